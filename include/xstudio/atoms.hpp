@@ -125,6 +125,7 @@ namespace media_reader {
     typedef std::shared_ptr<const ImageSetLayoutData> ImageSetLayoutDataPtr;
     class MediaReaderManager;
     class PixelInfo;
+    class ReadCancelToken;
 } // namespace media_reader
 
 namespace thumbnail {
@@ -203,6 +204,7 @@ CAF_ALLOW_UNSAFE_MESSAGE_TYPE(xstudio::media_reader::ImageBufPtr)
 CAF_ALLOW_UNSAFE_MESSAGE_TYPE(xstudio::media_reader::ImageBufDisplaySetPtr)
 CAF_ALLOW_UNSAFE_MESSAGE_TYPE(xstudio::media_reader::ImageSetLayoutDataPtr)
 CAF_ALLOW_UNSAFE_MESSAGE_TYPE(xstudio::media_reader::PixelInfo)
+CAF_ALLOW_UNSAFE_MESSAGE_TYPE(xstudio::media_reader::ReadCancelToken)
 CAF_ALLOW_UNSAFE_MESSAGE_TYPE(xstudio::ui::Hotkey)
 CAF_ALLOW_UNSAFE_MESSAGE_TYPE(xstudio::ui::viewport::GPUShaderPtr)
 CAF_ALLOW_UNSAFE_MESSAGE_TYPE(xstudio::ui::viewport::ViewportRendererPtr)
@@ -245,6 +247,7 @@ CAF_BEGIN_TYPE_ID_BLOCK(xstudio_simple_types, FIRST_CUSTOM_ID)
     CAF_ADD_TYPE_ID(xstudio_simple_types, (xstudio::media_reader::ImageSetLayoutDataPtr))
     CAF_ADD_TYPE_ID(xstudio_simple_types, (xstudio::media_reader::MRCertainty))
     CAF_ADD_TYPE_ID(xstudio_simple_types, (xstudio::media_reader::PixelInfo))
+    CAF_ADD_TYPE_ID(xstudio_simple_types, (xstudio::media_reader::ReadCancelToken))
     CAF_ADD_TYPE_ID(xstudio_simple_types, (xstudio::playhead::AssemblyMode))
     CAF_ADD_TYPE_ID(xstudio_simple_types, (xstudio::playhead::AutoAlignMode))
     CAF_ADD_TYPE_ID(xstudio_simple_types, (xstudio::playhead::LoopMode))
@@ -429,6 +432,7 @@ CAF_BEGIN_TYPE_ID_BLOCK(xstudio_framework_atoms, FIRST_CUSTOM_ID + (200 * 2))
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::global, get_scanner_atom)
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::global, get_studio_atom)
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::global, remote_session_name_atom)
+    CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::global, startup_timing_atom)
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::global, status_atom)
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::global_store, autosave_atom)
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::global_store, do_autosave_atom)
@@ -503,6 +507,7 @@ CAF_BEGIN_TYPE_ID_BLOCK(xstudio_framework_atoms, FIRST_CUSTOM_ID + (200 * 2))
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::module, watch_attribute_atom)
 
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::utility, notification_atom)
+    CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::utility, frame_trace_atom)
 
     CAF_ADD_ATOM(xstudio_framework_atoms, xstudio::global, authenticate_atom)
 
@@ -536,6 +541,7 @@ CAF_BEGIN_TYPE_ID_BLOCK(xstudio_plugin_atoms,  FIRST_CUSTOM_ID + (200 * 3))
     CAF_ADD_ATOM(xstudio_plugin_atoms, xstudio::http_client, http_post_simple_atom)
     CAF_ADD_ATOM(xstudio_plugin_atoms, xstudio::http_client, http_put_atom)
     CAF_ADD_ATOM(xstudio_plugin_atoms, xstudio::http_client, http_put_simple_atom)
+    CAF_ADD_ATOM(xstudio_plugin_atoms, xstudio::http_client, http_stats_atom)
     CAF_ADD_ATOM(xstudio_plugin_atoms, xstudio::media_hook, check_media_hook_plugin_versions_atom)
     CAF_ADD_ATOM(xstudio_plugin_atoms, xstudio::media_hook, gather_media_sources_atom)
     CAF_ADD_ATOM(xstudio_plugin_atoms, xstudio::media_hook, get_media_hook_atom)
@@ -554,6 +560,7 @@ CAF_BEGIN_TYPE_ID_BLOCK(xstudio_plugin_atoms,  FIRST_CUSTOM_ID + (200 * 3))
     CAF_ADD_ATOM(xstudio_plugin_atoms, xstudio::shotgun_client, shotgun_credential_atom)
     CAF_ADD_ATOM(xstudio_plugin_atoms, xstudio::shotgun_client, shotgun_delete_entity_atom)
     CAF_ADD_ATOM(xstudio_plugin_atoms, xstudio::shotgun_client, shotgun_entity_atom)
+    CAF_ADD_ATOM(xstudio_plugin_atoms, xstudio::shotgun_client, shotgun_entity_batch_atom)
     CAF_ADD_ATOM(xstudio_plugin_atoms, xstudio::shotgun_client, shotgun_entity_filter_atom)
     CAF_ADD_ATOM(xstudio_plugin_atoms, xstudio::shotgun_client, shotgun_entity_search_atom)
     CAF_ADD_ATOM(xstudio_plugin_atoms, xstudio::shotgun_client, shotgun_groups_atom)
@@ -736,11 +743,17 @@ CAF_BEGIN_TYPE_ID_BLOCK(xstudio_playback_atoms, FIRST_CUSTOM_ID + (200 * 5))
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, count_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, erase_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, keys_atom)
+    CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, playhead_hint_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, preserve_atom)
+    CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, proxy_atom)
+    CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, quota_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, retrieve_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, size_atom)
+    CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, stats_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, store_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, unpreserve_atom)
+    CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, usage_atom)
+    CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_cache, warm_start_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, clear_precache_queue_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, do_precache_work_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, get_audio_atom)
@@ -749,13 +762,16 @@ CAF_BEGIN_TYPE_ID_BLOCK(xstudio_playback_atoms, FIRST_CUSTOM_ID + (200 * 5))
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, get_media_detail_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, get_reader_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, get_thumbnail_atom)
+    CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, image_statistics_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, playback_precache_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, precache_audio_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, process_thumbnail_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, push_image_atom)
+    CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, read_ahead_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, read_precache_audio_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, read_precache_image_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, retire_readers_atom)
+    CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, return_worker_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, static_precache_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::media_reader, supported_atom)
     CAF_ADD_ATOM(xstudio_playback_atoms, xstudio::playhead, actual_playback_rate_atom)
@@ -9,6 +9,7 @@
 #include "xstudio/module/module.hpp"
 #include "xstudio/ui/viewport/shader.hpp"
 #include "xstudio/plugin_manager/plugin_base.hpp"
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -38,6 +39,12 @@ namespace colour_pipeline {
         [[nodiscard]] size_t size() const;
         std::any user_data_;
 
+        // Optional CPU implementation of the operation, used for software
+        // rendering when no GPU is available. Transforms packed RGBA float
+        // pixels in place. Must be thread safe.
+        typedef std::function<void(float *rgba, const size_t num_pixels)> CPUProcessFunc;
+        CPUProcessFunc cpu_process_func_;
+
         void set_cache_id(const std::string &id) { cache_id_ = id; }
         [[nodiscard]] const std::string &cache_id() const { return cache_id_; }
 
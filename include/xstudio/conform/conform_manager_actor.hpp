@@ -5,6 +5,7 @@
 
 #include "xstudio/media_reader/media_reader.hpp"
 #include "xstudio/module/module.hpp"
+#include "xstudio/timeline/item.hpp"
 #include "xstudio/utility/json_store_sync.hpp"
 
 namespace xstudio::conform {
@@ -17,9 +18,34 @@ class ConformWorkerActor : public caf::event_based_actor {
     const char *name() const override { return NAME.c_str(); }
 
   private:
+    void initialise_conformers();
+    void complete_initialisation();
+    void get_conform_tasks(caf::typed_response_promise<std::vector<std::string>> rp);
+    void send_progress(const std::string &stage, const size_t done, const size_t total);
+
     void process_request(
         caf::typed_response_promise<ConformReply> rp, const ConformRequest &request);
 
+    void process_request_add_media(
+        caf::typed_response_promise<ConformReply> rp,
+        const ConformRequest &request,
+        const ConformReply &result,
+        const size_t index,
+        const std::set<utility::Uuid> &failed);
+
+    void process_request_build_tracks(
+        caf::typed_response_promise<ConformReply> rp,
+        const ConformRequest &request,
+        const ConformReply &result,
+        const std::set<utility::Uuid> &failed_media);
+
+    void process_request_insert_tracks(
+        caf::typed_response_promise<ConformReply> rp,
+        const ConformReply &result,
+        const std::list<timeline::Item> &tracks,
+        const timeline::Item &unconformed_track,
+        const utility::UuidActorMap &mediamap);
+
     void process_task_request(
         caf::typed_response_promise<ConformReply> rp,
         const std::string &conform_task,
@@ -54,6 +80,41 @@ class ConformWorkerActor : public caf::event_based_actor {
         const utility::UuidActor &target_timeline,
         const utility::UuidActor &conform_track);
 
+    void conform_tracks_step_get_clip_media(
+        caf::typed_response_promise<ConformReply> rp,
+        const utility::UuidActor &source_playlist,
+        const utility::UuidActor &target_playlist,
+        const utility::UuidActor &target_timeline,
+        const timeline::Item &conform_track_item,
+        const std::vector<timeline::Item> &track_items);
+
+    void conform_tracks_step_duplicate_media(
+        caf::typed_response_promise<ConformReply> rp,
+        const utility::UuidActor &source_playlist,
+        const utility::UuidActor &target_playlist,
+        const utility::UuidActor &target_timeline,
+        const timeline::Item &conform_track_item,
+        const std::vector<timeline::Item> &track_items,
+        const std::map<utility::Uuid, utility::UuidActor> &clip_media);
+
+    void conform_tracks_step_add_media(
+        caf::typed_response_promise<ConformReply> rp,
+        const utility::UuidActor &target_playlist,
+        const utility::UuidActor &target_timeline,
+        const timeline::Item &conform_track_item,
+        const std::vector<timeline::Item> &track_items,
+        const std::map<utility::Uuid, utility::UuidActor> &clip_media,
+        const utility::UuidActorVector &media,
+        const size_t index);
+
+    void conform_tracks_step_build_request(
+        caf::typed_response_promise<ConformReply> rp,
+        const utility::UuidActor &target_playlist,
+        const utility::UuidActor &target_timeline,
+        const timeline::Item &conform_track,
+        const std::vector<timeline::Item> &track_items,
+        const std::map<utility::Uuid, utility::UuidActor> &clip_media);
+
     void conform_to_timeline(
         caf::typed_response_promise<ConformReply> rp,
         const utility::JsonStore &conform_operations,
@@ -97,10 +158,17 @@ class ConformWorkerActor : public caf::event_based_actor {
         const utility::UuidActor &clip,
         const utility::UuidActor &timeline);
 
+    void find_matched_step_match(
+        caf::typed_response_promise<utility::UuidActorVector> rp,
+        const std::string &key,
+        const utility::UuidActor &clip,
+        const std::vector<std::pair<utility::UuidActor, utility::JsonStore>> &metadata);
+
     inline static const std::string NAME = "ConformWorkerActor";
     caf::behavior behavior_;
     std::vector<caf::actor> conformers_;
     bool initialised_{false};
+    std::vector<caf::typed_response_promise<std::vector<std::string>>> initialise_waiters_;
 };
 
 class ConformManagerActor : public caf::event_based_actor, public module::Module {
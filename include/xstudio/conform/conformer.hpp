@@ -10,6 +10,8 @@
 // #include <optional>
 // #include <string>
 
+#include <unordered_map>
+
 #include "xstudio/global_store/global_store.hpp"
 #include "xstudio/plugin_manager/plugin_factory.hpp"
 #include "xstudio/timeline/item.hpp"
@@ -176,6 +178,56 @@ namespace conform {
         }
     };
 
+    // default conform key, shot, version and timecode range.
+    const auto ConformKeyPointers = std::vector<nlohmann::json::json_pointer>({
+        nlohmann::json::json_pointer(
+            "/metadata/shotgun/version/relationships/entity/data/name"),
+        nlohmann::json::json_pointer("/metadata/shotgun/version/attributes/code"),
+        nlohmann::json::json_pointer("/metadata/media/@/format/tags/timecode"),
+        nlohmann::json::json_pointer("/metadata/media/@/format/duration"),
+    });
+
+    // Hashed lookup of conform candidates keyed by conform key (shot, version, timecode
+    // range..), built once per request, so matching N needles against a haystack of M
+    // items is O(N + M) rather than O(N * M). Items sharing a key keep insertion order.
+    class ConformIndex {
+      public:
+        ConformIndex() : key_pointers_(ConformKeyPointers) {}
+        ConformIndex(std::vector<nlohmann::json::json_pointer> key_pointers)
+            : key_pointers_(std::move(key_pointers)) {}
+        virtual ~ConformIndex() = default;
+
+        static std::string make_key(const std::vector<std::string> &parts);
+
+        // build key from configured json pointers, empty if no pointer resolves.
+        [[nodiscard]] std::string make_key(const utility::JsonStore &metadata) const;
+
+        void add(const std::string &key, const utility::UuidActor &item);
+        void add(const utility::UuidActor &item, const utility::JsonStore &metadata);
+        void build(const std::vector<std::pair<utility::UuidActor, utility::JsonStore>>
+                       &haystack);
+
+        [[nodiscard]] const utility::UuidActorVector &find(const std::string &key) const;
+        [[nodiscard]] const utility::UuidActorVector &
+        find(const utility::JsonStore &metadata) const {
+            return find(make_key(metadata));
+        }
+
+        [[nodiscard]] size_t size() const { return size_; }
+        [[nodiscard]] size_t key_count() const { return index_.size(); }
+        [[nodiscard]] bool empty() const { return size_ == 0; }
+        void clear() {
+            index_.clear();
+            size_ = 0;
+        }
+
+      private:
+        std::vector<nlohmann::json::json_pointer> key_pointers_;
+        std::unordered_map<std::string, utility::UuidActorVector> index_;
+        size_t size_{0};
+        inline static const utility::UuidActorVector empty_{};
+    };
+
     class Conformer {
       public:
         Conformer(const utility::JsonStore &prefs = utility::JsonStore());
@@ -93,6 +93,8 @@ namespace global {
         StatusType status_{StatusType::ST_NONE};
         std::set<caf::actor_addr> busy_;
         utility::JsonStore file_map_regex_;
+        // time taken to start each global service, see startup_timing_atom
+        utility::JsonStore startup_timing_;
     };
 } // namespace global
 } // namespace xstudio
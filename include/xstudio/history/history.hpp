@@ -61,6 +61,15 @@ namespace history {
         return jsn;
     }
 
+    // json history, e.g. timeline edits, is held compactly with a memory budget.
+    template <typename K, typename V> struct HistoryMapStorage {
+        using type = utility::UndoRedoMap<K, V>;
+    };
+
+    template <typename K> struct HistoryMapStorage<K, utility::JsonStore> {
+        using type = utility::CompactUndoRedoMap<K>;
+    };
+
     template <typename K, typename V> class HistoryMap : public utility::Container {
       public:
         HistoryMap(const std::string &name = "HistoryMap");
@@ -73,6 +82,10 @@ namespace history {
 
         void set_max_count(const size_t value) { undo_redo_.set_max_count(value); };
 
+        // only for json history
+        [[nodiscard]] size_t bytes() const { return undo_redo_.bytes(); }
+        void set_max_bytes(const size_t value) { undo_redo_.set_max_bytes(value); };
+
         void push(const K &key, const V &value) { undo_redo_.push(key, value); }
 
         std::optional<V> undo() { return undo_redo_.undo(); }
@@ -92,7 +105,7 @@ namespace history {
         }
 
       private:
-        utility::UndoRedoMap<K, V> undo_redo_;
+        typename HistoryMapStorage<K, V>::type undo_redo_;
         bool enabled_{true};
     };
 
@@ -240,6 +240,14 @@ namespace history {
                 return true;
             },
 
+            // memory used by the history and its budget, in bytes.
+            [=](media_cache::size_atom) -> size_t { return base_.bytes(); },
+
+            [=](media_cache::size_atom, const size_t max_bytes) -> bool {
+                base_.set_max_bytes(max_bytes);
+                return true;
+            },
+
             [=](undo_atom) -> result<utility::JsonStore> {
                 auto i = base_.undo();
                 if (i)
@@ -9,12 +9,179 @@
 #endif
 #include <cpp-httplib/httplib.h>
 
+#include <atomic>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "xstudio/utility/chrono.hpp"
+#include "xstudio/utility/frame_trace.hpp"
+
 namespace xstudio {
 namespace http_client {
+
+    /* Class HTTPResponseCache
+
+    Responses to GET requests, kept in memory up to a byte budget and dropped
+    least recently used first. A response is fresh for its Cache-Control
+    max-age, or for the default TTL if it doesn't give one. It isn't stored
+    if it says no-store, or if it has neither a lifetime nor an ETag or
+    Last-Modified to revalidate with. Once stale, its validators go with the
+    next request for it and a 304 reply serves the cached body again.
+    */
+    class HTTPResponseCache {
+      public:
+        explicit HTTPResponseCache(
+            const size_t max_bytes                 = size_t(64) * 1024 * 1024,
+            const std::chrono::seconds default_ttl = std::chrono::seconds(0))
+            : max_bytes_(max_bytes), default_ttl_(default_ttl) {}
+
+        void set_max_bytes(const size_t max_bytes);
+        void set_default_ttl(const std::chrono::seconds default_ttl);
+
+        static std::string key(
+            const std::string &scheme_host_port,
+            const std::string &path,
+            const httplib::Headers &headers,
+            const httplib::Params &params);
+
+        [[nodiscard]] std::optional<httplib::Response> fresh(const std::string &key);
+
+        // If-None-Match and If-Modified-Since headers for a stale response
+        [[nodiscard]] httplib::Headers validators(const std::string &key) const;
+
+        // the cached response, made fresh again by a 304 reply
+        std::optional<httplib::Response>
+        revalidated(const std::string &key, const httplib::Response &not_modified);
+
+        void store(
+            const std::string &key,
+            const std::string &scheme_host_port,
+            const std::string &path,
+            const httplib::Response &response);
+
+        // a request has changed the resource at path, drop what we have of
+        // it, of anything under it and of the collections above it
+        void invalidate(const std::string &scheme_host_port, const std::string &path);
+
+        void clear();
+
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] size_t bytes() const;
+
+      private:
+        struct Entry {
+            httplib::Response response;
+            std::string scheme_host_port;
+            std::string path;
+            utility::time_point expires;
+            size_t bytes = {0};
+            std::list<std::string>::iterator lru;
+        };
+
+        // how long the response may be served without asking, nothing if it
+        // mustn't be stored
+        std::optional<std::chrono::seconds> lifetime(const httplib::Response &response) const;
+        void erase(std::unordered_map<std::string, Entry>::iterator entry);
+
+        mutable std::mutex mutex_;
+        size_t max_bytes_;
+        std::chrono::seconds default_ttl_;
+        size_t bytes_ = {0};
+        std::unordered_map<std::string, Entry> entries_;
+        std::list<std::string> lru_;
+    };
+
+    /* Class HTTPClient
+
+    Shared by the workers of an HTTPClientActor. Idle keep-alive connections
+    are pooled per host, so requests to the same server don't each pay for a
+    TCP and TLS handshake. GETs are answered from an HTTPResponseCache where
+    it can, and PUT, POST and DELETE requests invalidate what it holds for
+    their path. Request latency, connection reuse and cache hit rates are
+    measured.
+    */
     class HTTPClient {
       public:
-        HTTPClient()          = default;
+        HTTPClient(
+            const time_t connection_timeout = CPPHTTPLIB_CONNECTION_TIMEOUT_SECOND,
+            const time_t read_timeout       = CPPHTTPLIB_READ_TIMEOUT_SECOND,
+            const time_t write_timeout      = CPPHTTPLIB_WRITE_TIMEOUT_SECOND,
+            const size_t max_idle_per_host  = 4);
         virtual ~HTTPClient() = default;
+
+        httplib::Result
+        get(const std::string &scheme_host_port,
+            const std::string &path,
+            const httplib::Headers &headers,
+            const httplib::Params &params);
+
+        httplib::Result post(
+            const std::string &scheme_host_port,
+            const std::string &path,
+            const httplib::Headers &headers,
+            const httplib::Params &params,
+            const std::string &body,
+            const std::string &content_type);
+
+        httplib::Result
+        put(const std::string &scheme_host_port,
+            const std::string &path,
+            const httplib::Headers &headers,
+            const httplib::Params &params,
+            const std::string &body,
+            const std::string &content_type);
+
+        httplib::Result del(
+            const std::string &scheme_host_port,
+            const std::string &path,
+            const httplib::Headers &headers,
+            const std::string &body,
+            const std::string &content_type);
+
+        HTTPResponseCache &cache() { return cache_; }
+
+        void set_max_idle_per_host(const size_t max_idle_per_host);
+
+        // request counts and latency, connections opened and reused, cache
+        // hits and misses
+        [[nodiscard]] nlohmann::json stats() const;
+        void clear_stats();
+
+      private:
+        httplib::Result
+        send(const std::string &scheme_host_port,
+             const std::function<httplib::Result(httplib::Client &)> &request);
+
+        std::unique_ptr<httplib::Client> acquire(const std::string &scheme_host_port);
+        void release(
+            const std::string &scheme_host_port, std::unique_ptr<httplib::Client> client);
+
+        time_t connection_timeout_;
+        time_t read_timeout_;
+        time_t write_timeout_;
+
+        std::mutex mutex_;
+        size_t max_idle_per_host_;
+        std::map<std::string, std::vector<std::unique_ptr<httplib::Client>>> idle_;
+
+        HTTPResponseCache cache_;
+
+        std::atomic<uint64_t> requests_           = {0};
+        std::atomic<uint64_t> failed_             = {0};
+        std::atomic<uint64_t> connections_opened_ = {0};
+        std::atomic<uint64_t> connections_reused_ = {0};
+        std::atomic<uint64_t> cache_hits_         = {0};
+        std::atomic<uint64_t> cache_revalidated_  = {0};
+        std::atomic<uint64_t> cache_misses_       = {0};
+        utility::TraceHistogram latency_;
     };
 } // namespace http_client
 } // namespace xstudio
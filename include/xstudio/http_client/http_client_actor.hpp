@@ -13,9 +13,12 @@ namespace http_client {
       public:
         HTTPClientActor(
             caf::actor_config &cfg,
-            time_t connection_timeout = CPPHTTPLIB_CONNECTION_TIMEOUT_SECOND,
-            time_t read_timeout       = CPPHTTPLIB_READ_TIMEOUT_SECOND,
-            time_t write_timeout      = CPPHTTPLIB_WRITE_TIMEOUT_SECOND);
+            time_t connection_timeout      = CPPHTTPLIB_CONNECTION_TIMEOUT_SECOND,
+            time_t read_timeout            = CPPHTTPLIB_READ_TIMEOUT_SECOND,
+            time_t write_timeout           = CPPHTTPLIB_WRITE_TIMEOUT_SECOND,
+            size_t worker_count            = 10,
+            std::chrono::seconds cache_ttl = std::chrono::seconds(0),
+            size_t cache_bytes             = size_t(64) * 1024 * 1024);
         ~HTTPClientActor() override = default;
 
         const char *name() const override { return NAME.c_str(); }
@@ -30,15 +33,13 @@ namespace http_client {
         time_t connection_timeout_;
         time_t read_timeout_;
         time_t write_timeout_;
+        size_t worker_count_;
+        std::shared_ptr<HTTPClient> client_;
     };
 
     class HTTPWorker : public caf::event_based_actor {
       public:
-        HTTPWorker(
-            caf::actor_config &cfg,
-            time_t connection_timeout = CPPHTTPLIB_CONNECTION_TIMEOUT_SECOND,
-            time_t read_timeout       = CPPHTTPLIB_READ_TIMEOUT_SECOND,
-            time_t write_timeout      = CPPHTTPLIB_WRITE_TIMEOUT_SECOND);
+        HTTPWorker(caf::actor_config &cfg, std::shared_ptr<HTTPClient> client);
         ~HTTPWorker() override = default;
 
         const char *name() const override { return NAME.c_str(); }
@@ -50,6 +51,7 @@ namespace http_client {
 
       private:
         caf::behavior behavior_;
+        std::shared_ptr<HTTPClient> client_;
     };
 } // namespace http_client
 } // namespace xstudio
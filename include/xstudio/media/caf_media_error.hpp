@@ -5,7 +5,13 @@
 
 namespace xstudio {
 namespace media {
-    enum class media_error : uint8_t { missing = 1, corrupt, unsupported, unreadable };
+    enum class media_error : uint8_t {
+        missing = 1,
+        corrupt,
+        unsupported,
+        unreadable,
+        cancelled
+    };
 
     inline std::string to_string(media_error x) {
         switch (x) {
@@ -17,6 +23,8 @@ namespace media {
             return "File Unsupported";
         case media_error::unreadable:
             return "File unreadable";
+        case media_error::cancelled:
+            return "Read cancelled";
         default:
             return "-unknown-error-";
         }
@@ -35,6 +43,9 @@ namespace media {
         } else if (in == "File unreadable") {
             out = media_error::unreadable;
             return true;
+        } else if (in == "Read cancelled") {
+            out = media_error::cancelled;
+            return true;
         } else {
             return false;
         }
@@ -53,6 +64,9 @@ namespace media {
         } else if (in == 4) {
             out = media_error::unreadable;
             return true;
+        } else if (in == 5) {
+            out = media_error::cancelled;
+            return true;
         } else {
             return false;
         }
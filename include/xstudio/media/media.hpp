@@ -268,7 +268,8 @@ namespace media {
             const utility::Uuid &media_uuid         = utility::Uuid(),
             const utility::Uuid &clip_uuid          = utility::Uuid(),
             const MediaType media_type              = MT_IMAGE,
-            const utility::Timecode time_code       = utility::Timecode())
+            const utility::Timecode time_code       = utility::Timecode(),
+            const bool container                    = false)
             : uri_(uri),
               frame_(frame),
               key_(key_format, uri, frame, stream_id, mod_timestamp),
@@ -287,6 +288,7 @@ namespace media {
             md->media_uuid_        = media_uuid;
             md->clip_uuid_         = clip_uuid;
             md->media_type_        = media_type;
+            md->container_         = container;
             fixed_media_data_.reset(md);
         }
 
@@ -339,6 +341,8 @@ namespace media {
             return fixed_media_data_->clip_uuid_;
         }
         [[nodiscard]] MediaType media_type() const { return fixed_media_data_->media_type_; }
+        // all frames of the media are in one file (a movie), rather than a file per frame
+        [[nodiscard]] bool container() const { return fixed_media_data_->container_; }
         [[nodiscard]] const utility::Timecode &timecode() const { return timecode_; }
         [[nodiscard]] const std::string &error() const { return error_; }
 
@@ -375,6 +379,7 @@ namespace media {
             utility::Uuid media_uuid_;
             utility::Uuid clip_uuid_;
             MediaType media_type_;
+            bool container_;
         };
 
         std::shared_ptr<const FixedMediaData> fixed_media_data_;
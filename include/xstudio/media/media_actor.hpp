@@ -3,6 +3,7 @@
 
 #include <caf/all.hpp>
 #include <limits>
+#include <unordered_set>
 
 #include "xstudio/media/media.hpp"
 #include "xstudio/utility/container.hpp"
@@ -138,10 +139,14 @@ namespace media {
             caf::typed_response_promise<media::AVFrameIDs> rp,
             const utility::Uuid clip_uuid);
 
-        void get_media_pointers_for_frames(
+        void with_frame_range_inputs(
+            const MediaType media_type,
+            std::function<void(const utility::JsonStore &, const StreamDetail &)> on_ready,
+            std::function<void(const caf::error &)> on_error);
+
+        media::AVFrameIDs make_frame_ids(
             const MediaType media_type,
             const LogicalFrameRanges &ranges,
-            caf::typed_response_promise<media::AVFrameIDs> rp,
             const utility::Uuid clip_uuid,
             const utility::JsonStore &colour_mgmt_data,
             const StreamDetail &media_detail);
@@ -173,7 +178,30 @@ namespace media {
         utility::Uuid parent_uuid_;
         std::vector<caf::typed_response_promise<bool>> pending_stream_detail_requests_;
         MediaSourceChecksum media_metadata_ref_checksum_;
-        std::set<media::MediaKey> all_requested_frames_;
+        // the key of every frame handed out, which could be in the caches
+        std::unordered_set<media::MediaKey> requested_keys_;
+
+        // the frame ids last handed out for a clip (per media type), which
+        // are handed out again while nothing about them has changed, as
+        // playheads rebuild their frames on every edit
+        struct ReusableFrameId {
+            int key_frame_;
+            size_t mod_timestamp_;
+            std::shared_ptr<const media::AVFrameID> frame_id_;
+        };
+        struct ReusableFrameIds {
+            utility::Uuid stream_uuid_;
+            utility::MediaReference media_ref_;
+            utility::JsonStore colour_mgmt_data_;
+            StreamDetail media_detail_;
+            std::string reader_;
+            std::shared_ptr<const media::AVFrameID> base_;
+            // by logical frame and timecode
+            std::map<std::pair<int, unsigned int>, ReusableFrameId> frames_;
+            size_t last_used_ = {0};
+        };
+        std::map<std::pair<MediaType, utility::Uuid>, ReusableFrameIds> reusable_frame_ids_;
+        size_t frame_id_requests_ = {0};
         std::filesystem::file_time_type container_file_timestamp_;
 
         struct UriStatus {
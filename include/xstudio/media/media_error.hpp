@@ -35,4 +35,10 @@ class media_unreadable_error : public media_err {
     media_unreadable_error(const char *what_arg) : media_err(what_arg) {}
 };
 
+class media_cancelled_error : public media_err {
+  public:
+    media_cancelled_error(const std::string &what_arg) : media_err(what_arg) {}
+    media_cancelled_error(const char *what_arg) : media_err(what_arg) {}
+};
+
 } // namespace xstudio
\ No newline at end of file
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "xstudio/media/media.hpp"
+#include "xstudio/utility/chrono.hpp"
+#include "xstudio/utility/uuid.hpp"
+
+namespace xstudio {
+namespace media_cache {
+
+    /* Class CacheTrace
+
+    A record of the requests made of the image cache, so that eviction
+    policies can be compared offline by replaying what a real session asked
+    for (see the trace replay simulator in src/media_cache/test). Times are
+    kept in microseconds from the first event recorded.
+
+    Given a path, events are written out as json lines every few thousand
+    events and when the trace is destroyed. Without one they are kept in
+    memory.
+    */
+    class CacheTrace {
+      public:
+        enum class Op : uint8_t {
+            Store,
+            StoreOutOfDate,
+            Retrieve,
+            Preserve,
+            Unpreserve,
+            Erase,
+            Hint,
+            Position
+        };
+
+        struct Event {
+            Op op = {Op::Retrieve};
+            // when the request was made
+            int64_t t_us = {0};
+            media::MediaKey key;
+            utility::Uuid uuid;
+            // when the frame is needed, or when the playhead hint was taken
+            int64_t when_us        = {0};
+            int64_t out_of_date_us = {0};
+            // frame size, 0 for a retrieve that missed
+            size_t size = {0};
+
+            // playhead hints, see EvictionPolicy::set_playhead_hint
+            media::MediaKeyVector frames;
+            size_t position       = {0};
+            double frame_period_s = {0.0};
+            float velocity        = {0.0f};
+        };
+
+        CacheTrace() = default;
+        explicit CacheTrace(std::string path) : path_(std::move(path)) {}
+        CacheTrace(const CacheTrace &) = delete;
+        CacheTrace(CacheTrace &&)      = default;
+        ~CacheTrace();
+
+        static CacheTrace load(const std::string &path);
+
+        void record(
+            const Op op,
+            const media::MediaKey &key,
+            const utility::Uuid &uuid              = utility::Uuid(),
+            const utility::time_point &when        = utility::clock::now(),
+            const size_t size                      = 0,
+            const utility::time_point &out_of_date = utility::time_point());
+
+        void record_hint(
+            const utility::Uuid &playhead_uuid,
+            const media::MediaKeyVector &frames,
+            const size_t position,
+            const timebase::flicks frame_period,
+            const float velocity,
+            const utility::time_point &when);
+
+        // an event with its times already worked out
+        void add(Event event) { events_.emplace_back(std::move(event)); }
+
+        [[nodiscard]] const std::vector<Event> &events() const { return events_; }
+        [[nodiscard]] const std::string &path() const { return path_; }
+
+        // write pending events to path, the first flush replaces the file
+        bool flush();
+
+        static nlohmann::json to_json(const Event &event);
+        static Event from_json(const nlohmann::json &jsn);
+
+      private:
+        Event make_event(
+            const Op op,
+            const media::MediaKey &key,
+            const utility::Uuid &uuid,
+            const utility::time_point &when,
+            const size_t size                      = 0,
+            const utility::time_point &out_of_date = utility::time_point());
+        void push(Event event);
+        int64_t since_start(const utility::time_point &tp);
+
+        std::string path_;
+        bool started_ = {false};
+        bool flushed_ = {false};
+        utility::time_point start_;
+        std::vector<Event> events_;
+    };
+
+} // namespace media_cache
+} // namespace xstudio
@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "xstudio/media/media.hpp"
+#include "xstudio/utility/chrono.hpp"
+#include "xstudio/utility/time_cache.hpp"
+#include "xstudio/utility/uuid.hpp"
+
+namespace xstudio {
+namespace media_cache {
+
+    /* Class EvictionPolicy
+
+    Decides which frames the image cache drops when it is full. The cache
+    itself only knows when the playheads have said they need a frame, which
+    reaches no further than their read-ahead. A policy can also be told the
+    loop range each playing playhead is cycling over, its position and its
+    speed, and estimate when every frame will next be needed from that.
+
+    Policies are selected by name with make_eviction_policy, see the
+    /core/image_cache/eviction_policy preference.
+    */
+    class EvictionPolicy {
+      public:
+        virtual ~EvictionPolicy() = default;
+
+        [[nodiscard]] virtual std::string name() const = 0;
+
+        // the frames a playing playhead is looping over, in timeline order,
+        // and the index of the frame it was showing at 'when'. velocity is
+        // negative when playing backwards.
+        virtual void set_playhead_hint(
+            const utility::Uuid &playhead_uuid,
+            const media::MediaKeyVector &frames,
+            const size_t position,
+            const timebase::flicks frame_period,
+            const float velocity,
+            const utility::time_point &when) {}
+
+        // a fresh position for a playhead whose frames are already known
+        virtual void update_playhead_position(
+            const utility::Uuid &playhead_uuid,
+            const size_t position,
+            const timebase::flicks frame_period,
+            const float velocity,
+            const utility::time_point &when) {}
+
+        virtual void clear_playhead_hint(const utility::Uuid &playhead_uuid) {}
+
+        // policies that can't estimate next use leave the cache to order
+        // evictions on its own 'needed by' timepoints
+        [[nodiscard]] virtual bool estimates_next_use() const { return false; }
+
+        // when the key is expected to be needed again, time_point::max() if
+        // no playhead will come back to it
+        [[nodiscard]] virtual utility::time_point
+        next_use(const media::MediaKey &key, const utility::time_point &now) const {
+            return utility::time_point::max();
+        }
+
+        [[nodiscard]] virtual nlohmann::json json() const;
+
+        template <typename V>
+        void attach(utility::TimeCache<media::MediaKey, V> &cache) const {
+            if (estimates_next_use())
+                cache.set_next_use_estimator(
+                    [this](const media::MediaKey &key, const utility::time_point &now) {
+                        return next_use(key, now);
+                    });
+            else
+                cache.set_next_use_estimator(nullptr);
+        }
+    };
+
+    // the cache's own ordering, frames needed furthest from now go first
+    class NeededByPolicy : public EvictionPolicy {
+      public:
+        [[nodiscard]] std::string name() const override { return "needed_by"; }
+    };
+
+    /* An approximation of Belady's optimal policy for looping playheads. A
+    frame's next use is the time until the nearest playing playhead wraps
+    round to it at its current speed, so frames in a short loop that are
+    needed again in a few seconds are kept over frames from a one off scrub
+    that nothing will come back to. */
+    class PlayheadReusePolicy : public EvictionPolicy {
+      public:
+        [[nodiscard]] std::string name() const override { return "playhead_reuse"; }
+
+        void set_playhead_hint(
+            const utility::Uuid &playhead_uuid,
+            const media::MediaKeyVector &frames,
+            const size_t position,
+            const timebase::flicks frame_period,
+            const float velocity,
+            const utility::time_point &when) override;
+
+        void update_playhead_position(
+            const utility::Uuid &playhead_uuid,
+            const size_t position,
+            const timebase::flicks frame_period,
+            const float velocity,
+            const utility::time_point &when) override;
+
+        void clear_playhead_hint(const utility::Uuid &playhead_uuid) override;
+
+        [[nodiscard]] bool estimates_next_use() const override { return true; }
+
+        [[nodiscard]] utility::time_point
+        next_use(const media::MediaKey &key, const utility::time_point &now) const override;
+
+        [[nodiscard]] nlohmann::json json() const override;
+
+      private:
+        struct Hint {
+            // frames per second through the loop, negative when going backwards
+            double rate        = {0.0};
+            double position    = {0.0};
+            size_t frame_count = {0};
+            utility::time_point when;
+        };
+
+        void set_motion(
+            Hint &hint,
+            const size_t position,
+            const timebase::flicks frame_period,
+            const float velocity,
+            const utility::time_point &when);
+
+        std::map<utility::Uuid, Hint> hints_;
+        // loop indices of each key, per playhead
+        std::unordered_map<media::MediaKey, std::vector<std::pair<utility::Uuid, size_t>>>
+            frames_;
+    };
+
+    // throws std::runtime_error for an unknown name
+    std::unique_ptr<EvictionPolicy> make_eviction_policy(const std::string &name);
+
+} // namespace media_cache
+} // namespace xstudio
@@ -2,13 +2,18 @@
 #pragma once
 
 #include <caf/all.hpp>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
 
+#include "xstudio/media_cache/cache_trace.hpp"
+#include "xstudio/media_cache/eviction_policy.hpp"
 #include "xstudio/media_reader/media_reader.hpp"
 #include "xstudio/utility/time_cache.hpp"
 #include "xstudio/utility/chrono.hpp"
+#include "xstudio/utility/json_store.hpp"
+#include "xstudio/utility/uuid.hpp"
 
 namespace xstudio {
 namespace media_cache {
@@ -27,9 +32,48 @@ namespace media_cache {
         inline static const std::string NAME = "GlobalImageCacheActor";
         void
         update_changes(const media::MediaKeyVector &store, const media::MediaKeyVector &erase);
+        media_reader::ImageBufPtr count_retrieve(const media_reader::ImageBufPtr &buf);
+
+        void set_eviction_policy(const std::string &name);
+        void set_access_trace(const std::string &path);
+        void trace(
+            const CacheTrace::Op op,
+            const media::MediaKey &key,
+            const utility::Uuid &uuid,
+            const utility::time_point &when,
+            const media_reader::ImageBufPtr &buf   = media_reader::ImageBufPtr(),
+            const utility::time_point &out_of_date = utility::time_point());
+
+        // reduced copies for viewports that draw frames small, see proxy_atom
+        void store_proxy(
+            const media::MediaKey &key,
+            const media_reader::ImageBufPtr &buf,
+            const utility::Uuid &uuid);
+        void make_proxy(
+            const media::MediaKey &key,
+            const media_reader::ImageBufPtr &buf,
+            const int level,
+            const utility::Uuid &uuid);
+        void erase_proxies(const media::MediaKey &key);
+        // the level every viewport showing the playhead wants, otherwise 0
+        int proxy_level(const utility::Uuid &playhead) const;
+
+        // lists the cached frames for the next session, see WarmStart
+        void save_warm_start();
+
+        // what the cache holds per container, media, source and playhead
+        utility::JsonStore usage() const;
+        utility::JsonStore usage(const utility::Uuid &uuid) const;
+        void set_container(
+            const utility::Uuid &container,
+            const utility::UuidVector &members,
+            const std::string &name);
 
         caf::behavior behavior_;
         utility::TimeCache<media::MediaKey, media_reader::ImageBufPtr> cache_;
+        std::unique_ptr<EvictionPolicy> eviction_policy_;
+        // requests are recorded here while /core/image_cache/access_trace is set
+        std::unique_ptr<CacheTrace> access_trace_;
         std::unordered_set<media::MediaKey> new_keys_;
         std::unordered_set<media::MediaKey> erased_keys_;
 
@@ -39,6 +83,42 @@ namespace media_cache {
         bool update_pending_;
         std::chrono::minutes reset_idle_{0};
         utility::time_point last_activity_{utility::clock::now()};
+
+        // retrieve requests that found / didn't find the image, see stats_atom
+        size_t retrieve_hits_{0};
+        size_t retrieve_misses_{0};
+
+        // proxies have a budget of their own, so a grid full of them doesn't
+        // push full resolution frames out or the other way round
+        utility::TimeCache<media::MediaKey, media_reader::ImageBufPtr> proxy_cache_;
+        // the level each viewport showing a playhead asked for, by playhead
+        std::map<utility::Uuid, std::map<utility::Uuid, int>> proxy_demand_;
+        // proxies being made, with the requests waiting on them
+        std::map<
+            media::MediaKey,
+            std::vector<caf::typed_response_promise<media_reader::ImageBufPtr>>>
+            proxy_pending_;
+        size_t proxy_hits_{0};
+        size_t proxy_misses_{0};
+
+        // frames from the last session are read again as background reads of
+        // a playhead of their own, see /core/image_cache/warm_start
+        bool warm_start_{false};
+        std::string warm_start_path_;
+        utility::Uuid warm_start_uuid_{utility::Uuid::generate()};
+        std::unordered_set<media::MediaKey> warm_start_pending_;
+        size_t warm_start_frames_{0};
+        size_t warm_start_restored_{0};
+        size_t warm_start_changed_{0};
+
+        // frames are accounted against the media and source they came from
+        // and any container holding those, e.g. the playlists, see usage_atom
+        struct Container {
+            std::string name;
+            std::set<utility::Uuid> members;
+        };
+        std::map<utility::Uuid, Container> containers_;
+        std::map<utility::Uuid, std::set<utility::Uuid>> member_of_;
     };
 
     class GlobalAudioCacheActor : public caf::event_based_actor {
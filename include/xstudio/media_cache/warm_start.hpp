@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "xstudio/media/media.hpp"
+#include "xstudio/utility/chrono.hpp"
+#include "xstudio/utility/uuid.hpp"
+
+namespace xstudio {
+namespace media_cache {
+
+    /* Class WarmStart
+
+    The frames that were in the image cache when xSTUDIO shut down, so that
+    the next session can read them back into the cache in the background
+    instead of starting cold. Only what a reader needs to read each frame
+    again is kept, along with its size and how long before shutdown it was
+    last needed. Frames are kept most recently needed first.
+
+    Before frames are read again they are checked against their files: the
+    modification time that the media source put into each frame's MediaKey
+    has to match the file's, so frames of files that have been replaced or
+    removed since are dropped.
+    */
+    class WarmStart {
+      public:
+        struct Frame {
+            media::MediaKey key;
+            std::string uri;
+            int frame       = {0};
+            int first_frame = {0};
+            std::string stream_id;
+            std::string reader;
+            float pixel_aspect = {1.0f};
+            timebase::flicks rate{timebase::k_flicks_24fps};
+            nlohmann::json params;
+            utility::Uuid source_uuid;
+            utility::Uuid media_uuid;
+            size_t size = {0};
+            // how long before shutdown the frame was needed, negative if it
+            // was wanted later than that
+            int64_t age_ms = {0};
+        };
+
+        WarmStart() = default;
+
+        // throws if the file can't be read
+        static WarmStart load(const std::string &path);
+        // false if the file couldn't be written
+        bool save(const std::string &path) const;
+
+        // needed_by is the latest time the cache has for the frame
+        void add(
+            const media::AVFrameID &frame_id,
+            const size_t size,
+            const utility::time_point &needed_by,
+            const utility::time_point &now = utility::clock::now());
+
+        // most recently needed first
+        void sort();
+
+        // drops frames whose files have changed and then those that don't fit
+        // in max_size bytes, returning how many were dropped as changed
+        size_t validate(const size_t max_size);
+
+        // frames to queue as background reads, the first one needed at now
+        // and the rest following in the order they were needed before
+        [[nodiscard]] media::AVFrameIDsAndTimePoints
+        frame_ids(const utility::time_point &now = utility::clock::now()) const;
+
+        [[nodiscard]] const std::vector<Frame> &frames() const { return frames_; }
+        [[nodiscard]] bool empty() const { return frames_.empty(); }
+
+        // the file modification time at the end of a MediaKey, see
+        // media::AVFrameID
+        static std::optional<size_t> key_mod_timestamp(const media::MediaKey &key);
+        // whether the frame's file is still the one that was read
+        static bool unchanged(const Frame &frame);
+
+        static nlohmann::json to_json(const Frame &frame);
+        static Frame from_json(const nlohmann::json &jsn);
+
+      private:
+        std::vector<Frame> frames_;
+    };
+
+} // namespace media_cache
+} // namespace xstudio
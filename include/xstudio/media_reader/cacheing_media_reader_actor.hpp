@@ -2,9 +2,14 @@
 #pragma once
 
 #include <caf/all.hpp>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
 
 #include "xstudio/media/media.hpp"
 #include "xstudio/media_reader/media_reader.hpp"
+#include "xstudio/media_reader/read_priority.hpp"
 #include "xstudio/utility/chrono.hpp"
 #include "xstudio/utility/uuid.hpp"
 
@@ -21,32 +26,91 @@ namespace media_reader {
         ~CachingMediaReaderActor() override = default;
 
         caf::behavior make_behavior() override { return behavior_; }
+        void on_exit() override;
 
         const char *name() const override { return NAME.c_str(); }
 
       private:
-        struct ImmediateImageReqest {
-
-            ImmediateImageReqest(
-                const media::AVFrameID mptr, caf::typed_response_promise<ImageBufPtr> &rp)
-                : mptr_(mptr), response_promise_(rp) {}
-
-            ImmediateImageReqest(const ImmediateImageReqest &) = default;
-            ImmediateImageReqest()                             = default;
-
-            ImmediateImageReqest &operator=(const ImmediateImageReqest &o) = default;
+        /* A read waiting for, or running on, one of our workers. Reads of any
+        class can run on any worker, the queue is ordered by class and then
+        deadline. */
+        struct ReadJob {
+            media::AVFrameID mptr;
+            bool audio = {false};
+            ReadPriority priority = {RP_IMMEDIATE};
+            utility::time_point deadline;
+            // from the requester, lets it cancel reads that have gone stale
+            ReadCancelToken request_token;
+            // for the current run of the read, a child of request_token
+            ReadCancelToken token;
+            utility::Uuid playhead_uuid;
+            utility::time_point queued_at;
+            utility::time_point started_at;
+            bool preempted = {false};
+            std::function<void(const ImageBufPtr &)> on_image;
+            std::function<void(const AudioBufPtr &)> on_audio;
+            std::function<void(const caf::error &)> on_error;
+        };
+        using ReadJobPtr = std::shared_ptr<ReadJob>;
+
+        struct Worker {
+            caf::actor actor;
+            ReadJobPtr job;
+            // what its decoder was last asked for, so that sequential reads
+            // of a movie stay on the decoder already positioned there
+            caf::uri last_uri;
+            int last_frame  = {0};
+            bool last_audio = {false};
+            utility::time_point last_started;
+            // listed as spare for other sources to borrow, or lent to one
+            bool offered = {false};
+            bool lent    = {false};
+        };
 
-            media::AVFrameID mptr_;
-            caf::typed_response_promise<ImageBufPtr> response_promise_;
+        // a spare worker of another source, running one of our reads
+        struct BorrowedWorker {
+            caf::actor actor;
+            caf::actor_addr owner;
+            ReadJobPtr job;
         };
 
-        void do_urgent_get_image();
+        ReadJobPtr make_job(
+            const media::AVFrameID &mptr,
+            const ReadPriority priority,
+            const utility::time_point &deadline,
+            const ReadCancelToken &request_token = ReadCancelToken(),
+            const utility::Uuid &playhead_uuid   = utility::Uuid());
+
+        void queue_read(const ReadJobPtr &job);
+        void dispatch_reads();
+        void start_read(const size_t worker, const ReadJobPtr &job);
+        void start_borrowed_read(
+            const caf::actor &worker, const caf::actor_addr &owner, const ReadJobPtr &job);
+        void run_read(
+            const caf::actor &worker, const ReadJobPtr &job, std::function<void()> release);
+        void read_finished(const ReadJobPtr &job);
+        void read_failed(const ReadJobPtr &job, const caf::error &err);
+
+        // the worker positioned just before the job's frame of the same file,
+        // or -1
+        [[nodiscard]] int sequential_worker(const ReadJob &job) const;
+        // the free worker used least recently, or -1
+        int free_worker();
+        bool claim_worker(Worker &worker);
+        void note_frame(const media::AVFrameID &mptr);
+        void borrow_workers();
+        void offer_idle_workers();
+
         caf::typed_response_promise<ImageBufPtr> receive_image_buffer_request(
             const media::AVFrameID &mptr, const utility::Uuid playhead_uuid);
 
-        ImageBufPtr make_error_buffer(const caf::error &err, const media::AVFrameID &mptr);
+        void store_image(
+            const media::AVFrameID &mptr,
+            const ImageBufPtr &buf,
+            const utility::time_point &tp,
+            const utility::Uuid &playhead_uuid);
 
-        std::map<const utility::Uuid, ImmediateImageReqest> pending_get_image_requests_;
+        ImageBufPtr make_error_buffer(const caf::error &err, const media::AVFrameID &mptr);
 
         inline static const std::string NAME = "CachingMediaReaderActor";
 
@@ -55,11 +119,14 @@ namespace media_reader {
         caf::actor image_cache_;
         caf::actor audio_cache_;
 
-        bool urgent_worker_busy_ = {false};
+        utility::Uuid plugin_uuid_;
+        std::vector<Worker> workers_;
+        std::vector<BorrowedWorker> borrowed_;
+        std::vector<ReadJobPtr> pending_reads_;
 
-        caf::actor urgent_worker_;
-        caf::actor precache_worker_;
-        caf::actor audio_worker_;
+        // whether each frame is a file of its own (an image sequence) rather
+        // than a frame of a movie, unknown until the first read
+        std::optional<bool> frame_per_file_;
 
         ImageBufPtr blank_image_;
     };
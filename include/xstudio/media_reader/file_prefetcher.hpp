@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "xstudio/utility/chrono.hpp"
+#include "xstudio/utility/uuid.hpp"
+
+namespace xstudio {
+namespace media_reader {
+
+    /* Class FilePrefetcher
+
+    Pulls the files of frames that are about to be decoded into the OS page
+    cache, so that a reader opening them finds the data there instead of
+    waiting on the (network) filesystem. A few threads of its own read the
+    queued files ahead of the reader workers, asking the kernel for readahead
+    first where posix_fadvise is available.
+
+    Files that have been prefetched but not yet read by a decoder count
+    against a byte budget, and prefetching pauses while the budget is spent.
+    A file stops counting when consumed() is called for it, or when it has
+    sat unread for a while. Files bigger than a quarter of the budget are
+    skipped. Queueing files for a playhead replaces what was
+    queued for it before, and reads of files it no longer wants are abandoned.
+    */
+    class FilePrefetcher {
+      public:
+        explicit FilePrefetcher(
+            const int threads = 4, const size_t byte_budget = size_t(512) * 1024 * 1024);
+        ~FilePrefetcher();
+
+        FilePrefetcher(const FilePrefetcher &)            = delete;
+        FilePrefetcher &operator=(const FilePrefetcher &) = delete;
+
+        void set_byte_budget(const size_t byte_budget);
+        [[nodiscard]] size_t byte_budget() const;
+
+        // the files the playhead will want next, soonest first
+        void
+        prefetch(const utility::Uuid &playhead_uuid, const std::vector<std::string> &paths);
+
+        // the playhead has stopped or jumped, drop its queue and its reads
+        void cancel(const utility::Uuid &playhead_uuid);
+
+        // drop every playhead's queue and reads
+        void clear();
+
+        // a decoder has read the file
+        void consumed(const std::string &path);
+
+        // bytes prefetched and not yet consumed
+        [[nodiscard]] size_t outstanding_bytes() const;
+
+        // counts of files prefetched, cancelled, failed, skipped and waiting,
+        // and the budget in use
+        [[nodiscard]] nlohmann::json json() const;
+
+      private:
+        struct Job {
+            utility::Uuid playhead_uuid;
+            std::string path;
+            std::shared_ptr<std::atomic<bool>> cancelled;
+        };
+
+        struct Prefetched {
+            size_t bytes = {0};
+            utility::time_point when;
+            utility::Uuid playhead_uuid;
+        };
+
+        void run();
+        void expire(const utility::time_point &now);
+
+        // the file's size, 0 if it can't be opened
+        static size_t file_size(const std::string &path);
+        // false if the read was cancelled or failed
+        static bool read_file(const std::string &path, const std::atomic<bool> &cancelled);
+
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        bool stopping_ = {false};
+
+        size_t byte_budget_;
+        size_t outstanding_bytes_ = {0};
+
+        std::deque<Job> queue_;
+        std::map<std::string, Job> running_;
+        std::map<std::string, Prefetched> prefetched_;
+
+        uint64_t files_     = {0};
+        uint64_t bytes_     = {0};
+        uint64_t cancelled_ = {0};
+        uint64_t failed_    = {0};
+        uint64_t skipped_   = {0};
+
+        std::vector<std::thread> threads_;
+    };
+
+} // namespace media_reader
+} // namespace xstudio
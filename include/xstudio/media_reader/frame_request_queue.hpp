@@ -6,6 +6,7 @@
 #include "xstudio/atoms.hpp"
 #include "xstudio/media/media.hpp"
 #include "xstudio/media_reader/media_reader.hpp"
+#include "xstudio/media_reader/read_priority.hpp"
 #include "xstudio/utility/chrono.hpp"
 #include "xstudio/utility/uuid.hpp"
 
@@ -31,10 +32,13 @@ namespace media_reader {
         FrameRequest(
             std::shared_ptr<const media::AVFrameID> fi,
             const utility::time_point &rb,
-            const utility::Uuid &ph)
+            const utility::Uuid &ph,
+            const ReadPriority priority = RP_PLAYBACK)
             : requested_frame_(std::move(fi)),
               required_by_(rb),
-              requesting_playhead_uuid_(ph) {}
+              requesting_playhead_uuid_(ph),
+              queued_at_(utility::clock::now()),
+              priority_(priority) {}
 
         FrameRequest(const FrameRequest &o) = default;
 
@@ -43,6 +47,12 @@ namespace media_reader {
         std::shared_ptr<const media::AVFrameID> requested_frame_;
         utility::time_point required_by_;
         utility::Uuid requesting_playhead_uuid_;
+        // when the request was added to the queue, for tracing
+        utility::time_point queued_at_;
+        ReadPriority priority_ = {RP_PLAYBACK};
+        // set when the request is popped for reading, cancelling it lets the
+        // reader abandon a request that has gone stale
+        ReadCancelToken cancel_token_;
     };
 
 
@@ -58,6 +68,9 @@ namespace media_reader {
      *   playhead changes position. If the reader can't keep up with the playhead
      *   then 'out of date' unfulfilled requests that were needed in the past need
      *   to be pruned and so-on
+     *
+     *   Requests carry a ReadPriority class, they are popped in class order and
+     *   by the time they are required within a class.
      */
     class FrameRequestQueue {
 
@@ -83,11 +96,14 @@ namespace media_reader {
         void prune_stale_frame_requests();
 
         /**
-         *   @brief Get the next ordered frame request
+         *   @brief Get the next ordered frame request, with a fresh cancel token
          *
+         *  @details Requests from a playhead are skipped while it has as many reads
+         *  in flight as its entry in max_in_flight allows, one if it has no entry.
          */
-        std::optional<FrameRequest>
-        pop_request(const std::map<utility::Uuid, int> &exclude_playheads);
+        std::optional<FrameRequest> pop_request(
+            const std::map<utility::Uuid, int> &in_flight,
+            const std::map<utility::Uuid, int> &max_in_flight = {});
 
         /**
          *   @brief Add a request to the queue
@@ -96,7 +112,8 @@ namespace media_reader {
         void add_frame_request(
             const media::AVFrameID &frame_info,
             const utility::time_point &required_by,
-            const utility::Uuid &requesting_playhead_uuid);
+            const utility::Uuid &requesting_playhead_uuid,
+            const ReadPriority priority = RP_PLAYBACK);
 
         /**
          *   @brief Add a request to the queue
@@ -104,7 +121,8 @@ namespace media_reader {
          */
         void add_frame_requests(
             const media::AVFrameIDsAndTimePoints &frames_info,
-            const utility::Uuid &requesting_playhead_uuid);
+            const utility::Uuid &requesting_playhead_uuid,
+            const ReadPriority priority = RP_PLAYBACK);
 
         /**
          *   @brief Remove all frame requests in the queue originating from
@@ -112,7 +130,19 @@ namespace media_reader {
          */
         void clear_pending_requests(const utility::Uuid &playhead_uuid);
 
+        /**
+         *   @brief Remove the frame requests of one priority class originating
+         *   from the indicated playhead
+         */
+        void clear_pending_requests(
+            const utility::Uuid &playhead_uuid, const ReadPriority priority);
+
+        [[nodiscard]] size_t size() const { return queue_.size(); }
+        [[nodiscard]] size_t size(const ReadPriority priority) const;
+
       private:
+        void sort_queue();
+
         std::vector<std::shared_ptr<FrameRequest>> queue_;
     };
 
@@ -1,6 +1,9 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <functional>
+#include <mutex>
+
 #include "xstudio/media/media.hpp"
 #include "xstudio/media_reader/buffer.hpp"
 #include "xstudio/media_reader/audio_buffer.hpp"
@@ -34,8 +37,20 @@ namespace media_reader {
         void set_shader_params(const utility::JsonStore &params) { shader_params_ = params; }
         [[nodiscard]] const utility::JsonStore &shader_params() const { return shader_params_; }
 
-        void set_metadata(const utility::JsonStore &metadata) { metadata_ = metadata; }
-        [[nodiscard]] const utility::JsonStore &metadata() const { return metadata_; }
+        void set_metadata(const utility::JsonStore &metadata) {
+            metadata_ = metadata;
+            metadata_loader_.reset();
+        }
+        [[nodiscard]] const utility::JsonStore &metadata() const;
+
+        /* Readers whose metadata is expensive to turn into json (e.g. EXRs
+        with large headers) can instead hand over a function that builds it.
+        It is called, once, the first time something asks for the metadata,
+        which for most frames that pass through the cache is never. The
+        function must only capture data it owns, as it can outlive the
+        reader. */
+        typedef std::function<utility::JsonStore()> MetadataLoaderFunc;
+        void set_metadata_loader(MetadataLoaderFunc loader);
 
         [[nodiscard]] Imath::V2i image_size_in_pixels() const { return image_size_in_pixels_; }
         [[nodiscard]] Imath::Box2i image_pixels_bounding_box() const { return pixels_bounds_; }
@@ -74,17 +89,52 @@ namespace media_reader {
             return PixelInfo(pixel_location);
         }
 
+        /* Unpacks one scanline of the image data window into RGBA float
+        values, reproducing on the CPU what the reader's GLSL unpack shader
+        does on the GPU. 'line' is in image pixel coordinates (i.e. it can
+        be negative for overscan) and 'rgba_out' must have space for 4 floats
+        per pixel across the width of the data window. */
+        typedef std::function<void(const ImageBuffer &buf, const int line, float *rgba_out)>
+            ScanlineUnpackFunc;
+        void set_scanline_unpack_func(ScanlineUnpackFunc func) { scanline_unpack_ = func; }
+        [[nodiscard]] bool has_scanline_unpack_func() const {
+            return bool(scanline_unpack_);
+        }
+
+        void unpack_scanline(const int line, float *rgba_out) const;
+
+        /* Makes this a proxy (see image_proxy.hpp) of source, taking its
+        shader, metadata and unpack function. The pixel picker isn't taken as
+        it works in the source's pixel coordinates. */
+        void set_proxy_of(const ImageBuffer &source, const int level);
+        [[nodiscard]] int proxy_level() const { return proxy_level_; }
+
+        // the size of the frame a proxy was made from, or of this one
+        [[nodiscard]] Imath::V2i source_size_in_pixels() const {
+            return proxy_level_ ? source_size_in_pixels_ : image_size_in_pixels_;
+        }
+
       private:
+        struct MetadataLoader {
+            MetadataLoaderFunc load_;
+            std::once_flag loaded_;
+            utility::JsonStore metadata_;
+        };
+
         utility::Uuid shader_id_;
         utility::JsonStore shader_params_;
         utility::JsonStore metadata_;
+        std::shared_ptr<MetadataLoader> metadata_loader_;
         Imath::V2i image_size_in_pixels_;
         Imath::Box2i pixels_bounds_;
         media::MediaKey media_key_;
         int frame_num_ = -1;
         ui::viewport::GPUShaderPtr shader_;
         PixelPickerFunc pixel_picker_;
-        bool has_alpha_ = false;
+        ScanlineUnpackFunc scanline_unpack_;
+        bool has_alpha_  = false;
+        int proxy_level_ = 0;
+        Imath::V2i source_size_in_pixels_;
     };
 
     /* Extending std::shared_ptr<ImageBuffer> by adding a pointer to colour pipe
@@ -245,9 +295,9 @@ namespace media_reader {
 
     inline float image_aspect(const ImageBufPtr &v) {
 
-        return v ? v->image_size_in_pixels().y
-                       ? v.frame_id_.pixel_aspect() * v->image_size_in_pixels().x /
-                             v->image_size_in_pixels().y
+        return v ? v->source_size_in_pixels().y
+                       ? v.frame_id_.pixel_aspect() * v->source_size_in_pixels().x /
+                             v->source_size_in_pixels().y
                        : 16.0f / 9.0f
                  : 16.0f / 9.0f;
     }
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <vector>
+
+#include "xstudio/media_reader/image_buffer.hpp"
+
+namespace xstudio {
+namespace media_reader {
+
+    /* Proxies are reduced copies of a frame for drawing it at a fraction of
+    its resolution, as grid and composite layouts and contact sheets do.
+    Level n is 1/2^n of the frame across and down, each level being a 2x2
+    box filter of the one above. The pixels are kept in the reader's own
+    layout, so its unpack shader draws a proxy just like the frame. */
+    constexpr int max_proxy_level = 3;
+
+    // levels 1 to max_level, fewer (or none) where the frame's pixel layout
+    // isn't known (see pixel_layout) or it gets too small
+    std::vector<ImageBufPtr>
+    make_image_proxies(const ImageBuffer &buf, const int max_level = max_proxy_level);
+
+    // the smallest level that still has as many pixels across as the frame
+    // covers on screen, 0 meaning the frame itself
+    inline int proxy_level_for(const int source_width, const float onscreen_width) {
+        if (source_width <= 0 or onscreen_width <= 0.0f)
+            return 0;
+        int level = 0;
+        while (level < max_proxy_level and
+               float(source_width >> (level + 1)) >= onscreen_width)
+            level++;
+        return level;
+    }
+
+    // the frame with its pixels swapped for the proxy's, keeping everything
+    // the playhead and colour pipeline attached to it
+    inline ImageBufPtr with_proxy(const ImageBufPtr &frame, const ImageBufPtr &proxy) {
+        ImageBufPtr result(frame);
+        static_cast<ImageBufPtr::Base &>(result) =
+            static_cast<const ImageBufPtr::Base &>(proxy);
+        return result;
+    }
+
+} // namespace media_reader
+} // namespace xstudio
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <Imath/ImathBox.h>
+
+#include "xstudio/media_reader/image_buffer.hpp"
+#include "xstudio/utility/json_store.hpp"
+
+namespace xstudio {
+namespace media_reader {
+
+    /* What to measure. The region is in image pixel coordinates (max is
+    exclusive) and is clipped to the data window, an empty region means the
+    whole data window. Histograms and the waveform bin values between
+    range_min and range_max, values outside the range land in the end bins.
+    Setting a size to zero skips that measurement. */
+    struct StatisticsOptions {
+        StatisticsOptions() = default;
+        explicit StatisticsOptions(const utility::JsonStore &jsn);
+
+        [[nodiscard]] utility::JsonStore json() const;
+
+        Imath::Box2i region;
+        int histogram_bins{256};
+        float range_min{0.0f};
+        float range_max{1.0f};
+        int waveform_columns{0};
+        int waveform_rows{256};
+        int vectorscope_size{0};
+        int num_threads{0};
+    };
+
+    /* Results of image_statistics(). Channels are RGBA after the reader's
+    unpack, i.e. the same values the viewport's colour pipeline starts from.
+    The waveform is Rec.709 luma, one histogram of waveform_rows bins per
+    column, stored column by column. The vectorscope is a vectorscope_size
+    square of Cb (x) / Cr (y) counts, row by row, Cb and Cr spanning -0.5
+    to 0.5. NaN and infinite values are left out of the means, NaN values
+    out of everything else. */
+    struct ImageStatistics {
+        [[nodiscard]] utility::JsonStore json() const;
+
+        Imath::Box2i region;
+        size_t pixel_count{0};
+        std::array<float, 4> min{0.0f, 0.0f, 0.0f, 0.0f};
+        std::array<float, 4> max{0.0f, 0.0f, 0.0f, 0.0f};
+        std::array<double, 4> mean{0.0, 0.0, 0.0, 0.0};
+        std::array<std::vector<uint32_t>, 4> histograms;
+        std::vector<uint32_t> waveform;
+        std::vector<uint32_t> vectorscope;
+        int waveform_columns{0};
+        int waveform_rows{0};
+        int vectorscope_size{0};
+    };
+
+    /* Measures the decoded pixels directly from the buffer memory, no GPU
+    readback. The layout is worked out once from the shader params (see
+    pixel_layout), half, float, 8/16 bit packed and planar RGB and planar
+    YUV are decoded here; other buffers go through the reader's scanline
+    unpack. Rows are split across threads. */
+    ImageStatistics
+    image_statistics(const ImageBuffer &buf, const StatisticsOptions &options = {});
+
+} // namespace media_reader
+} // namespace xstudio
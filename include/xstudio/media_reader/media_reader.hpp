@@ -33,8 +33,10 @@
 #include "xstudio/media_reader/frame_request_queue.hpp"
 #include "xstudio/media_reader/image_buffer.hpp"
 #include "xstudio/media_reader/pixel_info.hpp"
+#include "xstudio/media_reader/read_priority.hpp"
 #include "xstudio/plugin_manager/plugin_factory.hpp"
 #include "xstudio/thumbnail/thumbnail.hpp"
+#include "xstudio/utility/frame_trace.hpp"
 #include "xstudio/utility/helpers.hpp"
 #include "xstudio/utility/json_store.hpp"
 #include "xstudio/utility/uuid.hpp"
@@ -78,6 +80,11 @@ namespace media_reader {
         [[nodiscard]] virtual ImageBuffer::PixelPickerFunc pixel_picker_func() const {
             return &MediaReader::default_pixel_picker;
         }
+        // Readers can provide a fast CPU scanline decoder for software rendering.
+        // If not provided, pixel_picker_func is used to decode pixels instead.
+        [[nodiscard]] virtual ImageBuffer::ScanlineUnpackFunc scanline_unpack_func() const {
+            return ImageBuffer::ScanlineUnpackFunc();
+        }
 
         virtual MRCertainty
         supported(const caf::uri &uri, const std::array<uint8_t, 16> &signature);
@@ -134,43 +141,23 @@ namespace media_reader {
                 [=](utility::name_atom) -> std::string { return media_reader_.name(); },
 
                 [=](get_audio_atom, const media::AVFrameID &mptr) -> result<AudioBufPtr> {
-                    AudioBufPtr mb;
-                    try {
-                        mb = media_reader_.audio(mptr);
-                        if (mb) {
-                            mb->set_media_key(mptr.key());
-                        }
-                    } catch (const std::exception &e) {
-                        return make_error(xstudio_error::error, e.what());
-                    }
-                    return mb;
+                    return read_audio(mptr, ReadCancelToken());
+                },
+
+                [=](get_audio_atom,
+                    const media::AVFrameID &mptr,
+                    const ReadCancelToken &token) -> result<AudioBufPtr> {
+                    return read_audio(mptr, token);
                 },
 
                 [=](get_image_atom, const media::AVFrameID &mptr) -> result<ImageBufPtr> {
-                    ImageBufPtr mb;
-                    try {
-                        std::string path = utility::uri_to_posix_path(mptr.uri());
-                        mb               = media_reader_.image(mptr);
-                        if (mb) {
-                            if (mb->media_key().is_null())
-                                mb->set_media_key(mptr.key());
-                            mb->set_pixel_picker_func(media_reader_.pixel_picker_func());
-                            mb->params()["path"]   = path;
-                            mb->params()["frame"]  = mptr.frame();
-                            mb->params()["reader"] = media_reader_.name();
-                        }
-                    } catch (const media_missing_error &e) {
-                        return make_error(media::media_error::missing, e.what());
-                    } catch (const media_corrupt_error &e) {
-                        return make_error(media::media_error::corrupt, e.what());
-                    } catch (const media_unsupported_error &e) {
-                        return make_error(media::media_error::unsupported, e.what());
-                    } catch (const media_unreadable_error &e) {
-                        return make_error(media::media_error::unreadable, e.what());
-                    } catch (const std::exception &e) {
-                        return make_error(xstudio_error::error, e.what());
-                    }
-                    return mb;
+                    return read_image(mptr, ReadCancelToken());
+                },
+
+                [=](get_image_atom,
+                    const media::AVFrameID &mptr,
+                    const ReadCancelToken &token) -> result<ImageBufPtr> {
+                    return read_image(mptr, token);
                 },
 
                 [=](get_media_detail_atom, const caf::uri &_uri) -> result<media::MediaDetail> {
@@ -244,6 +231,65 @@ namespace media_reader {
         caf::behavior make_behavior() override { return behavior_; }
 
       private:
+        caf::result<AudioBufPtr>
+        read_audio(const media::AVFrameID &mptr, const ReadCancelToken &token) {
+            // the request may have gone stale while it sat in our mailbox
+            if (token.cancelled())
+                return make_error(media::media_error::cancelled, "Read cancelled");
+
+            AudioBufPtr mb;
+            try {
+                ReadCancelToken::Scope scope(token);
+                mb = media_reader_.audio(mptr);
+                if (mb) {
+                    mb->set_media_key(mptr.key());
+                }
+            } catch (const media_cancelled_error &e) {
+                return make_error(media::media_error::cancelled, e.what());
+            } catch (const std::exception &e) {
+                return make_error(xstudio_error::error, e.what());
+            }
+            return mb;
+        }
+
+        caf::result<ImageBufPtr>
+        read_image(const media::AVFrameID &mptr, const ReadCancelToken &token) {
+            if (token.cancelled())
+                return make_error(media::media_error::cancelled, "Read cancelled");
+
+            ImageBufPtr mb;
+            try {
+                std::string path = utility::uri_to_posix_path(mptr.uri());
+                {
+                    ReadCancelToken::Scope scope(token);
+                    utility::TraceSpan span(utility::TraceStage::Decode, mptr.key());
+                    mb = media_reader_.image(mptr);
+                }
+                if (mb) {
+                    if (mb->media_key().is_null())
+                        mb->set_media_key(mptr.key());
+                    mb->set_pixel_picker_func(media_reader_.pixel_picker_func());
+                    mb->set_scanline_unpack_func(media_reader_.scanline_unpack_func());
+                    mb->params()["path"]   = path;
+                    mb->params()["frame"]  = mptr.frame();
+                    mb->params()["reader"] = media_reader_.name();
+                }
+            } catch (const media_cancelled_error &e) {
+                return make_error(media::media_error::cancelled, e.what());
+            } catch (const media_missing_error &e) {
+                return make_error(media::media_error::missing, e.what());
+            } catch (const media_corrupt_error &e) {
+                return make_error(media::media_error::corrupt, e.what());
+            } catch (const media_unsupported_error &e) {
+                return make_error(media::media_error::unsupported, e.what());
+            } catch (const media_unreadable_error &e) {
+                return make_error(media::media_error::unreadable, e.what());
+            } catch (const std::exception &e) {
+                return make_error(xstudio_error::error, e.what());
+            }
+            return mb;
+        }
+
         caf::behavior behavior_;
         T media_reader_;
     };
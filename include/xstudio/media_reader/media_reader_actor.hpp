@@ -4,7 +4,9 @@
 #include <caf/all.hpp>
 
 #include "xstudio/media/media.hpp"
+#include "xstudio/media_reader/file_prefetcher.hpp"
 #include "xstudio/media_reader/media_reader.hpp"
+#include "xstudio/media_reader/read_ahead.hpp"
 #include "xstudio/utility/chrono.hpp"
 #include "xstudio/utility/uuid.hpp"
 
@@ -69,8 +71,36 @@ namespace media_reader {
 
         void mark_playhead_received_precache_result(const utility::Uuid &playhead_uuid);
 
+        // cancel the playhead's precache reads that are in flight, except for
+        // frames it still wants
+        void cancel_stale_reads(
+            const utility::Uuid &playhead_uuid,
+            const media::AVFrameIDsAndTimePoints &wanted = media::AVFrameIDsAndTimePoints());
+
+        void read_done(const FrameRequest &fr);
+
+        // start pulling the files of the next frames the playhead needs read
+        // into the page cache
+        void prefetch_files(
+            const utility::Uuid &playhead_uuid, const media::AVFrameIDsAndTimePoints &frames);
+
+        // rebuild the per playhead limits on precache reads in flight from
+        // the read-ahead plans
+        void update_read_ahead_plans();
+
         void send_error_to_source(const caf::actor_addr &addr, const caf::error &err);
 
+        struct ImageBatch {
+            std::vector<media::AVFrameID> mptrs;
+            std::vector<ImageBufPtr> results;
+            caf::typed_response_promise<std::vector<ImageBufPtr>> rp;
+            size_t next    = {0};
+            size_t pending = {0};
+        };
+
+        // start reads for a batch of frames, up to the parallel read limit
+        void read_image_batch(const std::shared_ptr<ImageBatch> &batch);
+
         void process_get_media_detail_queue();
 
       private:
@@ -93,8 +123,17 @@ namespace media_reader {
         size_t max_source_count_;
         size_t max_source_age_;
 
-        FrameRequestQueue playback_precache_request_queue_;
-        FrameRequestQueue background_precache_request_queue_;
+        // playback read-ahead and background cacheing requests, by class
+        FrameRequestQueue precache_request_queue_;
+        std::map<utility::Uuid, std::map<media::MediaKey, ReadCancelToken>> in_flight_reads_;
+
+        // measured read throughput, sizes playback read-ahead and parallelism
+        ReadAheadController read_ahead_;
+        std::map<utility::Uuid, int> max_reads_in_flight_;
+
+        // files of upcoming frames read ahead of the decoders, 0 disables
+        size_t prefetch_files_ = {8};
+        FilePrefetcher prefetcher_;
 
         struct ImmediateFrameRequest {
             media::AVFrameID mptr;
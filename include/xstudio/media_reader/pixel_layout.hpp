@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "xstudio/media_reader/image_buffer.hpp"
+
+namespace xstudio {
+namespace media_reader {
+
+    /* One plane of pixel data in an ImageBuffer. Shape is rows, columns and
+    channels, strides are in bytes and format is a python struct format
+    character for a single channel value, so a plane maps directly onto the
+    python buffer protocol (and numpy) without copying. */
+    struct PixelPlane {
+        std::string name;
+        size_t offset{0};
+        std::array<size_t, 3> shape{0, 0, 0};
+        std::array<size_t, 3> strides{0, 0, 0};
+        std::string format{"B"};
+        size_t itemsize{1};
+
+        [[nodiscard]] size_t extent() const {
+            if (!shape[0] || !shape[1] || !shape[2])
+                return 0;
+            return offset + (shape[0] - 1) * strides[0] + (shape[1] - 1) * strides[1] +
+                   (shape[2] - 1) * strides[2] + itemsize;
+        }
+    };
+
+    namespace detail {
+
+        inline PixelPlane make_plane(
+            std::string name,
+            const size_t offset,
+            const size_t rows,
+            const size_t cols,
+            const size_t channels,
+            const size_t row_stride,
+            std::string format,
+            const size_t itemsize) {
+            PixelPlane p;
+            p.name     = std::move(name);
+            p.offset   = offset;
+            p.shape    = {rows, cols, channels};
+            p.strides  = {row_stride, channels * itemsize, itemsize};
+            p.format   = std::move(format);
+            p.itemsize = itemsize;
+            return p;
+        }
+
+        // OpenEXR reader, interleaved channels over the data window. Packed
+        // half rows may be padded to a 4 byte boundary.
+        inline std::vector<PixelPlane> exr_layout(const ImageBuffer &buf) {
+            const auto &sp    = buf.shader_params();
+            const auto bounds = buf.image_pixels_bounding_box();
+            const auto rows   = size_t(std::max(0, bounds.max.y - bounds.min.y));
+            const auto cols   = size_t(std::max(0, bounds.max.x - bounds.min.x));
+            const auto bpp    = sp.value("bytes_per_pixel", 0);
+            const auto stride = sp.value("line_stride", cols * std::max(bpp, 0));
+
+            // Imf::PixelType, UINT = 0, HALF = 1, FLOAT = 2, -1 is unused
+            int pix_type  = -2;
+            bool mixed    = false;
+            size_t n_chan = 0;
+            for (const auto c : {"pix_type_r", "pix_type_g", "pix_type_b", "pix_type_a"}) {
+                const auto t = sp.value(c, -1);
+                if (t == -1)
+                    continue;
+                n_chan++;
+                mixed    = mixed or (pix_type != -2 and pix_type != t);
+                pix_type = t;
+            }
+
+            if (!n_chan or bpp <= 0)
+                return {};
+
+            if (mixed)
+                return {make_plane("bytes", 0, rows, cols * bpp, 1, stride, "B", 1)};
+
+            const auto itemsize = size_t(pix_type == 1 ? 2 : 4);
+            const auto format   = pix_type == 1 ? "e" : (pix_type == 2 ? "f" : "I");
+            return {make_plane("rgba", 0, rows, cols, n_chan, stride, format, itemsize)};
+        }
+
+        // FFmpeg reader, see set_shader_pix_format_info
+        inline std::vector<PixelPlane> ffmpeg_layout(const ImageBuffer &buf) {
+            const auto &sp  = buf.shader_params();
+            const auto rows = size_t(buf.image_size_in_pixels().y);
+            const auto cols =
+                size_t(sp.value("frame_width_pixels", buf.image_size_in_pixels().x));
+            const auto rgb      = sp.value("rgb", 0);
+            const auto bits     = sp.value("bits_per_channel", 8);
+            const auto itemsize = size_t(bits > 8 ? 2 : 1);
+            const auto format   = bits > 8 ? "<H" : "B";
+
+            auto offset = [&](const char *p) {
+                return size_t(sp.value(std::string(p) + "_plane_bytes_offset", 0));
+            };
+            auto linesize = [&](const char *p) {
+                return size_t(sp.value(std::string(p) + "_linesize", 0));
+            };
+
+            switch (rgb) {
+            case 1: // RGB24
+            case 2: // BGR24
+                return {make_plane(
+                    rgb == 1 ? "rgb" : "bgr",
+                    offset("y"),
+                    rows,
+                    cols,
+                    3,
+                    linesize("y"),
+                    "B",
+                    1)};
+            case 3: // ARGB
+            case 4: // RGBA
+            case 5: // ABGR
+            case 6: // BGRA
+            {
+                static const std::array<const char *, 4> names = {
+                    "argb", "rgba", "abgr", "bgra"};
+                return {make_plane(
+                    names[rgb - 3], offset("y"), rows, cols, 4, linesize("y"), "B", 1)};
+            }
+            case 8: // RGB48LE
+            case 9: // RGBA64LE
+                return {make_plane(
+                    rgb == 8 ? "rgb" : "rgba",
+                    offset("y"),
+                    rows,
+                    cols,
+                    rgb == 8 ? 3 : 4,
+                    linesize("y"),
+                    "<H",
+                    2)};
+            case 7: // planar GBR(A), 10 to 16 bit
+            {
+                std::vector<PixelPlane> planes;
+                const std::array<const char *, 4> slots = {"y", "u", "v", "a"};
+                const std::array<const char *, 4> names = {"g", "b", "r", "a"};
+                for (size_t i = 0; i < 4; ++i) {
+                    if (linesize(slots[i]))
+                        planes.push_back(make_plane(
+                            names[i],
+                            offset(slots[i]),
+                            rows,
+                            cols,
+                            1,
+                            linesize(slots[i]),
+                            "<H",
+                            2));
+                }
+                return planes;
+            }
+            case 0: // planar YUV(A), chroma may be subsampled
+            {
+                std::vector<PixelPlane> planes;
+                const auto sx = sp.value("half_scale_uvx", 0);
+                const auto sy = sp.value("half_scale_uvy", 0);
+                for (const auto p : {"y", "u", "v", "a"}) {
+                    if (!linesize(p))
+                        continue;
+                    const bool chroma = p[0] == 'u' or p[0] == 'v';
+                    planes.push_back(make_plane(
+                        p,
+                        offset(p),
+                        chroma ? (rows + (1 << sy) - 1) >> sy : rows,
+                        chroma ? (cols + (1 << sx) - 1) >> sx : cols,
+                        1,
+                        linesize(p),
+                        format,
+                        itemsize));
+                }
+                return planes;
+            }
+            default:
+                break;
+            }
+            return {};
+        }
+
+        // PPM reader, the file data as is, so 16 bit is big endian
+        inline std::vector<PixelPlane> ppm_layout(const ImageBuffer &buf) {
+            const auto &sp      = buf.shader_params();
+            const auto rows     = size_t(sp.value("height", 0));
+            const auto cols     = size_t(sp.value("width", 0));
+            const auto itemsize = size_t(sp.value("bytes_per_channel", 1));
+            return {make_plane(
+                "rgb",
+                0,
+                rows,
+                cols,
+                3,
+                cols * 3 * itemsize,
+                itemsize == 2 ? ">H" : "B",
+                itemsize)};
+        }
+
+    } // namespace detail
+
+    /* The planes of pixel data in the buffer, derived from the shader
+    params of the reader that decoded it. Buffers from readers whose layout
+    isn't known here (or that don't fit the buffer) are described as a single
+    row of bytes. */
+    inline std::vector<PixelPlane> pixel_layout(const ImageBuffer &buf) {
+        std::vector<PixelPlane> planes;
+        if (!buf.buffer() or !buf.size())
+            return planes;
+
+        const auto &sp = buf.shader_params();
+        if (sp.is_object()) {
+            if (sp.contains("pix_type_r"))
+                planes = detail::exr_layout(buf);
+            else if (sp.contains("rgb"))
+                planes = detail::ffmpeg_layout(buf);
+            else if (sp.contains("bytes_per_channel"))
+                planes = detail::ppm_layout(buf);
+        }
+
+        bool valid = !planes.empty();
+        for (const auto &p : planes)
+            valid = valid and p.extent() and p.extent() <= buf.size();
+
+        if (!valid)
+            planes = {detail::make_plane("bytes", 0, 1, buf.size(), 1, buf.size(), "B", 1)};
+
+        return planes;
+    }
+
+} // namespace media_reader
+} // namespace xstudio
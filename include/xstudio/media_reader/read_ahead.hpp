@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <map>
+#include <set>
+
+#include <nlohmann/json.hpp>
+
+#include "xstudio/media/media.hpp"
+#include "xstudio/utility/chrono.hpp"
+#include "xstudio/utility/uuid.hpp"
+
+namespace xstudio {
+namespace media_reader {
+
+    /* Class ReadAheadController
+
+    Sizes playback read-ahead from measured decode throughput. Completed reads
+    are fed in per media source, giving a smoothed read latency (with its mean
+    deviation, in the manner of a TCP round trip estimator) and a bytes per
+    second rate. Each playhead's lookahead request tells us the rate it is
+    consuming frames at and the sources it is about to show. From those the
+    controller works out how many reads the playhead needs in flight to keep
+    up, and how far ahead it has to read so that decode latency and its jitter
+    are hidden.
+    */
+    class ReadAheadController {
+      public:
+        struct Plan {
+            // frames to read ahead, 0 until reads of the playhead's sources
+            // have been measured
+            int frames = {0};
+            // precache reads the playhead may have in flight at once
+            int parallel_reads = {1};
+            double demand_fps  = {0.0};
+            // frames per second the planned parallel reads can deliver
+            double throughput_fps = {0.0};
+        };
+
+        explicit ReadAheadController(const int max_parallel_reads = 3)
+            : max_parallel_reads_(max_parallel_reads) {}
+
+        void set_max_parallel_reads(const int max_parallel_reads);
+        [[nodiscard]] int max_parallel_reads() const { return max_parallel_reads_; }
+
+        void record_read(
+            const utility::Uuid &source_uuid,
+            const utility::time_point &started,
+            const utility::time_point &finished,
+            const size_t bytes);
+
+        // a fresh playback lookahead from a playhead, the time points of the
+        // frames give its demand and the frames give its sources
+        void set_lookahead(
+            const utility::Uuid &playhead_uuid,
+            const media::AVFrameIDsAndTimePoints &lookahead);
+
+        // the playhead has stopped playing or gone away
+        void clear_playhead(const utility::Uuid &playhead_uuid);
+
+        [[nodiscard]] Plan plan(const utility::Uuid &playhead_uuid) const;
+
+        // planned parallel reads of the playheads that are playing
+        [[nodiscard]] std::map<utility::Uuid, int> parallel_reads() const;
+
+        // forget sources that have not been read for max_age
+        void prune(const utility::time_point &now, const std::chrono::seconds max_age);
+
+        // per playhead plans and per source measurements
+        [[nodiscard]] nlohmann::json json() const;
+
+      private:
+        struct SourceStats {
+            double latency_s   = {0.0};
+            double deviation_s = {0.0};
+            double bytes_per_s = {0.0};
+            uint64_t reads     = {0};
+            utility::time_point last_read;
+        };
+
+        struct PlayheadDemand {
+            double demand_fps = {0.0};
+            std::set<utility::Uuid> sources;
+        };
+
+        int max_parallel_reads_;
+        std::map<utility::Uuid, SourceStats> sources_;
+        std::map<utility::Uuid, PlayheadDemand> playheads_;
+    };
+
+} // namespace media_reader
+} // namespace xstudio
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+
+#include <nlohmann/json.hpp>
+
+#include "xstudio/utility/chrono.hpp"
+#include "xstudio/utility/frame_trace.hpp"
+
+namespace xstudio {
+namespace media_reader {
+
+    /* Classes of read work, highest priority first. Queued reads are
+    dispatched by class and then by deadline, and a read may preempt a running
+    read of a lower class on the same source. */
+    enum ReadPriority {
+        RP_IMMEDIATE = 0, // frame is wanted on screen now, e.g. scrubbing
+        RP_PLAYBACK,      // read-ahead for playback
+        RP_BACKGROUND,    // filling the cache while the playhead is idle
+        RP_THUMBNAIL,
+        RP_COUNT
+    };
+
+    const char *to_string(const ReadPriority priority);
+
+    /* Class ReadCancelToken
+
+    Shared between whoever asked for a read and the reader doing it. Readers
+    that decode in pieces (scanline blocks, tiles, slices) call
+    throw_if_cancelled() between the pieces, so a read that has gone stale or
+    been preempted gives up its worker part way through a decode. A child token
+    is also cancelled when its parent is.
+    */
+    class ReadCancelToken {
+      public:
+        ReadCancelToken() = default;
+        ReadCancelToken(
+            const ReadPriority priority,
+            const utility::time_point &deadline,
+            const ReadCancelToken &parent = ReadCancelToken());
+
+        [[nodiscard]] explicit operator bool() const { return bool(state_); }
+
+        void cancel() const;
+        [[nodiscard]] bool cancelled() const;
+
+        [[nodiscard]] ReadPriority priority() const {
+            return state_ ? state_->priority : RP_IMMEDIATE;
+        }
+        [[nodiscard]] utility::time_point deadline() const {
+            return state_ ? state_->deadline : utility::time_point();
+        }
+
+        // the token of the read running on this thread
+        [[nodiscard]] static const ReadCancelToken &current();
+        // throws media_cancelled_error if the read on this thread was cancelled
+        static void throw_if_cancelled();
+
+        class Scope;
+
+      private:
+        struct State {
+            std::atomic<bool> cancelled = {false};
+            ReadPriority priority       = {RP_IMMEDIATE};
+            utility::time_point deadline;
+            std::shared_ptr<const State> parent;
+        };
+
+        std::shared_ptr<State> state_;
+    };
+
+    // makes a token current on this thread for the lifetime of the scope
+    class ReadCancelToken::Scope {
+      public:
+        explicit Scope(const ReadCancelToken &token);
+        ~Scope();
+
+        Scope(const Scope &)            = delete;
+        Scope &operator=(const Scope &) = delete;
+
+      private:
+        ReadCancelToken previous_;
+    };
+
+    /* Class ReadMetrics
+
+    Per class counts and latencies of reads, shared by the reader actors.
+    Queue wait is the time from a read being queued to it starting on a worker,
+    read time is the time the worker spent on it.
+    */
+    class ReadMetrics {
+      public:
+        enum Outcome { RO_COMPLETED = 0, RO_FAILED, RO_CANCELLED, RO_PREEMPTED, RO_COUNT };
+
+        static ReadMetrics &instance();
+
+        void record(
+            const ReadPriority priority,
+            const Outcome outcome,
+            const utility::time_point &queued,
+            const utility::time_point &started,
+            const utility::time_point &finished);
+
+        [[nodiscard]] uint64_t
+        count(const ReadPriority priority, const Outcome outcome = RO_COMPLETED) const;
+
+        // per class counts, completed reads per second since the last clear
+        // and the queue wait and read time histograms
+        [[nodiscard]] nlohmann::json json() const;
+
+        void clear();
+
+      private:
+        ReadMetrics();
+
+        struct ClassMetrics {
+            std::array<std::atomic<uint64_t>, RO_COUNT> outcomes = {};
+            utility::TraceHistogram wait;
+            utility::TraceHistogram read;
+        };
+
+        std::array<ClassMetrics, RP_COUNT> classes_;
+        std::atomic<int64_t> since_ns_;
+    };
+
+} // namespace media_reader
+} // namespace xstudio
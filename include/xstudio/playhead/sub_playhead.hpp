@@ -72,6 +72,12 @@ namespace playhead {
 
         void update_playback_precache_requests(caf::typed_response_promise<bool> &rp);
 
+        void update_adaptive_read_ahead();
+
+        void update_cache_hint();
+
+        void clear_cache_hint();
+
         void make_static_precache_request(
             caf::typed_response_promise<bool> &rp, const bool start_precache);
 
@@ -163,8 +169,21 @@ namespace playhead {
         int pre_cache_read_ahead_frames_                           = {32};
         std::chrono::milliseconds static_cache_delay_milliseconds_ = {
             std::chrono::milliseconds(500)};
+
+        // with adaptive read-ahead the global reader sizes our read-ahead from
+        // measured decode throughput, pre_cache_read_ahead_frames_ is then the
+        // most we will read ahead
+        bool adaptive_read_ahead_       = {true};
+        int min_read_ahead_frames_      = {8};
+        int adaptive_read_ahead_frames_ = {0};
+
+        // the image cache has been told the frames we are looping over, see
+        // update_cache_hint
+        bool cache_hint_sent_ = {false};
+
         caf::behavior behavior_;
         caf::actor pre_reader_;
+        caf::actor image_cache_;
         utility::UuidActor source_;
         caf::actor parent_;
         caf::actor event_group_;
@@ -86,6 +86,8 @@ namespace playlist {
         void open_media_readers();
         void open_media_reader(caf::actor media_actor);
         void send_content_changed_event(const bool queue = true);
+        // the image cache accounts our media's frames to the playlist
+        void update_cache_usage();
         void sort_by_media_display_info(const int sort_column_index, const bool ascending);
 
         void duplicate(
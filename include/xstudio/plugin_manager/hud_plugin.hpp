@@ -18,7 +18,8 @@ namespace plugin {
      *   Subclass to create custom HUDs in xStudio - which can be activated and configured
      *   from the 'HUD' toolbar button. The HUD graphics/text overlay can be implemented
      *   either as QML or an OpenGL renderer. Refer to the PixelProbe plugin example for
-     *   a reference implementation.
+     *   a reference implementation. HUDs that show scopes or region statistics can
+     *   measure the frame on the CPU with media_reader::image_statistics.
      */
 
     class HUDPluginBase : public plugin::StandardPlugin {
@@ -78,6 +78,18 @@ namespace plugin {
             const float device_pixel_ratio,
             const bool have_alpha_buffer){};
 
+        /* Software rendering equivalent of render_image_overlay, called by the
+        CPU viewport renderer when no GPU is available. 'rgba' is a window
+        sized buffer of RGBA float pixels, bottom scanline first, that the
+        overlay should composite its graphics into. */
+        virtual void render_image_overlay_cpu(
+            float *rgba,
+            const Imath::V2i &window_size,
+            const Imath::M44f &transform_window_to_viewport_space,
+            const Imath::M44f &transform_viewport_to_image_space,
+            const float viewport_du_dpixel,
+            const xstudio::media_reader::ImageBufPtr &frame){};
+
         [[nodiscard]] virtual RenderPass preferred_render_pass() const { return AfterImage; }
     };
 
@@ -2,34 +2,61 @@
 #pragma once
 
 #include <list>
+#include <optional>
+#include <set>
 #include <string>
 
+#include <nlohmann/json.hpp>
+
 #include "xstudio/plugin_manager/plugin_factory.hpp"
 
 namespace xstudio {
 namespace plugin_manager {
 
+    /* Class PluginEntry
+
+    A plugin known to the manager. The description of the plugin is held by the
+    entry so that it can be listed without its library being loaded, the factory
+    is only set once the library has been loaded (see PluginManager::factory).
+    */
     class PluginEntry {
       public:
-        PluginEntry(std::shared_ptr<PluginFactory> pf, std::string path)
-            : plugin_factory_(std::move(pf)), path_(std::move(path)) {
-            // auto enable xstudio plugins
-            // we might want to use uuids list.
-            if (plugin_factory_.get()->author() != "xStudio")
-                enabled_ = false;
-        }
+        PluginEntry(std::shared_ptr<PluginFactory> pf, std::string path);
+        // from a plugin manifest entry, the library isn't loaded.
+        PluginEntry(const nlohmann::json &jsn, std::string path);
 
         virtual ~PluginEntry() = default;
 
         [[nodiscard]] std::string path() const { return path_; }
         [[nodiscard]] PluginFactory *factory() const { return plugin_factory_.get(); }
+        [[nodiscard]] bool loaded() const { return plugin_factory_ != nullptr; }
         [[nodiscard]] bool enabled() const { return enabled_; }
         void set_enabled(const bool enable) { enabled_ = enable; }
+        void set_factory(std::shared_ptr<PluginFactory> pf) { plugin_factory_ = std::move(pf); }
+
+        [[nodiscard]] utility::Uuid uuid() const { return uuid_; }
+        [[nodiscard]] std::string name() const { return name_; }
+        [[nodiscard]] PluginType type() const { return type_; }
+        [[nodiscard]] bool resident() const { return resident_; }
+        [[nodiscard]] std::string author() const { return author_; }
+        [[nodiscard]] std::string description() const { return description_; }
+        [[nodiscard]] semver::version version() const { return version_; }
+
+        // manifest entry
+        [[nodiscard]] nlohmann::json json() const;
 
       private:
         std::shared_ptr<PluginFactory> plugin_factory_;
         std::string path_;
         bool enabled_{true};
+
+        utility::Uuid uuid_;
+        std::string name_;
+        PluginType type_{PluginFlags::PF_CUSTOM};
+        bool resident_{false};
+        std::string author_;
+        std::string description_;
+        semver::version version_;
     };
 
     class PluginDetail {
@@ -40,13 +67,13 @@ namespace plugin_manager {
         PluginDetail(const PluginEntry &pe)
             : enabled_(pe.enabled()),
               path_(pe.path()),
-              uuid_(pe.factory()->uuid()),
-              name_(pe.factory()->name()),
-              type_(pe.factory()->type()),
-              resident_(pe.factory()->resident()),
-              author_(pe.factory()->author()),
-              description_(pe.factory()->description()),
-              version_(pe.factory()->version()) {}
+              uuid_(pe.uuid()),
+              name_(pe.name()),
+              type_(pe.type()),
+              resident_(pe.resident()),
+              author_(pe.author()),
+              description_(pe.description()),
+              version_(pe.version()) {}
 
         bool enabled_;
         std::string path_;
@@ -83,8 +110,20 @@ namespace plugin_manager {
         void emplace_front_path(const std::string plugin_path) {
             plugin_paths_.emplace_front(plugin_path);
         }
+        // Plugins in libraries listed in the manifest with a matching mtime
+        // and size are added without loading the library, the rest are loaded
+        // and the manifest is rewritten.
         size_t load_plugins();
 
+        // no manifest is used when the path is empty (the default)
+        void set_manifest_path(const std::string &path) { manifest_path_ = path; }
+        [[nodiscard]] const std::string &manifest_path() const { return manifest_path_; }
+
+        // loads the plugin library if needed, throws if it can't be loaded.
+        PluginFactory *factory(const utility::Uuid &uuid);
+
+        [[nodiscard]] size_t libraries_loaded() const { return loaded_libraries_.size(); }
+
         std::list<std::string> &plugin_paths() { return plugin_paths_; }
         std::vector<PluginDetail> plugin_detail() {
             std::vector<PluginDetail> details;
@@ -105,8 +144,19 @@ namespace plugin_manager {
         [[nodiscard]] std::string spawn_menu_ui(const utility::Uuid &uuid);
 
       private:
+        // factories in the library, nullopt if it can't be opened
+        std::optional<std::vector<std::shared_ptr<PluginFactory>>>
+        load_library(const std::string &path);
+        void load_manifest();
+        void save_manifest() const;
+
         std::list<std::string> plugin_paths_;
         std::map<utility::Uuid, PluginEntry> factories_;
+
+        std::string manifest_path_;
+        // library path to manifest entry
+        nlohmann::json manifest_;
+        std::set<std::string> loaded_libraries_;
     };
 } // namespace plugin_manager
 } // namespace xstudio
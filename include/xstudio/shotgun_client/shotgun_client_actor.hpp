@@ -2,6 +2,7 @@
 #pragma once
 
 #include <caf/all.hpp>
+#include <map>
 #include <queue>
 
 #include "xstudio/shotgun_client/shotgun_client.hpp"
@@ -113,6 +114,16 @@ namespace shotgun_client {
             const std::vector<std::string> &fields,
             caf::typed_response_promise<utility::JsonStore> rp);
 
+        void queue_entity_request(
+            const std::string &entity,
+            const int record_id,
+            const std::vector<std::string> &fields,
+            caf::typed_response_promise<utility::JsonStore> rp);
+
+        // fetch the records of every queued request for entity and fields
+        // with one id filtered GET
+        void request_entity_batch(const std::string &entity, const std::string &fields);
+
         void request_entity_search(
             const std::string &entity,
             const utility::JsonStore &conditions,
@@ -204,6 +215,12 @@ namespace shotgun_client {
         caf::actor_addr secret_source_;
         caf::actor http_;
         caf::actor event_group_;
+
+        // entity requests waiting to be batched, by entity and fields
+        std::map<
+            std::pair<std::string, std::string>,
+            std::vector<std::pair<int, caf::typed_response_promise<utility::JsonStore>>>>
+            entity_batches_;
     };
 } // namespace shotgun_client
 } // namespace xstudio
@@ -11,6 +11,8 @@ namespace xstudio {
 namespace ui {
     namespace canvas {
 
+        struct CaptionGeometry;
+
         struct Caption {
 
             // JSON serialisation requires default constructible types
@@ -33,7 +35,7 @@ namespace ui {
 
             Imath::Box2f bounding_box() const;
 
-            std::vector<float> vertices() const;
+            const std::vector<float> &vertices() const;
 
             std::string hash() const;
 
@@ -54,8 +56,8 @@ namespace ui {
             void update_vertices() const;
 
             mutable std::string hash_;
-            mutable Imath::Box2f bounding_box_;
-            mutable std::vector<float> vertices_;
+            // shared with the TessellationCache and any copies of this caption
+            mutable std::shared_ptr<const CaptionGeometry> geometry_;
         };
 
         void from_json(const nlohmann::json &j, Caption &c);
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <Imath/ImathMatrix.h>
+#include <Imath/ImathVec.h>
+#include <Imath/ImathBox.h>
+
+#include "xstudio/ui/canvas/canvas.hpp"
+
+namespace xstudio {
+namespace ui {
+    namespace canvas {
+
+        /* Class CPUCanvasRenderer
+
+        Software rasteriser for canvas strokes, used by the CPU viewport renderer
+        when rendering annotations without a GPU. It mirrors the behaviour of
+        OpenGLStrokeRenderer: strokes are drawn in order as round-capped
+        segments with a soft, anti-aliased edge, and erase strokes remove the
+        pen strokes that were drawn before them.
+
+        Captions and shapes are not rasterised.
+
+        The target is a window sized buffer of RGBA float pixels with the bottom
+        scanline first (matching an OpenGL framebuffer read back).
+        */
+        class CPUCanvasRenderer {
+
+          public:
+            CPUCanvasRenderer() = default;
+
+            void render_canvas(
+                const Canvas &canvas,
+                float *rgba,
+                const Imath::V2i &window_size,
+                const Imath::M44f &transform_window_to_viewport_space,
+                const Imath::M44f &transform_viewport_to_image_space,
+                const float viewport_du_dpixel,
+                const float opacity = 1.0f) const;
+
+            void render_strokes(
+                const std::vector<Stroke> &strokes,
+                float *rgba,
+                const Imath::V2i &window_size,
+                const Imath::M44f &transform_window_to_viewport_space,
+                const Imath::M44f &transform_viewport_to_image_space,
+                const float viewport_du_dpixel,
+                const float opacity = 1.0f) const;
+        };
+
+    } // end namespace canvas
+} // end namespace ui
+} // end namespace xstudio
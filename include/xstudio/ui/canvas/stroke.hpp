@@ -50,9 +50,6 @@ namespace ui {
             void add_point(const Imath::V2f &pt);
 
             std::vector<Imath::V2f> vertices() const;
-
-          private:
-            mutable std::vector<Imath::V2f> vertices_;
         };
 
         void from_json(const nlohmann::json &j, Stroke &s);
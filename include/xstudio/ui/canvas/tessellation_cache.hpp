@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <Imath/ImathBox.h>
+#include <Imath/ImathVec.h>
+
+#include "xstudio/ui/canvas/caption.hpp"
+#include "xstudio/ui/canvas/stroke.hpp"
+
+namespace xstudio {
+namespace ui {
+    namespace canvas {
+
+        struct CaptionGeometry {
+            std::vector<float> vertices;
+            Imath::Box2f bounding_box;
+        };
+
+        typedef std::shared_ptr<const std::vector<Imath::V2f>> StrokeVerticesPtr;
+        typedef std::shared_ptr<const CaptionGeometry> CaptionGeometryPtr;
+
+        /* Class TessellationCache
+
+        Process wide cache of the geometry generated for strokes and captions
+        when they are drawn, keyed on a hash of their content.
+
+        Canvas items are copied and rebuilt from JSON all the time (e.g. every
+        time a playhead fetches the bookmarks for the frames it is playing) so
+        geometry cached on the items themselves is usually lost before it can
+        be reused. Looking it up by content means that any copy of an item
+        finds the geometry generated for the first one.
+
+        Memory use is bounded - the least recently used entries are evicted
+        when the total size of the cached geometry goes over the limit.
+        */
+        class TessellationCache {
+
+          public:
+            static TessellationCache &instance();
+
+            /* Returns the per vertex (line start, line end) pairs used to draw
+            the stroke, 6 vertices per segment (see OpenGLStrokeRenderer) */
+            StrokeVerticesPtr stroke_vertices(const Stroke &stroke);
+
+            CaptionGeometryPtr caption_geometry(const Caption &caption);
+
+            void set_max_bytes(const size_t max_bytes);
+            [[nodiscard]] size_t max_bytes() const;
+            [[nodiscard]] size_t bytes() const;
+            [[nodiscard]] size_t size() const;
+            void clear();
+
+            [[nodiscard]] size_t hits() const;
+            [[nodiscard]] size_t misses() const;
+
+            // exposed for testing/benchmarking, these bypass the cache
+            static std::vector<Imath::V2f> make_stroke_vertices(const Stroke &stroke);
+            static CaptionGeometry make_caption_geometry(const Caption &caption);
+
+            static size_t content_hash(const Stroke &stroke);
+            static size_t content_hash(const Caption &caption);
+
+          private:
+            TessellationCache() = default;
+
+            struct Entry {
+                size_t key;
+                size_t bytes;
+                StrokeVerticesPtr stroke;
+                CaptionGeometryPtr caption;
+            };
+            typedef std::list<Entry> EntryList;
+
+            const Entry *lookup(const size_t key);
+            void insert(Entry &&entry);
+            void evict();
+
+            mutable std::mutex mutex_;
+            EntryList lru_;
+            std::unordered_map<size_t, EntryList::iterator> index_;
+            size_t bytes_     = {0};
+            size_t max_bytes_ = {64 * 1024 * 1024};
+            size_t hits_      = {0};
+            size_t misses_    = {0};
+        };
+
+    } // end namespace canvas
+} // end namespace ui
+} // end namespace xstudio
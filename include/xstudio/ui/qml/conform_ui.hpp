@@ -75,6 +75,7 @@ namespace ui {
                 const QModelIndex &sequenceIndex) const;
 
           signals:
+            void conformProgress(const QString &stage, const int done, const int total);
 
           private:
             QFuture<QList<QUuid>> conformItemsFuture(
@@ -4,6 +4,7 @@
 #include "xstudio/ui/qt/viewport_widget.hpp"
 #include "xstudio/thumbnail/thumbnail.hpp"
 #include "xstudio/ui/viewport/viewport_gpu_post_processor.hpp"
+#include "xstudio/ui/viewport/cpu_viewport_renderer.hpp"
 
 #include <QString>
 #include <QUrl>
@@ -97,6 +98,15 @@ namespace ui {
 
             void initGL();
 
+            void initSoftwareRender();
+
+            void renderSoftware(
+                const int w,
+                const int h,
+                const bool sync_fetch_playhead_image,
+                const utility::time_point &tp,
+                const media_reader::ImageBufPtr &image_to_use);
+
             void exportToEXR(const media_reader::ImageBufPtr &image, const caf::uri path);
 
             media_reader::ImageBufPtr renderMediaFrameToImage(
@@ -171,6 +181,11 @@ namespace ui {
             QQmlEngine *qml_engine_              = nullptr;
             ui::qml::Helpers *helper_            = nullptr;
             bool overlays_loaded_                = false;
+
+            // software (CPU) rendering is used when no OpenGL context can be
+            // made or if XSTUDIO_SOFTWARE_RENDER is set in the environment
+            bool software_render_ = false;
+            std::shared_ptr<viewport::CPUViewportRenderer> cpu_renderer_;
         };
     } // namespace qt
 } // namespace ui
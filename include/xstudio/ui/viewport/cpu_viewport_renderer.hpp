@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "xstudio/ui/viewport/enums.hpp"
+#include "xstudio/ui/viewport/viewport_renderer_base.hpp"
+#include "xstudio/utility/worker_pool.hpp"
+
+namespace xstudio {
+namespace ui {
+    namespace viewport {
+
+        /**
+         *  @brief CPUViewportRenderer class.
+         *
+         *  @details
+         *   Software implementation of ViewportRenderer for use where no GPU is
+         *   available (e.g. headless render farm nodes). Images are unpacked with
+         *   the reader's scanline unpacker, resampled through the same layout
+         *   transforms as the OpenGL renderer and colour managed with the CPU
+         *   processors provided by the colour pipeline. Overlays can draw into
+         *   the result via ViewportOverlayRenderer::render_image_overlay_cpu.
+         *
+         *   The result is held in an RGBA float framebuffer laid out like an
+         *   OpenGL framebuffer (i.e. bottom scanline first).
+         */
+        class CPUViewportRenderer : public ViewportRenderer {
+
+          public:
+            CPUViewportRenderer(const int num_threads = 0);
+            ~CPUViewportRenderer() override = default;
+
+            void render(
+                const media_reader::ImageBufDisplaySetPtr &images,
+                const Imath::M44f &window_to_viewport_matrix,
+                const Imath::M44f &viewport_to_image_matrix,
+                const Imath::V2i &window_size,
+                const float device_pixel_ratio,
+                const std::map<utility::Uuid, plugin::ViewportOverlayRendererPtr>
+                    &overlay_renderers) override;
+
+            [[nodiscard]] const std::vector<float> &framebuffer() const { return framebuffer_; }
+            [[nodiscard]] const Imath::V2i &framebuffer_size() const {
+                return framebuffer_size_;
+            }
+
+            /**
+             *  @brief Copy the last render into an image buffer.
+             *
+             *  @details The pixel layout matches what is read back from the OpenGL
+             *  renderer's framebuffer for the same format, so the result can be
+             *  consumed by the same downstream code.
+             */
+            void copy_framebuffer(
+                media_reader::ImageBufPtr &destination_image, const ImageFormat format) const;
+
+          protected:
+            void pre_init() override {}
+
+          private:
+            void draw_image(
+                const media_reader::ImageBufPtr &image,
+                const media_reader::ImageSetLayoutDataPtr &layout_data,
+                const int index,
+                const Imath::M44f &window_to_viewport_matrix,
+                const Imath::M44f &viewport_to_image_space,
+                const float viewport_du_dx);
+
+            void parallel_rows(
+                const int num_rows,
+                const std::function<void(const int, const int)> &func) const;
+
+            std::vector<float> framebuffer_;
+            Imath::V2i framebuffer_size_ = {0, 0};
+            // kept for the life of the renderer, rows are split several times a frame
+            std::unique_ptr<utility::WorkerPool> workers_;
+        };
+
+    } // namespace viewport
+} // namespace ui
+} // namespace xstudio
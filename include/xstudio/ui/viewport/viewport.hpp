@@ -133,10 +133,20 @@ namespace ui {
              * data or other state/data initialisation of graphics resources
              */
             void init() {
-                if (active_renderer_)
-                    active_renderer_->init();
+                if (renderer())
+                    renderer()->init();
             }
 
+            /**
+             *  @brief Use the given renderer in place of the one provided by the
+             *  viewport layout.
+             *
+             *  @details Used by the offscreen viewport to render in software where
+             *  there is no GPU. Pass an empty pointer to revert to the layout's
+             *  renderer.
+             */
+            void set_renderer_override(const ViewportRendererPtr &renderer);
+
             /**
              *  @brief Inform the viewport of how its coordinate system maps to the
              *  coordinates of the canvas/scene into which it is drawn.
@@ -370,6 +380,10 @@ namespace ui {
 
             void calc_image_bounds_in_viewport_pixels();
 
+            // tells the frame queue the proxy level the on screen frames can
+            // be drawn from, see media_cache::proxy_atom
+            void update_proxy_level();
+
             void update_image_resolutions();
 
             utility::JsonStore settings_;
@@ -413,6 +427,8 @@ namespace ui {
             bool needs_redraw_       = {true};
             bool hover_image_select_ = {false};
             bool has_overlays_       = {true};
+            bool use_proxies_        = {true};
+            int proxy_level_         = {0};
             std::set<int> held_keys_;
             std::vector<Imath::Box2f> image_bounds_in_viewport_pixels_;
             std::vector<Imath::V2i> image_resolutions_;
@@ -473,7 +489,12 @@ namespace ui {
             };
             std::vector<ViewportLayout> viewport_layouts_;
 
+            [[nodiscard]] const ViewportRendererPtr &renderer() const {
+                return renderer_override_ ? renderer_override_ : active_renderer_;
+            }
+
             ViewportRendererPtr active_renderer_;
+            ViewportRendererPtr renderer_override_;
         };
     } // namespace viewport
 } // namespace ui
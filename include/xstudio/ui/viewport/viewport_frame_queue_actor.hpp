@@ -68,6 +68,13 @@ namespace ui {
 
             void clear_images_from_old_playheads();
 
+            // tells the image cache which proxy level our playheads' frames
+            // are wanted at, 0 for full resolution, or that we no longer show
+            // the playheads
+            void send_proxy_demand(const int level);
+            void withdraw_proxy_demand(const utility::UuidVector &playheads);
+            utility::UuidVector proxy_demand_playheads() const;
+
             void append_overlays_data(
                 caf::typed_response_promise<media_reader::ImageBufDisplaySetPtr> rp,
                 media_reader::ImageBufDisplaySet *result);
@@ -122,6 +129,12 @@ namespace ui {
             std::string viewport_layout_mode_name_;
 
             double playhead_velocity_ = {1.0};
+
+            caf::actor image_cache_;
+            int proxy_level_ = {0};
+            // tells our proxy demand apart from other viewports' showing the
+            // same playheads
+            const utility::Uuid proxy_demand_uuid_ = {utility::Uuid::generate()};
         };
 
     } // namespace viewport
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "xstudio/utility/json_store.hpp"
+
+namespace xstudio {
+namespace utility {
+
+    /* Compact binary (MessagePack) storage for json values. Objects and arrays
+    that encode to at least share_threshold bytes are stored once in the pool and
+    referenced by id, children before parents. A subtree that turns up unchanged
+    in many values, like the untouched clips of a track in successive edits, only
+    costs its memory once. */
+    class CompactJsonPool {
+      public:
+        // a stored value, holding references on the pool blobs it uses.
+        struct Handle {
+            std::vector<uint8_t> data;
+            std::vector<uint64_t> blobs;
+        };
+
+        explicit CompactJsonPool(const size_t share_threshold = 256)
+            : share_threshold_(share_threshold) {}
+
+        CompactJsonPool(const CompactJsonPool &)            = delete;
+        CompactJsonPool &operator=(const CompactJsonPool &) = delete;
+
+        [[nodiscard]] Handle store(const nlohmann::json &value);
+        [[nodiscard]] nlohmann::json load(const Handle &handle) const;
+
+        // drops the references held by the handle, blobs nothing uses are freed.
+        void release(Handle &handle);
+        void clear();
+
+        // memory held by shared blobs, each counted once.
+        [[nodiscard]] size_t bytes() const { return bytes_; }
+        [[nodiscard]] size_t blob_count() const { return blobs_.size(); }
+
+        [[nodiscard]] static size_t bytes(const Handle &handle) {
+            return handle.data.size() + handle.blobs.size() * sizeof(uint64_t);
+        }
+
+      private:
+        struct Blob {
+            std::vector<uint8_t> data;
+            std::vector<uint64_t> children;
+            size_t refs{0};
+        };
+
+        nlohmann::json intern(const nlohmann::json &value, std::vector<uint64_t> &refs);
+        void resolve(nlohmann::json &value) const;
+        void unref(const uint64_t id);
+
+        size_t share_threshold_;
+        size_t bytes_{0};
+        uint64_t next_id_{1};
+        std::unordered_map<uint64_t, Blob> blobs_;
+        // views into the blob data, node based storage keeps them valid.
+        std::unordered_map<std::string_view, uint64_t> index_;
+    };
+
+} // namespace utility
+} // namespace xstudio
@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "xstudio/utility/chrono.hpp"
+#include "xstudio/utility/uuid.hpp"
+
+namespace xstudio {
+namespace utility {
+
+    /* Stages of the frame pipeline that are traced, from the request for a
+    frame through to it being swapped onto the display */
+    enum class TraceStage : uint8_t {
+        RequestQueueWait, // time a precache request waited in the FrameRequestQueue
+        Decode,           // reader plugin image() call
+        CacheStore,       // GlobalImageCacheActor store
+        CacheRetrieve,    // GlobalImageCacheActor retrieve
+        ReceiveFromCache, // SubPlayhead request to image arriving back
+        ViewportSchedule, // ViewportFrameQueueActor picking frames for display
+        TextureUpload,    // pixel upload in GLDoubleBufferedTexture
+        Swap,             // interval between framebuffer swaps (FpsMonitor)
+        Count
+    };
+
+    const char *to_string(const TraceStage stage);
+
+    struct TraceEvent {
+        TraceStage stage;
+        int64_t start_ns;
+        int64_t end_ns;
+        size_t key_hash;
+        // key is truncated to fit, it is only used to label events
+        std::array<char, 88> key;
+        Uuid playhead;
+        // index of the recording thread, set when events are read
+        int tid = {0};
+
+        [[nodiscard]] std::string_view key_view() const { return std::string_view(key.data()); }
+    };
+
+    /* Log2 histogram of durations in microseconds - bucket 0 holds durations
+    under 1us, bucket n holds durations in [2^(n-1), 2^n) us. */
+    class TraceHistogram {
+      public:
+        static constexpr size_t num_buckets = 32;
+
+        void add(const int64_t duration_ns);
+        void clear();
+
+        [[nodiscard]] uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+        [[nodiscard]] std::array<uint64_t, num_buckets> buckets() const;
+
+        // approximate, returns the upper bound of the bucket holding the percentile
+        [[nodiscard]] double percentile_us(const double pc) const;
+
+        [[nodiscard]] nlohmann::json json() const;
+
+      private:
+        std::array<std::atomic<uint64_t>, num_buckets> buckets_ = {};
+        std::atomic<uint64_t> count_                            = {0};
+        std::atomic<int64_t> total_ns_                          = {0};
+        std::atomic<int64_t> max_ns_                            = {0};
+    };
+
+    /* Class FrameTracer
+
+    Low overhead tracing of the frame pipeline. Spans are written to a ring
+    buffer owned by the recording thread, so recording doesn't take any locks
+    (the buffer is allocated the first time a thread records a span) and old
+    events are overwritten once a thread has written ring_size events.
+
+    Per stage latency histograms are kept for all spans recorded while tracing
+    is enabled. Tracing is off by default, and when off the cost of a trace
+    point is a relaxed atomic load.
+    */
+    class FrameTracer {
+
+      public:
+        static constexpr size_t ring_size = 2048;
+
+        static FrameTracer &instance();
+
+        [[nodiscard]] static bool enabled() {
+            return enabled_.load(std::memory_order_relaxed);
+        }
+        void set_enabled(const bool enabled);
+
+        void record(
+            const TraceStage stage,
+            const time_point &start,
+            const time_point &end,
+            const size_t key_hash,
+            const std::string_view key,
+            const Uuid &playhead = Uuid());
+
+        void record(
+            const TraceStage stage,
+            const time_point &start,
+            const time_point &end,
+            const Uuid &playhead = Uuid()) {
+            record(stage, start, end, 0, std::string_view(), playhead);
+        }
+
+        // Key is anything with hash() and to_string_view(), e.g. media::MediaKey
+        template <typename Key>
+        void record(
+            const TraceStage stage,
+            const time_point &start,
+            const time_point &end,
+            const Key &key,
+            const Uuid &playhead = Uuid()) {
+            const auto sv = to_string_view(key);
+            record(
+                stage,
+                start,
+                end,
+                key.hash(),
+                std::string_view(sv.data(), sv.size()),
+                playhead);
+        }
+
+        // events from all threads, oldest first
+        [[nodiscard]] std::vector<TraceEvent> events() const;
+
+        // events in the Chrome trace event format, loads in chrome://tracing
+        // and Perfetto
+        [[nodiscard]] nlohmann::json chrome_trace() const;
+        void write_chrome_trace(const std::string &path) const;
+
+        [[nodiscard]] const TraceHistogram &histogram(const TraceStage stage) const {
+            return histograms_[static_cast<size_t>(stage)];
+        }
+        // histograms of all stages, keyed on stage name
+        [[nodiscard]] nlohmann::json statistics() const;
+
+        void clear();
+
+      private:
+        FrameTracer() = default;
+
+        struct ThreadBuffer {
+            std::array<TraceEvent, ring_size> events;
+            std::atomic<uint64_t> head = {0};
+            int tid;
+        };
+
+        ThreadBuffer *thread_buffer();
+
+        inline static std::atomic<bool> enabled_ = {false};
+
+        mutable std::mutex mutex_;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+        std::array<TraceHistogram, static_cast<size_t>(TraceStage::Count)> histograms_;
+    };
+
+    /* Records a span from construction to destruction, if tracing was enabled
+    when it was constructed */
+    class TraceSpan {
+      public:
+        template <typename Key>
+        TraceSpan(const TraceStage stage, const Key &key, const Uuid &playhead = Uuid())
+            : active_(FrameTracer::enabled()) {
+            if (active_) {
+                const auto sv = to_string_view(key);
+                start(stage, key.hash(), std::string_view(sv.data(), sv.size()), playhead);
+            }
+        }
+
+        ~TraceSpan();
+
+        TraceSpan(const TraceSpan &)            = delete;
+        TraceSpan &operator=(const TraceSpan &) = delete;
+
+      private:
+        void start(
+            const TraceStage stage,
+            const size_t key_hash,
+            const std::string_view key,
+            const Uuid &playhead);
+
+        const bool active_;
+        TraceStage stage_;
+        time_point start_;
+        size_t key_hash_;
+        std::string key_;
+        Uuid playhead_;
+    };
+
+} // namespace utility
+} // namespace xstudio
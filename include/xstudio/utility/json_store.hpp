@@ -7,6 +7,7 @@
 #include <filesystem>
 
 #include <fstream>
+#include <vector>
 
 #include "xstudio/utility/logging.hpp"
 #include "xstudio/utility/types.hpp"
@@ -276,7 +277,45 @@ namespace utility {
     };
 
 
+    /**
+     *  @brief Compact binary encoding of JSON.
+     *
+     *  @details The data is a short header, the magic "XSTB" and a format
+     *  version byte, followed by the document encoded as CBOR (RFC 8949), so
+     *  any CBOR decoder can read it once the header is skipped. Used for
+     *  binary .xsz session files and for JsonStore in binary CAF messages.
+     */
+    std::vector<uint8_t> json_to_binary(const nlohmann::json &json);
+
+    /**
+     *  @brief Decode JSON written by json_to_binary.
+     *  @throw std::runtime_error on a missing header or unsupported version.
+     */
+    nlohmann::json json_from_binary(const uint8_t *data, const size_t size);
+
+    /**
+     *  @brief Test for the header written by json_to_binary.
+     */
+    bool is_binary_json(const uint8_t *data, const size_t size);
+
     template <class Inspector> bool inspect(Inspector &f, JsonStore &x) {
+        if (not f.has_human_readable_format()) {
+            // binary serialisers (actor transfers, remote sessions) get the
+            // compact encoding, parsing text is much slower than decoding it.
+            auto get_bin = [&x] { return json_to_binary(x); };
+            auto set_bin = [&x](const std::vector<uint8_t> &val) {
+                try {
+                    x.set(json_from_binary(val.data(), val.size()));
+                } catch (const std::exception &err) {
+                    spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
+                    return false;
+                }
+
+                return true;
+            };
+            return f.object(x).fields(f.field("bin", get_bin, set_bin));
+        }
+
         auto get_jsn = [&x] { return x.dump(-1); };
         auto set_jsn = [&x](const std::string &val) {
             try {
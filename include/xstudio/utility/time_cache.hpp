@@ -33,6 +33,20 @@
 // buffers is X154 then the buffers are considered safe for removal as they will
 // no longer be needed for display.
 //
+// The default eviction order only knows about the 'needed by' timepoints that
+// have been registered so far, which reach no further than the playheads'
+// read-ahead. An estimator of when each key will next be needed can be set
+// with set_next_use_estimator, release then drops the entry whose next use is
+// furthest away (Belady's rule). See media_cache/eviction_policy.hpp.
+//
+// What's cached is accounted against every uuid stored with an entry and the
+// 'owners' of its value, which an owner function (set_owner_function) can
+// work out from the value - the image cache uses the media and media source
+// the frame came from, and any playlist holding that media. Each of those
+// uuids can be given a quota, beyond which storing another of its entries
+// drops its own entries rather than anyone else's, and a priority. Entries
+// of lower priority uuids are dropped first when the cache is full.
+//
 // Final note: We use std::map, not std::unsorted_map. Although advice is that
 // std::map should not be used for high performance applications, we found that
 // lookups and insertions are much quicker for std::map. It might be becuase
@@ -68,9 +82,25 @@ namespace utility {
             V value;
             std::unordered_set<utility::Uuid> uuids;
             std::set<time_point> timepoints;
+            // from the owner function, when the entry was stored
+            std::unordered_set<utility::Uuid> owners;
         };
         typedef std::shared_ptr<CacheEntry> CacheEntryPtr;
 
+        // what's cached against a uuid
+        struct Usage {
+            size_t size  = {0};
+            size_t count = {0};
+        };
+
+        // the uuids a value belongs to, besides those stored with it
+        using OwnerFunction =
+            std::function<std::vector<utility::Uuid>(const K &key, const V &value)>;
+
+        // estimated time at which a key will next be needed, time_point::max()
+        // if nothing is expected to need it again
+        using NextUseEstimator = std::function<time_point(const K &key, const time_point &now)>;
+
         using cache_type = std::map<K, CacheEntryPtr>;
         cache_type cache_;
 
@@ -111,12 +141,27 @@ namespace utility {
             const time_point &time    = utility::clock::now(),
             const utility::Uuid &uuid = utility::Uuid());
 
+        // lookups that leave the entries' timepoints and uuids alone
+        [[nodiscard]] bool contains(const K &key) const { return cache_.count(key) != 0; }
+        [[nodiscard]] V find(const K &key) const {
+            const auto it = cache_.find(key);
+            return it == cache_.end() ? V() : it->second->value;
+        }
+        template <typename F> void for_each(F fn) const {
+            for (const auto &i : cache_)
+                fn(i.first, *(i.second));
+        }
+
+        // within limits the release to entries accounted against that uuid
         V release(
-            const time_point &ntp     = utility::clock::now(),
-            const time_point &newtp   = utility::clock::now(),
-            const bool force_eviction = false);
+            const time_point &ntp       = utility::clock::now(),
+            const time_point &newtp     = utility::clock::now(),
+            const bool force_eviction   = false,
+            const utility::Uuid &within = utility::Uuid());
 
-        V release_out_of_date(const time_point &out_of_date_time = utility::clock::now());
+        V release_out_of_date(
+            const time_point &out_of_date_time = utility::clock::now(),
+            const utility::Uuid &within        = utility::Uuid());
 
         V reuse(
             const size_t min_size,
@@ -183,6 +228,47 @@ namespace utility {
                 change_callback_(store, erase);
         }
 
+        void set_next_use_estimator(NextUseEstimator estimator) {
+            next_use_estimator_ = std::move(estimator);
+        }
+
+        void set_owner_function(OwnerFunction fn) {
+            owner_function_ = std::move(fn);
+            refresh_owners();
+        }
+        // asks the owner function again, for when what it goes by has changed
+        void refresh_owners();
+        // as above, for only the entries currently owned by one of the uuids
+        void refresh_owners(const std::unordered_set<utility::Uuid> &uuids);
+
+        [[nodiscard]] Usage usage(const utility::Uuid &uuid) const {
+            const auto it = usage_.find(uuid);
+            return it == usage_.end() ? Usage() : it->second;
+        }
+        [[nodiscard]] const std::map<utility::Uuid, Usage> &usage() const { return usage_; }
+
+        // 0 for no quota, entries over a new quota are dropped straight away
+        void set_quota(const utility::Uuid &uuid, const size_t max_size);
+        [[nodiscard]] size_t quota(const utility::Uuid &uuid) const {
+            const auto it = quotas_.find(uuid);
+            return it == quotas_.end() ? 0 : it->second;
+        }
+        [[nodiscard]] const std::map<utility::Uuid, size_t> &quotas() const { return quotas_; }
+
+        // 0 by default, an entry has the highest priority set on its uuids
+        void set_priority(const utility::Uuid &uuid, const int priority);
+        [[nodiscard]] int priority(const utility::Uuid &uuid) const {
+            const auto it = priorities_.find(uuid);
+            return it == priorities_.end() ? 0 : it->second;
+        }
+        [[nodiscard]] const std::map<utility::Uuid, int> &priorities() const {
+            return priorities_;
+        }
+
+        // replaces the system clock when deciding what is out of date, so that
+        // recorded access traces can be replayed in their own time
+        void set_clock(std::function<time_point()> clock) { clock_ = std::move(clock); }
+
         /*bool noisy = {false};
         std::vector<int> retrieve_times;
         size_t avg_sum{0};
@@ -191,6 +277,18 @@ namespace utility {
       private:
         std::function<void(const std::vector<K> &store, const std::vector<K> &erase)>
             change_callback_;
+        NextUseEstimator next_use_estimator_;
+        std::function<time_point()> clock_;
+
+        [[nodiscard]] time_point now() const {
+            return clock_ ? clock_() : utility::clock::now();
+        }
+
+        typename cache_type::iterator release_candidate_by_next_use(
+            const time_point &ntp,
+            const time_point &newtp,
+            const bool force_eviction,
+            const utility::Uuid &within);
 
         void clean_timepoints(const K &key);
         void add_timepoint_reference(
@@ -200,12 +298,44 @@ namespace utility {
             V value,
             const time_point &time,
             const utility::Uuid &uuid,
-            const size_t size);
+            const size_t size,
+            std::unordered_set<utility::Uuid> owners);
+
+        [[nodiscard]] std::unordered_set<utility::Uuid> owners_of(const K &key, const V &value);
+        // release_from(uuid) drops one of the uuid's entries, false if it can't
+        template <typename F>
+        bool make_room_in_quotas(
+            const std::unordered_set<utility::Uuid> &owners,
+            const utility::Uuid &uuid,
+            const size_t size,
+            F release_from);
+
+        void add_uuid(CacheEntry &entry, const utility::Uuid &uuid);
+        // makes room in the uuid's quota before an existing entry is added to it
+        template <typename F>
+        bool make_room_for_uuid(const K &key, const utility::Uuid &uuid, F release_from);
+        void update_owners(CacheEntry &entry, const K &key);
+        void remove_uuid(CacheEntry &entry, const utility::Uuid &uuid);
+        void add_usage(const utility::Uuid &uuid, const size_t size);
+        void remove_usage(const utility::Uuid &uuid, const size_t size);
+        [[nodiscard]] static size_t entry_size(const CacheEntry &entry) {
+            return entry.value ? entry.value->size() : 0;
+        }
+        [[nodiscard]] static bool
+        belongs_to(const CacheEntry &entry, const utility::Uuid &uuid) {
+            return uuid.is_null() or entry.uuids.count(uuid) or entry.owners.count(uuid);
+        }
+        [[nodiscard]] int entry_priority(const CacheEntry &entry) const;
 
         size_t max_size_;
         size_t max_count_;
         size_t size_{0};
         size_t count_{0};
+
+        OwnerFunction owner_function_;
+        std::map<utility::Uuid, Usage> usage_;
+        std::map<utility::Uuid, size_t> quotas_;
+        std::map<utility::Uuid, int> priorities_;
     };
 
     template <typename K, typename V>
@@ -218,7 +348,7 @@ namespace utility {
     void TimeCache<K, V>::add_timepoint_reference(
         const K &key, const time_point &time, const utility::Uuid &uuid) {
         auto it = cache_.find(key);
-        it->second->uuids.insert(uuid);
+        add_uuid(*(it->second), uuid);
         it->second->timepoints.insert(time);
     }
 
@@ -228,17 +358,196 @@ namespace utility {
         V value,
         const time_point &time,
         const utility::Uuid &uuid,
-        const size_t size) {
+        const size_t size,
+        std::unordered_set<utility::Uuid> owners) {
         count_++;
         size_ += size;
 
-        cache_[key] = std::make_shared<CacheEntry>(value);
+        auto entry    = std::make_shared<CacheEntry>(value);
+        entry->owners = std::move(owners);
+        for (const auto &i : entry->owners)
+            add_usage(i, size);
+        cache_[key] = entry;
 
         call_change_callback({key}, {});
 
         add_timepoint_reference(key, time, uuid);
     }
 
+    template <typename K, typename V>
+    void TimeCache<K, V>::add_uuid(CacheEntry &entry, const utility::Uuid &uuid) {
+        if (entry.uuids.insert(uuid).second and not entry.owners.count(uuid))
+            add_usage(uuid, entry_size(entry));
+    }
+
+    template <typename K, typename V>
+    void TimeCache<K, V>::remove_uuid(CacheEntry &entry, const utility::Uuid &uuid) {
+        if (entry.uuids.erase(uuid) and not entry.owners.count(uuid))
+            remove_usage(uuid, entry_size(entry));
+    }
+
+    template <typename K, typename V>
+    void TimeCache<K, V>::add_usage(const utility::Uuid &uuid, const size_t size) {
+        if (uuid.is_null())
+            return;
+        auto &usage = usage_[uuid];
+        usage.size += size;
+        usage.count++;
+    }
+
+    template <typename K, typename V>
+    void TimeCache<K, V>::remove_usage(const utility::Uuid &uuid, const size_t size) {
+        auto it = usage_.find(uuid);
+        if (it == usage_.end())
+            return;
+        it->second.size -= std::min(size, it->second.size);
+        if (it->second.count)
+            it->second.count--;
+        if (not it->second.count)
+            usage_.erase(it);
+    }
+
+    template <typename K, typename V>
+    std::unordered_set<utility::Uuid>
+    TimeCache<K, V>::owners_of(const K &key, const V &value) {
+        std::unordered_set<utility::Uuid> result;
+        if (owner_function_) {
+            for (const auto &i : owner_function_(key, value)) {
+                if (not i.is_null())
+                    result.insert(i);
+            }
+        }
+        return result;
+    }
+
+    template <typename K, typename V> void TimeCache<K, V>::refresh_owners() {
+        usage_.clear();
+        for (auto &i : cache_) {
+            auto &entry       = *(i.second);
+            entry.owners      = owners_of(i.first, entry.value);
+            const auto _size  = entry_size(entry);
+            for (const auto &j : entry.owners)
+                add_usage(j, _size);
+            for (const auto &j : entry.uuids) {
+                if (not entry.owners.count(j))
+                    add_usage(j, _size);
+            }
+        }
+    }
+
+    template <typename K, typename V>
+    void TimeCache<K, V>::refresh_owners(const std::unordered_set<utility::Uuid> &uuids) {
+        if (uuids.empty())
+            return;
+        for (auto &i : cache_) {
+            auto &entry = *(i.second);
+            if (std::any_of(entry.owners.begin(), entry.owners.end(), [&](const auto &j) {
+                    return uuids.count(j);
+                }))
+                update_owners(entry, i.first);
+        }
+    }
+
+    template <typename K, typename V>
+    void TimeCache<K, V>::update_owners(CacheEntry &entry, const K &key) {
+        // usage is held by the owners and the uuids stored with the entry,
+        // only the owners that came or went change it
+        auto owners      = owners_of(key, entry.value);
+        const auto _size = entry_size(entry);
+        for (const auto &j : entry.owners) {
+            if (not owners.count(j) and not entry.uuids.count(j))
+                remove_usage(j, _size);
+        }
+        for (const auto &j : owners) {
+            if (not entry.owners.count(j) and not entry.uuids.count(j))
+                add_usage(j, _size);
+        }
+        entry.owners = std::move(owners);
+    }
+
+    template <typename K, typename V>
+    template <typename F>
+    bool TimeCache<K, V>::make_room_for_uuid(
+        const K &key, const utility::Uuid &uuid, F release_from) {
+        if (quotas_.empty() or uuid.is_null())
+            return true;
+        const auto it = cache_.find(key);
+        if (it == cache_.end() or belongs_to(*(it->second), uuid))
+            return true;
+        // the entry isn't the uuid's yet, so it can't be what's released
+        return make_room_in_quotas({}, uuid, entry_size(*(it->second)), release_from);
+    }
+
+    template <typename K, typename V>
+    template <typename F>
+    bool TimeCache<K, V>::make_room_in_quotas(
+        const std::unordered_set<utility::Uuid> &owners,
+        const utility::Uuid &uuid,
+        const size_t size,
+        F release_from) {
+        if (quotas_.empty())
+            return true;
+
+        auto make_room = [&](const utility::Uuid &container) -> bool {
+            const auto max_size = quota(container);
+            if (not max_size)
+                return true;
+            if (size > max_size)
+                return false;
+            while (usage(container).size > max_size - size) {
+                if (not release_from(container))
+                    return false;
+            }
+            return true;
+        };
+
+        for (const auto &i : owners) {
+            if (not make_room(i))
+                return false;
+        }
+        return owners.count(uuid) or make_room(uuid);
+    }
+
+    template <typename K, typename V>
+    void TimeCache<K, V>::set_quota(const utility::Uuid &uuid, const size_t max_size) {
+        if (not max_size) {
+            quotas_.erase(uuid);
+            return;
+        }
+        quotas_[uuid] = max_size;
+        while (usage(uuid).size > max_size) {
+            if (not release(now(), now(), true, uuid))
+                break;
+        }
+    }
+
+    template <typename K, typename V>
+    void TimeCache<K, V>::set_priority(const utility::Uuid &uuid, const int priority) {
+        if (priority)
+            priorities_[uuid] = priority;
+        else
+            priorities_.erase(uuid);
+    }
+
+    template <typename K, typename V>
+    int TimeCache<K, V>::entry_priority(const CacheEntry &entry) const {
+        if (priorities_.empty())
+            return 0;
+
+        int result = std::numeric_limits<int>::min();
+        bool found = false;
+        for (const auto *uuids : {&entry.uuids, &entry.owners}) {
+            for (const auto &i : *uuids) {
+                const auto it = priorities_.find(i);
+                if (it != priorities_.end()) {
+                    result = std::max(result, it->second);
+                    found  = true;
+                }
+            }
+        }
+        return found ? result : 0;
+    }
+
     template <typename K, typename V>
     bool TimeCache<K, V>::store_check(
         const K &key,
@@ -252,12 +561,12 @@ namespace utility {
                 cache_.count(key))) {
             // can we make space.
             while (count_ > max_count_ - 1) {
-                if (not release(utility::clock::now(), time, force_eviction))
+                if (not release(now(), time, force_eviction))
                     return false;
             }
 
             while (size_ > max_size_ - size) {
-                if (not release(utility::clock::now(), time, force_eviction))
+                if (not release(now(), time, force_eviction))
                     return false;
             }
         }
@@ -296,12 +605,22 @@ namespace utility {
         const time_point &time,
         const bool force_eviction,
         const utility::Uuid &uuid) {
+        auto release_from = [&](const utility::Uuid &container) {
+            return bool(release(now(), time, force_eviction, container));
+        };
+
         // already got it..
         if (cache_.count(key)) {
+            if (not make_room_for_uuid(key, uuid, release_from))
+                return false;
             add_timepoint_reference(key, time, uuid);
             clean_timepoints(key);
         } else {
             size_t _size = (value ? value->size() : 0);
+            auto owners  = owners_of(key, value);
+
+            if (not make_room_in_quotas(owners, uuid, _size, release_from))
+                return false;
 
             if (not shrink(
                     (max_size_ > _size ? max_size_ - _size : 0),
@@ -310,7 +629,7 @@ namespace utility {
                     force_eviction))
                 return false;
 
-            add_cache_entry(key, value, time, uuid, _size);
+            add_cache_entry(key, value, time, uuid, _size, std::move(owners));
         }
         return true;
     }
@@ -323,12 +642,22 @@ namespace utility {
         const time_point &time,
         const utility::Uuid &uuid,
         const time_point &out_of_date_time) {
+        auto release_from = [&](const utility::Uuid &container) {
+            return bool(release_out_of_date(out_of_date_time, container));
+        };
+
         // already got it..
         if (cache_.count(key)) {
+            if (not make_room_for_uuid(key, uuid, release_from))
+                return false;
             add_timepoint_reference(key, time, uuid);
             clean_timepoints(key);
         } else {
             size_t _size = (value ? value->size() : 0);
+            auto owners  = owners_of(key, value);
+
+            if (not make_room_in_quotas(owners, uuid, _size, release_from))
+                return false;
 
             if (not shrink_using_out_of_date(
                     (max_size_ > _size ? max_size_ - _size : 0),
@@ -336,7 +665,7 @@ namespace utility {
                     out_of_date_time))
                 return false;
 
-            add_cache_entry(key, value, time, uuid, _size);
+            add_cache_entry(key, value, time, uuid, _size, std::move(owners));
         }
         return true;
     }
@@ -348,12 +677,12 @@ namespace utility {
         const time_point &time,
         const bool force_eviction) {
         while (count_ > required_count) {
-            if (not release(utility::clock::now(), time, force_eviction))
+            if (not release(now(), time, force_eviction))
                 return false;
         }
 
         while (size_ > required_size) {
-            if (not release(utility::clock::now(), time, force_eviction))
+            if (not release(now(), time, force_eviction))
                 return false;
         }
         return true;
@@ -380,6 +709,7 @@ namespace utility {
         call_change_callback({}, keys());
 
         cache_.clear();
+        usage_.clear();
         count_ = 0;
         size_  = 0;
     }
@@ -409,7 +739,7 @@ namespace utility {
         bool result = false;
         while (it != std::end(cache_)) {
             if (it->second->uuids.count(uuid)) {
-                it->second->uuids.erase(uuid);
+                remove_uuid(*(it->second), uuid);
                 result = true;
                 if (it->second->uuids.empty()) {
                     it = erase(it);
@@ -425,8 +755,16 @@ namespace utility {
     typename TimeCache<K, V>::cache_type::iterator
     TimeCache<K, V>::erase(const typename cache_type::iterator &it) {
         typename cache_type::iterator nit;
-        if (it->second)
-            size_ -= it->second->value ? it->second->value->size() : 0;
+        if (it->second) {
+            const auto _size = entry_size(*(it->second));
+            size_ -= _size;
+            for (const auto &i : it->second->owners)
+                remove_usage(i, _size);
+            for (const auto &i : it->second->uuids) {
+                if (not it->second->owners.count(i))
+                    remove_usage(i, _size);
+            }
+        }
         count_--;
         call_change_callback({}, {it->first});
         nit = cache_.erase(it);
@@ -440,7 +778,7 @@ namespace utility {
         if (it != std::end(cache_)) {
             // remove from set..
             if (it->second->uuids.count(uuid)) {
-                it->second->uuids.erase(uuid);
+                remove_uuid(*(it->second), uuid);
                 result = true;
                 if (it->second->uuids.empty()) {
                     erase(it);
@@ -459,14 +797,27 @@ namespace utility {
     // return empty buffer on fail / empty cache.
     template <typename K, typename V>
     V TimeCache<K, V>::release(
-        const time_point &ntp, const time_point &newtp, const bool force_eviction) {
+        const time_point &ntp,
+        const time_point &newtp,
+        const bool force_eviction,
+        const utility::Uuid &within) {
 
         V ptr;
         if (cache_.empty())
             return ptr;
 
+        if (next_use_estimator_) {
+            auto it = release_candidate_by_next_use(ntp, newtp, force_eviction, within);
+            if (it != cache_.end()) {
+                ptr = it->second->value;
+                erase(it);
+            }
+            return ptr;
+        }
+
         // release in special time order..
         long long max_offset(0);
+        int min_priority = std::numeric_limits<int>::max();
 
         typename cache_type::iterator it = cache_.end();
         typename cache_type::iterator i  = cache_.begin();
@@ -475,6 +826,7 @@ namespace utility {
         if (not force_eviction)
             max_offset = std::abs(
                 std::chrono::duration_cast<std::chrono::microseconds>(ntp - newtp).count());
+        const long long min_offset = max_offset;
 
         // loop over every cache entry
         while (i != cache_.end()) {
@@ -484,15 +836,20 @@ namespace utility {
             // timepoints is an ordered set, so the last entry is the timepoint
             // furthest forward in time. How does this timepoint (which represents
             // the furthest point in the future that we would need this Value)
-            // compare to 'max_offset' ?
-            if (timepoints.size()) {
+            // compare to 'max_offset' ? Lower priority entries go before any
+            // of higher priority.
+            if (timepoints.size() and belongs_to(*(i->second), within)) {
                 long long offset =
                     std::abs(std::chrono::duration_cast<std::chrono::microseconds>(
                                  ntp - *(timepoints.rbegin()))
                                  .count());
-                if (offset >= max_offset) {
-                    max_offset = offset;
-                    it         = i;
+                const int priority = entry_priority(*(i->second));
+                if (offset >= min_offset and
+                    (priority < min_priority or
+                     (priority == min_priority and offset >= max_offset))) {
+                    max_offset   = offset;
+                    min_priority = priority;
+                    it           = i;
                 }
             }
             i++;
@@ -504,9 +861,57 @@ namespace utility {
         return ptr;
     }
 
+    // Belady's rule: the entry to drop is the one whose next use is furthest
+    // away. An entry's next use is the sooner of its 'needed by' timepoints
+    // still to come and the estimate, and unless eviction is forced it has to
+    // be later than newtp, when the incoming value is needed. Entries nothing
+    // expects to need again go first, least recently needed of those first.
+    template <typename K, typename V>
+    typename TimeCache<K, V>::cache_type::iterator
+    TimeCache<K, V>::release_candidate_by_next_use(
+        const time_point &ntp,
+        const time_point &newtp,
+        const bool force_eviction,
+        const utility::Uuid &within) {
+
+        auto result = cache_.end();
+        auto bar    = force_eviction ? time_point::min() : newtp;
+        time_point result_next;
+        time_point result_last;
+        int result_priority = 0;
+
+        for (auto i = cache_.begin(); i != cache_.end(); ++i) {
+            if (not belongs_to(*(i->second), within))
+                continue;
+            const std::set<time_point> &timepoints = i->second->timepoints;
+
+            auto next     = next_use_estimator_(i->first, ntp);
+            auto upcoming = timepoints.lower_bound(ntp);
+            if (upcoming != timepoints.end())
+                next = std::min(next, *upcoming);
+
+            if (next < bar)
+                continue;
+
+            // lower priority entries go before any of higher priority
+            const auto last = timepoints.empty() ? time_point::min() : *(timepoints.rbegin());
+            const int priority = entry_priority(*(i->second));
+            if (result == cache_.end() or priority < result_priority or
+                (priority == result_priority and
+                 (next > result_next or (next == result_next and last < result_last)))) {
+                result          = i;
+                result_next     = next;
+                result_last     = last;
+                result_priority = priority;
+            }
+        }
+        return result;
+    }
+
     // release the oldest item that is older than out_of_date_time
     template <typename K, typename V>
-    V TimeCache<K, V>::release_out_of_date(const time_point &out_of_date_time) {
+    V TimeCache<K, V>::release_out_of_date(
+        const time_point &out_of_date_time, const utility::Uuid &within) {
 
         V ptr;
         if (cache_.empty())
@@ -515,7 +920,8 @@ namespace utility {
         typename cache_type::iterator it = cache_.end();
         typename cache_type::iterator i  = cache_.begin();
 
-        long long maxx = 0;
+        long long maxx   = 0;
+        int min_priority = std::numeric_limits<int>::max();
 
         // loop over every cache entry
         while (i != cache_.end()) {
@@ -526,13 +932,17 @@ namespace utility {
             // furthest forward in time. How does this timepoint (which represents
             // the furthest point in the future that we would need this Value)
             // compare to 'max_offset' ?
-            if (timepoints.size()) {
+            if (timepoints.size() and belongs_to(*(i->second), within)) {
                 long long offset = std::chrono::duration_cast<std::chrono::microseconds>(
                                        out_of_date_time - *(timepoints.rbegin()))
                                        .count();
-                if (offset >= maxx) {
-                    maxx = offset;
-                    it   = i;
+                const int priority = entry_priority(*(i->second));
+                if (offset >= 0 and
+                    (priority < min_priority or
+                     (priority == min_priority and offset >= maxx))) {
+                    maxx         = offset;
+                    min_priority = priority;
+                    it           = i;
                 }
             }
             ++i;
@@ -573,7 +983,7 @@ namespace utility {
         // found entry, add timestamp (bit like lru ?)
         it->second->timepoints.insert(time);
         if (not uuid.is_null())
-            it->second->uuids.insert(uuid);
+            add_uuid(*(it->second), uuid);
         clean_timepoints(key);
 
         /*if (noisy){
@@ -633,7 +1043,7 @@ namespace utility {
         // and they shouldn't be purged when new cache entries are inserted
 
         auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(
-            utility::clock::now() - keys_and_timepoints.front().second);
+            now() - keys_and_timepoints.front().second);
 
         for (const auto &key : keys_and_timepoints) {
             auto it = cache_.find(key.first);
@@ -674,13 +1084,13 @@ namespace utility {
         if (timepoints.empty())
             return;
 
-        const time_point now = utility::clock::now();
+        const time_point tnow = now();
 
         // get the most recent timepoint
         time_point newest = *(timepoints.rbegin());
 
         // erasing all entries older than 'now'
-        while ((*timepoints.begin()) < now) {
+        while ((*timepoints.begin()) < tnow) {
             timepoints.erase(timepoints.begin());
             if (timepoints.empty())
                 break;
@@ -2,9 +2,12 @@
 #pragma once
 
 #include <deque>
+#include <iterator>
+#include <limits>
 #include <map>
 #include <optional>
 
+#include "xstudio/utility/compact_json.hpp"
 #include "xstudio/utility/json_store.hpp"
 
 namespace xstudio {
@@ -224,5 +227,171 @@ namespace utility {
         redo_.clear();
     }
 
+    /* UndoRedoMap for json values, e.g. timeline edit events. Entries are kept
+    in a CompactJsonPool, so subtrees shared between entries are held once, and
+    undo / redo move entries without copying them, decoding only the one
+    returned. The oldest entries are dropped to keep within max_bytes. */
+    template <typename K> class CompactUndoRedoMap {
+      public:
+        CompactUndoRedoMap() = default;
+        CompactUndoRedoMap(const utility::JsonStore &jsn) {}
+        ~CompactUndoRedoMap() = default;
+
+        [[nodiscard]] utility::JsonStore serialise() const { return utility::JsonStore(); }
+        [[nodiscard]] auto count() const { return undo_.size(); }
+        [[nodiscard]] bool empty() const { return undo_.empty(); }
+        [[nodiscard]] size_t bytes() const { return pool_.bytes() + entry_bytes_; }
+        [[nodiscard]] size_t max_bytes() const { return max_bytes_; }
+
+        void set_max_count(const size_t value);
+        void set_max_bytes(const size_t value);
+        void push(const K &key, const utility::JsonStore &value);
+
+        std::optional<utility::JsonStore> undo();
+        std::optional<utility::JsonStore> redo();
+        std::optional<utility::JsonStore> undo(const K &key);
+        std::optional<utility::JsonStore> redo(const K &key);
+
+        std::optional<K> peek_undo();
+        std::optional<K> peek_redo();
+
+        void clear();
+
+      private:
+        using Entries = std::multimap<K, CompactJsonPool::Handle>;
+
+        void drop(Entries &entries, typename Entries::iterator it);
+        void trim();
+
+        CompactJsonPool pool_;
+        Entries undo_;
+        Entries redo_;
+        size_t entry_bytes_{0};
+
+        size_t max_count_{std::numeric_limits<size_t>::max()};
+        size_t max_bytes_{size_t(128) * 1024 * 1024};
+    };
+
+    template <typename K>
+    void CompactUndoRedoMap<K>::drop(Entries &entries, typename Entries::iterator it) {
+        entry_bytes_ -= CompactJsonPool::bytes(it->second);
+        pool_.release(it->second);
+        entries.erase(it);
+    }
+
+    template <typename K> void CompactUndoRedoMap<K>::trim() {
+        while (undo_.size() > max_count_)
+            drop(undo_, undo_.begin());
+
+        // oldest undo first, then the furthest redo.
+        while (bytes() > max_bytes_ and not(undo_.empty() and redo_.empty())) {
+            if (not undo_.empty())
+                drop(undo_, undo_.begin());
+            else
+                drop(redo_, std::prev(redo_.end()));
+        }
+    }
+
+    template <typename K> void CompactUndoRedoMap<K>::set_max_count(const size_t value) {
+        max_count_ = value;
+        trim();
+    }
+
+    template <typename K> void CompactUndoRedoMap<K>::set_max_bytes(const size_t value) {
+        max_bytes_ = value;
+        trim();
+    }
+
+    template <typename K>
+    void CompactUndoRedoMap<K>::push(const K &key, const utility::JsonStore &value) {
+        while (not redo_.empty())
+            drop(redo_, redo_.begin());
+
+        auto handle = pool_.store(value);
+        entry_bytes_ += CompactJsonPool::bytes(handle);
+        undo_.emplace(key, std::move(handle));
+
+        trim();
+    }
+
+    template <typename K> std::optional<K> CompactUndoRedoMap<K>::peek_undo() {
+        if (undo_.empty())
+            return {};
+
+        return undo_.rbegin()->first;
+    }
+
+    template <typename K> std::optional<K> CompactUndoRedoMap<K>::peek_redo() {
+        if (redo_.empty())
+            return {};
+
+        return redo_.begin()->first;
+    }
+
+    template <typename K> std::optional<utility::JsonStore> CompactUndoRedoMap<K>::undo() {
+        if (undo_.empty())
+            return {};
+
+        auto node   = undo_.extract(std::prev(undo_.end()));
+        auto result = utility::JsonStore(pool_.load(node.mapped()));
+        redo_.insert(std::move(node));
+
+        return result;
+    }
+
+    template <typename K> std::optional<utility::JsonStore> CompactUndoRedoMap<K>::redo() {
+        if (redo_.empty())
+            return {};
+
+        auto node   = redo_.extract(redo_.begin());
+        auto result = utility::JsonStore(pool_.load(node.mapped()));
+
+        // as UndoRedoMap::redo, the other entries with the same key go
+        auto same_key = redo_.equal_range(node.key());
+        while (same_key.first != same_key.second)
+            drop(redo_, same_key.first++);
+
+        undo_.insert(std::move(node));
+
+        return result;
+    }
+
+    template <typename K>
+    std::optional<utility::JsonStore> CompactUndoRedoMap<K>::undo(const K &max) {
+        if (undo_.empty() or max >= undo_.rbegin()->first)
+            return {};
+
+        return undo();
+    }
+
+    template <typename K>
+    std::optional<utility::JsonStore> CompactUndoRedoMap<K>::redo(const K &min) {
+        if (redo_.empty())
+            return {};
+
+        auto it = redo_.begin();
+
+        if (min > it->first)
+            return {};
+
+        // duplicate keys are inserted oldest first, take the last one.
+        auto key_count = redo_.count(it->first);
+        if (key_count > 1)
+            std::advance(it, key_count - 1);
+
+        auto node   = redo_.extract(it);
+        auto result = utility::JsonStore(pool_.load(node.mapped()));
+        undo_.insert(std::move(node));
+
+        return result;
+    }
+
+    template <typename K> void CompactUndoRedoMap<K>::clear() {
+        undo_.clear();
+        redo_.clear();
+        pool_.clear();
+        entry_bytes_ = 0;
+    }
+
 } // namespace utility
 } // namespace xstudio
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace xstudio {
+namespace utility {
+
+    /* Threads that are kept for splitting loops (e.g. over the rows of an
+    image) into chunks, so that callers that do this several times a frame
+    don't start and join threads each time. The calling thread works on its
+    own loop too. Calls from several threads take turns, and func must not
+    call parallel_for on the same pool. */
+    class WorkerPool {
+      public:
+        // 0 threads for one per core, including the calling thread
+        explicit WorkerPool(const int num_threads = 0);
+        virtual ~WorkerPool();
+
+        WorkerPool(const WorkerPool &)            = delete;
+        WorkerPool &operator=(const WorkerPool &) = delete;
+
+        [[nodiscard]] int num_threads() const { return int(threads_.size()) + 1; }
+
+        // calls func(begin, end) for chunks of [0, count) and returns when all
+        // of them are done, rethrowing the first exception thrown by func
+        void parallel_for(
+            const int count,
+            const int chunk,
+            const std::function<void(const int, const int)> &func);
+
+      private:
+        struct Job {
+            Job(const int count,
+                const int chunk,
+                const std::function<void(const int, const int)> &func)
+                : count_(count), chunk_(chunk), func_(func) {}
+
+            void work();
+
+            const int count_;
+            const int chunk_;
+            const std::function<void(const int, const int)> &func_;
+            std::atomic<int> next_{0};
+            int workers_ = {0};
+            std::mutex error_mutex_;
+            std::exception_ptr error_;
+        };
+
+        void run();
+
+        std::vector<std::thread> threads_;
+        std::mutex submit_mutex_;
+        std::mutex mutex_;
+        std::condition_variable job_cv_;
+        std::condition_variable done_cv_;
+        std::shared_ptr<Job> job_;
+        size_t generation_ = {0};
+        bool stop_         = {false};
+    };
+
+} // namespace utility
+} // namespace xstudio
@@ -1,10 +1,12 @@
 # SPDX-License-Identifier: Apache-2.0
+import json
 from xstudio.core import session_atom, join_broadcast_atom
 from xstudio.core import colour_pipeline_atom, get_actor_from_registry_atom
 from xstudio.core import viewport_playhead_atom, quickview_media_atom
 from xstudio.core import UuidActorVec, UuidActor, viewport_atom
 from xstudio.core import get_global_playhead_events_atom, set_clipboard_atom
 from xstudio.core import active_viewport_atom, name_atom
+from xstudio.core import frame_trace_atom, clear_atom, startup_timing_atom
 from xstudio.api.session import Session, Container
 from xstudio.api.session.playhead import Playhead
 from xstudio.api.module import ModuleBase
@@ -133,4 +135,54 @@ class App(Container):
         return ActorConnection(
             self.connection,
             self.connection.request_receive(self.connection.remote(), get_actor_from_registry_atom(), "GLOBALPLAYHEADEVENTS")[0]
-            )
\ No newline at end of file
+            )
+
+    @property
+    def frame_trace(self):
+        """Is frame pipeline tracing enabled.
+
+        Returns:
+            enabled(bool): Tracing enabled."""
+        return self.frame_trace_stats()["enabled"]
+
+    @frame_trace.setter
+    def frame_trace(self, enable):
+        """Enable/disable frame pipeline tracing.
+
+        Args:
+            enable(bool): Enable tracing."""
+        self.connection.request_receive(self.connection.remote(), frame_trace_atom(), enable)
+
+    def frame_trace_stats(self):
+        """Per stage latency histograms of the frame pipeline, from frame
+        request through decode, cache, viewport and display.
+
+        Returns:
+            stats(dict): Count, mean, max and percentiles (in microseconds) per stage."""
+        return json.loads(
+            self.connection.request_receive(self.connection.remote(), frame_trace_atom())[0].dump()
+        )
+
+    def clear_frame_trace(self):
+        """Clear recorded trace spans and histograms."""
+        self.connection.request_receive(self.connection.remote(), frame_trace_atom(), clear_atom())
+
+    def write_frame_trace(self, path):
+        """Write recorded trace spans as Chrome trace json, which can be
+        loaded in chrome://tracing or Perfetto.
+
+        Args:
+            path(str): File path.
+
+        Returns:
+            success(bool): File written."""
+        return self.connection.request_receive(self.connection.remote(), frame_trace_atom(), path)[0]
+
+    def startup_timing(self):
+        """Time taken to start each global service.
+
+        Returns:
+            timing(dict): Per service and total start up time in milliseconds."""
+        return json.loads(
+            self.connection.request_receive(self.connection.remote(), startup_timing_atom())[0].dump()
+        )
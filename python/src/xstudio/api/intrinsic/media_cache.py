@@ -1,6 +1,9 @@
 # SPDX-License-Identifier: Apache-2.0
+import json
+
 from xstudio.api.auxiliary import ActorConnection
 from xstudio.core import keys_atom, erase_atom, count_atom, size_atom
+from xstudio.core import usage_atom, quota_atom, VectorUuid
 
 class MediaCache(ActorConnection):
     """Media cache object."""
@@ -48,3 +51,50 @@ class MediaCache(ActorConnection):
             size(int): Count of cached items in bytes.
         """
         return self.connection.request_receive(self.remote, size_atom())[0]
+
+    def usage(self, uuid=None):
+        """What the cache holds, image cache only.
+
+        Kwargs:
+            uuid(Uuid): Container, media, media source or playhead, all when None.
+
+        Returns:
+            usage(dict): Sizes in bytes, with any quota and priority set. For
+                all, lists of the containers (playlists), media with their
+                sources and playheads, largest first.
+        """
+        if uuid is None:
+            result = self.connection.request_receive(self.remote, usage_atom())[0]
+        else:
+            result = self.connection.request_receive(self.remote, usage_atom(), uuid)[0]
+        return json.loads(result.dump())
+
+    def set_quota(self, uuid, max_size_mb, priority=0):
+        """Cap what's cached for a container, media, media source or playhead,
+        image cache only.
+
+        Args:
+            uuid(Uuid): Uuid to cap.
+            max_size_mb(int): Most it may hold in megabytes, 0 for no cap.
+
+        Kwargs:
+            priority(int): Frames of lower priority are dropped first when
+                the cache is full.
+
+        Returns:
+            success(bool): Quota set.
+        """
+        return self.connection.request_receive(
+            self.remote, quota_atom(), uuid, max_size_mb, priority)[0]
+
+    def set_container(self, uuid, members, name):
+        """Account the frames of media to a container as well, image cache
+        only. Playlists register themselves.
+
+        Args:
+            uuid(Uuid): Container uuid.
+            members(list[Uuid]): Media or media source uuids, replacing any
+                set before.
+            name(str): Name shown for the container.
+        """
+        self.connection.send(self.remote, usage_atom(), uuid, VectorUuid(members), name)
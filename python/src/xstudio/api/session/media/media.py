@@ -3,6 +3,7 @@ from xstudio.core import get_media_source_atom, current_media_source_atom, get_j
 from xstudio.core import invalidate_cache_atom, get_media_pointer_atom, MediaType, Uuid, media_status_atom
 from xstudio.core import add_media_source_atom, FrameRate, FrameList, parse_posix_path, URI, MediaStatus
 from xstudio.core import set_json_atom, JsonStore, quickview_media_atom, media_display_info_atom
+from xstudio.core import get_image_atom, image_statistics_atom
 
 from xstudio.api.session.container import Container
 from xstudio.api.session.media.media_source import MediaSource
@@ -211,6 +212,70 @@ class Media(Container):
         """
         return self.connection.request_receive(self.remote, get_media_pointer_atom(), media_type, logical_frame)[0]
 
+    def get_media_pointers(self, start=0, end=None, media_type=MediaType.MT_IMAGE):
+        """Get Media Pointers for a range of frames
+
+        Kwargs:
+            start(int): First logical frame.
+            end(int): Last logical frame (inclusive), defaults to the last frame.
+            media_type(MediaType): MediaType of pointers.
+
+        Returns:
+            media_pointers(VectorAVFrameID): Media pointers.
+        """
+        mptrs = self.connection.request_receive(self.remote, get_media_pointer_atom(), media_type)[0]
+        return mptrs[start:None if end is None else end + 1]
+
+    def get_images(self, start=0, end=None):
+        """Get decoded images for a range of frames, from the image cache
+        where possible. Only available in process (e.g. embedded python).
+        Images support the buffer protocol, numpy.asarray(image) is a read
+        only view of the pixels, see ImageBuffer.layout().
+
+        Kwargs:
+            start(int): First logical frame.
+            end(int): Last logical frame (inclusive), defaults to the last frame.
+
+        Returns:
+            images(list[ImageBuffer]): Decoded images.
+        """
+        mptrs = self.get_media_pointers(start, end)
+        reader = self.connection.api.get_actor_from_registry("MEDIAREADER")
+        return self.connection.request_receive(reader.remote, get_image_atom(), mptrs)[0]
+
+    def get_image_statistics(self, image, region=None, histogram_bins=256, value_range=(0.0, 1.0),
+        waveform_columns=0, waveform_rows=256, vectorscope_size=0):
+        """Measure a decoded image (see get_images) on the CPU. Values are
+        the RGBA the viewport's colour pipeline starts from. Only available
+        in process (e.g. embedded python).
+
+        Args:
+            image(ImageBuffer): Decoded image.
+
+        Kwargs:
+            region(tuple(int)): x0, y0, x1, y1 in image pixels (exclusive max), defaults to the data window.
+            histogram_bins(int): Bins per channel histogram, 0 for no histograms.
+            value_range(tuple(float)): Values binned by the histograms and waveform.
+            waveform_columns(int): Luma waveform columns, 0 for no waveform.
+            waveform_rows(int): Waveform bins per column.
+            vectorscope_size(int): Width and height of the Cb/Cr vectorscope, 0 for none.
+
+        Returns:
+            statistics(dict): region, pixel_count, min, max, mean, histograms, waveform and vectorscope.
+        """
+        options = {
+            "histogram_bins": histogram_bins,
+            "range": list(value_range),
+            "waveform_columns": waveform_columns,
+            "waveform_rows": waveform_rows,
+            "vectorscope_size": vectorscope_size
+        }
+        if region is not None:
+            options["region"] = list(region)
+        reader = self.connection.api.get_actor_from_registry("MEDIAREADER")
+        return self.connection.request_receive(
+            reader.remote, image_statistics_atom(), image, JsonStore(options))[0].get()
+
     def add_media_source(self, path, frame_list=None, frame_rate=None):
         """Add media source from path
 
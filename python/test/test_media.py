@@ -1,4 +1,5 @@
 # SPDX-License-Identifier: Apache-2.0
+import pytest
 import xstudio
 import os
 from xstudio.api.session.media import Media
@@ -23,3 +24,20 @@ def test_add_remove_media(spawn):
 
     assert s.playlist_tree.empty == True
 
+def test_get_images(spawn):
+    s = spawn.api.session
+    (pl_uuid, pl) = s.create_playlist("TEST")
+
+    m = pl.add_media(os.environ["TEST_RESOURCE"]+"/media/test.mov")
+    assert m.acquire_metadata() == True
+
+    frames = m.media_source().media_reference.frame_count()
+    assert len(m.get_media_pointers()) == frames
+    assert len(m.get_media_pointers(0, 2)) == 3
+
+    # the frames resolve, but decoded images only come back in process
+    with pytest.raises(RuntimeError, match="in process"):
+        m.get_images(0, 2)
+
+    assert pl.remove_media(m) == True
+    assert s.remove_container(pl_uuid) == True
@@ -24,6 +24,37 @@ using namespace xstudio::global_store;
 using namespace xstudio::conform;
 using namespace caf;
 
+namespace {
+Uuid get_conform_track_uuid(const JsonStore &timeline_prop, const UuidActor &conform_track) {
+    auto result = conform_track.uuid();
+
+    if (result.is_null()) {
+        if (timeline_prop.is_null() or not timeline_prop.count("conform_track_uuid"))
+            throw std::runtime_error("No conform track defined.");
+        result = timeline_prop.value("conform_track_uuid", utility::Uuid());
+    }
+
+    if (result.is_null())
+        throw std::runtime_error("No conform track defined.");
+
+    return result;
+}
+
+// clear state of conform track items
+void reset_conform_track(timeline::Item &track) {
+    track.unbind();
+    track.set_enabled(true);
+    track.set_locked(false);
+
+    auto clip_items = track.find_all_items(timeline::IT_CLIP);
+    for (auto &i : clip_items) {
+        i.get().set_flag("");
+        i.get().set_enabled(true);
+        i.get().set_locked(false);
+    }
+}
+} // namespace
+
 ConformWorkerActor::ConformWorkerActor(caf::actor_config &cfg) : caf::event_based_actor(cfg) {
 
     // get hooks
@@ -57,58 +88,18 @@ ConformWorkerActor::ConformWorkerActor(caf::actor_config &cfg) : caf::event_base
         [=](xstudio::broadcast::broadcast_down_atom, const caf::actor_addr &) {},
 
         [=](conform_tasks_atom) -> result<std::vector<std::string>> {
-            if (not initialised_) {
-                // should be the first function called by the manager
-                auto pm = system().registry().template get<caf::actor>(plugin_manager_registry);
-                scoped_actor sys{system()};
-                try {
-                    auto details = request_receive<std::vector<plugin_manager::PluginDetail>>(
-                        *sys,
-                        pm,
-                        utility::detail_atom_v,
-                        plugin_manager::PluginType(plugin_manager::PluginFlags::PF_CONFORM));
-
-                    for (const auto &i : details) {
-                        if (i.enabled_) {
-                            auto actor = request_receive<caf::actor>(
-                                *sys, pm, plugin_manager::spawn_plugin_atom_v, i.uuid_);
-                            link_to(actor);
-                            conformers_.push_back(actor);
-                        }
-                    }
-                } catch (const std::exception &err) {
-                    spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
-                }
-
-                initialised_ = true;
-            }
-
-            if (not conformers_.empty()) {
-                auto rp = make_response_promise<std::vector<std::string>>();
-                fan_out_request<policy::select_all>(conformers_, infinite, conform_tasks_atom_v)
-                    .then(
-                        [=](const std::vector<std::vector<std::string>> all_results) mutable {
-                            // compile results..
-                            auto dups    = std::set<std::string>();
-                            auto results = std::vector<std::string>();
-
-                            for (const auto &i : all_results) {
-                                for (const auto &j : i) {
-                                    if (dups.count(j))
-                                        continue;
-
-                                    dups.insert(j);
-                                    results.push_back(j);
-                                }
-                            }
+            auto rp = make_response_promise<std::vector<std::string>>();
 
-                            rp.deliver(results);
-                        },
-                        [=](const error &err) mutable { rp.deliver(err); });
-                return rp;
+            if (initialised_) {
+                get_conform_tasks(rp);
+            } else {
+                // should be the first function called by the manager
+                initialise_waiters_.push_back(rp);
+                if (initialise_waiters_.size() == 1)
+                    initialise_conformers();
             }
 
-            return std::vector<std::string>();
+            return rp;
         },
 
         [=](conform_atom,
@@ -225,6 +216,100 @@ ConformWorkerActor::ConformWorkerActor(caf::actor_config &cfg) : caf::event_base
         });
 }
 
+void ConformWorkerActor::initialise_conformers() {
+    auto pm = system().registry().template get<caf::actor>(plugin_manager_registry);
+
+    mail(
+        utility::detail_atom_v,
+        plugin_manager::PluginType(plugin_manager::PluginFlags::PF_CONFORM))
+        .request(pm, infinite)
+        .then(
+            [=](const std::vector<plugin_manager::PluginDetail> &details) mutable {
+                auto uuids = UuidVector();
+                for (const auto &i : details) {
+                    if (i.enabled_)
+                        uuids.push_back(i.uuid_);
+                }
+
+                if (uuids.empty())
+                    return complete_initialisation();
+
+                // spawn plugins concurrently.
+                auto remaining = std::make_shared<size_t>(uuids.size());
+                for (const auto &i : uuids) {
+                    mail(plugin_manager::spawn_plugin_atom_v, i)
+                        .request(pm, infinite)
+                        .then(
+                            [=](const caf::actor &actor) mutable {
+                                link_to(actor);
+                                conformers_.push_back(actor);
+                                (*remaining)--;
+                                if (not *remaining)
+                                    complete_initialisation();
+                            },
+                            [=](const error &err) mutable {
+                                spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
+                                (*remaining)--;
+                                if (not *remaining)
+                                    complete_initialisation();
+                            });
+                }
+            },
+            [=](const error &err) mutable {
+                spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
+                complete_initialisation();
+            });
+}
+
+void ConformWorkerActor::complete_initialisation() {
+    initialised_ = true;
+
+    for (auto &i : initialise_waiters_)
+        get_conform_tasks(i);
+
+    initialise_waiters_.clear();
+}
+
+void ConformWorkerActor::get_conform_tasks(
+    caf::typed_response_promise<std::vector<std::string>> rp) {
+    if (conformers_.empty())
+        return rp.deliver(std::vector<std::string>());
+
+    fan_out_request<policy::select_all>(conformers_, infinite, conform_tasks_atom_v)
+        .then(
+            [=](const std::vector<std::vector<std::string>> all_results) mutable {
+                // compile results..
+                auto dups    = std::set<std::string>();
+                auto results = std::vector<std::string>();
+
+                for (const auto &i : all_results) {
+                    for (const auto &j : i) {
+                        if (dups.count(j))
+                            continue;
+
+                        dups.insert(j);
+                        results.push_back(j);
+                    }
+                }
+
+                rp.deliver(results);
+            },
+            [=](const error &err) mutable { rp.deliver(err); });
+}
+
+void ConformWorkerActor::send_progress(
+    const std::string &stage, const size_t done, const size_t total) {
+    // partial progress is relayed to the UI through the manager event group.
+    auto manager = system().registry().template get<caf::actor>(conform_registry);
+    if (manager) {
+        auto progress     = JsonStore(R"({"stage": null, "done": 0, "total": 0})"_json);
+        progress["stage"] = stage;
+        progress["done"]  = done;
+        progress["total"] = total;
+        anon_mail(utility::event_atom_v, conform_atom_v, progress).send(manager);
+    }
+}
+
 // similar to conform media to sequence.
 
 void ConformWorkerActor::conform_tracks_to_sequence(
@@ -235,51 +320,271 @@ void ConformWorkerActor::conform_tracks_to_sequence(
     const UuidActor &target_playlist,
     const UuidActor &target_timeline,
     const UuidActor &conform_track) {
-    try {
-        scoped_actor sys{system()};
 
-        auto timeline_prop = request_receive<JsonStore>(
-            *sys, target_timeline.actor(), timeline::item_prop_atom_v);
+    mail(timeline::item_prop_atom_v)
+        .request(target_timeline.actor(), infinite)
+        .then(
+            [=](const JsonStore &timeline_prop) mutable {
+                try {
+                    auto conform_track_uuid =
+                        get_conform_track_uuid(timeline_prop, conform_track);
 
-        auto conform_track_uuid = Uuid();
+                    // find conform track..
+                    mail(timeline::item_atom_v, conform_track_uuid)
+                        .request(target_timeline.actor(), infinite)
+                        .then(
+                            [=](timeline::Item conform_track_item) mutable {
+                                reset_conform_track(conform_track_item);
 
-        if (conform_track.uuid().is_null()) {
-            if (timeline_prop.is_null() or not timeline_prop.count("conform_track_uuid"))
-                throw std::runtime_error("No conform track defined.");
-            conform_track_uuid = timeline_prop.value("conform_track_uuid", utility::Uuid());
-        } else {
-            conform_track_uuid = conform_track.uuid();
+                                // source tracks are fetched in parallel, but we must
+                                // preserve the requested order.
+                                fan_out_request<policy::select_all>(
+                                    vector_to_caf_actor_vector(tracks),
+                                    infinite,
+                                    timeline::item_atom_v)
+                                    .then(
+                                        [=](const std::vector<timeline::Item> items) mutable {
+                                            auto item_map = std::map<Uuid, timeline::Item>();
+                                            for (const auto &i : items)
+                                                item_map[i.uuid()] = i;
+
+                                            auto track_items = std::vector<timeline::Item>();
+                                            for (const auto &i : tracks) {
+                                                auto it = item_map.find(i.uuid());
+                                                if (it != std::end(item_map))
+                                                    track_items.push_back(it->second);
+                                            }
+
+                                            conform_tracks_step_get_clip_media(
+                                                rp,
+                                                source_playlist,
+                                                target_playlist,
+                                                target_timeline,
+                                                conform_track_item,
+                                                track_items);
+                                        },
+                                        [=](const error &err) mutable {
+                                            spdlog::warn(
+                                                "{} {}", __PRETTY_FUNCTION__, to_string(err));
+                                            rp.deliver(err);
+                                        });
+                            },
+                            [=](const error &err) mutable {
+                                spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
+                                rp.deliver(err);
+                            });
+                } catch (const std::exception &err) {
+                    spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
+                    rp.deliver(make_error(sec::runtime_error, err.what()));
+                }
+            },
+            [=](const error &err) mutable {
+                spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
+                rp.deliver(err);
+            });
+}
+
+void ConformWorkerActor::conform_tracks_step_get_clip_media(
+    caf::typed_response_promise<ConformReply> rp,
+    const UuidActor &source_playlist,
+    const UuidActor &target_playlist,
+    const UuidActor &target_timeline,
+    const timeline::Item &conform_track_item,
+    const std::vector<timeline::Item> &track_items) {
+
+    // each track resolves its clip media independently, progress is reported per track.
+    auto clip_media = std::make_shared<std::map<Uuid, UuidActor>>();
+    auto remaining  = std::make_shared<size_t>(track_items.size());
+    auto total      = track_items.size();
+
+    auto track_done = [=]() mutable {
+        (*remaining)--;
+        send_progress("resolve_tracks", total - *remaining, total);
+
+        if (not *remaining and rp.pending())
+            conform_tracks_step_duplicate_media(
+                rp,
+                source_playlist,
+                target_playlist,
+                target_timeline,
+                conform_track_item,
+                track_items,
+                *clip_media);
+    };
+
+    for (const auto &track_item : track_items) {
+        auto actors = std::vector<caf::actor>();
+        for (const auto &i : track_item.find_all_items(timeline::IT_CLIP)) {
+            if (i.get().actor())
+                actors.push_back(i.get().actor());
         }
 
-        if (conform_track_uuid.is_null())
-            throw std::runtime_error("No conform track defined.");
+        if (actors.empty()) {
+            track_done();
+            continue;
+        }
+
+        fan_out_request<policy::select_all>(actors, infinite, playlist::get_media_atom_v, true)
+            .then(
+                [=](const std::vector<UuidUuidActor> item_media) mutable {
+                    for (const auto &i : item_media)
+                        (*clip_media)[i.first] = i.second;
+                    track_done();
+                },
+                [=](const error &err) mutable {
+                    spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
+                    if (rp.pending())
+                        rp.deliver(err);
+                });
+    }
 
-        // find conform track..
-        auto conform_track_item = request_receive<timeline::Item>(
-            *sys, target_timeline.actor(), timeline::item_atom_v, conform_track_uuid);
+    if (track_items.empty())
+        conform_tracks_step_duplicate_media(
+            rp,
+            source_playlist,
+            target_playlist,
+            target_timeline,
+            conform_track_item,
+            track_items,
+            *clip_media);
+}
 
-        // clear state of conform track items
-        conform_track_item.unbind();
-        // conform_track_item.reset_actor(true);
-        conform_track_item.set_enabled(true);
-        conform_track_item.set_locked(false);
-
-        auto clip_items = conform_track_item.find_all_items(timeline::IT_CLIP);
-        for (auto &i : clip_items) {
-            i.get().set_flag("");
-            i.get().set_enabled(true);
-            i.get().set_locked(false);
+void ConformWorkerActor::conform_tracks_step_duplicate_media(
+    caf::typed_response_promise<ConformReply> rp,
+    const UuidActor &source_playlist,
+    const UuidActor &target_playlist,
+    const UuidActor &target_timeline,
+    const timeline::Item &conform_track_item,
+    const std::vector<timeline::Item> &track_items,
+    const std::map<Uuid, UuidActor> &clip_media) {
+
+    // same playlist, media can be shared. otherwise it's cloned, in the order
+    // the tracks use it so that's the order it lands in the playlist.
+    auto media = UuidActorVector();
+    if (source_playlist.actor() != target_playlist.actor()) {
+        auto seen = std::set<Uuid>();
+        for (const auto &track_item : track_items) {
+            for (const auto &i : track_item.find_all_items(timeline::IT_CLIP)) {
+                auto it = clip_media.find(i.get().uuid());
+                if (it != std::end(clip_media) and it->second.actor() and
+                    seen.insert(it->second.uuid()).second)
+                    media.push_back(it->second);
+            }
         }
+    }
+
+    if (media.empty()) {
+        conform_tracks_step_build_request(
+            rp, target_playlist, target_timeline, conform_track_item, track_items, clip_media);
+        return;
+    }
+
+    // clone media, once per source media, in parallel.
+    auto duplicates = std::make_shared<std::map<Uuid, UuidActor>>();
+    auto remaining  = std::make_shared<size_t>(media.size());
+
+    auto media_done = [=]() mutable {
+        (*remaining)--;
+        if (not *remaining) {
+            auto remapped = clip_media;
+            for (auto &i : remapped) {
+                auto it = duplicates->find(i.second.uuid());
+                if (it != std::end(*duplicates))
+                    i.second = it->second;
+            }
+
+            auto added = UuidActorVector();
+            for (const auto &i : media) {
+                auto it = duplicates->find(i.uuid());
+                if (it != std::end(*duplicates))
+                    added.push_back(it->second);
+            }
+
+            conform_tracks_step_add_media(
+                rp,
+                target_playlist,
+                target_timeline,
+                conform_track_item,
+                track_items,
+                remapped,
+                added,
+                0);
+        }
+    };
+
+    for (const auto &i : media) {
+        const auto media_uuid = i.uuid();
+
+        mail(duplicate_atom_v)
+            .request(i.actor(), infinite)
+            .then(
+                [=](const UuidUuidActor &duplicate) mutable {
+                    (*duplicates)[media_uuid] = duplicate.second;
+                    media_done();
+                },
+                [=](const error &err) mutable {
+                    spdlog::warn("duplicate media {}", to_string(err));
+                    media_done();
+                });
+    }
+}
+
+void ConformWorkerActor::conform_tracks_step_add_media(
+    caf::typed_response_promise<ConformReply> rp,
+    const UuidActor &target_playlist,
+    const UuidActor &target_timeline,
+    const timeline::Item &conform_track_item,
+    const std::vector<timeline::Item> &track_items,
+    const std::map<Uuid, UuidActor> &clip_media,
+    const UuidActorVector &media,
+    const size_t index) {
+
+    if (index >= media.size()) {
+        conform_tracks_step_build_request(
+            rp, target_playlist, target_timeline, conform_track_item, track_items, clip_media);
+        return;
+    }
+
+    // one at a time, the playlist appends in the order it hears back
+    auto next = [=]() mutable {
+        conform_tracks_step_add_media(
+            rp,
+            target_playlist,
+            target_timeline,
+            conform_track_item,
+            track_items,
+            clip_media,
+            media,
+            index + 1);
+    };
+
+    mail(playlist::add_media_atom_v, media[index], Uuid())
+        .request(target_playlist.actor(), infinite)
+        .then(
+            [=](const UuidActor &) mutable { next(); },
+            [=](const error &err) mutable {
+                spdlog::warn("add to playlist {}", to_string(err));
+                next();
+            });
+}
+
+void ConformWorkerActor::conform_tracks_step_build_request(
+    caf::typed_response_promise<ConformReply> rp,
+    const UuidActor &target_playlist,
+    const UuidActor &target_timeline,
+    const timeline::Item &conform_track,
+    const std::vector<timeline::Item> &track_items,
+    const std::map<Uuid, UuidActor> &clip_media) {
+    try {
+        auto conform_track_item = conform_track;
+        auto clip_items         = conform_track_item.find_all_items(timeline::IT_CLIP);
 
         // populate track templates
         // we override the conform track settings with the source tracks
         auto ritems          = std::vector<ConformRequestItem>();
         auto template_tracks = std::vector<timeline::Item>();
 
-        for (const auto &i : tracks) {
-            auto track_item =
-                request_receive<timeline::Item>(*sys, i.actor(), timeline::item_atom_v);
-
+        for (const auto &track_item : track_items) {
             // think that's the lot..
             conform_track_item.set_name(track_item.name());
             conform_track_item.set_locked(track_item.locked());
@@ -291,42 +596,17 @@ void ConformWorkerActor::conform_tracks_to_sequence(
             // but we need to associate the clips with the source correct track
             template_tracks.push_back(conform_track_item);
 
-            auto track_clip_items = track_item.find_all_items(timeline::IT_CLIP);
-
-            for (auto i : track_clip_items) {
-                auto clip    = i.get();
-                auto clip_ua = clip.uuid_actor();
+            for (auto i : track_item.find_all_items(timeline::IT_CLIP)) {
+                auto clip     = i.get();
+                auto media_ua = UuidActor();
 
-                // get media actor from clip
-                auto media_ua =
-                    request_receive<UuidActor>(*sys, clip.actor(), playlist::get_media_atom_v);
+                auto it = clip_media.find(clip.uuid());
+                if (it != std::end(clip_media))
+                    media_ua = it->second;
 
                 clip.unbind();
                 clip.reset_actor(true);
 
-                if (source_playlist.actor() != target_playlist.actor() and media_ua.actor()) {
-                    // clone media..
-                    try {
-                        // might not need this..
-                        media_ua = request_receive<UuidUuidActor>(
-                                       *sys, media_ua.actor(), duplicate_atom_v)
-                                       .second;
-
-                        try {
-                            request_receive<UuidActor>(
-                                *sys,
-                                target_playlist.actor(),
-                                playlist::add_media_atom_v,
-                                media_ua,
-                                Uuid());
-                        } catch (const std::exception &err) {
-                            spdlog::warn("add to playlist {}", err.what());
-                        }
-                    } catch (const std::exception &err) {
-                        spdlog::warn("duplicate media {}", err.what());
-                    }
-                }
-
                 ritems.emplace_back(
                     ConformRequestItem(media_ua, media_ua, clip, track_item.uuid()));
             }
@@ -515,269 +795,268 @@ void ConformWorkerActor::process_request(
                             return rp.deliver(result);
 
                         // result.request_ = request;
+                        process_request_add_media(rp, request, result, 0, {});
+                    },
+                    [=](const error &err) mutable {
+                        spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
+                        rp.deliver(err);
+                    });
 
-                        // this is where the magic happens..
-                        // we've got a list of media
-                        // and a list of clips associated with them.
-
-                        // we need to construct N tracks based off the supplied track
-                        // replacing clip media with our media. we also need to rewite
-                        // the result items with the new clip actors.
-                        auto tracks       = std::list<timeline::Item>();
-                        auto track_to_use = 0;
-                        scoped_actor sys{system()};
-
-                        auto unconformed_track =
-                            result.request_.template_tracks_.at(track_to_use);
-                        unconformed_track.reset_actor(true);
-                        unconformed_track.clear();
-                        unconformed_track.set_name("Unconformed Media");
-
-                        for (size_t i = 0; i < request.items_.size(); i++) {
-                            const auto &media           = request.items_.at(i).item_;
-                            const auto &clip            = request.items_.at(i).clip_;
-                            const auto &clip_track_uuid = request.items_.at(i).clip_track_uuid_;
-
-                            // spdlog::warn("REQUESTED MEDIA {} {}",
-                            // to_string(media.uuid()),
-                            // static_cast<bool>(result.items_.at(i)));
-
-                            if (result.items_.at(i)) {
-                                // clip matched.
-                                // make sure media is in timeline.
-
-                                request_receive<UuidActor>(
-                                    *sys,
-                                    result.request_.container_.actor(),
-                                    playlist::add_media_atom_v,
-                                    media,
-                                    Uuid());
-
-                                // spdlog::warn("ADD MEDIA to SEQEUNCE {}",
-                                // to_string(media.uuid()));
-
-                                auto replacemode =
-                                    result.request_.operations_.value("replace_clip", false);
-                                // replace clip..
-                                // for(const auto &t: result.request_.template_tracks_)
-                                //     spdlog::warn("Template {}", to_string(t.uuid()));
-
-                                for (const auto &c : *(result.items_[i])) {
-                                    const auto clip_uuid = std::get<0>(c).uuid();
-                                    // spdlog::warn("{}", to_string(clip_uuid));
-                                    // for each clip asside them to this media.
-                                    auto trackit = tracks.begin();
-
-                                    // for(const auto &t: result.request_.template_tracks_)
-                                    //     spdlog::warn("C {} T {}",
-                                    //     to_string(clip_track_uuid),to_string(t.uuid()));
-
-
-                                    while (true) {
-                                        // still iterating
-                                        if (trackit == tracks.end()) {
-                                            // are we still bound to the real timeline ?
-                                            auto tmp = result.request_.template_tracks_.at(
-                                                track_to_use);
-                                            tmp.reset_actor(true);
-
-                                            // zero out clip media.
-                                            auto clip_items =
-                                                tmp.find_all_items(timeline::IT_CLIP);
-                                            for (auto &i : clip_items) {
-                                                auto prop          = i.get().prop();
-                                                prop["media_uuid"] = Uuid();
-                                                i.get().set_prop(prop);
-                                                i.get().set_flag("");
-                                                i.get().set_enabled(true);
-                                                i.get().set_locked(false);
-                                                // if(i.get().active_range())
-                                                //     i.get().set_available_range(*(i.get().active_range()));
-                                            }
-                                            tracks.push_back(tmp);
-                                            trackit = tracks.begin();
-                                            std::next(trackit, tracks.size() - 1);
-                                            if (track_to_use <
-                                                result.request_.template_tracks_.size() - 1)
-                                                track_to_use++;
-                                        }
-
-                                        auto clipit = find_uuid(trackit->children(), clip_uuid);
-                                        auto clip_prop = clipit->prop();
-                                        if ((clip_track_uuid.is_null() or
-                                             (clip_track_uuid == trackit->uuid())) and
-                                            clip_prop.value("media_uuid", Uuid()).is_null()) {
-                                            if (clip.item_type() == timeline::IT_CLIP) {
-                                                clipit->set_enabled(clip.enabled());
-                                                clipit->set_locked(clip.locked());
-                                                clipit->set_name(clip.name());
-                                                clipit->set_flag(clip.flag());
-                                                clip_prop = clip.prop();
-                                            }
+        } else {
+            rp.deliver(ConformReply(request));
+        }
+    } catch (const std::exception &err) {
+        spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
+        rp.deliver(make_error(sec::runtime_error, err.what()));
+    }
+}
 
-                                            clip_prop["media_uuid"] = media.uuid();
-                                            clipit->set_prop(clip_prop);
-
-
-                                            if (replacemode and trackit == tracks.begin()) {
-                                                // find in source and really change it..
-                                                // find clip actor..
-                                                auto real_clip = find_item(
-                                                    result.request_.template_tracks_.at(0)
-                                                        .children(),
-                                                    clip_uuid);
-                                                if (real_clip) {
-                                                    // spdlog::warn("{} {}",
-                                                    // (*real_clip)->name(),
-                                                    // to_string((*real_clip)->actor()));
-                                                    anon_mail(
-                                                        timeline::link_media_atom_v, media)
-                                                        .send((*real_clip)->actor());
-                                                }
-                                            }
+void ConformWorkerActor::process_request_add_media(
+    caf::typed_response_promise<ConformReply> rp,
+    const ConformRequest &request,
+    const ConformReply &result,
+    const size_t index,
+    const std::set<Uuid> &failed) {
+    // make sure all media, conformed or not, is in the container. requests
+    // are chained so the media lands in the container in request order.
+    if (index >= request.items_.size())
+        return process_request_build_tracks(rp, request, result, failed);
+
+    const auto media = request.items_[index].item_;
+
+    mail(playlist::add_media_atom_v, media, Uuid())
+        .request(result.request_.container_.actor(), infinite)
+        .then(
+            [=](const UuidActor &) mutable {
+                send_progress("add_media", index + 1, request.items_.size());
+                process_request_add_media(rp, request, result, index + 1, failed);
+            },
+            [=](const error &err) mutable {
+                spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
+                auto now_failed = failed;
+                now_failed.insert(media.uuid());
+                process_request_add_media(rp, request, result, index + 1, now_failed);
+            });
+}
 
-                                            break;
-                                        } else
-                                            trackit++;
-                                    }
-                                }
-                            } else {
-                                // unconformed media.
-                                // add to unconformed track.
-                                try {
-                                    // spdlog::warn("Unconformed {}", to_string(media.uuid()));
-                                    request_receive<UuidActor>(
-                                        *sys,
-                                        result.request_.container_.actor(),
-                                        playlist::add_media_atom_v,
-                                        media,
-                                        Uuid());
-
-                                    auto detail =
-                                        request_receive<std::pair<Uuid, MediaReference>>(
-                                            *sys,
-                                            media.actor(),
-                                            media::media_reference_atom_v,
-                                            Uuid());
-
-                                    auto clip = timeline::Item(
-                                        timeline::IT_CLIP, "", unconformed_track.rate());
-
-                                    auto media_prop          = R"({"media_uuid": null})"_json;
-                                    media_prop["media_uuid"] = media.uuid();
-                                    clip.set_prop(media_prop);
-                                    unconformed_track.push_back(clip);
-                                    unconformed_track.refresh();
-
-                                } catch (const std::exception &err) {
-                                    spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
-                                }
+void ConformWorkerActor::process_request_build_tracks(
+    caf::typed_response_promise<ConformReply> rp,
+    const ConformRequest &request,
+    const ConformReply &result,
+    const std::set<Uuid> &failed_media) {
+    try {
+        // this is where the magic happens..
+        // we've got a list of media
+        // and a list of clips associated with them.
+
+        // we need to construct N tracks based off the supplied track
+        // replacing clip media with our media. we also need to rewite
+        // the result items with the new clip actors.
+        auto tracks       = std::list<timeline::Item>();
+        auto track_to_use = 0;
+
+        auto unconformed_track = result.request_.template_tracks_.at(track_to_use);
+        unconformed_track.reset_actor(true);
+        unconformed_track.clear();
+        unconformed_track.set_name("Unconformed Media");
+
+        // clip lookup per generated track, built on first use.
+        auto clip_lookup = std::unordered_map<
+            const timeline::Item *,
+            std::unordered_map<Uuid, timeline::Item *>>();
+        auto find_clip = [&clip_lookup](
+                             timeline::Item &track, const Uuid &uuid) -> timeline::Item * {
+            auto &lookup = clip_lookup[&track];
+            if (lookup.empty()) {
+                for (auto &i : track.children())
+                    lookup[i.uuid()] = &i;
+            }
+            auto it = lookup.find(uuid);
+            return it == std::end(lookup) ? nullptr : it->second;
+        };
+
+        for (size_t i = 0; i < request.items_.size(); i++) {
+            const auto &media           = request.items_.at(i).item_;
+            const auto &clip            = request.items_.at(i).clip_;
+            const auto &clip_track_uuid = request.items_.at(i).clip_track_uuid_;
+
+            if (result.items_.at(i)) {
+                // clip matched.
+                auto replacemode = result.request_.operations_.value("replace_clip", false);
+
+                for (const auto &c : *(result.items_[i])) {
+                    const auto clip_uuid = std::get<0>(c).uuid();
+                    // for each clip asside them to this media.
+                    auto trackit = tracks.begin();
+
+                    while (true) {
+                        auto created = false;
+                        // still iterating
+                        if (trackit == tracks.end()) {
+                            // are we still bound to the real timeline ?
+                            auto tmp = result.request_.template_tracks_.at(track_to_use);
+                            tmp.reset_actor(true);
+
+                            // zero out clip media.
+                            auto clip_items = tmp.find_all_items(timeline::IT_CLIP);
+                            for (auto &i : clip_items) {
+                                auto prop          = i.get().prop();
+                                prop["media_uuid"] = Uuid();
+                                i.get().set_prop(prop);
+                                i.get().set_flag("");
+                                i.get().set_enabled(true);
+                                i.get().set_locked(false);
                             }
+                            tracks.push_back(tmp);
+                            trackit = std::prev(tracks.end());
+                            created = true;
+                            if (track_to_use < result.request_.template_tracks_.size() - 1)
+                                track_to_use++;
                         }
 
-                        // create new track actors and append to timeline.
+                        auto clipit = find_clip(*trackit, clip_uuid);
 
-                        try {
-                            auto track_actors = UuidActorVector();
-                            auto mediamap     = UuidActorMap();
-
-                            for (const auto &i : request.items_)
-                                mediamap[i.item_.uuid()] = i.item_.actor();
-
-                            if (result.request_.operations_.at("replace_clip") == true and
-                                not tracks.empty()) {
-                                // pop first track.. as this is a duplicate of our
-                                // replacement track. force relink..
-                                // request_receive<bool>(
-                                //     *sys,
-                                //     result.request_.track_.actor(),
-                                //     timeline::link_media_atom_v,
-                                //     mediamap,
-                                //     true);
-
-                                tracks.pop_front();
+                        if (not clipit) {
+                            if (created) {
+                                spdlog::warn(
+                                    "{} clip not found in template {}",
+                                    __PRETTY_FUNCTION__,
+                                    to_string(clip_uuid));
+                                break;
                             }
+                            trackit++;
+                            continue;
+                        }
 
-                            auto new_track_name = result.request_.operations_.value(
-                                "new_track_name", std::string());
-                            for (auto &i : tracks) {
-                                i.merge_gaps(true);
-                                i.reset_uuid(true);
-                                if (not new_track_name.empty())
-                                    i.set_name(new_track_name);
-                                // reset id's..
-                                auto track_actor = spawn<timeline::TrackActor>(i, i);
-                                // spdlog::warn("NEW TRACK {} {} {}",
-                                // to_string(track_actor), to_string(i.actor()),
-                                // to_string(i.uuid()));
-                                track_actors.push_back(i.uuid_actor());
-
-                                request_receive<bool>(
-                                    *sys,
-                                    track_actor,
-                                    timeline::link_media_atom_v,
-                                    mediamap,
-                                    true);
+                        auto clip_prop = clipit->prop();
+                        if ((clip_track_uuid.is_null() or
+                             (clip_track_uuid == trackit->uuid())) and
+                            clip_prop.value("media_uuid", Uuid()).is_null()) {
+                            if (clip.item_type() == timeline::IT_CLIP) {
+                                clipit->set_enabled(clip.enabled());
+                                clipit->set_locked(clip.locked());
+                                clipit->set_name(clip.name());
+                                clipit->set_flag(clip.flag());
+                                clip_prop = clip.prop();
                             }
 
-                            if (not unconformed_track.empty()) {
-                                unconformed_track.merge_gaps(true);
-                                unconformed_track.reset_uuid(true);
-                                auto track_actor = spawn<timeline::TrackActor>(
-                                    unconformed_track, unconformed_track);
-                                // spdlog::warn("NEW TRACK {} {} {}",
-                                // to_string(track_actor), to_string(i.actor()),
-                                // to_string(i.uuid()));
-                                track_actors.push_back(unconformed_track.uuid_actor());
-
-                                request_receive<bool>(
-                                    *sys,
-                                    track_actor,
-                                    timeline::link_media_atom_v,
-                                    mediamap,
-                                    true);
+                            clip_prop["media_uuid"] = media.uuid();
+                            clipit->set_prop(clip_prop);
+
+                            if (replacemode and trackit == tracks.begin()) {
+                                // find in source and really change it..
+                                // find clip actor..
+                                auto real_clip = find_item(
+                                    result.request_.template_tracks_.at(0).children(),
+                                    clip_uuid);
+                                if (real_clip) {
+                                    anon_mail(timeline::link_media_atom_v, media)
+                                        .send((*real_clip)->actor());
+                                }
                             }
 
-                            if (not track_actors.empty()) {
-                                // get stack actor
-                                auto stack = request_receive<timeline::Item>(
-                                    *sys,
-                                    result.request_.container_.actor(),
-                                    timeline::item_atom_v,
-                                    0);
-
-                                std::reverse(track_actors.begin(), track_actors.end());
-                                request_receive<JsonStore>(
-                                    *sys,
-                                    stack.actor(),
-                                    timeline::insert_item_atom_v,
-                                    0,
-                                    track_actors);
-                            }
-                            // rebind media..
-                            // does the timeline even know at this point ?
-                            // anon_mail(// timeline::link_media_atom_v,
-                            // true).send(result.request_.container_.actor());
+                            break;
+                        } else
+                            trackit++;
+                    }
+                }
+            } else if (not failed_media.count(media.uuid())) {
+                // unconformed media.
+                // add to unconformed track.
+                auto clip = timeline::Item(timeline::IT_CLIP, "", unconformed_track.rate());
+
+                auto media_prop          = R"({"media_uuid": null})"_json;
+                media_prop["media_uuid"] = media.uuid();
+                clip.set_prop(media_prop);
+                unconformed_track.push_back(clip);
+                unconformed_track.refresh();
+            }
+        }
 
-                        } catch (...) {
-                        }
+        auto mediamap = UuidActorMap();
+        for (const auto &i : request.items_)
+            mediamap[i.item_.uuid()] = i.item_.actor();
 
-                        rp.deliver(result);
-                    },
-                    [=](const error &err) mutable {
-                        spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
-                        rp.deliver(err);
-                    });
-
-        } else {
-            rp.deliver(ConformReply(request));
+        if (result.request_.operations_.at("replace_clip") == true and not tracks.empty()) {
+            // pop first track.. as this is a duplicate of our
+            // replacement track.
+            tracks.pop_front();
         }
+
+        process_request_insert_tracks(rp, result, tracks, unconformed_track, mediamap);
+
     } catch (const std::exception &err) {
         spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
-        rp.deliver(make_error(sec::runtime_error, err.what()));
+        rp.deliver(result);
     }
 }
 
+void ConformWorkerActor::process_request_insert_tracks(
+    caf::typed_response_promise<ConformReply> rp,
+    const ConformReply &result,
+    const std::list<timeline::Item> &tracks,
+    const timeline::Item &unconformed_track,
+    const UuidActorMap &mediamap) {
+
+    if (tracks.empty() and unconformed_track.empty())
+        return rp.deliver(result);
+
+    // create new track actors and append to timeline.
+    auto track_actors   = UuidActorVector();
+    auto actors         = std::vector<caf::actor>();
+    auto new_track_name = result.request_.operations_.value("new_track_name", std::string());
+
+    for (auto i : tracks) {
+        i.merge_gaps(true);
+        i.reset_uuid(true);
+        if (not new_track_name.empty())
+            i.set_name(new_track_name);
+        // reset id's..
+        actors.push_back(spawn<timeline::TrackActor>(i, i));
+        track_actors.push_back(i.uuid_actor());
+    }
+
+    if (not unconformed_track.empty()) {
+        auto track = unconformed_track;
+        track.merge_gaps(true);
+        track.reset_uuid(true);
+        actors.push_back(spawn<timeline::TrackActor>(track, track));
+        track_actors.push_back(track.uuid_actor());
+    }
+
+    // link all tracks in parallel
+    fan_out_request<policy::select_all>(
+        actors, infinite, timeline::link_media_atom_v, mediamap, true)
+        .then(
+            [=](const std::vector<bool>) mutable {
+                // get stack actor
+                mail(timeline::item_atom_v, 0)
+                    .request(result.request_.container_.actor(), infinite)
+                    .then(
+                        [=](const timeline::Item &stack) mutable {
+                            auto ordered = track_actors;
+                            std::reverse(ordered.begin(), ordered.end());
+
+                            mail(timeline::insert_item_atom_v, 0, ordered)
+                                .request(stack.actor(), infinite)
+                                .then(
+                                    [=](const JsonStore &) mutable { rp.deliver(result); },
+                                    [=](const error &err) mutable {
+                                        spdlog::warn(
+                                            "{} {}", __PRETTY_FUNCTION__, to_string(err));
+                                        rp.deliver(result);
+                                    });
+                        },
+                        [=](const error &err) mutable {
+                            spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
+                            rp.deliver(result);
+                        });
+            },
+            [=](const error &err) mutable {
+                spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
+                rp.deliver(result);
+            });
+}
 
 void ConformWorkerActor::prepare_sequence(
     caf::typed_response_promise<bool> rp,
@@ -912,63 +1191,50 @@ void ConformWorkerActor::conform_to_timeline(
     const UuidActor &conform_track,
     const UuidActorVector &media) {
     // get copy of conform track.
-    try {
-        scoped_actor sys{system()};
-
-        auto timeline_prop =
-            request_receive<JsonStore>(*sys, timeline.actor(), timeline::item_prop_atom_v);
-
-        auto conform_track_uuid = conform_track.uuid();
-
-        if (conform_track.uuid().is_null()) {
-            if (timeline_prop.is_null() or not timeline_prop.count("conform_track_uuid"))
-                throw std::runtime_error("No conform track defined.");
-            conform_track_uuid = timeline_prop.value("conform_track_uuid", utility::Uuid());
-        }
-
-        if (conform_track_uuid.is_null())
-            throw std::runtime_error("No conform track defined.");
-
-        // find track..
-        try {
-            // need media metadata populating.
-            auto ritems = std::vector<ConformRequestItem>();
-            for (const auto &i : media) {
-                ritems.emplace_back(ConformRequestItem(i, i));
-            }
-
-            auto track_item = request_receive<timeline::Item>(
-                *sys, timeline.actor(), timeline::item_atom_v, conform_track_uuid);
-
-            track_item.unbind();
-            track_item.set_enabled(true);
-            track_item.set_locked(false);
+    mail(timeline::item_prop_atom_v)
+        .request(timeline.actor(), infinite)
+        .then(
+            [=](const JsonStore &timeline_prop) mutable {
+                try {
+                    auto conform_track_uuid =
+                        get_conform_track_uuid(timeline_prop, conform_track);
 
-            auto clip_items = track_item.find_all_items(timeline::IT_CLIP);
-            for (auto &i : clip_items) {
-                i.get().set_flag("");
-                i.get().set_enabled(true);
-                i.get().set_locked(false);
-            }
+                    // find track..
+                    mail(timeline::item_atom_v, conform_track_uuid)
+                        .request(timeline.actor(), infinite)
+                        .then(
+                            [=](timeline::Item track_item) mutable {
+                                // need media metadata populating.
+                                auto ritems = std::vector<ConformRequestItem>();
+                                for (const auto &i : media)
+                                    ritems.emplace_back(ConformRequestItem(i, i));
 
-            auto crequest        = ConformRequest(playlist, timeline, track_item, ritems);
-            crequest.operations_ = conform_operations;
+                                reset_conform_track(track_item);
 
-            for (const auto &i : clip_items) {
-                crequest.metadata_[i.get().uuid()] = i.get().prop();
-            }
+                                auto crequest =
+                                    ConformRequest(playlist, timeline, track_item, ritems);
+                                crequest.operations_ = conform_operations;
 
-            // need to populate all metadata.
-            conform_chain(rp, crequest);
+                                for (const auto &i :
+                                     track_item.find_all_items(timeline::IT_CLIP))
+                                    crequest.metadata_[i.get().uuid()] = i.get().prop();
 
-        } catch (const std::exception &err) {
-            spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
-            rp.deliver(make_error(sec::runtime_error, err.what()));
-        }
-    } catch (const std::exception &err) {
-        spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
-        rp.deliver(make_error(sec::runtime_error, err.what()));
-    }
+                                // need to populate all metadata.
+                                conform_chain(rp, crequest);
+                            },
+                            [=](const error &err) mutable {
+                                spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
+                                rp.deliver(err);
+                            });
+                } catch (const std::exception &err) {
+                    spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
+                    rp.deliver(make_error(sec::runtime_error, err.what()));
+                }
+            },
+            [=](const error &err) mutable {
+                spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
+                rp.deliver(err);
+            });
 }
 
 void ConformWorkerActor::conform_chain(
@@ -1333,73 +1599,94 @@ void ConformWorkerActor::find_matched(
     const UuidActor &clip,
     const UuidActor &timeline) {
 
-    std::pair<utility::UuidActor, utility::JsonStore> needle;
-    std::vector<std::pair<utility::UuidActor, utility::JsonStore>> haystack;
-
-    // very heavy get all clips in timeline and all metadata.
+    if (conformers_.empty())
+        return rp.deliver(UuidActorVector());
 
-    try {
-        scoped_actor sys{system()};
+    // get all clips in timeline and their media metadata, media requests are concurrent.
+    mail(timeline::item_atom_v)
+        .request(timeline.actor(), infinite)
+        .then(
+            [=](const timeline::Item &timeline_item) mutable {
+                auto clip_items = timeline_item.find_all_items(timeline::IT_CLIP);
+                auto metadata =
+                    std::make_shared<std::vector<std::pair<UuidActor, JsonStore>>>();
+                auto remaining  = std::make_shared<size_t>(clip_items.size());
+
+                for (const auto &i : clip_items)
+                    metadata->emplace_back(
+                        std::make_pair(i.get().uuid_actor(), i.get().prop()));
+
+                if (clip_items.empty())
+                    return find_matched_step_match(rp, key, clip, *metadata);
+
+                for (size_t i = 0; i < clip_items.size(); i++) {
+                    mail(
+                        playlist::get_media_atom_v,
+                        json_store::get_json_atom_v,
+                        utility::Uuid(),
+                        "")
+                        .request(clip_items[i].get().actor(), infinite)
+                        .then(
+                            [=](const JsonStore &media_meta) mutable {
+                                (*metadata)[i].second.update(media_meta);
+                                (*remaining)--;
+                                if (not *remaining)
+                                    find_matched_step_match(rp, key, clip, *metadata);
+                            },
+                            [=](const error &) mutable {
+                                // clip has no media.
+                                (*remaining)--;
+                                if (not *remaining)
+                                    find_matched_step_match(rp, key, clip, *metadata);
+                            });
+                }
+            },
+            [=](const error &err) mutable {
+                spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
+                rp.deliver(err);
+            });
+}
 
-        auto timeline_item =
-            request_receive<timeline::Item>(*sys, timeline.actor(), timeline::item_atom_v);
+void ConformWorkerActor::find_matched_step_match(
+    caf::typed_response_promise<UuidActorVector> rp,
+    const std::string &key,
+    const UuidActor &clip,
+    const std::vector<std::pair<UuidActor, JsonStore>> &metadata) {
 
-        auto clip_items = timeline_item.find_all_items(timeline::IT_CLIP);
-        for (const auto &i : clip_items) {
-            auto metadata = i.get().prop();
+    std::pair<utility::UuidActor, utility::JsonStore> needle;
+    std::vector<std::pair<utility::UuidActor, utility::JsonStore>> haystack;
 
-            try {
-                auto media_meta = request_receive<JsonStore>(
-                    *sys,
-                    i.get().actor(),
-                    playlist::get_media_atom_v,
-                    json_store::get_json_atom_v,
-                    utility::Uuid(),
-                    "");
-                metadata.update(media_meta);
-            } catch (...) {
-            }
+    haystack.reserve(metadata.size());
 
-            if (i.get().uuid() == clip.uuid()) {
-                needle.first  = clip;
-                needle.second = metadata;
-            } else {
-                haystack.push_back(std::make_pair(i.get().uuid_actor(), metadata));
-            }
+    for (const auto &i : metadata) {
+        if (i.first.uuid() == clip.uuid()) {
+            needle.first  = clip;
+            needle.second = i.second;
+        } else {
+            haystack.push_back(i);
         }
+    }
 
-        // need to request media metadata as well..
-
-
-        if (not conformers_.empty()) {
-            // request.dump();
-            fan_out_request<policy::select_all>(
-                conformers_, infinite, conform_atom_v, key, needle, haystack)
-                .then(
-                    [=](const std::vector<UuidActorVector> all_results) mutable {
-                        // compile results..
-                        auto result = UuidActorVector();
-                        auto dup    = std::set<Uuid>();
-
-                        for (const auto &i : all_results) {
-                            for (const auto &j : i) {
-                                if (not dup.count(j.uuid())) {
-                                    result.push_back(j);
-                                    dup.insert(j.uuid());
-                                }
-                            }
+    fan_out_request<policy::select_all>(
+        conformers_, infinite, conform_atom_v, key, needle, haystack)
+        .then(
+            [=](const std::vector<UuidActorVector> all_results) mutable {
+                // compile results..
+                auto result = UuidActorVector();
+                auto dup    = std::set<Uuid>();
+
+                for (const auto &i : all_results) {
+                    for (const auto &j : i) {
+                        if (not dup.count(j.uuid())) {
+                            result.push_back(j);
+                            dup.insert(j.uuid());
                         }
+                    }
+                }
 
-                        rp.deliver(result);
-                    },
-                    [=](const error &err) mutable { rp.deliver(err); });
-        } else {
-            rp.deliver(UuidActorVector());
-        }
-    } catch (const std::exception &err) {
-        spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
-        rp.deliver(make_error(sec::runtime_error, err.what()));
-    }
+                rp.deliver(result);
+            },
+            [=](const error &err) mutable { rp.deliver(err); });
 }
 
 ConformManagerActor::ConformManagerActor(caf::actor_config &cfg, const utility::Uuid uuid)
@@ -1476,6 +1763,11 @@ caf::message_handler ConformManagerActor::message_handler_extensions() {
                 data_.process_event(event, true, false, false);
         },
 
+        // progress from workers.
+        [=](utility::event_atom, conform_atom, const JsonStore &progress) {
+            mail(utility::event_atom_v, conform_atom_v, progress).send(event_group_);
+        },
+
         [=](json_store::sync_atom) -> UuidVector { return UuidVector({data_uuid_}); },
 
         [=](json_store::sync_atom, const Uuid &uuid) -> JsonStore {
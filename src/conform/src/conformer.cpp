@@ -37,3 +37,65 @@ utility::UuidActorVector Conformer::find_matching(
     const std::vector<std::pair<utility::UuidActor, utility::JsonStore>> &haystack) {
     return utility::UuidActorVector();
 }
+
+std::string ConformIndex::make_key(const std::vector<std::string> &parts) {
+    auto result = std::string();
+    for (const auto &i : parts) {
+        result += i;
+        // unit separator, won't appear in shot/version names.
+        result.push_back('\x1f');
+    }
+    return result;
+}
+
+std::string ConformIndex::make_key(const utility::JsonStore &metadata) const {
+    auto parts = std::vector<std::string>();
+    auto found = false;
+
+    parts.reserve(key_pointers_.size());
+
+    for (const auto &i : key_pointers_) {
+        try {
+            if (metadata.contains(i) and not metadata.at(i).is_null()) {
+                const auto &value = metadata.at(i);
+                parts.emplace_back(value.is_string() ? value.get<std::string>() : value.dump());
+                found = true;
+                continue;
+            }
+        } catch (...) {
+        }
+        parts.emplace_back();
+    }
+
+    return found ? make_key(parts) : std::string();
+}
+
+void ConformIndex::add(const std::string &key, const utility::UuidActor &item) {
+    if (key.empty())
+        return;
+
+    index_[key].push_back(item);
+    size_++;
+}
+
+void ConformIndex::add(const utility::UuidActor &item, const utility::JsonStore &metadata) {
+    add(make_key(metadata), item);
+}
+
+void ConformIndex::build(
+    const std::vector<std::pair<utility::UuidActor, utility::JsonStore>> &haystack) {
+    clear();
+    index_.reserve(haystack.size());
+    for (const auto &i : haystack)
+        add(i.first, i.second);
+}
+
+const utility::UuidActorVector &ConformIndex::find(const std::string &key) const {
+    if (not key.empty()) {
+        auto it = index_.find(key);
+        if (it != std::end(index_))
+            return it->second;
+    }
+
+    return empty_;
+}
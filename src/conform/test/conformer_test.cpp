@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include "xstudio/conform/conformer.hpp"
+#include "xstudio/utility/uuid.hpp"
+
+using namespace xstudio::utility;
+using namespace xstudio::conform;
+
+TEST(ConformIndexTest, Test) {
+    auto index = ConformIndex(
+        {nlohmann::json::json_pointer("/shot"), nlohmann::json::json_pointer("/version")});
+
+    auto a = UuidActor(Uuid::generate(), caf::actor());
+    auto b = UuidActor(Uuid::generate(), caf::actor());
+    auto c = UuidActor(Uuid::generate(), caf::actor());
+
+    index.build(
+        {std::make_pair(a, JsonStore(R"({"shot": "A001", "version": 1})"_json)),
+         std::make_pair(b, JsonStore(R"({"shot": "A002", "version": 1})"_json)),
+         std::make_pair(c, JsonStore(R"({"shot": "A001", "version": 1})"_json)),
+         std::make_pair(
+             UuidActor(Uuid::generate(), caf::actor()), JsonStore(R"({"other": 1})"_json))});
+
+    // unkeyed items are not indexed
+    EXPECT_EQ(index.size(), 3);
+    EXPECT_EQ(index.key_count(), 2);
+
+    auto result = index.find(JsonStore(R"({"shot": "A001", "version": 1})"_json));
+    EXPECT_EQ(result.size(), 2);
+    EXPECT_EQ(result[0].uuid(), a.uuid());
+    EXPECT_EQ(result[1].uuid(), c.uuid());
+
+    EXPECT_TRUE(index.find(JsonStore(R"({"shot": "A001", "version": 2})"_json)).empty());
+    EXPECT_TRUE(index.find(JsonStore(R"({"other": 1})"_json)).empty());
+
+    // explicit keys
+    auto explicit_index = ConformIndex();
+    explicit_index.add(ConformIndex::make_key({"show", "shot", ""}), a);
+    EXPECT_EQ(explicit_index.find(ConformIndex::make_key({"show", "shot", ""})).size(), 1);
+    EXPECT_TRUE(explicit_index.find(ConformIndex::make_key({"show", "shot"})).empty());
+    EXPECT_TRUE(explicit_index.find(ConformIndex::make_key({"shows", "hot", ""})).empty());
+}
@@ -3,6 +3,7 @@
 #include <caf/policy/select_all.hpp>
 #include <caf/actor_registry.hpp>
 
+#include <future>
 #include <tuple>
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -29,6 +30,7 @@
 #include "xstudio/ui/model_data/model_data_actor.hpp"
 #include "xstudio/ui/viewport/keypress_monitor.hpp"
 #include "xstudio/ui/viewport/viewport_layout_plugin.hpp"
+#include "xstudio/utility/frame_trace.hpp"
 #include "xstudio/utility/helpers.hpp"
 #include "xstudio/utility/logging.hpp"
 
@@ -47,6 +49,26 @@ using namespace xstudio::global;
 using namespace xstudio::utility;
 using namespace xstudio::global_store;
 
+namespace {
+
+using TimedSpawn = std::pair<caf::actor, double>;
+
+// Spawns T from a worker thread, returning the actor and the time in ms taken
+// to construct it. Global service constructors make blocking requests to each
+// other, so services that don't depend on one another can start concurrently.
+template <typename T, typename... Ts>
+std::future<TimedSpawn> spawn_timed(caf::actor_system &sys, Ts... xs) {
+    return std::async(std::launch::async, [&sys, xs...]() {
+        const auto start = utility::clock::now();
+        caf::actor actor = sys.spawn<T>(xs...);
+        return std::make_pair(
+            actor,
+            std::chrono::duration<double, std::milli>(utility::clock::now() - start).count());
+    });
+}
+
+} // namespace
+
 APIActor::APIActor(caf::actor_config &cfg, const caf::actor &global)
     : caf::event_based_actor(cfg), global_(global) {
 
@@ -183,25 +205,72 @@ void GlobalActor::init(
         gsa_ = spawn<global_store::GlobalStoreActor>("GlobalStore", prefs, read_only);
     }
 
-    auto phev            = spawn<playhead::PlayheadGlobalEventsActor>();
-    auto keyboard_events = spawn<ui::keypress_monitor::KeypressMonitor>();
-    auto ui_models       = spawn<ui::model_data::GlobalUIModelData>();
-    auto metadata_mgr    = spawn<media::GlobalMetadataManager>();
-    auto audio           = spawn<audio::GlobalAudioOutputActor>();
-    auto pm              = spawn<plugin_manager::PluginManagerActor>();
-    auto colour          = spawn<colour_pipeline::GlobalColourPipelineActor>();
-    auto gmma            = spawn<media_metadata::GlobalMediaMetadataActor>();
-    auto gica            = spawn<media_cache::GlobalImageCacheActor>();
-    auto gaca            = spawn<media_cache::GlobalAudioCacheActor>();
-    auto gmra            = spawn<media_reader::GlobalMediaReaderActor>();
-    auto gcca            = spawn<colour_pipeline::GlobalColourCacheActor>();
-    auto gmha            = spawn<media_hook::GlobalMediaHookActor>();
-    auto thumbnail       = spawn<thumbnail::ThumbnailManagerActor>();
-    auto pa =
-        embedded_python ? spawn<embedded_python::EmbeddedPythonActor>("Python") : caf::actor();
-    auto scanner = spawn<scanner::ScannerActor>();
-    auto conform = spawn<conform::ConformManagerActor>();
-    auto vpmgr   = spawn<ui::viewport::ViewportLayoutManager>();
+    const auto startup_start = utility::clock::now();
+    auto services            = nlohmann::json::object();
+    auto started             = [&](const std::string &name, std::future<TimedSpawn> f) {
+        auto result    = f.get();
+        services[name] = result.second;
+        return result.first;
+    };
+
+    // Services looked up by resident plugins and the other services when
+    // they are created, so these start in order.
+    auto phev = started(
+        "PlayheadGlobalEventsActor",
+        spawn_timed<playhead::PlayheadGlobalEventsActor>(system()));
+    auto keyboard_events = started(
+        "KeypressMonitor", spawn_timed<ui::keypress_monitor::KeypressMonitor>(system()));
+    auto ui_models =
+        started("GlobalUIModelData", spawn_timed<ui::model_data::GlobalUIModelData>(system()));
+    auto metadata_mgr =
+        started("GlobalMetadataManager", spawn_timed<media::GlobalMetadataManager>(system()));
+    auto audio =
+        started("GlobalAudioOutputActor", spawn_timed<audio::GlobalAudioOutputActor>(system()));
+    auto pm = started(
+        "PluginManagerActor", spawn_timed<plugin_manager::PluginManagerActor>(system()));
+
+    // These only depend on the services above, so start concurrently.
+    auto colour_f  = spawn_timed<colour_pipeline::GlobalColourPipelineActor>(system());
+    auto gmma_f    = spawn_timed<media_metadata::GlobalMediaMetadataActor>(system());
+    auto gica_f    = spawn_timed<media_cache::GlobalImageCacheActor>(system());
+    auto gaca_f    = spawn_timed<media_cache::GlobalAudioCacheActor>(system());
+    auto gcca_f    = spawn_timed<colour_pipeline::GlobalColourCacheActor>(system());
+    auto gmha_f    = spawn_timed<media_hook::GlobalMediaHookActor>(system());
+    auto scanner_f = spawn_timed<scanner::ScannerActor>(system());
+    auto conform_f = spawn_timed<conform::ConformManagerActor>(system());
+    auto vpmgr_f   = spawn_timed<ui::viewport::ViewportLayoutManager>(system());
+
+    // the reader needs the caches, thumbnails need the reader.
+    auto gica = started("GlobalImageCacheActor", std::move(gica_f));
+    auto gaca = started("GlobalAudioCacheActor", std::move(gaca_f));
+    auto gmra = started(
+        "GlobalMediaReaderActor",
+        spawn_timed<media_reader::GlobalMediaReaderActor>(system()));
+    auto thumbnail = started(
+        "ThumbnailManagerActor", spawn_timed<thumbnail::ThumbnailManagerActor>(system()));
+
+    auto colour  = started("GlobalColourPipelineActor", std::move(colour_f));
+    auto gmma    = started("GlobalMediaMetadataActor", std::move(gmma_f));
+    auto gcca    = started("GlobalColourCacheActor", std::move(gcca_f));
+    auto gmha    = started("GlobalMediaHookActor", std::move(gmha_f));
+    auto scanner = started("ScannerActor", std::move(scanner_f));
+    auto conform = started("ConformManagerActor", std::move(conform_f));
+    auto vpmgr   = started("ViewportLayoutManager", std::move(vpmgr_f));
+
+    auto pa = embedded_python
+                  ? started(
+                        "EmbeddedPythonActor",
+                        spawn_timed<embedded_python::EmbeddedPythonActor>(
+                            system(), std::string("Python")))
+                  : caf::actor();
+
+    startup_timing_["services"] = services;
+    startup_timing_["total_ms"] =
+        std::chrono::duration<double, std::milli>(utility::clock::now() - startup_start)
+            .count();
+    spdlog::info(
+        "Started global services in {:.0f}ms", startup_timing_["total_ms"].get<double>());
+    spdlog::debug("Global service startup {}", startup_timing_.dump());
 
     link_to(audio);
     link_to(colour);
@@ -317,6 +386,34 @@ void GlobalActor::init(
 
         [=](status_atom) -> StatusType { return status_; },
 
+        // frame pipeline tracing, per stage latency histograms
+        [=](frame_trace_atom) -> JsonStore {
+            return JsonStore(FrameTracer::instance().statistics());
+        },
+
+        // time taken to start each global service, in milliseconds
+        [=](startup_timing_atom) -> JsonStore { return startup_timing_; },
+
+        [=](frame_trace_atom, const bool enable) -> bool {
+            FrameTracer::instance().set_enabled(enable);
+            return enable;
+        },
+
+        [=](frame_trace_atom, utility::clear_atom) -> bool {
+            FrameTracer::instance().clear();
+            return true;
+        },
+
+        // write recorded spans as Chrome trace json
+        [=](frame_trace_atom, const std::string &path) -> result<bool> {
+            try {
+                FrameTracer::instance().write_chrome_trace(path);
+            } catch (const std::exception &err) {
+                return make_error(xstudio_error::error, err.what());
+            }
+            return true;
+        },
+
         [=](status_atom, const StatusType field, const bool set) mutable -> StatusType {
             if (set)
                 status_ = status_ | field;
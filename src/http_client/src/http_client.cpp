@@ -1,7 +1,415 @@
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+#include <cctype>
+#include <regex>
+
 #include "xstudio/http_client/http_client.hpp"
 #include "xstudio/utility/helpers.hpp"
 
 using namespace xstudio::http_client;
 using namespace xstudio::utility;
+
+namespace {
+
+int64_t to_ns(const time_point &tp) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+}
+
+std::string lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) {
+        return std::tolower(c);
+    });
+    return s;
+}
+
+// path names the same resource as parent, or one beneath it
+bool beneath(const std::string &path, const std::string &parent) {
+    if (path.compare(0, parent.size(), parent) != 0)
+        return false;
+    return path.size() == parent.size() || path[parent.size()] == '/' ||
+           (!parent.empty() && parent.back() == '/');
+}
+
+} // namespace
+
+void HTTPResponseCache::set_max_bytes(const size_t max_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_bytes_ = max_bytes;
+    while (bytes_ > max_bytes_ && !lru_.empty())
+        erase(entries_.find(lru_.back()));
+}
+
+void HTTPResponseCache::set_default_ttl(const std::chrono::seconds default_ttl) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    default_ttl_ = default_ttl;
+}
+
+std::string HTTPResponseCache::key(
+    const std::string &scheme_host_port,
+    const std::string &path,
+    const httplib::Headers &headers,
+    const httplib::Params &params) {
+    // the request headers are part of the key, so responses fetched with one
+    // set of credentials are never handed to a request made with another
+    auto result = httplib::append_query_params(scheme_host_port + path, params);
+    for (const auto &h : headers)
+        result += "\n" + lower(h.first) + ":" + h.second;
+    return result;
+}
+
+std::optional<std::chrono::seconds>
+HTTPResponseCache::lifetime(const httplib::Response &response) const {
+    const auto cache_control = lower(response.get_header_value("Cache-Control"));
+    if (cache_control.find("no-store") != std::string::npos ||
+        cache_control.find("private") != std::string::npos)
+        return {};
+
+    auto result = default_ttl_;
+    static const std::regex max_age(R"(max-age\s*=\s*(\d+))");
+    std::smatch m;
+    if (cache_control.find("no-cache") != std::string::npos)
+        result = std::chrono::seconds(0);
+    else if (std::regex_search(cache_control, m, max_age))
+        result = std::chrono::seconds(std::stoll(m[1].str()));
+
+    if (result.count() <= 0 && !response.has_header("ETag") &&
+        !response.has_header("Last-Modified"))
+        return {};
+
+    return result;
+}
+
+std::optional<httplib::Response> HTTPResponseCache::fresh(const std::string &key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto p = entries_.find(key);
+    if (p == entries_.end() || p->second.expires < clock::now())
+        return {};
+    lru_.splice(lru_.begin(), lru_, p->second.lru);
+    return p->second.response;
+}
+
+httplib::Headers HTTPResponseCache::validators(const std::string &key) const {
+    httplib::Headers result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto p = entries_.find(key);
+    if (p == entries_.end())
+        return result;
+
+    const auto &response = p->second.response;
+    if (response.has_header("ETag"))
+        result.emplace("If-None-Match", response.get_header_value("ETag"));
+    if (response.has_header("Last-Modified"))
+        result.emplace("If-Modified-Since", response.get_header_value("Last-Modified"));
+    return result;
+}
+
+std::optional<httplib::Response> HTTPResponseCache::revalidated(
+    const std::string &key, const httplib::Response &not_modified) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto p = entries_.find(key);
+    if (p == entries_.end())
+        return {};
+
+    // a 304 may carry a new lifetime
+    auto &entry = p->second;
+    if (not_modified.has_header("Cache-Control")) {
+        entry.response.set_header(
+            "Cache-Control", not_modified.get_header_value("Cache-Control"));
+    }
+    const auto ttl = lifetime(entry.response).value_or(std::chrono::seconds(0));
+    entry.expires  = clock::now() + ttl;
+    lru_.splice(lru_.begin(), lru_, entry.lru);
+    return entry.response;
+}
+
+void HTTPResponseCache::store(
+    const std::string &key,
+    const std::string &scheme_host_port,
+    const std::string &path,
+    const httplib::Response &response) {
+
+    if (response.status != 200)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto ttl = lifetime(response);
+    if (!ttl)
+        return;
+
+    const size_t size = key.size() + response.body.size();
+    if (size > max_bytes_)
+        return;
+
+    auto p = entries_.find(key);
+    if (p != entries_.end())
+        erase(p);
+
+    lru_.push_front(key);
+    auto &entry            = entries_[key];
+    entry.response         = response;
+    entry.scheme_host_port = scheme_host_port;
+    entry.path             = path;
+    entry.expires          = clock::now() + *ttl;
+    entry.bytes            = size;
+    entry.lru              = lru_.begin();
+    bytes_ += size;
+
+    while (bytes_ > max_bytes_ && !lru_.empty())
+        erase(entries_.find(lru_.back()));
+}
+
+void HTTPResponseCache::invalidate(
+    const std::string &scheme_host_port, const std::string &path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto p = entries_.begin(); p != entries_.end();) {
+        auto next = std::next(p);
+        if (p->second.scheme_host_port == scheme_host_port &&
+            (beneath(p->second.path, path) || beneath(path, p->second.path)))
+            erase(p);
+        p = next;
+    }
+}
+
+void HTTPResponseCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lru_.clear();
+    bytes_ = 0;
+}
+
+size_t HTTPResponseCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+size_t HTTPResponseCache::bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+}
+
+void HTTPResponseCache::erase(std::unordered_map<std::string, Entry>::iterator entry) {
+    bytes_ -= entry->second.bytes;
+    lru_.erase(entry->second.lru);
+    entries_.erase(entry);
+}
+
+HTTPClient::HTTPClient(
+    const time_t connection_timeout,
+    const time_t read_timeout,
+    const time_t write_timeout,
+    const size_t max_idle_per_host)
+    : connection_timeout_(connection_timeout),
+      read_timeout_(read_timeout),
+      write_timeout_(write_timeout),
+      max_idle_per_host_(max_idle_per_host) {}
+
+void HTTPClient::set_max_idle_per_host(const size_t max_idle_per_host) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_idle_per_host_ = max_idle_per_host;
+    for (auto &i : idle_) {
+        if (i.second.size() > max_idle_per_host_)
+            i.second.resize(max_idle_per_host_);
+    }
+}
+
+std::unique_ptr<httplib::Client> HTTPClient::acquire(const std::string &scheme_host_port) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto p = idle_.find(scheme_host_port);
+        if (p != idle_.end() && !p->second.empty()) {
+            auto result = std::move(p->second.back());
+            p->second.pop_back();
+            connections_reused_++;
+            return result;
+        }
+    }
+
+    auto result = std::make_unique<httplib::Client>(scheme_host_port.c_str());
+    result->set_follow_location(true);
+    result->set_keep_alive(true);
+    result->set_connection_timeout(connection_timeout_, 0);
+    result->set_read_timeout(read_timeout_, 0);
+    result->set_write_timeout(write_timeout_, 0);
+    connections_opened_++;
+    return result;
+}
+
+void HTTPClient::release(
+    const std::string &scheme_host_port, std::unique_ptr<httplib::Client> client) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &idle = idle_[scheme_host_port];
+    if (idle.size() < max_idle_per_host_)
+        idle.emplace_back(std::move(client));
+}
+
+httplib::Result HTTPClient::send(
+    const std::string &scheme_host_port,
+    const std::function<httplib::Result(httplib::Client &)> &request) {
+
+    const auto started = clock::now();
+    requests_++;
+
+    // a connection that failed is dropped rather than going back in the pool
+    auto client = acquire(scheme_host_port);
+    auto result = request(*client);
+    if (result.error() == httplib::Error::Success)
+        release(scheme_host_port, std::move(client));
+    else
+        failed_++;
+
+    latency_.add(to_ns(clock::now()) - to_ns(started));
+    return result;
+}
+
+httplib::Result HTTPClient::get(
+    const std::string &scheme_host_port,
+    const std::string &path,
+    const httplib::Headers &headers,
+    const httplib::Params &params) {
+
+    const auto key = HTTPResponseCache::key(scheme_host_port, path, headers, params);
+
+    // callers can ask for a response straight from the server
+    const bool use_fresh =
+        lower(httplib::detail::get_header_value(headers, "Cache-Control", 0, ""))
+            .find("no-cache") == std::string::npos;
+
+    if (use_fresh) {
+        if (auto cached = cache_.fresh(key)) {
+            cache_hits_++;
+            return httplib::Result(
+                std::make_unique<httplib::Response>(std::move(*cached)),
+                httplib::Error::Success);
+        }
+    }
+
+    auto request_headers  = headers;
+    const auto validators = cache_.validators(key);
+    for (const auto &v : validators)
+        request_headers.insert(v);
+
+    auto result = send(scheme_host_port, [&](httplib::Client &cli) {
+        if (validators.empty())
+            return cli.Get(path.c_str(), params, headers);
+
+        // httplib takes a 304 for a redirect it can't follow, so conditional
+        // requests don't follow them, and any real redirect is asked for again
+        cli.set_follow_location(false);
+        auto conditional = cli.Get(path.c_str(), params, request_headers);
+        cli.set_follow_location(true);
+
+        if (conditional.error() == httplib::Error::Success && conditional &&
+            conditional->status >= 300 && conditional->status < 400 &&
+            conditional->status != 304)
+            return cli.Get(path.c_str(), params, headers);
+        return conditional;
+    });
+
+    if (result.error() == httplib::Error::Success && result) {
+        if (result->status == 304) {
+            if (auto cached = cache_.revalidated(key, *result)) {
+                cache_revalidated_++;
+                return httplib::Result(
+                    std::make_unique<httplib::Response>(std::move(*cached)),
+                    httplib::Error::Success);
+            }
+        }
+        cache_misses_++;
+        cache_.store(key, scheme_host_port, path, *result);
+    }
+
+    return result;
+}
+
+httplib::Result HTTPClient::post(
+    const std::string &scheme_host_port,
+    const std::string &path,
+    const httplib::Headers &headers,
+    const httplib::Params &params,
+    const std::string &body,
+    const std::string &content_type) {
+
+    auto result = send(scheme_host_port, [&](httplib::Client &cli) {
+        if (content_type.empty())
+            return cli.Post(path.c_str(), headers, params);
+        return cli.Post(path.c_str(), headers, body, content_type.c_str());
+    });
+
+    // searches are POSTs too, but don't change anything
+    if (path.find("/_search") == std::string::npos)
+        cache_.invalidate(scheme_host_port, path);
+    return result;
+}
+
+httplib::Result HTTPClient::put(
+    const std::string &scheme_host_port,
+    const std::string &path,
+    const httplib::Headers &headers,
+    const httplib::Params &params,
+    const std::string &body,
+    const std::string &content_type) {
+
+    auto result = send(scheme_host_port, [&](httplib::Client &cli) {
+        if (content_type.empty())
+            return cli.Put(path.c_str(), headers, params);
+
+        if (params.empty())
+            return cli.Put(path.c_str(), headers, body, content_type.c_str());
+
+        auto param_path = httplib::append_query_params(path, params);
+        return cli.Put(param_path.c_str(), headers, body, content_type.c_str());
+    });
+
+    cache_.invalidate(scheme_host_port, path);
+    return result;
+}
+
+httplib::Result HTTPClient::del(
+    const std::string &scheme_host_port,
+    const std::string &path,
+    const httplib::Headers &headers,
+    const std::string &body,
+    const std::string &content_type) {
+
+    auto result = send(scheme_host_port, [&](httplib::Client &cli) {
+        if (content_type.empty())
+            return cli.Delete(path.c_str(), headers);
+        return cli.Delete(path.c_str(), headers, body, content_type.c_str());
+    });
+
+    cache_.invalidate(scheme_host_port, path);
+    return result;
+}
+
+nlohmann::json HTTPClient::stats() const {
+    const uint64_t hits        = cache_hits_;
+    const uint64_t revalidated = cache_revalidated_;
+    const uint64_t misses      = cache_misses_;
+    const uint64_t lookups     = hits + revalidated + misses;
+
+    return nlohmann::json{
+        {"requests", uint64_t(requests_)},
+        {"failed", uint64_t(failed_)},
+        {"connections_opened", uint64_t(connections_opened_)},
+        {"connections_reused", uint64_t(connections_reused_)},
+        {"latency", latency_.json()},
+        {"cache",
+         {{"hits", hits},
+          {"revalidated", revalidated},
+          {"misses", misses},
+          {"hit_rate", lookups ? double(hits + revalidated) / double(lookups) : 0.0},
+          {"entries", cache_.size()},
+          {"bytes", cache_.bytes()}}}};
+}
+
+void HTTPClient::clear_stats() {
+    requests_           = 0;
+    failed_             = 0;
+    connections_opened_ = 0;
+    connections_reused_ = 0;
+    cache_hits_         = 0;
+    cache_revalidated_  = 0;
+    cache_misses_       = 0;
+    latency_.clear();
+}
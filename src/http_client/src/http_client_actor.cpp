@@ -3,6 +3,7 @@
 #include "xstudio/http_client/http_client_actor.hpp"
 #include "xstudio/atoms.hpp"
 #include "xstudio/utility/helpers.hpp"
+#include "xstudio/utility/json_store.hpp"
 #include "xstudio/utility/logging.hpp"
 #include "xstudio/utility/uuid.hpp"
 
@@ -60,12 +61,8 @@ std::string HTTPWorker::get_error_string(const httplib::Error err) {
     return "Unknown";
 }
 
-HTTPWorker::HTTPWorker(
-    caf::actor_config &cfg,
-    time_t connection_timeout,
-    time_t read_timeout,
-    time_t write_timeout)
-    : caf::event_based_actor(cfg) {
+HTTPWorker::HTTPWorker(caf::actor_config &cfg, std::shared_ptr<HTTPClient> client)
+    : caf::event_based_actor(cfg), client_(std::move(client)) {
     behavior_.assign(
         [=](xstudio::broadcast::broadcast_down_atom, const caf::actor_addr &) {},
         [=](http_delete_atom,
@@ -76,16 +73,7 @@ HTTPWorker::HTTPWorker(
             const std::string &content_type) -> result<httplib::Response> {
             // spdlog::warn("http_delete_atom {}", path);
             try {
-                httplib::Client cli(scheme_host_port.c_str());
-                cli.set_follow_location(true);
-                cli.set_connection_timeout(connection_timeout, 0);
-                cli.set_read_timeout(read_timeout, 0);
-                cli.set_write_timeout(write_timeout, 0);
-                auto res = [&]() -> httplib::Result {
-                    if (content_type.empty())
-                        return cli.Delete(path.c_str(), headers);
-                    return cli.Delete(path.c_str(), headers, body, content_type.c_str());
-                }();
+                auto res = client_->del(scheme_host_port, path, headers, body, content_type);
 
                 if (res.error() != httplib::Error::Success)
                     return make_error(hce::rest_error, get_error_string(res.error()));
@@ -130,17 +118,7 @@ HTTPWorker::HTTPWorker(
             // spdlog::warn("http_get_atom {}", path);
 
             try {
-                httplib::Client cli(scheme_host_port.c_str());
-                cli.set_follow_location(true);
-                cli.set_connection_timeout(connection_timeout, 0);
-                cli.set_read_timeout(read_timeout, 0);
-                cli.set_write_timeout(write_timeout, 0);
-
-                // cli.set_logger([](const auto& req, const auto& res) {
-                //     spdlog::warn("{}", req.);
-                // });
-
-                auto result = cli.Get(path.c_str(), params, headers);
+                auto result = client_->get(scheme_host_port, path, headers, params);
 
                 if (result.error() != httplib::Error::Success) {
                     auto error = get_error_string(result.error());
@@ -195,16 +173,8 @@ HTTPWorker::HTTPWorker(
             // spdlog::warn("http_post_atom {}", path);
 
             try {
-                httplib::Client cli(scheme_host_port.c_str());
-                cli.set_follow_location(true);
-                cli.set_connection_timeout(connection_timeout, 0);
-                cli.set_read_timeout(read_timeout, 0);
-                cli.set_write_timeout(write_timeout, 0);
-                auto res = [&]() -> httplib::Result {
-                    if (content_type.empty())
-                        return cli.Post(path.c_str(), headers, params);
-                    return cli.Post(path.c_str(), headers, body, content_type.c_str());
-                }();
+                auto res =
+                    client_->post(scheme_host_port, path, headers, params, body, content_type);
 
                 if (res.error() != httplib::Error::Success)
                     return make_error(hce::rest_error, get_error_string(res.error()));
@@ -252,23 +222,8 @@ HTTPWorker::HTTPWorker(
             // spdlog::warn("http_put_atom {}", path);
 
             try {
-                httplib::Client cli(scheme_host_port.c_str());
-                cli.set_follow_location(true);
-                cli.set_connection_timeout(connection_timeout, 0);
-                cli.set_read_timeout(read_timeout, 0);
-                cli.set_write_timeout(write_timeout, 0);
-
-                auto res = [&]() -> httplib::Result {
-                    if (content_type.empty())
-                        return cli.Put(path.c_str(), headers, params);
-
-                    if (params.empty())
-                        return cli.Put(path.c_str(), headers, body, content_type.c_str());
-
-                    auto param_path = httplib::append_query_params(path, params);
-                    return cli.Put(param_path.c_str(), headers, body, content_type.c_str());
-                }();
-
+                auto res =
+                    client_->put(scheme_host_port, path, headers, params, body, content_type);
 
                 if (res.error() != httplib::Error::Success)
                     return make_error(hce::rest_error, get_error_string(res.error()));
@@ -311,16 +266,24 @@ HTTPClientActor::HTTPClientActor(
     caf::actor_config &cfg,
     time_t connection_timeout,
     time_t read_timeout,
-    time_t write_timeout)
+    time_t write_timeout,
+    size_t worker_count,
+    std::chrono::seconds cache_ttl,
+    size_t cache_bytes)
     : caf::event_based_actor(cfg),
       connection_timeout_(connection_timeout),
       read_timeout_(read_timeout),
-      write_timeout_(write_timeout) {
+      write_timeout_(write_timeout),
+      worker_count_(worker_count) {
+    // one client for all the workers, so they share its connections and cache
+    client_ = std::make_shared<HTTPClient>(
+        connection_timeout_, read_timeout_, write_timeout_, worker_count_);
+    client_->cache().set_default_ttl(cache_ttl);
+    client_->cache().set_max_bytes(cache_bytes);
     init();
 }
 
 void HTTPClientActor::init() {
-    size_t worker_count = 10;
     spdlog::debug("Created HTTPClientActor");
     print_on_exit(this, "HTTPClientActor");
 
@@ -336,11 +299,8 @@ void HTTPClientActor::init() {
 
     auto pool = caf::actor_pool::make(
         system(),
-        worker_count,
-        [&] {
-            return system().spawn<HTTPWorker>(
-                connection_timeout_, read_timeout_, write_timeout_);
-        },
+        worker_count_,
+        [&] { return system().spawn<HTTPWorker>(client_); },
         caf::actor_pool::round_robin());
 
 #pragma GCC diagnostic pop
@@ -349,6 +309,13 @@ void HTTPClientActor::init() {
 
     behavior_.assign(
         [=](xstudio::broadcast::broadcast_down_atom, const caf::actor_addr &) {},
+        [=](http_stats_atom) -> JsonStore { return JsonStore(client_->stats()); },
+        [=](http_stats_atom, const bool clear) -> JsonStore {
+            auto result = JsonStore(client_->stats());
+            if (clear)
+                client_->clear_stats();
+            return result;
+        },
         [=](http_delete_atom atom,
             const std::string &scheme_host_port,
             const std::string &path) {
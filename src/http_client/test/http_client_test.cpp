@@ -1,5 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 #include <gtest/gtest.h>
+#include <set>
+#include <thread>
 
 #include "xstudio/http_client/http_client.hpp"
 #include "xstudio/utility/helpers.hpp"
@@ -8,6 +10,56 @@
 using namespace xstudio::utility;
 using namespace xstudio::http_client;
 
+namespace {
+
+// a local server standing in for ShotGrid, counting what reaches it
+class HTTPClientTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        server_.Get("/api/entity/([0-9]+)", [this](const auto &req, auto &res) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            gets_++;
+            ports_.insert(req.remote_port);
+            if (req.get_header_value("If-None-Match") == etag_) {
+                res.status = 304;
+                return;
+            }
+            res.set_header("ETag", etag_);
+            res.set_header("Cache-Control", max_age_);
+            res.set_content("{\"id\": " + req.matches[1].str() + "}", "application/json");
+        });
+        server_.Put("/api/entity/([0-9]+)", [this](const auto &, auto &res) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            etag_ = "\"v2\"";
+            res.set_content("{}", "application/json");
+        });
+
+        port_   = server_.bind_to_any_port("127.0.0.1");
+        thread_ = std::thread([this]() { server_.listen_after_bind(); });
+        while (!server_.is_running())
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        host_ = "http://127.0.0.1:" + std::to_string(port_);
+    }
+
+    void TearDown() override {
+        server_.stop();
+        thread_.join();
+    }
+
+    httplib::Server server_;
+    std::thread thread_;
+    int port_ = {0};
+    std::string host_;
+
+    std::mutex mutex_;
+    int gets_ = {0};
+    std::set<int> ports_;
+    std::string etag_    = "\"v1\"";
+    std::string max_age_ = "max-age=60";
+};
+
+} // namespace
+
 TEST(HttpClientTest, Test) {
     httplib::Client cli("http://localhost");
     cli.set_follow_location(true);
@@ -16,3 +68,97 @@ TEST(HttpClientTest, Test) {
     cli.set_write_timeout(5, 0);
     auto res = cli.Get("", httplib::Params(), httplib::Headers());
 }
+
+TEST_F(HTTPClientTest, KeepAlive) {
+    HTTPClient client(5, 5, 5);
+    // fresh responses aren't asked for again, don't let the cache answer
+    const auto headers = httplib::Headers({{"Cache-Control", "no-cache"}});
+
+    for (int i = 0; i < 5; ++i) {
+        auto res = client.get(host_, "/api/entity/1", headers, httplib::Params());
+        ASSERT_EQ(res.error(), httplib::Error::Success);
+        EXPECT_EQ(res->status, 200);
+    }
+
+    EXPECT_EQ(gets_, 5);
+    EXPECT_EQ(ports_.size(), size_t(1));
+
+    const auto stats = client.stats();
+    EXPECT_EQ(stats["requests"], 5);
+    EXPECT_EQ(stats["connections_opened"], 1);
+    EXPECT_EQ(stats["connections_reused"], 4);
+}
+
+TEST_F(HTTPClientTest, Cache) {
+    HTTPClient client(5, 5, 5);
+
+    auto res = client.get(host_, "/api/entity/1", httplib::Headers(), httplib::Params());
+    ASSERT_EQ(res.error(), httplib::Error::Success);
+    EXPECT_EQ(res->body, "{\"id\": 1}");
+
+    // fresh for its max-age
+    res = client.get(host_, "/api/entity/1", httplib::Headers(), httplib::Params());
+    EXPECT_EQ(res->status, 200);
+    EXPECT_EQ(res->body, "{\"id\": 1}");
+    EXPECT_EQ(gets_, 1);
+
+    // other request headers are other responses
+    res = client.get(
+        host_, "/api/entity/1", httplib::Headers({{"Authorization", "x"}}), httplib::Params());
+    EXPECT_EQ(gets_, 2);
+
+    // stale, so it's revalidated with its etag
+    max_age_ = "max-age=0";
+    client.cache().clear();
+    client.get(host_, "/api/entity/2", httplib::Headers(), httplib::Params());
+    res = client.get(host_, "/api/entity/2", httplib::Headers(), httplib::Params());
+    EXPECT_EQ(gets_, 4);
+    EXPECT_EQ(res->status, 200);
+    EXPECT_EQ(res->body, "{\"id\": 2}");
+
+    // a PUT changes it
+    client.put(host_, "/api/entity/2", httplib::Headers(), httplib::Params(), "{}", "");
+    EXPECT_EQ(client.cache().size(), size_t(0));
+
+    const auto stats = client.stats()["cache"];
+    EXPECT_EQ(stats["hits"], 1);
+    EXPECT_EQ(stats["revalidated"], 1);
+    EXPECT_EQ(stats["misses"], 3);
+}
+
+TEST(HTTPResponseCacheTest, Store) {
+    HTTPResponseCache cache(1024);
+
+    httplib::Response response;
+    response.status = 200;
+    response.body   = std::string(400, 'x');
+
+    // nothing to say how long it's good for, or how to check it
+    const auto key = HTTPResponseCache::key("http://host", "/a", {}, {});
+    cache.store(key, "http://host", "/a", response);
+    EXPECT_EQ(cache.size(), size_t(0));
+
+    cache.set_default_ttl(std::chrono::seconds(60));
+    cache.store(key, "http://host", "/a", response);
+    EXPECT_TRUE(cache.fresh(key));
+
+    response.set_header("Cache-Control", "no-store");
+    cache.store(
+        HTTPResponseCache::key("http://host", "/b", {}, {}), "http://host", "/b", response);
+    EXPECT_EQ(cache.size(), size_t(1));
+
+    // over budget, the least recently used goes
+    response.headers.clear();
+    for (const auto &path : {"/a/1", "/a/2", "/c"}) {
+        cache.store(
+            HTTPResponseCache::key("http://host", path, {}, {}), "http://host", path, response);
+    }
+    EXPECT_EQ(cache.size(), size_t(2));
+    EXPECT_LE(cache.bytes(), size_t(1024));
+    EXPECT_FALSE(cache.fresh(key));
+
+    // changing /a changes what's under it
+    cache.invalidate("http://host", "/a");
+    EXPECT_EQ(cache.size(), size_t(1));
+    EXPECT_TRUE(cache.fresh(HTTPResponseCache::key("http://host", "/c", {}, {})));
+}
@@ -0,0 +1,692 @@
+// SPDX-License-Identifier: Apache-2.0
+
+// Headless playback benchmark. Runs the playback pipeline (media readers,
+// cache, playhead and viewport frame queues) without Qt or OpenGL. Each
+// viewport is simulated by a thread that asks its ViewportFrameQueueActor for
+// frames at the display refresh rate, exactly as a real viewport does, and
+// records which playhead frame would have gone on screen.
+//
+// A single configuration is run in-process. When more than one value is given
+// for --fps, --velocity, --viewports or --readers the benchmark re-runs itself
+// for every combination, so each configuration gets a fresh actor system and
+// its own memory figures, and the results are reported as a JSON array.
+
+#include <args/args.hxx>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <unistd.h>
+#else
+#define popen _popen
+#define pclose _pclose
+#endif
+
+#include <caf/actor_registry.hpp>
+#include <caf/actor_system.hpp>
+#include <caf/scoped_actor.hpp>
+
+#include "xstudio/atoms.hpp"
+#include "xstudio/global/global_actor.hpp"
+#include "xstudio/global/xstudio_actor_system.hpp"
+#include "xstudio/global_store/global_store.hpp"
+#include "xstudio/media/media_actor.hpp"
+#include "xstudio/media_reader/image_buffer_set.hpp"
+#include "xstudio/playhead/playhead_actor.hpp"
+#include "xstudio/session/session_actor.hpp"
+#include "xstudio/ui/viewport/viewport_frame_queue_actor.hpp"
+#include "xstudio/utility/caf_helpers.hpp"
+#include "xstudio/utility/frame_trace.hpp"
+#include "xstudio/utility/helpers.hpp"
+#include "xstudio/utility/logging.hpp"
+#include "xstudio/utility/serialise_headers.hpp"
+#include "xstudio/utility/string_helpers.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct BenchmarkArgs {
+
+    args::ArgumentParser parser = {
+        "xstudio playback benchmark. v" PROJECT_VERSION,
+        "Plays media through the xstudio playback pipeline with null viewports and reports "
+        "delivered frame rate, dropped frames, reader queueing, cache hit rate and memory."};
+    args::HelpFlag help = {parser, "help", "Display this help menu", {'h', "help"}};
+
+    args::PositionalList<std::string> media_paths = {
+        parser, "PATH", "Media to play, defaults to the exr, ppm and mov test media"};
+
+    args::ValueFlag<std::string> session = {
+        parser,
+        "PATH",
+        "Session file, plays the first timeline or, if there is none, the first playlist",
+        {"session"}};
+    args::ValueFlag<std::string> generate = {
+        parser,
+        "WxH:N",
+        "Generate N frames of WxH PPM test media in a temporary folder and play them",
+        {"generate"}};
+
+    args::Group sweep = {parser, "Playback options, comma separated lists are swept"};
+    args::ValueFlag<std::string> fps = {sweep, "FPS", "Playhead rate", {'f', "fps"}, "24"};
+    args::ValueFlag<std::string> velocity = {
+        sweep, "VELOCITY", "Playback speed multiplier", {"velocity"}, "1"};
+    args::ValueFlag<std::string> viewports = {
+        sweep, "N", "Number of null viewports attached to the playhead", {"viewports"}, "1"};
+    args::ValueFlag<std::string> readers = {
+        sweep,
+        "N",
+        "readers_per_source for the OpenEXR and FFMPEG readers, 0 uses the preference",
+        {"readers"},
+        "0"};
+
+    args::Group run = {parser, "Run options"};
+    args::ValueFlag<double> refresh = {
+        run, "HZ", "Refresh rate of the null viewports", {"refresh"}, 60.0};
+    args::ValueFlag<double> duration = {
+        run, "SECONDS", "Measured playback time", {'d', "duration"}, 10.0};
+    args::ValueFlag<double> warmup = {
+        run, "SECONDS", "Playback time before measuring starts", {"warmup"}, 2.0};
+    args::Flag json = {run, "json", "Print results as json only", {"json"}};
+    args::ValueFlag<std::string> trace = {
+        run, "PATH", "Write a Chrome trace of the measured playback", {"trace"}};
+    args::Flag debug = {run, "debug", "Debug logging", {"debug"}};
+
+    void parse_args(int argc, char **argv) {
+        try {
+            parser.ParseCLI(argc, argv);
+        } catch (const args::Help &) {
+            std::cerr << parser;
+            std::exit(EXIT_SUCCESS);
+        } catch (const args::ParseError &e) {
+            std::cerr << e.what() << std::endl;
+            std::cerr << parser;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+};
+
+struct Config {
+    double fps;
+    double velocity;
+    int viewports;
+    int readers;
+};
+
+// Stands in for the viewport and the colour pipeline for a
+// ViewportFrameQueueActor, passing image sets through unchanged.
+class NullViewportActor : public caf::event_based_actor {
+  public:
+    NullViewportActor(caf::actor_config &cfg) : caf::event_based_actor(cfg) {
+
+        behavior_.assign(
+            [=](playhead::redraw_viewport_atom) {},
+
+            [=](colour_pipeline::get_colour_pipe_data_atom,
+                const media_reader::ImageBufDisplaySetPtr &images)
+                -> media_reader::ImageBufDisplaySetPtr { return images; },
+
+            [=](ui::viewport::viewport_layout_atom,
+                const std::string & /*layout_name*/,
+                const media_reader::ImageBufDisplaySetPtr &images)
+                -> media_reader::ImageSetLayoutDataPtr {
+                auto layout = std::make_shared<media_reader::ImageSetLayoutData>();
+                layout->image_transforms_.resize(images->num_onscreen_images());
+                for (int i = 0; i < images->num_onscreen_images(); ++i)
+                    layout->image_draw_order_hint_.push_back(i);
+                layout->layout_aspect_           = 16.0f / 9.0f;
+                layout->draw_hero_overlays_only_ = true;
+                layout->compute_hash();
+                return layout;
+            },
+
+            [=](caf::message) {});
+    }
+
+    const char *name() const override { return NAME.c_str(); }
+
+  private:
+    inline static const std::string NAME = "NullViewportActor";
+    caf::behavior make_behavior() override { return behavior_; }
+    caf::behavior behavior_;
+};
+
+struct ViewportStats {
+    int64_t refreshes      = {0};
+    int64_t blank          = {0};
+    int64_t delivered      = {0};
+    int64_t repeated       = {0};
+    int64_t skipped        = {0};
+    int64_t late_refresh   = {0};
+    double max_schedule_ms = {0.0};
+};
+
+// The vsync loop of a real viewport, minus the drawing: ask the frame queue
+// which images go on screen at the next refresh, wait for the refresh and
+// tell the frame queue the (virtual) framebuffer was swapped.
+ViewportStats run_null_viewport(
+    caf::actor frame_queue,
+    const timebase::flicks refresh_period,
+    const int duration_frames,
+    const time_point measure_start,
+    const time_point measure_end) {
+
+    ViewportStats stats;
+    caf::scoped_actor self{CafActorSystem::system()};
+
+    const auto period = std::chrono::duration_cast<std::chrono::nanoseconds>(refresh_period);
+    auto next_refresh = utility::clock::now() + period;
+    int last_frame    = -1;
+
+    while (next_refresh < measure_end) {
+
+        const auto t0 = utility::clock::now();
+        media_reader::ImageBufDisplaySetPtr images;
+        try {
+            images = request_receive_wait<media_reader::ImageBufDisplaySetPtr>(
+                *self,
+                frame_queue,
+                std::chrono::milliseconds(1000),
+                ui::viewport::viewport_get_next_frames_for_display_atom_v,
+                next_refresh);
+        } catch (const std::exception &err) {
+            spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
+        }
+        const auto t1 = utility::clock::now();
+
+        std::this_thread::sleep_until(next_refresh);
+        anon_mail(
+            ui::fps_monitor::framebuffer_swapped_atom_v,
+            utility::clock::now(),
+            refresh_period)
+            .send(frame_queue);
+
+        if (next_refresh >= measure_start) {
+
+            stats.refreshes++;
+            stats.max_schedule_ms = std::max(
+                stats.max_schedule_ms,
+                std::chrono::duration<double, std::milli>(t1 - t0).count());
+            if (t1 > next_refresh)
+                stats.late_refresh++;
+
+            if (!images || images->empty() || images->hero_sub_playhead_index() < 0 ||
+                !images->hero_image()) {
+                stats.blank++;
+            } else {
+                const int frame = images->hero_image().playhead_logical_frame();
+                if (frame == last_frame) {
+                    stats.repeated++;
+                } else {
+                    stats.delivered++;
+                    if (last_frame >= 0) {
+                        // frames the playhead moved past that never got on
+                        // screen, allowing for the loop back to the start
+                        int step = frame - last_frame;
+                        if (step < 0 && duration_frames > 0)
+                            step += duration_frames;
+                        if (step > 1)
+                            stats.skipped += step - 1;
+                    }
+                }
+                last_frame = frame;
+            }
+        } else if (images && !images->empty() && images->hero_sub_playhead_index() >= 0 &&
+                   images->hero_image()) {
+            last_frame = images->hero_image().playhead_logical_frame();
+        }
+
+        // if we fell behind don't try to catch up, skip to the next refresh
+        next_refresh += period;
+        while (next_refresh < utility::clock::now())
+            next_refresh += period;
+    }
+
+    return stats;
+}
+
+size_t resident_memory_bytes() {
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    if (statm >> pages >> resident)
+        return resident * size_t(sysconf(_SC_PAGESIZE));
+#endif
+    return 0;
+}
+
+size_t peak_resident_memory_bytes() {
+#ifndef _WIN32
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __apple__
+        return size_t(usage.ru_maxrss);
+#else
+        return size_t(usage.ru_maxrss) * 1024;
+#endif
+    }
+#endif
+    return 0;
+}
+
+std::string generate_ppm_sequence(const std::string &spec) {
+
+    int width = 0, height = 0, count = 0;
+    if (std::sscanf(spec.c_str(), "%dx%d:%d", &width, &height, &count) != 3 || width <= 0 ||
+        height <= 0 || count <= 0)
+        throw std::runtime_error("Invalid --generate spec, expected WxH:N, e.g. 1920x1080:100");
+
+    const auto dir = fs::temp_directory_path() /
+                     fmt::format("xstudio_playback_benchmark_{}x{}_{}", width, height, count);
+    fs::create_directories(dir);
+
+    std::vector<uint8_t> pixels(size_t(width) * size_t(height) * 3);
+    for (int f = 1; f <= count; ++f) {
+        const auto path = dir / fmt::format("frame.{:04d}.ppm", f);
+        if (fs::exists(path))
+            continue;
+        // moving gradient, so frames don't compress or dedupe to nothing
+        for (int y = 0; y < height; ++y) {
+            uint8_t *p = pixels.data() + size_t(y) * size_t(width) * 3;
+            for (int x = 0; x < width; ++x) {
+                *(p++) = uint8_t(x + f * 4);
+                *(p++) = uint8_t(y + f * 2);
+                *(p++) = uint8_t(f);
+            }
+        }
+        std::ofstream o(path, std::ios::binary);
+        o << "P6\n" << width << " " << height << "\n255\n";
+        o.write(reinterpret_cast<const char *>(pixels.data()), long(pixels.size()));
+    }
+
+    return (dir / "frame.####.ppm").string();
+}
+
+std::vector<caf::actor>
+make_media(caf::scoped_actor &self, const std::vector<std::string> &paths) {
+
+    std::vector<caf::actor> media;
+    for (const auto &path : paths) {
+        FrameList frame_list;
+        const auto uri = parse_cli_posix_path(path, frame_list, true);
+        const auto uuid = Uuid::generate();
+
+        caf::actor source =
+            frame_list.empty()
+                ? self->spawn<media::MediaSourceActor>(
+                      path, uri, FrameRate(timebase::k_flicks_24fps), uuid)
+                : self->spawn<media::MediaSourceActor>(
+                      path, uri, frame_list, FrameRate(timebase::k_flicks_24fps), uuid);
+
+        media.push_back(self->spawn<media::MediaActor>(
+            path, Uuid::generate(), UuidActorVector({UuidActor(uuid, source)})));
+    }
+    return media;
+}
+
+// Returns a playhead for the first timeline in the session or, failing that,
+// for all the media in the first playlist.
+caf::actor playhead_from_session(
+    caf::scoped_actor &self, caf::actor global_actor, const std::string &path) {
+
+    auto session = self->spawn<session::SessionActor>(
+        utility::open_session(path), posix_path_to_uri(path));
+    request_receive<bool>(*self, global_actor, session::session_atom_v, session);
+
+    const auto playlists =
+        request_receive<std::vector<UuidActor>>(*self, session, session::get_playlists_atom_v);
+    if (playlists.empty())
+        throw std::runtime_error("Session has no playlists.");
+
+    for (const auto &playlist : playlists) {
+        const auto containers = request_receive<std::vector<UuidActor>>(
+            *self, playlist.actor(), playlist::get_container_atom_v, true);
+        for (const auto &container : containers) {
+            if (request_receive<std::string>(*self, container.actor(), type_atom_v) ==
+                "Timeline")
+                return request_receive<UuidActor>(
+                           *self, container.actor(), playlist::create_playhead_atom_v)
+                    .actor();
+        }
+    }
+
+    const auto playlist = playlists.front().actor();
+    auto playhead =
+        request_receive<UuidActor>(*self, playlist, playlist::create_playhead_atom_v).actor();
+    auto selection =
+        request_receive<UuidActor>(*self, playhead, playhead::source_atom_v).actor();
+
+    UuidVector media_uuids;
+    for (const auto &m :
+         request_receive<std::vector<UuidActor>>(*self, playlist, playlist::get_media_atom_v))
+        media_uuids.push_back(m.uuid());
+    request_receive<bool>(*self, selection, playlist::select_media_atom_v, media_uuids);
+
+    return playhead;
+}
+
+nlohmann::json run_benchmark(BenchmarkArgs &cli, const Config &config) {
+
+    CafActorSystem::instance();
+    caf::scoped_actor self{CafActorSystem::system()};
+
+    JsonStore prefs;
+    if (!global_store::load_preferences(prefs, false))
+        throw std::runtime_error("Failed to load application preferences.");
+    if (config.readers > 0) {
+        prefs.set(config.readers, "/plugin/media_reader/OpenEXR/readers_per_source/value");
+        prefs.set(config.readers, "/plugin/media_reader/FFMPEG/readers_per_source/value");
+    }
+
+    auto global_actor = CafActorSystem::global_actor(false, true, "XStudio", prefs);
+    if (!global_actor)
+        throw std::runtime_error("Failed to create global actor.");
+
+    auto &tracer = FrameTracer::instance();
+    tracer.set_enabled(true);
+
+    // media ..
+    caf::actor playhead;
+    if (cli.session) {
+        playhead = playhead_from_session(self, global_actor, args::get(cli.session));
+    } else {
+        std::vector<std::string> paths = args::get(cli.media_paths);
+        if (cli.generate)
+            paths.push_back(generate_ppm_sequence(args::get(cli.generate)));
+        if (paths.empty())
+            paths = {
+                TEST_RESOURCE "/media/test.{:04d}.exr",
+                TEST_RESOURCE "/media/test.{:04d}.ppm",
+                TEST_RESOURCE "/media/test.mov"};
+
+        playhead = self->spawn<playhead::PlayheadActor>("BenchmarkPlayhead");
+        request_receive<bool>(
+            *self, playhead, playhead::source_atom_v, make_media(self, paths));
+        anon_mail(
+            module::change_attribute_value_atom_v,
+            std::string("Compare"),
+            JsonStore("String"),
+            true)
+            .send(playhead);
+    }
+
+    const auto playhead_uuid = request_receive<Uuid>(*self, playhead, uuid_atom_v);
+    request_receive<bool>(
+        *self, playhead, playhead::playhead_rate_atom_v, FrameRate(1.0 / config.fps));
+    anon_mail(playhead::velocity_multiplier_atom_v, float(config.velocity)).send(playhead);
+    anon_mail(playhead::loop_atom_v, playhead::LM_LOOP).send(playhead);
+
+    // null viewports ..
+    auto null_viewport = self->spawn<NullViewportActor>();
+    std::vector<caf::actor> frame_queues;
+    for (int i = 0; i < config.viewports; ++i) {
+        auto frame_queue = self->spawn<ui::viewport::ViewportFrameQueueActor>(
+            null_viewport,
+            std::map<Uuid, caf::actor>(),
+            fmt::format("benchmark_viewport_{}", i),
+            null_viewport);
+        anon_mail(ui::viewport::viewport_layout_atom_v, null_viewport, std::string("Off"))
+            .send(frame_queue);
+        request_receive<bool>(
+            *self,
+            frame_queue,
+            ui::viewport::viewport_playhead_atom_v,
+            UuidActor(playhead_uuid, playhead),
+            true);
+        frame_queues.push_back(frame_queue);
+    }
+
+    const auto duration_frames =
+        request_receive<int>(*self, playhead, playhead::duration_frames_atom_v);
+
+    auto image_cache =
+        CafActorSystem::system().registry().get<caf::actor>(image_cache_registry);
+
+    // play ..
+    const auto refresh_period = timebase::to_flicks(1.0 / args::get(cli.refresh));
+    const auto play_start     = utility::clock::now();
+    const auto measure_start =
+        play_start + std::chrono::duration_cast<timebase::flicks>(
+                         std::chrono::duration<double>(args::get(cli.warmup)));
+    const auto measure_end =
+        measure_start + std::chrono::duration_cast<timebase::flicks>(
+                            std::chrono::duration<double>(args::get(cli.duration)));
+
+    request_receive<bool>(*self, playhead, playhead::play_atom_v, true);
+
+    std::vector<std::thread> viewport_threads;
+    std::vector<ViewportStats> viewport_stats(frame_queues.size());
+    for (size_t i = 0; i < frame_queues.size(); ++i) {
+        viewport_threads.emplace_back([&, i]() {
+            viewport_stats[i] = run_null_viewport(
+                frame_queues[i], refresh_period, duration_frames, measure_start, measure_end);
+        });
+    }
+
+    // measure from a clean slate once the warm up is over
+    std::this_thread::sleep_until(measure_start);
+    tracer.clear();
+    request_receive<bool>(*self, image_cache, media_cache::stats_atom_v, clear_atom_v);
+
+    for (auto &t : viewport_threads)
+        t.join();
+
+    const auto trace_stats = tracer.statistics();
+    const auto cache_stats =
+        request_receive<JsonStore>(*self, image_cache, media_cache::stats_atom_v);
+    if (cli.trace)
+        tracer.write_chrome_trace(args::get(cli.trace));
+    tracer.set_enabled(false);
+
+    request_receive<bool>(*self, playhead, playhead::play_atom_v, false);
+
+    // report ..
+    const double seconds   = args::get(cli.duration);
+    const double requested = config.fps * config.velocity;
+
+    nlohmann::json result;
+    result["config"] = {
+        {"fps", config.fps},
+        {"velocity", config.velocity},
+        {"viewports", config.viewports},
+        {"readers_per_source", config.readers},
+        {"refresh_hz", args::get(cli.refresh)},
+        {"duration_s", seconds},
+        {"duration_frames", duration_frames}};
+
+    result["requested_fps"] = requested;
+    result["viewports"]     = nlohmann::json::array();
+    double worst_fps        = std::numeric_limits<double>::max();
+    int64_t total_skipped   = 0;
+    for (const auto &s : viewport_stats) {
+        const double delivered_fps = double(s.delivered) / seconds;
+        worst_fps                  = std::min(worst_fps, delivered_fps);
+        total_skipped += s.skipped;
+        result["viewports"].push_back(
+            {{"delivered_fps", delivered_fps},
+             {"delivered_frames", s.delivered},
+             {"dropped_frames", s.skipped},
+             {"repeated_refreshes", s.repeated},
+             {"blank_refreshes", s.blank},
+             {"late_refreshes", s.late_refresh},
+             {"refreshes", s.refreshes},
+             {"max_schedule_ms", s.max_schedule_ms}});
+    }
+    result["delivered_fps"]  = viewport_stats.empty() ? 0.0 : worst_fps;
+    result["dropped_frames"] = total_skipped;
+
+    // Little's law, mean queue depth = arrival rate x mean wait
+    const auto &queue_wait = trace_stats["stages"]["RequestQueueWait"];
+    const double arrivals  = queue_wait["count"].get<double>() / seconds;
+    result["reader_queue"] = {
+        {"requests_per_s", arrivals},
+        {"mean_depth", arrivals * queue_wait["mean_us"].get<double>() / 1e6},
+        {"wait_p50_us", queue_wait["p50_us"]},
+        {"wait_p99_us", queue_wait["p99_us"]}};
+
+    const auto &decode = trace_stats["stages"]["Decode"];
+    result["decode"]   = {
+        {"count", decode["count"]},
+        {"p50_us", decode["p50_us"]},
+        {"p99_us", decode["p99_us"]},
+        {"max_us", decode["max_us"]}};
+
+    result["cache"] = {
+        {"hit_rate", cache_stats["hit_rate"]},
+        {"hits", cache_stats["hits"]},
+        {"misses", cache_stats["misses"]},
+        {"count", cache_stats["count"]},
+        {"bytes", cache_stats["size"]}};
+
+    result["memory"] = {
+        {"resident_bytes", resident_memory_bytes()},
+        {"peak_resident_bytes", peak_resident_memory_bytes()}};
+
+    for (auto &frame_queue : frame_queues)
+        self->send_exit(frame_queue, caf::exit_reason::user_shutdown);
+    self->send_exit(null_viewport, caf::exit_reason::user_shutdown);
+    self->send_exit(global_actor, caf::exit_reason::user_shutdown);
+
+    return result;
+}
+
+void print_summary(const nlohmann::json &r) {
+    const auto &c = r["config"];
+    std::cout << fmt::format(
+        "fps {} x{} viewports {} readers {}: delivered {:.2f}/{:.2f} fps, dropped {}, "
+        "queue depth {:.2f}, cache hit rate {:.1f}%, resident {:.0f} MB (peak {:.0f} MB)\n",
+        c["fps"].get<double>(),
+        c["velocity"].get<double>(),
+        c["viewports"].get<int>(),
+        c["readers_per_source"].get<int>(),
+        r["delivered_fps"].get<double>(),
+        r["requested_fps"].get<double>(),
+        r["dropped_frames"].get<int64_t>(),
+        r["reader_queue"]["mean_depth"].get<double>(),
+        r["cache"]["hit_rate"].get<double>() * 100.0,
+        double(r["memory"]["resident_bytes"].get<size_t>()) / (1024.0 * 1024.0),
+        double(r["memory"]["peak_resident_bytes"].get<size_t>()) / (1024.0 * 1024.0));
+}
+
+template <typename T> std::vector<T> parse_list(const std::string &values) {
+    std::vector<T> result;
+    for (const auto &v : split(values, ','))
+        result.push_back(T(std::stod(v)));
+    return result;
+}
+
+std::string shell_quote(const std::string &s) {
+    std::string result = "'";
+    for (const auto c : s) {
+        if (c == '\'')
+            result += "'\\''";
+        else
+            result += c;
+    }
+    return result + "'";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+
+    BenchmarkArgs cli;
+    cli.parse_args(argc, argv);
+
+    start_logger(cli.debug ? spdlog::level::debug : spdlog::level::warn);
+
+    std::vector<Config> configs;
+    try {
+        for (const auto fps : parse_list<double>(args::get(cli.fps)))
+            for (const auto velocity : parse_list<double>(args::get(cli.velocity)))
+                for (const auto viewports : parse_list<int>(args::get(cli.viewports)))
+                    for (const auto readers : parse_list<int>(args::get(cli.readers)))
+                        configs.push_back(Config{fps, velocity, viewports, readers});
+    } catch (const std::exception &err) {
+        spdlog::critical("Invalid sweep values {}", err.what());
+        return EXIT_FAILURE;
+    }
+
+    if (configs.size() == 1) {
+        int status = EXIT_SUCCESS;
+        try {
+            const auto result = run_benchmark(cli, configs.front());
+            if (cli.json)
+                std::cout << result.dump() << std::endl;
+            else {
+                print_summary(result);
+                std::cout << result.dump(2) << std::endl;
+            }
+        } catch (const std::exception &err) {
+            spdlog::critical("{}", err.what());
+            status = EXIT_FAILURE;
+        }
+        CafActorSystem::exit();
+        stop_logger();
+        return status;
+    }
+
+    // sweep, run each configuration in its own process
+    std::string common;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool swept      = arg == "--fps" || arg == "-f" || arg == "--velocity" ||
+                           arg == "--viewports" || arg == "--readers";
+        if (swept) {
+            ++i;
+            continue;
+        }
+        if (starts_with(arg, "--fps=") || starts_with(arg, "--velocity=") ||
+            starts_with(arg, "--viewports=") || starts_with(arg, "--readers=") ||
+            arg == "--json")
+            continue;
+        common += " " + shell_quote(arg);
+    }
+
+    auto results = nlohmann::json::array();
+    int status   = EXIT_SUCCESS;
+    for (const auto &config : configs) {
+        const auto cmd = fmt::format(
+            "{} --json --fps {} --velocity {} --viewports {} --readers {}{}",
+            shell_quote(argv[0]),
+            config.fps,
+            config.velocity,
+            config.viewports,
+            config.readers,
+            common);
+
+        std::string output;
+        if (auto pipe = popen(cmd.c_str(), "r")) {
+            std::array<char, 4096> buffer;
+            while (fgets(buffer.data(), int(buffer.size()), pipe))
+                output += buffer.data();
+            if (pclose(pipe) != 0)
+                status = EXIT_FAILURE;
+        }
+
+        try {
+            // the result is the last line, anything before it is logging
+            const auto lines = split(output, '\n');
+            auto result      = nlohmann::json::parse(lines.empty() ? "" : lines.back());
+            if (!cli.json)
+                print_summary(result);
+            results.push_back(result);
+        } catch (const std::exception &err) {
+            spdlog::error("Benchmark run failed: {} {}", cmd, err.what());
+            status = EXIT_FAILURE;
+        }
+    }
+
+    std::cout << (cli.json ? results.dump() : results.dump(2)) << std::endl;
+    stop_logger();
+    return status;
+}
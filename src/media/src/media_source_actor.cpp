@@ -589,6 +589,39 @@ caf::message_handler MediaSourceActor::message_handler() {
             return false;
         },
 
+        // every frame of the current stream, e.g. for the python api
+        [=](get_media_pointer_atom,
+            const MediaType media_type) -> caf::result<std::vector<media::AVFrameID>> {
+            auto rp = make_response_promise<std::vector<media::AVFrameID>>();
+            mail(acquire_media_detail_atom_v)
+                .request(caf::actor_cast<caf::actor>(this), infinite)
+                .then(
+                    [=](bool) mutable {
+                        if (base_.current(media_type).is_null()) {
+                            rp.deliver(make_error(xstudio_error::error, "No streams"));
+                            return;
+                        }
+                        const auto frames =
+                            base_.media_reference(base_.current(media_type)).frame_count();
+                        LogicalFrameRanges ranges;
+                        if (frames > 0)
+                            ranges.emplace_back(0, frames - 1);
+                        mail(get_media_pointers_atom_v, media_type, ranges)
+                            .request(caf::actor_cast<caf::actor>(this), infinite)
+                            .then(
+                                [=](const media::AVFrameIDs &ids) mutable {
+                                    std::vector<media::AVFrameID> result;
+                                    result.reserve(ids.size());
+                                    for (const auto &i : ids)
+                                        result.push_back(i ? *i : media::AVFrameID());
+                                    rp.deliver(result);
+                                },
+                                [=](const error &err) mutable { rp.deliver(err); });
+                    },
+                    [=](const error &err) mutable { rp.deliver(err); });
+            return rp;
+        },
+
         [=](get_media_pointer_atom atom,
             const MediaType media_type,
             const int logical_frame) -> caf::result<media::AVFrameID> {
@@ -986,8 +1019,7 @@ caf::message_handler MediaSourceActor::message_handler() {
         [=](media::invalidate_cache_atom) -> caf::result<media::MediaKeyVector> {
             auto rp = make_response_promise<media::MediaKeyVector>();
 
-            media::MediaKeyVector keys(all_requested_frames_.size());
-            std::copy(all_requested_frames_.begin(), all_requested_frames_.end(), keys.begin());
+            const media::MediaKeyVector keys(requested_keys_.begin(), requested_keys_.end());
 
             auto image_cache =
                 system().registry().template get<caf::actor>(image_cache_registry);
@@ -1429,14 +1461,13 @@ void MediaSourceActor::init() {
             });
 }
 
-void MediaSourceActor::get_media_pointers_for_frames(
+void MediaSourceActor::with_frame_range_inputs(
     const MediaType media_type,
-    const LogicalFrameRanges &ranges,
-    caf::typed_response_promise<media::AVFrameIDs> rp,
-    const utility::Uuid clip_uuid) {
+    std::function<void(const utility::JsonStore &, const StreamDetail &)> on_ready,
+    std::function<void(const caf::error &)> on_error) {
 
     // func ptr to complete the task
-    auto do_get_pointers = [=]() mutable {
+    auto do_get_inputs = [=]() mutable {
         // fetch colour management data
         mail(json_store::get_json_atom_v, "/colour_pipeline")
             .request(json_store_, infinite)
@@ -1444,7 +1475,7 @@ void MediaSourceActor::get_media_pointers_for_frames(
                 [=](const JsonStore &colour_mgmt_data) mutable {
                     // fetch media detail
                     if (!media_streams_.contains(base_.current(media_type))) {
-                        rp.deliver(make_error(xstudio_error::error, "No streams"));
+                        on_error(make_error(xstudio_error::error, "No streams"));
                         return;
                     }
 
@@ -1452,17 +1483,11 @@ void MediaSourceActor::get_media_pointers_for_frames(
                         .request(media_streams_.at(base_.current(media_type)), infinite)
                         .then(
                             [=](const StreamDetail &detail) mutable {
-                                get_media_pointers_for_frames(
-                                    media_type,
-                                    ranges,
-                                    rp,
-                                    clip_uuid,
-                                    colour_mgmt_data,
-                                    detail);
+                                on_ready(colour_mgmt_data, detail);
                             },
-                            [=](error &err) mutable { rp.deliver(std::move(err)); });
+                            [=](const error &err) mutable { on_error(err); });
                 },
-                [=](error &err) mutable { rp.deliver(std::move(err)); });
+                [=](const error &err) mutable { on_error(err); });
     };
 
     // before we can deliver frame pointers to allow playback, ensure
@@ -1473,10 +1498,10 @@ void MediaSourceActor::get_media_pointers_for_frames(
     mail(acquire_media_detail_atom_v)
         .request(caf::actor_cast<caf::actor>(this), infinite)
         .then(
-            [=](bool) mutable { do_get_pointers(); },
+            [=](bool) mutable { do_get_inputs(); },
             [=](const error &err) mutable {
                 // we proceed on error, in order to make blank frames
-                do_get_pointers();
+                do_get_inputs();
             });
 }
 
@@ -1484,6 +1509,20 @@ void MediaSourceActor::get_media_pointers_for_frames(
     const MediaType media_type,
     const LogicalFrameRanges &ranges,
     caf::typed_response_promise<media::AVFrameIDs> rp,
+    const utility::Uuid clip_uuid) {
+
+    with_frame_range_inputs(
+        media_type,
+        [=](const JsonStore &colour_mgmt_data, const StreamDetail &detail) mutable {
+            rp.deliver(
+                make_frame_ids(media_type, ranges, clip_uuid, colour_mgmt_data, detail));
+        },
+        [=](const caf::error &err) mutable { rp.deliver(err); });
+}
+
+media::AVFrameIDs MediaSourceActor::make_frame_ids(
+    const MediaType media_type,
+    const LogicalFrameRanges &ranges,
     const utility::Uuid clip_uuid,
     const utility::JsonStore &colour_mgmt_data,
     const StreamDetail &media_detail) {
@@ -1502,6 +1541,12 @@ void MediaSourceActor::get_media_pointers_for_frames(
         parent_,
         caf::actor_cast<caf::actor_addr>(this)));
     blank.set_frame_status(media::FS_NOT_ON_DISK);
+    auto blank_ptr = std::make_shared<const media::AVFrameID>(blank);
+
+    size_t num_frames = 0;
+    for (const auto &i : ranges)
+        num_frames += size_t(std::max(0, i.second - i.first + 1));
+    media::AVFrameIDs frame_ids;
 
     if (base_.current(media_type).is_null()) {
 
@@ -1509,21 +1554,37 @@ void MediaSourceActor::get_media_pointers_for_frames(
         // This is useful for sources that have no audio or no video, to keep
         // them compatible with the video based frame request/deliver playback
         // system
-        auto blank_ptr = std::make_shared<const media::AVFrameID>(blank);
-        media::AVFrameIDs result;
-        for (const auto &i : ranges) {
-            for (auto ii = i.first; ii <= i.second; ii++)
-                result.emplace_back(blank_ptr);
-        }
-        rp.deliver(result);
-        return;
+        frame_ids.assign(num_frames, blank_ptr);
+        return frame_ids;
     }
+    frame_ids.reserve(num_frames);
+
+    const auto &stream_uuid = base_.current(media_type);
+    const auto &media_ref   = base_.media_reference(stream_uuid);
+
+    // Playheads rebuild their frames on every edit, mostly asking for the same
+    // frames of the same clip again. While the inputs to the frame ids are
+    // unchanged we hand out the ids we made last time rather than allocating
+    // new ones and formatting their keys.
+    static const size_t max_reusable_clips = 64;
+
+    auto &reusable = reusable_frame_ids_[std::make_pair(media_type, clip_uuid)];
+    if (reusable.stream_uuid_ != stream_uuid or reusable.media_ref_ != media_ref or
+        reusable.colour_mgmt_data_ != colour_mgmt_data or
+        not(reusable.media_detail_ == media_detail) or reusable.reader_ != base_.reader()) {
+        reusable.stream_uuid_      = stream_uuid;
+        reusable.media_ref_        = media_ref;
+        reusable.colour_mgmt_data_ = colour_mgmt_data;
+        reusable.media_detail_     = media_detail;
+        reusable.reader_           = base_.reader();
+        reusable.base_.reset();
+        reusable.frames_.clear();
+    } else if (reusable.frames_.size() > 4 * num_frames + 1024) {
+        reusable.frames_.clear();
+    }
+    reusable.last_used_ = ++frame_id_requests_;
 
-    auto blank_ptr = std::make_shared<const media::AVFrameID>(blank);
-
-    media::AVFrameIDs result;
-    media::AVFrameID base_frame_id;
-    auto timecode = base_.media_reference(base_.current(media_type)).timecode();
+    auto timecode = media_ref.timecode();
 
     int prev_range_last = 0;
     for (const auto &i : ranges) {
@@ -1551,17 +1612,30 @@ void MediaSourceActor::get_media_pointers_for_frames(
                 // cached
                 auto _uri = uri_for_logical_frame(
                     media_type, logical_frame, frame, keyframe, frame_status, mod_time);
+                const size_t mod_timestamp = mod_time.time_since_epoch().count();
+
+                auto &previous =
+                    reusable.frames_[std::make_pair(logical_frame, timecode.total_frames())];
+                if (previous.frame_id_ and previous.key_frame_ == keyframe and
+                    previous.mod_timestamp_ == mod_timestamp and
+                    previous.frame_id_->frame() == frame and
+                    previous.frame_id_->frame_status() == frame_status and
+                    previous.frame_id_->uri() == _uri) {
+                    frame_ids.emplace_back(previous.frame_id_);
+                    timecode = timecode + 1;
+                    continue;
+                }
 
-                if (base_frame_id.is_nil()) {
+                if (!reusable.base_) {
                     // TODO: less hideous creation of AVFrameID
-                    base_frame_id = media::AVFrameID(
+                    reusable.base_ = std::make_shared<const media::AVFrameID>(
                         _uri,
                         frame,
-                        *(base_.media_reference(base_.current(media_type)).frame(0)),
+                        *(media_ref.frame(0)),
                         frame_status,
-                        mod_time.time_since_epoch().count(),
+                        mod_timestamp,
                         media_detail.pixel_aspect_,
-                        base_.media_reference(base_.current(media_type)).rate(),
+                        media_ref.rate(),
                         media_detail.name_,
                         media_detail.key_format_,
                         base_.reader(),
@@ -1572,30 +1646,44 @@ void MediaSourceActor::get_media_pointers_for_frames(
                         parent_uuid_,
                         clip_uuid,
                         media_type,
-                        timecode);
+                        timecode,
+                        media_ref.container());
                 }
 
-                result.emplace_back(new media::AVFrameID(
-                    base_frame_id,
+                auto frame_id = std::make_shared<const media::AVFrameID>(
+                    *reusable.base_,
                     _uri,
                     frame,
                     keyframe,
                     media_detail.key_format_,
                     frame_status,
-                    mod_time.time_since_epoch().count(),
-                    timecode));
+                    mod_timestamp,
+                    timecode);
 
-                all_requested_frames_.insert(result.back()->key());
+                // keep the key, so we can invalidate cached frames later
+                requested_keys_.insert(frame_id->key());
+                previous = ReusableFrameId{keyframe, mod_timestamp, frame_id};
+                frame_ids.emplace_back(std::move(frame_id));
 
                 timecode = timecode + 1;
 
             } catch ([[maybe_unused]] const std::exception &e) {
                 // spdlog::warn("{}", e.what());
-                result.emplace_back(blank_ptr);
+                frame_ids.emplace_back(blank_ptr);
             }
         }
     }
-    rp.deliver(result);
+
+    if (reusable_frame_ids_.size() > max_reusable_clips) {
+        auto oldest = reusable_frame_ids_.begin();
+        for (auto p = reusable_frame_ids_.begin(); p != reusable_frame_ids_.end(); ++p) {
+            if (p->second.last_used_ < oldest->second.last_used_)
+                oldest = p;
+        }
+        reusable_frame_ids_.erase(oldest);
+    }
+
+    return frame_ids;
 }
 
 MediaSourceActor::UriStatus::UriStatus(
@@ -1620,21 +1708,35 @@ caf::uri MediaSourceActor::uri_for_logical_frame(
 
     const auto &media_ref = base_.media_reference(base_.current(media_type));
 
-    auto _uri = media_ref.uri(logical_frame, frame);
-    if (not _uri)
-        throw std::runtime_error("Time out of range");
-    keyframe     = frame;
-    frame_status = FS_ON_DISK;
-
-    if (!media_ref.container() && base_.partial_seq_behaviour() == PS_DONT_HOLD_FRAME) {
+    const bool check_on_disk =
+        !media_ref.container() && (base_.partial_seq_behaviour() == PS_DONT_HOLD_FRAME ||
+                                   base_.partial_seq_behaviour() == PS_HOLD_FRAME);
 
+    if (check_on_disk) {
+        // frames that we've resolved before are in the status cache. Check
+        // here before formatting the uri for the frame as this is the common
+        // case when playheads rebuild their frame lists.
         auto p = uri_status_cache_.find(logical_frame);
         if (p != uri_status_cache_.end()) {
+            const auto mapped_frame = media_ref.frame(logical_frame);
+            if (not mapped_frame)
+                throw std::runtime_error("Time out of range");
+            frame        = *mapped_frame;
             frame_status = p->second.status_;
             keyframe     = p->second.frame_;
             mod_time     = p->second.mod_timestamp_;
             return p->second.uri_;
         }
+    }
+
+    auto _uri = media_ref.uri(logical_frame, frame);
+    if (not _uri)
+        throw std::runtime_error("Time out of range");
+    keyframe     = frame;
+    frame_status = FS_ON_DISK;
+
+    if (!media_ref.container() && base_.partial_seq_behaviour() == PS_DONT_HOLD_FRAME) {
+
         // is this uri on disk?
         const auto path = fs::path(utility::uri_to_posix_path(*_uri));
         if (fs::exists(path)) {
@@ -1660,13 +1762,6 @@ caf::uri MediaSourceActor::uri_for_logical_frame(
         // the uri against the logical frame and whether it is on-disk or
         // a held frame.
 
-        auto p = uri_status_cache_.find(logical_frame);
-        if (p != uri_status_cache_.end()) {
-            frame_status = p->second.status_;
-            keyframe     = p->second.frame_;
-            mod_time     = p->second.mod_timestamp_;
-            return p->second.uri_;
-        }
         // is this uri on disk?
         const auto path = fs::path(utility::uri_to_posix_path(*_uri));
         if (fs::exists(path)) {
@@ -7,6 +7,7 @@
 #include "xstudio/json_store/json_store_helper.hpp"
 #include "xstudio/media/media.hpp"
 #include "xstudio/media/media_actor.hpp"
+#include "xstudio/media_reader/image_buffer.hpp"
 #include "xstudio/ui/viewport/viewport.hpp"
 #include "xstudio/utility/helpers.hpp"
 #include "xstudio/utility/logging.hpp"
@@ -16,6 +17,7 @@ using namespace xstudio::utility;
 using namespace xstudio::json_store;
 using namespace xstudio::media;
 using namespace xstudio::media_metadata;
+using namespace xstudio::media_reader;
 using namespace xstudio::global;
 
 using namespace caf;
@@ -106,6 +108,119 @@ TEST(MediaActorTest, Test) {
 }
 
 
+TEST(MediaSourceActorFrameIdsTest, Rebuild) {
+    fixture f;
+    auto gsa = f.self->spawn<GlobalActor>();
+
+    auto media = f.self->spawn<MediaSourceActor>(
+        "test", posix_path_to_uri(TEST_RESOURCE "/media/test.{:04d}.exr"), FrameList(1, 10));
+    const auto clip_uuid = Uuid::generate();
+
+    // a playhead rebuilding its full timeline frames asks for the same
+    // frames of the same clip again, which should hand out the same ids
+    const LogicalFrameRanges ranges({{0, 9}, {0, 9}, {2, 5}});
+    auto build = [&](AVFrameIDs &ids) {
+        const auto start = std::chrono::steady_clock::now();
+        f.self->request(media, infinite, get_media_pointers_atom_v, MT_IMAGE, ranges, clip_uuid)
+            .receive(
+                [&](const AVFrameIDs &result) { ids = result; },
+                [&](const caf::error &err) { EXPECT_TRUE(false) << to_string(err); });
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+    };
+
+    AVFrameIDs cold, rebuilt;
+    const auto cold_time    = build(cold);
+    const auto rebuild_time = build(rebuilt);
+    std::cout << "frame ids built in " << cold_time.count() << "us, rebuilt in "
+              << rebuild_time.count() << "us" << std::endl;
+
+    ASSERT_EQ(cold.size(), size_t(24));
+    ASSERT_EQ(rebuilt.size(), cold.size());
+    for (size_t i = 0; i < cold.size(); ++i)
+        EXPECT_EQ(rebuilt[i].get(), cold[i].get());
+    EXPECT_EQ(cold[0]->key(), cold[10]->key());
+
+    // a different clip gets its own ids
+    f.self->request(
+             media, infinite, get_media_pointers_atom_v, MT_IMAGE, ranges, Uuid::generate())
+        .receive(
+            [&](const AVFrameIDs &result) {
+                ASSERT_EQ(result.size(), cold.size());
+                EXPECT_NE(result[0].get(), cold[0].get());
+                EXPECT_EQ(result[0]->key(), cold[0]->key());
+            },
+            [&](const caf::error &err) { EXPECT_TRUE(false) << to_string(err); });
+
+    f.self->send_exit(gsa, caf::exit_reason::user_shutdown);
+}
+
+TEST(MediaSourceActorFrameIdsTest, InvalidateAfterManyRanges) {
+    fixture f;
+    auto gsa = f.self->spawn<GlobalActor>();
+
+    auto media = f.self->spawn<MediaSourceActor>(
+        "test", posix_path_to_uri(TEST_RESOURCE "/media/test.{:04d}.exr"), FrameList(1, 10));
+
+    std::shared_ptr<const AVFrameID> first_frame;
+    f.self
+        ->request(
+            media,
+            infinite,
+            get_media_pointers_atom_v,
+            MT_IMAGE,
+            LogicalFrameRanges({{0, 0}}),
+            Uuid::generate())
+        .receive(
+            [&](const AVFrameIDs &result) { first_frame = result.at(0); },
+            [&](const caf::error &err) { EXPECT_TRUE(false) << to_string(err); });
+    ASSERT_TRUE(first_frame);
+
+    // many more distinct requests that don't include the first frame
+    for (int i = 0; i < 300; ++i) {
+        f.self
+            ->request(
+                media,
+                infinite,
+                get_media_pointers_atom_v,
+                MT_IMAGE,
+                LogicalFrameRanges({{1 + i % 9, 9}}),
+                Uuid::generate())
+            .receive(
+                [&](const AVFrameIDs &) {},
+                [&](const caf::error &err) { EXPECT_TRUE(false) << to_string(err); });
+    }
+
+    caf::actor image_cache;
+    for (int i = 0; i < 100 and not image_cache; ++i) {
+        image_cache = f.system.registry().template get<caf::actor>(image_cache_registry);
+        if (not image_cache)
+            std::this_thread::sleep_for(50ms);
+    }
+    ASSERT_TRUE(image_cache);
+
+    f.self
+        ->request(
+            image_cache,
+            infinite,
+            media_cache::store_atom_v,
+            first_frame->key(),
+            ImageBufPtr(new ImageBuffer()))
+        .receive(
+            [&](const bool stored) { EXPECT_TRUE(stored); },
+            [&](const caf::error &err) { EXPECT_TRUE(false) << to_string(err); });
+
+    f.self->request(media, infinite, invalidate_cache_atom_v)
+        .receive(
+            [&](const MediaKeyVector &erased) {
+                EXPECT_NE(
+                    std::find(erased.begin(), erased.end(), first_frame->key()), erased.end());
+            },
+            [&](const caf::error &err) { EXPECT_TRUE(false) << to_string(err); });
+
+    f.self->send_exit(gsa, caf::exit_reason::user_shutdown);
+}
+
 TEST(MediaSourceActorTest, Test) {
     fixture f;
 
@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "xstudio/media_cache/cache_trace.hpp"
+#include "xstudio/utility/frame_rate.hpp"
+#include "xstudio/utility/logging.hpp"
+
+using namespace xstudio;
+using namespace xstudio::media_cache;
+
+namespace {
+
+// events are written out in batches of this many
+const size_t flush_size = 4096;
+
+const std::vector<std::string> op_names = {
+    "store",
+    "store_out_of_date",
+    "retrieve",
+    "preserve",
+    "unpreserve",
+    "erase",
+    "hint",
+    "position"};
+
+} // namespace
+
+CacheTrace::~CacheTrace() { flush(); }
+
+CacheTrace CacheTrace::load(const std::string &path) {
+    std::ifstream in(path);
+    if (not in)
+        throw std::runtime_error(fmt::format("Failed to open cache trace {}", path));
+
+    CacheTrace result;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (not line.empty())
+            result.add(from_json(nlohmann::json::parse(line)));
+    }
+    return result;
+}
+
+int64_t CacheTrace::since_start(const utility::time_point &tp) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(tp - start_).count();
+}
+
+void CacheTrace::record(
+    const Op op,
+    const media::MediaKey &key,
+    const utility::Uuid &uuid,
+    const utility::time_point &when,
+    const size_t size,
+    const utility::time_point &out_of_date) {
+
+    push(make_event(op, key, uuid, when, size, out_of_date));
+}
+
+void CacheTrace::record_hint(
+    const utility::Uuid &playhead_uuid,
+    const media::MediaKeyVector &frames,
+    const size_t position,
+    const timebase::flicks frame_period,
+    const float velocity,
+    const utility::time_point &when) {
+
+    auto event = make_event(
+        frames.empty() ? Op::Position : Op::Hint, media::MediaKey(), playhead_uuid, when);
+    event.frames         = frames;
+    event.position       = position;
+    event.frame_period_s = timebase::to_seconds(frame_period);
+    event.velocity       = velocity;
+    push(std::move(event));
+}
+
+CacheTrace::Event CacheTrace::make_event(
+    const Op op,
+    const media::MediaKey &key,
+    const utility::Uuid &uuid,
+    const utility::time_point &when,
+    const size_t size,
+    const utility::time_point &out_of_date) {
+
+    const auto now = utility::clock::now();
+    if (not started_) {
+        start_   = now;
+        started_ = true;
+    }
+
+    Event event;
+    event.op      = op;
+    event.t_us    = since_start(now);
+    event.key     = key;
+    event.uuid    = uuid;
+    event.when_us = since_start(when);
+    event.size    = size;
+    if (op == Op::StoreOutOfDate)
+        event.out_of_date_us = since_start(out_of_date);
+    return event;
+}
+
+void CacheTrace::push(Event event) {
+    // only complete events are buffered, a flush empties the buffer
+    events_.emplace_back(std::move(event));
+    if (not path_.empty() and events_.size() >= flush_size)
+        flush();
+}
+
+bool CacheTrace::flush() {
+    if (path_.empty() or events_.empty())
+        return true;
+
+    std::ofstream out(path_, flushed_ ? std::ios::app : std::ios::trunc);
+    for (const auto &event : events_) {
+        if (not out)
+            break;
+        out << to_json(event).dump() << "\n";
+    }
+    events_.clear();
+
+    // the trace is only a debugging aid, so a failed write drops the events
+    // rather than stopping the cache
+    if (not out) {
+        spdlog::warn("{} Failed to write cache trace {}", __PRETTY_FUNCTION__, path_);
+        return false;
+    }
+
+    flushed_ = true;
+    return true;
+}
+
+nlohmann::json CacheTrace::to_json(const Event &event) {
+    auto result  = nlohmann::json::object();
+    result["op"] = op_names[static_cast<size_t>(event.op)];
+    result["t"]  = event.t_us;
+
+    if (not event.key.is_null())
+        result["key"] = to_string(event.key);
+    if (not event.uuid.is_null())
+        result["uuid"] = to_string(event.uuid);
+
+    switch (event.op) {
+    case Op::StoreOutOfDate:
+        result["out_of_date"] = event.out_of_date_us;
+        [[fallthrough]];
+    case Op::Store:
+    case Op::Retrieve:
+    case Op::Preserve:
+        result["when"] = event.when_us;
+        result["size"] = event.size;
+        break;
+    case Op::Hint:
+        result["frames"] = nlohmann::json::array();
+        for (const auto &key : event.frames)
+            result["frames"].push_back(to_string(key));
+        [[fallthrough]];
+    case Op::Position:
+        result["when"]         = event.when_us;
+        result["position"]     = event.position;
+        result["frame_period"] = event.frame_period_s;
+        result["velocity"]     = event.velocity;
+        break;
+    default:
+        break;
+    }
+
+    return result;
+}
+
+CacheTrace::Event CacheTrace::from_json(const nlohmann::json &jsn) {
+    Event result;
+
+    const auto name = jsn.at("op").get<std::string>();
+    const auto op   = std::find(op_names.begin(), op_names.end(), name);
+    if (op == op_names.end())
+        throw std::runtime_error(fmt::format("Unknown cache trace op {}", name));
+
+    result.op             = static_cast<Op>(std::distance(op_names.begin(), op));
+    result.t_us           = jsn.at("t").get<int64_t>();
+    result.when_us        = jsn.value("when", result.t_us);
+    result.out_of_date_us = jsn.value("out_of_date", int64_t(0));
+    result.size           = jsn.value("size", size_t(0));
+    result.position       = jsn.value("position", size_t(0));
+    result.frame_period_s = jsn.value("frame_period", 0.0);
+    result.velocity       = jsn.value("velocity", 0.0f);
+
+    if (jsn.contains("key"))
+        result.key = media::MediaKey(jsn.at("key").get<std::string>());
+    if (jsn.contains("uuid"))
+        result.uuid = utility::Uuid(jsn.at("uuid").get<std::string>());
+    if (jsn.contains("frames")) {
+        for (const auto &key : jsn.at("frames"))
+            result.frames.emplace_back(key.get<std::string>());
+    }
+
+    return result;
+}
@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "xstudio/media_cache/eviction_policy.hpp"
+#include "xstudio/utility/frame_rate.hpp"
+
+using namespace xstudio;
+using namespace xstudio::media_cache;
+
+namespace {
+
+double to_seconds(const utility::time_point::duration &d) {
+    return std::chrono::duration_cast<std::chrono::duration<double>>(d).count();
+}
+
+} // namespace
+
+nlohmann::json EvictionPolicy::json() const { return nlohmann::json{{"name", name()}}; }
+
+void PlayheadReusePolicy::set_playhead_hint(
+    const utility::Uuid &playhead_uuid,
+    const media::MediaKeyVector &frames,
+    const size_t position,
+    const timebase::flicks frame_period,
+    const float velocity,
+    const utility::time_point &when) {
+
+    clear_playhead_hint(playhead_uuid);
+    if (frames.empty())
+        return;
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+        if (not frames[i].is_null())
+            frames_[frames[i]].emplace_back(playhead_uuid, i);
+    }
+
+    auto &hint       = hints_[playhead_uuid];
+    hint.frame_count = frames.size();
+    set_motion(hint, position, frame_period, velocity, when);
+}
+
+void PlayheadReusePolicy::update_playhead_position(
+    const utility::Uuid &playhead_uuid,
+    const size_t position,
+    const timebase::flicks frame_period,
+    const float velocity,
+    const utility::time_point &when) {
+
+    auto hint = hints_.find(playhead_uuid);
+    if (hint != hints_.end())
+        set_motion(hint->second, position, frame_period, velocity, when);
+}
+
+void PlayheadReusePolicy::set_motion(
+    Hint &hint,
+    const size_t position,
+    const timebase::flicks frame_period,
+    const float velocity,
+    const utility::time_point &when) {
+
+    const double period = timebase::to_seconds(frame_period);
+
+    hint.position = double(std::min(position, hint.frame_count - 1));
+    hint.rate     = period > 0.0 ? double(velocity) / period : 0.0;
+    hint.when     = when;
+}
+
+void PlayheadReusePolicy::clear_playhead_hint(const utility::Uuid &playhead_uuid) {
+    if (not hints_.erase(playhead_uuid))
+        return;
+
+    for (auto f = frames_.begin(); f != frames_.end();) {
+        auto &uses = f->second;
+        uses.erase(
+            std::remove_if(
+                uses.begin(),
+                uses.end(),
+                [&](const auto &use) { return use.first == playhead_uuid; }),
+            uses.end());
+        if (uses.empty())
+            f = frames_.erase(f);
+        else
+            ++f;
+    }
+}
+
+utility::time_point PlayheadReusePolicy::next_use(
+    const media::MediaKey &key, const utility::time_point &now) const {
+
+    auto result = utility::time_point::max();
+
+    auto f = frames_.find(key);
+    if (f == frames_.end())
+        return result;
+
+    for (const auto &use : f->second) {
+        auto h = hints_.find(use.first);
+        if (h == hints_.end() or h->second.rate == 0.0)
+            continue;
+
+        const auto &hint = h->second;
+        const double n   = double(hint.frame_count);
+
+        // where the playhead has got to since it told us its position, and
+        // how many frames it has to step through to come round to this one
+        const double position = hint.position + to_seconds(now - hint.when) * hint.rate;
+        const double offset   = double(use.second) - position;
+
+        double ahead = std::fmod(hint.rate > 0.0 ? offset : -offset, n);
+        if (ahead < 0.0)
+            ahead += n;
+
+        result = std::min(
+            result,
+            now + std::chrono::duration_cast<utility::time_point::duration>(
+                      std::chrono::duration<double>(ahead / std::fabs(hint.rate))));
+    }
+
+    return result;
+}
+
+nlohmann::json PlayheadReusePolicy::json() const {
+    auto result         = EvictionPolicy::json();
+    result["playheads"] = hints_.size();
+    result["frames"]    = frames_.size();
+    return result;
+}
+
+std::unique_ptr<EvictionPolicy>
+xstudio::media_cache::make_eviction_policy(const std::string &name) {
+    if (name == "needed_by")
+        return std::make_unique<NeededByPolicy>();
+    if (name == "playhead_reuse")
+        return std::make_unique<PlayheadReusePolicy>();
+    throw std::runtime_error(fmt::format("Unknown cache eviction policy \"{}\"", name));
+}
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 #include <caf/actor_registry.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <functional>
 #ifndef __apple__
@@ -12,6 +13,9 @@
 #include "xstudio/colour_pipeline/colour_pipeline.hpp"
 #include "xstudio/global_store/global_store.hpp"
 #include "xstudio/media_cache/media_cache_actor.hpp"
+#include "xstudio/media_cache/warm_start.hpp"
+#include "xstudio/media_reader/image_proxy.hpp"
+#include "xstudio/utility/frame_trace.hpp"
 #include "xstudio/utility/helpers.hpp"
 #include "xstudio/utility/json_store.hpp"
 #include "xstudio/utility/time_cache.hpp"
@@ -23,6 +27,13 @@ using namespace xstudio::global_store;
 using namespace xstudio::utility;
 using namespace caf;
 
+namespace {
+// proxies are kept under the key of the frame they were made from
+media::MediaKey proxy_key(const media::MediaKey &key, const int level) {
+    return media::MediaKey(fmt::format("{}@proxy{}", to_string(key), level));
+}
+} // namespace
+
 class TrimActor : public caf::event_based_actor {
   public:
     TrimActor(caf::actor_config &cfg);
@@ -65,13 +76,51 @@ TrimActor::TrimActor(caf::actor_config &cfg) : caf::event_based_actor(cfg) {
     );
 }
 
+// reads and checks the frames listed at the last shutdown away from the cache,
+// as it means looking at every file they came from
+class WarmStartActor : public caf::event_based_actor {
+  public:
+    WarmStartActor(caf::actor_config &cfg);
+    ~WarmStartActor() override = default;
+
+    const char *name() const override { return NAME.c_str(); }
+
+  private:
+    inline static const std::string NAME = "WarmStartActor";
+    caf::behavior make_behavior() override { return behavior_; }
+
+  private:
+    caf::behavior behavior_;
+};
+
+WarmStartActor::WarmStartActor(caf::actor_config &cfg) : caf::event_based_actor(cfg) {
+
+    behavior_.assign(
+        [=](warm_start_atom, const std::string &path, const size_t max_size) {
+            auto cache = caf::actor_cast<caf::actor>(current_sender());
+            if (not cache or not fs::exists(path))
+                return;
+
+            try {
+                auto warm_start    = WarmStart::load(path);
+                const auto changed = warm_start.validate(max_size);
+                anon_mail(warm_start_atom_v, warm_start.frame_ids(), changed).send(cache);
+            } catch (const std::exception &err) {
+                spdlog::warn("{} {} {}", __PRETTY_FUNCTION__, path, err.what());
+            }
+        });
+}
+
 GlobalImageCacheActor::GlobalImageCacheActor(caf::actor_config &cfg)
     : caf::event_based_actor(cfg), update_pending_(false) {
     print_on_exit(this, "GlobalImageCacheActor");
 
     system().registry().put(image_cache_registry, this);
-    size_t max_size  = std::numeric_limits<size_t>::max();
-    size_t max_count = std::numeric_limits<size_t>::max();
+    size_t max_size       = std::numeric_limits<size_t>::max();
+    size_t max_count      = std::numeric_limits<size_t>::max();
+    size_t proxy_max_size = size_t(512) * 1024 * 1024;
+
+    set_eviction_policy("needed_by");
 
     try {
         auto prefs = GlobalStoreHelper(system());
@@ -81,11 +130,37 @@ GlobalImageCacheActor::GlobalImageCacheActor(caf::actor_config &cfg)
         max_size    = preference_value<size_t>(j, "/core/image_cache/max_size") * 1024 * 1024;
         reset_idle_ = std::chrono::minutes(
             preference_value<size_t>(j, "/core/image_cache/release_on_idle"));
+        set_access_trace(preference_value<std::string>(j, "/core/image_cache/access_trace"));
+        set_eviction_policy(
+            preference_value<std::string>(j, "/core/image_cache/eviction_policy"));
+        proxy_max_size =
+            preference_value<size_t>(j, "/core/image_cache/proxy_max_size") * 1024 * 1024;
+        warm_start_      = preference_value<bool>(j, "/core/image_cache/warm_start");
+        warm_start_path_ = expand_envvars(
+            preference_value<std::string>(j, "/core/image_cache/warm_start_path"));
     } catch (...) {
     }
 
     cache_.set_max_size(max_size);
     cache_.set_max_count(max_count);
+    proxy_cache_.set_max_size(proxy_max_size);
+    cache_.set_owner_function(
+        [this](const media::MediaKey &, const media_reader::ImageBufPtr &buf) {
+            UuidVector result;
+            if (not buf)
+                return result;
+            const auto &frame_id = buf.frame_id();
+            for (const auto &uuid : {frame_id.media_uuid(), frame_id.source_uuid()}) {
+                if (uuid.is_null())
+                    continue;
+                result.push_back(uuid);
+                auto containers = member_of_.find(uuid);
+                if (containers != member_of_.end())
+                    result.insert(
+                        result.end(), containers->second.begin(), containers->second.end());
+            }
+            return result;
+        });
     cache_.bind_change_callback([this](auto &&PH1, auto &&PH2) {
         update_changes(std::forward<decltype(PH1)>(PH1), std::forward<decltype(PH2)>(PH2));
     });
@@ -98,6 +173,15 @@ GlobalImageCacheActor::GlobalImageCacheActor(caf::actor_config &cfg)
 
     anon_mail(clear_atom_v, true).delay(std::chrono::minutes(1)).send(this, weak_ref);
 
+    // give the session a head start, its playheads' reads come first anyway
+    if (warm_start_ and not warm_start_path_.empty()) {
+        auto warm_start = spawn<WarmStartActor>();
+        link_to(warm_start);
+        mail(warm_start_atom_v, warm_start_path_, max_size)
+            .delay(std::chrono::seconds(5))
+            .send(warm_start);
+    }
+
     // For cache benchmarking
     // cache_.noisy = true;
 
@@ -108,28 +192,47 @@ GlobalImageCacheActor::GlobalImageCacheActor(caf::actor_config &cfg)
                 utility::clock::now() - last_activity_ > reset_idle_) {
                 anon_mail(clear_atom_v).send(this);
             }
+            if (access_trace_)
+                access_trace_->flush();
             anon_mail(clear_atom_v, true).delay(std::chrono::minutes(1)).send(this, weak_ref);
         },
         [=](clear_atom) -> bool {
             cache_.clear();
+            proxy_cache_.clear();
             anon_mail(unpreserve_atom_v, static_cast<size_t>(0)).send(trim);
             return true;
         },
 
         [=](count_atom) -> size_t { return cache_.count(); },
 
-        [=](erase_atom, const media::MediaKey &key) { cache_.erase(key); },
+        [=](erase_atom, const media::MediaKey &key) {
+            cache_.erase(key);
+            erase_proxies(key);
+        },
 
         [=](erase_atom, const media::MediaKey &key, const utility::Uuid &uuid) {
             cache_.erase(key, uuid);
+            for (int level = 1; level <= media_reader::max_proxy_level; ++level)
+                proxy_cache_.erase(proxy_key(key, level), uuid);
         },
 
         [=](erase_atom, const media::MediaKeyVector &keys) -> media::MediaKeyVector {
+            for (const auto &key : keys)
+                erase_proxies(key);
             return cache_.erase(keys);
         },
 
         [=](erase_atom, const utility::Uuid &uuid) -> bool {
+            trace(CacheTrace::Op::Erase, media::MediaKey(), uuid, utility::clock::now());
             cache_.erase(uuid);
+            proxy_cache_.erase(uuid);
+            proxy_demand_.erase(uuid);
+
+            // the uuid is gone, so are its quota and priority
+            cache_.set_quota(uuid, 0);
+            cache_.set_priority(uuid, 0);
+            if (containers_.count(uuid))
+                set_container(uuid, UuidVector(), "");
             return true;
         },
 
@@ -151,6 +254,22 @@ GlobalImageCacheActor::GlobalImageCacheActor(caf::actor_config &cfg)
                     cache_.set_max_size(new_size);
                 if (cache_.max_count() != new_count)
                     cache_.set_max_count(new_count);
+                auto new_proxy_size =
+                    preference_value<size_t>(js, "/core/image_cache/proxy_max_size") * 1024 *
+                    1024;
+                if (proxy_cache_.max_size() != new_proxy_size)
+                    proxy_cache_.set_max_size(new_proxy_size);
+
+                warm_start_      = preference_value<bool>(js, "/core/image_cache/warm_start");
+                warm_start_path_ = expand_envvars(
+                    preference_value<std::string>(js, "/core/image_cache/warm_start_path"));
+
+                set_access_trace(
+                    preference_value<std::string>(js, "/core/image_cache/access_trace"));
+                auto policy =
+                    preference_value<std::string>(js, "/core/image_cache/eviction_policy");
+                if (policy != eviction_policy_->name())
+                    set_eviction_policy(policy);
             } catch (const std::exception &err) {
                 spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
             }
@@ -178,18 +297,62 @@ GlobalImageCacheActor::GlobalImageCacheActor(caf::actor_config &cfg)
         },
 
         [=](unpreserve_atom, const utility::Uuid &uuid) -> bool {
+            trace(CacheTrace::Op::Unpreserve, media::MediaKey(), uuid, utility::clock::now());
             cache_.unpreserve(uuid);
+            proxy_cache_.unpreserve(uuid);
+            eviction_policy_->clear_playhead_hint(uuid);
             return true;
         },
 
-        [=](preserve_atom, const media::MediaKey &key) -> bool { return cache_.preserve(key); },
+        // the loop range a playing playhead is cycling over, see EvictionPolicy
+        [=](playhead_hint_atom,
+            const utility::Uuid &playhead_uuid,
+            const media::MediaKeyVector &frames,
+            const size_t position,
+            const timebase::flicks frame_period,
+            const float velocity,
+            const time_point &when) {
+            if (access_trace_)
+                access_trace_->record_hint(
+                    playhead_uuid, frames, position, frame_period, velocity, when);
+            eviction_policy_->set_playhead_hint(
+                playhead_uuid, frames, position, frame_period, velocity, when);
+        },
+
+        [=](playhead_hint_atom,
+            const utility::Uuid &playhead_uuid,
+            const size_t position,
+            const timebase::flicks frame_period,
+            const float velocity,
+            const time_point &when) {
+            if (access_trace_)
+                access_trace_->record_hint(
+                    playhead_uuid, {}, position, frame_period, velocity, when);
+            eviction_policy_->update_playhead_position(
+                playhead_uuid, position, frame_period, velocity, when);
+        },
+
+        [=](playhead_hint_atom, const utility::Uuid &playhead_uuid) {
+            // a hint without frames
+            trace(CacheTrace::Op::Hint, media::MediaKey(), playhead_uuid, clock::now());
+            eviction_policy_->clear_playhead_hint(playhead_uuid);
+        },
+
+        [=](preserve_atom, const media::MediaKey &key) -> bool {
+            trace(CacheTrace::Op::Preserve, key, Uuid(), utility::clock::now());
+            return cache_.preserve(key);
+        },
 
         [=](preserve_atom, const media::MediaKey &key, const time_point &time) -> bool {
+            trace(CacheTrace::Op::Preserve, key, Uuid(), time);
             return cache_.preserve(key, time);
         },
 
         [=](preserve_atom, const media::MediaKey &key, const time_point &time, const Uuid &uuid)
-            -> bool { return cache_.preserve(key, time, uuid); },
+            -> bool {
+            trace(CacheTrace::Op::Preserve, key, uuid, time);
+            return cache_.preserve(key, time, uuid);
+        },
 
         // given a list of frame pointers, check which frames are in the cache
         // and return a list of those that *aren't* in the cache
@@ -198,7 +361,15 @@ GlobalImageCacheActor::GlobalImageCacheActor(caf::actor_config &cfg)
             const Uuid &uuid) -> media::AVFrameIDsAndTimePoints {
             media::AVFrameIDsAndTimePoints result;
             result.reserve(mpts.size());
+
+            // a playhead drawn at proxy size has what it needs in the proxy
+            const auto level = proxy_level(uuid);
+
             for (const auto &p : mpts) {
+                trace(CacheTrace::Op::Preserve, p.second->key(), uuid, p.first);
+                if (level and
+                    proxy_cache_.preserve(proxy_key(p.second->key(), level), p.first, uuid))
+                    continue;
                 if (!cache_.preserve(p.second->key(), p.first, uuid)) {
                     result.push_back(p);
                 }
@@ -213,9 +384,80 @@ GlobalImageCacheActor::GlobalImageCacheActor(caf::actor_config &cfg)
             return true;
         },
 
+        // the viewport showing these playheads draws their frames small enough
+        // for the proxy level, 0 for full resolution. Once every viewport
+        // showing a playhead wants the same level, proxies are made as its
+        // frames are stored and it is served those.
+        [=](proxy_atom,
+            const utility::Uuid &viewport,
+            const utility::UuidVector &playheads,
+            const int level) {
+            for (const auto &uuid : playheads)
+                proxy_demand_[uuid][viewport] =
+                    std::clamp(level, 0, media_reader::max_proxy_level);
+        },
+
+        // the viewport no longer shows these playheads
+        [=](proxy_atom,
+            erase_atom,
+            const utility::Uuid &viewport,
+            const utility::UuidVector &playheads) {
+            for (const auto &uuid : playheads) {
+                auto demand = proxy_demand_.find(uuid);
+                if (demand == proxy_demand_.end())
+                    continue;
+                demand->second.erase(viewport);
+                if (demand->second.empty())
+                    proxy_demand_.erase(demand);
+            }
+        },
+
+        // the proxy of a frame, made from the full resolution frame if it
+        // isn't there yet but that is, otherwise null
+        [=](proxy_atom,
+            retrieve_atom,
+            const media::MediaKey &key,
+            const int level,
+            const utility::Uuid &uuid) -> result<media_reader::ImageBufPtr> {
+            const auto pkey = proxy_key(key, level);
+            auto buf        = proxy_cache_.retrieve(pkey, utility::clock::now(), uuid);
+            if (buf) {
+                proxy_hits_++;
+                return buf;
+            }
+            proxy_misses_++;
+
+            // without touching the frame's timepoints, it's not being used
+            if (auto full = cache_.find(key))
+                make_proxy(key, full, level, uuid);
+
+            auto pending = proxy_pending_.find(pkey);
+            if (pending == proxy_pending_.end())
+                return media_reader::ImageBufPtr();
+
+            auto rp = make_response_promise<media_reader::ImageBufPtr>();
+            pending->second.push_back(rp);
+            return rp;
+        },
+
+        // caps what's cached for the uuid (a container, media, media source
+        // or playhead) at max_size_mb, 0 for no cap. Frames of lower
+        // priority uuids are dropped first when the cache is full.
+        [=](quota_atom,
+            const utility::Uuid &uuid,
+            const int max_size_mb,
+            const int priority) -> bool {
+            cache_.set_priority(uuid, priority);
+            cache_.set_quota(uuid, size_t(std::max(max_size_mb, 0)) * 1024 * 1024);
+            return true;
+        },
+
         [=](retrieve_atom, const media::MediaKey &key) -> media_reader::ImageBufPtr {
             last_activity_ = utility::clock::now();
-            return cache_.retrieve(key);
+            TraceSpan span(TraceStage::CacheRetrieve, key);
+            auto buf = count_retrieve(cache_.retrieve(key));
+            trace(CacheTrace::Op::Retrieve, key, Uuid(), last_activity_, buf);
+            return buf;
         },
 
         [=](retrieve_atom, const media::AVFrameIDsAndTimePoints &mptr_and_timepoints)
@@ -226,29 +468,111 @@ GlobalImageCacheActor::GlobalImageCacheActor(caf::actor_config &cfg)
             last_activity_ = utility::clock::now();
 
             for (const auto &p : mptr_and_timepoints) {
-                result.emplace_back(cache_.retrieve(p.second->key(), p.first));
+                result.emplace_back(count_retrieve(cache_.retrieve(p.second->key(), p.first)));
                 result.back().when_to_display_ = p.first;
+                trace(
+                    CacheTrace::Op::Retrieve, p.second->key(), Uuid(), p.first, result.back());
             }
             return result;
         },
 
+        // the frame for a playhead, at full resolution unless every viewport
+        // showing the playhead draws it at proxy size, see proxy_atom
+        [=](retrieve_atom,
+            const media::MediaKey &key,
+            const utility::Uuid &uuid) -> media_reader::ImageBufPtr {
+            last_activity_ = utility::clock::now();
+            TraceSpan span(TraceStage::CacheRetrieve, key, uuid);
+
+            if (const auto level = proxy_level(uuid)) {
+                auto buf = proxy_cache_.retrieve(proxy_key(key, level));
+                if (buf) {
+                    proxy_hits_++;
+                    trace(CacheTrace::Op::Retrieve, key, uuid, last_activity_, buf);
+                    return buf;
+                }
+            }
+
+            auto buf = count_retrieve(cache_.retrieve(key));
+            trace(CacheTrace::Op::Retrieve, key, uuid, last_activity_, buf);
+            return buf;
+        },
+
         [=](retrieve_atom,
             const media::MediaKey &key,
             const time_point &time) -> media_reader::ImageBufPtr {
             last_activity_ = utility::clock::now();
-            return cache_.retrieve(key, time);
+            TraceSpan span(TraceStage::CacheRetrieve, key);
+            auto buf = count_retrieve(cache_.retrieve(key, time));
+            trace(CacheTrace::Op::Retrieve, key, Uuid(), time, buf);
+            return buf;
         },
 
         [=](retrieve_atom, const media::MediaKey &key, const time_point &time, const Uuid &uuid)
             -> media_reader::ImageBufPtr {
             last_activity_ = utility::clock::now();
-            return cache_.retrieve(key, time, uuid);
+            TraceSpan span(TraceStage::CacheRetrieve, key, uuid);
+            auto buf = count_retrieve(cache_.retrieve(key, time, uuid));
+            trace(CacheTrace::Op::Retrieve, key, uuid, time, buf);
+            return buf;
         },
 
         [=](size_atom) -> size_t { return cache_.size(); },
 
+        [=](stats_atom) -> JsonStore {
+            const auto total = retrieve_hits_ + retrieve_misses_;
+            JsonStore result;
+            result["count"]    = cache_.count();
+            result["size"]     = cache_.size();
+            result["hits"]     = retrieve_hits_;
+            result["misses"]   = retrieve_misses_;
+            result["hit_rate"] = total ? double(retrieve_hits_) / double(total) : 0.0;
+
+            result["eviction_policy"] = eviction_policy_->json();
+
+            // the containers holding most of the cache
+            std::vector<std::pair<size_t, utility::Uuid>> largest;
+            for (const auto &i : containers_)
+                largest.emplace_back(cache_.usage(i.first).size, i.first);
+            std::sort(largest.begin(), largest.end(), std::greater<>());
+            largest.resize(std::min(largest.size(), size_t(3)));
+            result["largest"] = nlohmann::json::array();
+            for (const auto &i : largest)
+                result["largest"].push_back(usage(i.second));
+
+            if (warm_start_frames_ or warm_start_changed_) {
+                JsonStore warm_start;
+                warm_start["frames"]   = warm_start_frames_;
+                warm_start["restored"] = warm_start_restored_;
+                warm_start["pending"]  = warm_start_pending_.size();
+                warm_start["changed"]  = warm_start_changed_;
+                result["warm_start"]   = warm_start;
+            }
+
+            JsonStore proxy;
+            proxy["count"]     = proxy_cache_.count();
+            proxy["size"]      = proxy_cache_.size();
+            proxy["max_size"]  = proxy_cache_.max_size();
+            proxy["hits"]      = proxy_hits_;
+            proxy["misses"]    = proxy_misses_;
+            proxy["pending"]   = proxy_pending_.size();
+            proxy["playheads"] = proxy_demand_.size();
+            result["proxy"]    = proxy;
+            return result;
+        },
+
+        [=](stats_atom, clear_atom) -> bool {
+            retrieve_hits_   = 0;
+            retrieve_misses_ = 0;
+            proxy_hits_      = 0;
+            proxy_misses_    = 0;
+            return true;
+        },
+
         [=](store_atom, const media::MediaKey &key, media_reader::ImageBufPtr buf) -> bool {
             last_activity_ = utility::clock::now();
+            TraceSpan span(TraceStage::CacheStore, key);
+            trace(CacheTrace::Op::Store, key, Uuid(), last_activity_, buf);
             return cache_.store(key, buf);
         },
 
@@ -257,7 +581,8 @@ GlobalImageCacheActor::GlobalImageCacheActor(caf::actor_config &cfg)
             const media_reader::ImageBufPtr &buf,
             const time_point &when) -> bool {
             last_activity_ = utility::clock::now();
-
+            TraceSpan span(TraceStage::CacheStore, key);
+            trace(CacheTrace::Op::Store, key, Uuid(), when, buf);
             return cache_.store(key, buf, when);
         },
 
@@ -267,6 +592,9 @@ GlobalImageCacheActor::GlobalImageCacheActor(caf::actor_config &cfg)
             const time_point &when,
             const utility::Uuid &uuid) -> bool {
             last_activity_ = utility::clock::now();
+            TraceSpan span(TraceStage::CacheStore, key, uuid);
+            trace(CacheTrace::Op::Store, key, uuid, when, buf);
+            store_proxy(key, buf, uuid);
             return cache_.store(key, buf, when, false, uuid);
         },
 
@@ -276,6 +604,9 @@ GlobalImageCacheActor::GlobalImageCacheActor(caf::actor_config &cfg)
             const time_point &when,
             const utility::Uuid &uuid) -> bool {
             last_activity_ = utility::clock::now();
+            TraceSpan span(TraceStage::CacheStore, key, uuid);
+            trace(CacheTrace::Op::Store, key, uuid, when, buf);
+            store_proxy(key, buf, uuid);
             return cache_.store(key, buf, when, false, uuid);
         },
         [=](store_atom,
@@ -285,18 +616,316 @@ GlobalImageCacheActor::GlobalImageCacheActor(caf::actor_config &cfg)
             const utility::Uuid &uuid,
             const time_point &cache_out_date_tp) -> bool {
             last_activity_ = utility::clock::now();
+            TraceSpan span(TraceStage::CacheStore, key, uuid);
+            trace(CacheTrace::Op::StoreOutOfDate, key, uuid, when, buf, cache_out_date_tp);
+            store_proxy(key, buf, uuid);
             return cache_.store(key, buf, when, uuid, cache_out_date_tp);
         },
 
-        [=](utility::get_event_group_atom) -> caf::actor { return event_group_; });
+        [=](usage_atom) -> JsonStore { return usage(); },
+
+        [=](usage_atom, const utility::Uuid &uuid) -> JsonStore { return usage(uuid); },
+
+        // frames of the members' media are accounted against the container
+        // too, members replace any sent before
+        [=](usage_atom,
+            const utility::Uuid &container,
+            const utility::UuidVector &members,
+            const std::string &name) { set_container(container, members, name); },
+
+        [=](utility::get_event_group_atom) -> caf::actor { return event_group_; },
+
+        // the frames from the last session that are still good, see
+        // WarmStartActor
+        [=](warm_start_atom,
+            const media::AVFrameIDsAndTimePoints &frames,
+            const size_t changed) {
+            auto reader = system().registry().template get<caf::actor>(media_reader_registry);
+            if (not reader)
+                return;
+
+            // frames the session has read already count as restored
+            media::AVFrameIDsAndTimePoints wanted;
+            for (const auto &i : frames) {
+                if (cache_.contains(i.second->key()))
+                    warm_start_restored_++;
+                else if (warm_start_pending_.insert(i.second->key()).second)
+                    wanted.push_back(i);
+            }
+            warm_start_frames_  = warm_start_restored_ + warm_start_pending_.size();
+            warm_start_changed_ = changed;
+
+            if (not wanted.empty()) {
+                spdlog::info(
+                    "Cacheing {} frames from the last session, {} changed on disk",
+                    wanted.size(),
+                    changed);
+                anon_mail(media_reader::static_precache_atom_v, wanted, warm_start_uuid_)
+                    .send(reader);
+            }
+        });
+}
+
+media_reader::ImageBufPtr
+GlobalImageCacheActor::count_retrieve(const media_reader::ImageBufPtr &buf) {
+    if (buf)
+        retrieve_hits_++;
+    else
+        retrieve_misses_++;
+    return buf;
+}
+
+void GlobalImageCacheActor::store_proxy(
+    const media::MediaKey &key,
+    const media_reader::ImageBufPtr &buf,
+    const utility::Uuid &uuid) {
+    if (const auto level = proxy_level(uuid))
+        make_proxy(key, buf, level, uuid);
+}
+
+void GlobalImageCacheActor::make_proxy(
+    const media::MediaKey &key,
+    const media_reader::ImageBufPtr &buf,
+    const int level,
+    const utility::Uuid &uuid) {
+    const auto pkey = proxy_key(key, level);
+    if (level <= 0 or not buf or buf->error_state() != media_reader::NO_ERROR or
+        not proxy_cache_.max_size() or proxy_pending_.count(pkey) or
+        proxy_cache_.contains(pkey))
+        return;
+
+    // made by the media reader, which has the pixel layouts
+    auto reader = system().registry().template get<caf::actor>(media_reader_registry);
+    if (not reader)
+        return;
+
+    proxy_pending_[pkey];
+    auto deliver = [=](const media_reader::ImageBufPtr &proxy) {
+        if (proxy) {
+            proxy_cache_.store(pkey, proxy, utility::clock::now(), false, uuid);
+
+            // the playhead is served the proxy from now on (see preserve_atom
+            // and retrieve_atom), so it lets go of the full resolution frame,
+            // which goes unless another playhead holds it
+            if (proxy_level(uuid) == level)
+                cache_.erase(key, uuid);
+        }
+        auto pending = proxy_pending_.find(pkey);
+        if (pending == proxy_pending_.end())
+            return;
+        for (auto &rp : pending->second)
+            rp.deliver(proxy);
+        proxy_pending_.erase(pending);
+    };
+
+    mail(proxy_atom_v, buf, level)
+        .request(reader, infinite)
+        .then(
+            [=](const media_reader::ImageBufPtr &proxy) { deliver(proxy); },
+            [=](const caf::error &err) {
+                spdlog::debug("{} {} {}", __PRETTY_FUNCTION__, to_string(key), to_string(err));
+                deliver(media_reader::ImageBufPtr());
+            });
+}
+
+void GlobalImageCacheActor::erase_proxies(const media::MediaKey &key) {
+    for (int level = 1; level <= media_reader::max_proxy_level; ++level)
+        proxy_cache_.erase(proxy_key(key, level));
+}
+
+int GlobalImageCacheActor::proxy_level(const utility::Uuid &playhead) const {
+    const auto demand = proxy_demand_.find(playhead);
+    if (demand == proxy_demand_.end())
+        return 0;
+
+    // one viewport drawing the playhead at full resolution (or at another
+    // level) is enough for it to be served full resolution frames
+    const auto level = demand->second.begin()->second;
+    for (const auto &i : demand->second) {
+        if (i.second != level)
+            return 0;
+    }
+    return level;
+}
+
+void GlobalImageCacheActor::set_eviction_policy(const std::string &name) {
+    try {
+        // the cache holds on to the policy, so swap it over before the old
+        // policy goes
+        auto policy = make_eviction_policy(name);
+        policy->attach(cache_);
+        eviction_policy_ = std::move(policy);
+    } catch (const std::exception &err) {
+        spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
+    }
+}
+
+void GlobalImageCacheActor::set_access_trace(const std::string &path) {
+    if (access_trace_ ? access_trace_->path() == path : path.empty())
+        return;
+
+    access_trace_.reset();
+    if (not path.empty()) {
+        spdlog::info("Recording image cache access trace to {}", path);
+        access_trace_ = std::make_unique<CacheTrace>(path);
+    }
+}
+
+void GlobalImageCacheActor::trace(
+    const CacheTrace::Op op,
+    const media::MediaKey &key,
+    const utility::Uuid &uuid,
+    const utility::time_point &when,
+    const media_reader::ImageBufPtr &buf,
+    const utility::time_point &out_of_date) {
+    if (access_trace_)
+        access_trace_->record(op, key, uuid, when, buf ? buf->size() : 0, out_of_date);
+}
+
+void GlobalImageCacheActor::save_warm_start() {
+    const auto now = utility::clock::now();
+    WarmStart warm_start;
+    cache_.for_each([&](const media::MediaKey &key, const auto &entry) {
+        const auto &buf = entry.value;
+        if (not buf or buf->error_state() != media_reader::NO_ERROR or
+            buf.frame_id().key() != key)
+            return;
+        warm_start.add(
+            buf.frame_id(),
+            buf->size(),
+            entry.timepoints.empty() ? now : *entry.timepoints.rbegin(),
+            now);
+    });
+    warm_start.sort();
+
+    if (warm_start.save(warm_start_path_))
+        spdlog::debug(
+            "Saved {} cached frames for the next session to {}",
+            warm_start.frames().size(),
+            warm_start_path_);
+}
+
+JsonStore GlobalImageCacheActor::usage(const utility::Uuid &uuid) const {
+    const auto used = cache_.usage(uuid);
+    JsonStore result;
+    result["uuid"]     = uuid;
+    result["size"]     = used.size;
+    result["count"]    = used.count;
+    result["quota"]    = cache_.quota(uuid);
+    result["priority"] = cache_.priority(uuid);
+
+    auto container = containers_.find(uuid);
+    if (container != containers_.end()) {
+        result["name"]    = container->second.name;
+        result["members"] = container->second.members.size();
+    }
+    return result;
+}
+
+JsonStore GlobalImageCacheActor::usage() const {
+    // the cache only has uuids, the frames tell us which media they belong
+    // to and the rest are the playheads that asked for them
+    std::map<utility::Uuid, std::set<utility::Uuid>> media;
+    std::set<utility::Uuid> playheads;
+    cache_.for_each([&](const media::MediaKey &, const auto &entry) {
+        const auto &buf = entry.value;
+        if (buf and not buf.frame_id().media_uuid().is_null())
+            media[buf.frame_id().media_uuid()].insert(buf.frame_id().source_uuid());
+        for (const auto &j : entry.uuids) {
+            if (not j.is_null())
+                playheads.insert(j);
+        }
+    });
+
+    auto largest_first = [](nlohmann::json &items) {
+        std::sort(items.begin(), items.end(), [](const auto &a, const auto &b) {
+            return a.at("size").template get<size_t>() > b.at("size").template get<size_t>();
+        });
+        return items;
+    };
+
+    auto containers = nlohmann::json::array();
+    for (const auto &i : containers_)
+        containers.push_back(usage(i.first));
+
+    auto media_usage = nlohmann::json::array();
+    for (const auto &i : media) {
+        auto item    = usage(i.first);
+        auto sources = nlohmann::json::array();
+        for (const auto &j : i.second) {
+            if (not j.is_null())
+                sources.push_back(usage(j));
+        }
+        item["sources"] = largest_first(sources);
+        media_usage.push_back(item);
+    }
+
+    auto playhead_usage = nlohmann::json::array();
+    for (const auto &i : playheads)
+        playhead_usage.push_back(usage(i));
+
+    JsonStore result;
+    result["size"]       = cache_.size();
+    result["count"]      = cache_.count();
+    result["max_size"]   = cache_.max_size();
+    result["containers"] = largest_first(containers);
+    result["media"]      = largest_first(media_usage);
+    result["playheads"]  = largest_first(playhead_usage);
+    return result;
+}
+
+void GlobalImageCacheActor::set_container(
+    const utility::Uuid &container,
+    const utility::UuidVector &members,
+    const std::string &name) {
+
+    // without members or a name the container is forgotten
+    const std::set<utility::Uuid> new_members(members.begin(), members.end());
+    const bool forget = new_members.empty() and name.empty();
+
+    // only the frames of members that came or went change owners
+    std::unordered_set<utility::Uuid> changed;
+
+    auto it = containers_.find(container);
+    if (it != containers_.end()) {
+        it->second.name = name;
+        if (it->second.members == new_members and not forget)
+            return;
+
+        for (const auto &i : it->second.members) {
+            if (forget or not new_members.count(i))
+                changed.insert(i);
+            auto m = member_of_.find(i);
+            if (m == member_of_.end())
+                continue;
+            m->second.erase(container);
+            if (m->second.empty())
+                member_of_.erase(m);
+        }
+    }
+
+    if (forget) {
+        containers_.erase(container);
+    } else {
+        for (const auto &i : new_members) {
+            if (it == containers_.end() or not it->second.members.count(i))
+                changed.insert(i);
+            member_of_[i].insert(container);
+        }
+        containers_[container] = Container{name, new_members};
+    }
+    cache_.refresh_owners(changed);
 }
 
 void GlobalImageCacheActor::update_changes(
     const media::MediaKeyVector &store, const media::MediaKeyVector &erase) {
 
     new_keys_.insert(store.begin(), store.end());
-    for (const auto &i : store)
+    for (const auto &i : store) {
         erased_keys_.erase(i);
+        if (warm_start_pending_.erase(i))
+            warm_start_restored_++;
+    }
 
     erased_keys_.insert(erase.begin(), erase.end());
     for (const auto &i : erase)
@@ -308,7 +937,12 @@ void GlobalImageCacheActor::update_changes(
     }
 }
 
-void GlobalImageCacheActor::on_exit() { system().registry().erase(image_cache_registry); }
+void GlobalImageCacheActor::on_exit() {
+    access_trace_.reset();
+    if (warm_start_ and not warm_start_path_.empty())
+        save_warm_start();
+    system().registry().erase(image_cache_registry);
+}
 
 
 GlobalAudioCacheActor::GlobalAudioCacheActor(caf::actor_config &cfg)
@@ -0,0 +1,248 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "xstudio/media_cache/warm_start.hpp"
+#include "xstudio/utility/helpers.hpp"
+#include "xstudio/utility/json_store.hpp"
+#include "xstudio/utility/logging.hpp"
+
+using namespace xstudio;
+using namespace xstudio::media_cache;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// the key format media sources use, see media::AVFrameID
+const std::string key_format = "{0}@{1}/{2},{3}";
+
+std::shared_ptr<const media::AVFrameID> make_frame_id(const WarmStart::Frame &frame) {
+    auto uri = caf::make_uri(frame.uri);
+    if (not uri)
+        return {};
+
+    auto result = std::make_shared<const media::AVFrameID>(
+        *uri,
+        frame.frame,
+        frame.first_frame,
+        media::FS_ON_DISK,
+        WarmStart::key_mod_timestamp(frame.key).value_or(0),
+        frame.pixel_aspect,
+        utility::FrameRate(frame.rate),
+        frame.stream_id,
+        key_format,
+        frame.reader,
+        caf::actor_addr(),
+        caf::actor_addr(),
+        utility::JsonStore(frame.params),
+        frame.source_uuid,
+        frame.media_uuid);
+
+    // held frames are keyed on a frame other than the one they were read for,
+    // which we don't know any more
+    if (result->key() != frame.key)
+        return {};
+    return result;
+}
+
+} // namespace
+
+WarmStart WarmStart::load(const std::string &path) {
+    std::ifstream in(path);
+    if (not in)
+        throw std::runtime_error(fmt::format("Failed to open cache warm start {}", path));
+
+    const auto jsn = nlohmann::json::parse(in);
+    WarmStart result;
+    for (const auto &i : jsn.at("frames"))
+        result.frames_.emplace_back(from_json(i));
+    return result;
+}
+
+bool WarmStart::save(const std::string &path) const {
+    try {
+        const auto parent = fs::path(path).parent_path();
+        if (not parent.empty())
+            fs::create_directories(parent);
+
+        auto frames = nlohmann::json::array();
+        for (const auto &i : frames_)
+            frames.push_back(to_json(i));
+
+        // written alongside and moved over, so a half written file is never
+        // picked up
+        const auto tmp = path + ".tmp";
+        {
+            std::ofstream out(tmp);
+            if (not out)
+                return false;
+            out << nlohmann::json{{"version", 1}, {"frames", frames}}.dump();
+            if (not out)
+                return false;
+        }
+        fs::rename(tmp, path);
+        return true;
+    } catch (const std::exception &err) {
+        spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
+    }
+    return false;
+}
+
+void WarmStart::add(
+    const media::AVFrameID &frame_id,
+    const size_t size,
+    const utility::time_point &needed_by,
+    const utility::time_point &now) {
+
+    if (frame_id.is_nil() or frame_id.media_type() != media::MT_IMAGE)
+        return;
+
+    Frame frame;
+    frame.key          = frame_id.key();
+    frame.uri          = to_string(frame_id.uri());
+    frame.frame        = frame_id.frame();
+    frame.first_frame  = frame_id.first_frame();
+    frame.stream_id    = frame_id.stream_id();
+    frame.reader       = frame_id.reader();
+    frame.pixel_aspect = frame_id.pixel_aspect();
+    frame.rate         = frame_id.rate();
+    frame.params       = frame_id.params();
+    frame.source_uuid  = frame_id.source_uuid();
+    frame.media_uuid   = frame_id.media_uuid();
+    frame.size         = size;
+    frame.age_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - needed_by).count();
+    frames_.emplace_back(std::move(frame));
+}
+
+void WarmStart::sort() {
+    std::stable_sort(frames_.begin(), frames_.end(), [](const Frame &a, const Frame &b) {
+        return a.age_ms < b.age_ms;
+    });
+}
+
+size_t WarmStart::validate(const size_t max_size) {
+    // the frames of a movie share a file, which only needs checking once
+    std::map<std::pair<std::string, size_t>, bool> checked;
+
+    size_t changed = 0;
+    size_t total   = 0;
+    std::vector<Frame> kept;
+    for (auto &i : frames_) {
+        const auto file = std::make_pair(i.uri, key_mod_timestamp(i.key).value_or(0));
+        auto check      = checked.find(file);
+        if (check == checked.end())
+            check = checked.emplace(file, unchanged(i)).first;
+
+        if (not check->second) {
+            changed++;
+        } else if (total + i.size <= max_size) {
+            total += i.size;
+            kept.emplace_back(std::move(i));
+        }
+    }
+    frames_ = std::move(kept);
+    return changed;
+}
+
+media::AVFrameIDsAndTimePoints WarmStart::frame_ids(const utility::time_point &now) const {
+    media::AVFrameIDsAndTimePoints result;
+    result.reserve(frames_.size());
+    if (frames_.empty())
+        return result;
+
+    // the background queue reads frames needed soonest first, so frames that
+    // had gone unused longer are needed further ahead
+    const auto newest = frames_.front().age_ms;
+    for (const auto &i : frames_) {
+        auto frame_id = make_frame_id(i);
+        if (frame_id)
+            result.emplace_back(
+                now + std::chrono::milliseconds(std::max(i.age_ms - newest, int64_t(0))),
+                frame_id);
+    }
+    return result;
+}
+
+std::optional<size_t> WarmStart::key_mod_timestamp(const media::MediaKey &key) {
+    const auto str   = to_string(key);
+    const auto comma = str.rfind(',');
+    if (comma == std::string::npos or comma + 1 == str.size())
+        return {};
+
+    const auto digits = str.substr(comma + 1);
+    if (not std::all_of(digits.begin(), digits.end(), ::isdigit))
+        return {};
+    try {
+        return std::stoull(digits);
+    } catch (...) {
+    }
+    return {};
+}
+
+bool WarmStart::unchanged(const Frame &frame) {
+    auto uri = caf::make_uri(frame.uri);
+    if (not uri)
+        return false;
+
+    // other schemes have no modification time to go by, they are read again
+    // as they would be in a new session
+    if (uri->scheme() != "file")
+        return true;
+
+    try {
+        const auto path = utility::uri_to_posix_path(*uri);
+        if (not fs::exists(path))
+            return false;
+
+        // 0 where the media source didn't check the file
+        const auto mtime = key_mod_timestamp(frame.key).value_or(0);
+        return not mtime or
+               size_t(fs::last_write_time(path).time_since_epoch().count()) == mtime;
+    } catch (...) {
+    }
+    return false;
+}
+
+nlohmann::json WarmStart::to_json(const Frame &frame) {
+    nlohmann::json result;
+    result["key"]          = to_string(frame.key);
+    result["uri"]          = frame.uri;
+    result["frame"]        = frame.frame;
+    result["first_frame"]  = frame.first_frame;
+    result["stream_id"]    = frame.stream_id;
+    result["reader"]       = frame.reader;
+    result["pixel_aspect"] = frame.pixel_aspect;
+    result["rate"]         = frame.rate.count();
+    result["params"]       = frame.params;
+    result["source_uuid"]  = frame.source_uuid;
+    result["media_uuid"]   = frame.media_uuid;
+    result["size"]         = frame.size;
+    result["age_ms"]       = frame.age_ms;
+    return result;
+}
+
+WarmStart::Frame WarmStart::from_json(const nlohmann::json &jsn) {
+    Frame frame;
+    frame.key          = media::MediaKey(jsn.at("key").get<std::string>());
+    frame.uri          = jsn.at("uri").get<std::string>();
+    frame.frame        = jsn.value("frame", 0);
+    frame.first_frame  = jsn.value("first_frame", 0);
+    frame.stream_id    = jsn.value("stream_id", "");
+    frame.reader       = jsn.value("reader", "");
+    frame.pixel_aspect = jsn.value("pixel_aspect", 1.0f);
+    frame.rate =
+        timebase::flicks(jsn.value("rate", timebase::k_flicks_24fps.count()));
+    frame.params       = jsn.value("params", nlohmann::json());
+    frame.source_uuid  = jsn.value("source_uuid", utility::Uuid());
+    frame.media_uuid   = jsn.value("media_uuid", utility::Uuid());
+    frame.size         = jsn.value("size", size_t(0));
+    frame.age_ms       = jsn.value("age_ms", int64_t(0));
+    return frame;
+}
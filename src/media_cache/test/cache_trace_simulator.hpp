@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <nlohmann/json.hpp>
+
+#include "xstudio/media_cache/cache_trace.hpp"
+#include "xstudio/media_cache/eviction_policy.hpp"
+#include "xstudio/utility/frame_rate.hpp"
+#include "xstudio/utility/time_cache.hpp"
+
+namespace xstudio {
+namespace media_cache {
+
+    /* Class CacheTraceSimulator
+
+    Replays a CacheTrace, recorded from a session with the
+    /core/image_cache/access_trace preference or built by hand, against a
+    cache of a given size running one of the eviction policies. The cache runs
+    on the trace's own clock, so a trace of minutes replays in moments. A
+    retrieve that misses is counted and then stored, as the reader would have
+    had to read the frame.
+    */
+    class CacheTraceSimulator {
+      public:
+        struct Result {
+            std::string policy;
+            size_t retrieves = {0};
+            size_t hits      = {0};
+            // frames put in the cache, whether read ahead or read on a miss
+            size_t reads    = {0};
+            size_t rejected = {0};
+            size_t dropped  = {0};
+
+            [[nodiscard]] double hit_rate() const {
+                return retrieves ? double(hits) / double(retrieves) : 0.0;
+            }
+
+            [[nodiscard]] nlohmann::json json() const {
+                return nlohmann::json{
+                    {"policy", policy},
+                    {"retrieves", retrieves},
+                    {"hits", hits},
+                    {"hit_rate", hit_rate()},
+                    {"reads", reads},
+                    {"rejected", rejected},
+                    {"dropped", dropped}};
+            }
+        };
+
+        CacheTraceSimulator(
+            const std::string &policy,
+            const size_t max_size,
+            const size_t max_count = std::numeric_limits<size_t>::max())
+            : policy_(make_eviction_policy(policy)), cache_(max_size, max_count) {
+            result_.policy = policy_->name();
+            policy_->attach(cache_);
+            cache_.set_clock([this]() { return now_; });
+            cache_.bind_change_callback([this](const auto &stored, const auto &erased) {
+                result_.reads += stored.size();
+                result_.dropped += erased.size();
+            });
+        }
+        CacheTraceSimulator(const CacheTraceSimulator &) = delete;
+
+        Result replay(const CacheTrace &trace) {
+            // frame sizes, so that frames a retrieve missed can be stored
+            std::unordered_map<media::MediaKey, size_t> sizes;
+            for (const auto &event : trace.events()) {
+                if (event.size and not event.key.is_null())
+                    sizes[event.key] = event.size;
+            }
+
+            for (const auto &event : trace.events()) {
+                now_            = at(event.t_us);
+                const auto when = at(event.when_us);
+
+                switch (event.op) {
+                case CacheTrace::Op::Store:
+                    store(event.key, event.size, when, event.uuid);
+                    break;
+                case CacheTrace::Op::StoreOutOfDate:
+                    if (not cache_.store(
+                            event.key,
+                            buffer(event.size),
+                            when,
+                            event.uuid,
+                            at(event.out_of_date_us)))
+                        result_.rejected++;
+                    break;
+                case CacheTrace::Op::Retrieve:
+                    result_.retrieves++;
+                    if (cache_.retrieve(event.key, when, event.uuid)) {
+                        result_.hits++;
+                    } else {
+                        auto size = sizes.find(event.key);
+                        if (size != sizes.end())
+                            store(event.key, size->second, when, event.uuid);
+                    }
+                    break;
+                case CacheTrace::Op::Preserve:
+                    cache_.preserve(event.key, when, event.uuid);
+                    break;
+                case CacheTrace::Op::Unpreserve:
+                    cache_.unpreserve(event.uuid);
+                    policy_->clear_playhead_hint(event.uuid);
+                    break;
+                case CacheTrace::Op::Erase:
+                    if (event.key.is_null())
+                        cache_.erase(event.uuid);
+                    else
+                        cache_.erase(event.key);
+                    break;
+                case CacheTrace::Op::Hint:
+                    policy_->set_playhead_hint(
+                        event.uuid,
+                        event.frames,
+                        event.position,
+                        timebase::to_flicks(event.frame_period_s),
+                        event.velocity,
+                        when);
+                    break;
+                case CacheTrace::Op::Position:
+                    policy_->update_playhead_position(
+                        event.uuid,
+                        event.position,
+                        timebase::to_flicks(event.frame_period_s),
+                        event.velocity,
+                        when);
+                    break;
+                }
+            }
+
+            return result_;
+        }
+
+      private:
+        struct Buffer {
+            size_t size_;
+            [[nodiscard]] size_t size() const { return size_; }
+        };
+        using BufferPtr = std::shared_ptr<Buffer>;
+
+        static utility::time_point at(const int64_t t_us) {
+            return utility::time_point(std::chrono::microseconds(t_us));
+        }
+
+        static BufferPtr buffer(const size_t size) {
+            return std::make_shared<Buffer>(Buffer{size});
+        }
+
+        void store(
+            const media::MediaKey &key,
+            const size_t size,
+            const utility::time_point &when,
+            const utility::Uuid &uuid) {
+            if (not cache_.store(key, buffer(size), when, false, uuid))
+                result_.rejected++;
+        }
+
+        std::unique_ptr<EvictionPolicy> policy_;
+        utility::TimeCache<media::MediaKey, BufferPtr> cache_;
+        utility::time_point now_;
+        Result result_;
+    };
+
+} // namespace media_cache
+} // namespace xstudio
@@ -0,0 +1,290 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <cstdlib>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <map>
+
+#include "xstudio/media_cache/cache_trace.hpp"
+#include "xstudio/media_cache/eviction_policy.hpp"
+#include "cache_trace_simulator.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::media_cache;
+
+namespace {
+
+const int64_t frame_us = 1000000 / 24;
+
+struct Loop {
+    Uuid uuid = Uuid::generate();
+    media::MediaKeyVector frames;
+};
+
+media::MediaKeyVector keys(const std::string &name, const int count) {
+    media::MediaKeyVector result;
+    for (int i = 0; i < count; ++i)
+        result.emplace_back(fmt::format("{}@{}", name, i));
+    return result;
+}
+
+// playheads looping at 24fps, reading a few frames ahead and telling the
+// cache where they are every frame, while another viewer scrubs through
+// frames it never comes back to
+CacheTrace make_trace(
+    const std::vector<Loop> &loops,
+    const int scrubbed_per_frame,
+    const int seconds,
+    const int read_ahead = 8) {
+    CacheTrace trace;
+    const auto scrubber = Uuid::generate();
+    int scrubbed        = 0;
+
+    auto event = [&](const CacheTrace::Op op,
+                     const int64_t t_us,
+                     const media::MediaKey &key,
+                     const Uuid &uuid,
+                     const int64_t when_us) {
+        CacheTrace::Event e;
+        e.op      = op;
+        e.t_us    = t_us;
+        e.key     = key;
+        e.uuid    = uuid;
+        e.when_us = when_us;
+        e.size    = 1;
+        return e;
+    };
+
+    for (const auto &loop : loops) {
+        auto hint           = event(CacheTrace::Op::Hint, 0, media::MediaKey(), loop.uuid, 0);
+        hint.frames         = loop.frames;
+        hint.frame_period_s = 1.0 / 24.0;
+        hint.velocity       = 1.0f;
+        trace.add(hint);
+    }
+
+    for (int f = 0; f < seconds * 24; ++f) {
+        const int64_t t = f * frame_us;
+
+        for (const auto &loop : loops) {
+            const size_t n = loop.frames.size();
+            const size_t i = f % n;
+
+            auto position =
+                event(CacheTrace::Op::Position, t, media::MediaKey(), loop.uuid, t);
+            position.position       = i;
+            position.frame_period_s = 1.0 / 24.0;
+            position.velocity       = 1.0f;
+            trace.add(position);
+
+            for (int j = 1; j <= read_ahead; ++j)
+                trace.add(event(
+                    CacheTrace::Op::Preserve,
+                    t,
+                    loop.frames[(i + j) % n],
+                    loop.uuid,
+                    t + j * frame_us));
+
+            trace.add(event(CacheTrace::Op::Retrieve, t, loop.frames[i], loop.uuid, t));
+        }
+
+        for (int j = 0; j < scrubbed_per_frame; ++j)
+            trace.add(event(
+                CacheTrace::Op::Retrieve,
+                t,
+                media::MediaKey(fmt::format("scrub@{}", scrubbed++)),
+                scrubber,
+                t));
+    }
+
+    return trace;
+}
+
+CacheTraceSimulator::Result
+simulate(const CacheTrace &trace, const std::string &policy, const size_t max_count) {
+    return CacheTraceSimulator(policy, std::numeric_limits<size_t>::max(), max_count)
+        .replay(trace);
+}
+
+} // namespace
+
+TEST(EvictionPolicyTest, Make) {
+    EXPECT_EQ(make_eviction_policy("needed_by")->name(), "needed_by");
+    EXPECT_FALSE(make_eviction_policy("needed_by")->estimates_next_use());
+    EXPECT_EQ(make_eviction_policy("playhead_reuse")->name(), "playhead_reuse");
+    EXPECT_TRUE(make_eviction_policy("playhead_reuse")->estimates_next_use());
+    EXPECT_THROW(make_eviction_policy("wibble"), std::runtime_error);
+}
+
+TEST(EvictionPolicyTest, PlayheadReuse) {
+    PlayheadReusePolicy policy;
+    const auto ph     = Uuid::generate();
+    const auto frames = keys("loop", 10);
+    const auto now    = clock::now();
+    const auto period = timebase::k_flicks_24fps;
+
+    auto seconds_until = [&](const media::MediaKey &key, const time_point &when) {
+        return std::chrono::duration<double>(policy.next_use(key, when) - when).count();
+    };
+
+    EXPECT_EQ(policy.next_use(frames[0], now), time_point::max());
+
+    // at frame 2 of a 10 frame loop, frame 5 is 3 frames away and frame 1
+    // comes round again after 9
+    policy.set_playhead_hint(ph, frames, 2, period, 1.0f, now);
+    EXPECT_NEAR(seconds_until(frames[5], now), 3.0 / 24.0, 1e-4);
+    EXPECT_NEAR(seconds_until(frames[1], now), 9.0 / 24.0, 1e-4);
+    EXPECT_EQ(policy.next_use(keys("other", 1)[0], now), time_point::max());
+
+    // the playhead moves on while we aren't told
+    const auto later = now + std::chrono::microseconds(2 * frame_us);
+    EXPECT_NEAR(seconds_until(frames[5], later), 1.0 / 24.0, 1e-3);
+
+    // at double speed backwards frame 1 is next
+    policy.update_playhead_position(ph, 2, period, -2.0f, now);
+    EXPECT_NEAR(seconds_until(frames[1], now), 1.0 / 48.0, 1e-4);
+    EXPECT_NEAR(seconds_until(frames[3], now), 9.0 / 48.0, 1e-4);
+
+    // the nearest of two playheads wins
+    const auto other = Uuid::generate();
+    policy.set_playhead_hint(other, {frames[3]}, 0, period, 1.0f, now);
+    EXPECT_NEAR(seconds_until(frames[3], now), 0.0, 1e-4);
+    policy.clear_playhead_hint(other);
+    EXPECT_NEAR(seconds_until(frames[3], now), 9.0 / 48.0, 1e-4);
+
+    EXPECT_EQ(policy.json()["playheads"], 1);
+    policy.clear_playhead_hint(ph);
+    EXPECT_EQ(policy.next_use(frames[1], now), time_point::max());
+    EXPECT_EQ(policy.json()["frames"], 0);
+}
+
+TEST(EvictionPolicyTest, TimeCacheEvictsFurthestNextUse) {
+    TimeCache<media::MediaKey, std::shared_ptr<std::string>> cache(
+        std::numeric_limits<size_t>::max(), 3);
+    const auto now = clock::now();
+    const auto k   = keys("frame", 4);
+
+    // frame 0 is needed again soonest, frame 2 not at all
+    std::map<media::MediaKey, time_point> next_use = {
+        {k[0], now + std::chrono::seconds(1)},
+        {k[1], now + std::chrono::seconds(5)},
+        {k[2], time_point::max()}};
+    cache.set_next_use_estimator([&](const media::MediaKey &key, const time_point &) {
+        auto n = next_use.find(key);
+        return n == next_use.end() ? time_point::max() : n->second;
+    });
+    cache.set_clock([&]() { return now; });
+
+    for (size_t i = 0; i < 3; ++i)
+        cache.store(k[i], std::make_shared<std::string>("x"), now - std::chrono::seconds(i));
+
+    EXPECT_TRUE(cache.store(k[3], std::make_shared<std::string>("x"), now));
+    EXPECT_FALSE(cache.retrieve(k[2], now));
+    EXPECT_TRUE(cache.retrieve(k[0], now));
+
+    // nothing left that is needed later than the new frame
+    next_use[k[3]] = now + std::chrono::seconds(2);
+    const auto late = now + std::chrono::seconds(10);
+    EXPECT_FALSE(cache.store(keys("late", 1)[0], std::make_shared<std::string>("x"), late));
+    EXPECT_EQ(cache.count(), size_t(3));
+}
+
+TEST(EvictionPolicyTest, TraceRoundTrip) {
+    const auto ph   = Uuid::generate();
+    const auto path =
+        (std::filesystem::temp_directory_path() / (to_string(ph) + ".jsonl")).string();
+    {
+        CacheTrace trace(path);
+        trace.record(CacheTrace::Op::Store, keys("frame", 1)[0], ph, clock::now(), 1024);
+        trace.record_hint(
+            ph, keys("frame", 3), 1, timebase::k_flicks_24fps, -1.0f, clock::now());
+        trace.record(CacheTrace::Op::Unpreserve, media::MediaKey(), ph);
+    }
+
+    auto trace = CacheTrace::load(path);
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(trace.events().size(), size_t(3));
+    EXPECT_EQ(trace.events()[0].op, CacheTrace::Op::Store);
+    EXPECT_EQ(to_string(trace.events()[0].key), "frame@0");
+    EXPECT_EQ(trace.events()[0].uuid, ph);
+    EXPECT_EQ(trace.events()[0].size, size_t(1024));
+    EXPECT_EQ(trace.events()[1].op, CacheTrace::Op::Hint);
+    EXPECT_TRUE(trace.events()[1].frames == keys("frame", 3));
+    EXPECT_EQ(trace.events()[1].position, size_t(1));
+    EXPECT_NEAR(trace.events()[1].frame_period_s, 1.0 / 24.0, 1e-6);
+    EXPECT_EQ(trace.events()[1].velocity, -1.0f);
+    EXPECT_EQ(trace.events()[2].op, CacheTrace::Op::Unpreserve);
+    EXPECT_TRUE(trace.events()[2].key.is_null());
+}
+
+// hints recorded as the buffer fills are written out whole
+TEST(EvictionPolicyTest, TraceHintFlush) {
+    const auto ph   = Uuid::generate();
+    const auto path =
+        (std::filesystem::temp_directory_path() / (to_string(ph) + ".jsonl")).string();
+    const size_t count = 4096 * 2 + 1;
+    {
+        CacheTrace trace(path);
+        for (size_t i = 0; i < count; ++i)
+            trace.record_hint(
+                ph, keys("frame", 2), i, timebase::k_flicks_24fps, 1.0f, clock::now());
+    }
+
+    auto trace = CacheTrace::load(path);
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(trace.events().size(), count);
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(trace.events()[i].op, CacheTrace::Op::Hint);
+        EXPECT_EQ(trace.events()[i].position, i);
+        EXPECT_EQ(trace.events()[i].frames.size(), size_t(2));
+    }
+}
+
+// two viewers looping 2 and 3 second ranges, with a third scrubbing through
+// new frames, and room for both loops with a little to spare
+TEST(EvictionPolicyTest, SimulateLoopsWithScrubbing) {
+    const auto loops = std::vector<Loop>{
+        {Uuid::generate(), keys("a", 48)}, {Uuid::generate(), keys("b", 72)}};
+    const auto trace = make_trace(loops, 2, 30);
+
+    const auto needed_by = simulate(trace, "needed_by", 132);
+    const auto reuse     = simulate(trace, "playhead_reuse", 132);
+
+    // the scrubbed frames always miss, so a perfect score is a half
+    EXPECT_EQ(reuse.retrieves, size_t(30 * 24 * 4));
+    EXPECT_GT(reuse.hit_rate(), 0.4);
+    EXPECT_LT(needed_by.hit_rate(), reuse.hit_rate() - 0.1);
+    EXPECT_LT(reuse.reads, needed_by.reads);
+}
+
+// a loop that doesn't fit in the cache, evicting the least recently shown
+// frame always throws away the one needed next
+TEST(EvictionPolicyTest, SimulateLoopLargerThanCache) {
+    const auto trace = make_trace({{Uuid::generate(), keys("a", 200)}}, 0, 60);
+
+    const auto needed_by = simulate(trace, "needed_by", 100);
+    const auto reuse     = simulate(trace, "playhead_reuse", 100);
+
+    EXPECT_LT(needed_by.hit_rate(), 0.05);
+    EXPECT_GT(reuse.hit_rate(), 0.4);
+}
+
+// compare the policies on a trace recorded with /core/image_cache/access_trace,
+// e.g. XSTUDIO_CACHE_TRACE=/tmp/cache.jsonl XSTUDIO_CACHE_TRACE_MB=4096
+TEST(EvictionPolicyTest, SimulateRecordedTrace) {
+    const char *path = std::getenv("XSTUDIO_CACHE_TRACE");
+    if (not path)
+        GTEST_SKIP() << "XSTUDIO_CACHE_TRACE not set";
+
+    const char *mb        = std::getenv("XSTUDIO_CACHE_TRACE_MB");
+    const size_t max_size = size_t(mb ? std::atol(mb) : 4096) * 1024 * 1024;
+
+    const auto trace = CacheTrace::load(path);
+    for (const auto &policy : {"needed_by", "playhead_reuse"}) {
+        const auto result = CacheTraceSimulator(policy, max_size).replay(trace);
+        std::cout << result.json().dump() << std::endl;
+    }
+}
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include "xstudio/media_cache/warm_start.hpp"
+#include "xstudio/utility/helpers.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::media_cache;
+
+namespace {
+
+std::filesystem::path temp_dir() {
+    auto dir = std::filesystem::temp_directory_path() /
+               fmt::format("xstudio_warm_start_test_{}", to_string(Uuid::generate()));
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+std::string touch(const std::filesystem::path &path) {
+    std::ofstream(path) << "frame";
+    return path.string();
+}
+
+size_t mtime(const std::string &path) {
+    return std::filesystem::last_write_time(path).time_since_epoch().count();
+}
+
+media::AVFrameID
+frame_id(const std::string &path, const int frame, const size_t mod_timestamp) {
+    return media::AVFrameID(
+        posix_path_to_uri(path),
+        frame,
+        1,
+        media::FS_ON_DISK,
+        mod_timestamp,
+        1.0f,
+        FrameRate(timebase::k_flicks_24fps),
+        "main",
+        "{0}@{1}/{2},{3}",
+        "OpenEXR");
+}
+
+} // namespace
+
+TEST(WarmStartTest, KeyModTimestamp) {
+    EXPECT_EQ(
+        WarmStart::key_mod_timestamp(media::MediaKey("file:///a.exr@1/main,12345"))
+            .value_or(0),
+        size_t(12345));
+    EXPECT_FALSE(WarmStart::key_mod_timestamp(media::MediaKey("file:///a.exr@1/main,")));
+    EXPECT_FALSE(WarmStart::key_mod_timestamp(media::MediaKey("proxy_test")));
+}
+
+TEST(WarmStartTest, SaveAndLoad) {
+    const auto dir  = temp_dir();
+    const auto file = touch(dir / "a.0001.exr");
+    const auto now  = utility::clock::now();
+
+    WarmStart warm_start;
+    warm_start.add(frame_id(file, 1, mtime(file)), 100, now - std::chrono::seconds(10), now);
+    warm_start.add(frame_id(file, 2, mtime(file)), 200, now + std::chrono::seconds(5), now);
+    warm_start.sort();
+    ASSERT_EQ(warm_start.frames().size(), size_t(2));
+    EXPECT_EQ(warm_start.frames()[0].frame, 2);
+    EXPECT_EQ(warm_start.frames()[0].age_ms, -5000);
+
+    const auto path = (dir / "sub" / "warm_start.json").string();
+    ASSERT_TRUE(warm_start.save(path));
+
+    const auto loaded = WarmStart::load(path);
+    ASSERT_EQ(loaded.frames().size(), size_t(2));
+    for (size_t i = 0; i < 2; ++i) {
+        const auto &a = warm_start.frames()[i];
+        const auto &b = loaded.frames()[i];
+        EXPECT_TRUE(a.key == b.key);
+        EXPECT_EQ(a.uri, b.uri);
+        EXPECT_EQ(a.frame, b.frame);
+        EXPECT_EQ(a.reader, b.reader);
+        EXPECT_EQ(a.rate, b.rate);
+        EXPECT_EQ(a.size, b.size);
+        EXPECT_EQ(a.age_ms, b.age_ms);
+    }
+
+    EXPECT_THROW(WarmStart::load((dir / "missing.json").string()), std::exception);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(WarmStartTest, Validate) {
+    const auto dir       = temp_dir();
+    const auto unchanged = touch(dir / "a.0001.exr");
+    const auto replaced  = touch(dir / "a.0002.exr");
+    const auto removed   = (dir / "a.0003.exr").string();
+    const auto now       = utility::clock::now();
+
+    WarmStart warm_start;
+    warm_start.add(frame_id(unchanged, 1, mtime(unchanged)), 100, now, now);
+    warm_start.add(frame_id(replaced, 2, mtime(replaced) + 1), 100, now, now);
+    warm_start.add(frame_id(removed, 3, 0), 100, now, now);
+    // unchecked by its media source
+    warm_start.add(frame_id(unchanged, 4, 0), 100, now - std::chrono::seconds(1), now);
+
+    auto capped = warm_start;
+    EXPECT_EQ(warm_start.validate(1000), size_t(2));
+    ASSERT_EQ(warm_start.frames().size(), size_t(2));
+    EXPECT_EQ(warm_start.frames()[0].frame, 1);
+    EXPECT_EQ(warm_start.frames()[1].frame, 4);
+
+    // only as many frames as fit
+    EXPECT_EQ(capped.validate(150), size_t(2));
+    ASSERT_EQ(capped.frames().size(), size_t(1));
+    std::filesystem::remove_all(dir);
+}
+
+TEST(WarmStartTest, FrameIds) {
+    const auto dir  = temp_dir();
+    const auto file = touch(dir / "a.0001.exr");
+    const auto then = utility::clock::now();
+
+    WarmStart warm_start;
+    for (int i = 0; i < 3; ++i)
+        warm_start.add(
+            frame_id(file, i, mtime(file)), 100, then - std::chrono::seconds(i), then);
+    warm_start.sort();
+
+    const auto now    = then + std::chrono::hours(24);
+    const auto frames = warm_start.frame_ids(now);
+    ASSERT_EQ(frames.size(), size_t(3));
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(frames[i].second->frame(), i);
+        EXPECT_TRUE(frames[i].second->key() == warm_start.frames()[i].key);
+        EXPECT_EQ(frames[i].second->reader(), "OpenEXR");
+        EXPECT_EQ(frames[i].first, now + std::chrono::seconds(i));
+    }
+    std::filesystem::remove_all(dir);
+}
@@ -1,6 +1,9 @@
 // SPDX-License-Identifier: Apache-2.0
 #include <caf/actor_registry.hpp>
 
+#include <algorithm>
+#include <mutex>
+
 #include "xstudio/media_reader/cacheing_media_reader_actor.hpp"
 #include "xstudio/global_store/global_store.hpp"
 #include "xstudio/atoms.hpp"
@@ -80,6 +83,94 @@ ImageBufPtr make_blank_image() {
     return buf;
 }
 
+bool is_cancelled(const caf::error &err) {
+    return err.category() == caf::type_id_v<media::media_error> &&
+           err.code() == static_cast<uint8_t>(media::media_error::cancelled);
+}
+
+// keeps reads ordered by class and then deadline, after others of the same
+// class and deadline
+template <typename JobPtr> void insert_job(std::vector<JobPtr> &jobs, const JobPtr &job) {
+    jobs.insert(
+        std::upper_bound(
+            jobs.begin(),
+            jobs.end(),
+            job,
+            [](const JobPtr &a, const JobPtr &b) {
+                if (a->priority != b->priority)
+                    return a->priority < b->priority;
+                return a->deadline < b->deadline;
+            }),
+        job);
+}
+
+// sequential reads of a movie within this many frames of where a decoder
+// was last asked to go stay with that decoder, decoding forward is cheaper
+// than seeking another decoder back to a keyframe
+const int max_sequential_gap = 16;
+
+/* Idle workers of image sequence sources, by reader plugin. A source with more
+reads queued than it has workers borrows them, as every frame of a sequence is
+a file of its own that any reader instance can read. Movie sources don't lend
+their workers, a reader instance keeps one movie open and positioned. */
+class SpareWorkers {
+  public:
+    static SpareWorkers &instance() {
+        static SpareWorkers spare_workers;
+        return spare_workers;
+    }
+
+    void offer(const Uuid &plugin, const caf::actor_addr &owner, const caf::actor &worker) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        spares_.push_back(Spare{plugin, owner, worker});
+    }
+
+    // the owner wants its worker back, false if it has been lent
+    bool reclaim(const caf::actor &worker) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto p = std::find_if(spares_.begin(), spares_.end(), [&worker](const Spare &s) {
+            return s.worker == worker;
+        });
+        if (p == spares_.end())
+            return false;
+        spares_.erase(p);
+        return true;
+    }
+
+    void withdraw(const caf::actor_addr &owner) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        spares_.erase(
+            std::remove_if(
+                spares_.begin(),
+                spares_.end(),
+                [&owner](const Spare &s) { return s.owner == owner; }),
+            spares_.end());
+    }
+
+    std::optional<std::pair<caf::actor, caf::actor_addr>>
+    borrow(const Uuid &plugin, const caf::actor_addr &borrower) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto p = std::find_if(spares_.begin(), spares_.end(), [&](const Spare &s) {
+            return s.plugin == plugin and s.owner != borrower;
+        });
+        if (p == spares_.end())
+            return {};
+        auto result = std::make_pair(p->worker, p->owner);
+        spares_.erase(p);
+        return result;
+    }
+
+  private:
+    struct Spare {
+        Uuid plugin;
+        caf::actor_addr owner;
+        caf::actor worker;
+    };
+
+    std::mutex mutex_;
+    std::vector<Spare> spares_;
+};
+
 } // namespace
 
 CachingMediaReaderActor::CachingMediaReaderActor(
@@ -89,7 +180,8 @@ CachingMediaReaderActor::CachingMediaReaderActor(
     caf::actor audio_cache)
     : caf::event_based_actor(cfg),
       image_cache_(std::move(image_cache)),
-      audio_cache_(std::move(audio_cache)) {
+      audio_cache_(std::move(audio_cache)),
+      plugin_uuid_(media_reader_plugin_uuid) {
 
     print_on_exit(this, "CachingMediaReaderActor");
     spdlog::debug("Created CachingMediaReaderActor.");
@@ -100,18 +192,24 @@ CachingMediaReaderActor::CachingMediaReaderActor(
         JsonStore js;
         prefs.get_group(js);
 
+        size_t num_workers = 3;
+        try {
+            num_workers = std::max(
+                size_t(1),
+                preference_value<size_t>(js, "/core/media_reader/workers_per_source"));
+        } catch (...) {
+        }
+
         auto pm = system().registry().template get<caf::actor>(plugin_manager_registry);
         scoped_actor sys{system()};
 
-        precache_worker_ = request_receive<caf::actor>(
-            *sys, pm, plugin_manager::spawn_plugin_atom_v, media_reader_plugin_uuid, js);
-        link_to(precache_worker_);
-        urgent_worker_ = request_receive<caf::actor>(
-            *sys, pm, plugin_manager::spawn_plugin_atom_v, media_reader_plugin_uuid, js);
-        link_to(urgent_worker_);
-        audio_worker_ = request_receive<caf::actor>(
-            *sys, pm, plugin_manager::spawn_plugin_atom_v, media_reader_plugin_uuid, js);
-        link_to(audio_worker_);
+        for (size_t i = 0; i < num_workers; ++i) {
+            Worker worker;
+            worker.actor = request_receive<caf::actor>(
+                *sys, pm, plugin_manager::spawn_plugin_atom_v, media_reader_plugin_uuid, js);
+            link_to(worker.actor);
+            workers_.push_back(worker);
+        }
     }
 
     if (not image_cache_)
@@ -130,13 +228,6 @@ CachingMediaReaderActor::CachingMediaReaderActor(
             blank_image_ = blank;
         },
 
-        [=](get_image_atom) {
-            // get the next pending urgent image request
-            if (!urgent_worker_busy_ && pending_get_image_requests_.size()) {
-                do_urgent_get_image();
-            }
-        },
-
         [=](get_image_atom,
             const media::AVFrameID &mptr,
             bool pin,
@@ -150,46 +241,32 @@ CachingMediaReaderActor::CachingMediaReaderActor(
                     [=](media_reader::ImageBufPtr buf) mutable {
                         if (buf) {
                             rp.deliver(buf);
-                        } else {
-                            mail(get_image_atom_v, mptr)
-                                .request(urgent_worker_, infinite)
-                                .then(
-                                    [=](media_reader::ImageBufPtr buf) mutable {
-                                        rp.deliver(buf);
-                                        // store the image in our cache
-                                        anon_mail(
-                                            media_cache::store_atom_v,
-                                            mptr.key(),
-                                            buf,
-                                            utility::clock::now() +
-                                                (pin ? std::chrono::minutes(10)
-                                                     : std::chrono::minutes(0)),
-                                            playhead_uuid)
-                                            .urgent()
-                                            .send(image_cache_);
-                                    },
-                                    [=](const caf::error &err) mutable {
-                                        // make an empty image buffer that holds the error
-                                        // message
-                                        media_reader::ImageBufPtr buf =
-                                            make_error_buffer(err, mptr);
-
-                                        // store the failed image in our cache so we don't
-                                        // keep trying to load it
-                                        anon_mail(
-                                            media_cache::store_atom_v,
-                                            mptr.key(),
-                                            buf,
-                                            utility::clock::now() +
-                                                (pin ? std::chrono::minutes(10)
-                                                     : std::chrono::minutes(0)),
-                                            playhead_uuid)
-                                            .urgent()
-                                            .send(image_cache_);
-
-                                        rp.deliver(buf);
-                                    });
+                            return;
                         }
+
+                        const auto stamp =
+                            utility::clock::now() +
+                            (pin ? std::chrono::minutes(10) : std::chrono::minutes(0));
+
+                        auto job      = make_job(mptr, RP_IMMEDIATE, utility::clock::now());
+                        job->on_image = [=](const ImageBufPtr &buf) mutable {
+                            rp.deliver(buf);
+                            // store the image in our cache
+                            store_image(mptr, buf, stamp, playhead_uuid);
+                        };
+                        job->on_error = [=](const caf::error &err) mutable {
+                            if (is_cancelled(err)) {
+                                rp.deliver(err);
+                                return;
+                            }
+                            // make an empty image buffer that holds the error
+                            // message and store the failed image in our cache
+                            // so we don't keep trying to load it
+                            auto buf = make_error_buffer(err, mptr);
+                            store_image(mptr, buf, stamp, playhead_uuid);
+                            rp.deliver(buf);
+                        };
+                        queue_read(job);
                     },
                     [=](const caf::error &err) mutable { rp.deliver(err); });
             return rp;
@@ -207,28 +284,27 @@ CachingMediaReaderActor::CachingMediaReaderActor(
                     [=](media_reader::AudioBufPtr buf) mutable {
                         if (buf) {
                             rp.deliver(buf);
-                        } else {
-                            mail(get_audio_atom_v, mptr)
-                                .request(urgent_worker_, infinite)
-                                .then(
-                                    [=](media_reader::AudioBufPtr buf) mutable {
-                                        rp.deliver(buf);
-                                        // store the image in our cache
-                                        anon_mail(
-                                            media_cache::store_atom_v,
-                                            mptr.key(),
-                                            buf,
-                                            utility::clock::now() +
-                                                (pin ? std::chrono::minutes(10)
-                                                     : std::chrono::minutes(0)),
-                                            playhead_uuid)
-                                            .send(audio_cache_);
-                                    },
-                                    [=](const caf::error &) mutable {
-                                        // deliver an empty buffer
-                                        rp.deliver(buf);
-                                    });
+                            return;
                         }
+
+                        auto job      = make_job(mptr, RP_IMMEDIATE, utility::clock::now());
+                        job->audio    = true;
+                        job->on_audio = [=](const AudioBufPtr &buf) mutable {
+                            rp.deliver(buf);
+                            // store the audio in our cache
+                            anon_mail(
+                                media_cache::store_atom_v,
+                                mptr.key(),
+                                buf,
+                                utility::clock::now() +
+                                    (pin ? std::chrono::minutes(10)
+                                         : std::chrono::minutes(0)),
+                                playhead_uuid)
+                                .send(audio_cache_);
+                        };
+                        // deliver an empty buffer
+                        job->on_error = [=](const caf::error &) mutable { rp.deliver(buf); };
+                        queue_read(job);
                     },
                     [=](const caf::error &err) mutable { rp.deliver(err); });
             return rp;
@@ -240,89 +316,342 @@ CachingMediaReaderActor::CachingMediaReaderActor(
             return receive_image_buffer_request(mptr, playhead_uuid);
         },
 
-        [=](read_precache_image_atom, const media::AVFrameID &mptr) -> result<ImageBufPtr> {
+        [=](read_precache_image_atom,
+            const media::AVFrameID &mptr,
+            const ReadCancelToken &token) -> result<ImageBufPtr> {
             // note the caller (GlobalMediaReaderActor) handles the cacheing
             // of this image buffer
-            auto rp = make_response_promise<media_reader::ImageBufPtr>();
-            mail(get_image_atom_v, mptr)
-                .request(precache_worker_, infinite)
-                .then(
-                    [=](media_reader::ImageBufPtr buf) mutable { rp.deliver(buf); },
-                    [=](const caf::error &err) mutable {
-                        rp.deliver(make_error_buffer(err, mptr));
-                    });
-
+            auto rp       = make_response_promise<media_reader::ImageBufPtr>();
+            auto job      = make_job(mptr, token.priority(), token.deadline(), token);
+            job->on_image = [=](const ImageBufPtr &buf) mutable { rp.deliver(buf); };
+            job->on_error = [=](const caf::error &err) mutable {
+                // cancelled reads mustn't be cached as failures
+                if (is_cancelled(err))
+                    rp.deliver(err);
+                else
+                    rp.deliver(make_error_buffer(err, mptr));
+            };
+            queue_read(job);
             return rp;
         },
 
-        [=](read_precache_audio_atom, const media::AVFrameID &mptr) -> result<AudioBufPtr> {
+        [=](read_precache_audio_atom,
+            const media::AVFrameID &mptr,
+            const ReadCancelToken &token) -> result<AudioBufPtr> {
             // note the caller (GlobalMediaReaderActor) handles the cacheing
-            // of this image buffer
-            auto rp = make_response_promise<media_reader::AudioBufPtr>();
-            mail(get_audio_atom_v, mptr)
-                .request(precache_worker_, infinite)
-                .then(
-                    [=](media_reader::AudioBufPtr buf) mutable { rp.deliver(buf); },
-                    [=](const caf::error &err) mutable { rp.deliver(err); });
+            // of this audio buffer
+            auto rp       = make_response_promise<media_reader::AudioBufPtr>();
+            auto job      = make_job(mptr, token.priority(), token.deadline(), token);
+            job->audio    = true;
+            job->on_audio = [=](const AudioBufPtr &buf) mutable { rp.deliver(buf); };
+            job->on_error = [=](const caf::error &err) mutable { rp.deliver(err); };
+            queue_read(job);
             return rp;
         },
 
         [=](get_media_detail_atom atom, const caf::uri &_uri) {
-            return mail(atom, _uri).delegate(urgent_worker_);
+            return mail(atom, _uri).delegate(workers_.front().actor);
+        },
+
+        // a source we lent a worker to is done with it
+        [=](return_worker_atom, const caf::actor &worker) {
+            for (auto &w : workers_) {
+                if (w.actor == worker) {
+                    w.lent    = false;
+                    w.offered = false;
+                }
+            }
+            dispatch_reads();
         }
 
     );
 }
 
-void CachingMediaReaderActor::do_urgent_get_image() {
+void CachingMediaReaderActor::on_exit() {
+    SpareWorkers::instance().withdraw(address());
 
-    auto p                      = pending_get_image_requests_.begin();
-    const media::AVFrameID mptr = p->second.mptr_;
-    auto rp                     = p->second.response_promise_;
-    auto playhead_uuid          = p->first;
-    pending_get_image_requests_.erase(p);
+    // borrowed workers go back to their owners, whose reads they were
+    // running are dropped with us
+    for (const auto &b : borrowed_) {
+        if (auto owner = caf::actor_cast<caf::actor>(b.owner))
+            anon_mail(return_worker_atom_v, b.actor).send(owner);
+    }
+    borrowed_.clear();
+}
 
-    urgent_worker_busy_ = true;
-    mail(get_image_atom_v, mptr)
-        .request(urgent_worker_, infinite)
-        .then(
-            [=](media_reader::ImageBufPtr buf) mutable {
-                // send the image back to the playhead that requested it
-                rp.deliver(buf);
-
-                // store the image in our cache
-                anon_mail(
-                    media_cache::store_atom_v,
-                    mptr.key(),
-                    buf,
-                    utility::clock::now(),
-                    playhead_uuid)
-                    .urgent()
-                    .send(image_cache_);
+CachingMediaReaderActor::ReadJobPtr CachingMediaReaderActor::make_job(
+    const media::AVFrameID &mptr,
+    const ReadPriority priority,
+    const utility::time_point &deadline,
+    const ReadCancelToken &request_token,
+    const utility::Uuid &playhead_uuid) {
+
+    auto job           = std::make_shared<ReadJob>();
+    job->mptr          = mptr;
+    job->priority      = priority;
+    job->deadline      = deadline;
+    job->request_token = request_token;
+    job->playhead_uuid = playhead_uuid;
+    job->queued_at     = utility::clock::now();
+    return job;
+}
 
-                // perhaps more urgent requests are now pending
-                urgent_worker_busy_ = false;
-                anon_mail(get_image_atom_v).send(this);
-            },
-            [=](const caf::error &err) mutable {
-                // make an empty image buffer that holds the error message
-                media_reader::ImageBufPtr buf = make_error_buffer(err, mptr);
-                rp.deliver(buf);
-
-                // store the failed image in our cache so we don't
-                // keep trying to load it
-                anon_mail(
-                    media_cache::store_atom_v,
-                    mptr.key(),
-                    buf,
-                    utility::clock::now(),
-                    playhead_uuid)
-                    .urgent()
-                    .send(image_cache_);
+void CachingMediaReaderActor::queue_read(const ReadJobPtr &job) {
+
+    note_frame(job->mptr);
+    insert_job(pending_reads_, job);
+    dispatch_reads();
+
+    if (std::find(pending_reads_.begin(), pending_reads_.end(), job) == pending_reads_.end())
+        return;
+
+    // No free worker. Preempt the lowest class read that is running, if it is
+    // of a lower class than this one. Its reader gives up at the next point
+    // it checks its token and the read goes back in the queue. A sequential
+    // read of a movie only preempts the decoder it follows on from.
+    const auto sequential = sequential_worker(*job);
+    Worker *victim        = nullptr;
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        auto &w = workers_[i];
+        if (sequential >= 0 && int(i) != sequential)
+            continue;
+        if (w.job && !w.job->preempted && w.job->priority > job->priority &&
+            (!victim || w.job->priority > victim->job->priority))
+            victim = &w;
+    }
+    if (victim) {
+        victim->job->preempted = true;
+        victim->job->token.cancel();
+    }
+}
 
-                urgent_worker_busy_ = false;
-                anon_mail(get_image_atom_v).send(this);
-            });
+void CachingMediaReaderActor::dispatch_reads() {
+
+    // drop reads that went stale while they were queued
+    auto p = pending_reads_.begin();
+    while (p != pending_reads_.end()) {
+        if ((*p)->request_token.cancelled()) {
+            auto job = *p;
+            p        = pending_reads_.erase(p);
+            const auto now = utility::clock::now();
+            ReadMetrics::instance().record(
+                job->priority, ReadMetrics::RO_CANCELLED, job->queued_at, now, now);
+            job->on_error(make_error(media_error::cancelled, "Read cancelled"));
+        } else {
+            ++p;
+        }
+    }
+
+    // A read that follows on from where one of our decoders is in a movie
+    // waits for that decoder, rather than having another decoder seek and
+    // decode up from the keyframe. Reads behind it may go to other workers.
+    p = pending_reads_.begin();
+    while (p != pending_reads_.end()) {
+        auto job         = *p;
+        const auto chain = sequential_worker(*job);
+        const auto worker =
+            chain >= 0 ? (claim_worker(workers_[chain]) ? chain : -1) : free_worker();
+        if (worker < 0) {
+            ++p;
+            continue;
+        }
+        p = pending_reads_.erase(p);
+        start_read(size_t(worker), job);
+    }
+
+    borrow_workers();
+    offer_idle_workers();
+}
+
+int CachingMediaReaderActor::sequential_worker(const ReadJob &job) const {
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        const auto &w   = workers_[i];
+        const auto step = job.mptr.frame() - w.last_frame;
+        if (w.last_audio == job.audio && step > 0 && step <= max_sequential_gap &&
+            w.last_uri == job.mptr.uri())
+            return int(i);
+    }
+    return -1;
+}
+
+int CachingMediaReaderActor::free_worker() {
+    while (true) {
+        int result = -1;
+        for (size_t i = 0; i < workers_.size(); ++i) {
+            const auto &w = workers_[i];
+            if (!w.job && !w.lent &&
+                (result < 0 || w.last_started < workers_[result].last_started))
+                result = int(i);
+        }
+        // a worker that turns out to be lent is skipped on the next pass
+        if (result < 0 || claim_worker(workers_[result]))
+            return result;
+    }
+}
+
+bool CachingMediaReaderActor::claim_worker(Worker &worker) {
+    if (worker.job || worker.lent)
+        return false;
+    if (worker.offered) {
+        worker.offered = false;
+        if (!SpareWorkers::instance().reclaim(worker.actor)) {
+            // another source has it, it comes back with return_worker_atom
+            worker.lent = true;
+            return false;
+        }
+    }
+    return true;
+}
+
+void CachingMediaReaderActor::note_frame(const media::AVFrameID &mptr) {
+    if (!frame_per_file_ && !mptr.is_nil())
+        frame_per_file_ = !mptr.container();
+}
+
+void CachingMediaReaderActor::borrow_workers() {
+
+    if (!frame_per_file_.value_or(false))
+        return;
+
+    // reads still queued have no worker of ours free. Take no more spares
+    // than we have workers, to leave some for other sources.
+    auto p = pending_reads_.begin();
+    while (p != pending_reads_.end() && borrowed_.size() < workers_.size()) {
+        auto spare = SpareWorkers::instance().borrow(plugin_uuid_, address());
+        if (!spare)
+            break;
+        auto job = *p;
+        p        = pending_reads_.erase(p);
+        start_borrowed_read(spare->first, spare->second, job);
+    }
+}
+
+void CachingMediaReaderActor::offer_idle_workers() {
+
+    if (!frame_per_file_.value_or(false))
+        return;
+
+    for (auto &w : workers_) {
+        if (!w.job && !w.lent && !w.offered) {
+            SpareWorkers::instance().offer(plugin_uuid_, address(), w.actor);
+            w.offered = true;
+        }
+    }
+}
+
+void CachingMediaReaderActor::start_read(const size_t worker, const ReadJobPtr &job) {
+
+    auto &w        = workers_[worker];
+    w.job          = job;
+    w.last_uri     = job->mptr.uri();
+    w.last_frame   = job->mptr.frame();
+    w.last_audio   = job->audio;
+    w.last_started = utility::clock::now();
+
+    run_read(w.actor, job, [=]() { workers_[worker].job.reset(); });
+}
+
+void CachingMediaReaderActor::start_borrowed_read(
+    const caf::actor &worker, const caf::actor_addr &owner, const ReadJobPtr &job) {
+
+    borrowed_.push_back(BorrowedWorker{worker, owner, job});
+
+    run_read(worker, job, [=]() {
+        auto p = std::find_if(borrowed_.begin(), borrowed_.end(), [&](const BorrowedWorker &b) {
+            return b.actor == worker;
+        });
+        if (p != borrowed_.end())
+            borrowed_.erase(p);
+        if (auto o = caf::actor_cast<caf::actor>(owner))
+            anon_mail(return_worker_atom_v, worker).send(o);
+    });
+}
+
+void CachingMediaReaderActor::run_read(
+    const caf::actor &worker, const ReadJobPtr &job, std::function<void()> release) {
+
+    job->token      = ReadCancelToken(job->priority, job->deadline, job->request_token);
+    job->started_at = utility::clock::now();
+    job->preempted  = false;
+
+    if (job->audio) {
+        mail(get_audio_atom_v, job->mptr, job->token)
+            .request(worker, infinite)
+            .then(
+                [=](const AudioBufPtr &buf) mutable {
+                    release();
+                    read_finished(job);
+                    job->on_audio(buf);
+                    dispatch_reads();
+                },
+                [=](const caf::error &err) mutable {
+                    release();
+                    read_failed(job, err);
+                });
+    } else {
+        mail(get_image_atom_v, job->mptr, job->token)
+            .request(worker, infinite)
+            .then(
+                [=](const ImageBufPtr &buf) mutable {
+                    release();
+                    read_finished(job);
+                    job->on_image(buf);
+                    dispatch_reads();
+                },
+                [=](const caf::error &err) mutable {
+                    release();
+                    read_failed(job, err);
+                });
+    }
+}
+
+void CachingMediaReaderActor::read_finished(const ReadJobPtr &job) {
+    ReadMetrics::instance().record(
+        job->priority,
+        ReadMetrics::RO_COMPLETED,
+        job->queued_at,
+        job->started_at,
+        utility::clock::now());
+}
+
+void CachingMediaReaderActor::read_failed(const ReadJobPtr &job, const caf::error &err) {
+
+    const auto cancelled = is_cancelled(err);
+    // a borrowed worker goes when the source that owns it is retired
+    const auto lost_worker = err == caf::sec::request_receiver_down;
+    if (((cancelled && job->preempted) || lost_worker) && !job->request_token.cancelled()) {
+        // preempted by a more urgent read, try again when a worker is free
+        ReadMetrics::instance().record(
+            job->priority,
+            ReadMetrics::RO_PREEMPTED,
+            job->queued_at,
+            job->started_at,
+            utility::clock::now());
+        insert_job(pending_reads_, job);
+    } else {
+        ReadMetrics::instance().record(
+            job->priority,
+            cancelled ? ReadMetrics::RO_CANCELLED : ReadMetrics::RO_FAILED,
+            job->queued_at,
+            job->started_at,
+            utility::clock::now());
+        job->on_error(err);
+    }
+
+    dispatch_reads();
+}
+
+void CachingMediaReaderActor::store_image(
+    const media::AVFrameID &mptr,
+    const ImageBufPtr &buf,
+    const utility::time_point &tp,
+    const utility::Uuid &playhead_uuid) {
+    // the cache lists what it holds by frame for a warm start
+    ImageBufPtr stored(buf);
+    stored.set_frame_id(mptr);
+    anon_mail(media_cache::store_atom_v, mptr.key(), stored, tp, playhead_uuid)
+        .urgent()
+        .send(image_cache_);
 }
 
 caf::typed_response_promise<ImageBufPtr> CachingMediaReaderActor::receive_image_buffer_request(
@@ -337,11 +666,53 @@ caf::typed_response_promise<ImageBufPtr> CachingMediaReaderActor::receive_image_
                 if (buf) {
                     // send the image back to the playhead that requested it
                     rt.deliver(buf);
-                } else {
-                    // image is not cached. Update the request to load the image
-                    pending_get_image_requests_[playhead_uuid] = ImmediateImageReqest(mptr, rt);
-                    mail(get_image_atom_v).send(this);
+                    return;
+                }
+
+                // image is not cached. A playhead only wants its latest
+                // frame, so this replaces any read it has queued but not
+                // started
+                auto p = pending_reads_.begin();
+                while (p != pending_reads_.end()) {
+                    if ((*p)->priority == RP_IMMEDIATE &&
+                        (*p)->playhead_uuid == playhead_uuid) {
+                        auto job       = *p;
+                        p              = pending_reads_.erase(p);
+                        const auto now = utility::clock::now();
+                        ReadMetrics::instance().record(
+                            job->priority, ReadMetrics::RO_CANCELLED, job->queued_at, now, now);
+                        job->on_error(make_error(media_error::cancelled, "Read superseded"));
+                    } else {
+                        ++p;
+                    }
                 }
+
+                auto job = make_job(
+                    mptr,
+                    RP_IMMEDIATE,
+                    utility::clock::now(),
+                    ReadCancelToken(),
+                    playhead_uuid);
+
+                job->on_image = [=](const ImageBufPtr &buf) mutable {
+                    // send the image back to the playhead that requested it
+                    rt.deliver(buf);
+                    // store the image in our cache
+                    store_image(mptr, buf, utility::clock::now(), playhead_uuid);
+                };
+                job->on_error = [=](const caf::error &err) mutable {
+                    if (is_cancelled(err)) {
+                        rt.deliver(err);
+                        return;
+                    }
+                    // make an empty image buffer that holds the error message
+                    // and store the failed image in our cache so we don't keep
+                    // trying to load it
+                    auto buf = make_error_buffer(err, mptr);
+                    rt.deliver(buf);
+                    store_image(mptr, buf, utility::clock::now(), playhead_uuid);
+                };
+                queue_read(job);
             },
             [=](const caf::error &err) mutable {
                 rt.deliver(err);
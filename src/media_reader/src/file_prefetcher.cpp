@@ -0,0 +1,284 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <filesystem>
+#include <set>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "xstudio/media_reader/file_prefetcher.hpp"
+
+using namespace xstudio;
+using namespace xstudio::media_reader;
+
+namespace {
+
+// files are read in pieces of this size, checking for cancellation between
+const size_t chunk_size = 1024 * 1024;
+
+// a prefetched file that no decoder has read within this time is assumed to
+// be unwanted, and stops counting against the budget
+const auto prefetch_expiry = std::chrono::seconds(10);
+
+} // namespace
+
+FilePrefetcher::FilePrefetcher(const int threads, const size_t byte_budget)
+    : byte_budget_(byte_budget) {
+    for (int i = 0; i < std::max(threads, 1); ++i)
+        threads_.emplace_back(&FilePrefetcher::run, this);
+}
+
+FilePrefetcher::~FilePrefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        for (auto &i : running_)
+            i.second.cancelled->store(true);
+    }
+    cv_.notify_all();
+    for (auto &t : threads_)
+        t.join();
+}
+
+void FilePrefetcher::set_byte_budget(const size_t byte_budget) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        byte_budget_ = byte_budget;
+    }
+    cv_.notify_all();
+}
+
+size_t FilePrefetcher::byte_budget() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return byte_budget_;
+}
+
+size_t FilePrefetcher::outstanding_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return outstanding_bytes_;
+}
+
+void FilePrefetcher::prefetch(
+    const utility::Uuid &playhead_uuid, const std::vector<std::string> &paths) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        expire(utility::clock::now());
+
+        const std::set<std::string> wanted(paths.begin(), paths.end());
+
+        queue_.erase(
+            std::remove_if(
+                queue_.begin(),
+                queue_.end(),
+                [&](const Job &job) { return job.playhead_uuid == playhead_uuid; }),
+            queue_.end());
+
+        for (auto &i : running_) {
+            if (i.second.playhead_uuid == playhead_uuid && !wanted.count(i.first))
+                i.second.cancelled->store(true);
+        }
+
+        // files fetched for where the playhead was heading before
+        for (auto p = prefetched_.begin(); p != prefetched_.end();) {
+            if (p->second.playhead_uuid == playhead_uuid && !wanted.count(p->first)) {
+                outstanding_bytes_ -= p->second.bytes;
+                p = prefetched_.erase(p);
+            } else {
+                ++p;
+            }
+        }
+
+        std::set<std::string> queued;
+        for (const auto &job : queue_)
+            queued.insert(job.path);
+
+        for (const auto &path : paths) {
+            if (prefetched_.count(path) || running_.count(path) || !queued.insert(path).second)
+                continue;
+            queue_.push_back(
+                Job{playhead_uuid, path, std::make_shared<std::atomic<bool>>(false)});
+        }
+    }
+    cv_.notify_all();
+}
+
+void FilePrefetcher::cancel(const utility::Uuid &playhead_uuid) {
+    prefetch(playhead_uuid, std::vector<std::string>());
+}
+
+void FilePrefetcher::clear() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.clear();
+        for (auto &i : running_)
+            i.second.cancelled->store(true);
+        // reads still running give their bytes back as they stop
+        for (const auto &i : prefetched_)
+            outstanding_bytes_ -= i.second.bytes;
+        prefetched_.clear();
+    }
+    cv_.notify_all();
+}
+
+void FilePrefetcher::consumed(const std::string &path) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto p = prefetched_.find(path);
+        if (p != prefetched_.end()) {
+            outstanding_bytes_ -= p->second.bytes;
+            prefetched_.erase(p);
+        }
+
+        // the decoder got there first, it is reading the file itself
+        auto r = running_.find(path);
+        if (r != running_.end())
+            r->second.cancelled->store(true);
+        queue_.erase(
+            std::remove_if(
+                queue_.begin(),
+                queue_.end(),
+                [&](const Job &job) { return job.path == path; }),
+            queue_.end());
+    }
+    cv_.notify_all();
+}
+
+nlohmann::json FilePrefetcher::json() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nlohmann::json{
+        {"files", files_},
+        {"bytes", bytes_},
+        {"cancelled", cancelled_},
+        {"failed", failed_},
+        {"skipped", skipped_},
+        {"queued", queue_.size()},
+        {"running", running_.size()},
+        {"outstanding_bytes", outstanding_bytes_},
+        {"byte_budget", byte_budget_}};
+}
+
+void FilePrefetcher::expire(const utility::time_point &now) {
+    for (auto p = prefetched_.begin(); p != prefetched_.end();) {
+        if (now - p->second.when > prefetch_expiry) {
+            outstanding_bytes_ -= p->second.bytes;
+            p = prefetched_.erase(p);
+        } else {
+            ++p;
+        }
+    }
+}
+
+void FilePrefetcher::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        expire(utility::clock::now());
+
+        if (queue_.empty() || outstanding_bytes_ >= byte_budget_) {
+            cv_.wait_for(lock, std::chrono::seconds(1));
+            continue;
+        }
+
+        auto job = queue_.front();
+        queue_.pop_front();
+        running_[job.path] = job;
+
+        lock.unlock();
+        const size_t size = file_size(job.path);
+        lock.lock();
+
+        if (!size || job.cancelled->load()) {
+            running_.erase(job.path);
+            if (size)
+                cancelled_++;
+            else
+                failed_++;
+            continue;
+        }
+
+        if (size > byte_budget_ / 4) {
+            // too big to be a single frame, most likely a movie that decoders
+            // only read a small part of
+            running_.erase(job.path);
+            skipped_++;
+            continue;
+        }
+
+        if (outstanding_bytes_ && outstanding_bytes_ + size > byte_budget_) {
+            // no room for it yet, it stays at the head of the queue until
+            // decoders have read some of what we already fetched
+            running_.erase(job.path);
+            queue_.push_front(job);
+            cv_.wait_for(lock, std::chrono::seconds(1));
+            continue;
+        }
+
+        outstanding_bytes_ += size;
+        lock.unlock();
+        const bool fetched = read_file(job.path, *job.cancelled);
+        lock.lock();
+
+        running_.erase(job.path);
+        if (fetched) {
+            prefetched_[job.path] = Prefetched{size, utility::clock::now(), job.playhead_uuid};
+            files_++;
+            bytes_ += size;
+        } else {
+            outstanding_bytes_ -= size;
+            if (job.cancelled->load())
+                cancelled_++;
+            else
+                failed_++;
+        }
+    }
+}
+
+size_t FilePrefetcher::file_size(const std::string &path) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(path, ec);
+    return ec ? 0 : size_t(size);
+}
+
+bool FilePrefetcher::read_file(const std::string &path, const std::atomic<bool> &cancelled) {
+    thread_local std::vector<char> buffer(chunk_size);
+
+#ifdef _WIN32
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    if (!in)
+        return false;
+    while (in && !cancelled.load())
+        in.read(buffer.data(), buffer.size());
+    return !cancelled.load();
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+#ifdef __linux__
+    // start the kernel reading the whole file while we pull it through
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#endif
+
+    bool result = true;
+    while (true) {
+        if (cancelled.load()) {
+            result = false;
+            break;
+        }
+        const ssize_t n = ::read(fd, buffer.data(), buffer.size());
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n < 0)
+            result = false;
+        if (n <= 0)
+            break;
+    }
+
+    ::close(fd);
+    return result;
+#endif
+}
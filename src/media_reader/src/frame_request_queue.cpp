@@ -1,14 +1,30 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "xstudio/media_reader/frame_request_queue.hpp"
+#include "xstudio/utility/frame_trace.hpp"
 #include "xstudio/utility/helpers.hpp"
 
 using namespace xstudio::media_reader;
 using namespace xstudio;
 
+void FrameRequestQueue::sort_queue() {
+    // stable, so requests of the same class required at the same time keep the
+    // order they were added in
+    std::stable_sort(
+        queue_.begin(),
+        queue_.end(),
+        [](const std::shared_ptr<FrameRequest> &a, const std::shared_ptr<FrameRequest> &b)
+            -> bool {
+            if (a->priority_ != b->priority_)
+                return a->priority_ < b->priority_;
+            return a->required_by_ < b->required_by_;
+        });
+}
+
 void FrameRequestQueue::add_frame_request(
     const media::AVFrameID &frame_info,
     const utility::time_point &required_by,
-    const utility::Uuid &requesting_playhead_uuid) {
+    const utility::Uuid &requesting_playhead_uuid,
+    const ReadPriority priority) {
 
     // auto tt = utility::clock::now();
     // spdlog::warn("{}",to_string(frame_info.uri_));
@@ -21,6 +37,9 @@ void FrameRequestQueue::add_frame_request(
             if ((*pp)->required_by_ > required_by) {
                 (*pp)->required_by_ = required_by;
             }
+            if ((*pp)->priority_ > priority) {
+                (*pp)->priority_ = priority;
+            }
             matches_existing_request = true;
             break;
         }
@@ -31,45 +50,60 @@ void FrameRequestQueue::add_frame_request(
         queue_.emplace_back(new FrameRequest(
             std::shared_ptr<const media::AVFrameID>(new media::AVFrameID(frame_info)),
             required_by,
-            requesting_playhead_uuid));
+            requesting_playhead_uuid,
+            priority));
     }
 
-    std::sort(
-        queue_.begin(),
-        queue_.end(),
-        [](const std::shared_ptr<FrameRequest> &a, const std::shared_ptr<FrameRequest> &b)
-            -> bool { return a->required_by_ < b->required_by_; });
+    sort_queue();
 }
 
 void FrameRequestQueue::add_frame_requests(
     const media::AVFrameIDsAndTimePoints &frames_info,
-    const utility::Uuid &requesting_playhead_uuid) {
+    const utility::Uuid &requesting_playhead_uuid,
+    const ReadPriority priority) {
 
     for (const auto &p : frames_info) {
         const std::shared_ptr<const media::AVFrameID> &frame_info = (p.second);
         const utility::time_point &when_we_want_it                = p.first;
-        queue_.emplace_back(
-            new FrameRequest(frame_info, when_we_want_it, requesting_playhead_uuid));
+        queue_.emplace_back(new FrameRequest(
+            frame_info, when_we_want_it, requesting_playhead_uuid, priority));
     }
 
-    std::sort(
-        queue_.begin(),
-        queue_.end(),
-        [](const std::shared_ptr<FrameRequest> &a, const std::shared_ptr<FrameRequest> &b)
-            -> bool { return a->required_by_ < b->required_by_; });
+    sort_queue();
 }
 
-std::optional<FrameRequest>
-FrameRequestQueue::pop_request(const std::map<utility::Uuid, int> &exclude_playheads) {
+std::optional<FrameRequest> FrameRequestQueue::pop_request(
+    const std::map<utility::Uuid, int> &in_flight,
+    const std::map<utility::Uuid, int> &max_in_flight) {
     std::optional<FrameRequest> rt = {};
 
+    auto is_busy = [&](const utility::Uuid &playhead_uuid) -> bool {
+        auto n = in_flight.find(playhead_uuid);
+        if (n == in_flight.end())
+            return false;
+        auto m = max_in_flight.find(playhead_uuid);
+        return n->second >= (m == max_in_flight.end() ? 1 : m->second);
+    };
+
     for (auto p = queue_.begin(); p != queue_.end(); p++) {
-        if (!exclude_playheads.count((*p)->requesting_playhead_uuid_)) {
+        if (!is_busy((*p)->requesting_playhead_uuid_)) {
             rt = *(*p);
             queue_.erase(p);
             break;
         }
     }
+
+    if (rt)
+        rt->cancel_token_ = ReadCancelToken(rt->priority_, rt->required_by_);
+
+    if (rt && utility::FrameTracer::enabled()) {
+        utility::FrameTracer::instance().record(
+            utility::TraceStage::RequestQueueWait,
+            rt->queued_at_,
+            utility::clock::now(),
+            rt->requested_frame_->key(),
+            rt->requesting_playhead_uuid_);
+    }
     return rt;
 }
 
@@ -88,6 +122,27 @@ void FrameRequestQueue::prune_stale_frame_requests() {
     }
 }
 
+size_t FrameRequestQueue::size(const ReadPriority priority) const {
+    return std::count_if(
+        queue_.begin(), queue_.end(), [priority](const std::shared_ptr<FrameRequest> &x) {
+            return x->priority_ == priority;
+        });
+}
+
+void FrameRequestQueue::clear_pending_requests(
+    const utility::Uuid &playhead_uuid, const ReadPriority priority) {
+
+    queue_.erase(
+        std::remove_if(
+            queue_.begin(),
+            queue_.end(),
+            [&playhead_uuid, priority](const std::shared_ptr<FrameRequest> &x) {
+                return x->requesting_playhead_uuid_ == playhead_uuid &&
+                       x->priority_ == priority;
+            }),
+        queue_.end());
+}
+
 void FrameRequestQueue::clear_pending_requests(const utility::Uuid &playhead_uuid) {
 
     queue_.erase(
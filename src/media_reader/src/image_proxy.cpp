@@ -0,0 +1,334 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <cstring>
+
+#include <Imath/half.h>
+
+#if defined(__SSE2__) || defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+#include "xstudio/media_reader/image_proxy.hpp"
+#include "xstudio/media_reader/pixel_layout.hpp"
+
+using namespace xstudio;
+using namespace xstudio::media_reader;
+
+namespace {
+
+// not worth making a level narrower than this
+constexpr size_t min_proxy_width = 32;
+
+enum class SampleFormat { U8, U16LE, U16BE, U32, Half, Float, Unsupported };
+
+SampleFormat sample_format(const PixelPlane &plane) {
+    if (plane.format == "B")
+        return SampleFormat::U8;
+    if (plane.format == "<H")
+        return SampleFormat::U16LE;
+    if (plane.format == ">H")
+        return SampleFormat::U16BE;
+    if (plane.format == "I")
+        return SampleFormat::U32;
+    if (plane.format == "e")
+        return SampleFormat::Half;
+    if (plane.format == "f")
+        return SampleFormat::Float;
+    return SampleFormat::Unsupported;
+}
+
+template <typename T> T load(const uint8_t *p) {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+template <typename T> void store(uint8_t *p, const T v) { std::memcpy(p, &v, sizeof(T)); }
+
+inline uint32_t load_u16(const uint8_t *p, const bool big_endian) {
+    return big_endian ? uint32_t((p[0] << 8) | p[1]) : uint32_t(p[0] | (p[1] << 8));
+}
+
+inline void store_u16(uint8_t *p, const uint32_t v, const bool big_endian) {
+    p[big_endian ? 1 : 0] = uint8_t(v & 0xff);
+    p[big_endian ? 0 : 1] = uint8_t(v >> 8);
+}
+
+// average of the samples at a, b, c and d into out, integers rounded to
+// nearest
+void average(
+    const uint8_t *a,
+    const uint8_t *b,
+    const uint8_t *c,
+    const uint8_t *d,
+    uint8_t *out,
+    const SampleFormat f) {
+    switch (f) {
+    case SampleFormat::U8:
+        *out = uint8_t((uint32_t(*a) + *b + *c + *d + 2) >> 2);
+        break;
+    case SampleFormat::U16LE:
+    case SampleFormat::U16BE: {
+        const bool be = f == SampleFormat::U16BE;
+        store_u16(
+            out,
+            (load_u16(a, be) + load_u16(b, be) + load_u16(c, be) + load_u16(d, be) + 2) >> 2,
+            be);
+    } break;
+    case SampleFormat::U32:
+        store<uint32_t>(
+            out,
+            uint32_t(
+                (uint64_t(load<uint32_t>(a)) + load<uint32_t>(b) + load<uint32_t>(c) +
+                 load<uint32_t>(d) + 2) >>
+                2));
+        break;
+    case SampleFormat::Half:
+        store<half>(
+            out,
+            half(
+                (float(load<half>(a)) + float(load<half>(b)) + float(load<half>(c)) +
+                 float(load<half>(d))) *
+                0.25f));
+        break;
+    case SampleFormat::Float:
+        store<float>(
+            out,
+            (load<float>(a) + load<float>(b) + load<float>(c) + load<float>(d)) * 0.25f);
+        break;
+    default:
+        break;
+    }
+}
+
+/* The vectorised reductions take whole 2x2 blocks only, from the start of
+the row, and return how many output pixels they did. The rest of the row,
+including the last column of an odd width, is left to the scalar loop. */
+
+#if defined(__SSE2__)
+// 8 bit RGBA, two output pixels a step
+size_t reduce_u8x4(const uint8_t *r0, const uint8_t *r1, uint8_t *out, const size_t blocks) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two  = _mm_set1_epi16(2);
+    size_t x           = 0;
+    for (; x + 2 <= blocks; x += 2) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r0 + x * 8));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r1 + x * 8));
+        // the rows summed, pixels 0 and 1 in lo, 2 and 3 in hi
+        const __m128i lo =
+            _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+        const __m128i hi =
+            _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+        // then 0 with 1 and 2 with 3
+        const __m128i sum =
+            _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+        const __m128i avg = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + x * 4), _mm_packus_epi16(avg, zero));
+    }
+    return x;
+}
+
+// 8 bit single channel (planar YUV), eight output samples a step
+size_t reduce_u8x1(const uint8_t *r0, const uint8_t *r1, uint8_t *out, const size_t blocks) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+    const __m128i two  = _mm_set1_epi16(2);
+    size_t x           = 0;
+    for (; x + 8 <= blocks; x += 8) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r0 + x * 2));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r1 + x * 2));
+        const __m128i lo =
+            _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+        const __m128i hi =
+            _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+        // neighbours summed into 32 bit lanes, then back to 16
+        const __m128i sum =
+            _mm_packs_epi32(_mm_madd_epi16(lo, ones), _mm_madd_epi16(hi, ones));
+        const __m128i avg = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + x), _mm_packus_epi16(avg, zero));
+    }
+    return x;
+}
+
+// float RGBA, one output pixel a step
+size_t reduce_f32x4(const uint8_t *r0, const uint8_t *r1, uint8_t *out, const size_t blocks) {
+    const __m128 quarter = _mm_set1_ps(0.25f);
+    const auto *a        = reinterpret_cast<const float *>(r0);
+    const auto *b        = reinterpret_cast<const float *>(r1);
+    auto *o              = reinterpret_cast<float *>(out);
+    for (size_t x = 0; x < blocks; ++x) {
+        const __m128 sum = _mm_add_ps(
+            _mm_add_ps(_mm_loadu_ps(a + x * 8), _mm_loadu_ps(a + x * 8 + 4)),
+            _mm_add_ps(_mm_loadu_ps(b + x * 8), _mm_loadu_ps(b + x * 8 + 4)));
+        _mm_storeu_ps(o + x * 4, _mm_mul_ps(sum, quarter));
+    }
+    return blocks;
+}
+#endif
+
+#if defined(__F16C__)
+// half RGBA, one output pixel a step
+size_t reduce_f16x4(const uint8_t *r0, const uint8_t *r1, uint8_t *out, const size_t blocks) {
+    const __m128 quarter = _mm_set1_ps(0.25f);
+    for (size_t x = 0; x < blocks; ++x) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r0 + x * 16));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(r1 + x * 16));
+        const __m128 sum = _mm_add_ps(
+            _mm_add_ps(_mm_cvtph_ps(a), _mm_cvtph_ps(_mm_srli_si128(a, 8))),
+            _mm_add_ps(_mm_cvtph_ps(b), _mm_cvtph_ps(_mm_srli_si128(b, 8))));
+        _mm_storel_epi64(
+            reinterpret_cast<__m128i *>(out + x * 8),
+            _mm_cvtps_ph(_mm_mul_ps(sum, quarter), _MM_FROUND_TO_NEAREST_INT));
+    }
+    return blocks;
+}
+#endif
+
+/* One row of the reduced plane from rows r0 and r1 of the source, which are
+the same row at the bottom of an odd height. */
+void reduce_row(
+    const uint8_t *r0,
+    const uint8_t *r1,
+    uint8_t *out,
+    const PixelPlane &plane,
+    const SampleFormat f) {
+    const size_t cols     = plane.shape[1];
+    const size_t channels = plane.shape[2];
+    const size_t pixel    = plane.strides[1];
+    const size_t out_cols = (cols + 1) / 2;
+    const size_t blocks   = cols / 2;
+
+    size_t x = 0;
+#if defined(__SSE2__)
+    if (f == SampleFormat::U8 and channels == 4)
+        x = reduce_u8x4(r0, r1, out, blocks);
+    else if (f == SampleFormat::U8 and channels == 1)
+        x = reduce_u8x1(r0, r1, out, blocks);
+    else if (f == SampleFormat::Float and channels == 4)
+        x = reduce_f32x4(r0, r1, out, blocks);
+#endif
+#if defined(__F16C__)
+    if (f == SampleFormat::Half and channels == 4)
+        x = reduce_f16x4(r0, r1, out, blocks);
+#endif
+
+    for (; x < out_cols; ++x) {
+        const size_t c0 = 2 * x * pixel;
+        const size_t c1 = std::min(2 * x + 1, cols - 1) * pixel;
+        for (size_t c = 0; c < channels; ++c) {
+            const size_t o = c * plane.itemsize;
+            average(r0 + c0 + o, r0 + c1 + o, r1 + c0 + o, r1 + c1 + o, out + x * pixel + o, f);
+        }
+    }
+}
+
+// the next level down from src, null if it can't be made
+ImageBufPtr reduce(const ImageBuffer &src, const int level) {
+    if (src.error_state() != NO_ERROR)
+        return ImageBufPtr();
+
+    const auto planes = pixel_layout(src);
+    if (planes.empty() or planes[0].name == "bytes" or planes[0].shape[1] < min_proxy_width * 2)
+        return ImageBufPtr();
+
+    std::vector<SampleFormat> formats;
+    for (const auto &p : planes) {
+        formats.push_back(sample_format(p));
+        if (formats.back() == SampleFormat::Unsupported)
+            return ImageBufPtr();
+    }
+
+    const auto &sp    = src.shader_params();
+    const bool exr    = sp.contains("pix_type_r");
+    const bool ffmpeg = not exr and sp.contains("rgb");
+
+    // the EXR shader steps through the data window bytes_per_pixel at a time
+    if (exr and size_t(sp.value("bytes_per_pixel", 0)) != planes[0].strides[1])
+        return ImageBufPtr();
+
+    // planes are packed one after the other, only the ffmpeg and EXR shaders
+    // take a line size so elsewhere rows can't be padded. Packed half EXR
+    // rows start on a 4 byte boundary.
+    const bool packed_half = exr and sp.value("packed_half", 0);
+    std::vector<PixelPlane> out_planes;
+    size_t total = 0;
+    for (const auto &p : planes) {
+        const size_t rows = (p.shape[0] + 1) / 2;
+        const size_t cols = (p.shape[1] + 1) / 2;
+        size_t row_bytes  = cols * p.strides[1];
+        if (ffmpeg)
+            row_bytes = (row_bytes + 31) & ~size_t(31);
+        else if (packed_half)
+            row_bytes = (row_bytes + 3) & ~size_t(3);
+        out_planes.push_back(detail::make_plane(
+            p.name, total, rows, cols, p.shape[2], row_bytes, p.format, p.itemsize));
+        total += rows * row_bytes;
+    }
+
+    utility::JsonStore params(sp);
+    const auto size = src.image_size_in_pixels();
+    const Imath::V2i proxy_size((size.x + 1) / 2, (size.y + 1) / 2);
+    const Imath::V2i proxy_cols_rows(int(out_planes[0].shape[1]), int(out_planes[0].shape[0]));
+    Imath::Box2i bounds;
+
+    if (exr) {
+        // the data window can start at an odd (or negative) pixel
+        const auto b = src.image_pixels_bounding_box();
+        bounds.min   = Imath::V2i(b.min.x >> 1, b.min.y >> 1);
+        bounds.max   = bounds.min + proxy_cols_rows;
+        if (sp.contains("line_stride"))
+            params["line_stride"] = out_planes[0].strides[0];
+    } else if (ffmpeg) {
+        params["frame_width_pixels"] = proxy_cols_rows.x;
+        size_t i                     = 0;
+        for (const std::string slot : {"y", "u", "v", "a"}) {
+            if (i == out_planes.size() or not sp.value(slot + "_linesize", 0))
+                continue;
+            params[slot + "_linesize"]           = out_planes[i].strides[0];
+            params[slot + "_plane_bytes_offset"] = out_planes[i].offset;
+            i++;
+        }
+    } else {
+        params["width"]  = proxy_cols_rows.x;
+        params["height"] = proxy_cols_rows.y;
+    }
+
+    ImageBufPtr result(new ImageBuffer(utility::Uuid(), params, src.params()));
+    result->set_image_dimensions(proxy_size, bounds);
+    result->set_proxy_of(src, level);
+
+    const auto *in = reinterpret_cast<const uint8_t *>(src.buffer());
+    auto *out      = reinterpret_cast<uint8_t *>(result->allocate(total));
+
+    for (size_t i = 0; i < planes.size(); ++i) {
+        const auto &p = planes[i];
+        const auto &o = out_planes[i];
+        for (size_t y = 0; y < o.shape[0]; ++y) {
+            reduce_row(
+                in + p.offset + 2 * y * p.strides[0],
+                in + p.offset + std::min(2 * y + 1, p.shape[0] - 1) * p.strides[0],
+                out + o.offset + y * o.strides[0],
+                p,
+                formats[i]);
+        }
+    }
+
+    return result;
+}
+
+} // namespace
+
+std::vector<ImageBufPtr>
+xstudio::media_reader::make_image_proxies(const ImageBuffer &buf, const int max_level) {
+    std::vector<ImageBufPtr> result;
+    const ImageBuffer *src = &buf;
+    for (int level = buf.proxy_level() + 1; level <= std::min(max_level, max_proxy_level);
+         ++level) {
+        auto proxy = reduce(*src, level);
+        if (not proxy)
+            break;
+        result.push_back(proxy);
+        src = proxy.get();
+    }
+    return result;
+}
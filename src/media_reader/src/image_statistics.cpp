@@ -0,0 +1,568 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <Imath/half.h>
+#include <Imath/ImathMatrix.h>
+
+#if defined(__SSE2__) || defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+#include "xstudio/media_reader/image_statistics.hpp"
+#include "xstudio/media_reader/pixel_layout.hpp"
+#include "xstudio/utility/worker_pool.hpp"
+
+using namespace xstudio;
+using namespace xstudio::media_reader;
+
+namespace {
+
+// rows handed to a thread at a time
+constexpr int row_chunk = 16;
+
+enum class SampleFormat { U8, U16LE, U16BE, U32, Half, Float, Unsupported };
+
+SampleFormat sample_format(const PixelPlane &plane) {
+    if (plane.format == "B")
+        return SampleFormat::U8;
+    if (plane.format == "<H")
+        return SampleFormat::U16LE;
+    if (plane.format == ">H")
+        return SampleFormat::U16BE;
+    if (plane.format == "I")
+        return SampleFormat::U32;
+    if (plane.format == "e")
+        return SampleFormat::Half;
+    if (plane.format == "f")
+        return SampleFormat::Float;
+    return SampleFormat::Unsupported;
+}
+
+inline float load_sample(const uint8_t *p, const SampleFormat f) {
+    switch (f) {
+    case SampleFormat::U8:
+        return float(*p);
+    case SampleFormat::U16LE:
+        return float(uint16_t(p[0] | (p[1] << 8)));
+    case SampleFormat::U16BE:
+        return float(uint16_t((p[0] << 8) | p[1]));
+    case SampleFormat::U32: {
+        // exr uint channels, ids and counts, measured as their raw values
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(uint32_t));
+        return float(v);
+    }
+    case SampleFormat::Half: {
+        half h;
+        std::memcpy(&h, p, sizeof(half));
+        return float(h);
+    }
+    case SampleFormat::Float: {
+        float v;
+        std::memcpy(&v, p, sizeof(float));
+        return v;
+    }
+    default:
+        break;
+    }
+    return 0.0f;
+}
+
+/* Decodes a span of pixels on a row of the data window to RGBA float,
+matching the reader's unpack shader. Everything that depends on the shader
+params is worked out once in the constructor, the per row decode only
+touches the pixel memory. */
+class RowDecoder {
+  public:
+    explicit RowDecoder(const ImageBuffer &buf);
+
+    // pixels [x0, x1) of image line y, 4 floats per pixel into rgba
+    void decode(const int y, const int x0, const int x1, float *rgba) const;
+
+  private:
+    enum class Kind { Scanline, Interleaved, PlanarRGB, PlanarYUV };
+
+    void decode_interleaved(const int row, const int c0, const int n, float *rgba) const;
+    void decode_planar_rgb(const int row, const int c0, const int n, float *rgba) const;
+    void decode_planar_yuv(const int row, const int c0, const int n, float *rgba) const;
+
+    const ImageBuffer &buf_;
+    const uint8_t *data_;
+    Imath::Box2i bounds_;
+    Kind kind_{Kind::Scanline};
+    std::vector<PixelPlane> planes_;
+    std::vector<SampleFormat> formats_;
+    float norm_{1.0f};
+
+    // interleaved, source channel for R, G, B and A, -1 means constant
+    std::array<int, 4> order_{0, 1, 2, -1};
+
+    // planar YUV
+    Imath::M33f yuv_conv_;
+    Imath::V3f yuv_offsets_{0.0f, 0.0f, 0.0f};
+    int chroma_shift_x_{0};
+    int chroma_shift_y_{0};
+};
+
+RowDecoder::RowDecoder(const ImageBuffer &buf)
+    : buf_(buf),
+      data_(reinterpret_cast<const uint8_t *>(buf.buffer())),
+      bounds_(buf.image_pixels_bounding_box()),
+      planes_(pixel_layout(buf)) {
+
+    for (const auto &p : planes_)
+        formats_.push_back(sample_format(p));
+
+    const bool supported =
+        !planes_.empty() && planes_[0].name != "bytes" &&
+        std::none_of(formats_.begin(), formats_.end(), [](const auto f) {
+            return f == SampleFormat::Unsupported;
+        });
+    if (!supported)
+        return;
+
+    const auto &sp = buf.shader_params();
+    switch (formats_[0]) {
+    case SampleFormat::U8:
+        norm_ = 1.0f / 255.0f;
+        break;
+    case SampleFormat::U16LE:
+        norm_ = sp.value("norm_coeff", 1.0f / 65535.0f);
+        break;
+    case SampleFormat::U16BE:
+        norm_ = 1.0f / 65535.0f;
+        break;
+    default:
+        norm_ = 1.0f;
+        break;
+    }
+
+    const auto &name = planes_[0].name;
+    if (planes_.size() == 1) {
+        const auto n_chan = int(planes_[0].shape[2]);
+        kind_             = Kind::Interleaved;
+        if (name == "bgr" || name == "bgra")
+            order_ = {2, 1, 0, n_chan == 4 ? 3 : -1};
+        else if (name == "argb")
+            order_ = {1, 2, 3, 0};
+        else if (name == "abgr")
+            order_ = {3, 2, 1, 0};
+        else if (n_chan == 1)
+            order_ = {0, 0, 0, -1};
+        else if (n_chan == 2)
+            // luminance / alpha
+            order_ = {0, 0, 0, 1};
+        else
+            order_ = {0, 1, 2, n_chan == 4 ? 3 : -1};
+    } else if (name == "g") {
+        kind_ = Kind::PlanarRGB;
+    } else if (name == "y" && planes_.size() >= 3) {
+        try {
+            yuv_conv_    = sp.at("yuv_conv").get<Imath::M33f>();
+            yuv_offsets_ = sp.at("yuv_offsets").get<Imath::V3f>();
+        } catch (...) {
+            // without the matrix we can't match the shader
+            return;
+        }
+        chroma_shift_x_ = sp.value("half_scale_uvx", 0);
+        chroma_shift_y_ = sp.value("half_scale_uvy", 0);
+        kind_           = Kind::PlanarYUV;
+    }
+}
+
+void RowDecoder::decode(const int y, const int x0, const int x1, float *rgba) const {
+
+    const int row = y - bounds_.min.y;
+    const int c0  = x0 - bounds_.min.x;
+    const int n   = x1 - x0;
+
+    switch (kind_) {
+    case Kind::Interleaved:
+        decode_interleaved(row, c0, n, rgba);
+        break;
+    case Kind::PlanarRGB:
+        decode_planar_rgb(row, c0, n, rgba);
+        break;
+    case Kind::PlanarYUV:
+        decode_planar_yuv(row, c0, n, rgba);
+        break;
+    default: {
+        // the reader knows best, unpack the whole line and keep our span
+        thread_local std::vector<float> line;
+        line.resize(size_t(bounds_.max.x - bounds_.min.x) * 4);
+        buf_.unpack_scanline(y, line.data());
+        std::memcpy(rgba, line.data() + size_t(c0) * 4, size_t(n) * 4 * sizeof(float));
+    } break;
+    }
+}
+
+void RowDecoder::decode_interleaved(
+    const int row, const int c0, const int n, float *rgba) const {
+
+    const auto &p   = planes_[0];
+    const auto fmt  = formats_[0];
+    const auto *src = data_ + p.offset + size_t(row) * p.strides[0] + size_t(c0) * p.strides[1];
+    const bool rgba_order = order_ == std::array<int, 4>{0, 1, 2, 3};
+
+#if defined(__F16C__)
+    if (fmt == SampleFormat::Half && rgba_order) {
+        for (int x = 0; x < n; ++x, src += 8) {
+            const __m128i hv = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src));
+            _mm_storeu_ps(rgba + x * 4, _mm_cvtph_ps(hv));
+        }
+        return;
+    }
+#endif
+
+#if defined(__SSE2__)
+    if (fmt == SampleFormat::U8 && rgba_order) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128 scale = _mm_set1_ps(norm_);
+        for (int x = 0; x < n; ++x, src += 4) {
+            int32_t px;
+            std::memcpy(&px, src, sizeof(px));
+            __m128i v = _mm_cvtsi32_si128(px);
+            v         = _mm_unpacklo_epi16(_mm_unpacklo_epi8(v, zero), zero);
+            _mm_storeu_ps(rgba + x * 4, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+        }
+        return;
+    }
+#endif
+
+    const auto step = p.strides[1];
+    const auto item = p.strides[2];
+    for (int x = 0; x < n; ++x, src += step, rgba += 4) {
+        for (int c = 0; c < 4; ++c) {
+            rgba[c] = order_[c] < 0 ? 1.0f : load_sample(src + order_[c] * item, fmt) * norm_;
+        }
+    }
+}
+
+void RowDecoder::decode_planar_rgb(
+    const int row, const int c0, const int n, float *rgba) const {
+
+    // planes are stored G, B, R (, A)
+    static const std::array<int, 4> channel = {1, 2, 0, 3};
+
+    std::fill(rgba, rgba + size_t(n) * 4, 1.0f);
+    for (size_t i = 0; i < planes_.size() && i < 4; ++i) {
+        const auto &p   = planes_[i];
+        const auto *src = data_ + p.offset + size_t(row) * p.strides[0];
+        float *dst      = rgba + channel[i];
+        for (int x = 0; x < n; ++x, dst += 4) {
+            *dst = load_sample(src + size_t(c0 + x) * p.strides[1], formats_[i]) * norm_;
+        }
+    }
+}
+
+void RowDecoder::decode_planar_yuv(
+    const int row, const int c0, const int n, float *rgba) const {
+
+    const auto &py = planes_[0];
+    const auto &pu = planes_[1];
+    const auto &pv = planes_[2];
+    const auto *pa = planes_.size() > 3 ? &planes_[3] : nullptr;
+
+    const auto crow = size_t(row >> chroma_shift_y_);
+    const auto *y   = data_ + py.offset + size_t(row) * py.strides[0];
+    const auto *u   = data_ + pu.offset + crow * pu.strides[0];
+    const auto *v   = data_ + pv.offset + crow * pv.strides[0];
+    const auto *a   = pa ? data_ + pa->offset + size_t(row) * pa->strides[0] : nullptr;
+
+    for (int x = 0; x < n; ++x, rgba += 4) {
+        const auto col  = size_t(c0 + x);
+        const auto ccol = col >> chroma_shift_x_;
+        const Imath::V3f yuv(
+            load_sample(y + col * py.strides[1], formats_[0]),
+            load_sample(u + ccol * pu.strides[1], formats_[1]),
+            load_sample(v + ccol * pv.strides[1], formats_[2]));
+        const Imath::V3f rgb = (yuv - yuv_offsets_) * yuv_conv_ * norm_;
+        rgba[0]              = rgb.x;
+        rgba[1]              = rgb.y;
+        rgba[2]              = rgb.z;
+        rgba[3] = a ? load_sample(a + col * pa->strides[1], formats_[3]) * norm_ : 1.0f;
+    }
+}
+
+// one thread's share of the results, merged at the end
+struct Partial {
+    explicit Partial(const ImageStatistics &layout) {
+        min.fill(std::numeric_limits<float>::max());
+        max.fill(std::numeric_limits<float>::lowest());
+        for (size_t c = 0; c < 4; ++c)
+            histograms[c].assign(layout.histograms[c].size(), 0);
+        waveform.assign(layout.waveform.size(), 0);
+        vectorscope.assign(layout.vectorscope.size(), 0);
+    }
+
+    std::array<float, 4> min;
+    std::array<float, 4> max;
+    std::array<double, 4> sum{0.0, 0.0, 0.0, 0.0};
+    // finite samples that went into sum
+    std::array<size_t, 4> count{0, 0, 0, 0};
+    std::array<std::vector<uint32_t>, 4> histograms;
+    std::vector<uint32_t> waveform;
+    std::vector<uint32_t> vectorscope;
+};
+
+class Accumulator {
+  public:
+    Accumulator(const StatisticsOptions &options, const ImageStatistics &layout)
+        : options_(options),
+          layout_(layout),
+          width_(layout.region.max.x - layout.region.min.x),
+          range_scale_(
+              options.range_max > options.range_min
+                  ? 1.0f / (options.range_max - options.range_min)
+                  : 1.0f) {}
+
+    void add_row(const float *rgba, Partial &p) const;
+
+  private:
+    [[nodiscard]] inline int bin(const float v, const int n) const {
+        const int b = int((v - options_.range_min) * range_scale_ * float(n));
+        return std::clamp(b, 0, n - 1);
+    }
+
+    const StatisticsOptions &options_;
+    const ImageStatistics &layout_;
+    const int width_;
+    const float range_scale_;
+};
+
+void Accumulator::add_row(const float *rgba, Partial &p) const {
+
+#if defined(__SSE2__)
+    // min/max take the accumulator as the second operand, which is what
+    // SSE returns when the other is NaN, so NaN pixels don't stick. NaN and
+    // infinite values are masked out of the sum, v - v is only ordered for
+    // finite v.
+    __m128 vmin    = _mm_loadu_ps(p.min.data());
+    __m128 vmax    = _mm_loadu_ps(p.max.data());
+    __m128 vsum    = _mm_setzero_ps();
+    __m128i vcount = _mm_setzero_si128();
+    for (int x = 0; x < width_; ++x) {
+        const __m128 v      = _mm_loadu_ps(rgba + x * 4);
+        const __m128 finite = _mm_cmpord_ps(_mm_sub_ps(v, v), _mm_setzero_ps());
+        vmin                = _mm_min_ps(v, vmin);
+        vmax                = _mm_max_ps(v, vmax);
+        vsum                = _mm_add_ps(vsum, _mm_and_ps(v, finite));
+        // the mask is -1 in the finite lanes
+        vcount = _mm_sub_epi32(vcount, _mm_castps_si128(finite));
+    }
+    std::array<float, 4> row_sum;
+    std::array<int32_t, 4> row_count;
+    _mm_storeu_ps(p.min.data(), vmin);
+    _mm_storeu_ps(p.max.data(), vmax);
+    _mm_storeu_ps(row_sum.data(), vsum);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(row_count.data()), vcount);
+#else
+    std::array<float, 4> row_sum{0.0f, 0.0f, 0.0f, 0.0f};
+    std::array<int32_t, 4> row_count{0, 0, 0, 0};
+    for (int x = 0; x < width_; ++x) {
+        for (int c = 0; c < 4; ++c) {
+            const float v = rgba[x * 4 + c];
+            if (std::isnan(v))
+                continue;
+            p.min[c] = std::min(p.min[c], v);
+            p.max[c] = std::max(p.max[c], v);
+            if (std::isfinite(v)) {
+                row_sum[c] += v;
+                row_count[c]++;
+            }
+        }
+    }
+#endif
+    for (size_t c = 0; c < 4; ++c) {
+        p.sum[c] += row_sum[c];
+        p.count[c] += size_t(row_count[c]);
+    }
+
+    const int bins = options_.histogram_bins;
+    if (bins > 0) {
+        for (int x = 0; x < width_; ++x) {
+            for (int c = 0; c < 4; ++c) {
+                const float v = rgba[x * 4 + c];
+                if (!std::isnan(v))
+                    p.histograms[c][bin(v, bins)]++;
+            }
+        }
+    }
+
+    const int wcols = layout_.waveform_columns;
+    const int wrows = layout_.waveform_rows;
+    const int vsize = layout_.vectorscope_size;
+    if (!wcols && !vsize)
+        return;
+
+    for (int x = 0; x < width_; ++x) {
+        const float *px = rgba + x * 4;
+        // Rec.709
+        const float luma = 0.2126f * px[0] + 0.7152f * px[1] + 0.0722f * px[2];
+        if (std::isnan(luma))
+            continue;
+
+        if (wcols) {
+            const int col = int(int64_t(x) * wcols / width_);
+            p.waveform[size_t(col) * wrows + bin(luma, wrows)]++;
+        }
+
+        if (vsize) {
+            const float cb = (px[2] - luma) / 1.8556f + 0.5f;
+            const float cr = (px[0] - luma) / 1.5748f + 0.5f;
+            const int u    = std::clamp(int(cb * float(vsize)), 0, vsize - 1);
+            const int v    = std::clamp(int(cr * float(vsize)), 0, vsize - 1);
+            p.vectorscope[size_t(v) * vsize + u]++;
+        }
+    }
+}
+
+template <typename T> void add_to(std::vector<T> &dst, const std::vector<T> &src) {
+    for (size_t i = 0; i < dst.size(); ++i)
+        dst[i] += src[i];
+}
+
+nlohmann::json box_to_json(const Imath::Box2i &box) {
+    return nlohmann::json::array({box.min.x, box.min.y, box.max.x, box.max.y});
+}
+
+} // anonymous namespace
+
+StatisticsOptions::StatisticsOptions(const utility::JsonStore &jsn) {
+    if (jsn.contains("region") && jsn["region"].is_array() && jsn["region"].size() == 4) {
+        const auto &r = jsn["region"];
+        region        = Imath::Box2i(
+            Imath::V2i(r[0].get<int>(), r[1].get<int>()),
+            Imath::V2i(r[2].get<int>(), r[3].get<int>()));
+    }
+    if (jsn.contains("range") && jsn["range"].is_array() && jsn["range"].size() == 2) {
+        range_min = jsn["range"][0].get<float>();
+        range_max = jsn["range"][1].get<float>();
+    }
+    histogram_bins   = jsn.value("histogram_bins", histogram_bins);
+    waveform_columns = jsn.value("waveform_columns", waveform_columns);
+    waveform_rows    = jsn.value("waveform_rows", waveform_rows);
+    vectorscope_size = jsn.value("vectorscope_size", vectorscope_size);
+    num_threads      = jsn.value("num_threads", num_threads);
+}
+
+utility::JsonStore StatisticsOptions::json() const {
+    utility::JsonStore result;
+    if (!region.isEmpty())
+        result["region"] = box_to_json(region);
+    result["range"]            = nlohmann::json::array({range_min, range_max});
+    result["histogram_bins"]   = histogram_bins;
+    result["waveform_columns"] = waveform_columns;
+    result["waveform_rows"]    = waveform_rows;
+    result["vectorscope_size"] = vectorscope_size;
+    result["num_threads"]      = num_threads;
+    return result;
+}
+
+utility::JsonStore ImageStatistics::json() const {
+    utility::JsonStore result;
+    result["region"]      = box_to_json(region);
+    result["pixel_count"] = pixel_count;
+    result["min"]         = min;
+    result["max"]         = max;
+    result["mean"]        = mean;
+
+    static const std::array<const char *, 4> names = {"r", "g", "b", "a"};
+    if (!histograms[0].empty()) {
+        auto h = nlohmann::json::object();
+        for (size_t c = 0; c < 4; ++c)
+            h[names[c]] = histograms[c];
+        result["histograms"] = h;
+    }
+    if (waveform_columns)
+        result["waveform"] = {
+            {"columns", waveform_columns}, {"rows", waveform_rows}, {"data", waveform}};
+    if (vectorscope_size)
+        result["vectorscope"] = {{"size", vectorscope_size}, {"data", vectorscope}};
+    return result;
+}
+
+ImageStatistics xstudio::media_reader::image_statistics(
+    const ImageBuffer &buf, const StatisticsOptions &options) {
+
+    ImageStatistics result;
+
+    const auto bounds = buf.image_pixels_bounding_box();
+    auto region       = options.region.isEmpty() ? bounds : options.region;
+    region.min.x      = std::max(region.min.x, bounds.min.x);
+    region.min.y      = std::max(region.min.y, bounds.min.y);
+    region.max.x      = std::min(region.max.x, bounds.max.x);
+    region.max.y      = std::min(region.max.y, bounds.max.y);
+
+    if (!buf.buffer() || !buf.size() || region.max.x <= region.min.x ||
+        region.max.y <= region.min.y)
+        return result;
+
+    const int width  = region.max.x - region.min.x;
+    const int height = region.max.y - region.min.y;
+
+    result.region           = region;
+    result.pixel_count      = size_t(width) * size_t(height);
+    result.waveform_columns = std::clamp(options.waveform_columns, 0, width);
+    result.waveform_rows    = result.waveform_columns ? std::max(options.waveform_rows, 1) : 0;
+    result.vectorscope_size = std::max(options.vectorscope_size, 0);
+    for (auto &h : result.histograms)
+        h.assign(size_t(std::max(options.histogram_bins, 0)), 0);
+    result.waveform.assign(size_t(result.waveform_columns) * result.waveform_rows, 0);
+    result.vectorscope.assign(size_t(result.vectorscope_size) * result.vectorscope_size, 0);
+
+    const RowDecoder decoder(buf);
+    const Accumulator accumulator(options, result);
+
+    // threads are kept between calls, statistics are taken for every frame
+    // while scopes are shown
+    static utility::WorkerPool workers;
+
+    const int max_threads = options.num_threads > 0
+                                ? std::min(options.num_threads, workers.num_threads())
+                                : workers.num_threads();
+    const int n_threads   = std::clamp((height + row_chunk - 1) / row_chunk, 1, max_threads);
+
+    // each partial is filled by one worker at a time, which takes rows until
+    // there are none left
+    std::vector<Partial> partials(size_t(n_threads), Partial(result));
+    std::atomic<int> next_row{0};
+
+    workers.parallel_for(n_threads, 1, [&](const int begin, const int end) {
+        std::vector<float> rgba(size_t(width) * 4);
+        for (int i = begin; i < end; ++i) {
+            int r;
+            while ((r = next_row.fetch_add(row_chunk)) < height) {
+                for (int y = r; y < std::min(r + row_chunk, height); ++y) {
+                    decoder.decode(
+                        region.min.y + y, region.min.x, region.max.x, rgba.data());
+                    accumulator.add_row(rgba.data(), partials[i]);
+                }
+            }
+        }
+    });
+
+    std::array<double, 4> sum{0.0, 0.0, 0.0, 0.0};
+    std::array<size_t, 4> count{0, 0, 0, 0};
+    result.min.fill(std::numeric_limits<float>::max());
+    result.max.fill(std::numeric_limits<float>::lowest());
+    for (const auto &p : partials) {
+        for (size_t c = 0; c < 4; ++c) {
+            result.min[c] = std::min(result.min[c], p.min[c]);
+            result.max[c] = std::max(result.max[c], p.max[c]);
+            sum[c] += p.sum[c];
+            count[c] += p.count[c];
+            add_to(result.histograms[c], p.histograms[c]);
+        }
+        add_to(result.waveform, p.waveform);
+        add_to(result.vectorscope, p.vectorscope);
+    }
+    for (size_t c = 0; c < 4; ++c)
+        result.mean[c] = count[c] ? sum[c] / double(count[c]) : 0.0;
+
+    return result;
+}
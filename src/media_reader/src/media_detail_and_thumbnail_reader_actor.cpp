@@ -167,10 +167,17 @@ void MediaDetailAndThumbnailReaderActor::get_thumbnail_from_reader_plugin(
     const size_t size) {
 
     auto colour_pipe_manager = system().registry().get<caf::actor>(colour_pipeline_registry);
+    const auto started       = utility::clock::now();
     mail(get_thumbnail_atom_v, mptr, size)
         .request(reader_plugin, infinite)
         .then(
             [=](const thumbnail::ThumbnailBufferPtr &buf) mutable {
+                ReadMetrics::instance().record(
+                    RP_THUMBNAIL,
+                    buf ? ReadMetrics::RO_COMPLETED : ReadMetrics::RO_FAILED,
+                    started,
+                    started,
+                    utility::clock::now());
                 if (buf && buf->format() == thumbnail::THUMBNAIL_FORMAT::TF_RGB24)
                     rp.deliver(buf);
                 else if (buf) {
@@ -195,6 +202,12 @@ void MediaDetailAndThumbnailReaderActor::get_thumbnail_from_reader_plugin(
                 }
             },
             [=](const caf::error &err) mutable {
+                ReadMetrics::instance().record(
+                    RP_THUMBNAIL,
+                    ReadMetrics::RO_FAILED,
+                    started,
+                    started,
+                    utility::clock::now());
                 spdlog::error("{} {}", err.category(), to_string(err));
                 rp.deliver(err);
             });
@@ -289,6 +302,8 @@ void MediaDetailAndThumbnailReaderActor::send_error_to_source(
             case media_error::missing:
                 anon_mail(media_status_atom_v, MediaStatus::MS_MISSING).send(dest);
                 break;
+            case media_error::cancelled:
+                break;
             }
         }
     }
@@ -155,6 +155,73 @@ xstudio::media_reader::byte *ImageBuffer::allocate(const size_t _size) {
     return Buffer::allocate(padded_size);
 }
 
+void ImageBuffer::unpack_scanline(const int line, float *rgba_out) const {
+
+    const Imath::Box2i &bounds = pixels_bounds_;
+    const int width            = bounds.max.x - bounds.min.x;
+
+    if (scanline_unpack_) {
+        scanline_unpack_(*this, line, rgba_out);
+        return;
+    }
+
+    // Fallback for readers that don't provide a dedicated unpacker - the
+    // pixel picker returns raw RGBA for any 'extra' pixel locations so we
+    // can use it to decode a scanline. Slow, but works for any reader
+    // that supports pixel probing.
+    std::fill(rgba_out, rgba_out + width * 4, 0.0f);
+    if (!pixel_picker_ || width <= 0)
+        return;
+
+    std::vector<Imath::V2i> locations;
+    locations.reserve(width);
+    for (int x = bounds.min.x; x < bounds.max.x; ++x) {
+        locations.emplace_back(x, line);
+    }
+
+    const PixelInfo info = pixel_picker_(*this, Imath::V2i(bounds.min.x, line), locations);
+    const auto &pixels   = info.extra_pixel_raw_rgba_values();
+    const size_t n       = std::min(pixels.size(), size_t(width));
+    for (size_t i = 0; i < n; ++i) {
+        rgba_out[i * 4]     = pixels[i].x;
+        rgba_out[i * 4 + 1] = pixels[i].y;
+        rgba_out[i * 4 + 2] = pixels[i].z;
+        rgba_out[i * 4 + 3] = pixels[i].w;
+    }
+}
+
+const utility::JsonStore &ImageBuffer::metadata() const {
+    if (!metadata_loader_)
+        return metadata_;
+
+    auto &loader = *metadata_loader_;
+    std::call_once(loader.loaded_, [&loader]() {
+        loader.metadata_ = loader.load_();
+        loader.load_     = MetadataLoaderFunc();
+    });
+    return loader.metadata_;
+}
+
+void ImageBuffer::set_metadata_loader(MetadataLoaderFunc loader) {
+    metadata_loader_        = std::make_shared<MetadataLoader>();
+    metadata_loader_->load_ = std::move(loader);
+    metadata_               = utility::JsonStore();
+}
+
+void ImageBuffer::set_proxy_of(const ImageBuffer &source, const int level) {
+    shader_                = source.shader_;
+    metadata_              = source.metadata_;
+    metadata_loader_       = source.metadata_loader_;
+    media_key_             = source.media_key_;
+    frame_num_             = source.frame_num_;
+    scanline_unpack_       = source.scanline_unpack_;
+    has_alpha_             = source.has_alpha_;
+    source_size_in_pixels_ = source.source_size_in_pixels();
+    proxy_level_           = level;
+    if (source.display_timestamp_seconds_is_set())
+        set_display_timestamp_seconds(source.display_timestamp_seconds());
+}
+
 utility::JsonStore ImageBufPtr::metadata() const {
     // the idea here is we add in a few useful metadata fields ontop of the
     // metadata that is carried by the underlying pointer (the ImageBuffer).
@@ -4,11 +4,14 @@
 #include <caf/actor_registry.hpp>
 
 #include <limits>
+#include <set>
 
 #include "xstudio/atoms.hpp"
 #include "xstudio/global_store/global_store.hpp"
 #include "xstudio/media/caf_media_error.hpp"
 #include "xstudio/media_reader/cacheing_media_reader_actor.hpp"
+#include "xstudio/media_reader/image_proxy.hpp"
+#include "xstudio/media_reader/image_statistics.hpp"
 #include "xstudio/media_reader/media_detail_and_thumbnail_reader_actor.hpp"
 #include "xstudio/media_reader/media_reader_actor.hpp"
 #include "xstudio/plugin_manager/plugin_manager.hpp"
@@ -139,6 +142,67 @@ ReaderHelper::ReaderHelper(
         });
 }
 
+// makes proxies for the image cache, away from the global reader
+class ProxyHelper : public caf::event_based_actor {
+  public:
+    ProxyHelper(caf::actor_config &cfg);
+    ~ProxyHelper() override = default;
+
+    const char *name() const override { return NAME.c_str(); }
+
+  private:
+    inline static const std::string NAME = "ProxyHelper";
+    caf::behavior make_behavior() override { return behavior_; }
+
+  private:
+    caf::behavior behavior_;
+};
+
+ProxyHelper::ProxyHelper(caf::actor_config &cfg) : caf::event_based_actor(cfg) {
+
+    behavior_.assign(
+        // the smallest level up to the one asked for that could be made, made
+        // through the levels above it
+        [=](proxy_atom, const ImageBufPtr &buf, const int level) -> ImageBufPtr {
+            if (not buf)
+                return ImageBufPtr();
+            const auto proxies = make_image_proxies(*buf, level);
+            return proxies.empty() ? ImageBufPtr() : proxies.back();
+        });
+}
+
+// measures decoded frames for the python api, away from the global reader
+class StatisticsHelper : public caf::event_based_actor {
+  public:
+    StatisticsHelper(caf::actor_config &cfg);
+    ~StatisticsHelper() override = default;
+
+    const char *name() const override { return NAME.c_str(); }
+
+  private:
+    inline static const std::string NAME = "StatisticsHelper";
+    caf::behavior make_behavior() override { return behavior_; }
+
+  private:
+    caf::behavior behavior_;
+};
+
+StatisticsHelper::StatisticsHelper(caf::actor_config &cfg) : caf::event_based_actor(cfg) {
+
+    behavior_.assign(
+        [=](image_statistics_atom,
+            const ImageBufPtr &buf,
+            const utility::JsonStore &options) -> result<utility::JsonStore> {
+            if (!buf)
+                return make_error(xstudio_error::error, "No image");
+            try {
+                return image_statistics(*buf, StatisticsOptions(options)).json();
+            } catch (const std::exception &err) {
+                return make_error(xstudio_error::error, err.what());
+            }
+        });
+}
+
 GlobalMediaReaderActor::GlobalMediaReaderActor(
     caf::actor_config &cfg, const utility::Uuid &uuid)
     : caf::event_based_actor(cfg), uuid_(uuid), max_source_count_(256), max_source_age_(600) {
@@ -156,6 +220,12 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
             max_source_count_ =
                 preference_value<size_t>(js, "/core/media_reader/max_source_count");
             max_source_age_ = preference_value<size_t>(js, "/core/media_reader/max_source_age");
+            read_ahead_.set_max_parallel_reads(
+                preference_value<int>(js, "/core/media_reader/workers_per_source"));
+            prefetch_files_ = preference_value<size_t>(js, "/core/media_reader/prefetch_files");
+            prefetcher_.set_byte_budget(
+                preference_value<size_t>(js, "/core/media_reader/prefetch_budget_mb") * 1024 *
+                1024);
         } catch (...) {
         }
 
@@ -211,14 +281,31 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
         caf::actor_pool::round_robin());
     link_to(thumbnail_reader_pool);
 
+    auto proxy_pool = caf::actor_pool::make(
+        system(),
+        2,
+        [&] { return system().spawn<ProxyHelper>(); },
+        caf::actor_pool::round_robin());
+    link_to(proxy_pool);
+
+    auto statistics_pool = caf::actor_pool::make(
+        system(),
+        2,
+        [&] { return system().spawn<StatisticsHelper>(); },
+        caf::actor_pool::round_robin());
+    link_to(statistics_pool);
+
 #pragma GCC diagnostic pop
 
     behavior_.assign(
         [=](xstudio::broadcast::broadcast_down_atom, const caf::actor_addr &) {},
 
         [=](clear_precache_queue_atom, const Uuid &playhead_uuid) -> bool {
-            playback_precache_request_queue_.clear_pending_requests(playhead_uuid);
-            background_precache_request_queue_.clear_pending_requests(playhead_uuid);
+            precache_request_queue_.clear_pending_requests(playhead_uuid);
+            cancel_stale_reads(playhead_uuid);
+            prefetcher_.cancel(playhead_uuid);
+            read_ahead_.clear_playhead(playhead_uuid);
+            update_read_ahead_plans();
 
             // this marks all cache entries for this playhead as 'stale' by
             // moving their timestamps to 1 hour in the past - hence they
@@ -234,14 +321,17 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
         [=](clear_precache_queue_atom, const std::vector<Uuid> &playhead_uuids) -> bool {
             for (const auto &playhead_uuid : playhead_uuids) {
 
-                playback_precache_request_queue_.clear_pending_requests(playhead_uuid);
-                background_precache_request_queue_.clear_pending_requests(playhead_uuid);
+                precache_request_queue_.clear_pending_requests(playhead_uuid);
+                cancel_stale_reads(playhead_uuid);
+                prefetcher_.cancel(playhead_uuid);
+                read_ahead_.clear_playhead(playhead_uuid);
                 // this marks all cache entries for this playhead as 'stale' by
                 // moving their timestamps to 1 hour in the past - hence they
                 // will be dropped if the cache fills up
 
                 anon_mail(media_cache::unpreserve_atom_v, playhead_uuid).send(image_cache_);
             }
+            update_read_ahead_plans();
             return true;
         },
 
@@ -309,7 +399,7 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
             const utility::Uuid &playhead_uuid,
             const timebase::flicks plahead_position) -> result<ImageBufPtr> {
             auto rp = make_response_promise<media_reader::ImageBufPtr>();
-            mail(media_cache::retrieve_atom_v, mptr.key())
+            mail(media_cache::retrieve_atom_v, mptr.key(), playhead_uuid)
                 .request(image_cache_, infinite)
                 .then(
                     [=](media_reader::ImageBufPtr buf) mutable {
@@ -389,6 +479,66 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
             return rp;
         },
 
+        // a batch of frames, e.g. a frame range for the python api. Images
+        // come from the cache where possible, frames that fail to read are
+        // returned as buffers holding the error.
+        [=](get_image_atom,
+            const std::vector<media::AVFrameID> &mptrs) -> result<std::vector<ImageBufPtr>> {
+            // image buffers are not serialisable
+            if (current_sender() and current_sender()->node() != node())
+                return make_error(
+                    xstudio_error::error, "Decoded images can only be requested in process");
+
+            if (mptrs.empty())
+                return std::vector<ImageBufPtr>();
+
+            auto batch   = std::make_shared<ImageBatch>();
+            batch->mptrs = mptrs;
+            batch->results.resize(mptrs.size());
+            batch->rp = make_response_promise<std::vector<ImageBufPtr>>();
+            read_image_batch(batch);
+            return batch->rp;
+        },
+
+        // region stats, histograms and scope data for a decoded frame, see
+        // StatisticsOptions for the keys of the options dict. Measured by the
+        // statistics pool so that reads aren't held up behind it.
+        [=](image_statistics_atom atom,
+            const ImageBufPtr &buf,
+            const utility::JsonStore &options) -> result<utility::JsonStore> {
+            if (current_sender() and current_sender()->node() != node())
+                return make_error(
+                    xstudio_error::error, "Image statistics can only be requested in process");
+            auto rp = make_response_promise<utility::JsonStore>();
+            rp.delegate(statistics_pool, atom, buf, options);
+            return rp;
+        },
+
+        // per class read counts, rates and latencies, the depth of the
+        // precache queue, the state of the read-ahead controller and the
+        // file prefetcher
+        [=](media_cache::stats_atom) -> JsonStore {
+            JsonStore result;
+            result["classes"] = ReadMetrics::instance().json();
+            result["queued"]  = {
+                {to_string(RP_PLAYBACK), precache_request_queue_.size(RP_PLAYBACK)},
+                {to_string(RP_BACKGROUND), precache_request_queue_.size(RP_BACKGROUND)}};
+            result["read_ahead"] = read_ahead_.json();
+            result["prefetch"]   = prefetcher_.json();
+            return result;
+        },
+
+        // frames the playhead should read ahead during playback, 0 until its
+        // sources have been measured
+        [=](read_ahead_atom, const Uuid &playhead_uuid) -> int {
+            return read_ahead_.plan(playhead_uuid).frames;
+        },
+
+        [=](media_cache::stats_atom, clear_atom) -> bool {
+            ReadMetrics::instance().clear();
+            return true;
+        },
+
         [=](get_future_frames_atom,
             const media::AVFrameIDsAndTimePoints &mptr_and_timepoints,
             const utility::Uuid & /*playhead_uuid*/
@@ -421,7 +571,7 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
             const utility::Uuid playhead_uuid,
             const utility::time_point &tp,
             const timebase::flicks playhead_position) {
-            mail(media_cache::retrieve_atom_v, mptr.key())
+            mail(media_cache::retrieve_atom_v, mptr.key(), playhead_uuid)
                 .request(image_cache_, infinite)
                 .then(
                     [=](const media_reader::ImageBufPtr &buf) mutable {
@@ -532,6 +682,11 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
             return mail(atom, mptr, size).delegate(thumbnail_reader_pool);
         },
 
+        // a reduced copy of a cached frame for the image cache's proxy tier
+        [=](proxy_atom atom, const ImageBufPtr &buf, const int level) {
+            return mail(atom, buf, level).delegate(proxy_pool);
+        },
+
         [=](json_store::update_atom,
             const JsonStore & /*change*/,
             const std::string & /*path*/,
@@ -544,6 +699,24 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
                 preference_value<size_t>(json, "/core/media_reader/max_source_count");
             max_source_age_ =
                 preference_value<size_t>(json, "/core/media_reader/max_source_age");
+            try {
+                read_ahead_.set_max_parallel_reads(
+                    preference_value<int>(json, "/core/media_reader/workers_per_source"));
+                update_read_ahead_plans();
+            } catch (const std::exception &err) {
+                spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
+            }
+            try {
+                prefetch_files_ =
+                    preference_value<size_t>(json, "/core/media_reader/prefetch_files");
+                prefetcher_.set_byte_budget(
+                    preference_value<size_t>(json, "/core/media_reader/prefetch_budget_mb") *
+                    1024 * 1024);
+                if (!prefetch_files_)
+                    prefetcher_.clear();
+            } catch (const std::exception &err) {
+                spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
+            }
             // mmm_->update_preferences(json);
             prune_readers();
         },
@@ -552,7 +725,7 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
             const media::AVFrameID &mptr,
             const utility::time_point &time,
             const Uuid &playhead_uuid) -> result<bool> {
-            playback_precache_request_queue_.add_frame_request(mptr, time, playhead_uuid);
+            precache_request_queue_.add_frame_request(mptr, time, playhead_uuid, RP_PLAYBACK);
             return true;
         },
 
@@ -565,6 +738,12 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
             // have those frames, and if not we need to queue read requests to
             // start reading/decoding those frames
             auto rp = make_response_promise<bool>();
+
+            // the spacing of the lookahead frames tells us how fast the
+            // playhead is consuming them
+            read_ahead_.set_lookahead(playhead_uuid, media_ptrs);
+            update_read_ahead_plans();
+
             if (mt == MT_IMAGE) {
                 mail(media_cache::preserve_atom_v, media_ptrs, playhead_uuid)
                     .request(image_cache_, std::chrono::seconds(1))
@@ -573,14 +752,15 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
                                 media_ptrs_not_in_image_cache) mutable {
                             if (media_ptrs_not_in_image_cache.size()) {
 
-                                // clear all pending requests
-                                playback_precache_request_queue_.clear_pending_requests(
-                                    playhead_uuid);
-                                background_precache_request_queue_.clear_pending_requests(
+                                // clear all pending requests, and stop reads
+                                // of frames that are no longer wanted
+                                precache_request_queue_.clear_pending_requests(
                                     playhead_uuid);
+                                cancel_stale_reads(playhead_uuid, media_ptrs);
 
-                                playback_precache_request_queue_.add_frame_requests(
-                                    media_ptrs_not_in_image_cache, playhead_uuid);
+                                precache_request_queue_.add_frame_requests(
+                                    media_ptrs_not_in_image_cache, playhead_uuid, RP_PLAYBACK);
+                                prefetch_files(playhead_uuid, media_ptrs_not_in_image_cache);
 
                                 if (media_ptrs.size())
                                     background_cached_ref_timepoint_[playhead_uuid] =
@@ -598,14 +778,14 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
                                 &media_ptrs_not_in_audio_cache) mutable {
                             if (media_ptrs_not_in_audio_cache.size()) {
 
-                                // clear all pending requests
-                                playback_precache_request_queue_.clear_pending_requests(
-                                    playhead_uuid);
-                                background_precache_request_queue_.clear_pending_requests(
+                                // clear all pending requests, and stop reads
+                                // of frames that are no longer wanted
+                                precache_request_queue_.clear_pending_requests(
                                     playhead_uuid);
+                                cancel_stale_reads(playhead_uuid, media_ptrs);
 
-                                playback_precache_request_queue_.add_frame_requests(
-                                    media_ptrs_not_in_audio_cache, playhead_uuid);
+                                precache_request_queue_.add_frame_requests(
+                                    media_ptrs_not_in_audio_cache, playhead_uuid, RP_PLAYBACK);
 
                                 if (media_ptrs.size())
                                     background_cached_ref_timepoint_[playhead_uuid] =
@@ -631,17 +811,19 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
             // We keep a note of the timepoint of the first frame in the request
             // queue - anything with an older time in the cache can be discarded
             // when the cache is full
+            read_ahead_.clear_playhead(playhead_uuid);
+            update_read_ahead_plans();
+
             if (mptrs.size()) {
                 mail(media_cache::unpreserve_atom_v, playhead_uuid)
                     .request(image_cache_, infinite)
                     .then(
                         [=](bool) mutable {
-                            background_precache_request_queue_.clear_pending_requests(
-                                playhead_uuid);
-                            playback_precache_request_queue_.clear_pending_requests(
-                                playhead_uuid);
-                            background_precache_request_queue_.add_frame_requests(
-                                mptrs, playhead_uuid);
+                            precache_request_queue_.clear_pending_requests(playhead_uuid);
+                            cancel_stale_reads(playhead_uuid, mptrs);
+                            precache_request_queue_.add_frame_requests(
+                                mptrs, playhead_uuid, RP_BACKGROUND);
+                            prefetch_files(playhead_uuid, mptrs);
                             background_cached_ref_timepoint_[playhead_uuid] =
                                 mptrs.front().first;
                             continue_precacheing();
@@ -649,7 +831,7 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
                         },
                         [=](const caf::error &err) mutable { rp.deliver(err); });
             } else {
-                background_precache_request_queue_.clear_pending_requests(playhead_uuid);
+                precache_request_queue_.clear_pending_requests(playhead_uuid, RP_BACKGROUND);
                 rp.deliver(false);
             }
             return rp;
@@ -657,6 +839,7 @@ GlobalMediaReaderActor::GlobalMediaReaderActor(
 
         [=](retire_readers_atom) {
             prune_readers();
+            read_ahead_.prune(utility::clock::now(), std::chrono::seconds(max_source_age_));
             anon_mail(retire_readers_atom_v)
                 .delay(std::chrono::seconds(max_source_age_))
                 .send(this);
@@ -793,23 +976,19 @@ void GlobalMediaReaderActor::do_precache() {
     // fast) before frames can actually be read, decoded and cached (because
     // reading frames is slow) - we would then be in a situation where the CAF
     // mailbox is full of requests to precache frames
-    std::optional<FrameRequest> fr = playback_precache_request_queue_.pop_request(
-        playheads_with_precache_requests_in_flight_);
+    //
+    // Playback read-ahead requests are popped before background requests.
+    std::optional<FrameRequest> fr = precache_request_queue_.pop_request(
+        playheads_with_precache_requests_in_flight_, max_reads_in_flight_);
 
-    // when putting new images in the cache, images older than this timepoint can
-    // be discarded
-    bool is_background_cache = false;
     if (not fr) {
-        fr = background_precache_request_queue_.pop_request(
-            playheads_with_precache_requests_in_flight_);
-
-
-        if (not fr) {
-            return; // global reader is saying pre-cache queue for this reader is empty
-        }
-        is_background_cache = true;
+        return; // global reader is saying pre-cache queue for this reader is empty
     }
 
+    // when putting new images in the cache, images older than this timepoint can
+    // be discarded
+    const bool is_background_cache = fr->priority_ == RP_BACKGROUND;
+
     const std::shared_ptr<const media::AVFrameID> mptr = fr->requested_frame_;
 
     const time_point &predicted_time   = fr->required_by_;
@@ -834,6 +1013,13 @@ void GlobalMediaReaderActor::do_precache() {
     caf::actor cache_actor =
         mptr->media_type() == media::MediaType::MT_IMAGE ? image_cache_ : audio_cache_;
     mark_playhead_waiting_for_precache_result(playhead_uuid);
+    in_flight_reads_[playhead_uuid][mptr->key()] = fr->cancel_token_;
+
+    // the read-ahead plan may allow the playhead more than one read at once
+    auto limit = max_reads_in_flight_.find(playhead_uuid);
+    if (limit != max_reads_in_flight_.end() &&
+        playheads_with_precache_requests_in_flight_[playhead_uuid] < limit->second)
+        continue_precacheing();
 
     mail(media_cache::preserve_atom_v, mptr->key(), predicted_time, playhead_uuid)
         .request(cache_actor, std::chrono::milliseconds(500))
@@ -842,6 +1028,7 @@ void GlobalMediaReaderActor::do_precache() {
             [=](const bool exists) mutable {
                 if (exists) {
                     // already have in the cache, but might still have work to do
+                    read_done(*fr);
                     mark_playhead_received_precache_result(playhead_uuid);
                     // if (is_background_cache) {
                     // keep_cache_hot(mptr.key(), predicted_time, playhead_uuid);
@@ -875,6 +1062,7 @@ void GlobalMediaReaderActor::do_precache() {
                                         }
                                     },
                                     [=](caf::error &err) {
+                                        read_done(*fr);
                                         mark_playhead_received_precache_result(playhead_uuid);
                                         continue_precacheing();
                                     });
@@ -910,6 +1098,7 @@ void GlobalMediaReaderActor::do_precache() {
                 }
             },
             [=](const caf::error &err) {
+                read_done(*fr);
                 mark_playhead_received_precache_result(playhead_uuid);
                 spdlog::warn(
                     "Failed preserve buffer {} {}", to_string(mptr->key()), to_string(err));
@@ -936,10 +1125,18 @@ void GlobalMediaReaderActor::read_and_cache_image(
     const time_point predicted_time                    = fr.required_by_;
     const utility::Uuid playhead_uuid                  = fr.requesting_playhead_uuid_;
 
-    mail(read_precache_image_atom_v, *mptr)
+    const auto started = utility::clock::now();
+
+    mail(read_precache_image_atom_v, *mptr, fr.cancel_token_)
         .request(reader, std::chrono::seconds(60))
         .then(
             [=](media_reader::ImageBufPtr buf) mutable {
+                read_done(fr);
+                read_ahead_.record_read(
+                    mptr->source_uuid(), started, utility::clock::now(), buf ? buf->size() : 0);
+                update_read_ahead_plans();
+                // the cache lists what it holds by frame for a warm start
+                buf.set_frame_id(*mptr);
                 // store the image in our cache. We use a different store message
                 // if background cacheing
                 if (is_background_cache) {
@@ -957,8 +1154,8 @@ void GlobalMediaReaderActor::read_and_cache_image(
 
                                 if (!stored) {
                                     // cache is full ... stop background cacheing
-                                    background_precache_request_queue_.clear_pending_requests(
-                                        playhead_uuid);
+                                    precache_request_queue_.clear_pending_requests(
+                                        playhead_uuid, RP_BACKGROUND);
                                 } else {
                                     // still might have work to do
                                     continue_precacheing();
@@ -980,9 +1177,7 @@ void GlobalMediaReaderActor::read_and_cache_image(
                             [=](const bool stored) {
                                 if (!stored) {
                                     // woops, cache is full. Stop pre-reading.
-                                    playback_precache_request_queue_.clear_pending_requests(
-                                        playhead_uuid);
-                                    background_precache_request_queue_.clear_pending_requests(
+                                    precache_request_queue_.clear_pending_requests(
                                         playhead_uuid);
                                 }
                                 mark_playhead_received_precache_result(playhead_uuid);
@@ -997,6 +1192,7 @@ void GlobalMediaReaderActor::read_and_cache_image(
                 }
             },
             [=](const caf::error &err) mutable {
+                read_done(fr);
                 mark_playhead_received_precache_result(playhead_uuid);
                 send_error_to_source(mptr->media_source_addr(), err);
                 // we might still have more work to do so keep going
@@ -1014,10 +1210,16 @@ void GlobalMediaReaderActor::read_and_cache_audio(
     const time_point predicted_time                    = fr.required_by_;
     const utility::Uuid playhead_uuid                  = fr.requesting_playhead_uuid_;
 
-    mail(read_precache_audio_atom_v, *mptr)
+    const auto started = utility::clock::now();
+
+    mail(read_precache_audio_atom_v, *mptr, fr.cancel_token_)
         .request(reader, std::chrono::seconds(60))
         .then(
             [=](media_reader::AudioBufPtr buf) mutable {
+                read_done(fr);
+                read_ahead_.record_read(
+                    mptr->source_uuid(), started, utility::clock::now(), buf ? buf->size() : 0);
+                update_read_ahead_plans();
                 // store the image in our cache
                 mail(
                     media_cache::store_atom_v,
@@ -1033,8 +1235,8 @@ void GlobalMediaReaderActor::read_and_cache_audio(
 
                             if (!stored && is_background_cache) {
                                 // cache is full ... stop background cacheing
-                                background_precache_request_queue_.clear_pending_requests(
-                                    playhead_uuid);
+                                precache_request_queue_.clear_pending_requests(
+                                    playhead_uuid, RP_BACKGROUND);
                             } else {
                                 continue_precacheing();
                                 if (is_background_cache) {
@@ -1049,6 +1251,7 @@ void GlobalMediaReaderActor::read_and_cache_audio(
                         });
             },
             [=](const caf::error &err) mutable {
+                read_done(fr);
                 mark_playhead_received_precache_result(playhead_uuid);
                 send_error_to_source(mptr->media_source_addr(), err);
                 // we might still have more work to do so keep going
@@ -1091,6 +1294,93 @@ void GlobalMediaReaderActor::mark_playhead_received_precache_result(
     }
 }
 
+void GlobalMediaReaderActor::cancel_stale_reads(
+    const utility::Uuid &playhead_uuid, const media::AVFrameIDsAndTimePoints &wanted) {
+
+    auto p = in_flight_reads_.find(playhead_uuid);
+    if (p == in_flight_reads_.end())
+        return;
+
+    std::set<media::MediaKey> wanted_keys;
+    for (const auto &i : wanted)
+        wanted_keys.insert(i.second->key());
+
+    for (const auto &i : p->second) {
+        if (!wanted_keys.count(i.first))
+            i.second.cancel();
+    }
+}
+
+void GlobalMediaReaderActor::read_done(const FrameRequest &fr) {
+    auto p = in_flight_reads_.find(fr.requesting_playhead_uuid_);
+    if (p != in_flight_reads_.end()) {
+        p->second.erase(fr.requested_frame_->key());
+        if (p->second.empty())
+            in_flight_reads_.erase(p);
+    }
+    if (prefetch_files_ && fr.requested_frame_->uri().scheme() == "file")
+        prefetcher_.consumed(uri_to_posix_path(fr.requested_frame_->uri()));
+}
+
+void GlobalMediaReaderActor::prefetch_files(
+    const utility::Uuid &playhead_uuid, const media::AVFrameIDsAndTimePoints &frames) {
+    if (!prefetch_files_)
+        return;
+
+    // the frames of a movie share one file, far too big to pull in whole, so
+    // only files that hold a single frame are prefetched
+    std::set<std::string> seen;
+    std::vector<std::string> paths;
+    for (const auto &i : frames) {
+        if (paths.size() == prefetch_files_)
+            break;
+        if (i.second->container() || i.second->uri().scheme() != "file")
+            continue;
+        auto path = uri_to_posix_path(i.second->uri());
+        if (seen.insert(path).second)
+            paths.push_back(std::move(path));
+    }
+    prefetcher_.prefetch(playhead_uuid, paths);
+}
+
+void GlobalMediaReaderActor::update_read_ahead_plans() {
+    max_reads_in_flight_ = read_ahead_.parallel_reads();
+}
+
+void GlobalMediaReaderActor::read_image_batch(const std::shared_ptr<ImageBatch> &batch) {
+
+    // a long range would otherwise start every read at once, holding up
+    // playback reads behind it
+    const auto max_reads = size_t(std::max(1, read_ahead_.max_parallel_reads()));
+
+    while (batch->next < batch->mptrs.size() and batch->pending < max_reads) {
+        const auto i = batch->next++;
+        batch->pending++;
+
+        auto done = [=](ImageBufPtr buf) mutable {
+            batch->results[i] = std::move(buf);
+            batch->pending--;
+            if (batch->next < batch->mptrs.size())
+                read_image_batch(batch);
+            else if (not batch->pending)
+                batch->rp.deliver(batch->results);
+        };
+
+        mail(
+            get_image_atom_v,
+            batch->mptrs[i],
+            false,
+            utility::Uuid(),
+            timebase::k_flicks_zero_seconds)
+            .request(caf::actor_cast<caf::actor>(this), infinite)
+            .then(
+                [=](const ImageBufPtr &buf) mutable { done(buf); },
+                [=](const caf::error &err) mutable {
+                    done(ImageBufPtr(new ImageBuffer(to_string(err))));
+                });
+    }
+}
+
 void GlobalMediaReaderActor::send_error_to_source(
     const caf::actor_addr &addr, const caf::error &err) {
     if (addr) {
@@ -1112,6 +1402,9 @@ void GlobalMediaReaderActor::send_error_to_source(
             case media_error::missing:
                 anon_mail(media_status_atom_v, MediaStatus::MS_MISSING).send(dest);
                 break;
+            case media_error::cancelled:
+                // a stale or preempted read, nothing wrong with the media
+                break;
             }
         }
     }
@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "xstudio/media_reader/read_ahead.hpp"
+
+using namespace xstudio;
+using namespace xstudio::media_reader;
+
+namespace {
+
+// smoothing of the latency and its mean deviation, as used for TCP round trip
+// time estimates
+const double latency_gain   = 0.125;
+const double deviation_gain = 0.25;
+
+// extra parallel reads and read-ahead over the bare estimate, to ride out
+// frames that are slower to decode than the average
+const double headroom = 1.5;
+
+double to_seconds(const utility::time_point::duration &d) {
+    return std::chrono::duration_cast<std::chrono::duration<double>>(d).count();
+}
+
+} // namespace
+
+void ReadAheadController::set_max_parallel_reads(const int max_parallel_reads) {
+    max_parallel_reads_ = std::max(1, max_parallel_reads);
+}
+
+void ReadAheadController::record_read(
+    const utility::Uuid &source_uuid,
+    const utility::time_point &started,
+    const utility::time_point &finished,
+    const size_t bytes) {
+
+    const double latency = to_seconds(finished - started);
+    if (latency <= 0.0)
+        return;
+
+    auto &s = sources_[source_uuid];
+    if (not s.reads) {
+        s.latency_s   = latency;
+        s.deviation_s = latency / 2.0;
+        s.bytes_per_s = double(bytes) / latency;
+    } else {
+        s.deviation_s += deviation_gain * (std::fabs(s.latency_s - latency) - s.deviation_s);
+        s.latency_s += latency_gain * (latency - s.latency_s);
+        s.bytes_per_s += latency_gain * (double(bytes) / latency - s.bytes_per_s);
+    }
+    s.reads++;
+    s.last_read = finished;
+}
+
+void ReadAheadController::set_lookahead(
+    const utility::Uuid &playhead_uuid, const media::AVFrameIDsAndTimePoints &lookahead) {
+
+    auto &p = playheads_[playhead_uuid];
+    p.sources.clear();
+    p.demand_fps = 0.0;
+
+    for (const auto &i : lookahead) {
+        if (i.second)
+            p.sources.insert(i.second->source_uuid());
+    }
+
+    if (lookahead.size() > 1) {
+        const double span = to_seconds(lookahead.back().first - lookahead.front().first);
+        if (span > 0.0)
+            p.demand_fps = double(lookahead.size() - 1) / span;
+    }
+}
+
+void ReadAheadController::clear_playhead(const utility::Uuid &playhead_uuid) {
+    playheads_.erase(playhead_uuid);
+}
+
+ReadAheadController::Plan ReadAheadController::plan(const utility::Uuid &playhead_uuid) const {
+    auto result = Plan();
+
+    auto p = playheads_.find(playhead_uuid);
+    if (p == playheads_.end())
+        return result;
+
+    result.demand_fps = p->second.demand_fps;
+
+    // plan for the slowest source the playhead is about to show
+    const SourceStats *slowest = nullptr;
+    for (const auto &uuid : p->second.sources) {
+        auto s = sources_.find(uuid);
+        if (s != sources_.end() and (not slowest or s->second.latency_s > slowest->latency_s))
+            slowest = &(s->second);
+    }
+
+    if (not slowest or result.demand_fps <= 0.0)
+        return result;
+
+    // reads that have to be in flight to deliver frames at the demanded rate
+    const double in_flight = result.demand_fps * slowest->latency_s * headroom;
+    result.parallel_reads =
+        std::clamp(int(std::ceil(in_flight)), 1, std::max(1, max_parallel_reads_));
+    result.throughput_fps = double(result.parallel_reads) / slowest->latency_s;
+
+    if (result.throughput_fps < result.demand_fps) {
+        // the readers can't keep up, read as far ahead as the playhead allows
+        // so the cache is as full as it can be when playback catches up
+        result.frames = std::numeric_limits<int>::max();
+    } else {
+        // cover a read that runs well over the average, plus the reads that
+        // are in flight
+        const double lead_s = slowest->latency_s + 4.0 * slowest->deviation_s;
+        result.frames =
+            int(std::ceil(result.demand_fps * lead_s * headroom)) + result.parallel_reads;
+    }
+
+    return result;
+}
+
+std::map<utility::Uuid, int> ReadAheadController::parallel_reads() const {
+    auto result = std::map<utility::Uuid, int>();
+    for (const auto &i : playheads_)
+        result[i.first] = plan(i.first).parallel_reads;
+    return result;
+}
+
+void ReadAheadController::prune(
+    const utility::time_point &now, const std::chrono::seconds max_age) {
+    for (auto p = sources_.begin(); p != sources_.end();) {
+        if (now - p->second.last_read > max_age)
+            p = sources_.erase(p);
+        else
+            ++p;
+    }
+}
+
+nlohmann::json ReadAheadController::json() const {
+    auto result                  = nlohmann::json::object();
+    result["max_parallel_reads"] = max_parallel_reads_;
+
+    auto playheads = nlohmann::json::object();
+    for (const auto &i : playheads_) {
+        const auto pl = plan(i.first);
+
+        // frames is -1 while the readers are falling behind and the playhead
+        // reads as far ahead as it is allowed to
+        auto p              = nlohmann::json::object();
+        p["frames"]         = pl.frames == std::numeric_limits<int>::max() ? -1 : pl.frames;
+        p["parallel_reads"] = pl.parallel_reads;
+        p["demand_fps"]     = pl.demand_fps;
+        p["throughput_fps"] = pl.throughput_fps;
+        p["sources"]        = i.second.sources.size();
+
+        playheads[to_string(i.first)] = p;
+    }
+    result["playheads"] = playheads;
+
+    auto sources = nlohmann::json::object();
+    for (const auto &i : sources_) {
+        auto s            = nlohmann::json::object();
+        s["latency_ms"]   = i.second.latency_s * 1000.0;
+        s["deviation_ms"] = i.second.deviation_s * 1000.0;
+        s["mb_per_s"]     = i.second.bytes_per_s / (1024.0 * 1024.0);
+        s["reads"]        = i.second.reads;
+
+        sources[to_string(i.first)] = s;
+    }
+    result["sources"] = sources;
+
+    return result;
+}
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "xstudio/media/media_error.hpp"
+#include "xstudio/media_reader/read_priority.hpp"
+
+using namespace xstudio;
+using namespace xstudio::media_reader;
+
+namespace {
+
+int64_t to_ns(const utility::time_point &tp) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch())
+        .count();
+}
+
+thread_local ReadCancelToken current_token;
+
+} // namespace
+
+const char *xstudio::media_reader::to_string(const ReadPriority priority) {
+    switch (priority) {
+    case RP_IMMEDIATE:
+        return "immediate";
+    case RP_PLAYBACK:
+        return "playback";
+    case RP_BACKGROUND:
+        return "background";
+    case RP_THUMBNAIL:
+        return "thumbnail";
+    default:
+        break;
+    }
+    return "unknown";
+}
+
+ReadCancelToken::ReadCancelToken(
+    const ReadPriority priority,
+    const utility::time_point &deadline,
+    const ReadCancelToken &parent)
+    : state_(std::make_shared<State>()) {
+    state_->priority = priority;
+    state_->deadline = deadline;
+    state_->parent   = parent.state_;
+}
+
+void ReadCancelToken::cancel() const {
+    if (state_)
+        state_->cancelled.store(true, std::memory_order_relaxed);
+}
+
+bool ReadCancelToken::cancelled() const {
+    for (auto s = state_.get(); s; s = s->parent.get()) {
+        if (s->cancelled.load(std::memory_order_relaxed))
+            return true;
+    }
+    return false;
+}
+
+const ReadCancelToken &ReadCancelToken::current() { return current_token; }
+
+void ReadCancelToken::throw_if_cancelled() {
+    if (current_token.cancelled())
+        throw media_cancelled_error("Read cancelled");
+}
+
+ReadCancelToken::Scope::Scope(const ReadCancelToken &token) : previous_(current_token) {
+    current_token = token;
+}
+
+ReadCancelToken::Scope::~Scope() { current_token = previous_; }
+
+ReadMetrics &ReadMetrics::instance() {
+    static ReadMetrics metrics;
+    return metrics;
+}
+
+ReadMetrics::ReadMetrics() : since_ns_(to_ns(utility::clock::now())) {}
+
+void ReadMetrics::record(
+    const ReadPriority priority,
+    const Outcome outcome,
+    const utility::time_point &queued,
+    const utility::time_point &started,
+    const utility::time_point &finished) {
+
+    if (priority < 0 || priority >= RP_COUNT)
+        return;
+
+    auto &m = classes_[priority];
+    m.outcomes[outcome].fetch_add(1, std::memory_order_relaxed);
+    m.wait.add(to_ns(started) - to_ns(queued));
+    m.read.add(to_ns(finished) - to_ns(started));
+}
+
+uint64_t ReadMetrics::count(const ReadPriority priority, const Outcome outcome) const {
+    return classes_[priority].outcomes[outcome].load(std::memory_order_relaxed);
+}
+
+nlohmann::json ReadMetrics::json() const {
+    const double seconds =
+        double(to_ns(utility::clock::now()) - since_ns_.load(std::memory_order_relaxed)) /
+        1e9;
+
+    auto result = nlohmann::json::object();
+    for (int i = 0; i < RP_COUNT; ++i) {
+        const auto priority  = static_cast<ReadPriority>(i);
+        const auto &m        = classes_[i];
+        const auto completed = count(priority, RO_COMPLETED);
+
+        auto c           = nlohmann::json::object();
+        c["completed"]   = completed;
+        c["failed"]      = count(priority, RO_FAILED);
+        c["cancelled"]   = count(priority, RO_CANCELLED);
+        c["preempted"]   = count(priority, RO_PREEMPTED);
+        c["reads_per_s"] = seconds > 0.0 ? double(completed) / seconds : 0.0;
+        c["queue_wait"]  = m.wait.json();
+        c["read_time"]   = m.read.json();
+
+        result[to_string(priority)] = c;
+    }
+    return result;
+}
+
+void ReadMetrics::clear() {
+    for (auto &m : classes_) {
+        for (auto &o : m.outcomes)
+            o.store(0, std::memory_order_relaxed);
+        m.wait.clear();
+        m.read.clear();
+    }
+    since_ns_.store(to_ns(utility::clock::now()), std::memory_order_relaxed);
+}
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "xstudio/media_reader/file_prefetcher.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::media_reader;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const size_t kb = 1024;
+
+class FilePrefetcherTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        dir_ = fs::temp_directory_path() / ("file_prefetcher_" + to_string(Uuid::generate()));
+        fs::create_directories(dir_);
+    }
+
+    void TearDown() override { fs::remove_all(dir_); }
+
+    std::vector<std::string>
+    make_files(const int count, const size_t size, const std::string &name = "frame") {
+        std::vector<std::string> result;
+        for (int i = 0; i < count; ++i) {
+            const auto path = (dir_ / fmt::format("{}.{:04d}.exr", name, i)).string();
+            std::ofstream out(path, std::ios::binary);
+            out << std::string(size, 'x');
+            result.push_back(path);
+        }
+        return result;
+    }
+
+    fs::path dir_;
+};
+
+// the prefetcher works on its own threads, wait for it to get somewhere
+template <typename F> bool eventually(F done) {
+    for (int i = 0; i < 500; ++i) {
+        if (done())
+            return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return done();
+}
+
+} // namespace
+
+TEST_F(FilePrefetcherTest, Prefetch) {
+    FilePrefetcher prefetcher(2);
+    const auto ph    = Uuid::generate();
+    const auto files = make_files(3, 64 * kb);
+
+    prefetcher.prefetch(ph, files);
+    EXPECT_TRUE(eventually([&]() { return prefetcher.json()["files"] == 3; }));
+    EXPECT_EQ(prefetcher.outstanding_bytes(), 3 * 64 * kb);
+
+    // the decoder has read one of them
+    prefetcher.consumed(files[0]);
+    EXPECT_EQ(prefetcher.outstanding_bytes(), 2 * 64 * kb);
+
+    // asking again doesn't read them again
+    prefetcher.prefetch(ph, {files[1], files[2]});
+    EXPECT_EQ(prefetcher.json()["queued"], 0);
+
+    // missing files fail quietly
+    prefetcher.prefetch(ph, {(dir_ / "missing.exr").string()});
+    EXPECT_TRUE(eventually([&]() { return prefetcher.json()["failed"] == 1; }));
+
+    // the playhead jumped elsewhere
+    prefetcher.cancel(ph);
+    EXPECT_EQ(prefetcher.outstanding_bytes(), size_t(0));
+}
+
+TEST_F(FilePrefetcherTest, ByteBudget) {
+    FilePrefetcher prefetcher(2, 400 * kb);
+    const auto ph    = Uuid::generate();
+    const auto files = make_files(6, 100 * kb);
+
+    prefetcher.prefetch(ph, files);
+    EXPECT_TRUE(eventually([&]() { return prefetcher.json()["files"] == 4; }));
+
+    // no more until decoders catch up
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    const auto stats = prefetcher.json();
+    EXPECT_EQ(stats["files"], 4);
+    EXPECT_EQ(stats["queued"].get<int>() + stats["running"].get<int>(), 2);
+    EXPECT_LE(prefetcher.outstanding_bytes(), 400 * kb);
+
+    prefetcher.consumed(files[0]);
+    prefetcher.consumed(files[1]);
+    EXPECT_TRUE(eventually([&]() { return prefetcher.json()["files"] == 6; }));
+    EXPECT_EQ(prefetcher.outstanding_bytes(), 4 * 100 * kb);
+
+    // anything bigger than a quarter of the budget isn't a frame
+    const auto movie = make_files(1, 200 * kb, "movie");
+    prefetcher.clear();
+    prefetcher.prefetch(ph, movie);
+    EXPECT_TRUE(eventually([&]() { return prefetcher.json()["skipped"] == 1; }));
+    EXPECT_EQ(prefetcher.outstanding_bytes(), size_t(0));
+}
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include "xstudio/media/media_error.hpp"
+#include "xstudio/media_reader/frame_request_queue.hpp"
+#include "xstudio/media_reader/read_priority.hpp"
+#include "xstudio/utility/helpers.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::media_reader;
+
+namespace {
+
+media::AVFrameID frame(const int f) {
+    return media::AVFrameID(*caf::make_uri("file:///tmp/test.exr"), f);
+}
+
+} // namespace
+
+TEST(FrameRequestQueueTest, PriorityOrder) {
+    FrameRequestQueue queue;
+    const auto now = clock::now();
+    const auto ph  = Uuid::generate();
+
+    queue.add_frame_request(frame(1), now, ph, RP_BACKGROUND);
+    queue.add_frame_request(frame(2), now + std::chrono::seconds(2), ph, RP_PLAYBACK);
+    queue.add_frame_request(frame(3), now + std::chrono::seconds(1), ph, RP_PLAYBACK);
+    EXPECT_EQ(queue.size(), size_t(3));
+    EXPECT_EQ(queue.size(RP_PLAYBACK), size_t(2));
+
+    // class first, then deadline
+    auto fr = queue.pop_request({});
+    ASSERT_TRUE(fr);
+    EXPECT_EQ(fr->requested_frame_->frame(), 3);
+    EXPECT_EQ(fr->priority_, RP_PLAYBACK);
+    EXPECT_TRUE(fr->cancel_token_);
+    EXPECT_FALSE(fr->cancel_token_.cancelled());
+    EXPECT_EQ(fr->cancel_token_.priority(), RP_PLAYBACK);
+
+    EXPECT_EQ(queue.pop_request({})->requested_frame_->frame(), 2);
+    EXPECT_EQ(queue.pop_request({})->requested_frame_->frame(), 1);
+    EXPECT_FALSE(queue.pop_request({}));
+
+    // a repeated request is promoted to the more urgent class
+    queue.add_frame_request(frame(4), now, ph, RP_BACKGROUND);
+    queue.add_frame_request(frame(5), now, ph, RP_PLAYBACK);
+    queue.add_frame_request(frame(4), now, ph, RP_IMMEDIATE);
+    EXPECT_EQ(queue.size(), size_t(2));
+    EXPECT_EQ(queue.pop_request({})->requested_frame_->frame(), 4);
+
+    // playheads with reads in flight are skipped
+    const auto other = Uuid::generate();
+    queue.add_frame_request(frame(6), now, other, RP_BACKGROUND);
+    EXPECT_EQ(queue.pop_request({{ph, 1}})->requested_frame_->frame(), 6);
+
+    // unless they are allowed more than one read at a time
+    EXPECT_FALSE(queue.pop_request({{ph, 2}}, {{ph, 2}}));
+    EXPECT_EQ(queue.pop_request({{ph, 1}}, {{ph, 2}})->requested_frame_->frame(), 5);
+}
+
+TEST(FrameRequestQueueTest, ClearByClass) {
+    FrameRequestQueue queue;
+    const auto now = clock::now();
+    const auto ph  = Uuid::generate();
+
+    queue.add_frame_request(frame(1), now, ph, RP_BACKGROUND);
+    queue.add_frame_request(frame(2), now, ph, RP_PLAYBACK);
+    queue.add_frame_request(frame(3), now, Uuid::generate(), RP_BACKGROUND);
+
+    queue.clear_pending_requests(ph, RP_BACKGROUND);
+    EXPECT_EQ(queue.size(), size_t(2));
+    EXPECT_EQ(queue.size(RP_BACKGROUND), size_t(1));
+
+    queue.clear_pending_requests(ph);
+    EXPECT_EQ(queue.size(), size_t(1));
+}
+
+TEST(ReadCancelTokenTest, Cancel) {
+    ReadCancelToken empty;
+    EXPECT_FALSE(empty);
+    EXPECT_FALSE(empty.cancelled());
+    empty.cancel();
+
+    const auto deadline = clock::now();
+    ReadCancelToken parent(RP_BACKGROUND, deadline);
+    ReadCancelToken child(parent.priority(), parent.deadline(), parent);
+    ReadCancelToken copy = child;
+    EXPECT_EQ(child.priority(), RP_BACKGROUND);
+    EXPECT_EQ(child.deadline(), deadline);
+
+    // cancelling a child leaves the parent alone
+    child.cancel();
+    EXPECT_TRUE(copy.cancelled());
+    EXPECT_FALSE(parent.cancelled());
+
+    ReadCancelToken child2(RP_BACKGROUND, deadline, parent);
+    parent.cancel();
+    EXPECT_TRUE(child2.cancelled());
+
+    EXPECT_NO_THROW(ReadCancelToken::throw_if_cancelled());
+    {
+        ReadCancelToken::Scope scope(child2);
+        EXPECT_TRUE(ReadCancelToken::current().cancelled());
+        EXPECT_THROW(ReadCancelToken::throw_if_cancelled(), media_cancelled_error);
+    }
+    EXPECT_FALSE(ReadCancelToken::current());
+}
+
+TEST(ReadMetricsTest, Record) {
+    auto &metrics = ReadMetrics::instance();
+    metrics.clear();
+
+    const auto queued = clock::now();
+    metrics.record(
+        RP_PLAYBACK,
+        ReadMetrics::RO_COMPLETED,
+        queued,
+        queued + std::chrono::milliseconds(2),
+        queued + std::chrono::milliseconds(12));
+    metrics.record(RP_PLAYBACK, ReadMetrics::RO_PREEMPTED, queued, queued, queued);
+    metrics.record(RP_THUMBNAIL, ReadMetrics::RO_FAILED, queued, queued, queued);
+
+    EXPECT_EQ(metrics.count(RP_PLAYBACK), uint64_t(1));
+    EXPECT_EQ(metrics.count(RP_PLAYBACK, ReadMetrics::RO_PREEMPTED), uint64_t(1));
+    EXPECT_EQ(metrics.count(RP_IMMEDIATE), uint64_t(0));
+
+    const auto jsn = metrics.json();
+    EXPECT_EQ(jsn["playback"]["completed"], 1);
+    EXPECT_EQ(jsn["playback"]["read_time"]["count"], 2);
+    EXPECT_DOUBLE_EQ(jsn["playback"]["read_time"]["max_us"].get<double>(), 10000.0);
+    EXPECT_EQ(jsn["thumbnail"]["failed"], 1);
+
+    metrics.clear();
+    EXPECT_EQ(metrics.count(RP_PLAYBACK), uint64_t(0));
+}
@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <cstring>
+#include <gtest/gtest.h>
+
+#include <Imath/half.h>
+
+#include "xstudio/media_reader/image_proxy.hpp"
+#include "xstudio/media_reader/pixel_layout.hpp"
+#include "xstudio/utility/helpers.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::media_reader;
+
+namespace {
+
+// packed 8 bit RGBA, value of each channel from its position
+ImageBufPtr make_rgba8(const int width, const int height) {
+    JsonStore jsn;
+    jsn["rgb"]                  = 4;
+    jsn["bits_per_channel"]     = 8;
+    jsn["frame_width_pixels"]   = width;
+    jsn["y_linesize"]           = width * 4;
+    jsn["u_linesize"]           = 0;
+    jsn["v_linesize"]           = 0;
+    jsn["a_linesize"]           = 0;
+    jsn["y_plane_bytes_offset"] = 0;
+
+    ImageBufPtr buf(new ImageBuffer(Uuid(), jsn));
+    auto *p = reinterpret_cast<uint8_t *>(buf->allocate(width * height * 4));
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+            for (int c = 0; c < 4; ++c)
+                p[(y * width + x) * 4 + c] = uint8_t((x * 3 + y * 5 + c * 7) & 0xff);
+    buf->set_image_dimensions(Imath::V2i(width, height));
+    buf->set_media_key(media::MediaKey("proxy_test"));
+    return buf;
+}
+
+uint8_t rgba8(const ImageBufPtr &buf, const int x, const int y, const int c) {
+    const auto planes = pixel_layout(*buf);
+    const auto *p     = reinterpret_cast<const uint8_t *>(buf->buffer());
+    return p[planes[0].offset + y * planes[0].strides[0] + x * 4 + c];
+}
+
+} // namespace
+
+TEST(ImageProxyTest, Levels) {
+    // odd sizes, so the last row and column of each level are repeated
+    auto buf     = make_rgba8(517, 291);
+    auto proxies = make_image_proxies(*buf);
+    ASSERT_EQ(proxies.size(), size_t(3));
+
+    EXPECT_EQ(proxies[0]->image_size_in_pixels(), Imath::V2i(259, 146));
+    EXPECT_EQ(proxies[1]->image_size_in_pixels(), Imath::V2i(130, 73));
+    EXPECT_EQ(proxies[2]->image_size_in_pixels(), Imath::V2i(65, 37));
+
+    for (size_t i = 0; i < proxies.size(); ++i) {
+        EXPECT_EQ(proxies[i]->proxy_level(), int(i) + 1);
+        EXPECT_EQ(proxies[i]->source_size_in_pixels(), Imath::V2i(517, 291));
+        EXPECT_TRUE(proxies[i]->media_key() == buf->media_key());
+        EXPECT_EQ(
+            proxies[i]->shader_params().value("frame_width_pixels", 0),
+            proxies[i]->image_size_in_pixels().x);
+    }
+
+    // each level is the rounded average of 2x2 blocks of the one above
+    const auto &level1 = proxies[0];
+    for (const auto &[x, y] : std::vector<std::pair<int, int>>{{0, 0}, {7, 3}, {258, 145}}) {
+        const int x1 = std::min(x * 2 + 1, 516);
+        const int y1 = std::min(y * 2 + 1, 290);
+        for (int c = 0; c < 4; ++c) {
+            const int sum = rgba8(buf, x * 2, y * 2, c) + rgba8(buf, x1, y * 2, c) +
+                            rgba8(buf, x * 2, y1, c) + rgba8(buf, x1, y1, c);
+            EXPECT_EQ(rgba8(level1, x, y, c), (sum + 2) / 4) << x << " " << y << " " << c;
+        }
+    }
+
+    EXPECT_EQ(make_image_proxies(*buf, 1).size(), size_t(1));
+
+    // not worth it for tiny frames
+    EXPECT_TRUE(make_image_proxies(*make_rgba8(40, 20)).empty());
+}
+
+TEST(ImageProxyTest, OpenEXR) {
+    // half RGBA data window starting at an odd pixel
+    JsonStore jsn;
+    jsn["num_channels"]    = 4;
+    jsn["pix_type_r"]      = 1;
+    jsn["pix_type_g"]      = 1;
+    jsn["pix_type_b"]      = 1;
+    jsn["pix_type_a"]      = 1;
+    jsn["bytes_per_pixel"] = 8;
+
+    ImageBuffer buf(Uuid(), jsn);
+    auto *p = reinterpret_cast<half *>(buf.allocate(128 * 64 * 8));
+    for (int i = 0; i < 128 * 64 * 4; ++i)
+        p[i] = half(float(i % 5));
+    buf.set_image_dimensions(
+        Imath::V2i(256, 128), Imath::Box2i(Imath::V2i(-3, 5), Imath::V2i(125, 69)));
+
+    const auto proxies = make_image_proxies(buf, 1);
+    ASSERT_EQ(proxies.size(), size_t(1));
+    const auto bounds = proxies[0]->image_pixels_bounding_box();
+    EXPECT_EQ(bounds.min, Imath::V2i(-2, 2));
+    EXPECT_EQ(bounds.max - bounds.min, Imath::V2i(64, 32));
+
+    const auto planes = pixel_layout(*proxies[0]);
+    ASSERT_EQ(planes.size(), size_t(1));
+    EXPECT_EQ(planes[0].format, "e");
+    EXPECT_EQ(planes[0].strides[0], size_t(64 * 8));
+
+    // pixel (1, 1) from source pixels (2, 2), (3, 2), (2, 3) and (3, 3)
+    const auto *q = reinterpret_cast<const half *>(proxies[0]->buffer());
+    float sum     = 0.0f;
+    for (const int row : {2, 3})
+        for (const int col : {2, 3})
+            sum += float(p[(row * 128 + col) * 4 + 1]);
+    EXPECT_FLOAT_EQ(float(q[(64 + 1) * 4 + 1]), sum / 4.0f);
+}
+
+TEST(ImageProxyTest, PlanarYUV) {
+    // 8 bit 4:2:0 with padded lines
+    JsonStore jsn;
+    jsn["rgb"]                  = 0;
+    jsn["bits_per_channel"]     = 8;
+    jsn["half_scale_uvx"]       = 1;
+    jsn["half_scale_uvy"]       = 1;
+    jsn["frame_width_pixels"]   = 150;
+    jsn["y_linesize"]           = 160;
+    jsn["u_linesize"]           = 80;
+    jsn["v_linesize"]           = 80;
+    jsn["a_linesize"]           = 0;
+    jsn["y_plane_bytes_offset"] = 0;
+    jsn["u_plane_bytes_offset"] = 160 * 90;
+    jsn["v_plane_bytes_offset"] = 160 * 90 + 80 * 45;
+    jsn["a_plane_bytes_offset"] = 0;
+
+    ImageBuffer buf(Uuid(), jsn);
+    auto *p = reinterpret_cast<uint8_t *>(buf.allocate(160 * 90 + 80 * 45 * 2));
+    std::memset(p, 16, 160 * 90);
+    std::memset(p + 160 * 90, 128, 80 * 45 * 2);
+    buf.set_image_dimensions(Imath::V2i(150, 90));
+
+    const auto proxies = make_image_proxies(buf, 1);
+    ASSERT_EQ(proxies.size(), size_t(1));
+
+    const auto planes = pixel_layout(*proxies[0]);
+    ASSERT_EQ(planes.size(), size_t(3));
+    EXPECT_EQ(planes[0].shape, (std::array<size_t, 3>{45, 75, 1}));
+    EXPECT_EQ(planes[1].shape, (std::array<size_t, 3>{23, 38, 1}));
+    EXPECT_EQ(planes[0].strides[0] % 32, size_t(0));
+
+    const auto *q = reinterpret_cast<const uint8_t *>(proxies[0]->buffer());
+    EXPECT_EQ(q[planes[0].offset + 44 * planes[0].strides[0] + 74], 16);
+    EXPECT_EQ(q[planes[2].offset + 22 * planes[2].strides[0] + 37], 128);
+}
+
+TEST(ImageProxyTest, Unsupported) {
+    // mixed EXR channel types have no per channel layout
+    JsonStore jsn;
+    jsn["pix_type_r"]      = 1;
+    jsn["pix_type_g"]      = 1;
+    jsn["pix_type_b"]      = 1;
+    jsn["pix_type_a"]      = 2;
+    jsn["bytes_per_pixel"] = 10;
+
+    ImageBuffer buf(Uuid(), jsn);
+    buf.allocate(128 * 64 * 10);
+    buf.set_image_dimensions(Imath::V2i(128, 64));
+    EXPECT_TRUE(make_image_proxies(buf).empty());
+
+    EXPECT_TRUE(make_image_proxies(ImageBuffer()).empty());
+}
+
+TEST(ImageProxyTest, ProxyLevelFor) {
+    EXPECT_EQ(proxy_level_for(4096, 4096.0f), 0);
+    EXPECT_EQ(proxy_level_for(4096, 2049.0f), 0);
+    EXPECT_EQ(proxy_level_for(4096, 2048.0f), 1);
+    EXPECT_EQ(proxy_level_for(4096, 1000.0f), 2);
+    EXPECT_EQ(proxy_level_for(4096, 10.0f), max_proxy_level);
+    EXPECT_EQ(proxy_level_for(4096, 0.0f), 0);
+}
+
+TEST(ImageProxyTest, WithProxy) {
+    auto frame = make_rgba8(128, 64);
+    frame.set_timline_timestamp(timebase::flicks(1000));
+    const auto proxies = make_image_proxies(*frame, 1);
+    ASSERT_EQ(proxies.size(), size_t(1));
+
+    const auto swapped = with_proxy(frame, proxies[0]);
+    EXPECT_EQ(swapped.get(), proxies[0].get());
+    EXPECT_EQ(swapped.timeline_timestamp(), timebase::flicks(1000));
+}
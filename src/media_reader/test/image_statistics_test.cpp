@@ -0,0 +1,252 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include <Imath/half.h>
+
+#include "xstudio/media_reader/image_statistics.hpp"
+#include "xstudio/utility/helpers.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::media_reader;
+
+TEST(ImageStatisticsTest, HalfRGBA) {
+    // 8 x 4 data window of half RGBA, r ramps across, g down
+    JsonStore jsn;
+    jsn["num_channels"]    = 4;
+    jsn["pix_type_r"]      = 1;
+    jsn["pix_type_g"]      = 1;
+    jsn["pix_type_b"]      = 1;
+    jsn["pix_type_a"]      = 1;
+    jsn["bytes_per_pixel"] = 8;
+
+    ImageBuffer buf(Uuid(), jsn);
+    auto *pix = reinterpret_cast<half *>(buf.allocate(8 * 4 * 8));
+    buf.set_image_dimensions(
+        Imath::V2i(16, 8), Imath::Box2i(Imath::V2i(2, 2), Imath::V2i(10, 6)));
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 8; ++x, pix += 4) {
+            pix[0] = float(x) / 8.0f;
+            pix[1] = float(y) / 4.0f;
+            pix[2] = 0.5f;
+            pix[3] = 1.0f;
+        }
+    }
+
+    StatisticsOptions options;
+    options.histogram_bins = 8;
+    auto stats             = image_statistics(buf, options);
+    EXPECT_EQ(stats.pixel_count, size_t(32));
+    EXPECT_EQ(stats.min[0], 0.0f);
+    EXPECT_EQ(stats.max[0], 0.875f);
+    EXPECT_DOUBLE_EQ(stats.mean[0], 0.4375);
+    EXPECT_DOUBLE_EQ(stats.mean[1], 0.375);
+    EXPECT_DOUBLE_EQ(stats.mean[2], 0.5);
+    EXPECT_EQ(stats.histograms[0], std::vector<uint32_t>(8, 4));
+    // alpha of 1.0 is at the top of the range
+    EXPECT_EQ(stats.histograms[3][7], uint32_t(32));
+
+    // region is in image coordinates and clipped to the data window
+    options.region = Imath::Box2i(Imath::V2i(4, 3), Imath::V2i(100, 100));
+    stats          = image_statistics(buf, options);
+    EXPECT_EQ(stats.region, Imath::Box2i(Imath::V2i(4, 3), Imath::V2i(10, 6)));
+    EXPECT_EQ(stats.pixel_count, size_t(18));
+    EXPECT_EQ(stats.min[0], 0.25f);
+    EXPECT_EQ(stats.min[1], 0.25f);
+
+    const auto jsn_stats = stats.json();
+    EXPECT_EQ(jsn_stats["pixel_count"], 18);
+    EXPECT_EQ(jsn_stats["histograms"]["r"].size(), size_t(8));
+    EXPECT_FALSE(jsn_stats.contains("waveform"));
+
+    // outside the data window
+    options.region = Imath::Box2i(Imath::V2i(20, 20), Imath::V2i(30, 30));
+    EXPECT_EQ(image_statistics(buf, options).pixel_count, size_t(0));
+}
+
+TEST(ImageStatisticsTest, UintChannel) {
+    // a single uint channel, e.g. an object id, is measured as its values
+    JsonStore jsn;
+    jsn["num_channels"]    = 1;
+    jsn["pix_type_r"]      = 0;
+    jsn["bytes_per_pixel"] = 4;
+
+    ImageBuffer buf(Uuid(), jsn);
+    auto *pix = reinterpret_cast<uint32_t *>(buf.allocate(4 * 2 * 4));
+    buf.set_image_dimensions(Imath::V2i(4, 2));
+    for (uint32_t i = 0; i < 8; ++i)
+        pix[i] = i * 100;
+
+    StatisticsOptions options;
+    options.range_max = 800.0f;
+    const auto stats  = image_statistics(buf, options);
+    EXPECT_EQ(stats.pixel_count, size_t(8));
+    EXPECT_EQ(stats.min[0], 0.0f);
+    EXPECT_EQ(stats.max[0], 700.0f);
+    EXPECT_DOUBLE_EQ(stats.mean[0], 350.0);
+    EXPECT_EQ(stats.max[3], 1.0f);
+}
+
+TEST(ImageStatisticsTest, NonFinite) {
+    // float RGBA with a NaN pixel and an infinite red value
+    JsonStore jsn;
+    jsn["num_channels"]    = 4;
+    jsn["pix_type_r"]      = 2;
+    jsn["pix_type_g"]      = 2;
+    jsn["pix_type_b"]      = 2;
+    jsn["pix_type_a"]      = 2;
+    jsn["bytes_per_pixel"] = 16;
+
+    ImageBuffer buf(Uuid(), jsn);
+    auto *pix = reinterpret_cast<float *>(buf.allocate(16 * 4 * 2));
+    buf.set_image_dimensions(Imath::V2i(4, 2));
+    for (int i = 0; i < 8; ++i, pix += 4) {
+        pix[0] = 0.25f;
+        pix[1] = 0.5f;
+        pix[2] = float(i) / 8.0f;
+        pix[3] = 1.0f;
+        if (i == 3)
+            std::fill(pix, pix + 4, std::numeric_limits<float>::quiet_NaN());
+        if (i == 6)
+            pix[0] = std::numeric_limits<float>::infinity();
+    }
+
+    StatisticsOptions options;
+    options.histogram_bins = 4;
+    const auto stats       = image_statistics(buf, options);
+    EXPECT_EQ(stats.pixel_count, size_t(8));
+
+    // NaN and infinite values are left out of the means
+    EXPECT_DOUBLE_EQ(stats.mean[0], 0.25);
+    EXPECT_DOUBLE_EQ(stats.mean[1], 0.5);
+    EXPECT_DOUBLE_EQ(stats.mean[2], (0.0 + 1 + 2 + 4 + 5 + 6 + 7) / 8.0 / 7.0);
+    EXPECT_DOUBLE_EQ(stats.mean[3], 1.0);
+    EXPECT_FALSE(std::isnan(stats.min[1]));
+    EXPECT_EQ(stats.min[2], 0.0f);
+    EXPECT_EQ(stats.max[2], 0.875f);
+
+    // nor are NaN values binned
+    EXPECT_EQ(stats.histograms[1][2], uint32_t(7));
+}
+
+TEST(ImageStatisticsTest, PlanarYUV) {
+    // 8 bit 4:2:0, 4 x 2 mid grey
+    JsonStore jsn;
+    jsn["rgb"]                  = 0;
+    jsn["bits_per_channel"]     = 8;
+    jsn["norm_coeff"]           = 1.0f / 255.0f;
+    jsn["half_scale_uvx"]       = 1;
+    jsn["half_scale_uvy"]       = 1;
+    jsn["y_linesize"]           = 4;
+    jsn["u_linesize"]           = 2;
+    jsn["v_linesize"]           = 2;
+    jsn["a_linesize"]           = 0;
+    jsn["y_plane_bytes_offset"] = 0;
+    jsn["u_plane_bytes_offset"] = 8;
+    jsn["v_plane_bytes_offset"] = 10;
+    jsn["a_plane_bytes_offset"] = 0;
+    jsn["yuv_offsets"]          = {"ivec3", 1, 0, 128, 128};
+    // Rec.601, full range
+    jsn["yuv_conv"] =
+        Imath::M33f(1.0f, 1.0f, 1.0f, 0.0f, -0.344f, 1.772f, 1.402f, -0.714f, 0.0f);
+
+    ImageBuffer buf(Uuid(), jsn);
+    auto *data = reinterpret_cast<uint8_t *>(buf.allocate(12));
+    std::fill(data, data + 12, 128);
+    buf.set_image_dimensions(Imath::V2i(4, 2));
+
+    StatisticsOptions options;
+    options.waveform_columns = 2;
+    options.waveform_rows    = 4;
+    options.vectorscope_size = 4;
+
+    const auto stats = image_statistics(buf, options);
+    EXPECT_EQ(stats.pixel_count, size_t(8));
+    for (size_t c = 0; c < 3; ++c) {
+        EXPECT_NEAR(stats.min[c], 128.0f / 255.0f, 1e-6);
+        EXPECT_NEAR(stats.max[c], 128.0f / 255.0f, 1e-6);
+    }
+    EXPECT_EQ(stats.max[3], 1.0f);
+
+    // each column holds 4 pixels of luma in bin 2
+    EXPECT_EQ(stats.waveform, std::vector<uint32_t>({0, 0, 4, 0, 0, 0, 4, 0}));
+    // no chroma, so everything is at the centre
+    EXPECT_EQ(stats.vectorscope[2 * 4 + 2], uint32_t(8));
+
+    const auto jsn_stats = stats.json();
+    EXPECT_EQ(jsn_stats["waveform"]["columns"], 2);
+    EXPECT_EQ(jsn_stats["vectorscope"]["data"].size(), size_t(16));
+}
+
+TEST(ImageStatisticsTest, Threads) {
+    // packed 8 bit RGBA with padded lines
+    const int width = 37, height = 203, linesize = 160;
+    JsonStore jsn;
+    jsn["rgb"]                  = 4;
+    jsn["y_linesize"]           = linesize;
+    jsn["y_plane_bytes_offset"] = 0;
+
+    ImageBuffer buf(Uuid(), jsn);
+    auto *data = reinterpret_cast<uint8_t *>(buf.allocate(linesize * height));
+    buf.set_image_dimensions(Imath::V2i(width, height));
+    std::mt19937 gen(42);
+    for (int i = 0; i < linesize * height; ++i)
+        data[i] = uint8_t(gen());
+
+    StatisticsOptions options;
+    options.waveform_columns = 10;
+    options.vectorscope_size = 16;
+    options.num_threads      = 1;
+    const auto single        = image_statistics(buf, options);
+    options.num_threads      = 8;
+    const auto multi         = image_statistics(buf, options);
+
+    EXPECT_EQ(single.pixel_count, size_t(width * height));
+    EXPECT_EQ(single.min, multi.min);
+    EXPECT_EQ(single.max, multi.max);
+    for (size_t c = 0; c < 4; ++c) {
+        EXPECT_NEAR(single.mean[c], multi.mean[c], 1e-9);
+        EXPECT_EQ(single.histograms[c], multi.histograms[c]);
+    }
+    EXPECT_EQ(single.waveform, multi.waveform);
+    EXPECT_EQ(single.vectorscope, multi.vectorscope);
+
+    // check against a straight scalar pass over the pixels
+    double sum = 0.0;
+    int max    = 0;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            sum += data[y * linesize + x * 4 + 2];
+            max = std::max(max, int(data[y * linesize + x * 4 + 2]));
+        }
+    }
+    EXPECT_NEAR(single.mean[2], sum / 255.0 / (width * height), 1e-6);
+    EXPECT_FLOAT_EQ(single.max[2], float(max) / 255.0f);
+}
+
+TEST(ImageStatisticsTest, ScanlineFallback) {
+    // a layout we don't know, decoded by the reader
+    ImageBuffer buf;
+    buf.allocate(64);
+    buf.set_image_dimensions(Imath::V2i(4, 4));
+    buf.set_scanline_unpack_func([](const ImageBuffer &, const int line, float *rgba) {
+        for (int x = 0; x < 4; ++x, rgba += 4) {
+            rgba[0] = rgba[1] = rgba[2] = float(line);
+            rgba[3]                     = 1.0f;
+        }
+    });
+
+    StatisticsOptions options(JsonStore(nlohmann::json{{"region", {1, 1, 3, 4}}}));
+    const auto stats = image_statistics(buf, options);
+    EXPECT_EQ(stats.pixel_count, size_t(6));
+    EXPECT_EQ(stats.min[0], 1.0f);
+    EXPECT_EQ(stats.max[0], 3.0f);
+    EXPECT_DOUBLE_EQ(stats.mean[0], 2.0);
+
+    // nothing decoded
+    EXPECT_EQ(image_statistics(ImageBuffer()).pixel_count, size_t(0));
+}
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include "xstudio/media_reader/pixel_layout.hpp"
+#include "xstudio/utility/helpers.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::media_reader;
+
+TEST(PixelLayoutTest, OpenEXR) {
+    // 8 x 4 data window of half RGBA
+    JsonStore jsn;
+    jsn["num_channels"]    = 4;
+    jsn["pix_type_r"]      = 1;
+    jsn["pix_type_g"]      = 1;
+    jsn["pix_type_b"]      = 1;
+    jsn["pix_type_a"]      = 1;
+    jsn["bytes_per_pixel"] = 8;
+
+    ImageBuffer buf(Uuid(), jsn);
+    buf.allocate(8 * 4 * 8);
+    buf.set_image_dimensions(
+        Imath::V2i(16, 8), Imath::Box2i(Imath::V2i(2, 2), Imath::V2i(10, 6)));
+
+    auto planes = pixel_layout(buf);
+    ASSERT_EQ(planes.size(), size_t(1));
+    EXPECT_EQ(planes[0].format, "e");
+    EXPECT_EQ(planes[0].shape, (std::array<size_t, 3>{4, 8, 4}));
+    EXPECT_EQ(planes[0].strides, (std::array<size_t, 3>{64, 8, 2}));
+    // buffers are padded to a multiple of the texture line size
+    EXPECT_LE(planes[0].extent(), buf.size());
+
+    // mixed half / float channels are exposed as bytes
+    jsn["pix_type_a"]      = 2;
+    jsn["bytes_per_pixel"] = 10;
+    buf.set_shader_params(jsn);
+    buf.allocate(8 * 4 * 10);
+    planes = pixel_layout(buf);
+    ASSERT_EQ(planes.size(), size_t(1));
+    EXPECT_EQ(planes[0].name, "bytes");
+    EXPECT_EQ(planes[0].shape, (std::array<size_t, 3>{4, 80, 1}));
+
+    // packed half RGB, 7 pixel rows padded to a 4 byte boundary
+    jsn["pix_type_a"]      = -1;
+    jsn["num_channels"]    = 3;
+    jsn["bytes_per_pixel"] = 6;
+    jsn["line_stride"]     = 44;
+    jsn["packed_half"]     = 1;
+    buf.set_shader_params(jsn);
+    buf.allocate(44 * 4);
+    buf.set_image_dimensions(
+        Imath::V2i(16, 8), Imath::Box2i(Imath::V2i(2, 2), Imath::V2i(9, 6)));
+    planes = pixel_layout(buf);
+    ASSERT_EQ(planes.size(), size_t(1));
+    EXPECT_EQ(planes[0].format, "e");
+    EXPECT_EQ(planes[0].shape, (std::array<size_t, 3>{4, 7, 3}));
+    EXPECT_EQ(planes[0].strides, (std::array<size_t, 3>{44, 6, 2}));
+}
+
+TEST(PixelLayoutTest, FFmpeg) {
+    // 10 bit 4:2:0 with padded lines
+    JsonStore jsn;
+    jsn["rgb"]                  = 0;
+    jsn["bits_per_channel"]     = 10;
+    jsn["half_scale_uvx"]       = 1;
+    jsn["half_scale_uvy"]       = 1;
+    jsn["frame_width_pixels"]   = 15;
+    jsn["y_linesize"]           = 32;
+    jsn["u_linesize"]           = 16;
+    jsn["v_linesize"]           = 16;
+    jsn["a_linesize"]           = 0;
+    jsn["y_plane_bytes_offset"] = 0;
+    jsn["u_plane_bytes_offset"] = 32 * 9;
+    jsn["v_plane_bytes_offset"] = 32 * 9 + 16 * 5;
+    jsn["a_plane_bytes_offset"] = 0;
+
+    ImageBuffer buf(Uuid(), jsn);
+    buf.allocate(32 * 9 + 16 * 5 * 2);
+    buf.set_image_dimensions(Imath::V2i(15, 9));
+
+    const auto planes = pixel_layout(buf);
+    ASSERT_EQ(planes.size(), size_t(3));
+    EXPECT_EQ(planes[0].name, "y");
+    EXPECT_EQ(planes[0].format, "<H");
+    EXPECT_EQ(planes[0].shape, (std::array<size_t, 3>{9, 15, 1}));
+    EXPECT_EQ(planes[0].strides, (std::array<size_t, 3>{32, 2, 2}));
+    EXPECT_EQ(planes[1].name, "u");
+    EXPECT_EQ(planes[1].offset, size_t(32 * 9));
+    EXPECT_EQ(planes[1].shape, (std::array<size_t, 3>{5, 8, 1}));
+    EXPECT_EQ(planes[2].extent(), size_t(32 * 9 + 16 * 5 * 2));
+
+    // packed RGBA
+    JsonStore rgba;
+    rgba["rgb"]                  = 4;
+    rgba["y_linesize"]           = 60;
+    rgba["y_plane_bytes_offset"] = 0;
+    buf.set_shader_params(rgba);
+    buf.allocate(60 * 9);
+    const auto packed = pixel_layout(buf);
+    ASSERT_EQ(packed.size(), size_t(1));
+    EXPECT_EQ(packed[0].name, "rgba");
+    EXPECT_EQ(packed[0].shape, (std::array<size_t, 3>{9, 15, 4}));
+    EXPECT_EQ(packed[0].strides, (std::array<size_t, 3>{60, 4, 1}));
+}
+
+TEST(PixelLayoutTest, Fallback) {
+    JsonStore jsn;
+    jsn["bytes_per_channel"] = 2;
+    jsn["width"]             = 100;
+    jsn["height"]            = 100;
+
+    // too small for the layout described by the params
+    ImageBuffer buf(Uuid(), jsn);
+    buf.allocate(20000);
+    auto planes = pixel_layout(buf);
+    ASSERT_EQ(planes.size(), size_t(1));
+    EXPECT_EQ(planes[0].name, "bytes");
+    EXPECT_EQ(planes[0].shape, (std::array<size_t, 3>{1, buf.size(), 1}));
+
+    buf.allocate(100 * 100 * 6);
+    planes = pixel_layout(buf);
+    EXPECT_EQ(planes[0].name, "rgb");
+    EXPECT_EQ(planes[0].format, ">H");
+
+    // nothing decoded
+    EXPECT_TRUE(pixel_layout(ImageBuffer()).empty());
+}
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include "xstudio/media_reader/read_ahead.hpp"
+#include "xstudio/utility/helpers.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace xstudio::media_reader;
+
+namespace {
+
+// a lookahead of frames from one source, one every frame_ms
+media::AVFrameIDsAndTimePoints
+lookahead(const Uuid &source, const int frames, const int frame_ms) {
+    media::AVFrameIDsAndTimePoints result;
+    const auto now = clock::now();
+    for (int i = 0; i < frames; ++i) {
+        result.emplace_back(
+            now + std::chrono::milliseconds(i * frame_ms),
+            std::make_shared<const media::AVFrameID>(
+                *caf::make_uri("file:///tmp/test.exr"),
+                i,
+                0,
+                media::FS_UNKNOWN,
+                0,
+                1.0f,
+                FrameRate(timebase::k_flicks_24fps),
+                "",
+                "{0}@{1}/{2},{3}",
+                "",
+                caf::actor_addr(),
+                caf::actor_addr(),
+                JsonStore(),
+                source));
+    }
+    return result;
+}
+
+void read(ReadAheadController &controller, const Uuid &source, const int ms, const int n = 1) {
+    const auto now = clock::now();
+    for (int i = 0; i < n; ++i)
+        controller.record_read(source, now, now + std::chrono::milliseconds(ms), 1024 * 1024);
+}
+
+} // namespace
+
+TEST(ReadAheadControllerTest, Unmeasured) {
+    ReadAheadController controller;
+    const auto ph     = Uuid::generate();
+    const auto source = Uuid::generate();
+
+    EXPECT_EQ(controller.plan(ph).frames, 0);
+
+    // no reads of the source yet, so no plan beyond the demand
+    controller.set_lookahead(ph, lookahead(source, 25, 40));
+    const auto plan = controller.plan(ph);
+    EXPECT_EQ(plan.frames, 0);
+    EXPECT_EQ(plan.parallel_reads, 1);
+    EXPECT_NEAR(plan.demand_fps, 25.0, 0.01);
+}
+
+TEST(ReadAheadControllerTest, SizesFromThroughput) {
+    ReadAheadController controller(4);
+    const auto ph     = Uuid::generate();
+    const auto source = Uuid::generate();
+
+    // 24fps playback of a source that decodes in a steady 10ms needs one read
+    // at a time and only a few frames of read-ahead
+    controller.set_lookahead(ph, lookahead(source, 25, 40));
+    read(controller, source, 10, 50);
+    auto fast = controller.plan(ph);
+    EXPECT_EQ(fast.parallel_reads, 1);
+    EXPECT_GE(fast.throughput_fps, fast.demand_fps);
+    EXPECT_GT(fast.frames, 0);
+    EXPECT_LT(fast.frames, 8);
+
+    // slower decodes need more reads in flight and read further ahead
+    read(controller, source, 100, 200);
+    auto slow = controller.plan(ph);
+    EXPECT_EQ(slow.parallel_reads, 4);
+    EXPECT_GE(slow.throughput_fps, slow.demand_fps);
+    EXPECT_GT(slow.frames, fast.frames);
+    EXPECT_EQ(controller.parallel_reads()[ph], 4);
+
+    // and if the readers can't keep up, read as far ahead as allowed
+    read(controller, source, 500, 200);
+    auto behind = controller.plan(ph);
+    EXPECT_EQ(behind.parallel_reads, 4);
+    EXPECT_LT(behind.throughput_fps, behind.demand_fps);
+    EXPECT_EQ(behind.frames, std::numeric_limits<int>::max());
+    EXPECT_EQ(controller.json()["playheads"][to_string(ph)]["frames"], -1);
+
+    controller.set_max_parallel_reads(0);
+    EXPECT_EQ(controller.plan(ph).parallel_reads, 1);
+
+    controller.clear_playhead(ph);
+    EXPECT_EQ(controller.plan(ph).frames, 0);
+    EXPECT_TRUE(controller.parallel_reads().empty());
+}
+
+TEST(ReadAheadControllerTest, Prune) {
+    ReadAheadController controller;
+    const auto source = Uuid::generate();
+
+    read(controller, source, 20);
+    auto jsn = controller.json();
+    EXPECT_EQ(jsn["sources"][to_string(source)]["reads"], 1);
+    EXPECT_NEAR(jsn["sources"][to_string(source)]["latency_ms"].get<double>(), 20.0, 0.01);
+    EXPECT_NEAR(jsn["sources"][to_string(source)]["mb_per_s"].get<double>(), 50.0, 0.01);
+
+    controller.prune(clock::now() + std::chrono::seconds(10), std::chrono::seconds(60));
+    EXPECT_EQ(controller.json()["sources"].size(), size_t(1));
+    controller.prune(clock::now() + std::chrono::seconds(120), std::chrono::seconds(60));
+    EXPECT_TRUE(controller.json()["sources"].empty());
+}
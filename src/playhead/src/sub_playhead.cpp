@@ -11,6 +11,7 @@
 #include "xstudio/global_store/global_store.hpp"
 #include "xstudio/media_reader/media_reader_actor.hpp"
 #include "xstudio/playhead/sub_playhead.hpp"
+#include "xstudio/utility/frame_trace.hpp"
 #include "xstudio/utility/helpers.hpp"
 #include "xstudio/utility/logging.hpp"
 #include "xstudio/utility/media_reference.hpp"
@@ -64,6 +65,7 @@ SubPlayhead::SubPlayhead(
 SubPlayhead::~SubPlayhead() {}
 
 void SubPlayhead::on_exit() {
+    clear_cache_hint();
     parent_ = caf::actor();
     source_ = utility::UuidActor();
 }
@@ -89,6 +91,9 @@ void SubPlayhead::init() {
         pre_cache_read_ahead_frames_ = preference_value<size_t>(j, "/core/playhead/read_ahead");
         static_cache_delay_milliseconds_ = std::chrono::milliseconds(
             preference_value<size_t>(j, "/core/playhead/static_cache_delay_milliseconds"));
+        adaptive_read_ahead_ =
+            preference_value<bool>(j, "/core/playhead/adaptive_read_ahead");
+        min_read_ahead_frames_ = preference_value<int>(j, "/core/playhead/min_read_ahead");
 
     } catch (std::exception &e) {
         spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
@@ -332,6 +337,10 @@ void SubPlayhead::init() {
                     static_cache_delay_milliseconds_ =
                         std::chrono::milliseconds(preference_value<size_t>(
                             full, "/core/playhead/static_cache_delay_milliseconds"));
+                    adaptive_read_ahead_ =
+                        preference_value<bool>(full, "/core/playhead/adaptive_read_ahead");
+                    min_read_ahead_frames_ =
+                        preference_value<int>(full, "/core/playhead/min_read_ahead");
                 } catch (std::exception &e) {
                     spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
                 }
@@ -346,6 +355,10 @@ void SubPlayhead::init() {
                     static_cache_delay_milliseconds_ =
                         std::chrono::milliseconds(preference_value<size_t>(
                             full, "/core/playhead/static_cache_delay_milliseconds"));
+                    adaptive_read_ahead_ =
+                        preference_value<bool>(full, "/core/playhead/adaptive_read_ahead");
+                    min_read_ahead_frames_ =
+                        preference_value<int>(full, "/core/playhead/min_read_ahead");
                 } catch (std::exception &e) {
                     spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
                 }
@@ -1057,6 +1070,9 @@ void SubPlayhead::set_position(
     playing_forwards_  = forwards;
     playback_velocity_ = velocity;
 
+    if (!playing)
+        clear_cache_hint();
+
     timebase::flicks frame_period, timeline_pts;
     std::shared_ptr<const media::AVFrameID> frame = get_frame(time, frame_period, timeline_pts);
     int logical_frame                             = logical_frame_from_pts(timeline_pts);
@@ -1201,6 +1217,7 @@ void SubPlayhead::broadcast_image_frame(
     waiting_for_next_frame_ = true;
 
     const int broadcast_logical = logical_frame_;
+    const auto requested_at     = utility::clock::now();
 
     mail(
         media_reader::get_image_atom_v,
@@ -1212,6 +1229,14 @@ void SubPlayhead::broadcast_image_frame(
         .then(
 
             [=](ImageBufPtr image_buffer) mutable {
+                if (utility::FrameTracer::enabled())
+                    utility::FrameTracer::instance().record(
+                        utility::TraceStage::ReceiveFromCache,
+                        requested_at,
+                        utility::clock::now(),
+                        frame_media_pointer->key(),
+                        uuid_);
+
                 image_buffer.when_to_display_ = when_to_show_frame;
                 image_buffer.set_timline_timestamp(timeline_pts);
                 image_buffer.set_frame_id(*(frame_media_pointer.get()));
@@ -1481,19 +1506,113 @@ void SubPlayhead::request_future_frames() {
 
 void SubPlayhead::update_playback_precache_requests(caf::typed_response_promise<bool> &rp) {
 
+    // until the global reader has measured our sources we read ahead as far as
+    // the preference allows
+    int read_ahead = pre_cache_read_ahead_frames_;
+    if (adaptive_read_ahead_ && adaptive_read_ahead_frames_ > 0) {
+        read_ahead = std::clamp(
+            adaptive_read_ahead_frames_,
+            std::min(min_read_ahead_frames_, pre_cache_read_ahead_frames_),
+            pre_cache_read_ahead_frames_);
+    }
+
     // get the AVFrameID iterator for the current frame
     media::AVFrameIDsAndTimePoints requests;
-    get_lookahead_frame_pointers(requests, pre_cache_read_ahead_frames_);
+    get_lookahead_frame_pointers(requests, read_ahead);
 
     make_prefetch_requests_for_colour_pipeline(requests);
 
+    update_cache_hint();
+
     mail(media_reader::playback_precache_atom_v, requests, uuid_, media_type_)
         .request(pre_reader_, infinite)
         .then(
-            [=](const bool requests_processed) mutable { rp.deliver(requests_processed); },
+            [=](const bool requests_processed) mutable {
+                rp.deliver(requests_processed);
+                if (adaptive_read_ahead_)
+                    update_adaptive_read_ahead();
+            },
             [=](const error &err) mutable { rp.deliver(err); });
 }
 
+void SubPlayhead::update_adaptive_read_ahead() {
+
+    // the global reader plans our read-ahead from how quickly the sources we
+    // are about to show are decoding and how fast we are consuming frames
+    mail(media_reader::read_ahead_atom_v, uuid_)
+        .request(pre_reader_, infinite)
+        .then(
+            [=](const int frames) mutable { adaptive_read_ahead_frames_ = frames; },
+            [=](const error &err) mutable {
+                spdlog::debug("{} {}", __PRETTY_FUNCTION__, to_string(err));
+            });
+}
+
+void SubPlayhead::update_cache_hint() {
+
+    // tell the image cache which frames we are looping over and where we are
+    // in the loop, so its eviction policy can hang on to frames we will come
+    // back round to (see media_cache::EvictionPolicy)
+    if (media_type_ != media::MediaType::MT_IMAGE || num_retimed_frames_ < 2)
+        return;
+
+    if (!image_cache_)
+        image_cache_ = system().registry().template get<caf::actor>(image_cache_registry);
+    if (!image_cache_)
+        return;
+
+    timebase::flicks current_frame_tp =
+        std::min(out_frame_->first, std::max(in_frame_->first, position_flicks_));
+    auto current = current_frame_iterator(current_frame_tp);
+
+    // out_frame_ is never the dummy frame at the end of retimed_frames_, so
+    // there is always a frame after it
+    auto loop_end = out_frame_;
+    loop_end++;
+    const auto num_frames = std::distance(in_frame_, loop_end);
+
+    const timebase::flicks frame_period = (loop_end->first - in_frame_->first) / num_frames;
+
+    const float velocity = playing_forwards_ ? playback_velocity_ : -playback_velocity_;
+    const auto now       = utility::clock::now();
+
+    if (cache_hint_sent_) {
+        anon_mail(
+            media_cache::playhead_hint_atom_v,
+            uuid_,
+            size_t(std::distance(in_frame_, current)),
+            frame_period,
+            velocity,
+            now)
+            .send(image_cache_);
+        return;
+    }
+
+    media::MediaKeyVector frames;
+    frames.reserve(num_frames);
+    size_t position = 0;
+    for (auto frame = in_frame_; frame != loop_end; ++frame) {
+        if (frame == current)
+            position = frames.size();
+        // blank frames are never read, so have nothing to keep
+        if (frame->second && !frame->second->source_uuid().is_null())
+            frames.push_back(frame->second->key());
+        else
+            frames.emplace_back();
+    }
+
+    anon_mail(
+        media_cache::playhead_hint_atom_v, uuid_, frames, position, frame_period, velocity, now)
+        .send(image_cache_);
+    cache_hint_sent_ = true;
+}
+
+void SubPlayhead::clear_cache_hint() {
+    if (cache_hint_sent_ && image_cache_)
+        anon_mail(media_cache::playhead_hint_atom_v, uuid_).send(image_cache_);
+    cache_hint_sent_ = false;
+}
+
 void SubPlayhead::make_static_precache_request(
     caf::typed_response_promise<bool> &rp, const bool start_precache) {
 
@@ -1561,6 +1680,15 @@ void SubPlayhead::receive_image_from_cache(
         return;
     last_image_timepoint_ = tp;
 
+    // tp is when the image was requested
+    if (utility::FrameTracer::enabled())
+        utility::FrameTracer::instance().record(
+            utility::TraceStage::ReceiveFromCache,
+            tp,
+            utility::clock::now(),
+            mptr.key(),
+            uuid_);
+
     image_buffer.when_to_display_ = utility::clock::now();
     image_buffer.set_timline_timestamp(timeline_pts);
     image_buffer.set_playhead_logical_frame(logical_frame_from_pts(timeline_pts));
@@ -2059,6 +2187,9 @@ void SubPlayhead::store_media_frame_ranges() {
 
 void SubPlayhead::set_in_and_out_frames() {
 
+    // the loop range is changing, the cache needs to hear about the new one
+    cache_hint_sent_ = false;
+
     if (num_retimed_frames_ < 2) {
         out_frame_   = retimed_frames_.begin();
         in_frame_    = retimed_frames_.begin();
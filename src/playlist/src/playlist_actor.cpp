@@ -2089,6 +2089,24 @@ void PlaylistActor::init() {
 void PlaylistActor::on_exit() {
     // shutdown playhead
     send_exit(playhead_.actor(), caf::exit_reason::user_shutdown);
+
+    auto cache = system().registry().template get<caf::actor>(image_cache_registry);
+    if (cache)
+        anon_mail(media_cache::erase_atom_v, base_.uuid()).send(cache);
+}
+
+void PlaylistActor::update_cache_usage() {
+    auto cache = system().registry().template get<caf::actor>(image_cache_registry);
+    if (not cache)
+        return;
+
+    const auto media = base_.media();
+    anon_mail(
+        media_cache::usage_atom_v,
+        base_.uuid(),
+        UuidVector(media.begin(), media.end()),
+        base_.name())
+        .send(cache);
 }
 
 void PlaylistActor::create_container(
@@ -2405,6 +2423,7 @@ void PlaylistActor::send_content_changed_event(const bool queue) {
         mail(utility::event_atom_v, media_content_changed_atom_v, actors)
             .send(base_.event_group());
         mail(utility::event_atom_v, utility::change_atom_v).send(change_event_group_);
+        update_cache_usage();
         content_changed_ = false;
         // spdlog::warn("{} {}", __PRETTY_FUNCTION__,
         // to_string(caf::actor_cast<caf::actor>(this)));
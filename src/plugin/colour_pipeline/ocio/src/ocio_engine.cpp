@@ -23,6 +23,35 @@ struct ShaderDescriptor {
 };
 typedef std::shared_ptr<ShaderDescriptor> ShaderDescriptorPtr;
 
+// Wraps an OCIO processor for use by the software viewport renderer. The
+// (relatively expensive) optimised CPU processor is only built the first
+// time the function is actually called.
+ColourOperationData::CPUProcessFunc make_cpu_process_func(OCIO::ConstProcessorRcPtr proc) {
+
+    struct LazyCPUProcessor {
+        OCIO::ConstProcessorRcPtr proc;
+        OCIO::ConstCPUProcessorRcPtr cpu_proc;
+        std::once_flag once;
+    };
+    auto lazy  = std::make_shared<LazyCPUProcessor>();
+    lazy->proc = proc;
+
+    return [lazy](float *rgba, const size_t num_pixels) {
+        std::call_once(lazy->once, [&lazy]() {
+            try {
+                lazy->cpu_proc = lazy->proc->getOptimizedCPUProcessor(
+                    OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32, OCIO::OPTIMIZATION_DEFAULT);
+            } catch (const std::exception &e) {
+                spdlog::warn("OCIOEngine: Failed to build CPU processor: {}", e.what());
+            }
+        });
+        if (!lazy->cpu_proc || !num_pixels)
+            return;
+        OCIO::PackedImageDesc img(rgba, long(num_pixels), 1, 4);
+        lazy->cpu_proc->apply(img);
+    };
+}
+
 } // anonymous namespace
 
 ColourOperationDataPtr OCIOEngine::linearise_op_data(
@@ -53,6 +82,7 @@ ColourOperationDataPtr OCIOEngine::linearise_op_data(
 
     data->shader_ =
         std::make_shared<ui::opengl::OpenGLShader>(utility::Uuid::generate(), shader_text);
+    data->cpu_process_func_ = make_cpu_process_func(shader_builder.getProcessor());
 
     data->set_cache_id(to_string(PLUGIN_UUID) + shader_builder.getCacheString());
 
@@ -112,6 +142,7 @@ ColourOperationDataPtr OCIOEngine::linear_to_display_op_data(
 
     data->shader_ =
         std::make_shared<ui::opengl::OpenGLShader>(utility::Uuid::generate(), shader_text);
+    data->cpu_process_func_ = make_cpu_process_func(shader_builder.getProcessor());
 
     // Store ShaderBuilder for later use during uniform binding / update.
     auto desc            = std::make_shared<ShaderDescriptor>();
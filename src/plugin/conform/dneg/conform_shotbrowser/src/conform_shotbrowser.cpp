@@ -386,10 +386,8 @@ template <typename T> class ShotbrowserConformActor : public caf::event_based_ac
             const auto fake_shot_ptr =
                 json::json_pointer("/metadata/shotgun/version/attributes/sg_pipe_tag_3");
 
-            // build clip lookup.
-            std::map<Uuid, std::string> clip_project_map;
-            std::map<Uuid, std::string> clip_shot_map;
-            std::map<Uuid, std::string> clip_meta_shot_map;
+            // build clip lookup, keyed on project/shot/meta shot.
+            auto clip_index = ConformIndex();
 
             // remap start frame if requested via metadata..
             for (auto &t : creply.request_.template_tracks_) {
@@ -449,10 +447,6 @@ template <typename T> class ShotbrowserConformActor : public caf::event_based_ac
                     not crequest.metadata_.at(media_uuid).at(fake_shot_ptr).is_null())
                     clip_meta_shot = crequest.metadata_.at(media_uuid).at(fake_shot_ptr);
 
-                clip_project_map[clip_uuid]   = clip_project;
-                clip_shot_map[clip_uuid]      = clip_shot;
-                clip_meta_shot_map[clip_uuid] = clip_meta_shot;
-
                 if (clip_project.empty() or clip_shot.empty()) {
                     spdlog::warn(
                         "Clip metadata not found, {} project: '{}', 'shot':  {}, 'meta shot':  "
@@ -465,6 +459,9 @@ template <typename T> class ShotbrowserConformActor : public caf::event_based_ac
                     // spdlog::warn("CLIP {} project: '{}', 'shot':  {}, 'meta shot':  {}",
                     // to_string(clip_uuid), clip_project,
                     // clip_shot, clip_meta_shot);
+                    clip_index.add(
+                        ConformIndex::make_key({clip_project, clip_shot, clip_meta_shot}),
+                        c.get().uuid_actor());
                 }
             }
 
@@ -516,15 +513,11 @@ template <typename T> class ShotbrowserConformActor : public caf::event_based_ac
                             //     meta_shot);
                             auto ritems = std::vector<ConformReplyItem>();
 
-                            for (const auto &c : clips) {
-                                auto clip_uuid = c.get().uuid();
-                                if ((not only_one_match or
-                                     not matched_clips.count(clip_uuid)) and
-                                    clip_project_map.at(clip_uuid) == project and
-                                    clip_shot_map.at(clip_uuid) == shot and
-                                    clip_meta_shot_map.at(clip_uuid) == meta_shot) {
-                                    ritems.push_back(std::make_tuple(c.get().uuid_actor()));
-                                    matched_clips.insert(clip_uuid);
+                            for (const auto &c : clip_index.find(
+                                     ConformIndex::make_key({project, shot, meta_shot}))) {
+                                if (not only_one_match or not matched_clips.count(c.uuid())) {
+                                    ritems.push_back(std::make_tuple(c));
+                                    matched_clips.insert(c.uuid());
                                     if (only_one_match)
                                         break;
                                 }
@@ -1261,23 +1254,16 @@ template <typename T> class ShotbrowserConformActor : public caf::event_based_ac
         // spdlog::warn("{}", needle.second.dump(2));
 
         auto result = utility::UuidActorVector();
-        auto pointer =
-            nlohmann::json::json_pointer("/metadata/shotgun/version/attributes/sg_ivy_dnuuid");
-
-        for (const auto &i : haystack) {
-            if (i.first.uuid() == needle.first.uuid())
-                continue;
+        auto index  = ConformIndex({nlohmann::json::json_pointer(
+            "/metadata/shotgun/version/attributes/sg_ivy_dnuuid")});
 
-            try {
-                if (i.second.value(pointer, Uuid()) == needle.second.value(pointer, Uuid()))
-                    result.push_back(i.first);
-            } catch (...) {
-            }
+        index.build(haystack);
 
-            // spdlog::warn("{}", i.second.dump(2));
+        for (const auto &i : index.find(needle.second)) {
+            if (i.uuid() != needle.first.uuid())
+                result.push_back(i);
         }
 
-
         rp.deliver(result);
     }
 
@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <caf/actor_registry.hpp>
+
+#include "playback_stats_hud.hpp"
+#include "xstudio/atoms.hpp"
+#include "xstudio/plugin_manager/plugin_base.hpp"
+#include "xstudio/utility/helpers.hpp"
+
+using namespace xstudio;
+using namespace xstudio::ui::viewport;
+
+PlaybackStatsHUD::PlaybackStatsHUD(
+    caf::actor_config &cfg, const utility::JsonStore &init_settings)
+    : plugin::HUDPluginBase(cfg, "Playback Stats", init_settings, 4.0f) {
+
+    stats_text_ = add_string_attribute("Playback Stats", "Playback Stats", "");
+    stats_text_->expose_in_ui_attrs_group("playback_stats_attributes");
+
+    auto font_size = add_float_attribute("Font Size", "Font Size", 10.0f, 5.0f, 50.0f, 1.0f);
+    font_size->expose_in_ui_attrs_group("playback_stats_attributes");
+    font_size->set_tool_tip("Sets the font size for the playback stats overlay.");
+    add_hud_settings_attribute(font_size);
+
+    auto bg_opacity = add_float_attribute("Bg Opacity", "Bg Opacity", 0.5f, 0.0f, 1.0f, 0.05f);
+    bg_opacity->expose_in_ui_attrs_group("playback_stats_attributes");
+    bg_opacity->set_tool_tip("Sets the opacity for the dark backdrop behind the stats text.");
+    add_hud_settings_attribute(bg_opacity);
+
+    refresh_interval_ =
+        add_integer_attribute("Refresh Interval", "Refresh (ms)", 500, 100, 5000);
+    refresh_interval_->set_tool_tip("How often the stats are fetched, in milliseconds.");
+    add_hud_settings_attribute(refresh_interval_);
+
+    font_size->set_preference_path("/plugin/playback_stats/font_size");
+    bg_opacity->set_preference_path("/plugin/playback_stats/bg_opacity");
+    refresh_interval_->set_preference_path("/plugin/playback_stats/refresh_interval");
+
+    hud_element_qml(
+        R"(
+            import PlaybackStats 1.0
+            PlaybackStatsOverlay {
+            }
+        )",
+        plugin::TopRight);
+
+    // start the refresh loop, stats are only fetched while the HUD is visible
+    anon_mail(utility::event_atom_v).send(this);
+}
+
+caf::message_handler PlaybackStatsHUD::message_handler_extensions() {
+    return caf::message_handler(
+               [=](utility::event_atom) {
+                   if (visible())
+                       poll_stats();
+                   else if (not stats_text_->value().empty())
+                       stats_text_->set_value("");
+
+                   anon_mail(utility::event_atom_v)
+                       .delay(std::chrono::milliseconds(refresh_interval_->value()))
+                       .send(this);
+               })
+        .or_else(plugin::HUDPluginBase::message_handler_extensions());
+}
+
+void PlaybackStatsHUD::poll_stats() {
+
+    auto reader = system().registry().template get<caf::actor>(media_reader_registry);
+    auto cache  = system().registry().template get<caf::actor>(image_cache_registry);
+    if (not reader or not cache)
+        return;
+
+    mail(media_cache::stats_atom_v)
+        .request(reader, std::chrono::seconds(1))
+        .then(
+            [=](const utility::JsonStore &reader_stats) mutable {
+                mail(media_cache::stats_atom_v)
+                    .request(cache, std::chrono::seconds(1))
+                    .then(
+                        [=](const utility::JsonStore &cache_stats) mutable {
+                            make_onscreen_text(reader_stats, cache_stats);
+                        },
+                        [=](const caf::error &err) mutable {
+                            make_onscreen_text(reader_stats, utility::JsonStore());
+                        });
+            },
+            [=](const caf::error &err) {
+                spdlog::debug("{} {}", __PRETTY_FUNCTION__, to_string(err));
+            });
+}
+
+void PlaybackStatsHUD::make_onscreen_text(
+    const utility::JsonStore &reader_stats, const utility::JsonStore &cache_stats) {
+
+    const auto read_ahead = reader_stats.value("read_ahead", nlohmann::json::object());
+    const auto playheads  = read_ahead.value("playheads", nlohmann::json::object());
+    const auto sources    = read_ahead.value("sources", nlohmann::json::object());
+    const int max_reads   = read_ahead.value("max_parallel_reads", 1);
+
+    std::stringstream ss;
+
+    // the controller only plans for playheads that are playing
+    int playing = 0;
+    for (const auto &p : playheads) {
+        if (p.value("demand_fps", 0.0) <= 0.0)
+            continue;
+        if (playing++)
+            ss << "\n";
+
+        const int frames = p.value("frames", 0);
+        if (frames < 0)
+            ss << "Read-ahead  maximum, readers are behind\n";
+        else if (frames == 0)
+            ss << "Read-ahead  maximum, measuring\n";
+        else
+            ss << fmt::format("Read-ahead  {} frames\n", frames);
+
+        ss << fmt::format(
+            "Reads       {} of {} in flight\n", p.value("parallel_reads", 1), max_reads);
+        ss << fmt::format(
+            "Demand      {:.1f} fps, reads deliver {:.1f} fps",
+            p.value("demand_fps", 0.0),
+            p.value("throughput_fps", 0.0));
+    }
+    if (not playing)
+        ss << "Read-ahead  idle";
+
+    // the read-ahead is planned for the slowest source about to be shown
+    const nlohmann::json *slowest = nullptr;
+    for (const auto &s : sources) {
+        if (not slowest or s.value("latency_ms", 0.0) > slowest->value("latency_ms", 0.0))
+            slowest = &s;
+    }
+    if (slowest) {
+        ss << fmt::format(
+            "\nDecode      {:.1f} ms +/- {:.1f}, {:.0f} MB/s ({} sources)",
+            slowest->value("latency_ms", 0.0),
+            slowest->value("deviation_ms", 0.0),
+            slowest->value("mb_per_s", 0.0),
+            sources.size());
+    }
+
+    const auto queued = reader_stats.value("queued", nlohmann::json::object());
+    ss << fmt::format(
+        "\nQueued      {} playback, {} background",
+        queued.value("playback", 0),
+        queued.value("background", 0));
+
+    if (cache_stats.contains("count")) {
+        ss << fmt::format(
+            "\nCache       {} frames, {:.2f} GB, {:.1f}% hits",
+            cache_stats.value("count", 0),
+            double(cache_stats.value("size", size_t(0))) / (1024.0 * 1024.0 * 1024.0),
+            cache_stats.value("hit_rate", 0.0) * 100.0);
+    }
+
+    // the playlists holding most of the cache, against any quota set on them
+    for (const auto &c : cache_stats.value("largest", nlohmann::json::array())) {
+        const double size  = double(c.value("size", size_t(0))) / (1024.0 * 1024.0 * 1024.0);
+        const double quota = double(c.value("quota", size_t(0))) / (1024.0 * 1024.0 * 1024.0);
+        if (size <= 0.0)
+            continue;
+        ss << fmt::format("\n  {:.16}  {:.2f} GB", c.value("name", std::string()), size);
+        if (quota > 0.0)
+            ss << fmt::format(" of {:.2f} GB", quota);
+    }
+
+    // frames from the last session being read back into the cache
+    if (cache_stats.contains("warm_start")) {
+        const auto warm_start = cache_stats.value("warm_start", nlohmann::json::object());
+        ss << fmt::format(
+            "\nWarm start  {} of {} frames",
+            warm_start.value("restored", 0),
+            warm_start.value("frames", 0));
+        if (warm_start.value("changed", 0))
+            ss << fmt::format(", {} changed on disk", warm_start.value("changed", 0));
+    }
+
+    stats_text_->set_value(ss.str());
+}
+
+extern "C" {
+plugin_manager::PluginFactoryCollection *plugin_factory_collection_ptr() {
+    return new plugin_manager::PluginFactoryCollection(
+        std::vector<std::shared_ptr<plugin_manager::PluginFactory>>(
+            {std::make_shared<plugin_manager::PluginFactoryTemplate<PlaybackStatsHUD>>(
+                utility::Uuid("128d0fa7-37b0-4b73-97ff-627d0fe04a17"),
+                "PlaybackStatsHUD",
+                plugin_manager::PluginFlags::PF_HEAD_UP_DISPLAY,
+                true,
+                "xStudio",
+                "Viewport HUD Plugin")}));
+}
+}
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "xstudio/plugin_manager/hud_plugin.hpp"
+
+namespace xstudio {
+namespace ui {
+    namespace viewport {
+
+        /* Shows what the readers and cache are doing during playback: the
+        read-ahead the global reader has planned for each playing playhead,
+        the reads it lets them have in flight, measured decode latency and
+        throughput, the depth of the precache queue, cache occupancy and how
+        far the cache's warm start has got. */
+        class PlaybackStatsHUD : public plugin::HUDPluginBase {
+          public:
+            PlaybackStatsHUD(caf::actor_config &cfg, const utility::JsonStore &init_settings);
+
+            ~PlaybackStatsHUD() override = default;
+
+          protected:
+            caf::message_handler message_handler_extensions() override;
+
+          private:
+            void poll_stats();
+            void make_onscreen_text(
+                const utility::JsonStore &reader_stats, const utility::JsonStore &cache_stats);
+
+            module::StringAttribute *stats_text_;
+            module::IntegerAttribute *refresh_interval_;
+        };
+
+    } // namespace viewport
+} // namespace ui
+} // namespace xstudio
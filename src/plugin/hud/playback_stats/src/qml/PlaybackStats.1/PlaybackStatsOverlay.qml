@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: Apache-2.0
+
+import QtQuick.Layouts
+import QtQuick
+import xStudio 1.0
+import xstudio.qml.models 1.0
+
+Rectangle {
+
+    width: layout.width+10
+    height: layout.height+10
+    color: "transparent"
+
+    id: control
+    visible: stats_string != ""
+
+    XsModuleData {
+        id: playback_stats_model_data
+        modelDataName: "playback_stats_attributes"
+    }
+
+    XsAttributeValue {
+        id: __stats_string
+        attributeTitle: "Playback Stats"
+        model: playback_stats_model_data
+    }
+    property alias stats_string: __stats_string.value
+
+    XsAttributeValue {
+        id: __font_size
+        attributeTitle: "Font Size"
+        model: playback_stats_model_data
+    }
+    property alias font_size: __font_size.value
+
+    XsAttributeValue {
+        id: __bg_opacity
+        attributeTitle: "Bg Opacity"
+        model: playback_stats_model_data
+    }
+    property alias bg_opacity: __bg_opacity.value
+
+    Rectangle {
+        anchors.fill: parent
+        radius: 5
+        color: "black"
+        opacity: bg_opacity
+        border.color: "white"
+        border.width: 2
+    }
+
+    Column {
+
+        id: layout
+        x: 5
+        y: 5
+        spacing: 4
+
+        Text {
+            id: title
+            text: "Playback Stats"
+            color: "white"
+            font.pixelSize: font_size
+            font.family: XsStyleSheet.fixedWidthFontFamily
+        }
+
+        Rectangle {
+            width: the_text.width
+            height: 1
+            opacity: bg_opacity
+        }
+
+        Text {
+            id: the_text
+            text: stats_string
+            color: "white"
+            font.pixelSize: font_size
+            font.family: XsStyleSheet.fixedWidthFontFamily
+        }
+    }
+
+}
@@ -388,6 +388,21 @@ void FFMpegMediaReader::update_preferences(const utility::JsonStore &prefs) {
     } catch (const std::exception &e) {
         spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
     }
+
+    try {
+
+        ffmpeg::RemoteInput::cache().configure(
+            expand_envvars(preference_value<std::string>(
+                prefs, "/plugin/media_reader/FFMPEG/remote_cache/path")),
+            size_t(preference_value<int>(
+                prefs, "/plugin/media_reader/FFMPEG/remote_cache/max_size")) *
+                1024 * 1024,
+            preference_value<int>(
+                prefs, "/plugin/media_reader/FFMPEG/remote_cache/read_ahead"));
+
+    } catch (const std::exception &e) {
+        spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
+    }
 }
 
 ImageBufPtr FFMpegMediaReader::image(const media::AVFrameID &mptr) {
@@ -426,6 +441,9 @@ ImageBufPtr FFMpegMediaReader::image(const media::AVFrameID &mptr) {
             last_decoded_image_ = rt;
         }
 
+    } catch (const media_cancelled_error &) {
+        // the reader actor reports cancelled reads, they aren't failures
+        throw;
     } catch (std::exception &e) {
         rt = make_blank_image();
         if (mptr.error() != "") {
@@ -844,3 +862,140 @@ PixelInfo FFMpegMediaReader::ffmpeg_buffer_pixel_picker(
     }
     return PixelInfo();
 }
+
+/*
+ *
+ * CPU equivalent of the glsl shaders at the top of this file, for software
+ * rendering. Decodes a whole scanline at a time for every pixel format the
+ * shaders take, YUV formats going through the same matrix and offsets.
+ *
+ */
+void FFMpegMediaReader::ffmpeg_buffer_scanline_unpack(
+    const ImageBuffer &buf, const int line, float *rgba_out) {
+
+    const Imath::Box2i bounds = buf.image_pixels_bounding_box();
+    const int width           = std::max(bounds.max.x - bounds.min.x, 0);
+    std::fill(rgba_out, rgba_out + width * 4, 0.0f);
+
+    const auto &params = buf.shader_params();
+    if (params.is_null() || line < bounds.min.y || line >= bounds.max.y)
+        return;
+
+    const int y                    = line - bounds.min.y;
+    const int rgb                  = params.value("rgb", 0);
+    const int y_linesize           = params.value("y_linesize", 0);
+    const int u_linesize           = params.value("u_linesize", 0);
+    const int v_linesize           = params.value("v_linesize", 0);
+    const int a_linesize           = params.value("a_linesize", 0);
+    const int y_plane_bytes_offset = params.value("y_plane_bytes_offset", 0);
+    const int u_plane_bytes_offset = params.value("u_plane_bytes_offset", 0);
+    const int v_plane_bytes_offset = params.value("v_plane_bytes_offset", 0);
+    const int a_plane_bytes_offset = params.value("a_plane_bytes_offset", 0);
+    const int half_scale_uvy       = params.value("half_scale_uvy", 0);
+    const int half_scale_uvx       = params.value("half_scale_uvx", 0);
+    const int bits_per_channel     = params.value("bits_per_channel", 0);
+    const float norm_coeff         = params.value("norm_coeff", 1.0f);
+
+    const auto *data  = reinterpret_cast<const uint8_t *>(buf.buffer());
+    const size_t size = buf.size();
+
+    auto byte_at = [&](const size_t address) -> int {
+        return address < size ? data[address] : 0;
+    };
+
+    auto short_at = [&](const size_t address) -> int {
+        if (address + 2 > size)
+            return 0;
+        uint16_t v;
+        memcpy(&v, data + address, sizeof(v));
+        return v;
+    };
+
+    if (rgb == 0) {
+        const Imath::M33f yuv_conv   = params.value("yuv_conv", Imath::M33f());
+        const Imath::V3i yuv_offsets = params.value("yuv_offsets", Imath::V3i());
+        const bool wide              = bits_per_channel == 10 || bits_per_channel == 12;
+        const size_t bytes           = wide ? 2 : 1;
+
+        auto sample = [&](const int offset, const int linesize, const int px, const int py) {
+            const size_t address = size_t(offset) + size_t(py) * linesize + px * bytes;
+            return wide ? short_at(address) : byte_at(address);
+        };
+
+        const int uv_y = half_scale_uvy ? y >> 1 : y;
+
+        for (int x = 0; x < width; ++x, rgba_out += 4) {
+            const int uv_x = half_scale_uvx ? x >> 1 : x;
+            Imath::V3i yuv(
+                sample(y_plane_bytes_offset, y_linesize, x, y),
+                sample(u_plane_bytes_offset, u_linesize, uv_x, uv_y),
+                sample(v_plane_bytes_offset, v_linesize, uv_x, uv_y));
+
+            // odd pixels sit between two chroma samples
+            if (wide && half_scale_uvx && (x & 1) == 1 && x * 2 < width) {
+                yuv.y = (yuv.y + sample(u_plane_bytes_offset, u_linesize, uv_x + 1, uv_y)) >> 1;
+                yuv.z = (yuv.z + sample(v_plane_bytes_offset, v_linesize, uv_x + 1, uv_y)) >> 1;
+            }
+
+            yuv -= yuv_offsets;
+            Imath::V3f rgbf(yuv.x, yuv.y, yuv.z);
+            rgbf *= yuv_conv;
+            rgbf *= norm_coeff;
+
+            rgba_out[0] = rgbf.x;
+            rgba_out[1] = rgbf.y;
+            rgba_out[2] = rgbf.z;
+            rgba_out[3] = 1.0f;
+            if (wide && a_linesize != 0)
+                rgba_out[3] =
+                    float(sample(a_plane_bytes_offset, a_linesize, x, y)) * norm_coeff;
+        }
+        return;
+    }
+
+    const size_t row = size_t(y) * y_linesize;
+
+    if (rgb == 1 || rgb == 2) {
+        // RGB24, BGR24
+        const int r_byte = rgb == 2 ? 2 : 0;
+        const int b_byte = rgb == 2 ? 0 : 2;
+        for (int x = 0; x < width; ++x, rgba_out += 4) {
+            const size_t address = row + size_t(x) * 3;
+            rgba_out[0]          = float(byte_at(address + r_byte)) * norm_coeff;
+            rgba_out[1]          = float(byte_at(address + 1)) * norm_coeff;
+            rgba_out[2]          = float(byte_at(address + b_byte)) * norm_coeff;
+            rgba_out[3]          = 1.0f;
+        }
+    } else if (rgb >= 3 && rgb <= 6) {
+        // the byte holding each of R, G, B and A for ARGB, RGBA, ABGR and BGRA
+        static const std::array<std::array<int, 4>, 4> channel_bytes = {
+            {{1, 2, 3, 0}, {0, 1, 2, 3}, {3, 2, 1, 0}, {2, 1, 0, 3}}};
+        const auto &bytes = channel_bytes[rgb - 3];
+        for (int x = 0; x < width; ++x, rgba_out += 4) {
+            const size_t address = row + size_t(x) * 4;
+            for (int c = 0; c < 4; ++c)
+                rgba_out[c] = float(byte_at(address + bytes[c])) * norm_coeff;
+        }
+    } else if (rgb == 7) {
+        // GBR(A) planar, 2 bytes a channel
+        for (int x = 0; x < width; ++x, rgba_out += 4) {
+            const size_t address = row + size_t(x) * 2;
+            rgba_out[0]          = float(short_at(address + v_plane_bytes_offset)) * norm_coeff;
+            rgba_out[1]          = float(short_at(address + y_plane_bytes_offset)) * norm_coeff;
+            rgba_out[2]          = float(short_at(address + u_plane_bytes_offset)) * norm_coeff;
+            rgba_out[3] = a_linesize != 0
+                              ? float(short_at(address + a_plane_bytes_offset)) * norm_coeff
+                              : 1.0f;
+        }
+    } else if (rgb == 8 || rgb == 9) {
+        // RGB48, RGBA64
+        const size_t channels = rgb == 9 ? 4 : 3;
+        for (int x = 0; x < width; ++x, rgba_out += 4) {
+            const size_t address = row + size_t(x) * channels * 2;
+            for (size_t c = 0; c < channels; ++c)
+                rgba_out[c] = float(short_at(address + c * 2)) * norm_coeff;
+            if (channels == 3)
+                rgba_out[3] = 1.0f;
+        }
+    }
+}
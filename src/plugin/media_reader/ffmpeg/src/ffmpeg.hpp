@@ -35,6 +35,9 @@ namespace media_reader {
         [[nodiscard]] ImageBuffer::PixelPickerFunc pixel_picker_func() const override {
             return &FFMpegMediaReader::ffmpeg_buffer_pixel_picker;
         }
+        [[nodiscard]] ImageBuffer::ScanlineUnpackFunc scanline_unpack_func() const override {
+            return &FFMpegMediaReader::ffmpeg_buffer_scanline_unpack;
+        }
 
       private:
         static PixelInfo ffmpeg_buffer_pixel_picker(
@@ -42,6 +45,9 @@ namespace media_reader {
             const Imath::V2i &pixel_location,
             const std::vector<Imath::V2i> &extra_pixel_locationss);
 
+        static void
+        ffmpeg_buffer_scanline_unpack(const ImageBuffer &buf, const int line, float *rgba_out);
+
         std::shared_ptr<ffmpeg::FFMpegDecoder> decoder;
         std::shared_ptr<ffmpeg::FFMpegDecoder> audio_decoder;
         std::shared_ptr<ffmpeg::FFMpegDecoder> thumbnail_decoder;
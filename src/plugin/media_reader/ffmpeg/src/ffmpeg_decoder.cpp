@@ -4,6 +4,7 @@
 
 #include "ffmpeg_decoder.hpp"
 #include "xstudio/media/media_error.hpp"
+#include "xstudio/media_reader/read_priority.hpp"
 
 #ifdef __GNUC__ // Check if GCC compiler is being used
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
@@ -52,6 +53,15 @@ void FFMpegDecoder::open_handles() {
         avc_packet_ = av_packet_alloc();
     }
 
+    if (RemoteInput::cached(movie_file_path_)) {
+        // remote media is read through the local chunk cache, so reopening the
+        // decoder or seeking doesn't fetch it over the network again
+        remote_input_      = std::make_unique<RemoteInput>(movie_file_path_);
+        av_format_ctx_     = avformat_alloc_context();
+        av_format_ctx_->pb = remote_input_->context();
+        av_format_ctx_->flags |= AVFMT_FLAG_CUSTOM_IO;
+    }
+
     AVC_CHECK_THROW(
         avformat_open_input(&av_format_ctx_, movie_file_path_.c_str(), nullptr, nullptr),
         "avformat_open_input");
@@ -183,6 +193,7 @@ void FFMpegDecoder::close_handles() {
         avformat_close_input(&av_format_ctx_);
         av_format_ctx_ = nullptr;
     }
+    remote_input_.reset();
 
     if (avc_packet_) {
         av_packet_unref(avc_packet_);
@@ -408,6 +419,10 @@ void FFMpegDecoder::decode_audio_frame(
         // that we want.
         while (last_decoded_frame_ <= frame_num) {
 
+            // decoding up from a keyframe can take many packets, give up
+            // between them if the read has gone stale
+            media_reader::ReadCancelToken::throw_if_cancelled();
+
             // decoding of any and all streams happens in this call, and if
             // we get a complete video or audio frame it is also stored within
             // this function
@@ -482,6 +497,8 @@ void FFMpegDecoder::decode_video_frame(
         // that we want.
         while (last_decoded_frame_ < frame_num) {
 
+            media_reader::ReadCancelToken::throw_if_cancelled();
+
             // decoding of any and all streams happens in this call, and if
             // we get a complete video or audio frame it is also stored
             // within/hosts/hawley/user_data/QT_PIX_FORMATS_PROP/ this function
@@ -1,7 +1,10 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <memory>
+
 #include "ffmpeg_stream.hpp"
+#include "remote_input.hpp"
 
 namespace xstudio {
 namespace media_reader {
@@ -72,6 +75,7 @@ namespace media_reader {
             int64_t requested_decode_frame_;
             AVPacket *avc_packet_;
             AVFormatContext *av_format_ctx_;
+            std::unique_ptr<RemoteInput> remote_input_;
             StreamPtr decode_stream_;
             StreamPtr timecode_stream_;
 
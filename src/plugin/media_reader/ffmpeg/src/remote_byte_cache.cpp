@@ -0,0 +1,374 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <filesystem>
+#include <fmt/format.h>
+#include <fstream>
+
+#include "remote_byte_cache.hpp"
+#include "xstudio/utility/logging.hpp"
+
+using namespace xstudio::media_reader::ffmpeg;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// chunks of a url live in a directory named from a hash of it, along with a
+// file holding the url and the size and validator it had when they were
+// fetched, one a line
+const std::string source_file = "source";
+
+std::string url_hash(const std::string &url) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const auto c : url) {
+        hash ^= uint8_t(c);
+        hash *= 1099511628211ull;
+    }
+    return fmt::format("{:016x}", hash);
+}
+
+bool write_file(const fs::path &path, const std::string &data) {
+    // written under another name first, so nobody reads half a chunk
+    const auto tmp = fs::path(path.string() + ".tmp");
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.write(data.data(), data.size()))
+            return false;
+    }
+    std::error_code ec;
+    fs::rename(tmp, path, ec);
+    if (ec)
+        fs::remove(tmp, ec);
+    return !ec;
+}
+
+} // namespace
+
+RemoteByteCache::RemoteByteCache(
+    StatFunc stat_func, FetchFunc fetch_func, const size_t chunk_size, const int threads)
+    : stat_func_(std::move(stat_func)),
+      fetch_func_(std::move(fetch_func)),
+      chunk_size_(chunk_size) {
+    for (int i = 0; i < std::max(threads, 1); ++i)
+        threads_.emplace_back(&RemoteByteCache::run, this);
+}
+
+RemoteByteCache::~RemoteByteCache() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        queue_.clear();
+    }
+    queue_cv_.notify_all();
+    cv_.notify_all();
+    for (auto &t : threads_)
+        t.join();
+}
+
+void RemoteByteCache::configure(
+    const std::string &dir, const size_t max_bytes, const int read_ahead) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_bytes_  = max_bytes;
+    read_ahead_ = std::max(read_ahead, 0);
+
+    if (dir != dir_) {
+        dir_ = dir;
+        sources_.clear();
+        lru_.clear();
+        queue_.clear();
+        bytes_ = 0;
+        if (!dir_.empty() && max_bytes_)
+            scan();
+    }
+    evict();
+}
+
+bool RemoteByteCache::enabled() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_bytes_ && !dir_.empty();
+}
+
+size_t RemoteByteCache::bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+}
+
+nlohmann::json RemoteByteCache::json() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nlohmann::json{
+        {"hits", hits_},
+        {"misses", misses_},
+        {"prefetched", prefetched_},
+        {"evicted", evicted_},
+        {"failed", failed_},
+        {"chunks", lru_.size()},
+        {"bytes", bytes_},
+        {"max_bytes", max_bytes_}};
+}
+
+void RemoteByteCache::scan() {
+    // what earlier sessions left, oldest first
+    std::vector<std::tuple<fs::file_time_type, std::string, int64_t, size_t>> found;
+
+    std::error_code ec;
+    for (const auto &entry : fs::directory_iterator(dir_, ec)) {
+        if (!entry.is_directory())
+            continue;
+
+        std::ifstream in(entry.path() / source_file);
+        std::string url, size, validator;
+        if (!std::getline(in, url) || !std::getline(in, size) ||
+            url_hash(url) != entry.path().filename())
+            continue;
+        // files from before validators were kept have none, and are only
+        // used again if the server doesn't send one either
+        std::getline(in, validator);
+
+        auto &src = source(url);
+        try {
+            src.size = std::stoll(size);
+        } catch (...) {
+            continue;
+        }
+        src.validator = validator;
+
+        for (const auto &chunk : fs::directory_iterator(entry.path(), ec)) {
+            if (chunk.path().extension() != ".chunk")
+                continue;
+            try {
+                found.emplace_back(
+                    chunk.last_write_time(),
+                    url,
+                    std::stoll(chunk.path().stem().string()),
+                    size_t(chunk.file_size()));
+            } catch (...) {
+            }
+        }
+    }
+
+    std::sort(found.begin(), found.end());
+    for (const auto &[when, url, index, bytes] : found)
+        add_chunk(url, index, bytes);
+}
+
+RemoteByteCache::Source &RemoteByteCache::source(const std::string &url) {
+    auto &result = sources_[url];
+    if (result.dir.empty())
+        result.dir = (fs::path(dir_) / url_hash(url)).string();
+    return result;
+}
+
+std::string RemoteByteCache::chunk_path(const Source &source, const int64_t index) const {
+    return (fs::path(source.dir) / fmt::format("{}.chunk", index)).string();
+}
+
+int64_t RemoteByteCache::size(const std::string &url) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto &src = source(url);
+        if (src.verified)
+            return src.size;
+    }
+
+    // asked for once a session, and if the file has changed size or been
+    // replaced on the server what we kept of it is no good
+    const auto remote = stat_func_(url);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &src = source(url);
+    if (remote.size < 0 || src.verified)
+        return src.verified ? src.size : remote.size;
+
+    // without a validator, e.g. https where the server's headers couldn't be
+    // read, a replaced file of the same size can't be told apart
+    const bool unvalidated = remote.validator.empty() && url.rfind("https://", 0) == 0;
+    if (unvalidated && !src.chunks.empty())
+        spdlog::warn(
+            "No ETag or Last-Modified for {}, not reusing the {} chunks kept of it",
+            url,
+            src.chunks.size());
+
+    if (unvalidated || src.size != remote.size || src.validator != remote.validator) {
+        while (!src.chunks.empty())
+            drop_chunk(url, src.chunks.begin()->first, true);
+
+        std::error_code ec;
+        fs::create_directories(src.dir, ec);
+        if (!write_file(
+                fs::path(src.dir) / source_file,
+                url + "\n" + std::to_string(remote.size) + "\n" + remote.validator))
+            return -1;
+    }
+
+    src.size      = remote.size;
+    src.validator = remote.validator;
+    src.verified  = true;
+    return remote.size;
+}
+
+int64_t RemoteByteCache::read(
+    const std::string &url, const int64_t pos, uint8_t *buffer, size_t size) {
+    const auto total = this->size(url);
+    if (total < 0)
+        return -1;
+    if (pos >= total || !size)
+        return 0;
+
+    const int64_t index  = pos / int64_t(chunk_size_);
+    const int64_t offset = pos - index * int64_t(chunk_size_);
+    const int64_t chunk_bytes = std::min(int64_t(chunk_size_), total - pos + offset);
+    size                      = std::min(size, size_t(chunk_bytes - offset));
+
+    // a chunk can be evicted between finding it and reading it, so there's a
+    // second go
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        std::string path;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (!attempt) {
+                if (source(url).chunks.count(index))
+                    hits_++;
+                else
+                    misses_++;
+            }
+            if (!ensure_chunk(lock, url, index))
+                return -1;
+            queue_read_ahead(url, index);
+            path = chunk_path(source(url), index);
+        }
+
+        std::ifstream in(path, std::ios::binary);
+        if (in.seekg(offset) && in.read(reinterpret_cast<char *>(buffer), size))
+            return int64_t(size);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        drop_chunk(url, index, false);
+    }
+
+    return -1;
+}
+
+bool RemoteByteCache::ensure_chunk(
+    std::unique_lock<std::mutex> &lock, const std::string &url, const int64_t index) {
+    const auto key = std::make_pair(url, index);
+
+    while (true) {
+        auto &src = source(url);
+        auto p    = src.chunks.find(index);
+        if (p != src.chunks.end()) {
+            lru_.splice(lru_.begin(), lru_, p->second.lru);
+            return true;
+        }
+
+        // somebody is already fetching it
+        if (!fetching_.count(key))
+            break;
+        cv_.wait(lock);
+    }
+
+    fetching_.insert(key);
+    const auto offset = index * int64_t(chunk_size_);
+    const auto size   = std::min(int64_t(chunk_size_), source(url).size - offset);
+    const auto path   = chunk_path(source(url), index);
+    const auto dir    = source(url).dir;
+
+    lock.unlock();
+    std::string data;
+    bool fetched = fetch_func_(url, offset, size_t(size), data) && data.size() == size_t(size);
+    if (fetched) {
+        std::error_code ec;
+        fs::create_directories(dir, ec);
+        fetched = write_file(path, data);
+    }
+    lock.lock();
+
+    fetching_.erase(key);
+    if (fetched)
+        add_chunk(url, index, data.size());
+    else
+        failed_++;
+    cv_.notify_all();
+
+    return fetched && source(url).chunks.count(index);
+}
+
+void RemoteByteCache::add_chunk(
+    const std::string &url, const int64_t index, const size_t bytes) {
+    auto &src = source(url);
+    if (src.chunks.count(index))
+        return;
+
+    lru_.emplace_front(url, index);
+    src.chunks[index] = Chunk{bytes, lru_.begin()};
+    bytes_ += bytes;
+    evict();
+}
+
+void RemoteByteCache::drop_chunk(
+    const std::string &url, const int64_t index, const bool remove) {
+    auto &src = source(url);
+    auto p    = src.chunks.find(index);
+    if (p == src.chunks.end())
+        return;
+
+    bytes_ -= p->second.bytes;
+    lru_.erase(p->second.lru);
+    src.chunks.erase(p);
+
+    if (remove) {
+        std::error_code ec;
+        fs::remove(chunk_path(src, index), ec);
+    }
+}
+
+void RemoteByteCache::evict() {
+    // the chunk just added is never the one to go
+    while (bytes_ > max_bytes_ && lru_.size() > 1) {
+        const auto key = lru_.back();
+        drop_chunk(key.first, key.second, true);
+        evicted_++;
+    }
+}
+
+void RemoteByteCache::queue_read_ahead(const std::string &url, const int64_t index) {
+    // the read position has moved, what was queued for it before is stale
+    queue_.erase(
+        std::remove_if(
+            queue_.begin(),
+            queue_.end(),
+            [&](const ChunkKey &key) { return key.first == url; }),
+        queue_.end());
+
+    // never so far ahead that fetching it evicts what is being read now
+    const auto &src      = source(url);
+    const int64_t chunks = (src.size + int64_t(chunk_size_) - 1) / int64_t(chunk_size_);
+    const int64_t ahead =
+        std::min(int64_t(read_ahead_), int64_t(max_bytes_ / chunk_size_ / 2));
+    for (int64_t i = index + 1; i <= index + ahead && i < chunks; ++i) {
+        if (!src.chunks.count(i) && !fetching_.count(std::make_pair(url, i)))
+            queue_.emplace_back(url, i);
+    }
+
+    if (!queue_.empty())
+        queue_cv_.notify_all();
+}
+
+void RemoteByteCache::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        if (queue_.empty()) {
+            queue_cv_.wait(lock);
+            continue;
+        }
+
+        const auto key = queue_.front();
+        queue_.pop_front();
+
+        const auto &src = source(key.first);
+        if (src.chunks.count(key.second) || fetching_.count(key) || !max_bytes_)
+            continue;
+
+        if (ensure_chunk(lock, key.first, key.second))
+            prefetched_++;
+    }
+}
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace xstudio {
+namespace media_reader {
+    namespace ffmpeg {
+
+        /* Class RemoteByteCache
+
+        Keeps the bytes of remote (http/https) media in fixed size chunks on
+        local disk, so that decoders reopening a movie or seeking around in it
+        read it from there instead of fetching it over the network again. One
+        cache is shared by all the decoders, so a movie is only fetched once
+        however many readers have it open.
+
+        Chunks are fetched when a read needs them, and the chunks after the
+        read position are fetched ahead of it by worker threads. Total size on
+        disk is kept within a budget by dropping the least recently read
+        chunks, and chunks left by earlier sessions are picked up again as long
+        as the remote file still has the same size and ETag (or Last-Modified
+        date, for servers that don't send an ETag).
+
+        Fetching from the server is done through the functions given at
+        construction, so the cache itself doesn't care how.
+        */
+        class RemoteByteCache {
+          public:
+            // content length of a url, negative if it can't be had, and the
+            // ETag or Last-Modified the server sent with it, empty for neither
+            struct RemoteFile {
+                int64_t size = {-1};
+                std::string validator;
+            };
+            using StatFunc = std::function<RemoteFile(const std::string &url)>;
+
+            // size bytes of url starting at offset (fewer at the end of the
+            // file) into buffer, false on failure
+            using FetchFunc = std::function<bool(
+                const std::string &url,
+                const int64_t offset,
+                const size_t size,
+                std::string &buffer)>;
+
+            RemoteByteCache(
+                StatFunc stat_func,
+                FetchFunc fetch_func,
+                const size_t chunk_size = size_t(4) * 1024 * 1024,
+                const int threads       = 2);
+            ~RemoteByteCache();
+
+            RemoteByteCache(const RemoteByteCache &)            = delete;
+            RemoteByteCache &operator=(const RemoteByteCache &) = delete;
+
+            // a max_bytes of 0 turns the cache off
+            void
+            configure(const std::string &dir, const size_t max_bytes, const int read_ahead);
+            [[nodiscard]] bool enabled() const;
+
+            [[nodiscard]] int64_t size(const std::string &url);
+
+            // bytes read into buffer, 0 at the end of the file, negative on
+            // error
+            int64_t
+            read(const std::string &url, const int64_t pos, uint8_t *buffer, size_t size);
+
+            [[nodiscard]] size_t bytes() const;
+
+            // hits, misses, chunks fetched ahead and evicted, bytes on disk
+            [[nodiscard]] nlohmann::json json() const;
+
+          private:
+            typedef std::pair<std::string, int64_t> ChunkKey;
+
+            struct Chunk {
+                size_t bytes = {0};
+                std::list<ChunkKey>::iterator lru;
+            };
+
+            struct Source {
+                std::string dir;
+                int64_t size = {-1};
+                std::string validator;
+                bool verified = {false};
+                std::map<int64_t, Chunk> chunks;
+            };
+
+            void run();
+            void scan();
+
+            Source &source(const std::string &url);
+            [[nodiscard]] std::string
+            chunk_path(const Source &source, const int64_t index) const;
+
+            // blocks until the chunk is on disk, false if it can't be fetched
+            bool ensure_chunk(
+                std::unique_lock<std::mutex> &lock,
+                const std::string &url,
+                const int64_t index);
+            void add_chunk(const std::string &url, const int64_t index, const size_t bytes);
+            void drop_chunk(const std::string &url, const int64_t index, const bool remove);
+            void evict();
+            void queue_read_ahead(const std::string &url, const int64_t index);
+
+            StatFunc stat_func_;
+            FetchFunc fetch_func_;
+            const size_t chunk_size_;
+
+            mutable std::mutex mutex_;
+            std::condition_variable cv_;
+            std::condition_variable queue_cv_;
+            bool stopping_ = {false};
+
+            std::string dir_;
+            size_t max_bytes_ = {0};
+            int read_ahead_   = {0};
+            size_t bytes_     = {0};
+
+            std::map<std::string, Source> sources_;
+            std::list<ChunkKey> lru_;
+            std::set<ChunkKey> fetching_;
+            std::deque<ChunkKey> queue_;
+
+            uint64_t hits_       = {0};
+            uint64_t misses_     = {0};
+            uint64_t prefetched_ = {0};
+            uint64_t evicted_    = {0};
+            uint64_t failed_     = {0};
+
+            std::vector<std::thread> threads_;
+        };
+
+    } // namespace ffmpeg
+} // namespace media_reader
+} // namespace xstudio
@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+
+extern "C" {
+#include <libavutil/error.h>
+#include <libavutil/mem.h>
+}
+
+#include "remote_input.hpp"
+#include "xstudio/http_client/http_client.hpp"
+
+using namespace xstudio::media_reader::ffmpeg;
+
+namespace {
+
+// ffmpeg reads through the context in pieces of this size
+const int io_buffer_size = 256 * 1024;
+
+// ffmpeg doesn't hand back response headers, so the validator comes from a
+// HEAD request of our own. What's kept of https files that come back without
+// one isn't reused, see RemoteByteCache::size.
+std::string remote_validator(const std::string &url) {
+    const auto host_end = url.find('/', url.find("://") + 3);
+    const auto path     = host_end == std::string::npos ? "/" : url.substr(host_end);
+
+    httplib::Client client(url.substr(0, host_end));
+    client.set_follow_location(true);
+    const auto res = client.Head(path);
+    if (!res || res->status != 200)
+        return std::string();
+
+    const auto etag = res->get_header_value("ETag");
+    return etag.empty() ? res->get_header_value("Last-Modified") : etag;
+}
+
+RemoteByteCache::RemoteFile remote_stat(const std::string &url) {
+    RemoteByteCache::RemoteFile result;
+    AVIOContext *io = nullptr;
+    if (avio_open2(&io, url.c_str(), AVIO_FLAG_READ, nullptr, nullptr) < 0)
+        return result;
+    result.size = avio_size(io);
+    avio_closep(&io);
+
+    if (result.size >= 0)
+        result.validator = remote_validator(url);
+    return result;
+}
+
+bool remote_fetch(
+    const std::string &url, const int64_t offset, const size_t size, std::string &buffer) {
+    AVIOContext *io = nullptr;
+    if (avio_open2(&io, url.c_str(), AVIO_FLAG_READ, nullptr, nullptr) < 0)
+        return false;
+
+    buffer.resize(size);
+    size_t got = 0;
+    if (avio_seek(io, offset, SEEK_SET) == offset) {
+        while (got < size) {
+            const auto n = avio_read(
+                io,
+                reinterpret_cast<unsigned char *>(&buffer[got]),
+                int(std::min(size - got, size_t(io_buffer_size))));
+            if (n <= 0)
+                break;
+            got += size_t(n);
+        }
+    }
+
+    avio_closep(&io);
+    buffer.resize(got);
+    return got == size;
+}
+
+} // namespace
+
+RemoteInput::RemoteInput(std::string url) : url_(std::move(url)) {
+    auto buffer = static_cast<unsigned char *>(av_malloc(io_buffer_size));
+    if (!buffer)
+        throw std::runtime_error("Failed to allocate remote input buffer");
+
+    context_ = avio_alloc_context(
+        buffer,
+        io_buffer_size,
+        0,
+        this,
+        &RemoteInput::read_packet,
+        nullptr,
+        &RemoteInput::seek);
+    if (!context_) {
+        av_free(buffer);
+        throw std::runtime_error("Failed to allocate remote input context");
+    }
+}
+
+RemoteInput::~RemoteInput() {
+    if (context_) {
+        av_freep(&context_->buffer);
+        avio_context_free(&context_);
+    }
+}
+
+bool RemoteInput::cached(const std::string &path) {
+    return (path.find("http://") == 0 || path.find("https://") == 0) && cache().enabled();
+}
+
+RemoteByteCache &RemoteInput::cache() {
+    static RemoteByteCache the_cache(&remote_stat, &remote_fetch);
+    return the_cache;
+}
+
+int RemoteInput::read_packet(void *opaque, uint8_t *buffer, int size) {
+    auto input   = static_cast<RemoteInput *>(opaque);
+    const auto n = cache().read(input->url_, input->position_, buffer, size_t(size));
+    if (n < 0)
+        return AVERROR(EIO);
+    if (n == 0)
+        return AVERROR_EOF;
+    input->position_ += n;
+    return int(n);
+}
+
+int64_t RemoteInput::seek(void *opaque, int64_t offset, int whence) {
+    auto input = static_cast<RemoteInput *>(opaque);
+
+    if (whence & AVSEEK_SIZE)
+        return cache().size(input->url_);
+
+    switch (whence & ~AVSEEK_FORCE) {
+    case SEEK_SET:
+        input->position_ = offset;
+        break;
+    case SEEK_CUR:
+        input->position_ += offset;
+        break;
+    case SEEK_END: {
+        const auto size = cache().size(input->url_);
+        if (size < 0)
+            return AVERROR(EIO);
+        input->position_ = size + offset;
+    } break;
+    default:
+        return AVERROR(EINVAL);
+    }
+
+    return input->position_;
+}
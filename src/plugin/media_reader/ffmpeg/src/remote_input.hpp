@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <string>
+
+extern "C" {
+#include <libavformat/avio.h>
+}
+
+#include "remote_byte_cache.hpp"
+
+namespace xstudio {
+namespace media_reader {
+    namespace ffmpeg {
+
+        /* Class RemoteInput
+
+        Custom AVIOContext for a decoder reading an http(s) movie, serving its
+        reads and seeks from the shared RemoteByteCache.
+        */
+        class RemoteInput {
+          public:
+            explicit RemoteInput(std::string url);
+            ~RemoteInput();
+
+            RemoteInput(const RemoteInput &)            = delete;
+            RemoteInput &operator=(const RemoteInput &) = delete;
+
+            AVIOContext *context() { return context_; }
+
+            // true if path is remote media and the cache is turned on
+            static bool cached(const std::string &path);
+
+            // the cache shared by all decoders, fetching through ffmpeg's own
+            // protocol handlers
+            static RemoteByteCache &cache();
+
+          private:
+            static int read_packet(void *opaque, uint8_t *buffer, int size);
+            static int64_t seek(void *opaque, int64_t offset, int whence);
+
+            const std::string url_;
+            int64_t position_     = {0};
+            AVIOContext *context_ = {nullptr};
+        };
+
+    } // namespace ffmpeg
+} // namespace media_reader
+} // namespace xstudio
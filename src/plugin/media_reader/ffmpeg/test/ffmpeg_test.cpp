@@ -1,8 +1,12 @@
 // SPDX-License-Identifier: Apache-2.0
+#include <cstring>
+#include <filesystem>
 #include <gtest/gtest.h>
+#include <thread>
 
 #include "ffmpeg_decoder.hpp"
 #include "ffmpeg.hpp"
+#include "remote_byte_cache.hpp"
 #include "xstudio/media/media.hpp"
 #include "xstudio/media_reader/media_reader.hpp"
 #include "xstudio/utility/helpers.hpp"
@@ -49,3 +53,104 @@ ACTOR_TEST_MINIMAL()
 
 //    delete decoder;
 //}
+
+TEST(RemoteByteCacheTest, Test) {
+    namespace fs   = std::filesystem;
+    const auto dir =
+        fs::temp_directory_path() / ("remote_cache_" + to_string(Uuid::generate()));
+
+    // a 10 chunk 'remote' file, counting what is fetched from it
+    const size_t chunk = 1024;
+    std::string remote(chunk * 10 - 100, ' ');
+    for (size_t i = 0; i < remote.size(); ++i)
+        remote[i] = char(i % 251);
+
+    std::atomic<int> fetches = {0};
+    std::string etag         = "\"1\"";
+    auto stat_func           = [&](const std::string &) {
+        return RemoteByteCache::RemoteFile{int64_t(remote.size()), etag};
+    };
+    auto fetch_func =
+        [&](const std::string &, const int64_t offset, const size_t size, std::string &buffer) {
+            fetches++;
+            buffer = remote.substr(offset, size);
+            return true;
+        };
+
+    {
+        RemoteByteCache cache(stat_func, fetch_func, chunk);
+        cache.configure(dir.string(), chunk * 6, 2);
+        EXPECT_EQ(cache.size("http://host/movie.mov"), int64_t(remote.size()));
+
+        // reads don't cross chunks, and the chunks after are fetched ahead
+        std::vector<uint8_t> buffer(chunk * 2);
+        EXPECT_EQ(cache.read("http://host/movie.mov", 1000, buffer.data(), 100), 24);
+        EXPECT_EQ(std::memcmp(buffer.data(), remote.data() + 1000, 24), 0);
+
+        for (int i = 0; i < 500 && cache.json()["prefetched"] != 2; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        EXPECT_EQ(cache.json()["prefetched"], 2);
+
+        EXPECT_EQ(cache.read("http://host/movie.mov", 1024, buffer.data(), 2048), 1024);
+        EXPECT_EQ(std::memcmp(buffer.data(), remote.data() + 1024, 1024), 0);
+        EXPECT_EQ(cache.json()["hits"], 1);
+
+        // the last chunk is short, and then it's the end of the file
+        EXPECT_EQ(cache.read("http://host/movie.mov", chunk * 9, buffer.data(), chunk), 924);
+        EXPECT_EQ(cache.read("http://host/movie.mov", remote.size(), buffer.data(), chunk), 0);
+
+        // never more than the budget on disk
+        for (size_t pos = 0; pos < remote.size(); pos += chunk)
+            cache.read("http://host/movie.mov", pos, buffer.data(), chunk);
+        EXPECT_LE(cache.bytes(), chunk * 6);
+        EXPECT_GT(cache.json()["evicted"].get<int>(), 0);
+    }
+
+    // another session finds what's left on disk
+    fetches = 0;
+    {
+        RemoteByteCache cache(stat_func, fetch_func, chunk);
+        cache.configure(dir.string(), chunk * 6, 0);
+        EXPECT_GT(cache.bytes(), size_t(0));
+
+        std::vector<uint8_t> buffer(chunk);
+        EXPECT_EQ(cache.read("http://host/movie.mov", chunk * 9, buffer.data(), chunk), 924);
+        EXPECT_EQ(std::memcmp(buffer.data(), remote.data() + chunk * 9, 924), 0);
+        EXPECT_EQ(fetches, 0);
+    }
+
+    // the file was replaced on the server with one of the same size, so
+    // nothing kept from before is used
+    etag = "\"2\"";
+    remote[chunk * 9] = char(remote[chunk * 9] + 1);
+    fetches           = 0;
+    {
+        RemoteByteCache cache(stat_func, fetch_func, chunk);
+        cache.configure(dir.string(), chunk * 6, 0);
+
+        std::vector<uint8_t> buffer(chunk);
+        EXPECT_EQ(cache.read("http://host/movie.mov", chunk * 9, buffer.data(), chunk), 924);
+        EXPECT_EQ(std::memcmp(buffer.data(), remote.data() + chunk * 9, 924), 0);
+        EXPECT_EQ(fetches, 1);
+        EXPECT_EQ(cache.bytes(), size_t(924));
+    }
+
+    // https without a validator is fetched again every session
+    etag = "";
+    for (int session = 0; session < 2; ++session) {
+        fetches = 0;
+        RemoteByteCache cache(stat_func, fetch_func, chunk);
+        cache.configure(dir.string(), chunk * 6, 0);
+
+        std::vector<uint8_t> buffer(chunk);
+        EXPECT_EQ(cache.read("https://host/movie.mov", 0, buffer.data(), chunk), 1024);
+        EXPECT_EQ(std::memcmp(buffer.data(), remote.data(), 1024), 0);
+        EXPECT_EQ(fetches, 1);
+
+        // but is kept for the rest of the session
+        EXPECT_EQ(cache.read("https://host/movie.mov", 0, buffer.data(), chunk), 1024);
+        EXPECT_EQ(fetches, 1);
+    }
+
+    fs::remove_all(dir);
+}
@@ -19,6 +19,9 @@
 #include <ImfTimeCodeAttribute.h>
 #include <ImfIntAttribute.h>
 #include <ImfVecAttribute.h>
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
 
 #include "xstudio/media/media_error.hpp"
 #include "xstudio/media_reader/media_reader.hpp"
@@ -78,6 +81,24 @@ bool crop_data_window(
     return in_data_window != data_window;
 }
 
+// channel layouts are cached per sequence and stream, this many at most
+const size_t max_cached_layouts = 256;
+
+/* The path with the frame number (the last run of digits in the file name)
+swapped for '#', so that every frame in a sequence gives the same pattern */
+std::string sequence_pattern(const std::string &path) {
+    const size_t name_start = path.find_last_of('/') + 1;
+    size_t end              = path.size();
+    while (end > name_start && !std::isdigit(static_cast<unsigned char>(path[end - 1])))
+        end--;
+    size_t start = end;
+    while (start > name_start && std::isdigit(static_cast<unsigned char>(path[start - 1])))
+        start--;
+    if (start == end)
+        return path;
+    return path.substr(0, start) + "#" + path.substr(end);
+}
+
 static Uuid openexr_shader_uuid{"1c9259fc-46a5-11ea-87fe-989096adb429"};
 static std::string shader{R"(
 #version 410 core
@@ -89,6 +110,8 @@ uniform int pix_type_g;
 uniform int pix_type_b;
 uniform int pix_type_a;
 uniform int bytes_per_pixel;
+uniform int line_stride;
+uniform int packed_half;
 uniform ivec2 image_bounds_min;
 uniform ivec2 image_bounds_max;
 
@@ -102,7 +125,22 @@ vec4 fetch_rgba_pixel(ivec2 image_coord)
     if (image_coord.x < image_bounds_min.x || image_coord.x >= image_bounds_max.x) return vec4(0.0,0.0,0.0,0.0);
 	if (image_coord.y < image_bounds_min.y || image_coord.y >= image_bounds_max.y) return vec4(0.0,0.0,0.0,0.0);
 
-    int pixel_address_bytes = ((image_coord.x-image_bounds_min.x) + (image_coord.y-image_bounds_min.y)*(image_bounds_max.x-image_bounds_min.x))*bytes_per_pixel;
+    int pixel_address_bytes = (image_coord.x-image_bounds_min.x)*bytes_per_pixel +
+        (image_coord.y-image_bounds_min.y)*line_stride;
+
+    if (packed_half == 1) {
+        // RGBA or RGB halves, rows start on a 4 byte boundary so every fetch
+        // is aligned
+        if (bytes_per_pixel == 8) {
+            vec2 rg = get_image_data_2floats(pixel_address_bytes);
+            return vec4(rg, get_image_data_2floats(pixel_address_bytes+4));
+        } else if ((pixel_address_bytes & 3) == 0) {
+            vec2 rg = get_image_data_2floats(pixel_address_bytes);
+            return vec4(rg, get_image_data_2floats(pixel_address_bytes+4).x, 1.0);
+        }
+        float r = get_image_data_2floats(pixel_address_bytes-2).y;
+        return vec4(r, get_image_data_2floats(pixel_address_bytes+2), 1.0);
+    }
 
     float R = 0.9;
     float G = 0.4;
@@ -183,6 +221,7 @@ OpenEXRMediaReader::OpenEXRMediaReader(const utility::JsonStore &prefs)
     Imf::setGlobalThreadCount(16);
     max_exr_overscan_percent_ = 5.0f;
     readers_per_source_       = 1;
+    float_as_half_            = false;
 
     update_preferences(prefs);
 }
@@ -202,6 +241,12 @@ void OpenEXRMediaReader::update_preferences(const utility::JsonStore &prefs) {
     } catch (const std::exception &e) {
         spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
     }
+    try {
+        float_as_half_ =
+            preference_value<bool>(prefs, "/plugin/media_reader/OpenEXR/float_as_half");
+    } catch (const std::exception &e) {
+        spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
+    }
 }
 
 ImageBufPtr OpenEXRMediaReader::image(const media::AVFrameID &mptr) {
@@ -211,67 +256,27 @@ ImageBufPtr OpenEXRMediaReader::image(const media::AVFrameID &mptr) {
     // DebugTimer dd(path);
 
     Imf::MultiPartInputFile input(path.c_str());
-    int parts    = input.parts();
-    int part_idx = -1;
-    std::array<Imf::PixelType, 4> pix_type;
-    std::vector<std::string> exr_channels_to_load;
-
-    for (int prt = 0; prt < parts; ++prt) {
-        // skip incomplete parts - maybe better error/handling messaging required?
-        const Imf::Header &part_header = input.header(prt);
-        std::vector<std::string> stream_ids;
-        stream_ids_from_exr_part(part_header, stream_ids);
-        for (const auto &stream_id : stream_ids) {
-            if (stream_id == mptr.stream_id()) {
-                pix_type = pick_exr_channels_from_stream_id(
-                    part_header, mptr.stream_id(), exr_channels_to_load);
-                part_idx = prt;
-            }
-        }
-    }
-
-    if (part_idx == -1) {
-        // When an EXR sequence is added to an xSTUDIO session, xSTUDIO opens
-        // the middle frame in the sequence and inspects it to see what parts
-        // and channels there are in that file. A MediaStream is then created
-        // for each part or layer in that EXR.
-        // It is possible that other EXRs in the sequence have different parts
-        // or layers, however. What do we do then? All we can do is just pick
-        // the first part to load as a dumb fallback.
-        // It's not reasonable to expect xSTUDIO to be able to predict how to
-        // load an EXR sequence where the parts/layers in the files are not
-        // consistent
-        const Imf::Header &part_header = input.header(0);
-        std::vector<std::string> stream_ids;
-        stream_ids_from_exr_part(part_header, stream_ids);
-        if (stream_ids.empty()) {
-            std::stringstream ss;
-            ss << "Unable to find readable layer/stream in part 0 for file \"" << path
-               << "\"\n";
-            throw std::runtime_error(ss.str().c_str());
-        }
-        pix_type =
-            pick_exr_channels_from_stream_id(part_header, stream_ids[0], exr_channels_to_load);
-        part_idx = 0;
-    }
-
-    if (exr_channels_to_load.empty()) {
-        std::stringstream ss;
-        ss << "The parts, channels or layers in file \"" << path
-           << "\" are inconsistent with other EXR files in the sequence.\n";
-        throw std::runtime_error(ss.str().c_str());
+    const auto layout = exr_layout(input, path, mptr.stream_id());
+
+    const int part_idx                                   = layout.part_idx;
+    const std::vector<std::string> &exr_channels_to_load = layout.channels;
+
+    // RGB(A) halves are read straight into the layout the shader and the
+    // CPU consumers read fastest: 3 or 4 halves a pixel and rows starting on
+    // a 4 byte boundary. OpenEXR converts float channels to half as it
+    // decodes when float_as_half_ is set.
+    std::array<Imf::PixelType, 4> pix_type = layout.pix_type;
+    bool packed_half = exr_channels_to_load.size() >= 3 and exr_channels_to_load.size() <= 4;
+    for (size_t i = 0; i < exr_channels_to_load.size() and packed_half; ++i)
+        packed_half = pix_type[i] == Imf::PixelType::HALF or
+                      (float_as_half_ and pix_type[i] == Imf::PixelType::FLOAT);
+    if (packed_half) {
+        for (size_t i = 0; i < exr_channels_to_load.size(); ++i)
+            pix_type[i] = Imf::PixelType::HALF;
     }
 
     Imf::InputPart in(input, part_idx);
 
-    utility::JsonStore part_metadata;
-    try {
-        const Imf::Header &h = in.header();
-        exr_reader::dump_json_headers(h, part_metadata.ref());
-    } catch (const std::exception &e) {
-        part_metadata["METADATA LOAD ERROR"] = e.what();
-    }
-
     Imath::Box2i data_window    = in.header().dataWindow();
     Imath::Box2i display_window = in.header().displayWindow();
 
@@ -280,7 +285,6 @@ ImageBufPtr OpenEXRMediaReader::image(const media::AVFrameID &mptr) {
         crop_data_window(data_window, display_window, max_exr_overscan_percent_);
 
     // compute the size of the buffer we need
-    const size_t n_pixels = (data_window.size().x + 1) * (data_window.size().y + 1);
     const size_t bytes_per_channel_r =
         (pix_type[0] == -1                     ? 0
          : pix_type[0] == Imf::PixelType::HALF ? 2
@@ -299,7 +303,9 @@ ImageBufPtr OpenEXRMediaReader::image(const media::AVFrameID &mptr) {
                                                : 4);
     const size_t bytes_per_pixel =
         bytes_per_channel_r + bytes_per_channel_g + bytes_per_channel_b + bytes_per_channel_a;
-    const size_t buf_size = n_pixels * bytes_per_pixel;
+    const size_t line_bytes  = (data_window.size().x + 1) * bytes_per_pixel;
+    const size_t line_stride = packed_half ? (line_bytes + 3) & ~size_t(3) : line_bytes;
+    const size_t buf_size = line_stride * (data_window.size().y + 1);
 
     // const size_t gl_line_size = 8192*4;
     // const size_t padded_buf_size = (buf_size & (gl_line_size-1)) ?
@@ -312,6 +318,8 @@ ImageBufPtr OpenEXRMediaReader::image(const media::AVFrameID &mptr) {
     jsn["pix_type_b"]      = int(pix_type[2]);
     jsn["pix_type_a"]      = int(pix_type[3]);
     jsn["bytes_per_pixel"] = int(bytes_per_pixel);
+    jsn["line_stride"]     = int(line_stride);
+    jsn["packed_half"]     = int(packed_half);
     // jsn["path"] = to_string(mptr.uri());
 
     ImageBufPtr buf(new ImageBuffer(openexr_shader_uuid, jsn));
@@ -323,7 +331,18 @@ ImageBufPtr OpenEXRMediaReader::image(const media::AVFrameID &mptr) {
         memset(b, 0, buf_size);
     }
 
-    buf->set_metadata(part_metadata);
+    // converting the header to json can cost as much as decoding the pixels
+    // for EXRs with lots of attributes, so keep a copy of the header and only
+    // convert it if something wants to show the metadata
+    buf->set_metadata_loader([header = std::make_shared<const Imf::Header>(in.header())]() {
+        utility::JsonStore part_metadata;
+        try {
+            exr_reader::dump_json_headers(*header, part_metadata.ref());
+        } catch (const std::exception &e) {
+            part_metadata["METADATA LOAD ERROR"] = e.what();
+        }
+        return part_metadata;
+    });
 
     // 4th channel is always put into 'alpha' channel as per shader code
     // above
@@ -341,17 +360,22 @@ ImageBufPtr OpenEXRMediaReader::image(const media::AVFrameID &mptr) {
     buf->params()["channel_names"] = exr_channels_to_load;
     buf->params()["stream_id"]     = mptr.stream_id();
 
-    if (cropped_data_window) {
+    // rows outside the crop are simply not read, only a crop across the rows
+    // needs the pixels read somewhere else first
+    const Imath::Box2i actual_data_window = in.header().dataWindow();
+    const bool cropped_columns            = cropped_data_window and
+                                 (data_window.min.x != actual_data_window.min.x or
+                                  data_window.max.x != actual_data_window.max.x);
+
+    if (cropped_columns) {
         // if we are not loading the whole data window, we need to provide a temporary
         // buffer that matches the EXR data window width for OpenEXR to load pixels into, we
         // then copy the pixels we want into our cropped image buffer. We do this in chunks
         // in the Y dimension to take advantage of OpenEXR decompress threads that are
         // (possibly) more efficient when decoding blocks of pixels at once
-        const Imath::Box2i actual_data_window = in.header().dataWindow();
         const size_t actual_data_window_width = actual_data_window.size().x + 1;
-        const size_t line_stride              = actual_data_window_width * bytes_per_pixel;
-        const size_t cropped_line_stride      = (data_window.size().x + 1) * bytes_per_pixel;
-        Imf::FrameBuffer fb;
+        const size_t tmp_line_stride          = actual_data_window_width * bytes_per_pixel;
+        const size_t cropped_line_bytes       = (data_window.size().x + 1) * bytes_per_pixel;
 
         std::vector<uint8_t> tmp_buf(
             bytes_per_pixel * actual_data_window_width * EXR_READ_BLOCK_HEIGHT);
@@ -362,8 +386,10 @@ ImageBufPtr OpenEXRMediaReader::image(const media::AVFrameID &mptr) {
         for (int chunk_y_min = data_window.min.y; chunk_y_min < data_window.max.y;
              chunk_y_min += EXR_READ_BLOCK_HEIGHT) {
 
+            ReadCancelToken::throw_if_cancelled();
+
             uint8_t *fPtr = tmp_buf.data() - actual_data_window.min.x * bytes_per_pixel -
-                            chunk_y_min * line_stride;
+                            chunk_y_min * tmp_line_stride;
 
             Imf::FrameBuffer fb;
             int ii = 0;
@@ -375,7 +401,13 @@ ImageBufPtr OpenEXRMediaReader::image(const media::AVFrameID &mptr) {
                     fb.insert(
                         chan_name.c_str(),
                         Imf::Slice(
-                            channel_type, (char *)fPtr, bytes_per_pixel, line_stride, 1, 1, 0));
+                            channel_type,
+                            (char *)fPtr,
+                            bytes_per_pixel,
+                            tmp_line_stride,
+                            1,
+                            1,
+                            0));
                     fPtr += channel_type == Imf::PixelType::HALF ? 2 : 4;
                 });
             in.setFrameBuffer(fb);
@@ -394,9 +426,9 @@ ImageBufPtr OpenEXRMediaReader::image(const media::AVFrameID &mptr) {
             fPtr = tmp_buf.data() +
                    (data_window.min.x - actual_data_window.min.x) * bytes_per_pixel;
             for (int l = chunk_y_min; l <= ymax; ++l) {
-                memcpy(buffer, fPtr, cropped_line_stride);
-                buffer += cropped_line_stride;
-                fPtr += line_stride;
+                memcpy(buffer, fPtr, cropped_line_bytes);
+                buffer += line_stride;
+                fPtr += tmp_line_stride;
             }
         }
 
@@ -412,8 +444,6 @@ ImageBufPtr OpenEXRMediaReader::image(const media::AVFrameID &mptr) {
 
     } else {
 
-        const size_t line_stride =
-            (data_window.max.x - data_window.min.x + 1) * bytes_per_pixel;
         byte *buffer = buf->buffer() - data_window.min.x * bytes_per_pixel -
                        data_window.min.y * line_stride;
 
@@ -434,7 +464,15 @@ ImageBufPtr OpenEXRMediaReader::image(const media::AVFrameID &mptr) {
             });
         in.setFrameBuffer(fb);
         try {
-            in.readPixels(data_window.min.y, data_window.max.y);
+            // in blocks, so that a stale or preempted read can be abandoned
+            // part way through the frame
+            for (int chunk_y_min = data_window.min.y; chunk_y_min <= data_window.max.y;
+                 chunk_y_min += EXR_READ_BLOCK_HEIGHT) {
+                ReadCancelToken::throw_if_cancelled();
+                in.readPixels(
+                    chunk_y_min,
+                    std::min(chunk_y_min + EXR_READ_BLOCK_HEIGHT - 1, data_window.max.y));
+            }
         } catch (Iex::InputExc &e) {
             // probably a partial EXR, but we've loaded some scanlines.
             // We need a unique key incase the user hits reload and we load
@@ -448,6 +486,99 @@ ImageBufPtr OpenEXRMediaReader::image(const media::AVFrameID &mptr) {
     return buf;
 }
 
+OpenEXRMediaReader::ExrLayout OpenEXRMediaReader::exr_layout(
+    Imf::MultiPartInputFile &input, const std::string &path, const std::string &stream_id) {
+
+    // the signature is the part names and their channel names and types,
+    // which is all the layout depends on
+    std::string signature;
+    for (int prt = 0; prt < input.parts(); ++prt) {
+        const Imf::Header &part_header = input.header(prt);
+        signature += part_header.hasName() ? part_header.name() : std::string();
+        signature += "|";
+        const auto &channels = part_header.channels();
+        for (Imf::ChannelList::ConstIterator i = channels.begin(); i != channels.end(); ++i) {
+            signature += i.name();
+            signature += ":" + std::to_string(int(i.channel().type)) + ",";
+        }
+        signature += "\n";
+    }
+
+    const std::string key = sequence_pattern(path) + "|" + stream_id;
+    {
+        std::lock_guard<std::mutex> lock(layout_cache_mutex_);
+        auto p = layout_cache_.find(key);
+        if (p != layout_cache_.end() && p->second.part_signature == signature)
+            return p->second;
+    }
+
+    auto layout           = make_exr_layout(input, path, stream_id);
+    layout.part_signature = std::move(signature);
+
+    std::lock_guard<std::mutex> lock(layout_cache_mutex_);
+    if (layout_cache_.size() >= max_cached_layouts)
+        layout_cache_.clear();
+    layout_cache_[key] = layout;
+    return layout;
+}
+
+OpenEXRMediaReader::ExrLayout OpenEXRMediaReader::make_exr_layout(
+    Imf::MultiPartInputFile &input,
+    const std::string &path,
+    const std::string &stream_id) const {
+
+    ExrLayout layout;
+    const int parts = input.parts();
+
+    for (int prt = 0; prt < parts; ++prt) {
+        // skip incomplete parts - maybe better error/handling messaging required?
+        const Imf::Header &part_header = input.header(prt);
+        std::vector<std::string> stream_ids;
+        stream_ids_from_exr_part(part_header, stream_ids);
+        for (const auto &id : stream_ids) {
+            if (id == stream_id) {
+                layout.pix_type =
+                    pick_exr_channels_from_stream_id(part_header, stream_id, layout.channels);
+                layout.part_idx = prt;
+            }
+        }
+    }
+
+    if (layout.part_idx == -1) {
+        // When an EXR sequence is added to an xSTUDIO session, xSTUDIO opens
+        // the middle frame in the sequence and inspects it to see what parts
+        // and channels there are in that file. A MediaStream is then created
+        // for each part or layer in that EXR.
+        // It is possible that other EXRs in the sequence have different parts
+        // or layers, however. What do we do then? All we can do is just pick
+        // the first part to load as a dumb fallback.
+        // It's not reasonable to expect xSTUDIO to be able to predict how to
+        // load an EXR sequence where the parts/layers in the files are not
+        // consistent
+        const Imf::Header &part_header = input.header(0);
+        std::vector<std::string> stream_ids;
+        stream_ids_from_exr_part(part_header, stream_ids);
+        if (stream_ids.empty()) {
+            std::stringstream ss;
+            ss << "Unable to find readable layer/stream in part 0 for file \"" << path
+               << "\"\n";
+            throw std::runtime_error(ss.str().c_str());
+        }
+        layout.pix_type =
+            pick_exr_channels_from_stream_id(part_header, stream_ids[0], layout.channels);
+        layout.part_idx = 0;
+    }
+
+    if (layout.channels.empty()) {
+        std::stringstream ss;
+        ss << "The parts, channels or layers in file \"" << path
+           << "\" are inconsistent with other EXR files in the sequence.\n";
+        throw std::runtime_error(ss.str().c_str());
+    }
+
+    return layout;
+}
+
 MRCertainty
 OpenEXRMediaReader::supported(const caf::uri &, const std::array<uint8_t, 16> &sig) {
     if (sig[0] == 0x76 && sig[1] == 0x2f && sig[2] == 0x31 && sig[3] == 0x01)
@@ -590,9 +721,11 @@ std::array<Imf::PixelType, 4> OpenEXRMediaReader::pick_exr_channels_from_stream_
     int ii = 0;
     for (const auto &chan_name : exr_channels_to_load) {
 
-        pix_type[ii] = Imf::PixelType::UINT;
+        // uint channels are read as float, OpenEXR converting them as it fills
+        // the frame buffer, as the shader and the cpu unpack only know half/float
+        pix_type[ii] = Imf::PixelType::FLOAT;
         for (Imf::ChannelList::ConstIterator i = channels.begin(); i != channels.end(); ++i) {
-            if (i.name() == chan_name) {
+            if (i.name() == chan_name && i.channel().type != Imf::PixelType::UINT) {
                 pix_type[ii] = i.channel().type;
             }
         }
@@ -761,6 +894,8 @@ PixelInfo OpenEXRMediaReader::exr_buffer_pixel_picker(
     int pix_type_a                    = buf.shader_params().value("pix_type_a", 0);
     const Imath::V2i image_bounds_min = buf.image_pixels_bounding_box().min;
     const Imath::V2i image_bounds_max = buf.image_pixels_bounding_box().max;
+    const int line_stride             = buf.shader_params().value(
+        "line_stride", (image_bounds_max.x - image_bounds_min.x) * bytes_per_pixel);
 
     std::vector<std::string> channel_names;
     auto chan_names = buf.params()["channel_names"];
@@ -850,10 +985,8 @@ PixelInfo OpenEXRMediaReader::exr_buffer_pixel_picker(
     if (pixel_location.y < image_bounds_min.y || pixel_location.y >= image_bounds_max.y)
         return r;
 
-    int pixel_address_bytes =
-        ((pixel_location.x - image_bounds_min.x) +
-         (pixel_location.y - image_bounds_min.y) * (image_bounds_max.x - image_bounds_min.x)) *
-        bytes_per_pixel;
+    int pixel_address_bytes = (pixel_location.x - image_bounds_min.x) * bytes_per_pixel +
+                              (pixel_location.y - image_bounds_min.y) * line_stride;
 
     Imath::V2f pixRG = get_image_data_2xhalf_float(pixel_address_bytes);
 
@@ -908,13 +1041,117 @@ PixelInfo OpenEXRMediaReader::exr_buffer_pixel_picker(
             p.y >= image_bounds_max.y) {
             r.add_extra_pixel_raw_rgba(Imath::V4f(0.0f, 0.0f, 0.0f, 0.0f));
         } else {
-            int pixel_address_bytes =
-                ((p.x - image_bounds_min.x) +
-                 (p.y - image_bounds_min.y) * (image_bounds_max.x - image_bounds_min.x)) *
-                bytes_per_pixel;
+            int pixel_address_bytes = (p.x - image_bounds_min.x) * bytes_per_pixel +
+                                      (p.y - image_bounds_min.y) * line_stride;
             r.add_extra_pixel_raw_rgba(get_pixel_rgba(pixel_address_bytes));
         }
     }
 
     return r;
-}
\ No newline at end of file
+}
+
+/*
+ *
+ * CPU equivalent of the glsl unpack shader, for software rendering. Decodes a
+ * whole scanline at a time with fast paths for the packed half RGBA and RGB
+ * layouts.
+ *
+ */
+void OpenEXRMediaReader::exr_buffer_scanline_unpack(
+    const ImageBuffer &buf, const int line, float *rgba_out) {
+
+    const Imath::Box2i bounds = buf.image_pixels_bounding_box();
+    const int width           = bounds.max.x - bounds.min.x;
+    const int num_channels    = buf.shader_params().value("num_channels", 0);
+    const int bytes_per_pixel = buf.shader_params().value("bytes_per_pixel", 0);
+    const std::array<int, 4> pix_types{
+        buf.shader_params().value("pix_type_r", -1),
+        buf.shader_params().value("pix_type_g", -1),
+        buf.shader_params().value("pix_type_b", -1),
+        buf.shader_params().value("pix_type_a", -1)};
+
+    const size_t line_stride = buf.shader_params().value(
+        "line_stride", size_t(std::max(width, 0)) * bytes_per_pixel);
+    const size_t line_offset = size_t(line - bounds.min.y) * line_stride;
+
+    if (width <= 0 || line < bounds.min.y || line >= bounds.max.y || !bytes_per_pixel ||
+        line_offset + size_t(width) * bytes_per_pixel > buf.size()) {
+        std::fill(rgba_out, rgba_out + std::max(width, 0) * 4, 0.0f);
+        return;
+    }
+
+    const auto *src = reinterpret_cast<const uint8_t *>(buf.buffer()) + line_offset;
+
+    if (num_channels == 4 && bytes_per_pixel == 8) {
+        // 4 x half, which is by far the most common layout
+        const auto *h = reinterpret_cast<const half *>(src);
+#if defined(__F16C__)
+        for (int x = 0; x < width; ++x) {
+            const __m128i hv = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(h + x * 4));
+            _mm_storeu_ps(rgba_out + x * 4, _mm_cvtph_ps(hv));
+        }
+#else
+        for (int i = 0; i < width * 4; ++i) {
+            rgba_out[i] = h[i];
+        }
+#endif
+        return;
+    }
+
+    if (num_channels == 3 && bytes_per_pixel == 6 &&
+        std::all_of(pix_types.begin(), pix_types.begin() + 3, [](const int t) {
+            return t == Imf::PixelType::HALF;
+        })) {
+        // 3 x half, 4 are converted at a time so the last pixel, which may
+        // end the buffer, is done on its own
+        const auto *h = reinterpret_cast<const half *>(src);
+        int x         = 0;
+#if defined(__F16C__)
+        for (; x < width - 1; ++x) {
+            const __m128i hv = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(h + x * 3));
+            _mm_storeu_ps(rgba_out + x * 4, _mm_cvtph_ps(hv));
+            rgba_out[x * 4 + 3] = 1.0f;
+        }
+#endif
+        for (; x < width; ++x) {
+            rgba_out[x * 4]     = h[x * 3];
+            rgba_out[x * 4 + 1] = h[x * 3 + 1];
+            rgba_out[x * 4 + 2] = h[x * 3 + 2];
+            rgba_out[x * 4 + 3] = 1.0f;
+        }
+        return;
+    }
+
+    // general case - step through the interleaved channels
+    std::array<int, 4> offsets{0, 0, 0, 0};
+    int offset = 0;
+    for (int c = 0; c < std::min(num_channels, 4); ++c) {
+        offsets[c] = offset;
+        offset += pix_types[c] == Imf::PixelType::HALF ? 2 : 4;
+    }
+
+    auto channel = [&](const uint8_t *pix, const int c) -> float {
+        if (pix_types[c] == Imf::PixelType::HALF)
+            return float(*reinterpret_cast<const half *>(pix + offsets[c]));
+        float f;
+        memcpy(&f, pix + offsets[c], sizeof(float));
+        return f;
+    };
+
+    for (int x = 0; x < width; ++x, src += bytes_per_pixel, rgba_out += 4) {
+        const float r = channel(src, 0);
+        if (num_channels == 1) {
+            rgba_out[0] = rgba_out[1] = rgba_out[2] = r;
+            rgba_out[3]                             = 1.0f;
+        } else if (num_channels == 2) {
+            // luminance/alpha
+            rgba_out[0] = rgba_out[1] = rgba_out[2] = r;
+            rgba_out[3]                             = channel(src, 1);
+        } else {
+            rgba_out[0] = r;
+            rgba_out[1] = channel(src, 1);
+            rgba_out[2] = channel(src, 2);
+            rgba_out[3] = num_channels > 3 ? channel(src, 3) : 1.0f;
+        }
+    }
+}
@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <map>
+#include <mutex>
 #include <string>
 
 #include "xstudio/media_reader/media_reader.hpp"
@@ -8,6 +10,7 @@
 #include "xstudio/utility/helpers.hpp"
 #include <ImfChannelList.h>
 #include <ImfHeader.h> // staticInitialize
+#include <ImfMultiPartInputFile.h>
 
 namespace xstudio {
 namespace media_reader {
@@ -32,6 +35,9 @@ namespace media_reader {
         [[nodiscard]] ImageBuffer::PixelPickerFunc pixel_picker_func() const override {
             return &OpenEXRMediaReader::exr_buffer_pixel_picker;
         }
+        [[nodiscard]] ImageBuffer::ScanlineUnpackFunc scanline_unpack_func() const override {
+            return &OpenEXRMediaReader::exr_buffer_scanline_unpack;
+        }
 
       private:
         static PixelInfo exr_buffer_pixel_picker(
@@ -39,6 +45,9 @@ namespace media_reader {
             const Imath::V2i &pixel_location,
             const std::vector<Imath::V2i> &extra_pixel_locationss);
 
+        static void
+        exr_buffer_scanline_unpack(const ImageBuffer &buf, const int line, float *rgba_out);
+
         void get_channel_names_by_layer(
             const Imf::Header &header,
             std::map<std::string, std::vector<std::string>> &channel_names_by_layer) const;
@@ -51,8 +60,34 @@ namespace media_reader {
             const std::string &stream_id,
             std::vector<std::string> &exr_channels_to_load) const;
 
+        // Which part and channels to load for a stream, worked out from the
+        // part headers. Frames in a sequence nearly always share their
+        // layout, so this is cached per sequence and stream and only worked
+        // out again when the parts' names or channels change.
+        struct ExrLayout {
+            std::string part_signature;
+            int part_idx = {-1};
+            std::array<Imf::PixelType, 4> pix_type;
+            std::vector<std::string> channels;
+        };
+
+        ExrLayout exr_layout(
+            Imf::MultiPartInputFile &input,
+            const std::string &path,
+            const std::string &stream_id);
+
+        ExrLayout make_exr_layout(
+            Imf::MultiPartInputFile &input,
+            const std::string &path,
+            const std::string &stream_id) const;
+
         float max_exr_overscan_percent_;
         int readers_per_source_;
+        // float channels are read as half, for the packed half layout
+        bool float_as_half_;
+
+        std::mutex layout_cache_mutex_;
+        std::map<std::string, ExrLayout> layout_cache_;
     };
 } // namespace media_reader
 } // namespace xstudio
@@ -35,3 +35,19 @@ TEST(OpenEXRMediaReaderTest, Test) {
 
     EXPECT_TRUE(got_image) << "Should be supported";
 }
+
+TEST(OpenEXRMediaReaderTest, CachedLayoutAndLazyMetadata) {
+    OpenEXRMediaReader mr;
+    caf::uri good = posix_path_to_uri(TEST_RESOURCE "/media/test.0001.exr");
+
+    // the second read uses the channel layout worked out for the first
+    auto first  = mr.image(media::AVFrameID(good));
+    auto second = mr.image(media::AVFrameID(good));
+    ASSERT_TRUE(first && second);
+    EXPECT_EQ(first->params()["channel_names"], second->params()["channel_names"]);
+
+    // the header is only turned into json when asked for
+    EXPECT_FALSE(second->metadata().empty());
+    EXPECT_EQ(first->metadata(), second->metadata());
+    EXPECT_TRUE(first.metadata().contains("uri"));
+}
@@ -0,0 +1,841 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <array>
+#include <fstream>
+#include <sstream>
+
+#include "video_render_encoder.hpp"
+#include "xstudio/utility/logging.hpp"
+
+extern "C" {
+#include <libavutil/pixdesc.h>
+}
+
+using namespace xstudio;
+using namespace xstudio::video_render_plugin_1_0;
+
+namespace {
+
+std::string av_error(const int error) {
+    std::array<char, AV_ERROR_MAX_STRING_SIZE> buf;
+    if (av_strerror(error, buf.data(), buf.size()))
+        return fmt::format("unknown error {}", error);
+    return buf.data();
+}
+
+void av_check(const int error, const char *what) {
+    if (error < 0)
+        throw std::runtime_error(fmt::format("{} failed: {}", what, av_error(error)));
+}
+
+double seconds(const std::chrono::steady_clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+}
+
+struct InputDeleter {
+    void operator()(AVFormatContext *ctx) const { avformat_close_input(&ctx); }
+};
+typedef std::unique_ptr<AVFormatContext, InputDeleter> InputPtr;
+
+// a chunk opened for reading, and the index of its video stream
+std::pair<InputPtr, int> open_chunk(const std::string &path) {
+    AVFormatContext *ctx = nullptr;
+    av_check(avformat_open_input(&ctx, path.c_str(), nullptr, nullptr), "avformat_open_input");
+    InputPtr input(ctx);
+    av_check(avformat_find_stream_info(ctx, nullptr), "avformat_find_stream_info");
+    const int index = av_find_best_stream(ctx, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    av_check(index, "av_find_best_stream");
+    return std::make_pair(std::move(input), index);
+}
+
+// The presets hold ffmpeg command line options for one stream, like
+// "-c:v libx264 -pix_fmt yuv420p -preset medium". The codec, pixel format and
+// audio layout options are picked out, everything else goes into a dictionary
+// for avcodec_open2 (and then the muxer) to make sense of.
+struct CodecOptions {
+    CodecOptions(const std::string &opts, const char stream_type) {
+        std::vector<std::string> tokens;
+        std::istringstream in(opts);
+        for (std::string token; in >> token;)
+            tokens.push_back(token);
+
+        for (size_t i = 0; i < tokens.size(); ++i) {
+            const auto &token = tokens[i];
+            if (token.size() < 2 || token[0] != '-' || i + 1 == tokens.size())
+                throw std::runtime_error(fmt::format("Unsupported option {}", token));
+
+            auto name       = token.substr(1);
+            const auto spec = name.find(':');
+            if (spec != std::string::npos) {
+                // options for other streams can't be applied to this one
+                if (name.substr(spec + 1) != std::string(1, stream_type))
+                    throw std::runtime_error(fmt::format("Unsupported option {}", token));
+                name = name.substr(0, spec);
+            }
+
+            const auto &value = tokens[++i];
+            if (name == "c" || name == "codec" || name == "vcodec" || name == "acodec")
+                codec = value;
+            else if (name == "pix_fmt")
+                pix_fmt = value;
+            else if (name == "ac")
+                channels = std::stoi(value);
+            else if (name == "ar")
+                sample_rate = std::stoi(value);
+            else
+                av_dict_set(&dict, name.c_str(), value.c_str(), 0);
+        }
+    }
+
+    ~CodecOptions() { av_dict_free(&dict); }
+
+    std::string codec;
+    std::string pix_fmt;
+    int channels       = {0};
+    int sample_rate    = {0};
+    AVDictionary *dict = {nullptr};
+};
+
+} // namespace
+
+NativeEncoder::NativeEncoder(
+    const std::string &output_path,
+    const Imath::V2i &resolution,
+    const double frame_rate,
+    const bool is_16_bit,
+    const std::string &video_codec_opts,
+    const std::string &audio_codec_opts,
+    const int audio_sample_rate,
+    ReadyFunc ready,
+    DoneFunc done,
+    const size_t queue_depth)
+    : ready_(std::move(ready)),
+      done_(std::move(done)),
+      src_pix_fmt_(is_16_bit ? AV_PIX_FMT_RGBA64 : AV_PIX_FMT_RGBA),
+      frame_rate_(av_d2q(frame_rate, 100000)),
+      audio_sample_rate_(audio_sample_rate),
+      queue_depth_(std::max(queue_depth, size_t(1))),
+      input_(queue_depth_ * 2),
+      encodable_(queue_depth_),
+      started_(std::chrono::steady_clock::now()) {
+
+    AVDictionary *format_opts = nullptr;
+
+    try {
+        av_check(
+            avformat_alloc_output_context2(
+                &format_ctx_, nullptr, nullptr, output_path.c_str()),
+            "avformat_alloc_output_context2");
+
+        open_video(video_codec_opts, resolution, &format_opts);
+        if (!audio_codec_opts.empty())
+            open_audio(audio_codec_opts, &format_opts);
+        open_output(output_path, &format_opts);
+
+    } catch (...) {
+        av_dict_free(&format_opts);
+        cleanup();
+        throw;
+    }
+
+    convert_thread_ = std::thread(&NativeEncoder::run_convert, this);
+    encode_thread_  = std::thread(&NativeEncoder::run_encode, this);
+}
+
+NativeEncoder::NativeEncoder(
+    const std::string &output_path,
+    const std::vector<std::string> &video_files,
+    const std::vector<std::string> &audio_files,
+    const double frame_rate,
+    const std::string &audio_codec_opts,
+    const int audio_sample_rate,
+    DoneFunc done,
+    const size_t queue_depth)
+    : done_(std::move(done)),
+      src_pix_fmt_(AV_PIX_FMT_NONE),
+      frame_rate_(av_d2q(frame_rate, 100000)),
+      audio_sample_rate_(audio_sample_rate),
+      queue_depth_(std::max(queue_depth, size_t(1))),
+      input_(queue_depth_ * 2),
+      encodable_(queue_depth_),
+      started_(std::chrono::steady_clock::now()) {
+
+    AVDictionary *format_opts = nullptr;
+
+    try {
+        if (video_files.empty())
+            throw std::runtime_error("No chunks to join");
+
+        av_check(
+            avformat_alloc_output_context2(
+                &format_ctx_, nullptr, nullptr, output_path.c_str()),
+            "avformat_alloc_output_context2");
+
+        open_copy(video_files.front());
+        if (!audio_codec_opts.empty())
+            open_audio(audio_codec_opts, &format_opts);
+        open_output(output_path, &format_opts);
+
+    } catch (...) {
+        av_dict_free(&format_opts);
+        cleanup();
+        throw;
+    }
+
+    convert_thread_ = std::thread(&NativeEncoder::run_concat, this, video_files, audio_files);
+    encode_thread_  = std::thread(&NativeEncoder::run_encode, this);
+}
+
+bool NativeEncoder::supported(
+    const std::string &video_codec_opts, const std::string &audio_codec_opts) {
+    try {
+        CodecOptions video(video_codec_opts, 'v');
+        if (!video.codec.empty() && !avcodec_find_encoder_by_name(video.codec.c_str()))
+            return false;
+        if (!audio_codec_opts.empty()) {
+            CodecOptions audio(audio_codec_opts, 'a');
+            if (!audio.codec.empty() && !avcodec_find_encoder_by_name(audio.codec.c_str()))
+                return false;
+        }
+    } catch (...) {
+        return false;
+    }
+    return true;
+}
+
+NativeEncoder::~NativeEncoder() {
+    stopping_ = true;
+    input_.abort();
+    encodable_.abort();
+    if (convert_thread_.joinable())
+        convert_thread_.join();
+    if (encode_thread_.joinable())
+        encode_thread_.join();
+    cleanup();
+}
+
+void NativeEncoder::open_video(
+    const std::string &codec_opts, const Imath::V2i &resolution, AVDictionary **format_opts) {
+
+    CodecOptions opts(codec_opts, 'v');
+
+    const AVCodec *codec = opts.codec.empty()
+                               ? avcodec_find_encoder(format_ctx_->oformat->video_codec)
+                               : avcodec_find_encoder_by_name(opts.codec.c_str());
+    if (!codec || codec->type != AVMEDIA_TYPE_VIDEO)
+        throw std::runtime_error(fmt::format("No video encoder {}", opts.codec));
+
+    video_stream_ = avformat_new_stream(format_ctx_, nullptr);
+    video_ctx_    = avcodec_alloc_context3(codec);
+    if (!video_stream_ || !video_ctx_)
+        throw std::runtime_error("Failed to allocate video stream");
+
+    video_ctx_->pix_fmt = opts.pix_fmt.empty()
+                              ? avcodec_find_best_pix_fmt_of_list(
+                                    codec->pix_fmts, src_pix_fmt_, 0, nullptr)
+                              : av_get_pix_fmt(opts.pix_fmt.c_str());
+    if (video_ctx_->pix_fmt == AV_PIX_FMT_NONE)
+        throw std::runtime_error(fmt::format("Unsupported pixel format {}", opts.pix_fmt));
+
+    video_ctx_->width               = resolution.x;
+    video_ctx_->height              = resolution.y;
+    video_ctx_->time_base           = av_inv_q(frame_rate_);
+    video_ctx_->framerate           = frame_rate_;
+    video_ctx_->sample_aspect_ratio = AVRational{1, 1};
+    video_ctx_->thread_count        = 0;
+
+    // the viewport renders bt709, which the subprocess got to with a
+    // colorspace filter
+    video_ctx_->color_primaries = AVCOL_PRI_BT709;
+    video_ctx_->color_trc       = AVCOL_TRC_BT709;
+    video_ctx_->colorspace      = AVCOL_SPC_BT709;
+    video_ctx_->color_range     = AVCOL_RANGE_MPEG;
+
+    if (format_ctx_->oformat->flags & AVFMT_GLOBALHEADER)
+        video_ctx_->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+
+    av_check(avcodec_open2(video_ctx_, codec, &opts.dict), "avcodec_open2 (video)");
+    av_check(
+        avcodec_parameters_from_context(video_stream_->codecpar, video_ctx_),
+        "avcodec_parameters_from_context (video)");
+    video_stream_->time_base      = video_ctx_->time_base;
+    video_stream_->avg_frame_rate = frame_rate_;
+
+    av_dict_copy(format_opts, opts.dict, 0);
+}
+
+void NativeEncoder::open_audio(const std::string &codec_opts, AVDictionary **format_opts) {
+
+    CodecOptions opts(codec_opts, 'a');
+
+    const AVCodec *codec = opts.codec.empty()
+                               ? avcodec_find_encoder(format_ctx_->oformat->audio_codec)
+                               : avcodec_find_encoder_by_name(opts.codec.c_str());
+    if (!codec || codec->type != AVMEDIA_TYPE_AUDIO)
+        throw std::runtime_error(fmt::format("No audio encoder {}", opts.codec));
+
+    audio_stream_ = avformat_new_stream(format_ctx_, nullptr);
+    audio_ctx_    = avcodec_alloc_context3(codec);
+    if (!audio_stream_ || !audio_ctx_)
+        throw std::runtime_error("Failed to allocate audio stream");
+
+    audio_channels_         = opts.channels ? opts.channels : 2;
+    audio_ctx_->sample_rate = opts.sample_rate ? opts.sample_rate : audio_sample_rate_;
+    audio_ctx_->sample_fmt  = codec->sample_fmts ? codec->sample_fmts[0] : AV_SAMPLE_FMT_S16;
+    audio_ctx_->time_base   = AVRational{1, audio_ctx_->sample_rate};
+
+    if (format_ctx_->oformat->flags & AVFMT_GLOBALHEADER)
+        audio_ctx_->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+
+#if LIBAVFORMAT_VERSION_MAJOR > 59
+    av_channel_layout_default(&audio_ctx_->ch_layout, audio_channels_);
+#else
+    audio_ctx_->channels       = audio_channels_;
+    audio_ctx_->channel_layout = av_get_default_channel_layout(audio_channels_);
+#endif
+
+    av_check(avcodec_open2(audio_ctx_, codec, &opts.dict), "avcodec_open2 (audio)");
+    av_check(
+        avcodec_parameters_from_context(audio_stream_->codecpar, audio_ctx_),
+        "avcodec_parameters_from_context (audio)");
+    audio_stream_->time_base = audio_ctx_->time_base;
+
+    av_dict_copy(format_opts, opts.dict, 0);
+
+    // xstudio delivers 16 bit interleaved stereo at the soundcard rate
+#if LIBAVFORMAT_VERSION_MAJOR > 59
+    auto src_layout = AVChannelLayout(AV_CHANNEL_LAYOUT_STEREO);
+    av_check(
+        swr_alloc_set_opts2(
+            &swr_ctx_,
+            &audio_ctx_->ch_layout,
+            audio_ctx_->sample_fmt,
+            audio_ctx_->sample_rate,
+            &src_layout,
+            AV_SAMPLE_FMT_S16,
+            audio_sample_rate_,
+            0,
+            nullptr),
+        "swr_alloc_set_opts2");
+#else
+    swr_ctx_ = swr_alloc_set_opts(
+        nullptr,
+        audio_ctx_->channel_layout,
+        audio_ctx_->sample_fmt,
+        audio_ctx_->sample_rate,
+        AV_CH_LAYOUT_STEREO,
+        AV_SAMPLE_FMT_S16,
+        audio_sample_rate_,
+        0,
+        nullptr);
+#endif
+    if (!swr_ctx_)
+        throw std::runtime_error("Failed to allocate audio resampler");
+    av_check(swr_init(swr_ctx_), "swr_init");
+
+    audio_fifo_ = av_audio_fifo_alloc(
+        audio_ctx_->sample_fmt, audio_channels_, audio_ctx_->sample_rate);
+    if (!audio_fifo_)
+        throw std::runtime_error("Failed to allocate audio fifo");
+}
+
+void NativeEncoder::open_copy(const std::string &video_file) {
+
+    // the first chunk tells us what the video stream is, the others have
+    // to match it
+    auto [input, index] = open_chunk(video_file);
+
+    video_stream_ = avformat_new_stream(format_ctx_, nullptr);
+    if (!video_stream_)
+        throw std::runtime_error("Failed to allocate video stream");
+
+    av_check(
+        avcodec_parameters_copy(video_stream_->codecpar, input->streams[index]->codecpar),
+        "avcodec_parameters_copy");
+    video_stream_->codecpar->codec_tag = 0;
+    video_stream_->time_base           = av_inv_q(frame_rate_);
+    video_stream_->avg_frame_rate      = frame_rate_;
+}
+
+void NativeEncoder::open_output(const std::string &output_path, AVDictionary **format_opts) {
+
+    if (!(format_ctx_->oformat->flags & AVFMT_NOFILE)) {
+        av_check(
+            avio_open(&format_ctx_->pb, output_path.c_str(), AVIO_FLAG_WRITE), "avio_open");
+    }
+
+    av_check(avformat_write_header(format_ctx_, format_opts), "avformat_write_header");
+
+    // anything left is an option nobody knew what to do with, and ffmpeg
+    // itself might
+    if (av_dict_count(*format_opts)) {
+        auto e = av_dict_get(*format_opts, "", nullptr, AV_DICT_IGNORE_SUFFIX);
+        throw std::runtime_error(fmt::format("Unsupported option -{}", e->key));
+    }
+    av_dict_free(format_opts);
+
+    packet_ = av_packet_alloc();
+    if (!packet_)
+        throw std::runtime_error("av_packet_alloc failed");
+}
+
+void NativeEncoder::cleanup() {
+    if (format_ctx_) {
+        if (format_ctx_->pb && !(format_ctx_->oformat->flags & AVFMT_NOFILE))
+            avio_closep(&format_ctx_->pb);
+        avformat_free_context(format_ctx_);
+        format_ctx_ = nullptr;
+    }
+    avcodec_free_context(&video_ctx_);
+    avcodec_free_context(&audio_ctx_);
+    av_packet_free(&packet_);
+    swr_free(&swr_ctx_);
+    if (sws_ctx_) {
+        sws_freeContext(sws_ctx_);
+        sws_ctx_ = nullptr;
+    }
+    if (audio_fifo_) {
+        av_audio_fifo_free(audio_fifo_);
+        audio_fifo_ = nullptr;
+    }
+}
+
+bool NativeEncoder::ready() const {
+    // each render step queues a frame and maybe its audio
+    return input_.size() + 2 <= input_.capacity();
+}
+
+void NativeEncoder::add_video(const media_reader::ImageBufPtr &image) {
+    input_.push(Input(image));
+}
+
+void NativeEncoder::add_audio(const media_reader::AudioBufPtr &audio) {
+    if (audio_ctx_)
+        input_.push(Input(audio));
+}
+
+void NativeEncoder::finish() { input_.close(); }
+
+void NativeEncoder::run_convert() {
+
+    Input item;
+    Duration starved = Duration::zero();
+
+    try {
+        while (input_.pop(item, &starved)) {
+
+            if (ready_)
+                ready_();
+
+            add_stats("convert", 0, Duration::zero(), starved);
+            starved = Duration::zero();
+
+            if (auto image = std::get_if<media_reader::ImageBufPtr>(&item)) {
+                const auto start = std::chrono::steady_clock::now();
+                auto frame       = convert_video(*image);
+                const auto busy  = std::chrono::steady_clock::now() - start;
+
+                Duration blocked = Duration::zero();
+                if (frame && !encodable_.push(Encodable{false, std::move(frame)}, &blocked))
+                    return;
+                add_stats("convert", 1, busy, Duration::zero(), blocked);
+
+            } else if (!convert_audio(std::get<media_reader::AudioBufPtr>(item), false)) {
+                return;
+            }
+
+            item = Input();
+        }
+
+        if (!stopping_ && audio_ctx_ && !convert_audio(media_reader::AudioBufPtr(), true))
+            return;
+
+    } catch (std::exception &e) {
+        fail(e.what());
+        return;
+    }
+
+    encodable_.close();
+}
+
+NativeEncoder::FramePtr NativeEncoder::convert_video(const media_reader::ImageBufPtr &image) {
+
+    const auto size          = image->image_size_in_pixels();
+    const int bytes_per_line = size.x * (src_pix_fmt_ == AV_PIX_FMT_RGBA64 ? 8 : 4);
+    if (size.x <= 0 || size.y <= 0 || image->size() < size_t(bytes_per_line) * size.y) {
+        spdlog::warn("{} skipping frame with no image data", __PRETTY_FUNCTION__);
+        return FramePtr();
+    }
+
+    if (!sws_ctx_ || size != sws_src_size_) {
+        if (sws_ctx_)
+            sws_freeContext(sws_ctx_);
+        sws_ctx_ = sws_getContext(
+            size.x,
+            size.y,
+            src_pix_fmt_,
+            video_ctx_->width,
+            video_ctx_->height,
+            video_ctx_->pix_fmt,
+            SWS_BICUBIC,
+            nullptr,
+            nullptr,
+            nullptr);
+        if (!sws_ctx_)
+            throw std::runtime_error(fmt::format(
+                "No conversion from {} to {}",
+                av_get_pix_fmt_name(src_pix_fmt_),
+                av_get_pix_fmt_name(video_ctx_->pix_fmt)));
+
+        // full range RGB in, limited range bt709 YUV out
+        sws_setColorspaceDetails(
+            sws_ctx_,
+            sws_getCoefficients(SWS_CS_DEFAULT),
+            1,
+            sws_getCoefficients(SWS_CS_ITU709),
+            0,
+            0,
+            1 << 16,
+            1 << 16);
+        sws_src_size_ = size;
+    }
+
+    FramePtr frame(av_frame_alloc());
+    if (!frame)
+        throw std::runtime_error("av_frame_alloc failed");
+    frame->format = video_ctx_->pix_fmt;
+    frame->width  = video_ctx_->width;
+    frame->height = video_ctx_->height;
+    av_check(av_frame_get_buffer(frame.get(), 0), "av_frame_get_buffer");
+
+    // the viewport image is bottom-up, reading it from the last line back
+    // flips it as part of the conversion
+    const uint8_t *src[1] = {
+        reinterpret_cast<const uint8_t *>(image->buffer()) +
+        size_t(size.y - 1) * bytes_per_line};
+    const int src_stride[1] = {-bytes_per_line};
+    sws_scale(sws_ctx_, src, src_stride, 0, size.y, frame->data, frame->linesize);
+
+    frame->pts = video_pts_++;
+    return frame;
+}
+
+bool NativeEncoder::convert_audio(const media_reader::AudioBufPtr &audio, const bool flush) {
+
+    const auto start = std::chrono::steady_clock::now();
+    Duration blocked = Duration::zero();
+    uint64_t frames  = 0;
+
+    if (audio && (audio->sample_format() != audio::SampleFormat::INT16 ||
+                  audio->num_channels() != 2)) {
+        spdlog::warn("{} skipping audio that isn't 16 bit stereo", __PRETTY_FUNCTION__);
+        return true;
+    }
+
+    // resample into the fifo
+    const int in_samples  = audio ? int(audio->num_samples()) : 0;
+    const int out_samples = swr_get_out_samples(swr_ctx_, in_samples);
+    if (out_samples > 0) {
+        uint8_t **out = nullptr;
+        av_check(
+            av_samples_alloc_array_and_samples(
+                &out, nullptr, audio_channels_, out_samples, audio_ctx_->sample_fmt, 0),
+            "av_samples_alloc_array_and_samples");
+
+        const uint8_t *in[1] = {
+            audio ? reinterpret_cast<const uint8_t *>(audio->buffer()) : nullptr};
+        const int converted =
+            swr_convert(swr_ctx_, out, out_samples, audio ? in : nullptr, in_samples);
+        const int written =
+            converted > 0 ? av_audio_fifo_write(audio_fifo_, (void **)out, converted) : 0;
+
+        av_freep(&out[0]);
+        av_freep(&out);
+        av_check(converted, "swr_convert");
+        av_check(written, "av_audio_fifo_write");
+    }
+
+    // and then out in frames of the size the encoder wants, the last one can
+    // be short
+    const int frame_size = audio_ctx_->frame_size ? audio_ctx_->frame_size : 1024;
+    while (av_audio_fifo_size(audio_fifo_) >= frame_size ||
+           (flush && av_audio_fifo_size(audio_fifo_) > 0)) {
+
+        FramePtr frame(av_frame_alloc());
+        if (!frame)
+            throw std::runtime_error("av_frame_alloc failed");
+        frame->nb_samples  = std::min(av_audio_fifo_size(audio_fifo_), frame_size);
+        frame->format      = audio_ctx_->sample_fmt;
+        frame->sample_rate = audio_ctx_->sample_rate;
+#if LIBAVFORMAT_VERSION_MAJOR > 59
+        av_check(
+            av_channel_layout_copy(&frame->ch_layout, &audio_ctx_->ch_layout),
+            "av_channel_layout_copy");
+#else
+        frame->channels       = audio_ctx_->channels;
+        frame->channel_layout = audio_ctx_->channel_layout;
+#endif
+        av_check(av_frame_get_buffer(frame.get(), 0), "av_frame_get_buffer");
+        av_check(
+            av_audio_fifo_read(audio_fifo_, (void **)frame->data, frame->nb_samples),
+            "av_audio_fifo_read");
+
+        frame->pts = audio_pts_;
+        audio_pts_ += frame->nb_samples;
+        frames++;
+
+        if (!encodable_.push(Encodable{true, std::move(frame)}, &blocked))
+            return false;
+    }
+
+    add_stats(
+        "convert (audio)",
+        frames,
+        std::chrono::steady_clock::now() - start - blocked,
+        Duration::zero(),
+        blocked);
+    return true;
+}
+
+void NativeEncoder::run_concat(
+    const std::vector<std::string> video_files, const std::vector<std::string> audio_files) {
+
+    // chunks are laid end to end, so each one's timestamps start where the
+    // last one's frames ran out
+    const auto time_base = av_inv_q(frame_rate_);
+    int64_t offset       = 0;
+
+    try {
+        for (size_t i = 0; i < video_files.size() && !stopping_; ++i) {
+
+            const auto start = std::chrono::steady_clock::now();
+            Duration blocked = Duration::zero();
+            uint64_t frames  = 0;
+
+            auto [input, index]        = open_chunk(video_files[i]);
+            const auto chunk_time_base = input->streams[index]->time_base;
+
+            PacketPtr packet(av_packet_alloc());
+            while (av_read_frame(input.get(), packet.get()) >= 0) {
+                if (packet->stream_index != index) {
+                    av_packet_unref(packet.get());
+                    continue;
+                }
+
+                av_packet_rescale_ts(packet.get(), chunk_time_base, time_base);
+                if (packet->pts != AV_NOPTS_VALUE)
+                    packet->pts += offset;
+                if (packet->dts != AV_NOPTS_VALUE)
+                    packet->dts += offset;
+                frames++;
+
+                PacketPtr copy(av_packet_alloc());
+                av_packet_move_ref(copy.get(), packet.get());
+                if (!encodable_.push(Encodable{false, FramePtr(), std::move(copy)}, &blocked))
+                    return;
+            }
+            offset += int64_t(frames);
+
+            add_stats(
+                "read",
+                frames,
+                std::chrono::steady_clock::now() - start - blocked,
+                Duration::zero(),
+                blocked);
+
+            if (!audio_ctx_ || i >= audio_files.size())
+                continue;
+
+            // the chunk's raw audio, a tenth of a second at a time
+            std::ifstream pcm(audio_files[i], std::ios::binary);
+            std::vector<char> samples(size_t(audio_sample_rate_ / 10) * 4);
+            while (pcm.read(samples.data(), samples.size()) || pcm.gcount()) {
+                const long num_samples = long(pcm.gcount() / 4);
+                if (!num_samples)
+                    break;
+
+                auto audio = media_reader::AudioBufPtr(new media_reader::AudioBuffer());
+                audio->allocate(
+                    audio_sample_rate_, 2, num_samples, audio::SampleFormat::INT16);
+                memcpy(audio->buffer(), samples.data(), size_t(num_samples) * 4);
+                if (!convert_audio(audio, false))
+                    return;
+            }
+        }
+
+        if (!stopping_ && audio_ctx_ && !convert_audio(media_reader::AudioBufPtr(), true))
+            return;
+
+    } catch (std::exception &e) {
+        fail(e.what());
+        return;
+    }
+
+    encodable_.close();
+}
+
+void NativeEncoder::run_encode() {
+
+    Encodable item;
+    Duration starved = Duration::zero();
+
+    try {
+        while (encodable_.pop(item, &starved)) {
+            add_stats("encode", 0, Duration::zero(), starved);
+            starved = Duration::zero();
+
+            if (item.packet) {
+                const auto busy =
+                    write(item.packet.get(), av_inv_q(frame_rate_), video_stream_);
+                add_stats("write", 1, busy);
+            } else if (item.audio) {
+                encode(audio_ctx_, audio_stream_, item.frame.get());
+            } else {
+                encode(video_ctx_, video_stream_, item.frame.get());
+            }
+            item = Encodable();
+        }
+
+        // stopped, or failed in the convert stage
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            if (stopping_ || completed_)
+                return;
+        }
+
+        // flush the encoders and finish off the file
+        if (video_ctx_)
+            encode(video_ctx_, video_stream_, nullptr);
+        if (audio_ctx_)
+            encode(audio_ctx_, audio_stream_, nullptr);
+
+        av_check(av_write_trailer(format_ctx_), "av_write_trailer");
+        if (!(format_ctx_->oformat->flags & AVFMT_NOFILE))
+            av_check(avio_closep(&format_ctx_->pb), "avio_closep");
+
+    } catch (std::exception &e) {
+        fail(e.what());
+        return;
+    }
+
+    complete("");
+}
+
+void NativeEncoder::encode(AVCodecContext *ctx, AVStream *stream, AVFrame *frame) {
+
+    const auto start = std::chrono::steady_clock::now();
+    Duration writing = Duration::zero();
+    uint64_t packets = 0;
+
+    av_check(avcodec_send_frame(ctx, frame), "avcodec_send_frame");
+
+    while (true) {
+        const int ret = avcodec_receive_packet(ctx, packet_);
+        if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF)
+            break;
+        av_check(ret, "avcodec_receive_packet");
+
+        writing += write(packet_, ctx->time_base, stream);
+        packets++;
+    }
+
+    add_stats(
+        ctx == video_ctx_ ? "encode" : "encode (audio)",
+        frame ? 1 : 0,
+        std::chrono::steady_clock::now() - start - writing);
+    add_stats("write", packets, writing);
+}
+
+NativeEncoder::Duration
+NativeEncoder::write(AVPacket *packet, const AVRational time_base, AVStream *stream) {
+    const auto start = std::chrono::steady_clock::now();
+    av_packet_rescale_ts(packet, time_base, stream->time_base);
+    packet->stream_index = stream->index;
+    // takes ownership of the packet data
+    av_check(av_interleaved_write_frame(format_ctx_, packet), "av_interleaved_write_frame");
+    return std::chrono::steady_clock::now() - start;
+}
+
+void NativeEncoder::fail(const std::string &error) {
+    input_.abort();
+    encodable_.abort();
+    complete(error.empty() ? "Unknown error" : error);
+}
+
+void NativeEncoder::complete(const std::string &error) {
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        if (completed_ || stopping_)
+            return;
+        completed_ = true;
+    }
+    if (done_)
+        done_(error);
+}
+
+void NativeEncoder::record_stage(
+    const std::string &stage, const Duration busy, const uint64_t items) {
+    add_stats(stage, items, busy);
+}
+
+void NativeEncoder::add_stats(
+    const std::string &stage,
+    const uint64_t items,
+    const Duration busy,
+    const Duration starved,
+    const Duration blocked) {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    auto &s = stages_[stage];
+    s.items += items;
+    s.busy += busy;
+    s.starved += starved;
+    s.blocked += blocked;
+}
+
+nlohmann::json NativeEncoder::stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+
+    const auto elapsed = seconds(std::chrono::steady_clock::now() - started_);
+    auto result        = nlohmann::json{{"elapsed", elapsed}};
+
+    for (const auto &[stage, s] : stages_) {
+        // throughput is over the whole run, capacity is what the stage could
+        // manage if it was never waiting on the others
+        result["stages"][stage] = nlohmann::json{
+            {"items", s.items},
+            {"busy", seconds(s.busy)},
+            {"starved", seconds(s.starved)},
+            {"blocked", seconds(s.blocked)},
+            {"throughput", elapsed > 0.0 ? double(s.items) / elapsed : 0.0},
+            {"capacity", s.busy.count() ? double(s.items) / seconds(s.busy) : 0.0}};
+    }
+    return result;
+}
+
+std::string NativeEncoder::stats_report() const {
+    const auto j = stats();
+
+    std::string result = fmt::format(
+        "{:<16}{:>8}{:>12}{:>12}{:>10}{:>10}{:>10}\n",
+        "Stage",
+        "Items",
+        "Items/s",
+        "Capacity/s",
+        "Busy s",
+        "Starved s",
+        "Blocked s");
+    if (j.contains("stages")) {
+        for (const auto &[stage, s] : j["stages"].items()) {
+            result += fmt::format(
+                "{:<16}{:>8}{:>12.1f}{:>12.1f}{:>10.2f}{:>10.2f}{:>10.2f}\n",
+                stage,
+                s["items"].get<uint64_t>(),
+                s["throughput"].get<double>(),
+                s["capacity"].get<double>(),
+                s["busy"].get<double>(),
+                s["starved"].get<double>(),
+                s["blocked"].get<double>());
+        }
+    }
+    result += fmt::format("Elapsed {:.2f}s\n", j["elapsed"].get<double>());
+    return result;
+}
@@ -0,0 +1,295 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "xstudio/media_reader/audio_buffer.hpp"
+#include "xstudio/media_reader/image_buffer.hpp"
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/audio_fifo.h>
+#include <libswresample/swresample.h>
+#include <libswscale/swscale.h>
+}
+
+namespace xstudio {
+
+namespace video_render_plugin_1_0 {
+
+    /* Fixed capacity FIFO between two pipeline stages. push blocks while the
+    queue is full and pop while it is empty, so a slow stage holds back the
+    ones feeding it instead of letting frames pile up in memory. Once closed,
+    pop drains what is left and then returns false. */
+    template <typename T> class BoundedQueue {
+      public:
+        BoundedQueue(const size_t capacity) : capacity_(std::max(capacity, size_t(1))) {}
+
+        // false if the queue was closed before there was room
+        bool push(T &&item, std::chrono::steady_clock::duration *waited = nullptr) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            const auto start = std::chrono::steady_clock::now();
+            not_full_.wait(lock, [this]() { return closed_ || items_.size() < capacity_; });
+            if (waited)
+                *waited += std::chrono::steady_clock::now() - start;
+            if (closed_)
+                return false;
+            items_.emplace_back(std::move(item));
+            not_empty_.notify_one();
+            return true;
+        }
+
+        bool pop(T &item, std::chrono::steady_clock::duration *waited = nullptr) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            const auto start = std::chrono::steady_clock::now();
+            not_empty_.wait(lock, [this]() { return closed_ || !items_.empty(); });
+            if (waited)
+                *waited += std::chrono::steady_clock::now() - start;
+            if (items_.empty())
+                return false;
+            item = std::move(items_.front());
+            items_.pop_front();
+            not_full_.notify_one();
+            return true;
+        }
+
+        // no more pushes, pops carry on until the queue is empty
+        void close() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+            not_full_.notify_all();
+            not_empty_.notify_all();
+        }
+
+        // close and throw away what hasn't been popped yet
+        void abort() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+            items_.clear();
+            not_full_.notify_all();
+            not_empty_.notify_all();
+        }
+
+        [[nodiscard]] size_t size() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return items_.size();
+        }
+
+        [[nodiscard]] size_t capacity() const { return capacity_; }
+
+      private:
+        const size_t capacity_;
+        mutable std::mutex mutex_;
+        std::condition_variable not_full_, not_empty_;
+        std::deque<T> items_;
+        bool closed_ = {false};
+    };
+
+    /* Class NativeEncoder
+
+    Encodes the rendered frames and audio straight into the output movie with
+    libavcodec/libavformat, instead of streaming raw data through fifos to an
+    ffmpeg subprocess. Work is split into stages that run concurrently, each
+    on its own thread and fed by a bounded queue:
+
+        convert - RGBA to the codec's pixel format (flipping the bottom-up
+                  viewport image on the way) and audio to the codec's sample
+                  format and frame size
+        encode  - avcodec encode of video and audio frames
+        write   - muxing the packets into the output file
+
+    The render stage (offscreen viewport render and readback) runs in the
+    VideoRenderWorker, which records its timings here so that the throughput
+    of all stages is reported together.
+
+    The codec options are the ffmpeg command line options of the render
+    presets. The constructor throws if any of them can't be applied, in which
+    case the caller should fall back to running ffmpeg itself.
+
+    The second constructor joins the chunks of a parallel render. The chunks'
+    video is copied into the output as it is and their audio, which was kept
+    as raw samples, is encoded in one go so there are no gaps or priming
+    samples at the joins. The convert stage is then a read stage, demuxing the
+    chunks one after the other.
+    */
+    class NativeEncoder {
+      public:
+        // called from the convert thread when it has taken an item off the
+        // input queue, so the caller can queue more
+        using ReadyFunc = std::function<void()>;
+
+        // called once from the encode thread when the output is complete, or
+        // with an error message when encoding has failed
+        using DoneFunc = std::function<void(const std::string &error)>;
+
+        NativeEncoder(
+            const std::string &output_path,
+            const Imath::V2i &resolution,
+            const double frame_rate,
+            const bool is_16_bit,
+            const std::string &video_codec_opts,
+            const std::string &audio_codec_opts,
+            const int audio_sample_rate,
+            ReadyFunc ready,
+            DoneFunc done,
+            const size_t queue_depth = 4);
+
+        // video_files are movies encoded with identical settings and no audio,
+        // audio_files hold the 16 bit interleaved stereo that goes with each
+        NativeEncoder(
+            const std::string &output_path,
+            const std::vector<std::string> &video_files,
+            const std::vector<std::string> &audio_files,
+            const double frame_rate,
+            const std::string &audio_codec_opts,
+            const int audio_sample_rate,
+            DoneFunc done,
+            const size_t queue_depth = 4);
+
+        ~NativeEncoder();
+
+        // whether the options look like ones the encoder can apply, without
+        // opening anything
+        [[nodiscard]] static bool
+        supported(const std::string &video_codec_opts, const std::string &audio_codec_opts);
+
+        NativeEncoder(const NativeEncoder &)            = delete;
+        NativeEncoder &operator=(const NativeEncoder &) = delete;
+
+        // true while there's room on the input queue for another frame and its
+        // audio
+        [[nodiscard]] bool ready() const;
+        [[nodiscard]] bool has_audio() const { return audio_ctx_ != nullptr; }
+
+        void add_video(const media_reader::ImageBufPtr &image);
+        void add_audio(const media_reader::AudioBufPtr &audio);
+
+        // no more input, the output is finished off once what's queued is
+        // encoded
+        void finish();
+
+        // for stages that run outside the encoder
+        void record_stage(
+            const std::string &stage,
+            const std::chrono::steady_clock::duration busy,
+            const uint64_t items = 1);
+
+        // per stage items, busy and waiting time and throughput
+        [[nodiscard]] nlohmann::json stats() const;
+        [[nodiscard]] std::string stats_report() const;
+
+      private:
+        struct AVFrameDeleter {
+            void operator()(AVFrame *frame) const { av_frame_free(&frame); }
+        };
+        typedef std::unique_ptr<AVFrame, AVFrameDeleter> FramePtr;
+
+        struct AVPacketDeleter {
+            void operator()(AVPacket *packet) const { av_packet_free(&packet); }
+        };
+        typedef std::unique_ptr<AVPacket, AVPacketDeleter> PacketPtr;
+
+        typedef std::variant<media_reader::ImageBufPtr, media_reader::AudioBufPtr> Input;
+
+        // a frame for the video or audio encoder, or a packet that is already
+        // encoded and only needs writing
+        struct Encodable {
+            bool audio = {false};
+            FramePtr frame;
+            PacketPtr packet;
+        };
+
+        typedef std::chrono::steady_clock::duration Duration;
+
+        // starved is time spent waiting for input, blocked is time spent
+        // waiting for room on the queue to the next stage
+        struct StageStats {
+            uint64_t items   = {0};
+            Duration busy    = Duration::zero();
+            Duration starved = Duration::zero();
+            Duration blocked = Duration::zero();
+        };
+
+        // options the codec didn't take are left in format_opts for the muxer
+        void open_video(
+            const std::string &codec_opts,
+            const Imath::V2i &resolution,
+            AVDictionary **format_opts);
+        void open_audio(const std::string &codec_opts, AVDictionary **format_opts);
+        void open_copy(const std::string &video_file);
+        void open_output(const std::string &output_path, AVDictionary **format_opts);
+        void cleanup();
+
+        void run_convert();
+        void run_concat(
+            const std::vector<std::string> video_files,
+            const std::vector<std::string> audio_files);
+        void run_encode();
+
+        FramePtr convert_video(const media_reader::ImageBufPtr &image);
+        bool convert_audio(const media_reader::AudioBufPtr &audio, const bool flush);
+        void encode(AVCodecContext *ctx, AVStream *stream, AVFrame *frame);
+        Duration write(AVPacket *packet, const AVRational time_base, AVStream *stream);
+        void add_stats(
+            const std::string &stage,
+            const uint64_t items,
+            const Duration busy,
+            const Duration starved = Duration::zero(),
+            const Duration blocked = Duration::zero());
+
+        void fail(const std::string &error);
+        void complete(const std::string &error);
+
+        ReadyFunc ready_;
+        DoneFunc done_;
+
+        const AVPixelFormat src_pix_fmt_;
+        const AVRational frame_rate_;
+        const int audio_sample_rate_;
+        const size_t queue_depth_;
+
+        AVFormatContext *format_ctx_ = {nullptr};
+        AVCodecContext *video_ctx_   = {nullptr};
+        AVCodecContext *audio_ctx_   = {nullptr};
+        AVStream *video_stream_      = {nullptr};
+        AVStream *audio_stream_      = {nullptr};
+        AVPacket *packet_            = {nullptr};
+        SwsContext *sws_ctx_         = {nullptr};
+        SwrContext *swr_ctx_         = {nullptr};
+        AVAudioFifo *audio_fifo_     = {nullptr};
+        int audio_channels_          = {2};
+        Imath::V2i sws_src_size_;
+
+        int64_t video_pts_ = {0};
+        int64_t audio_pts_ = {0};
+
+        BoundedQueue<Input> input_;
+        BoundedQueue<Encodable> encodable_;
+
+        const std::chrono::steady_clock::time_point started_;
+        mutable std::mutex stats_mutex_;
+        std::map<std::string, StageStats> stages_;
+        bool completed_             = {false};
+        std::atomic<bool> stopping_ = {false};
+
+        std::thread convert_thread_;
+        std::thread encode_thread_;
+    };
+
+} // namespace video_render_plugin_1_0
+} // namespace xstudio
@@ -127,6 +127,9 @@ void VideoRenderPlugin::on_exit() {
         send_exit(p.actor(), caf::exit_reason::user_shutdown);
     }
     queued_jobs_.clear();
+    while (!chunked_renders_.empty())
+        stop_chunked_render(chunked_renders_.begin()->first);
+    render_viewports_.clear();
     offscreen_viewport_ = caf::actor();
     colour_pipeline_    = caf::actor();
     StandardPlugin::on_exit();
@@ -156,6 +159,15 @@ caf::message_handler VideoRenderPlugin::message_handler_extensions() {
                             overall_status_->set_value("Done");
                     }
                 },
+                [=](utility::event_atom,
+                    const utility::Uuid &job_id,
+                    caf::actor renderable,
+                    const utility::JsonStore &plan) {
+                    // the worker for the current job has split it into chunks
+                    // for us to render in parallel
+                    if (current_worker_.uuid() == job_id)
+                        start_chunked_render(job_id, current_worker_.actor(), renderable, plan);
+                },
                 [=](utility::event_atom,
                     const utility::JsonStore &status,
                     const std::string &ffmpeg_output) {
@@ -163,6 +175,12 @@ caf::message_handler VideoRenderPlugin::message_handler_extensions() {
                     // our jobs_status_data_ attribute, which drives the job queue UI
                     // qml stuff
 
+                    if (status.contains("parent_job_id")) {
+                        // chunks don't get a row of their own in the queue
+                        chunk_status(status, ffmpeg_output);
+                        return;
+                    }
+
                     try {
 
                         utility::Uuid job_id = status.at("job_id");
@@ -329,6 +347,8 @@ void VideoRenderPlugin::attribute_changed(const utility::Uuid &attr_uuid, const
 
 void VideoRenderPlugin::remove_job(const utility::Uuid &job_id) {
 
+    stop_chunked_render(job_id);
+
     for (auto p = queued_jobs_.begin(); p != queued_jobs_.end(); ++p) {
         if (p->uuid() == job_id) {
             send_exit(p->actor(), caf::exit_reason::user_shutdown);
@@ -494,7 +514,8 @@ void VideoRenderPlugin::qml_item_callback(
 
             // handler for worker exit (worker self exists when its render has
             // completed or is cancelled)
-            monitor(worker, [this, worker](const error &err) {
+            monitor(worker, [this, worker, job_id](const error &err) {
+                stop_chunked_render(job_id);
                 if (current_worker_ == worker) {
                     current_worker_ = utility::UuidActor();
                     anon_mail(utility::user_start_action_atom_v)
@@ -528,6 +549,247 @@ void VideoRenderPlugin::qml_item_callback(
     }
 }
 
+void VideoRenderPlugin::start_chunked_render(
+    const utility::Uuid &job_id,
+    caf::actor coordinator,
+    caf::actor renderable,
+    const utility::JsonStore &plan) {
+
+    try {
+        auto &job          = chunked_renders_[job_id];
+        job.coordinator    = coordinator;
+        job.renderable     = renderable;
+        job.render_options = utility::JsonStore(plan.at("options"));
+        job.chunks         = utility::JsonStore(plan.at("chunks"));
+        job.workers        = size_t(std::max(plan.at("workers").get<int>(), 1));
+        job.percent        = std::vector<int>(job.chunks.size(), 0);
+        job.started        = std::chrono::steady_clock::now();
+    } catch (std::exception &e) {
+        chunked_renders_.erase(job_id);
+        anon_mail(utility::event_atom_v, fmt::format("Bad chunk plan: {}\n", e.what()))
+            .send(coordinator);
+        return;
+    }
+
+    // Each chunk worker needs an offscreen viewport to itself. The job's own
+    // viewport is free while its chunks render, the others are made as
+    // needed and kept for later jobs.
+    if (render_viewports_.empty())
+        render_viewports_.push_back(RenderViewport{offscreen_viewport_, colour_pipeline_});
+
+    const auto have = render_viewports_.size() + render_viewports_pending_;
+    const auto want = chunked_renders_[job_id].workers;
+    if (have < want)
+        add_render_viewports(want - have);
+
+    dispatch_chunks();
+}
+
+void VideoRenderPlugin::add_render_viewports(const size_t count) {
+
+    auto studio_ui = system().registry().template get<caf::actor>(studio_ui_registry);
+
+    auto handle_error = [=](caf::error &err) mutable {
+        render_viewports_pending_--;
+        spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
+    };
+
+    for (size_t i = 0; i < count; ++i) {
+
+        const auto name = fmt::format(
+            "vid_render_offscreen_viewport_{}",
+            render_viewports_.size() + render_viewports_pending_);
+        render_viewports_pending_++;
+
+        mail(offscreen_viewport_atom_v, name, false)
+            .request(studio_ui, infinite)
+            .then(
+                [=](caf::actor offscreen_vp) {
+                    mail(colour_pipeline::colour_pipeline_atom_v)
+                        .request(offscreen_vp, infinite)
+                        .then(
+                            [=](caf::actor colour_pipeline) {
+                                render_viewports_pending_--;
+
+                                // as for the job's own viewport, the user's View is
+                                // applied to all the sources
+                                anon_mail(
+                                    colour_pipeline::global_ocio_controls_atom_v,
+                                    "force_global_view",
+                                    true)
+                                    .send(colour_pipeline);
+
+                                render_viewports_.push_back(
+                                    RenderViewport{offscreen_vp, colour_pipeline});
+                                dispatch_chunks();
+                            },
+                            handle_error);
+                },
+                handle_error);
+    }
+}
+
+void VideoRenderPlugin::dispatch_chunks() {
+
+    for (auto p = chunked_renders_.begin(); p != chunked_renders_.end(); ++p) {
+
+        const auto job_id = p->first;
+        auto &job         = p->second;
+
+        while (job.next < job.chunks.size() && job.running.size() < job.workers) {
+
+            auto vp = std::find_if(
+                render_viewports_.begin(),
+                render_viewports_.end(),
+                [](const RenderViewport &v) { return !v.busy; });
+            if (vp == render_viewports_.end())
+                return;
+
+            const auto chunk_id = utility::Uuid::generate();
+            const auto index    = job.next++;
+            auto worker         = spawn<VideoRenderWorker>(
+                chunk_id,
+                job.render_options,
+                vp->viewport,
+                vp->colour_pipeline,
+                caf::actor_cast<caf::actor>(this),
+                job.renderable,
+                utility::JsonStore(job.chunks[index]));
+
+            vp->busy              = true;
+            job.running[chunk_id] = RunningChunk{
+                worker, index, size_t(std::distance(render_viewports_.begin(), vp))};
+
+            monitor(worker, [this, job_id, chunk_id](const error &err) {
+                chunk_exited(job_id, chunk_id);
+            });
+
+            mail(utility::user_start_action_atom_v).send(worker);
+        }
+    }
+}
+
+void VideoRenderPlugin::chunk_status(
+    const utility::JsonStore &status, const std::string &ffmpeg_output) {
+
+    try {
+
+        const utility::Uuid job_id   = status.at("parent_job_id");
+        const utility::Uuid chunk_id = status.at("job_id");
+
+        auto p = chunked_renders_.find(job_id);
+        if (p == chunked_renders_.end())
+            return;
+        auto &job = p->second;
+
+        auto c = job.running.find(chunk_id);
+        if (c == job.running.end())
+            return;
+        const auto index = c->second.index;
+
+        const int status_num = status.get_or("status_num", 0);
+        if (status_num == 2) {
+            // failed, which fails the job
+            anon_mail(
+                utility::event_atom_v,
+                fmt::format(
+                    "Chunk {} of {} failed: {}\n\n{}",
+                    index + 1,
+                    job.chunks.size(),
+                    status.get_or("status", std::string()),
+                    ffmpeg_output))
+                .send(job.coordinator);
+            stop_chunked_render(job_id);
+            return;
+        }
+
+        job.percent[index] = std::clamp(status.get_or("percent_complete", 0), 0, 100);
+
+        if (status_num == 3) {
+            job.percent[index]                         = 100;
+            render_viewports_[c->second.viewport].busy = false;
+            job.running.erase(c);
+            job.completed++;
+        }
+
+        // progress of the job is that of its chunks, weighted by their frames
+        double frames = 0.0, done = 0.0;
+        for (size_t i = 0; i < job.chunks.size(); ++i) {
+            const double f = job.chunks[i].value("frames", 1);
+            frames += f;
+            done += f * job.percent[i] / 100.0;
+        }
+        const double percent = frames > 0.0 ? done * 100.0 / frames : 0.0;
+
+        std::string eta;
+        if (percent > 0.0) {
+            const auto elapsed = std::chrono::duration<double>(
+                                     std::chrono::steady_clock::now() - job.started)
+                                     .count();
+            const auto secs = int64_t(elapsed * (100.0 - percent) / percent);
+            eta             = fmt::format(", ETA {}:{:02d}", secs / 60, secs % 60);
+        }
+
+        if (jobs_status_data_.find(job_id) != jobs_status_data_.end()) {
+            utility::JsonStore job_status(jobs_status_data_[job_id]->value());
+            job_status["percent_complete"] = int(round(percent));
+            job_status["status"]           = fmt::format(
+                "Rendering ({}%, {} of {} chunks done{})",
+                int(round(percent)),
+                job.completed,
+                job.chunks.size(),
+                eta);
+            jobs_status_data_[job_id]->set_value(job_status);
+        }
+
+        if (job.completed == job.chunks.size()) {
+            // the job's worker joins them into the output
+            anon_mail(utility::event_atom_v, job.chunks).send(job.coordinator);
+            chunked_renders_.erase(p);
+        } else if (status_num == 3) {
+            dispatch_chunks();
+        }
+
+    } catch (std::exception &e) {
+        spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
+    }
+}
+
+void VideoRenderPlugin::chunk_exited(
+    const utility::Uuid &job_id, const utility::Uuid &chunk_id) {
+
+    // chunk workers that complete are no longer running by the time they exit
+    auto p = chunked_renders_.find(job_id);
+    if (p == chunked_renders_.end())
+        return;
+    auto c = p->second.running.find(chunk_id);
+    if (c == p->second.running.end())
+        return;
+
+    anon_mail(
+        utility::event_atom_v,
+        fmt::format(
+            "Chunk {} of {} stopped before it was complete\n",
+            c->second.index + 1,
+            p->second.chunks.size()))
+        .send(p->second.coordinator);
+    stop_chunked_render(job_id);
+}
+
+void VideoRenderPlugin::stop_chunked_render(const utility::Uuid &job_id) {
+
+    auto p = chunked_renders_.find(job_id);
+    if (p == chunked_renders_.end())
+        return;
+
+    for (auto &c : p->second.running) {
+        send_exit(c.second.worker, caf::exit_reason::user_shutdown);
+        if (c.second.viewport < render_viewports_.size())
+            render_viewports_[c.second.viewport].busy = false;
+    }
+    chunked_renders_.erase(p);
+}
+
 void VideoRenderPlugin::playback_render_output(
     const std::string path_to_render, caf::actor session) {
 
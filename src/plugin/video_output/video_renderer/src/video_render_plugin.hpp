@@ -1,6 +1,10 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include <chrono>
+#include <map>
+#include <vector>
+
 #include "xstudio/ui/viewport/video_output_plugin.hpp"
 #include "xstudio/ui/viewport/viewport_gpu_post_processor.hpp"
 #include "xstudio/ui/opengl/shader_program_base.hpp"
@@ -33,6 +37,45 @@ namespace video_render_plugin_1_0 {
             const utility::Uuid qml_item_id, const utility::JsonStore callback_data);
         void playback_render_output(const std::string path_to_render, caf::actor session);
 
+        void start_chunked_render(
+            const utility::Uuid &job_id,
+            caf::actor coordinator,
+            caf::actor renderable,
+            const utility::JsonStore &plan);
+        void add_render_viewports(const size_t count);
+        void dispatch_chunks();
+        void chunk_status(const utility::JsonStore &status, const std::string &ffmpeg_output);
+        void chunk_exited(const utility::Uuid &job_id, const utility::Uuid &chunk_id);
+        void stop_chunked_render(const utility::Uuid &job_id);
+
+        // an offscreen viewport and its colour pipeline, for a chunk worker to
+        // render with
+        struct RenderViewport {
+            caf::actor viewport, colour_pipeline;
+            bool busy = {false};
+        };
+
+        struct RunningChunk {
+            caf::actor worker;
+            size_t index    = {0};
+            size_t viewport = {0};
+        };
+
+        // a job that its worker has split into chunks, which we render several
+        // at a time, see VideoRenderWorker::plan_chunks
+        struct ChunkedRender {
+            caf::actor coordinator;
+            caf::actor renderable;
+            utility::JsonStore render_options;
+            utility::JsonStore chunks;
+            std::map<utility::Uuid, RunningChunk> running;
+            std::vector<int> percent;
+            size_t next      = {0};
+            size_t completed = {0};
+            size_t workers   = {1};
+            std::chrono::steady_clock::time_point started;
+        };
+
       protected:
         void attribute_changed(const utility::Uuid &attribute_uuid, const int role) override;
 
@@ -49,6 +92,9 @@ namespace video_render_plugin_1_0 {
         utility::UuidActorVector queued_jobs_;
         utility::UuidActor current_worker_;
         utility::JsonStore ocio_settings_;
+        std::map<utility::Uuid, ChunkedRender> chunked_renders_;
+        std::vector<RenderViewport> render_viewports_;
+        size_t render_viewports_pending_ = {0};
     };
 
     class YUVFrameGrabber : public ui::viewport::ViewportFramePostProcessor {
@@ -278,12 +278,16 @@ VideoRenderWorker::VideoRenderWorker(
     const utility::JsonStore &render_options,
     caf::actor offscreen_viewport,
     caf::actor colour_pipeline,
-    caf::actor renderer_plugin)
+    caf::actor renderer_plugin,
+    caf::actor renderable,
+    const utility::JsonStore &chunk)
     : caf::event_based_actor(cfg),
       job_uuid_(job_id),
       offscreen_viewport_(offscreen_viewport),
       colour_pipeline_(colour_pipeline),
-      renderer_plugin_(renderer_plugin) {
+      renderer_plugin_(renderer_plugin),
+      render_options_(render_options),
+      chunk_(chunk) {
 
 #ifdef _WIN32
 #else        
@@ -349,6 +353,39 @@ VideoRenderWorker::VideoRenderWorker(
         spdlog::warn("Failed to get global audio sample rate: {}", e.what());
     }
 
+    try {
+        auto prefs          = global_store::GlobalStoreHelper(system());
+        use_native_encoder_ = prefs.value<bool>("/plugin/video_render/native_encoder");
+        parallel_renders_   = prefs.value<int>("/plugin/video_render/parallel_renders");
+        chunk_frames_       = prefs.value<int>("/plugin/video_render/chunk_frames");
+    } catch (std::exception &e) {
+        spdlog::warn("{} {}", __PRETTY_FUNCTION__, e.what());
+    }
+
+    if (!chunk_.empty()) {
+        // a chunk of a parallel render goes to its own file, with the audio
+        // kept raw until the chunks are joined
+        try {
+            renderable_        = renderable;
+            output_file_path_  = chunk_.at("video").get<std::string>();
+            video_codec_opts_  = chunk_.at("video_codec_opts").get<std::string>();
+            auto_check_output_ = false;
+
+            if (!audio_codec_opts_.empty()) {
+                const auto audio_path = chunk_.at("audio").get<std::string>();
+                chunk_audio_.open(audio_path, std::ios::binary | std::ios::trunc);
+                if (!chunk_audio_.is_open())
+                    throw std::runtime_error(
+                        fmt::format("Failed to open {} for writing", audio_path));
+            }
+            audio_codec_opts_.clear();
+        } catch (std::exception &e) {
+            spdlog::critical("{} {}", __PRETTY_FUNCTION__, e.what());
+            send_exit(caf::actor_cast<caf::actor>(this), caf::exit_reason::user_shutdown);
+            return;
+        }
+    }
+
     behavior_.assign(
         [=](const utility::Uuid &parent_playlist_item_id,
             const utility::Uuid &target_render_item_id) {
@@ -372,12 +409,22 @@ VideoRenderWorker::VideoRenderWorker(
         },
         [=](utility::event_atom, const utility::Uuid &job_id, const int return_code) {
             // Also sent directly from Python plugin thread monitoring the ffmpeg subprocess.
-            // We get this when the FFMPEG process exits
+            // We get this when the FFMPEG process exits, or from the native encoder
+            // when it has finished the output file
 
             ffmpeg_process_running_ = false;
+            const bool native       = native_encoder_ != nullptr;
+            if (native) {
+                ffmpeg_stdout_ += "\n" + native_encoder_->stats_report();
+                native_encoder_.reset();
+            }
+
             if (return_code) {
                 update_status(
-                    fmt::format("FFMpeg failed with code {}. Check log.", return_code), Failed);
+                    native ? std::string("Encoding failed. Check log.")
+                           : fmt::format(
+                                 "FFMpeg failed with code {}. Check log.", return_code),
+                    Failed);
             } else {
                 update_status("Complete", Complete);
                 if (auto_check_output_) {
@@ -385,25 +432,54 @@ VideoRenderWorker::VideoRenderWorker(
                     return;
                 }
             }
-            mail(utility::user_start_action_atom_v).send(renderer_plugin_);
+            // chunks aren't jobs in the plugin's queue
+            if (chunk_.empty())
+                mail(utility::user_start_action_atom_v).send(renderer_plugin_);
             send_exit(caf::actor_cast<caf::actor>(this), caf::exit_reason::user_shutdown);
         },
+        [=](utility::event_atom, const utility::JsonStore &chunks) {
+            // sent by the plugin once all the chunks of a parallel render are
+            // done
+            join_chunks(chunks);
+        },
+        [=](utility::event_atom, const std::string &chunk_error) {
+            // or this if one of them failed, in which case the plugin has
+            // stopped the rest
+            ffmpeg_stdout_ += chunk_error;
+            update_status("Chunk render failed. Check log.", Failed);
+            mail(utility::user_start_action_atom_v).send(renderer_plugin_);
+        },
         [=](playhead::step_atom) {
             // main render step funcition
             render_step();
+        },
+        [=](utility::event_atom, playhead::step_atom) {
+            // the native encoder has taken frames off its input queue
+            continue_render_loop();
         });
 
     update_status("Queued", Queued);
 
     // this will trigger an async call to clone_render_target. Calling that
     // function directly here is also possible but it might be slow to execute,
-    // causing the parent plugin to pause when it spawns the VideoRenderWorker
-    anon_mail(parent_playlist_item_id, target_render_item_id)
-        .send(caf::actor_cast<caf::actor>(this));
+    // causing the parent plugin to pause when it spawns the VideoRenderWorker.
+    // Chunks render from the clone that the job's worker made.
+    if (chunk_.empty()) {
+        anon_mail(parent_playlist_item_id, target_render_item_id)
+            .send(caf::actor_cast<caf::actor>(this));
+    }
 }
 
 void VideoRenderWorker::on_exit() {
 
+    // stops the encoder threads, leaving whatever it had written
+    native_encoder_.reset();
+
+    if (!chunk_dir_.empty()) {
+        std::error_code ec;
+        std::filesystem::remove_all(chunk_dir_, ec);
+    }
+
     if (audio_out_pipe_)
         send_exit(audio_out_pipe_, caf::exit_reason::user_shutdown);
     if (video_out_pipe_)
@@ -456,6 +532,12 @@ void VideoRenderWorker::update_status(
     new_status["video_preset"]     = video_preset_name_;
     new_status["visible"]          = true;
 
+    if (!chunk_.empty()) {
+        // the plugin folds chunk progress into the status of the job
+        new_status["parent_job_id"] = chunk_.at("parent_job_id");
+        new_status["chunk"]         = chunk_.at("index");
+    }
+
     static const std::map<RenderStatus, std::string> status_icons({
         {Queued, "qrc:/icons/pending.svg"},
         {InProgress, "qrc:/icons/directions_run.svg"},
@@ -517,7 +599,10 @@ void VideoRenderWorker::start_render_task() {
                     const timebase::flicks dur = utility::request_receive<timebase::flicks>(
                         *sys, playhead_, playhead::duration_flicks_atom_v, true);
 
-                    if (in_point_ == -1) {
+                    if (!chunk_.empty()) {
+                        playhead_position_ =
+                            timebase::flicks(chunk_.at("start").get<int64_t>());
+                    } else if (in_point_ == -1) {
                         playhead_position_ = timebase::flicks(0);
                     } else {
                         playhead_position_ = utility::request_receive<timebase::flicks>(
@@ -527,7 +612,9 @@ void VideoRenderWorker::start_render_task() {
                             in_point_);
                     }
 
-                    if (out_point_ == -1) {
+                    if (!chunk_.empty()) {
+                        end_position_ = timebase::flicks(chunk_.at("end").get<int64_t>());
+                    } else if (out_point_ == -1) {
                         end_position_ = dur;
                     } else {
                         end_position_ = utility::request_receive<timebase::flicks>(
@@ -562,8 +649,15 @@ void VideoRenderWorker::start_render_task() {
                              soundcard_sample_rate_) /
                             1000000;
 
-                        // next step ... start FFMpeg
-                        start_ffmpeg_process();
+                        // next step ... start encoding, in process if we can, or
+                        // split the job into chunks for the plugin to render in
+                        // parallel
+                        if (!chunk_.empty()) {
+                            if (!start_native_encoder())
+                                update_status("Chunk encoder failed. Check log.", Failed);
+                        } else if (!plan_chunks() && !start_native_encoder()) {
+                            start_ffmpeg_process();
+                        }
                     }
 
                 } catch (std::exception &e) {
@@ -585,6 +679,11 @@ void VideoRenderWorker::continue_render_loop() {
 
     if (completing_) {
 
+        // The native encoder finishes off the output once it has encoded
+        // everything that is queued, and then lets us know.
+        if (native_encoder_)
+            native_encoder_->finish();
+
         // If completing_ is true it means we have got to the end of the frame
         // range to be rendered and we've got all the image buffers and audio
         // buffers and queued them up to be piped to FFMPEG via the FIFOS.
@@ -605,19 +704,22 @@ void VideoRenderWorker::continue_render_loop() {
         }
 
     } else if (
-        video_bufs_in_flight_ < max_frames_in_flight_ ||
-        (audio_out_pipe_ && (audio_bufs_in_flight_ < max_frames_in_flight_))) {
+        native_encoder_
+            ? native_encoder_->ready()
+            : (video_bufs_in_flight_ < max_frames_in_flight_ ||
+               (audio_out_pipe_ && (audio_bufs_in_flight_ < max_frames_in_flight_)))) {
 
         // continue loop
         anon_mail(playhead::step_atom_v).send(caf::actor_cast<caf::actor>(this));
 
-        int cp = int(round(
-            timebase::to_seconds(playhead_position_) * 100.0 /
-            timebase::to_seconds(end_position_)));
+        // a chunk's progress is through its own range of frames
+        const auto start = chunk_.empty() ? timebase::flicks(0)
+                                          : timebase::flicks(chunk_.at("start").get<int64_t>());
+        int cp           = int(round(
+            timebase::to_seconds(playhead_position_ - start) * 100.0 /
+            std::max(timebase::to_seconds(end_position_ - start), 1e-6)));
         if (cp != percent_complete_) {
-            percent_complete_ = int(round(
-                timebase::to_seconds(playhead_position_) * 100.0 /
-                timebase::to_seconds(end_position_)));
+            percent_complete_ = cp;
             update_status(fmt::format("In Progress ({}%)", percent_complete_));
         }
     }
@@ -656,6 +758,13 @@ void VideoRenderWorker::encode_frame(const media_reader::ImageBufPtr &image) {
     // many video/audio buffers queued up which will consume a lot of system
     // RAM.
 
+    if (native_encoder_) {
+        // queued for the encoder's convert stage, which tells us when there's
+        // room for more
+        native_encoder_->add_video(image);
+        return;
+    }
+
     video_bufs_in_flight_++;
     mail(image)
         .request(video_out_pipe_, std::chrono::seconds(30))
@@ -674,6 +783,17 @@ void VideoRenderWorker::encode_frame(const media_reader::ImageBufPtr &image) {
 
 void VideoRenderWorker::encode_audio(const media_reader::AudioBufPtr &audio) {
 
+    if (chunk_audio_.is_open()) {
+        chunk_audio_.write(
+            reinterpret_cast<const char *>(audio->buffer()), audio->actual_sample_data_size());
+        return;
+    }
+
+    if (native_encoder_) {
+        native_encoder_->add_audio(audio);
+        return;
+    }
+
     // see notes in encode_frame for details on what's happening here.
     audio_bufs_in_flight_++;
     mail(audio)
@@ -689,6 +809,179 @@ void VideoRenderWorker::encode_audio(const media_reader::AudioBufPtr &audio) {
             });
 }
 
+bool VideoRenderWorker::start_native_encoder() {
+
+    if (!use_native_encoder_)
+        return false;
+
+    // the encoder calls us back from its own threads, it has our address
+    // rather than a handle so that it doesn't keep us alive
+    const auto self = caf::actor_cast<caf::actor_addr>(this);
+
+    try {
+
+        native_encoder_ = std::make_unique<NativeEncoder>(
+            output_file_path_,
+            resolution_,
+            rate_.to_fps(),
+            render_format_ == viewport::ImageFormat::RGBA_16,
+            video_codec_opts_,
+            audio_codec_opts_,
+            soundcard_sample_rate_,
+            [self]() {
+                if (auto dest = caf::actor_cast<caf::actor>(self))
+                    caf::anon_mail(utility::event_atom_v, playhead::step_atom_v).send(dest);
+            },
+            native_encoder_done());
+
+    } catch (std::exception &e) {
+        // options that only the ffmpeg executable understands, or a codec this
+        // build of libavcodec doesn't have. Chunks have no fallback.
+        if (!chunk_.empty()) {
+            ffmpeg_stdout_ += fmt::format("In process encoder failed: {}\n", e.what());
+            return false;
+        }
+        spdlog::info("{} falling back to ffmpeg: {}", __PRETTY_FUNCTION__, e.what());
+        ffmpeg_stdout_ +=
+            fmt::format("Encoding with ffmpeg, in process encoder: {}\n\n", e.what());
+        return false;
+    }
+
+    ffmpeg_stdout_ += fmt::format(
+        "Encoding in process with options: {} {}\n\n", video_codec_opts_, audio_codec_opts_);
+    update_status("Started encoder");
+    percent_complete_ = 0;
+
+    // start the rendering after initialising the colour settings
+    set_colour_params_and_start();
+    return true;
+}
+
+NativeEncoder::DoneFunc VideoRenderWorker::native_encoder_done() {
+
+    // reported the same way as the ffmpeg subprocess finishing
+    const auto self   = caf::actor_cast<caf::actor_addr>(this);
+    const auto job_id = job_uuid_;
+
+    return [self, job_id](const std::string &error) {
+        auto dest = caf::actor_cast<caf::actor>(self);
+        if (!dest)
+            return;
+        if (!error.empty()) {
+            caf::anon_mail(
+                utility::event_atom_v,
+                job_id,
+                fmt::format("Encoding failed: {}\n", error),
+                false)
+                .send(dest);
+        }
+        caf::anon_mail(utility::event_atom_v, job_id, int(error.empty() ? 0 : 1)).send(dest);
+    };
+}
+
+bool VideoRenderWorker::plan_chunks() {
+
+    if (parallel_renders_ < 2 || !use_native_encoder_ ||
+        !NativeEncoder::supported(video_codec_opts_, audio_codec_opts_))
+        return false;
+
+    // Chunks are whole GOPs, so the keyframes of the joined movie fall where
+    // they would have in a single encode. Each chunk starts a new GOP anyway,
+    // being encoded on its own.
+    auto video_opts = video_codec_opts_;
+    int gop         = std::max(chunk_frames_, 1);
+    const auto opts = utility::split(video_codec_opts_, ' ');
+    const auto g    = std::find(opts.begin(), opts.end(), "-g");
+    if (g != opts.end() && std::next(g) != opts.end()) {
+        try {
+            gop = std::max(std::stoi(*std::next(g)), 1);
+        } catch (...) {
+            return false;
+        }
+    } else {
+        video_opts += fmt::format(" -g {}", gop);
+    }
+    const int64_t chunk_frames = ((std::max(chunk_frames_, 1) + gop - 1) / gop) * gop;
+    const int64_t total_frames = (end_position_ - playhead_position_) / rate_ + 1;
+
+    // not worth it for a couple of chunks
+    if (total_frames < chunk_frames * 2)
+        return false;
+
+    const auto output = std::filesystem::path(output_file_path_);
+    chunk_dir_        = (output.parent_path() / fmt::format(
+                                                   ".{}.{}.chunks",
+                                                   output.filename().string(),
+                                                   to_string(job_uuid_)))
+                     .string();
+    std::error_code ec;
+    std::filesystem::create_directories(chunk_dir_, ec);
+    if (ec) {
+        spdlog::warn("{} {} {}", __PRETTY_FUNCTION__, chunk_dir_, ec.message());
+        chunk_dir_.clear();
+        return false;
+    }
+
+    utility::JsonStore plan;
+    plan["workers"] = parallel_renders_;
+    plan["options"] = render_options_;
+    plan["chunks"]  = nlohmann::json::array();
+
+    for (int64_t first = 0; first < total_frames; first += chunk_frames) {
+        const auto frames = std::min(chunk_frames, total_frames - first);
+        const auto index  = plan["chunks"].size();
+        const auto name   = fmt::format("chunk_{:05d}", index);
+
+        nlohmann::json chunk;
+        chunk["parent_job_id"] = job_uuid_;
+        chunk["index"]         = index;
+        chunk["frames"]        = frames;
+        chunk["start"]         = (playhead_position_ + rate_ * first).count();
+        chunk["end"]           = (playhead_position_ + rate_ * (first + frames - 1)).count();
+        chunk["video_codec_opts"] = video_opts;
+        chunk["video"] =
+            (std::filesystem::path(chunk_dir_) / (name + output.extension().string()))
+                .string();
+        chunk["audio"] = (std::filesystem::path(chunk_dir_) / (name + ".pcm")).string();
+        plan["chunks"].push_back(chunk);
+    }
+
+    update_status(fmt::format("Rendering {} chunks", plan["chunks"].size()));
+    percent_complete_ = 0;
+
+    // the plugin renders the chunks from our clone of the render target, and
+    // tells us when they are all done
+    mail(utility::event_atom_v, job_uuid_, renderable_, plan).send(renderer_plugin_);
+    return true;
+}
+
+void VideoRenderWorker::join_chunks(const utility::JsonStore &chunks) {
+
+    std::vector<std::string> video_files, audio_files;
+    for (const auto &chunk : chunks) {
+        video_files.push_back(chunk.at("video").get<std::string>());
+        audio_files.push_back(chunk.at("audio").get<std::string>());
+    }
+
+    try {
+        native_encoder_ = std::make_unique<NativeEncoder>(
+            output_file_path_,
+            video_files,
+            audio_files,
+            rate_.to_fps(),
+            audio_codec_opts_,
+            soundcard_sample_rate_,
+            native_encoder_done());
+    } catch (std::exception &e) {
+        update_status(
+            fmt::format("Failed with error: {} {}", __PRETTY_FUNCTION__, e.what()), Failed);
+        return;
+    }
+
+    ffmpeg_stdout_ += fmt::format("Joining {} chunks\n\n", video_files.size());
+    update_status("Joining chunks");
+}
+
 void VideoRenderWorker::start_ffmpeg_process() {
 
     // the ffmpeg subprocess is managed by the python component of this pluing.
@@ -982,6 +1275,7 @@ void VideoRenderWorker::render_step() {
         return;
 
     waiting_for_buffers_ = true;
+    render_step_start_   = std::chrono::steady_clock::now();
     // set playhead position
     mail(playhead::jump_atom_v, playhead_position_)
         .request(playhead_, infinite)
@@ -996,7 +1290,12 @@ void VideoRenderWorker::render_step() {
                     .request(offscreen_viewport_, infinite)
                     .then(
                         [=](const media_reader::ImageBufPtr &image) {
-                            if (render_format_ == viewport::ImageFormat::RGBA_16) {
+                            if (native_encoder_) {
+                                // the encoder flips the image as it converts it
+                                native_encoder_->record_stage(
+                                    "render",
+                                    std::chrono::steady_clock::now() - render_step_start_);
+                            } else if (render_format_ == viewport::ImageFormat::RGBA_16) {
                                 flop_rgba_image<uint16_t>(image);
                             } else {
                                 flop_rgba_image<uint8_t>(image);
@@ -1005,7 +1304,8 @@ void VideoRenderWorker::render_step() {
                             // send the image to ffmpeg
                             encode_frame(image);
 
-                            if (audio_out_pipe_) {
+                            if (audio_out_pipe_ || chunk_audio_.is_open() ||
+                                (native_encoder_ && native_encoder_->has_audio())) {
 
                                 // now make an empty audio buffer - we send this to the playhead
                                 // to fill with samples.
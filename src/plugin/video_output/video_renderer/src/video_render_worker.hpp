@@ -7,6 +7,7 @@
 #include <fstream>
 #include "xstudio/utility/json_store.hpp"
 #include "xstudio/media_reader/image_buffer.hpp"
+#include "video_render_encoder.hpp"
 
 namespace xstudio {
 
@@ -50,7 +51,9 @@ namespace video_render_plugin_1_0 {
             const utility::JsonStore &render_options,
             caf::actor offscreen_viewport,
             caf::actor colour_pipeline,
-            caf::actor renderer_plugin);
+            caf::actor renderer_plugin,
+            caf::actor renderable           = caf::actor(),
+            const utility::JsonStore &chunk = utility::JsonStore());
 
         void on_exit() override;
 
@@ -68,6 +71,10 @@ namespace video_render_plugin_1_0 {
         void start_render_task();
         void continue_render_loop();
         void start_ffmpeg_process();
+        bool start_native_encoder();
+        NativeEncoder::DoneFunc native_encoder_done();
+        bool plan_chunks();
+        void join_chunks(const utility::JsonStore &chunks);
         void set_colour_params_and_start();
         void stop_ffmpeg_process();
         void render_step();
@@ -99,6 +106,17 @@ namespace video_render_plugin_1_0 {
 
         caf::actor playhead_, colour_pipeline_;
         caf::actor video_out_pipe_, audio_out_pipe_;
+        std::unique_ptr<NativeEncoder> native_encoder_;
+
+        // A chunk worker renders part of the frame range for a parallel render,
+        // in which case chunk_ says which part and where it goes. The worker
+        // for the job as a whole then only plans the chunks and joins them.
+        const utility::JsonStore render_options_;
+        utility::JsonStore chunk_;
+        std::ofstream chunk_audio_;
+        std::string chunk_dir_;
+        int parallel_renders_ = {1};
+        int chunk_frames_     = {240};
         caf::behavior behavior_;
 
         std::string output_yuv_filename_, output_audio_filename_;
@@ -110,12 +128,14 @@ namespace video_render_plugin_1_0 {
         int video_bufs_in_flight_            = {0};
         const int max_frames_in_flight_      = 32;
         bool ffmpeg_process_running_         = {false};
+        bool use_native_encoder_             = {true};
         bool waiting_for_buffers_            = {false};
         bool completing_                     = {false};
         int soundcard_sample_rate_           = {48000};
         int percent_complete_                = {-1};
         int64_t num_audio_samples_delivered_ = {0};
         RenderStatus status_                 = {Queued};
+        std::chrono::steady_clock::time_point render_step_start_;
     };
 
 } // namespace video_render_plugin_1_0
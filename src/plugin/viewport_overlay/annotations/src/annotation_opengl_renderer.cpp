@@ -81,17 +81,7 @@ void AnnotationsRenderer::render_image_overlay(
         return;
     }
 
-    auto render_data = frame.plugin_blind_data(AnnotationsTool::PLUGIN_UUID);
-    if (render_data) {
-        const auto *data = dynamic_cast<const AnnotationRenderDataSet *>(render_data.get());
-        if (data) {
-            handle_                       = data->handle_;
-            current_edited_bookmark_uuid_ = data->current_edited_bookmark_uuid_;
-            laser_drawing_mode_           = data->laser_mode_;
-            frame_being_annotated_        = data->interaction_frame_key_;
-            annotations_visible_          = data->show_annotations_;
-        }
-    }
+    update_render_state(frame);
 
     if (!annotations_visible_)
         return;
@@ -148,6 +138,69 @@ void AnnotationsRenderer::render_image_overlay(
     glClear(GL_DEPTH_BUFFER_BIT);
 }
 
+void AnnotationsRenderer::render_image_overlay_cpu(
+    float *rgba,
+    const Imath::V2i &window_size,
+    const Imath::M44f &transform_window_to_viewport_space,
+    const Imath::M44f &transform_viewport_to_image_space,
+    const float viewport_du_dpixel,
+    const xstudio::media_reader::ImageBufPtr &frame) {
+
+    update_render_state(frame);
+
+    if (!annotations_visible_)
+        return;
+
+    ui::canvas::CPUCanvasRenderer renderer;
+    bool draw_interaction_canvas = false;
+
+    for (const auto &anno : frame.bookmarks()) {
+
+        if (anno->detail_.uuid_ == current_edited_bookmark_uuid_) {
+            draw_interaction_canvas = true;
+            continue;
+        }
+
+        const Annotation *my_annotation =
+            dynamic_cast<const Annotation *>(anno->annotation_.get());
+        if (my_annotation) {
+            renderer.render_canvas(
+                my_annotation->canvas(),
+                rgba,
+                window_size,
+                transform_window_to_viewport_space,
+                transform_viewport_to_image_space,
+                viewport_du_dpixel);
+        }
+    }
+
+    if (draw_interaction_canvas || (current_edited_bookmark_uuid_.is_null() &&
+                                    (frame_being_annotated_ == frame.frame_id().key()))) {
+        renderer.render_canvas(
+            interaction_canvas_,
+            rgba,
+            window_size,
+            transform_window_to_viewport_space,
+            transform_viewport_to_image_space,
+            viewport_du_dpixel);
+    }
+}
+
+void AnnotationsRenderer::update_render_state(const xstudio::media_reader::ImageBufPtr &frame) {
+
+    auto render_data = frame.plugin_blind_data(AnnotationsTool::PLUGIN_UUID);
+    if (render_data) {
+        const auto *data = dynamic_cast<const AnnotationRenderDataSet *>(render_data.get());
+        if (data) {
+            handle_                       = data->handle_;
+            current_edited_bookmark_uuid_ = data->current_edited_bookmark_uuid_;
+            laser_drawing_mode_           = data->laser_mode_;
+            frame_being_annotated_        = data->interaction_frame_key_;
+            annotations_visible_          = data->show_annotations_;
+        }
+    }
+}
+
 void AnnotationsRenderer::render_viewport_overlay(
     const Imath::M44f &transform_window_to_viewport_space,
     const Imath::M44f &transform_viewport_to_normalised_coords,
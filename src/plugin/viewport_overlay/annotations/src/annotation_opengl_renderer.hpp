@@ -3,6 +3,7 @@
 
 #include "xstudio/plugin_manager/plugin_base.hpp"
 #include "xstudio/ui/opengl/opengl_canvas_renderer.hpp"
+#include "xstudio/ui/canvas/cpu_canvas_renderer.hpp"
 #include "annotation.hpp"
 #include "xstudio/ui/opengl/shader_program_base.hpp"
 
@@ -34,9 +35,19 @@ namespace ui {
                 const float device_pixel_ratio,
                 const bool have_alpha_buffer) override;
 
+            void render_image_overlay_cpu(
+                float *rgba,
+                const Imath::V2i &window_size,
+                const Imath::M44f &transform_window_to_viewport_space,
+                const Imath::M44f &transform_viewport_to_image_space,
+                const float viewport_du_dpixel,
+                const xstudio::media_reader::ImageBufPtr &frame) override;
+
             RenderPass preferred_render_pass() const override { return BeforeImage; }
 
           private:
+            void update_render_state(const xstudio::media_reader::ImageBufPtr &frame);
+
             void render_pixel_picker_patch(
                 const Imath::M44f &transform_window_to_viewport_space,
                 const Imath::M44f &transform_viewport_to_image_space,
@@ -6,9 +6,12 @@
 
 #include <fstream>
 #include <iostream>
+#include <optional>
 
 #include "xstudio/plugin_manager/plugin_manager.hpp"
+#include "xstudio/utility/chrono.hpp"
 #include "xstudio/utility/helpers.hpp"
+#include "xstudio/utility/logging.hpp"
 
 using namespace xstudio::plugin_manager;
 using namespace xstudio::utility;
@@ -40,12 +43,187 @@ std::string GetLastErrorAsString() {
 }
 #endif
 
+namespace {
+
+// bump to invalidate existing manifests
+const int manifest_version = 1;
+
+// identifies a build of a library, the manifest entry is ignored if it changes
+nlohmann::json library_stamp(const fs::path &path) {
+    const auto mtime = fs::last_write_time(path).time_since_epoch().count();
+    auto result      = nlohmann::json::object();
+    result["mtime"]  = static_cast<int64_t>(mtime);
+    result["size"]   = static_cast<uint64_t>(fs::file_size(path));
+    return result;
+}
+
+bool is_plugin_library(const fs::path &path) {
+#ifdef _WIN32
+    return path.extension() == ".dll";
+#else
+    return path.extension() == ".so" || path.extension() == ".dylib";
+#endif
+}
+
+} // namespace
+
+PluginEntry::PluginEntry(std::shared_ptr<PluginFactory> pf, std::string path)
+    : plugin_factory_(std::move(pf)),
+      path_(std::move(path)),
+      uuid_(plugin_factory_->uuid()),
+      name_(plugin_factory_->name()),
+      type_(plugin_factory_->type()),
+      resident_(plugin_factory_->resident()),
+      author_(plugin_factory_->author()),
+      description_(plugin_factory_->description()),
+      version_(plugin_factory_->version()) {
+    // auto enable xstudio plugins
+    // we might want to use uuids list.
+    if (author_ != "xStudio")
+        enabled_ = false;
+}
+
+PluginEntry::PluginEntry(const nlohmann::json &jsn, std::string path)
+    : path_(std::move(path)),
+      uuid_(jsn.at("uuid").get<Uuid>()),
+      name_(jsn.at("name").get<std::string>()),
+      type_(jsn.at("type").get<PluginType>()),
+      resident_(jsn.at("resident").get<bool>()),
+      author_(jsn.at("author").get<std::string>()),
+      description_(jsn.at("description").get<std::string>()),
+      version_(jsn.at("version").get<std::string>()) {
+    if (author_ != "xStudio")
+        enabled_ = false;
+}
+
+nlohmann::json PluginEntry::json() const {
+    return nlohmann::json{
+        {"uuid", uuid_},
+        {"name", name_},
+        {"type", type_},
+        {"resident", resident_},
+        {"author", author_},
+        {"description", description_},
+        {"version", version_.to_string()}};
+}
+
 PluginManager::PluginManager(std::list<std::string> plugin_paths)
     : plugin_paths_(std::move(plugin_paths)) {}
 
+void PluginManager::load_manifest() {
+    manifest_ = nlohmann::json::object();
+    if (manifest_path_.empty() or not fs::exists(manifest_path_))
+        return;
+
+    try {
+        std::ifstream i(manifest_path_);
+        nlohmann::json j;
+        i >> j;
+        if (j.value("version", 0) == manifest_version and j.count("libraries"))
+            manifest_ = j.at("libraries");
+    } catch (const std::exception &err) {
+        spdlog::warn("{} {} {}", __PRETTY_FUNCTION__, manifest_path_, err.what());
+    }
+}
+
+void PluginManager::save_manifest() const {
+    if (manifest_path_.empty())
+        return;
+
+    try {
+        const auto dir = fs::path(manifest_path_).parent_path();
+        if (not dir.empty())
+            fs::create_directories(dir);
+
+        // write and rename, other instances may be reading it.
+        const auto tmp = manifest_path_ + "." + to_string(Uuid::generate());
+        {
+            std::ofstream o(tmp);
+            o.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+            o << nlohmann::json{{"version", manifest_version}, {"libraries", manifest_}}.dump(
+                2);
+        }
+        fs::rename(tmp, manifest_path_);
+    } catch (const std::exception &err) {
+        spdlog::warn("{} {} {}", __PRETTY_FUNCTION__, manifest_path_, err.what());
+    }
+}
+
+std::optional<std::vector<std::shared_ptr<PluginFactory>>>
+PluginManager::load_library(const std::string &path) {
+    std::vector<std::shared_ptr<PluginFactory>> result;
+
+#ifdef _WIN32
+    HMODULE hndl = LoadLibraryA(path.c_str());
+    if (hndl == nullptr) {
+        spdlog::warn("{} {}", __PRETTY_FUNCTION__, GetLastErrorAsString());
+        return {};
+    }
+
+    plugin_factory_collection_ptr pfcp;
+    pfcp = reinterpret_cast<plugin_factory_collection_ptr>(
+        GetProcAddress(hndl, "plugin_factory_collection_ptr"));
+
+    if (pfcp == nullptr) {
+        spdlog::debug("{} {}", __PRETTY_FUNCTION__, GetLastErrorAsString());
+        FreeLibrary(hndl);
+        return result;
+    }
+#else
+    // clear any errors..
+    dlerror();
+
+    // open .so
+    void *hndl = dlopen(path.c_str(), RTLD_NOW);
+    if (hndl == nullptr) {
+        spdlog::warn("{} {}", __PRETTY_FUNCTION__, dlerror());
+        return {};
+    }
+
+    plugin_factory_collection_ptr pfcp;
+    *(void **)(&pfcp) = dlsym(hndl, "plugin_factory_collection_ptr");
+    if (pfcp == nullptr) {
+        spdlog::debug("{} {}", __PRETTY_FUNCTION__, dlerror());
+        dlclose(hndl);
+        return result;
+    }
+#endif
+
+    loaded_libraries_.insert(path);
+
+    PluginFactoryCollection *pfc = nullptr;
+    try {
+        pfc    = pfcp();
+        result = pfc->factories();
+    } catch (const std::exception &err) {
+        spdlog::warn("{} Failed to init plugin {} {}", __PRETTY_FUNCTION__, path, err.what());
+    }
+    if (pfc)
+        delete pfc;
+
+    return result;
+}
+
 size_t PluginManager::load_plugins() {
     // scan for .so or .dll for each path.
-    size_t loaded = 0;
+    size_t loaded         = 0;
+    size_t from_manifest  = 0;
+    bool manifest_changed = false;
+    const auto start      = utility::clock::now();
+
+    load_manifest();
+
+    auto add_plugin = [&](PluginEntry &&entry) {
+        if (not factories_.count(entry.uuid())) {
+            // new plugin..
+            loaded++;
+            spdlog::debug(
+                "Add plugin {} {} {}", to_string(entry.uuid()), entry.name(), entry.path());
+            factories_.emplace(entry.uuid(), std::move(entry));
+        } else if (factories_.at(entry.uuid()).path() != entry.path()) {
+            spdlog::warn("Ignore duplicate plugin {} {}", entry.name(), entry.path());
+        }
+    };
 
     for (const auto &path : plugin_paths_) {
         try {
@@ -54,131 +232,100 @@ size_t PluginManager::load_plugins() {
                 if (not fs::is_regular_file(entry.status()))
                     continue;
 
-#ifdef _WIN32
-
-                if (entry.path().extension() != ".dll")
+                // only want .so / .dylib / .dll
+                if (not is_plugin_library(entry.path()))
                     continue;
 
-                // open .dll
-                std::string dllPath = entry.path().string();
-
-                HMODULE hndl = LoadLibraryA(dllPath.c_str());
-                if (hndl == nullptr) {
-                    DWORD errorCode = GetLastError();
-                    LPSTR buffer    = nullptr;
-                    DWORD size      = FormatMessageA(
-                        FORMAT_MESSAGE_ALLOCATE_BUFFER | FORMAT_MESSAGE_FROM_SYSTEM |
-                            FORMAT_MESSAGE_IGNORE_INSERTS,
-                        nullptr,
-                        errorCode,
-                        MAKELANGID(LANG_NEUTRAL, SUBLANG_DEFAULT),
-                        reinterpret_cast<LPSTR>(&buffer),
-                        0,
-                        nullptr);
-                    std::string errorMsg(buffer, size);
-                    LocalFree(buffer);
-                    spdlog::warn("{} {}", __PRETTY_FUNCTION__, errorMsg);
-                    continue;
-                }
+                const auto lib_path = entry.path().string();
+                const auto stamp    = library_stamp(entry.path());
 
-                plugin_factory_collection_ptr pfcp;
-                pfcp = reinterpret_cast<plugin_factory_collection_ptr>(
-                    GetProcAddress(hndl, "plugin_factory_collection_ptr"));
-
-                if (pfcp == nullptr) {
-                    spdlog::debug("{} {}", __PRETTY_FUNCTION__, GetLastErrorAsString());
-                    FreeLibrary(hndl);
-                    continue;
-                }
-#else
-                if (entry.path().extension() != ".so" && entry.path().extension() != ".dylib")
-                    continue;
-                // only want .so / .dylib
-                // clear any errors..
-                dlerror();
-
-                // open .so
-                void *hndl = dlopen(entry.path().c_str(), RTLD_NOW);
-                if (hndl == nullptr) {
-                    spdlog::warn("{} {}", __PRETTY_FUNCTION__, dlerror());
-                    continue;
+                // unchanged since it was last loaded, no need to open it.
+                if (manifest_.count(lib_path) and
+                    manifest_.at(lib_path).value("stamp", nlohmann::json()) == stamp) {
+                    try {
+                        for (const auto &i : manifest_.at(lib_path).at("plugins")) {
+                            add_plugin(PluginEntry(i, lib_path));
+                            from_manifest++;
+                        }
+                        continue;
+                    } catch (const std::exception &err) {
+                        spdlog::warn("{} {} {}", __PRETTY_FUNCTION__, lib_path, err.what());
+                    }
                 }
 
-                plugin_factory_collection_ptr pfcp;
-                *(void **)(&pfcp) = dlsym(hndl, "plugin_factory_collection_ptr");
-                if (pfcp == nullptr) {
-                    spdlog::debug("{} {}", __PRETTY_FUNCTION__, dlerror());
-                    dlclose(hndl);
+                // only record libraries that could be opened, so failures are retried.
+                const auto factories = load_library(lib_path);
+                if (not factories)
                     continue;
-                }
-#endif
 
-                PluginFactoryCollection *pfc = nullptr;
-                try {
-                    pfc = pfcp();
-                    for (const auto &i : pfc->factories()) {
-                        if (not factories_.count(i->uuid())) {
-                            // new plugin..
-                            loaded++;
-#ifdef _WIN32
-                            factories_.emplace(
-                                i->uuid(), PluginEntry(i, entry.path().string()));
-#else
-                            factories_.emplace(i->uuid(), PluginEntry(i, entry.path()));
-#endif
-                            spdlog::debug(
-                                "Add plugin {} {} {}",
-                                to_string(i->uuid()),
-                                i->name(),
-                                entry.path().string());
-                        } else {
-                            spdlog::warn(
-                                "Ignore duplicate plugin {} {}",
-                                i->name(),
-                                entry.path().string());
-                        }
-                    }
-                } catch (const std::exception &err) {
-                    spdlog::warn(
-                        "{} Failed to init plugin {} {}",
-                        __PRETTY_FUNCTION__,
-#ifdef _WIN32
-                        entry.path().string(),
-#else
-                        entry.path().c_str(),
-#endif
-                        err.what());
+                auto plugins = nlohmann::json::array();
+                for (const auto &i : *factories) {
+                    PluginEntry pe(i, lib_path);
+                    plugins.push_back(pe.json());
+                    add_plugin(std::move(pe));
                 }
-                if (pfc)
-                    delete pfc;
+                manifest_[lib_path] = nlohmann::json{{"stamp", stamp}, {"plugins", plugins}};
+                manifest_changed    = true;
             }
         } catch (const std::exception &err) {
             spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
         }
     }
+
+    if (manifest_changed)
+        save_manifest();
+
+    spdlog::debug(
+        "Found {} plugins in {:.1f}ms, {} from manifest, {} libraries loaded",
+        loaded,
+        std::chrono::duration<double, std::milli>(utility::clock::now() - start).count(),
+        from_manifest,
+        loaded_libraries_.size());
+
     return loaded;
 }
 
+PluginFactory *PluginManager::factory(const utility::Uuid &uuid) {
+    if (not factories_.count(uuid))
+        throw std::runtime_error("Invalid plugin uuid");
+
+    auto &entry = factories_.at(uuid);
+    if (entry.loaded())
+        return entry.factory();
+
+    if (loaded_libraries_.count(entry.path()))
+        throw std::runtime_error(
+            "Plugin " + entry.name() + " missing from library " + entry.path());
+
+    // first use, load the library and hand its factories to all of its entries
+    spdlog::debug("Load plugin library {} for {}", entry.path(), entry.name());
+    const auto factories = load_library(entry.path());
+    for (const auto &i : factories.value_or(std::vector<std::shared_ptr<PluginFactory>>())) {
+        auto it = factories_.find(i->uuid());
+        if (it != factories_.end() and it->second.path() == entry.path())
+            it->second.set_factory(i);
+    }
+
+    if (not entry.loaded())
+        throw std::runtime_error("Failed to load plugin library " + entry.path());
+
+    return entry.factory();
+}
+
 caf::actor PluginManager::spawn(
     caf::blocking_actor &sys, const utility::Uuid &uuid, const utility::JsonStore &json) {
 
-    auto spawned = caf::actor();
-    if (factories_.count(uuid))
-        spawned = factories_.at(uuid).factory()->spawn(sys, json);
-    else
-        throw std::runtime_error("Invalid plugin uuid");
-
-    return spawned;
+    return factory(uuid)->spawn(sys, json);
 }
 
 std::string PluginManager::spawn_widget_ui(const utility::Uuid &uuid) {
     if (factories_.count(uuid))
-        return factories_.at(uuid).factory()->spawn_widget_ui();
+        return factory(uuid)->spawn_widget_ui();
     return "";
 }
 
 std::string PluginManager::spawn_menu_ui(const utility::Uuid &uuid) {
     if (factories_.count(uuid))
-        return factories_.at(uuid).factory()->spawn_menu_ui();
+        return factory(uuid)->spawn_menu_ui();
     return "";
 }
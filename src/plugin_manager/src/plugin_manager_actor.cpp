@@ -35,6 +35,12 @@ PluginManagerActor::PluginManagerActor(caf::actor_config &cfg) : caf::event_base
         }
     }
 
+    // plugins are listed from the manifest and their libraries loaded on first use
+    const auto prefs_path = preference_path();
+    if (not prefs_path.empty())
+        manager_.set_manifest_path(
+            (fs::path(prefs_path).parent_path() / "plugin_manifest.json").string());
+
     manager_.load_plugins();
 
     try {
@@ -66,7 +72,7 @@ PluginManagerActor::PluginManagerActor(caf::actor_config &cfg) : caf::event_base
             auto actors = std::vector<caf::actor>();
 
             for (const auto &i : manager_.factories()) {
-                if (i.second.factory()->type() & PluginFlags::PF_DATA_SOURCE and
+                if (i.second.type() & PluginFlags::PF_DATA_SOURCE and
                     resident_.count(i.first))
                     actors.push_back(resident_[i.first]);
             }
@@ -104,7 +110,7 @@ PluginManagerActor::PluginManagerActor(caf::actor_config &cfg) : caf::event_base
             auto actors = std::vector<caf::actor>();
 
             for (const auto &i : manager_.factories()) {
-                if (i.second.factory()->type() & PluginFlags::PF_DATA_SOURCE and
+                if (i.second.type() & PluginFlags::PF_DATA_SOURCE and
                     resident_.count(i.first))
                     actors.push_back(resident_[i.first]);
             }
@@ -138,7 +144,7 @@ PluginManagerActor::PluginManagerActor(caf::actor_config &cfg) : caf::event_base
             auto actors = std::vector<caf::actor>();
 
             for (const auto &i : manager_.factories()) {
-                if (i.second.factory()->type() & PluginFlags::PF_DATA_SOURCE and
+                if (i.second.type() & PluginFlags::PF_DATA_SOURCE and
                     resident_.count(i.first))
                     actors.push_back(resident_[i.first]);
             }
@@ -222,7 +228,7 @@ PluginManagerActor::PluginManagerActor(caf::actor_config &cfg) : caf::event_base
         [=](utility::detail_atom, const PluginType type) -> std::vector<PluginDetail> {
             std::vector<PluginDetail> details;
             for (const auto &i : manager_.factories()) {
-                if (i.second.factory()->type() & type)
+                if (i.second.type() & type)
                     details.emplace_back(PluginDetail(i.second));
             }
 
@@ -257,7 +263,7 @@ PluginManagerActor::PluginManagerActor(caf::actor_config &cfg) : caf::event_base
             // find enabled / resident plugins
             update_from_preferences(json);
             // for(const auto &i : manager_.factories()) {
-            //     if(i.second.factory()->resident() and i.second.enabled())
+            //     if(i.second.resident() and i.second.enabled())
             //         enable_resident(i.first, true, json);
             // }
         },
@@ -420,7 +426,7 @@ PluginManagerActor::PluginManagerActor(caf::actor_config &cfg) : caf::event_base
             manager_.factories().at(uuid).set_enabled(enabled);
 
             // check if it's a resident
-            if (manager_.factories().at(uuid).factory()->resident())
+            if (manager_.factories().at(uuid).resident())
                 enable_resident(uuid, enabled);
 
             mail(utility::event_atom_v, utility::detail_atom_v, manager_.plugin_detail())
@@ -473,7 +479,7 @@ void PluginManagerActor::update_from_preferences(const utility::JsonStore &json)
         }
 
         for (const auto &i : manager_.factories()) {
-            if (i.second.factory()->resident() and i.second.enabled())
+            if (i.second.resident() and i.second.enabled())
                 enable_resident(i.first, true, json);
         }
 
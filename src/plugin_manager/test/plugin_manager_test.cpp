@@ -56,3 +56,43 @@ TEST(PluginManagerTest, Test) {
         EXPECT_EQ(name, "hello");
     }
 }
+
+TEST(PluginManagerTest, Manifest) {
+    fixture f;
+
+    const auto manifest = (fs::temp_directory_path() /
+                           ("plugin_manifest_" + to_string(Uuid::generate()) + ".json"))
+                              .string();
+    utility::Uuid test_uuid1("17e4323c-8ee7-4d9c-b74a-57ba805c10e8");
+
+    // first run opens the libraries and writes the manifest
+    {
+        PluginManager pm(std::list<std::string>({{PLUGIN_DIR}}));
+        pm.set_manifest_path(manifest);
+        EXPECT_TRUE(pm.load_plugins() > 0);
+        EXPECT_TRUE(pm.libraries_loaded() > 0);
+        EXPECT_TRUE(fs::exists(manifest));
+    }
+
+    // second run lists plugins without opening anything
+    PluginManager pm(std::list<std::string>({{PLUGIN_DIR}}));
+    pm.set_manifest_path(manifest);
+    EXPECT_TRUE(pm.load_plugins() > 0);
+    EXPECT_EQ(pm.libraries_loaded(), size_t(0));
+
+    ASSERT_TRUE(pm.factories().count(test_uuid1));
+    const auto &entry = pm.factories().at(test_uuid1);
+    EXPECT_FALSE(entry.loaded());
+    EXPECT_EQ(entry.name(), "hello");
+    EXPECT_EQ(PluginDetail(entry).name_, "hello");
+
+    // spawning loads the library
+    auto actor1 = pm.spawn(*(f.self), test_uuid1);
+    EXPECT_TRUE(actor1);
+    EXPECT_TRUE(entry.loaded());
+    EXPECT_EQ(pm.libraries_loaded(), size_t(1));
+
+    EXPECT_THROW(pm.factory(Uuid::generate()), std::runtime_error);
+
+    fs::remove(manifest);
+}
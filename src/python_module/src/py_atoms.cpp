@@ -157,6 +157,7 @@ void py_config::add_atoms() {
     ADD_ATOM(xstudio::media_reader, clear_precache_queue_atom);
     ADD_ATOM(xstudio::media_reader, get_image_atom);
     ADD_ATOM(xstudio::media_reader, get_thumbnail_atom);
+    ADD_ATOM(xstudio::media_reader, image_statistics_atom);
     ADD_ATOM(xstudio::media_reader, process_thumbnail_atom);
     ADD_ATOM(xstudio::media_reader, get_media_detail_atom);
     ADD_ATOM(xstudio::media_reader, precache_audio_atom);
@@ -165,16 +166,24 @@ void py_config::add_atoms() {
     ADD_ATOM(xstudio::media_reader, do_precache_work_atom);
     ADD_ATOM(xstudio::media_reader, get_reader_atom);
     ADD_ATOM(xstudio::media_reader, push_image_atom);
+    ADD_ATOM(xstudio::media_reader, read_ahead_atom);
     ADD_ATOM(xstudio::media_reader, retire_readers_atom);
+    ADD_ATOM(xstudio::media_reader, return_worker_atom);
     ADD_ATOM(xstudio::media_reader, supported_atom);
     ADD_ATOM(xstudio::media_cache, count_atom);
     ADD_ATOM(xstudio::media_cache, erase_atom);
     ADD_ATOM(xstudio::media_cache, keys_atom);
+    ADD_ATOM(xstudio::media_cache, playhead_hint_atom);
     ADD_ATOM(xstudio::media_cache, preserve_atom);
+    ADD_ATOM(xstudio::media_cache, proxy_atom);
+    ADD_ATOM(xstudio::media_cache, quota_atom);
     ADD_ATOM(xstudio::media_cache, unpreserve_atom);
     ADD_ATOM(xstudio::media_cache, retrieve_atom);
     ADD_ATOM(xstudio::media_cache, size_atom);
+    ADD_ATOM(xstudio::media_cache, stats_atom);
     ADD_ATOM(xstudio::media_cache, store_atom);
+    ADD_ATOM(xstudio::media_cache, usage_atom);
+    ADD_ATOM(xstudio::media_cache, warm_start_atom);
     ADD_ATOM(xstudio::colour_pipeline, colour_pipeline_atom);
     ADD_ATOM(xstudio::colour_pipeline, get_colour_pipe_data_atom);
     ADD_ATOM(xstudio::colour_pipeline, get_colour_pipe_params_atom);
@@ -217,6 +226,7 @@ void py_config::add_atoms() {
     ADD_ATOM(xstudio::global, get_studio_atom);
     ADD_ATOM(xstudio::global, get_scanner_atom);
     ADD_ATOM(xstudio::global, remote_session_name_atom);
+    ADD_ATOM(xstudio::global, startup_timing_atom);
     ADD_ATOM(xstudio::global, status_atom);
     ADD_ATOM(xstudio::global, get_actor_from_registry_atom);
     ADD_ATOM(xstudio::global, authenticate_atom);
@@ -265,6 +275,7 @@ void py_config::add_atoms() {
     ADD_ATOM(xstudio::utility, uuid_atom);
     ADD_ATOM(xstudio::utility, version_atom);
     ADD_ATOM(xstudio::utility, notification_atom);
+    ADD_ATOM(xstudio::utility, frame_trace_atom);
     ADD_ATOM(xstudio::json_store, get_json_atom);
     ADD_ATOM(xstudio::json_store, jsonstore_change_atom);
     ADD_ATOM(xstudio::json_store, patch_atom);
@@ -329,11 +340,13 @@ void py_config::add_atoms() {
     ADD_ATOM(xstudio::http_client, http_put_simple_atom);
     ADD_ATOM(xstudio::http_client, http_delete_atom);
     ADD_ATOM(xstudio::http_client, http_delete_simple_atom);
+    ADD_ATOM(xstudio::http_client, http_stats_atom);
     ADD_ATOM(xstudio::shotgun_client, shotgun_acquire_authentication_atom);
     ADD_ATOM(xstudio::shotgun_client, shotgun_acquire_token_atom);
     ADD_ATOM(xstudio::shotgun_client, shotgun_authenticate_atom);
     ADD_ATOM(xstudio::shotgun_client, shotgun_credential_atom);
     ADD_ATOM(xstudio::shotgun_client, shotgun_entity_atom);
+    ADD_ATOM(xstudio::shotgun_client, shotgun_entity_batch_atom);
     ADD_ATOM(xstudio::shotgun_client, shotgun_entity_filter_atom);
     ADD_ATOM(xstudio::shotgun_client, shotgun_entity_search_atom);
     ADD_ATOM(xstudio::shotgun_client, shotgun_host_atom);
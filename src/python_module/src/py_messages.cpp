@@ -10,6 +10,7 @@
 #include "py_opaque.hpp"
 
 #include "xstudio/global_store/global_store.hpp"
+#include "xstudio/media_reader/image_buffer.hpp"
 #include "xstudio/playhead/playhead.hpp"
 #include "xstudio/playlist/playlist.hpp"
 #include "xstudio/ui/mouse.hpp"
@@ -33,6 +34,7 @@ extern void register_uuid_class(py::module &m, const std::string &name);
 extern void register_plugindetail_class(py::module &m, const std::string &name);
 extern void register_playlisttree_class(py::module &m, const std::string &name);
 extern void register_thumbnailbuffer_class(py::module &m, const std::string &name);
+extern void register_imagebuffer_class(py::module &m, const std::string &name);
 extern void register_streamdetail_class(py::module &m, const std::string &name);
 extern void register_timecode_class(py::module &m, const std::string &name);
 extern void register_mediareference_class(py::module &m, const std::string &name);
@@ -174,6 +176,13 @@ void py_config::add_messages() {
         "xstudio::thumbnail::ThumbnailBuffer",
         &register_thumbnailbuffer_class);
 
+    // decoded images can only be received in process, e.g. by embedded python
+    add_message_type<xstudio::media_reader::ImageBufPtr>(
+        "ImageBuffer", "xstudio::media_reader::ImageBufPtr", &register_imagebuffer_class);
+
+    add_message_type<std::vector<xstudio::media_reader::ImageBufPtr>>(
+        "ImageBufferVec", "std::vector<xstudio::media_reader::ImageBufPtr>", nullptr);
+
     add_message_type<xstudio::timeline::Item>(
         "Item", "xstudio::timeline::Item", &register_item_class);
 
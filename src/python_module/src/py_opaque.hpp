@@ -6,8 +6,10 @@ CAF_PUSH_WARNINGS
 #include <pybind11/pybind11.h>
 CAF_POP_WARNINGS
 
+#include "xstudio/media/media.hpp"
 #include "xstudio/utility/uuid.hpp"
 
 PYBIND11_MAKE_OPAQUE(std::vector<std::string>)
 PYBIND11_MAKE_OPAQUE(std::vector<xstudio::utility::Uuid>)
 PYBIND11_MAKE_OPAQUE(std::vector<xstudio::utility::UuidActor>)
+PYBIND11_MAKE_OPAQUE(std::vector<xstudio::media::AVFrameID>)
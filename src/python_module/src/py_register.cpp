@@ -20,6 +20,8 @@ CAF_POP_WARNINGS
 
 #include "xstudio/bookmark/bookmark.hpp"
 #include "xstudio/global_store/global_store.hpp"
+#include "xstudio/media_reader/image_buffer.hpp"
+#include "xstudio/media_reader/pixel_layout.hpp"
 #include "xstudio/playlist/playlist.hpp"
 #include "xstudio/plugin_manager/plugin_manager.hpp"
 #include "xstudio/thumbnail/thumbnail.hpp"
@@ -227,14 +229,148 @@ void register_playlisttree_class(py::module &m, const std::string &name) {
 }
 
 void register_thumbnailbuffer_class(py::module &m, const std::string &name) {
+    // numpy.asarray(thumb) is a view of the pixels, rows x columns x channels
+    auto buffer_impl = [](thumbnail::ThumbnailBuffer &x) {
+        const bool is_float = x.format() == thumbnail::TF_RGBF96;
+        const auto itemsize = x.pixel_stride() / x.channels();
+        return py::buffer_info(
+            x.data().data(),
+            static_cast<py::ssize_t>(itemsize),
+            is_float ? py::format_descriptor<float>::format()
+                     : py::format_descriptor<uint8_t>::format(),
+            3,
+            std::vector<py::ssize_t>(
+                {static_cast<py::ssize_t>(x.height()),
+                 static_cast<py::ssize_t>(x.width()),
+                 static_cast<py::ssize_t>(x.channels())}),
+            std::vector<py::ssize_t>(
+                {static_cast<py::ssize_t>(x.row_stride()),
+                 static_cast<py::ssize_t>(x.pixel_stride()),
+                 static_cast<py::ssize_t>(itemsize)}));
+    };
+
     py::class_<thumbnail::ThumbnailBuffer, std::shared_ptr<thumbnail::ThumbnailBuffer>>(
-        m, name.c_str())
+        m, name.c_str(), py::buffer_protocol())
         .def(py::init<>())
+        .def_buffer(buffer_impl)
         .def("width", &thumbnail::ThumbnailBuffer::width)
         .def("height", &thumbnail::ThumbnailBuffer::height)
+        .def("channels", &thumbnail::ThumbnailBuffer::channels)
         .def("data", &thumbnail::ThumbnailBuffer::data);
 }
 
+namespace {
+
+// a plane of an image buffer, holds a reference to the buffer so a numpy
+// array made from it keeps the pixels alive.
+struct ImageBufferPlane {
+    media_reader::ImageBufPtr buf;
+    media_reader::PixelPlane plane;
+};
+
+py::buffer_info plane_buffer_info(
+    const media_reader::ImageBufPtr &buf, const media_reader::PixelPlane &plane) {
+    // decoded frames are shared with the cache and viewports, so read only
+    return py::buffer_info(
+        const_cast<std::byte *>(buf->buffer()) + plane.offset,
+        static_cast<py::ssize_t>(plane.itemsize),
+        plane.format,
+        3,
+        std::vector<py::ssize_t>(plane.shape.begin(), plane.shape.end()),
+        std::vector<py::ssize_t>(plane.strides.begin(), plane.strides.end()),
+        true);
+}
+
+nlohmann::json plane_json(const media_reader::PixelPlane &plane) {
+    return nlohmann::json{
+        {"name", plane.name},
+        {"offset", plane.offset},
+        {"shape", plane.shape},
+        {"strides", plane.strides},
+        {"format", plane.format}};
+}
+
+} // namespace
+
+void register_imagebuffer_class(py::module &m, const std::string &name) {
+
+    py::class_<ImageBufferPlane>(m, (name + "Plane").c_str(), py::buffer_protocol())
+        .def_buffer([](ImageBufferPlane &x) { return plane_buffer_info(x.buf, x.plane); })
+        .def("name", [](const ImageBufferPlane &x) { return x.plane.name; })
+        .def("layout", [](const ImageBufferPlane &x) { return plane_json(x.plane); });
+
+    // numpy.asarray(image) is a view of the first plane of pixels, see
+    // media_reader::pixel_layout for how the readers' layouts are described.
+    py::class_<media_reader::ImageBufPtr>(m, name.c_str(), py::buffer_protocol())
+        .def(py::init<>())
+        .def_buffer([](media_reader::ImageBufPtr &x) {
+            if (!x or !x->buffer())
+                throw std::runtime_error("Image buffer is empty");
+            return plane_buffer_info(x, media_reader::pixel_layout(*x).front());
+        })
+        .def("__bool__", [](const media_reader::ImageBufPtr &x) { return bool(x); })
+        .def(
+            "width",
+            [](const media_reader::ImageBufPtr &x) {
+                return x ? x->image_size_in_pixels().x : 0;
+            })
+        .def(
+            "height",
+            [](const media_reader::ImageBufPtr &x) {
+                return x ? x->image_size_in_pixels().y : 0;
+            })
+        .def(
+            "data_window",
+            [](const media_reader::ImageBufPtr &x) {
+                const auto b = x ? x->image_pixels_bounding_box() : Imath::Box2i();
+                return std::vector<int>({b.min.x, b.min.y, b.max.x, b.max.y});
+            })
+        .def(
+            "size",
+            [](const media_reader::ImageBufPtr &x) -> size_t { return x ? x->size() : 0; })
+        .def(
+            "error",
+            [](const media_reader::ImageBufPtr &x) {
+                return x ? x->error_message() : std::string();
+            })
+        .def(
+            "media_key",
+            [](const media_reader::ImageBufPtr &x) {
+                return x ? x->media_key() : media::MediaKey();
+            })
+        .def(
+            "shader_params",
+            [](const media_reader::ImageBufPtr &x) {
+                return x ? x->shader_params() : utility::JsonStore();
+            })
+        .def(
+            "params",
+            [](const media_reader::ImageBufPtr &x) {
+                return x ? x->params() : utility::JsonStore();
+            })
+        .def(
+            "metadata",
+            [](const media_reader::ImageBufPtr &x) {
+                return x ? x->metadata() : utility::JsonStore();
+            })
+        .def(
+            "layout",
+            [](const media_reader::ImageBufPtr &x) {
+                auto result = nlohmann::json::array();
+                if (x)
+                    for (const auto &p : media_reader::pixel_layout(*x))
+                        result.push_back(plane_json(p));
+                return result;
+            })
+        .def("planes", [](const media_reader::ImageBufPtr &x) {
+            std::vector<ImageBufferPlane> result;
+            if (x and x->buffer())
+                for (const auto &p : media_reader::pixel_layout(*x))
+                    result.push_back(ImageBufferPlane{x, p});
+            return result;
+        });
+}
+
 void register_streamdetail_class(py::module &m, const std::string &name) {
     auto str_impl = [](const media::StreamDetail &x) { return to_string(x); };
     py::class_<media::StreamDetail>(m, name.c_str())
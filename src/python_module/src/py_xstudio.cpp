@@ -192,6 +192,7 @@ PYBIND11_MODULE(__pybind_xstudio, m) {
 
     py::bind_vector<std::vector<std::string>>(m, "VectorString");
     py::bind_vector<std::vector<xstudio::utility::Uuid>>(m, "VectorUuid");
+    py::bind_vector<std::vector<xstudio::media::AVFrameID>>(m, "VectorAVFrameID");
 
     py_remote_session_file(m);
     py_playhead(m);
@@ -33,7 +33,15 @@ namespace {
 
 class SessionIOActor : public caf::event_based_actor {
   public:
-    SessionIOActor(caf::actor_config &cfg) : caf::event_based_actor(cfg) {}
+    SessionIOActor(caf::actor_config &cfg) : caf::event_based_actor(cfg) {
+        try {
+            auto prefs = GlobalStoreHelper(system());
+            JsonStore j;
+            join_broadcast(this, prefs.get_group(j));
+            binary_ = preference_value<bool>(j, "/core/session/binary_session");
+        } catch (...) {
+        }
+    }
     const char *name() const override { return NAME.c_str(); }
 
     caf::message_handler message_handler() {
@@ -46,7 +54,20 @@ class SessionIOActor : public caf::event_based_actor {
                 size_t new_hash = 0;
 
                 try {
-                    auto data = js.dump(2);
+                    const auto ext =
+                        to_lower(path_to_string(fs::path(uri_to_posix_path(path)).extension()));
+                    const bool compress = ext == ".xsz";
+                    // binary encoding is only used for .xsz, plain .xst files stay
+                    // human readable for interchange
+                    const bool binary = compress and binary_;
+
+                    std::string data;
+                    if (binary) {
+                        const auto bin = json_to_binary(js);
+                        data.assign(bin.begin(), bin.end());
+                    } else {
+                        data = js.dump(2);
+                    }
 
                     auto resolve_link = false;
                     new_hash          = std::hash<std::string>{}(data);
@@ -75,13 +96,16 @@ class SessionIOActor : public caf::event_based_actor {
 
 
                     // compress data.
-                    if (to_lower(path_to_string(fs::path(save_path).extension())) == ".xsz") {
-                        zstr::ofstream o(save_path + ".tmp");
+                    if (compress) {
+                        zstr::ofstream o(save_path + ".tmp", std::ios::out | std::ios::binary);
                         try {
                             o.exceptions(std::ifstream::failbit | std::ifstream::badbit);
                             // if(not o.is_open())
                             //     throw std::runtime_error();
-                            o << std::setw(4) << data << std::endl;
+                            if (binary)
+                                o.write(data.data(), data.size());
+                            else
+                                o << std::setw(4) << data << std::endl;
                             o.close();
                         } catch (const std::exception &) {
                             // remove failed file
@@ -122,13 +146,27 @@ class SessionIOActor : public caf::event_based_actor {
                 }
 
                 return new_hash;
-            }};
+            },
+
+            [=](json_store::update_atom,
+                const JsonStore &change,
+                const std::string &path,
+                const JsonStore &) {
+                try {
+                    if (path == "/core/session/binary_session/value")
+                        binary_ = change.get<bool>();
+                } catch (std::exception &err) {
+                    spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
+                }
+            },
+            [=](json_store::update_atom, const JsonStore &) {}};
     }
 
     caf::behavior make_behavior() override { return message_handler(); }
 
   private:
     inline static const std::string NAME = "SessionIOActor";
+    bool binary_{false};
 };
 
 
@@ -20,6 +20,13 @@ using namespace caf;
 
 using sce = shotgun_client_error;
 
+namespace {
+// how long entity requests wait for others to share a GET with
+const auto entity_batch_delay = std::chrono::milliseconds(10);
+// ids in one batched GET, keeping the query string a sensible length
+const size_t max_entity_batch = 100;
+} // namespace
+
 ShotgunClientActor::ShotgunClientActor(caf::actor_config &cfg) : caf::event_based_actor(cfg) {
     init();
 }
@@ -28,7 +35,10 @@ void ShotgunClientActor::init() {
     spdlog::debug("Created ShotgunClientActor");
     print_on_exit(this, "ShotgunClientActor");
 
-    http_ = spawn<HTTPClientActor>(CPPHTTPLIB_CONNECTION_TIMEOUT_SECOND, 20, 20);
+    // entities fetched again within a few seconds come from the http cache,
+    // our own updates drop what it holds of them
+    http_ = spawn<HTTPClientActor>(
+        CPPHTTPLIB_CONNECTION_TIMEOUT_SECOND, 20, 20, 10, std::chrono::seconds(5));
     link_to(http_);
 
     event_group_ = spawn<broadcast::BroadcastActor>(this);
@@ -111,7 +121,7 @@ void ShotgunClientActor::init() {
         [=](shotgun_entity_atom, const std::string &entity, const int record_id) {
             auto rp = make_response_promise<JsonStore>();
             authenticate(rp, [=]() {
-                request_entity(entity, record_id, std::vector<std::string>(), rp);
+                queue_entity_request(entity, record_id, std::vector<std::string>(), rp);
             });
             return rp;
         },
@@ -121,10 +131,14 @@ void ShotgunClientActor::init() {
             const int record_id,
             const std::vector<std::string> &fields) -> result<JsonStore> {
             auto rp = make_response_promise<JsonStore>();
-            authenticate(rp, [=]() { request_entity(entity, record_id, fields, rp); });
+            authenticate(rp, [=]() { queue_entity_request(entity, record_id, fields, rp); });
             return rp;
         },
 
+        [=](shotgun_entity_batch_atom, const std::string &entity, const std::string &fields) {
+            request_entity_batch(entity, fields);
+        },
+
         // [=](shotgun_entity_filter_atom, const std::string &entity) -> result<JsonStore> {
         //     auto rp = make_response_promise<JsonStore>();
         //     authenticate(rp, [=]() {
@@ -871,6 +885,110 @@ void ShotgunClientActor::request_entity(
             [=](error &err) mutable { rp.deliver(std::move(err)); });
 }
 
+void ShotgunClientActor::queue_entity_request(
+    const std::string &entity,
+    const int record_id,
+    const std::vector<std::string> &fields,
+    caf::typed_response_promise<utility::JsonStore> rp) {
+    // requests for the same kind of record arriving close together are
+    // fetched with one GET
+    const auto key = std::make_pair(entity, join_as_string(fields, ","));
+    auto &batch    = entity_batches_[key];
+    if (batch.empty())
+        anon_mail(shotgun_entity_batch_atom_v, key.first, key.second)
+            .delay(entity_batch_delay)
+            .send(this);
+    batch.emplace_back(record_id, rp);
+}
+
+void ShotgunClientActor::request_entity_batch(
+    const std::string &entity, const std::string &fields) {
+    auto p = entity_batches_.find(std::make_pair(entity, fields));
+    if (p == entity_batches_.end())
+        return;
+    auto batch = std::move(p->second);
+    entity_batches_.erase(p);
+
+    const auto field_list = fields.empty() ? std::vector<std::string>() : split(fields, ',');
+
+    std::map<int, std::vector<caf::typed_response_promise<JsonStore>>> requests;
+    for (const auto &i : batch)
+        requests[i.first].push_back(i.second);
+
+    auto fallback = [=](const int record_id,
+                        std::vector<caf::typed_response_promise<JsonStore>> rps) {
+        for (auto &rp : rps)
+            request_entity(entity, record_id, field_list, rp);
+    };
+
+    while (not requests.empty()) {
+        std::map<int, std::vector<caf::typed_response_promise<JsonStore>>> chunk;
+        while (not requests.empty() and chunk.size() < max_entity_batch)
+            chunk.insert(requests.extract(requests.begin()));
+
+        // a lone request uses the single record endpoint, as it always has
+        if (chunk.size() == 1) {
+            fallback(chunk.begin()->first, chunk.begin()->second);
+            continue;
+        }
+
+        std::vector<std::string> ids;
+        for (const auto &i : chunk)
+            ids.push_back(std::to_string(i.first));
+
+        httplib::Params params(
+            {{"fields", fields.empty() ? "*" : fields},
+             {"filter[id]", join_as_string(ids, ",")},
+             {"page[size]", std::to_string(ids.size())}});
+
+        mail(
+            http_get_atom_v,
+            base_.scheme_host_port(),
+            std::string("/api/v1/entity/" + entity),
+            base_.get_auth_headers(),
+            params)
+            .request(http_, infinite)
+            .then(
+                [=](const httplib::Response &response) mutable {
+                    try {
+                        auto jsn = nlohmann::json::parse(response.body);
+
+                        // split the records into what a single entity request
+                        // would have returned
+                        if (jsn.count("data") and jsn.at("data").is_array()) {
+                            for (const auto &record : jsn.at("data")) {
+                                auto r = chunk.find(record.value("id", 0));
+                                if (r == chunk.end())
+                                    continue;
+
+                                auto single = nlohmann::json{{"data", record}};
+                                if (record.count("links") and
+                                    record.at("links").count("self"))
+                                    single["links"] = {
+                                        {"self", record.at("links").at("self")}};
+
+                                for (auto &rp : r->second)
+                                    rp.deliver(JsonStore(single));
+                                chunk.erase(r);
+                            }
+                        }
+                    } catch (const std::exception &err) {
+                        spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
+                    }
+
+                    // records we didn't get, errors included, are asked for
+                    // one at a time so they're reported as before
+                    for (auto &i : chunk)
+                        fallback(i.first, i.second);
+                },
+                [=](error &err) mutable {
+                    for (auto &i : chunk)
+                        for (auto &rp : i.second)
+                            rp.deliver(err);
+                });
+    }
+}
+
 void ShotgunClientActor::request_entity_search(
     const std::string &entity,
     const JsonStore &conditions,
@@ -2,6 +2,10 @@
 #include <caf/policy/select_all.hpp>
 #include <caf/actor_registry.hpp>
 
+#include <future>
+#include <thread>
+#include <unordered_map>
+
 #include <opentimelineio/version.h>
 #include <opentimelineio/timeline.h>
 #include <opentimelineio/gap.h>
@@ -11,6 +15,7 @@
 #include <opentimelineio/externalReference.h>
 #include <opentimelineio/imageSequenceReference.h>
 #include <opentimelineio/deserialization.h>
+#include <opentimelineio/serialization.h>
 
 #include <cpp-colors/colors.h>
 
@@ -280,6 +285,61 @@ namespace otio = opentimelineio::OPENTIMELINEIO_VERSION;
 //         }
 //     }
 // }
+// metadata attached to an otio object, without serialising the object and its children.
+JsonStore otio_metadata(const otio::SerializableObjectWithMetadata *object) {
+    auto result = JsonStore();
+    try {
+        otio::ErrorStatus err;
+        auto str =
+            otio::serialize_json_to_string(std::any(object->metadata()), nullptr, &err, 0);
+        if (not otio::is_error(err))
+            result = JsonStore(nlohmann::json::parse(str));
+    } catch (const std::exception &err) {
+        spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
+    }
+    return result;
+}
+
+FrameRateDuration otio_duration(const otio::RationalTime &time) {
+    return FrameRateDuration(
+        static_cast<int>(time.value()), FrameRate(fps_to_flicks(time.rate())));
+}
+
+// url of the clip's active media reference, relative paths are resolved against the otio file.
+std::string otio_clip_url(const otio::Clip *clip, const caf::uri &path) {
+    auto result = std::string();
+
+    if (auto ext = dynamic_cast<otio::ExternalReference *>(clip->media_reference())) {
+        result = ext->target_url();
+    } else if (
+        auto seq = dynamic_cast<otio::ImageSequenceReference *>(clip->media_reference())) {
+        result = seq->target_url_base() + seq->name_prefix() + "{:0" +
+                 std::to_string(seq->frame_zero_padding()) + "d}" + seq->name_suffix();
+    }
+
+    if (not result.empty() and not caf::make_uri(result) and result.find("http") != 0) {
+        // not uri....
+        // assume relative ?
+        if (result[0] != '/') {
+            auto tmp       = uri_to_posix_path(path);
+            auto const pos = tmp.find_last_of('/');
+            result         = "file://" + tmp.substr(0, pos + 1) + result;
+        } else {
+            result = "file://" + result;
+        }
+    }
+
+    return result;
+}
+
+// key used to match clips against media, file uris are compared as posix paths so that
+// differences in encoding don't stop us reusing media that's already in the playlist.
+std::string media_lookup_key(const std::string &url) {
+    if (auto uri = caf::make_uri(url); uri and uri->scheme() == "file")
+        return uri_to_posix_path(*uri);
+    return url;
+}
+
 std::vector<Marker> process_markers(
     const std::vector<otio::SerializableObject::Retainer<otio::Marker>> &markers,
     const FrameRate &timeline_rate) {
@@ -292,12 +352,10 @@ std::vector<Marker> process_markers(
             m.set_flag(colors::to_ahex_str<char>(colors::color(
                 colors::value_of(colors::wpf_named_color_converter::value(om->color())))));
 
-        auto marker_metadata = JsonStore();
         try {
-            otio::ErrorStatus err;
-            auto marker_metadata = nlohmann::json::parse(om->to_json_string(&err, {}, 0));
-            if (marker_metadata.count("metadata")) {
-                m.set_prop(JsonStore(marker_metadata.at("metadata")));
+            auto marker_metadata = otio_metadata(om.value);
+            if (not marker_metadata.is_null()) {
+                m.set_prop(marker_metadata);
                 if (m.prop().contains(COLOUR_JPOINTER)) {
                     m.set_flag(m.prop().at(COLOUR_JPOINTER).get<std::string>());
                 }
@@ -306,15 +364,9 @@ std::vector<Marker> process_markers(
             spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
         }
 
-
         auto marked_range = om->marked_range();
         m.set_range(FrameRange(
-            FrameRateDuration(
-                static_cast<int>(marked_range.start_time().value()),
-                FrameRate(fps_to_flicks(marked_range.start_time().rate()))),
-            FrameRateDuration(
-                static_cast<int>(marked_range.duration().value()),
-                FrameRate(fps_to_flicks(marked_range.duration().rate())))));
+            otio_duration(marked_range.start_time()), otio_duration(marked_range.duration())));
 
         result.emplace_back(m);
     }
@@ -322,406 +374,214 @@ std::vector<Marker> process_markers(
     return result;
 }
 
-void process_item(
-    const std::vector<otio::SerializableObject::Retainer<otio::Composable>> &items,
-    blocking_actor *self,
-    const caf::actor &timeline_actor,
-    caf::actor &parent,
-    const caf::uri &path, // otio path
-    const std::map<std::string, UuidActor> &media_lookup,
-    const FrameRate &timeline_rate) {
+// item state we understand from the otio metadata, written by our export or by fcp xml.
+struct OTIOItemState {
+    JsonStore metadata;
+    std::string name;
+    std::string flag;
+    std::string media_flag;
+    bool enabled{true};
+    bool locked{false};
+    bool conform_track{false};
+};
+
+OTIOItemState otio_item_state(const otio::Item *item) {
+    const static auto fcp_locked_path  = nlohmann::json::json_pointer("/fcp_xml/locked");
+    const static auto fcp_enabled_path = nlohmann::json::json_pointer("/fcp_xml/enabled");
+    const static auto fcp_track_name_path =
+        nlohmann::json::json_pointer("/fcp_xml/@MZ.TrackName");
+
+    auto result     = OTIOItemState();
+    result.metadata = otio_metadata(item);
+    result.name     = item->name();
+    result.enabled  = item->enabled();
 
-    auto fcp_locked_path     = nlohmann::json::json_pointer("/fcp_xml/locked");
-    auto fcp_enabled_path    = nlohmann::json::json_pointer("/fcp_xml/enabled");
-    auto fcp_track_name_path = nlohmann::json::json_pointer("/fcp_xml/@MZ.TrackName");
-
-    // let the fun begin..
-    for (auto i : items) {
-        if (auto ii = dynamic_cast<otio::Track *>(&(*i))) {
-            // spdlog::warn("Track");
-            auto media_type = media::MediaType::MT_IMAGE;
-            if (ii->kind() == otio::Track::Kind::audio)
-                media_type = media::MediaType::MT_AUDIO;
-
-            auto locked        = false;
-            auto enabled       = ii->enabled();
-            auto name          = ii->name();
-            auto metadata      = JsonStore();
-            auto flag          = std::string();
-            auto conform_track = false;
-
-            try {
-                // "fcp_xml": {
-                //     "@MZ.TrackName": "Cut Ref QT",
-                //     "@MZ.TrackTargeted": "1",
-                //     "@TL.SQTrackExpanded": "0",
-                //     "@TL.SQTrackExpandedHeight": "45",
-                //     "@TL.SQTrackShy": "0",
-                //     "enabled": "TRUE",
-                //     "locked": "FALSE"
-                //   }
-                otio::ErrorStatus err;
-                auto track_metadata = nlohmann::json::parse(ii->to_json_string(&err, {}, 0));
+    try {
+        // "fcp_xml": {
+        //     "@MZ.TrackName": "Cut Ref QT",
+        //     "@MZ.TrackTargeted": "1",
+        //     "@TL.SQTrackExpanded": "0",
+        //     "@TL.SQTrackExpandedHeight": "45",
+        //     "@TL.SQTrackShy": "0",
+        //     "enabled": "TRUE",
+        //     "locked": "FALSE"
+        //   }
+        const auto &metadata = result.metadata;
 
-                if (track_metadata.count("metadata"))
-                    metadata = JsonStore(track_metadata.at("metadata"));
+        if (metadata.contains(fcp_locked_path) and
+            metadata.at(fcp_locked_path).get<std::string>() == "TRUE")
+            result.locked = true;
 
-                if (metadata.contains(fcp_locked_path) and
-                    metadata.at(fcp_locked_path).get<std::string>() == "TRUE")
-                    locked = true;
+        if (metadata.contains(fcp_enabled_path) and
+            metadata.at(fcp_enabled_path).get<std::string>() == "FALSE")
+            result.enabled = false;
 
-                if (metadata.contains(fcp_enabled_path) and
-                    metadata.at(fcp_enabled_path).get<std::string>() == "FALSE")
-                    enabled = false;
+        if (metadata.contains(fcp_track_name_path) and
+            metadata.at(fcp_track_name_path).get<std::string>() != "")
+            result.name = metadata.at(fcp_track_name_path).get<std::string>();
 
-                if (metadata.contains(fcp_track_name_path) and
-                    metadata.at(fcp_track_name_path).get<std::string>() != "")
-                    name = metadata.at(fcp_track_name_path).get<std::string>();
+        if (metadata.contains(COLOUR_JPOINTER))
+            result.flag = metadata.at(COLOUR_JPOINTER).get<std::string>();
 
-                if (metadata.contains(COLOUR_JPOINTER))
-                    flag = metadata.at(COLOUR_JPOINTER).get<std::string>();
+        if (metadata.contains(MEDIA_COLOUR_JPOINTER))
+            result.media_flag = metadata.at(MEDIA_COLOUR_JPOINTER).get<std::string>();
 
-                if (metadata.contains(LOCKED_JPOINTER))
-                    locked = metadata.at(LOCKED_JPOINTER).get<bool>();
+        if (metadata.contains(LOCKED_JPOINTER))
+            result.locked = metadata.at(LOCKED_JPOINTER).get<bool>();
 
-                if (metadata.contains(CONFORM_JPOINTER))
-                    conform_track = metadata.at(CONFORM_JPOINTER).get<bool>();
+        if (metadata.contains(CONFORM_JPOINTER))
+            result.conform_track = metadata.at(CONFORM_JPOINTER).get<bool>();
 
-                if (metadata.contains(ENABLED_JPOINTER))
-                    enabled = metadata.at(ENABLED_JPOINTER).get<bool>();
+        if (metadata.contains(ENABLED_JPOINTER))
+            result.enabled = metadata.at(ENABLED_JPOINTER).get<bool>();
 
-            } catch (const std::exception &err) {
-                spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
-            }
+    } catch (const std::exception &err) {
+        spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
+    }
 
-            auto uuid  = Uuid::generate();
-            auto actor = self->spawn<TrackActor>(name, timeline_rate, media_type, uuid);
-
-            if (locked)
-                self->mail(item_lock_atom_v, locked)
-                    .request(actor, infinite)
-                    .receive([=](const JsonStore &) {}, [=](const error &err) {});
-
-            if (conform_track) {
-                self->mail(item_prop_atom_v)
-                    .request(timeline_actor, infinite)
-                    .receive(
-                        [=](JsonStore &prop) {
-                            prop["conform_track_uuid"] = uuid;
-                            self->mail(item_prop_atom_v, prop)
-                                .request(timeline_actor, infinite)
-                                .receive([=](const JsonStore &) {}, [=](const error &err) {});
-                        },
-                        [=](const error &err) {});
-            }
+    return result;
+}
 
-            if (not enabled)
-                self->mail(plugin_manager::enable_atom_v, enabled)
-                    .request(actor, infinite)
-                    .receive([=](const JsonStore &) {}, [=](const error &err) {});
-
-            if (not flag.empty())
-                self->mail(item_flag_atom_v, flag)
-                    .request(actor, infinite)
-                    .receive([=](const JsonStore &) {}, [=](const error &err) {});
-
-            anon_mail(item_prop_atom_v, metadata, "").send(actor);
-
-            auto source_range = ii->source_range();
-            if (source_range)
-                self->mail(
-                        active_range_atom_v,
-                        FrameRange(FrameRateDuration(
-                            static_cast<int>(source_range->duration().value()),
-                            FrameRate(fps_to_flicks(source_range->duration().rate())))))
-                    .request(actor, infinite)
-                    .receive([=](const JsonStore &) {}, [=](const error &err) {});
-
-            self->mail(insert_item_atom_v, -1, UuidActorVector({UuidActor(uuid, actor)}))
-                .request(parent, infinite)
-                .receive([=](const JsonStore &) {}, [=](const error &err) {});
-
-            process_item(
-                ii->children(), self, timeline_actor, actor, path, media_lookup, timeline_rate);
-        } else if (auto ii = dynamic_cast<otio::Gap *>(&(*i))) {
+void apply_otio_state(Item &item, const OTIOItemState &state) {
+    item.set_enabled(state.enabled);
+    item.set_locked(state.locked);
 
-            auto uuid = Uuid::generate();
-            auto actor =
-                self->spawn<GapActor>(ii->name(), FrameRateDuration(0, timeline_rate), uuid);
-            auto source_range = ii->source_range();
+    if (not state.flag.empty())
+        item.set_flag(state.flag);
 
-            try {
-                auto locked   = false;
-                auto enabled  = ii->enabled();
-                auto metadata = JsonStore();
-                auto flag     = std::string();
-                otio::ErrorStatus err;
-                auto ometadata = nlohmann::json::parse(ii->to_json_string(&err, {}, 0));
+    if (state.metadata.is_object() and not state.metadata.empty()) {
+        auto prop = item.prop();
+        if (not prop.is_object())
+            prop = JsonStore(R"({})"_json);
+        prop.update(state.metadata, true);
+        item.set_prop(prop);
+    }
+}
 
-                if (ometadata.count("metadata"))
-                    metadata = JsonStore(ometadata.at("metadata"));
+// the tracks of an otio stack in our order, otio lists video tracks bottom up.
+std::vector<otio::SerializableObject::Retainer<otio::Composable>>
+otio_stack_tracks(const otio::Stack *stack) {
+    std::vector<otio::SerializableObject::Retainer<otio::Composable>> result;
 
-                if (metadata.contains(fcp_locked_path) and
-                    metadata.at(fcp_locked_path).get<std::string>() == "TRUE")
-                    locked = true;
+    const auto &children = stack->children();
+    for (auto it = children.rbegin(); it != children.rend(); ++it) {
+        auto track = dynamic_cast<otio::Track *>(it->value);
+        if (track and track->kind() != otio::Track::Kind::audio)
+            result.emplace_back(*it);
+    }
 
-                if (metadata.contains(fcp_enabled_path) and
-                    metadata.at(fcp_enabled_path).get<std::string>() == "FALSE")
-                    enabled = false;
+    for (const auto &child : children) {
+        auto track = dynamic_cast<otio::Track *>(child.value);
+        if (track and track->kind() == otio::Track::Kind::audio)
+            result.emplace_back(child);
+    }
 
-                if (metadata.contains(COLOUR_JPOINTER))
-                    flag = metadata.at(COLOUR_JPOINTER).get<std::string>();
+    return result;
+}
 
-                if (metadata.contains(LOCKED_JPOINTER))
-                    locked = metadata.at(LOCKED_JPOINTER).get<bool>();
+// shared state while building the timeline from otio
+struct OTIOImport {
+    caf::uri path;
+    FrameRate rate;
+    // media keyed on media_lookup_key of the active reference url
+    std::unordered_map<std::string, UuidActor> media;
+    Uuid conform_track_uuid;
+    std::vector<std::pair<UuidActor, std::string>> media_flags;
+};
+
+// Build the items for the otio children in memory, no actors are involved, they're spawned
+// from the finished tree.
+void build_items(
+    const std::vector<otio::SerializableObject::Retainer<otio::Composable>> &items,
+    Item &parent,
+    OTIOImport &otio_import) {
 
-                if (metadata.contains(ENABLED_JPOINTER))
-                    enabled = metadata.at(ENABLED_JPOINTER).get<bool>();
+    for (const auto &i : items) {
+        if (auto ii = dynamic_cast<otio::Track *>(&(*i))) {
+            auto media_type = media::MediaType::MT_IMAGE;
+            if (ii->kind() == otio::Track::Kind::audio)
+                media_type = media::MediaType::MT_AUDIO;
 
-                if (locked)
-                    self->mail(item_lock_atom_v, locked)
-                        .request(actor, infinite)
-                        .receive([=](const JsonStore &) {}, [=](const error &err) {});
+            const auto state = otio_item_state(ii);
+            auto track       = Track(state.name, otio_import.rate, media_type);
+            apply_otio_state(track.item(), state);
 
-                if (not enabled)
-                    self->mail(plugin_manager::enable_atom_v, enabled)
-                        .request(actor, infinite)
-                        .receive([=](const JsonStore &) {}, [=](const error &err) {});
+            if (auto source_range = ii->source_range())
+                track.item().set_active_range(
+                    FrameRange(otio_duration(source_range->duration())));
 
-                if (not flag.empty())
-                    self->mail(item_flag_atom_v, flag)
-                        .request(actor, infinite)
-                        .receive([=](const JsonStore &) {}, [=](const error &err) {});
+            build_items(ii->children(), track.item(), otio_import);
 
-                anon_mail(item_prop_atom_v, metadata, "").send(actor);
-            } catch (const std::exception &err) {
-                spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
-            }
+            if (state.conform_track)
+                otio_import.conform_track_uuid = track.item().uuid();
 
-            if (source_range)
-                self->mail(
-                        active_range_atom_v,
-                        FrameRange(FrameRateDuration(
-                            static_cast<int>(source_range->duration().value()),
-                            FrameRate(fps_to_flicks(source_range->duration().rate())))))
-                    .request(actor, infinite)
-                    .receive([=](const JsonStore &) {}, [=](const error &err) {});
+            parent.push_back(track.item());
+        } else if (auto ii = dynamic_cast<otio::Gap *>(&(*i))) {
+            const auto state = otio_item_state(ii);
+            auto gap         = Gap(state.name, FrameRateDuration(0, otio_import.rate));
+            apply_otio_state(gap.item(), state);
 
-            self->mail(insert_item_atom_v, -1, UuidActorVector({UuidActor(uuid, actor)}))
-                .request(parent, infinite)
-                .receive([=](const JsonStore &) {}, [=](const error &err) {});
+            if (auto source_range = ii->source_range())
+                gap.item().set_active_range(
+                    FrameRange(otio_duration(source_range->duration())));
 
+            parent.push_back(gap.item());
         } else if (auto ii = dynamic_cast<otio::Clip *>(&(*i))) {
-            // spdlog::warn("Clip");
-            // what does it contain ?
-            auto uuid  = Uuid::generate();
-            auto actor = caf::actor();
-
-            const auto active_key = ii->active_media_reference_key();
-            auto active_path      = std::string();
-
-            if (auto active = otio::SerializableObject::Retainer<otio::ExternalReference>(
-                    dynamic_cast<otio::ExternalReference *>(ii->media_reference()))) {
-                active_path = active->target_url();
-            } else if (
-                auto active = otio::SerializableObject::Retainer<otio::ImageSequenceReference>(
-                    dynamic_cast<otio::ImageSequenceReference *>(ii->media_reference()))) {
-                active_path = active->target_url_base() + active->name_prefix() + "{:0" +
-                              std::to_string(active->frame_zero_padding()) + "d}" +
-                              active->name_suffix();
+            const auto state = otio_item_state(ii);
+            const auto url   = otio_clip_url(ii, otio_import.path);
+            auto media       = UuidActor();
+
+            if (not url.empty()) {
+                auto it = otio_import.media.find(media_lookup_key(url));
+                if (it != otio_import.media.end())
+                    media = it->second;
             }
 
-            // active_path maybe relative..
-            if (not active_path.empty() and not caf::make_uri(active_path) and
-                active_path.find("http") != 0) {
-                // not uri....
-                // assume relative ?
-                if (active_path[0] != '/') {
-                    auto tmp       = uri_to_posix_path(path);
-                    auto const pos = tmp.find_last_of('/');
-                    active_path    = "file://" + tmp.substr(0, pos + 1) + active_path;
-                } else {
-                    active_path = "file://" + active_path;
-                }
-            }
+            // missing media gives a clip with a null media uuid.
+            auto clip = Clip(state.name, Uuid::generate(), caf::actor(), media.uuid());
+            apply_otio_state(clip.item(), state);
 
-            if (active_path.empty() or not media_lookup.count(active_path)) {
-                // missing media..
-                actor = self->spawn<ClipActor>(UuidActor(), ii->name(), uuid);
-            } else {
-                actor = self->spawn<ClipActor>(media_lookup.at(active_path), ii->name(), uuid);
-            }
+            if (auto source_range = ii->source_range()) {
+                const auto active = FrameRange(
+                    otio_duration(source_range->start_time()),
+                    otio_duration(source_range->duration()));
 
-            try {
-                auto locked     = false;
-                auto enabled    = ii->enabled();
-                auto metadata   = JsonStore();
-                auto flag       = std::string();
-                auto media_flag = std::string();
-                otio::ErrorStatus err;
-                auto ometadata = nlohmann::json::parse(ii->to_json_string(&err, {}, 0));
-                if (ometadata.count("metadata"))
-                    metadata = JsonStore(ometadata.at("metadata"));
-
-                if (metadata.contains(fcp_locked_path) and
-                    metadata.at(fcp_locked_path).get<std::string>() == "TRUE")
-                    locked = true;
-
-                if (metadata.contains(fcp_enabled_path) and
-                    metadata.at(fcp_enabled_path).get<std::string>() == "FALSE")
-                    enabled = false;
-
-                if (metadata.contains(COLOUR_JPOINTER))
-                    flag = metadata.at(COLOUR_JPOINTER).get<std::string>();
-
-                if (metadata.contains(MEDIA_COLOUR_JPOINTER))
-                    media_flag = metadata.at(MEDIA_COLOUR_JPOINTER).get<std::string>();
-
-                if (metadata.contains(LOCKED_JPOINTER))
-                    locked = metadata.at(LOCKED_JPOINTER).get<bool>();
-
-                if (metadata.contains(ENABLED_JPOINTER))
-                    enabled = metadata.at(ENABLED_JPOINTER).get<bool>();
-
-                if (locked)
-                    self->mail(item_lock_atom_v, locked)
-                        .request(actor, infinite)
-                        .receive([=](const JsonStore &) {}, [=](const error &err) {});
-
-                if (not enabled)
-                    self->mail(plugin_manager::enable_atom_v, enabled)
-                        .request(actor, infinite)
-                        .receive([=](const JsonStore &) {}, [=](const error &err) {});
-
-                if (not flag.empty())
-                    self->mail(item_flag_atom_v, flag)
-                        .request(actor, infinite)
-                        .receive([=](const JsonStore &) {}, [=](const error &err) {});
-
-                if (not metadata.is_null())
-                    anon_mail(item_prop_atom_v, metadata, "").send(actor);
-
-                // set media colour
-                if (not media_flag.empty() and not active_path.empty() and
-                    media_lookup.count(active_path)) {
-                    self->mail(
-                            playlist::reflag_container_atom_v,
-                            std::tuple<std::optional<std::string>, std::optional<std::string>>(
-                                media_flag, {}))
-                        .request(media_lookup.at(active_path).actor(), infinite)
-                        .receive([=](const bool) {}, [=](const error &err) {});
-                }
-
-            } catch (const std::exception &err) {
-                spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
-            }
+                // the media range replaces this once the clip actor has the media details.
+                auto available = std::optional<otio::TimeRange>();
+                if (ii->media_reference())
+                    available = ii->media_reference()->available_range();
 
-            auto source_range = ii->source_range();
-            if (source_range) {
-                self->mail(
-                        active_range_atom_v,
+                if (available)
+                    clip.item().set_range(
                         FrameRange(
-                            FrameRateDuration(
-                                static_cast<int>(source_range->start_time().value()),
-                                FrameRate(fps_to_flicks(source_range->start_time().rate()))),
-                            FrameRateDuration(
-                                static_cast<int>(source_range->duration().value()),
-                                FrameRate(fps_to_flicks(source_range->duration().rate())))))
-                    .request(actor, infinite)
-                    .receive([=](const JsonStore &) {}, [=](const error &err) {});
+                            otio_duration(available->start_time()),
+                            otio_duration(available->duration())),
+                        active);
+                else
+                    clip.item().set_active_range(active);
             }
 
-            self->mail(insert_item_atom_v, -1, UuidActorVector({UuidActor(uuid, actor)}))
-                .request(parent, infinite)
-                .receive([=](const JsonStore &) {}, [=](const error &err) {});
+            if (not state.media_flag.empty() and media.actor())
+                otio_import.media_flags.emplace_back(media, state.media_flag);
 
+            parent.push_back(clip.item());
         } else if (auto ii = dynamic_cast<otio::Stack *>(&(*i))) {
-            // spdlog::warn("Stack");
             // timeline where marker live..
-            auto uuid = Uuid::generate();
-            // spdlog::warn("SPAWN stack {}", timeline_rate.to_fps());
-            auto actor = self->spawn<StackActor>(ii->name(), timeline_rate, uuid);
-
-            if (not ii->enabled())
-                self->mail(plugin_manager::enable_atom_v, false)
-                    .request(actor, infinite)
-                    .receive([=](const JsonStore &) {}, [=](const error &err) {});
-
-            auto markers = process_markers(ii->markers(), timeline_rate);
+            const auto state = otio_item_state(ii);
+            auto stack       = Stack(state.name, otio_import.rate);
+            apply_otio_state(stack.item(), state);
 
+            auto markers = process_markers(ii->markers(), otio_import.rate);
             if (not markers.empty())
-                anon_mail(item_marker_atom_v, insert_item_atom_v, markers).send(actor);
+                stack.item().set_markers(markers);
 
-            try {
-                auto locked   = false;
-                auto enabled  = ii->enabled();
-                auto metadata = JsonStore();
-                auto flag     = std::string();
-                otio::ErrorStatus err;
-                auto ometadata = nlohmann::json::parse(ii->to_json_string(&err, {}, 0));
-                if (ometadata.count("metadata"))
-                    metadata = JsonStore(ometadata.at("metadata"));
-
-                if (metadata.contains(fcp_locked_path) and
-                    metadata.at(fcp_locked_path).get<std::string>() == "TRUE")
-                    locked = true;
-
-                if (metadata.contains(fcp_enabled_path) and
-                    metadata.at(fcp_enabled_path).get<std::string>() == "FALSE")
-                    enabled = false;
-
-                if (metadata.contains(COLOUR_JPOINTER))
-                    flag = metadata.at(COLOUR_JPOINTER).get<std::string>();
-
-                if (metadata.contains(LOCKED_JPOINTER))
-                    locked = metadata.at(LOCKED_JPOINTER).get<bool>();
-
-                if (metadata.contains(ENABLED_JPOINTER))
-                    enabled = metadata.at(ENABLED_JPOINTER).get<bool>();
-
-                if (locked)
-                    self->mail(item_lock_atom_v, locked)
-                        .request(actor, infinite)
-                        .receive([=](const JsonStore &) {}, [=](const error &err) {});
-
-                if (not enabled)
-                    self->mail(plugin_manager::enable_atom_v, enabled)
-                        .request(actor, infinite)
-                        .receive([=](const JsonStore &) {}, [=](const error &err) {});
-
-                if (not flag.empty())
-                    self->mail(item_flag_atom_v, flag)
-                        .request(actor, infinite)
-                        .receive([=](const JsonStore &) {}, [=](const error &err) {});
-
-                anon_mail(item_prop_atom_v, metadata, "").send(actor);
-            } catch (const std::exception &err) {
-                spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
-            }
+            if (auto source_range = ii->source_range())
+                stack.item().set_active_range(
+                    FrameRange(otio_duration(source_range->duration())));
 
-            auto source_range = ii->source_range();
-
-            if (source_range)
-                self->mail(
-                        active_range_atom_v,
-                        FrameRange(FrameRateDuration(
-                            static_cast<int>(source_range->duration().value()),
-                            FrameRate(fps_to_flicks(source_range->duration().rate())))))
-                    .request(actor, infinite)
-                    .receive([=](const JsonStore &) {}, [=](const error &err) {});
-
-            self->mail(insert_item_atom_v, -1, UuidActorVector({UuidActor(uuid, actor)}))
-                .request(parent, infinite)
-                .receive([=](const JsonStore &) {}, [=](const error &err) {});
-
-            process_item(
-                ii->children(),
-                self,
-                timeline_actor,
-                parent,
-                path,
-                media_lookup,
-                timeline_rate);
+            build_items(otio_stack_tracks(ii), stack.item(), otio_import);
+
+            parent.push_back(stack.item());
         }
     }
 }
@@ -795,24 +655,21 @@ void timeline_importer(
         .request(dst.actor(), infinite)
         .receive([=](const JsonStore &) {}, [=](const error &err) {});
 
-    auto timeline_metadata = JsonStore(R"({})"_json);
-    try {
-        otio::ErrorStatus err;
-        auto metadata = nlohmann::json::parse(timeline->to_json_string(&err, {}, 0));
-        if (metadata.count("metadata"))
-            timeline_metadata = metadata.at("metadata");
-    } catch (const std::exception &err) {
-        spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
-    }
+    auto timeline_metadata = otio_metadata(timeline.value);
+    if (not timeline_metadata.is_object())
+        timeline_metadata = JsonStore(R"({})"_json);
     timeline_metadata["path"] = to_string(path);
 
     anon_mail(item_prop_atom_v, timeline_metadata).send(dst.actor());
 
     // this maps Media actors to the url for the active media ref. We use this
     // to check if a clip can re-use Media that we already have, or whether we
-    // need to create a new Media item.
-    std::map<std::string, UuidActor> existing_media_url_map;
-    std::map<std::string, UuidActor> target_url_map;
+    // need to create a new Media item. Both are keyed on media_lookup_key.
+    std::unordered_map<std::string, UuidActor> existing_media_url_map;
+    auto otio_import     = OTIOImport{path, timeline_rate};
+    auto &target_url_map = otio_import.media;
+    // media for the timeline, in clip order
+    UuidActorVector new_media;
 
     spdlog::info("Processing {} clips", clips.size());
     // fill our map with media that's already in the parent playlist
@@ -825,8 +682,8 @@ void timeline_importer(
                         .request(media.actor(), infinite)
                         .receive(
                             [&](const std::pair<Uuid, MediaReference> &ref) mutable {
-                                existing_media_url_map[uri_to_posix_path(ref.second.uri())] =
-                                    media;
+                                existing_media_url_map[media_lookup_key(
+                                    to_string(ref.second.uri()))] = media;
                             },
                             [=](error &err) {
                                 spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
@@ -840,58 +697,22 @@ void timeline_importer(
         count++;
         anon_mail(notification_atom_v, notify_uuid, count).send(dst.actor());
 
-        const auto &name = cl->name();
-        // spdlog::warn("{} {}", name, cl->active_media_reference_key());
-
-        const auto active_key = cl->active_media_reference_key();
-        auto active_path      = std::string();
-
-        if (auto active = otio::SerializableObject::Retainer<otio::ExternalReference>(
-                dynamic_cast<otio::ExternalReference *>(cl->media_reference()))) {
-            active_path = active->target_url();
-        } else if (
-            auto active = otio::SerializableObject::Retainer<otio::ImageSequenceReference>(
-                dynamic_cast<otio::ImageSequenceReference *>(cl->media_reference()))) {
-
-            active_path = active->target_url_base() + active->name_prefix() + "{:0" +
-                          std::to_string(active->frame_zero_padding()) + "d}" +
-                          active->name_suffix();
-        }
-
-        // active_path maybe relative..
-	const auto uri = caf::make_uri(active_path);
-        if (not uri) {
-            // not uri....
-            // assume relative ?
-            if (active_path[0] != '/') {
-                auto tmp       = uri_to_posix_path(path);
-                auto const pos = tmp.find_last_of('/');
-                active_path    = "file://" + tmp.substr(0, pos + 1) + active_path;
-            } else {
-                active_path = "file://" + active_path;
-            }
-        }
+        const auto &name       = cl->name();
+        const auto active_path = otio_clip_url(cl.value, path);
+        const auto key         = media_lookup_key(active_path);
+        const auto uri         = caf::make_uri(active_path);
 
         // WARNING this may inadvertantly skip auxiliary sources we want..
-        if (active_path.empty() or target_url_map.count(active_path)) {
-            // spdlog::warn("SKIP {}", active_path);
+        if (active_path.empty() or target_url_map.count(key)) {
             continue;
-        } else if (existing_media_url_map.count(active_path)) {
-            // spdlog::warn("SKIP EXISTING {}", active_path);
-            target_url_map[active_path] = existing_media_url_map[active_path];
+        } else if (auto it = existing_media_url_map.find(key);
+                   it != existing_media_url_map.end()) {
+            target_url_map[key] = it->second;
+            new_media.push_back(it->second);
             continue;
         }
 
-        auto clip_metadata = JsonStore();
-        try {
-            otio::ErrorStatus err;
-            auto clip_meta = nlohmann::json::parse(cl->to_json_string(&err, {}, 0));
-            if (clip_meta.count("metadata"))
-                clip_metadata = JsonStore(clip_meta.at("metadata"));
-
-        } catch (const std::exception &err) {
-            spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
-        }
+        auto clip_metadata = otio_metadata(cl.value);
 
 	if (uri and uri->scheme() != "file" and
 	    not uri->scheme().starts_with("http")) {
@@ -901,10 +722,11 @@ void timeline_importer(
 	    auto plugin_media_tmp = request_receive<UuidActorVector>(
 		*sys, pm, data_source::use_data_atom_v, *uri, timeline_rate, false);
 	    if (not plugin_media_tmp.empty()) {
-		target_url_map[active_path] = plugin_media_tmp[0];
+		target_url_map[key] = plugin_media_tmp[0];
+		new_media.push_back(plugin_media_tmp[0]);
 		if (not clip_metadata.is_null())
 		    anon_mail(json_store::set_json_atom_v, clip_metadata, "/metadata/timeline")
-			.send(target_url_map[active_path].actor());
+			.send(plugin_media_tmp[0].actor());
 		continue;
 	    }
 	}
@@ -940,16 +762,7 @@ void timeline_importer(
                         rate = FrameRate(fps_to_flicks(ar->start_time().rate()));
                     }
 
-                    auto source_metadata = JsonStore();
-                    try {
-                        otio::ErrorStatus err;
-                        auto ext_meta = nlohmann::json::parse(ext->to_json_string(&err, {}, 0));
-                        if (ext_meta.count("metadata")) {
-                            source_metadata = JsonStore(ext_meta.at("metadata"));
-                        }
-                    } catch (const std::exception &err) {
-                        spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
-                    }
+                    auto source_metadata = otio_metadata(ext.value);
 
                     auto source = self->spawn<media::MediaSourceActor>(
                         extname.empty() ? std::string("ExternalReference") : extname,
@@ -985,16 +798,7 @@ void timeline_importer(
                         rate = FrameRate(fps_to_flicks(ar->start_time().rate()));
                     }
 
-                    auto source_metadata = JsonStore();
-                    try {
-                        otio::ErrorStatus err;
-                        auto ext_meta = nlohmann::json::parse(ext->to_json_string(&err, {}, 0));
-                        if (ext_meta.count("metadata")) {
-                            source_metadata = JsonStore(ext_meta.at("metadata"));
-                        }
-                    } catch (const std::exception &err) {
-                        spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
-                    }
+                    auto source_metadata = otio_metadata(ext.value);
 
                     auto source = self->spawn<media::MediaSourceActor>(
                         extname.empty() ? std::string("ImageSequenceReference") : extname,
@@ -1019,39 +823,23 @@ void timeline_importer(
         if (not sources.empty()) {
             // create media
             // add to map.
-            auto uuid = Uuid::generate();
-            target_url_map[active_path] =
-                UuidActor(uuid, self->spawn<media::MediaActor>(name, uuid, sources));
+            auto uuid  = Uuid::generate();
+            auto media = UuidActor(uuid, self->spawn<media::MediaActor>(name, uuid, sources));
+            target_url_map[key] = media;
+            new_media.push_back(media);
 
             if (not clip_metadata.is_null())
                 anon_mail(json_store::set_json_atom_v, clip_metadata, "/metadata/timeline")
-                    .send(target_url_map[active_path].actor());
+                    .send(media.actor());
 
             anon_mail(media::current_media_source_atom_v, sources.front().uuid())
-                .send(target_url_map[active_path].actor());
+                .send(media.actor());
         }
-
-        otio::RationalTime dur = cl->duration();
-        // std::cout << "Name: " << cl->name() << " [";
-        // std::cout << dur.value() << "/" << dur.rate() << "]" << std::endl;
-        // trigger population of additional sources ? May conflict with timeline ?
     }
 
     // populate source
-    if (not target_url_map.empty()) {
-        // batch add..
-        UuidActorVector new_media;
-
-        for (const auto &i : target_url_map)
-            new_media.push_back(i.second);
-
-        // trigger additional sources.
-        UuidList media_uuids;
-        for (const auto &i : target_url_map) {
-            media_uuids.push_back(i.second.uuid());
-        }
-
-        // add to playlist/timeline
+    if (not new_media.empty()) {
+        // batch add to playlist/timeline
         self->mail(playlist::add_media_atom_v, new_media, Uuid())
             .request(dst.actor(), infinite)
             .receive([=](const UuidActor &) {}, [=](const error &err) {});
@@ -1074,15 +862,7 @@ void timeline_importer(
 
     // build timeline, for fun and profit..
     // purge any current timeline..
-    std::vector<otio::SerializableObject::Retainer<otio::Composable>> tracks;
-
-    auto vtracks = timeline->video_tracks();
-    for (auto it = vtracks.rbegin(); it != vtracks.rend(); ++it)
-        tracks.emplace_back(otio::SerializableObject::Retainer<otio::Composable>(*it));
-
-    auto atracks = timeline->audio_tracks();
-    for (auto &atrack : atracks)
-        tracks.emplace_back(otio::SerializableObject::Retainer<otio::Composable>(atrack));
+    const auto tracks = otio_stack_tracks(timeline->tracks());
 
     // get timeline stack..
     auto stack_actor = caf::actor();
@@ -1110,8 +890,76 @@ void timeline_importer(
         if (not markers.empty())
             anon_mail(item_marker_atom_v, insert_item_atom_v, markers).send(stack_actor);
 
-        process_item(
-            tracks, self, dst.actor(), stack_actor, path, target_url_map, timeline_rate);
+        // build the whole tree before any actors exist, instead of a round trip per
+        // property per item.
+        auto root = Item();
+        build_items(tracks, root, otio_import);
+
+        // track actors spawn their own children, so spawn the tracks a batch at a time
+        // across threads and hand them all to the stack in one insertion.
+        auto spawned     = UuidActorVector();
+        auto clip_actors = UuidActorVector();
+        auto &system     = self->system();
+        const auto batch = std::max(1u, std::thread::hardware_concurrency());
+        auto it          = root.begin();
+
+        while (it != root.end()) {
+            std::vector<std::future<std::pair<UuidActor, UuidActorVector>>> futures;
+
+            for (; it != root.end() and futures.size() < batch; ++it) {
+                it->refresh();
+                futures.emplace_back(std::async(std::launch::async, [&system, &item = *it]() {
+                    auto nitem = Item();
+                    auto actor = system.spawn<TrackActor>(item, nitem);
+                    return std::make_pair(
+                        UuidActor(item.uuid(), actor), nitem.find_all_uuid_actors(IT_CLIP));
+                }));
+            }
+
+            for (auto &f : futures) {
+                auto [track, track_clips] = f.get();
+                spawned.push_back(track);
+                clip_actors.insert(clip_actors.end(), track_clips.begin(), track_clips.end());
+            }
+        }
+
+        if (not spawned.empty())
+            self->mail(insert_item_atom_v, -1, spawned)
+                .request(stack_actor, infinite)
+                .receive(
+                    [=](const JsonStore &) {},
+                    [=](const error &err) {
+                        spdlog::warn("{} {}", __PRETTY_FUNCTION__, to_string(err));
+                    });
+
+        // clips were built without actors, hook them up to their media and let them
+        // fetch its details.
+        self->mail(link_media_atom_v, false)
+            .request(dst.actor(), infinite)
+            .receive([=](const bool) {}, [=](const error &err) {});
+
+        for (const auto &clip : clip_actors)
+            anon_mail(media::acquire_media_detail_atom_v).send(clip.actor());
+
+        // set media colour
+        for (const auto &[media, flag] : otio_import.media_flags)
+            anon_mail(
+                playlist::reflag_container_atom_v,
+                std::tuple<std::optional<std::string>, std::optional<std::string>>(flag, {}))
+                .send(media.actor());
+
+        if (not otio_import.conform_track_uuid.is_null()) {
+            self->mail(item_prop_atom_v)
+                .request(dst.actor(), infinite)
+                .receive(
+                    [&](JsonStore &prop) {
+                        prop["conform_track_uuid"] = otio_import.conform_track_uuid;
+                        self->mail(item_prop_atom_v, prop)
+                            .request(dst.actor(), infinite)
+                            .receive([=](const JsonStore &) {}, [=](const error &err) {});
+                    },
+                    [=](const error &err) {});
+        }
     }
 
     // enable history, we've finished.
@@ -3310,11 +3158,23 @@ void TimelineActor::bake(caf::typed_response_promise<UuidActor> rp, const UuidSe
     rp.deliver(UuidActor(track_uuid, track_actor));
 }
 
-void TimelineActor::export_otio_as_string(caf::typed_response_promise<std::string> rp) {
+// what the otio export needs from the media behind the clips, keyed on media uuid and the
+// media type of the track.
+struct OTIOMediaDetail {
+    std::string flag;
+    std::optional<MediaReference> reference;
+    std::string source_name;
+};
+
+using OTIOMediaDetails = std::map<std::pair<Uuid, media::MediaType>, OTIOMediaDetail>;
+
+// Streams the timeline item tree to otio json, everything needed from the media comes
+// from details, so no requests are made.
+std::string otio_timeline_string(const Item &timeline, const OTIOMediaDetails &details) {
 
     otio::ErrorStatus err;
     auto jany = std::any();
-    auto meta = base_.item().prop();
+    auto meta = timeline.prop();
 
     try {
         if (not meta.is_object())
@@ -3326,9 +3186,9 @@ void TimelineActor::export_otio_as_string(caf::typed_response_promise<std::strin
 
         auto xstudio_meta =
             R"({"xstudio": {"colour": "", "enabled": true, "locked": false}})"_json;
-        xstudio_meta[COLOUR_JPOINTER]  = base_.item().flag();
-        xstudio_meta[ENABLED_JPOINTER] = base_.item().enabled();
-        xstudio_meta[LOCKED_JPOINTER]  = base_.item().locked();
+        xstudio_meta[COLOUR_JPOINTER]  = timeline.flag();
+        xstudio_meta[ENABLED_JPOINTER] = timeline.enabled();
+        xstudio_meta[LOCKED_JPOINTER]  = timeline.locked();
         meta.update(xstudio_meta, true);
         deserialize_json_from_string(meta.dump(), &jany, &err);
         // if(is_error(err)) {
@@ -3336,9 +3196,9 @@ void TimelineActor::export_otio_as_string(caf::typed_response_promise<std::strin
         // }
 
         otio::SerializableObject::Retainer<otio::Timeline> otimeline(new otio::Timeline(
-            base_.item().name(),
+            timeline.name(),
             otio::RationalTime::from_frames(
-                base_.item().trimmed_frame_start().frames(), base_.item().rate().to_fps()),
+                timeline.trimmed_frame_start().frames(), timeline.rate().to_fps()),
             std::any_cast<otio::AnyDictionary>(jany)));
 
         auto to_marker = [=](const Marker &item) mutable {
@@ -3361,10 +3221,47 @@ void TimelineActor::export_otio_as_string(caf::typed_response_promise<std::strin
                 std::any_cast<otio::AnyDictionary>(jany)));
         };
 
-        auto to_composition = [=](const Item &item) mutable {
+        // tracks hold gaps, clips and nested stacks, which hold tracks of their own
+        std::function<otio::Composition *(const Item &)> to_composition;
+        to_composition = [=, &details, &to_composition](const Item &item) mutable {
             otio::Composition *result = nullptr;
 
-            if (item.item_type() == IT_VIDEO_TRACK or item.item_type() == IT_AUDIO_TRACK) {
+            if (item.item_type() == IT_STACK) {
+                if (meta = item.prop(); not meta.is_object())
+                    meta = R"({})"_json;
+
+                xstudio_meta =
+                    R"({"xstudio": {"colour": "", "enabled": true, "locked": false}})"_json;
+                xstudio_meta[COLOUR_JPOINTER]  = item.flag();
+                xstudio_meta[ENABLED_JPOINTER] = item.enabled();
+                xstudio_meta[LOCKED_JPOINTER]  = item.locked();
+                meta.update(xstudio_meta, true);
+                deserialize_json_from_string(meta.dump(), &jany, &err);
+
+                auto stack = new otio::Stack(
+                    item.name(),
+                    otio::TimeRange(
+                        otio::RationalTime::from_frames(
+                            item.trimmed_frame_start().frames(), item.rate().to_fps()),
+                        otio::RationalTime::from_frames(
+                            item.trimmed_frame_duration().frames(), item.rate().to_fps())),
+                    std::any_cast<otio::AnyDictionary>(jany));
+                stack->set_enabled(item.enabled());
+
+                for (const auto &marker : item.markers())
+                    stack->markers().push_back(to_marker(marker));
+
+                // same track order as the timeline stack, video tracks are bottom up in otio
+                for (const auto &track : item.children()) {
+                    if (track.item_type() == IT_VIDEO_TRACK)
+                        stack->insert_child(0, to_composition(track));
+                    else
+                        stack->append_child(to_composition(track));
+                }
+
+                result = stack;
+            } else if (
+                item.item_type() == IT_VIDEO_TRACK or item.item_type() == IT_AUDIO_TRACK) {
                 if (meta = item.prop(); not meta.is_object())
                     meta = R"({})"_json;
 
@@ -3425,20 +3322,15 @@ void TimelineActor::export_otio_as_string(caf::typed_response_promise<std::strin
                         xstudio_meta[ENABLED_JPOINTER] = citem.enabled();
                         xstudio_meta[LOCKED_JPOINTER]  = citem.locked();
 
-                        // need to get the media flag..
-                        try {
-                            if (citem.actor()) {
-                                caf::scoped_actor sys(system());
-                                auto flag = std::get<0>(
-                                    request_receive<std::tuple<std::string, std::string>>(
-                                        *sys,
-                                        citem.actor(),
-                                        playlist::reflag_container_atom_v));
-                                if (flag != "#00000000" and flag != "")
-                                    xstudio_meta[MEDIA_COLOUR_JPOINTER] = flag;
-                            }
-                        } catch (const std::exception &err) {
-                            spdlog::warn("{} {}", __PRETTY_FUNCTION__, err.what());
+                        const auto mt = item.item_type() == IT_VIDEO_TRACK ? media::MT_IMAGE
+                                                                           : media::MT_AUDIO;
+                        const auto detail = details.find(std::make_pair(
+                            citem.prop().value("media_uuid", Uuid()), mt));
+
+                        if (detail != details.end()) {
+                            const auto &flag = detail->second.flag;
+                            if (flag != "#00000000" and flag != "")
+                                xstudio_meta[MEDIA_COLOUR_JPOINTER] = flag;
                         }
 
                         meta.update(xstudio_meta, true);
@@ -3459,43 +3351,9 @@ void TimelineActor::export_otio_as_string(caf::typed_response_promise<std::strin
                         clip->set_enabled(citem.enabled());
 
                         try {
-                            if (citem.actor()) {
-                                caf::scoped_actor sys(system());
-
-                                auto mr = MediaReference();
-                                auto mt = item.item_type() == IT_VIDEO_TRACK ? media::MT_IMAGE
-                                                                             : media::MT_AUDIO;
-
-                                try {
-                                    mr = request_receive<std::pair<Uuid, MediaReference>>(
-                                             *sys,
-                                             citem.actor(),
-                                             media::media_reference_atom_v,
-                                             mt)
-                                             .second;
-                                } catch (...) {
-                                    // fallback..
-                                    if (mt == media::MT_AUDIO) {
-                                        mt = media::MT_IMAGE;
-                                        mr = request_receive<std::pair<Uuid, MediaReference>>(
-                                                 *sys,
-                                                 citem.actor(),
-                                                 media::media_reference_atom_v,
-                                                 mt)
-                                                 .second;
-                                    } else {
-                                        throw;
-                                    }
-                                }
-
-                                auto msua = request_receive<UuidActor>(
-                                    *sys,
-                                    citem.actor(),
-                                    media::current_media_source_atom_v,
-                                    mt);
-
-                                auto name = request_receive<std::string>(
-                                    *sys, msua.actor(), name_atom_v);
+                            if (detail != details.end() and detail->second.reference) {
+                                const auto &mr   = *(detail->second.reference);
+                                const auto &name = detail->second.source_name;
 
                                 if (mr.container()) {
 
@@ -3580,6 +3438,8 @@ void TimelineActor::export_otio_as_string(caf::typed_response_promise<std::strin
                         }
 
                         result->append_child(clip);
+                    } else if (citem.item_type() == IT_STACK) {
+                        result->append_child(to_composition(citem));
                     }
                 }
             }
@@ -3590,7 +3450,7 @@ void TimelineActor::export_otio_as_string(caf::typed_response_promise<std::strin
         // add tracks.. / etc..
         auto ostack = otimeline->tracks();
 
-        auto stack = base_.item().front();
+        const auto &stack = timeline.front();
         for (const auto &marker : stack.markers()) {
             ostack->markers().push_back(to_marker(marker));
         }
@@ -3608,13 +3468,13 @@ void TimelineActor::export_otio_as_string(caf::typed_response_promise<std::strin
         // }
 
 
-        if (meta = base_.item().front().prop(); not meta.is_object())
+        if (meta = stack.prop(); not meta.is_object())
             meta = R"({})"_json;
 
         xstudio_meta = R"({"xstudio": {"colour": "", "enabled": true, "locked": false}})"_json;
-        xstudio_meta[COLOUR_JPOINTER]  = base_.item().front().flag();
-        xstudio_meta[ENABLED_JPOINTER] = base_.item().front().enabled();
-        xstudio_meta[LOCKED_JPOINTER]  = base_.item().front().locked();
+        xstudio_meta[COLOUR_JPOINTER]  = stack.flag();
+        xstudio_meta[ENABLED_JPOINTER] = stack.enabled();
+        xstudio_meta[LOCKED_JPOINTER]  = stack.locked();
         meta.update(xstudio_meta, true);
         deserialize_json_from_string(meta.dump(), &jany, &err);
         ostack->metadata() = std::any_cast<otio::AnyDictionary>(jany);
@@ -3628,20 +3488,121 @@ void TimelineActor::export_otio_as_string(caf::typed_response_promise<std::strin
 
         const auto result = otimeline->to_json_string(&err, nullptr, 0);
 
-        if (not otio::is_error(err))
-            rp.deliver(result);
-        else
-            rp.deliver(make_error(xstudio_error::error, "Export failed"));
-
         // and crash..
         otimeline->possibly_delete();
+
+        if (otio::is_error(err))
+            throw std::runtime_error("Export failed");
+
+        return result;
     } catch (const std::exception &err) {
         spdlog::warn(
             "{} {} {} {}", __PRETTY_FUNCTION__, err.what(), meta.dump(2), jany.type().name());
-        rp.deliver(make_error(xstudio_error::error, err.what()));
+        throw;
     }
 }
 
+// add an entry for the media of every clip in the stack's tracks, nested stacks included.
+void otio_clip_media(const Item &stack, OTIOMediaDetails &details) {
+    for (const auto &track : stack.children()) {
+        if (track.item_type() != IT_VIDEO_TRACK and track.item_type() != IT_AUDIO_TRACK)
+            continue;
+
+        const auto mt =
+            track.item_type() == IT_VIDEO_TRACK ? media::MT_IMAGE : media::MT_AUDIO;
+
+        for (const auto &citem : track.children()) {
+            if (citem.item_type() == IT_CLIP)
+                details[std::make_pair(citem.prop().value("media_uuid", Uuid()), mt)];
+            else if (citem.item_type() == IT_STACK)
+                otio_clip_media(citem, details);
+        }
+    }
+}
+
+void TimelineActor::export_otio_as_string(caf::typed_response_promise<std::string> rp) {
+    // collect what the export needs from each media up front, with all the requests in
+    // flight at once, the same media is often used by many clips.
+    auto details = std::make_shared<OTIOMediaDetails>();
+
+    otio_clip_media(base_.item().front(), *details);
+    for (auto i = details->begin(); i != details->end();) {
+        if (media_actors_.count(i->first.first))
+            ++i;
+        else
+            i = details->erase(i);
+    }
+
+    auto deliver = [=]() mutable {
+        try {
+            rp.deliver(otio_timeline_string(base_.item(), *details));
+        } catch (const std::exception &err) {
+            rp.deliver(make_error(xstudio_error::error, err.what()));
+        }
+    };
+
+    if (details->empty())
+        return deliver();
+
+    // a flag request and a reference chain per media
+    auto pending = std::make_shared<size_t>(details->size() * 2);
+    auto done    = [=]() mutable {
+        if (--(*pending) == 0)
+            deliver();
+    };
+
+    for (const auto &i : *details) {
+        const auto key   = i.first;
+        const auto media = media_actors_.at(key.first);
+
+        mail(playlist::reflag_container_atom_v)
+            .request(media, infinite)
+            .then(
+                [=](const std::tuple<std::string, std::string> &flag) mutable {
+                    (*details)[key].flag = std::get<0>(flag);
+                    done();
+                },
+                [=](const caf::error &) mutable { done(); });
+
+        auto source_detail = [=](const media::MediaType mt, const MediaReference &ref) mutable {
+            mail(media::current_media_source_atom_v, mt)
+                .request(media, infinite)
+                .then(
+                    [=](const UuidActor &source) mutable {
+                        mail(name_atom_v)
+                            .request(source.actor(), infinite)
+                            .then(
+                                [=](const std::string &name) mutable {
+                                    (*details)[key].reference   = ref;
+                                    (*details)[key].source_name = name;
+                                    done();
+                                },
+                                [=](const caf::error &) mutable { done(); });
+                    },
+                    [=](const caf::error &) mutable { done(); });
+        };
+
+        mail(media::media_reference_atom_v, key.second, Uuid())
+            .request(media, infinite)
+            .then(
+                [=](const std::pair<Uuid, MediaReference> &ref) mutable {
+                    source_detail(key.second, ref.second);
+                },
+                [=](const caf::error &) mutable {
+                    // fallback..
+                    if (key.second != media::MT_AUDIO)
+                        return done();
+
+                    mail(media::media_reference_atom_v, media::MT_IMAGE, Uuid())
+                        .request(media, infinite)
+                        .then(
+                            [=](const std::pair<Uuid, MediaReference> &ref) mutable {
+                                source_detail(media::MT_IMAGE, ref.second);
+                            },
+                            [=](const caf::error &) mutable { done(); });
+                });
+    }
+}
 
 void TimelineActor::export_otio(
     caf::typed_response_promise<bool> rp,
@@ -541,6 +541,156 @@ TEST(TimelineActorChildTest, Test) {
     f.self->send_exit(t2, caf::exit_reason::user_shutdown);
 }
 
+namespace {
+
+nlohmann::json otio_range(const int start, const int duration) {
+    auto time = [](const int value) {
+        return nlohmann::json(
+            {{"OTIO_SCHEMA", "RationalTime.1"}, {"rate", 24.0}, {"value", double(value)}});
+    };
+    return nlohmann::json(
+        {{"OTIO_SCHEMA", "TimeRange.1"},
+         {"start_time", time(start)},
+         {"duration", time(duration)}});
+}
+
+nlohmann::json otio_item(
+    const std::string &schema,
+    const std::string &name,
+    const nlohmann::json &source_range = nullptr) {
+    return nlohmann::json(
+        {{"OTIO_SCHEMA", schema},
+         {"name", name},
+         {"source_range", source_range},
+         {"effects", nlohmann::json::array()},
+         {"markers", nlohmann::json::array()},
+         {"metadata", nlohmann::json::object()}});
+}
+
+nlohmann::json otio_gap(const int duration) {
+    return otio_item("Gap.1", "", otio_range(0, duration));
+}
+
+nlohmann::json otio_clip(const std::string &name, const int start, const int duration) {
+    auto result               = otio_item("Clip.1", name, otio_range(start, duration));
+    result["media_reference"] = nullptr;
+    return result;
+}
+
+nlohmann::json otio_track(const std::string &name, const nlohmann::json &children) {
+    auto result        = otio_item("Track.1", name);
+    result["kind"]     = "Video";
+    result["children"] = children;
+    return result;
+}
+
+nlohmann::json otio_stack(const std::string &name, const nlohmann::json &tracks) {
+    auto result        = otio_item("Stack.1", name);
+    result["children"] = tracks;
+    return result;
+}
+
+// the import replies once the stack has its tracks, the timeline hears about them after
+Item imported_stack(fixture &f, const caf::actor &timeline, const size_t tracks) {
+    auto item = request_receive<Item>(*(f.self), timeline, item_atom_v);
+    for (auto i = 0; i < 50 and item.front().size() != tracks; ++i) {
+        std::this_thread::sleep_for(100ms);
+        item = request_receive<Item>(*(f.self), timeline, item_atom_v);
+    }
+    return item.front();
+}
+
+void expect_same_items(const Item &a, const Item &b) {
+    ASSERT_EQ(a.size(), b.size()) << a.name();
+
+    auto ib = b.cbegin();
+    for (auto ia = a.cbegin(); ia != a.cend(); ++ia, ++ib) {
+        EXPECT_EQ(ia->item_type(), ib->item_type()) << ia->name();
+        EXPECT_EQ(ia->name(), ib->name());
+        EXPECT_EQ(ia->trimmed_frame_start().frames(), ib->trimmed_frame_start().frames())
+            << ia->name();
+        EXPECT_EQ(ia->trimmed_frame_duration().frames(), ib->trimmed_frame_duration().frames())
+            << ia->name();
+        expect_same_items(*ia, *ib);
+    }
+}
+
+} // namespace
+
+TEST(TimelineActorOTIOTest, RoundTrip) {
+    fixture f;
+
+    // otio lists video tracks bottom up, V1 is below V2
+    const auto nested = otio_stack(
+        "Nested",
+        nlohmann::json::array(
+            {otio_track("N1", nlohmann::json::array({otio_clip("n1", 0, 8)})),
+             otio_track("N2", nlohmann::json::array({otio_gap(2), otio_clip("n2", 4, 7)}))}));
+
+    const auto v1 = otio_track(
+        "V1",
+        nlohmann::json::array(
+            {otio_gap(5), otio_clip("c1", 10, 20), nested, otio_clip("c2", 30, 12)}));
+    const auto v2 = otio_track("V2", nlohmann::json::array({otio_clip("top", 0, 24)}));
+
+    auto document                 = otio_item("Timeline.1", "RoundTrip");
+    document["global_start_time"] = otio_range(0, 0)["start_time"];
+    document["tracks"]            = otio_stack("Tracks", nlohmann::json::array({v1, v2}));
+    document.erase("source_range");
+    document.erase("effects");
+    document.erase("markers");
+
+    const auto path = posix_path_to_uri("/tmp/round_trip.otio");
+    auto pl         = f.self->spawn<PlaylistActor>("Test");
+
+    auto t1 = f.self->spawn<TimelineActor>("Timeline", FrameRate(), Uuid::generate(), pl);
+    EXPECT_TRUE(request_receive<bool>(
+        *(f.self), t1, session::import_atom_v, path, std::string(document.dump())));
+
+    const auto stack1 = imported_stack(f, t1, 2);
+
+    // our tracks are top down
+    ASSERT_EQ(stack1.size(), 2u);
+    const auto &track_v2 = stack1.front();
+    const auto &track_v1 = stack1.back();
+    EXPECT_EQ(track_v2.name(), "V2");
+    EXPECT_EQ(track_v1.name(), "V1");
+
+    ASSERT_EQ(track_v1.size(), 4u);
+    auto it = track_v1.cbegin();
+    EXPECT_EQ(it->item_type(), IT_GAP);
+    EXPECT_EQ(it->trimmed_frame_duration().frames(), 5);
+    ++it;
+    EXPECT_EQ(it->item_type(), IT_CLIP);
+    EXPECT_EQ(it->name(), "c1");
+    EXPECT_EQ(it->trimmed_frame_start().frames(), 10);
+    EXPECT_EQ(it->trimmed_frame_duration().frames(), 20);
+    ++it;
+    EXPECT_EQ(it->item_type(), IT_STACK);
+    EXPECT_EQ(it->name(), "Nested");
+    EXPECT_EQ(it->trimmed_frame_duration().frames(), 9);
+    ASSERT_EQ(it->size(), 2u);
+    EXPECT_EQ(it->front().name(), "N2");
+    EXPECT_EQ(it->back().name(), "N1");
+    ++it;
+    EXPECT_EQ(it->item_type(), IT_CLIP);
+    EXPECT_EQ(it->name(), "c2");
+    EXPECT_EQ(it->trimmed_frame_start().frames(), 30);
+    EXPECT_EQ(it->trimmed_frame_duration().frames(), 12);
+
+    // export and import again, nothing should move
+    const auto exported = request_receive<std::string>(*(f.self), t1, session::export_atom_v);
+
+    auto t2 = f.self->spawn<TimelineActor>("Timeline", FrameRate(), Uuid::generate(), pl);
+    EXPECT_TRUE(request_receive<bool>(*(f.self), t2, session::import_atom_v, path, exported));
+
+    expect_same_items(stack1, imported_stack(f, t2, 2));
+
+    f.self->send_exit(t1, caf::exit_reason::user_shutdown);
+    f.self->send_exit(t2, caf::exit_reason::user_shutdown);
+    f.self->send_exit(pl, caf::exit_reason::user_shutdown);
+}
+
 
 // fixture f;
 // auto gsa = f.self->spawn<GlobalActor>();
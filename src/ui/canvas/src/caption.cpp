@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "xstudio/ui/canvas/caption.hpp"
+#include "xstudio/ui/canvas/tessellation_cache.hpp"
 
 using namespace xstudio::ui::canvas;
 using namespace xstudio;
@@ -80,13 +81,13 @@ void Caption::modify_text(const std::string &t, std::string::const_iterator &cur
 Imath::Box2f Caption::bounding_box() const {
 
     update_vertices();
-    return bounding_box_;
+    return geometry_->bounding_box;
 }
 
-std::vector<float> Caption::vertices() const {
+const std::vector<float> &Caption::vertices() const {
 
     update_vertices();
-    return vertices_;
+    return geometry_->vertices;
 }
 
 std::string Caption::hash() const {
@@ -105,11 +106,11 @@ std::string Caption::hash() const {
 void Caption::update_vertices() const {
     const std::string curr_hash = hash();
 
-    if (curr_hash != hash_) {
-        bounding_box_ =
-            SDFBitmapFont::font_by_name(font_name)->precompute_text_rendering_vertex_layout(
-                vertices_, text, position, wrap_width, font_size, justification, 1.0f);
-        hash_ = curr_hash;
+    if (curr_hash != hash_ || !geometry_) {
+        // captions are rebuilt from JSON whenever annotations are reloaded,
+        // the cache means we only lay out the text once for all the copies
+        geometry_ = TessellationCache::instance().caption_geometry(*this);
+        hash_     = curr_hash;
     }
 }
 
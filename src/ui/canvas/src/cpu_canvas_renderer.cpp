@@ -0,0 +1,269 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+
+#include "xstudio/ui/canvas/cpu_canvas_renderer.hpp"
+
+using namespace xstudio::ui::canvas;
+using namespace xstudio;
+
+namespace {
+
+inline float smoothstep(const float edge0, const float edge1, const float x) {
+    const float t = std::clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+inline float dist_to_segment(const Imath::V2f &pt, const Imath::V2f &a, const Imath::V2f &b) {
+    const Imath::V2f L = b - a;
+    const float l2     = L.length2();
+    if (l2 == 0.0f)
+        return (pt - a).length();
+    const float t = std::clamp((pt - a).dot(L) / l2, 0.0f, 1.0f);
+    return (pt - (a + L * t)).length();
+}
+
+// Maps between window pixels (bottom scanline first) and the image
+// coordinate space that stroke points are expressed in. The mapping is
+// affine so we step through pixels with constant increments.
+struct PixelMapping {
+
+    PixelMapping(
+        const Imath::V2i &window_size,
+        const Imath::M44f &transform_window_to_viewport_space,
+        const Imath::M44f &transform_viewport_to_image_space)
+        : size_(window_size) {
+
+        image_to_ndc_ =
+            transform_viewport_to_image_space.inverse() * transform_window_to_viewport_space;
+        const Imath::M44f ndc_to_image = image_to_ndc_.inverse();
+
+        auto to_image = [&](const float x, const float y) {
+            Imath::V3f p(
+                (x + 0.5f) * 2.0f / float(size_.x) - 1.0f,
+                (y + 0.5f) * 2.0f / float(size_.y) - 1.0f,
+                0.0f);
+            Imath::V3f r;
+            ndc_to_image.multVecMatrix(p, r);
+            return Imath::V2f(r.x, r.y);
+        };
+        origin_ = to_image(0.0f, 0.0f);
+        dx_     = to_image(1.0f, 0.0f) - origin_;
+        dy_     = to_image(0.0f, 1.0f) - origin_;
+    }
+
+    [[nodiscard]] Imath::V2f image_coord(const int x, const int y) const {
+        return origin_ + dx_ * float(x) + dy_ * float(y);
+    }
+
+    // window pixel area covered by the given image space box, clamped to the window
+    [[nodiscard]] Imath::Box2i window_box(const Imath::Box2f &image_box) const {
+        Imath::Box2f b;
+        for (const auto &c :
+             {image_box.min,
+              image_box.max,
+              Imath::V2f(image_box.min.x, image_box.max.y),
+              Imath::V2f(image_box.max.x, image_box.min.y)}) {
+            Imath::V3f r;
+            image_to_ndc_.multVecMatrix(Imath::V3f(c.x, c.y, 0.0f), r);
+            b.extendBy(Imath::V2f(
+                (r.x + 1.0f) * 0.5f * float(size_.x), (r.y + 1.0f) * 0.5f * float(size_.y)));
+        }
+        // N.B. Box2i max is exclusive here
+        return Imath::Box2i(
+            Imath::V2i(
+                std::max(0, int(std::floor(b.min.x)) - 1),
+                std::max(0, int(std::floor(b.min.y)) - 1)),
+            Imath::V2i(
+                std::min(size_.x, int(std::ceil(b.max.x)) + 1),
+                std::min(size_.y, int(std::ceil(b.max.y)) + 1)));
+    }
+
+    Imath::V2i size_;
+    Imath::M44f image_to_ndc_;
+    Imath::V2f origin_, dx_, dy_;
+};
+
+Imath::Box2f stroke_bounds(const Stroke &stroke, const float radius) {
+    Imath::Box2f b;
+    for (const auto &pt : stroke.points) {
+        b.extendBy(pt);
+    }
+    b.min -= Imath::V2f(radius, radius);
+    b.max += Imath::V2f(radius, radius);
+    return b;
+}
+
+} // anonymous namespace
+
+void CPUCanvasRenderer::render_canvas(
+    const Canvas &canvas,
+    float *rgba,
+    const Imath::V2i &window_size,
+    const Imath::M44f &transform_window_to_viewport_space,
+    const Imath::M44f &transform_viewport_to_image_space,
+    const float viewport_du_dpixel,
+    const float opacity) const {
+
+    std::vector<Stroke> strokes;
+    canvas.read_lock();
+    for (const auto &item : canvas) {
+        if (std::holds_alternative<Stroke>(item)) {
+            strokes.push_back(std::get<Stroke>(item));
+        }
+    }
+    canvas.read_unlock();
+
+    render_strokes(
+        strokes,
+        rgba,
+        window_size,
+        transform_window_to_viewport_space,
+        transform_viewport_to_image_space,
+        viewport_du_dpixel,
+        opacity);
+}
+
+void CPUCanvasRenderer::render_strokes(
+    const std::vector<Stroke> &strokes,
+    float *rgba,
+    const Imath::V2i &window_size,
+    const Imath::M44f &transform_window_to_viewport_space,
+    const Imath::M44f &transform_viewport_to_image_space,
+    const float viewport_du_dpixel,
+    const float opacity) const {
+
+    if (strokes.empty() || window_size.x <= 0 || window_size.y <= 0)
+        return;
+
+    const PixelMapping mapping(
+        window_size, transform_window_to_viewport_space, transform_viewport_to_image_space);
+
+    auto soft_edge = [=](const Stroke &s) {
+        if (s.type == StrokeType_Erase)
+            return 0.0f;
+        return viewport_du_dpixel * 4.0f + s.softness * s.thickness;
+    };
+
+    // The strokes are plotted into a premultiplied RGBA layer that covers
+    // only the window area touched by the canvas, which is then composited
+    // over the image.
+    Imath::Box2i layer_box;
+    for (const auto &stroke : strokes) {
+        if (stroke.points.empty())
+            continue;
+        const Imath::Box2i b = mapping.window_box(
+            stroke_bounds(stroke, stroke.thickness + soft_edge(stroke)));
+        if (b.min.x < b.max.x && b.min.y < b.max.y) {
+            layer_box.extendBy(b.min);
+            layer_box.extendBy(b.max);
+        }
+    }
+    if (layer_box.isEmpty())
+        return;
+
+    const int lw = layer_box.max.x - layer_box.min.x;
+    const int lh = layer_box.max.y - layer_box.min.y;
+    std::vector<float> layer(size_t(lw) * lh * 4, 0.0f);
+    std::vector<float> coverage(size_t(lw) * lh, 0.0f);
+
+    for (const auto &stroke : strokes) {
+
+        if (stroke.points.empty())
+            continue;
+
+        const float thickness = stroke.thickness;
+        const float soft      = soft_edge(stroke);
+        const float radius    = thickness + soft;
+
+        Imath::Box2i sbox = mapping.window_box(stroke_bounds(stroke, radius));
+        sbox.min.x        = std::max(sbox.min.x, layer_box.min.x);
+        sbox.min.y        = std::max(sbox.min.y, layer_box.min.y);
+        sbox.max.x        = std::min(sbox.max.x, layer_box.max.x);
+        sbox.max.y        = std::min(sbox.max.y, layer_box.max.y);
+        if (sbox.min.x >= sbox.max.x || sbox.min.y >= sbox.max.y)
+            continue;
+
+        for (int y = sbox.min.y; y < sbox.max.y; ++y) {
+            float *c = coverage.data() + size_t(y - layer_box.min.y) * lw +
+                       (sbox.min.x - layer_box.min.x);
+            std::fill(c, c + (sbox.max.x - sbox.min.x), 0.0f);
+        }
+
+        // a stroke is the union of round capped segments. Taking the max
+        // coverage stops self-overlapping segments from accumulating, like
+        // the depth test does in the GPU renderer
+        const size_t n_segs = std::max(size_t(1), stroke.points.size() - 1);
+        for (size_t i = 0; i < n_segs; ++i) {
+
+            const Imath::V2f &a = stroke.points[i];
+            const Imath::V2f &b = stroke.points[std::min(i + 1, stroke.points.size() - 1)];
+
+            Imath::Box2f seg_bounds(a);
+            seg_bounds.extendBy(b);
+            seg_bounds.min -= Imath::V2f(radius, radius);
+            seg_bounds.max += Imath::V2f(radius, radius);
+
+            const Imath::Box2i wb = mapping.window_box(seg_bounds);
+            const int x0          = std::max(wb.min.x, sbox.min.x);
+            const int x1          = std::min(wb.max.x, sbox.max.x);
+            const int y0          = std::max(wb.min.y, sbox.min.y);
+            const int y1          = std::min(wb.max.y, sbox.max.y);
+
+            for (int y = y0; y < y1; ++y) {
+                float *c = coverage.data() + size_t(y - layer_box.min.y) * lw;
+                Imath::V2f p = mapping.image_coord(x0, y);
+                for (int x = x0; x < x1; ++x, p += mapping.dx_) {
+                    const float d = dist_to_segment(p, a, b);
+                    if (d >= radius)
+                        continue;
+                    const float v = soft > 0.0f ? smoothstep(radius, thickness, d) : 1.0f;
+                    float &cv     = c[x - layer_box.min.x];
+                    cv            = std::max(cv, v);
+                }
+            }
+        }
+
+        for (int y = sbox.min.y; y < sbox.max.y; ++y) {
+            const size_t row = size_t(y - layer_box.min.y) * lw;
+            for (int x = sbox.min.x - layer_box.min.x; x < sbox.max.x - layer_box.min.x; ++x) {
+                const float cv = coverage[row + x];
+                if (cv == 0.0f)
+                    continue;
+                float *l = layer.data() + (row + x) * 4;
+                if (stroke.type == StrokeType_Erase) {
+                    const float k = 1.0f - cv;
+                    l[0] *= k;
+                    l[1] *= k;
+                    l[2] *= k;
+                    l[3] *= k;
+                } else {
+                    const float a = stroke.opacity * cv;
+                    const float k = 1.0f - a;
+                    l[0]          = stroke.colour.r * a + l[0] * k;
+                    l[1]          = stroke.colour.g * a + l[1] * k;
+                    l[2]          = stroke.colour.b * a + l[2] * k;
+                    l[3]          = a + l[3] * k;
+                }
+            }
+        }
+    }
+
+    // composite the layer 'over' the target
+    for (int y = 0; y < lh; ++y) {
+        const float *l = layer.data() + size_t(y) * lw * 4;
+        float *dst =
+            rgba + (size_t(y + layer_box.min.y) * window_size.x + layer_box.min.x) * 4;
+        for (int x = 0; x < lw * 4; x += 4) {
+            const float a = l[x + 3] * opacity;
+            if (a == 0.0f)
+                continue;
+            const float k = 1.0f - a;
+            dst[x]        = l[x] * opacity + dst[x] * k;
+            dst[x + 1]    = l[x + 1] * opacity + dst[x + 1] * k;
+            dst[x + 2]    = l[x + 2] * opacity + dst[x + 2] * k;
+            dst[x + 3]    = a + dst[x + 3] * k;
+        }
+    }
+}
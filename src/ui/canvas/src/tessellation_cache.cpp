@@ -0,0 +1,260 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <string_view>
+#include <thread>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "xstudio/ui/canvas/tessellation_cache.hpp"
+
+using namespace xstudio::ui::canvas;
+using namespace xstudio;
+
+namespace {
+
+// strokes with more segments than this have their vertices generated
+// by several threads
+constexpr size_t parallel_segment_threshold = 16384;
+
+// distinguishes stroke and caption keys in the shared index
+constexpr size_t caption_key_salt = 0x9e3779b97f4a7c15ull;
+
+// Each segment is drawn as two triangles, and each of the 6 vertices
+// carries the start and end point of the segment, i.e. x0,y0,x1,y1.
+void write_segments(
+    const Imath::V2f *points, const size_t first, const size_t last, Imath::V2f *out) {
+
+    out += first * 12;
+
+#if defined(__SSE2__)
+    // points i and i+1 are adjacent in memory, so one load gives us the
+    // x0,y0,x1,y1 block that is repeated for every vertex of the segment
+    const float *src = &points[first].x;
+    float *dst       = &out->x;
+    for (size_t i = first; i < last; ++i, src += 2, dst += 24) {
+        const __m128 seg = _mm_loadu_ps(src);
+        _mm_storeu_ps(dst, seg);
+        _mm_storeu_ps(dst + 4, seg);
+        _mm_storeu_ps(dst + 8, seg);
+        _mm_storeu_ps(dst + 12, seg);
+        _mm_storeu_ps(dst + 16, seg);
+        _mm_storeu_ps(dst + 20, seg);
+    }
+#else
+    for (size_t i = first; i < last; ++i) {
+        for (int v = 0; v < 6; ++v) {
+            *(out++) = points[i];
+            *(out++) = points[i + 1];
+        }
+    }
+#endif
+}
+
+size_t hash_bytes(const void *data, const size_t n, const size_t seed = 0) {
+    const size_t h =
+        std::hash<std::string_view>{}(std::string_view(static_cast<const char *>(data), n));
+    return seed ^ (h + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+} // anonymous namespace
+
+TessellationCache &TessellationCache::instance() {
+    static TessellationCache cache;
+    return cache;
+}
+
+size_t TessellationCache::content_hash(const Stroke &stroke) {
+    // stroke geometry only depends on the points, so strokes that differ in
+    // colour, thickness etc. share their vertices
+    return hash_bytes(stroke.points.data(), stroke.points.size() * sizeof(Imath::V2f));
+}
+
+size_t TessellationCache::content_hash(const Caption &caption) {
+    const std::string h = caption.hash();
+    return hash_bytes(
+               caption.font_name.data(),
+               caption.font_name.size(),
+               hash_bytes(h.data(), h.size())) ^
+           caption_key_salt;
+}
+
+std::vector<Imath::V2f> TessellationCache::make_stroke_vertices(const Stroke &stroke) {
+
+    std::vector<Imath::V2f> result;
+    if (stroke.points.empty())
+        return result;
+
+    if (stroke.points.size() == 1) {
+        // single point, one segment of zero length
+        result.assign(12, stroke.points.front());
+        return result;
+    }
+
+    const size_t n_segments = stroke.points.size() - 1;
+    result.resize(n_segments * 12);
+
+    const unsigned int n_threads = std::max(1u, std::thread::hardware_concurrency());
+    if (n_segments < parallel_segment_threshold || n_threads == 1) {
+        write_segments(stroke.points.data(), 0, n_segments, result.data());
+        return result;
+    }
+
+    const size_t chunk = (n_segments + n_threads - 1) / n_threads;
+    std::vector<std::thread> threads;
+    for (size_t first = chunk; first < n_segments; first += chunk) {
+        threads.emplace_back(
+            write_segments,
+            stroke.points.data(),
+            first,
+            std::min(first + chunk, n_segments),
+            result.data());
+    }
+    write_segments(stroke.points.data(), 0, std::min(chunk, n_segments), result.data());
+    for (auto &t : threads)
+        t.join();
+
+    return result;
+}
+
+CaptionGeometry TessellationCache::make_caption_geometry(const Caption &caption) {
+
+    CaptionGeometry result;
+    result.bounding_box =
+        SDFBitmapFont::font_by_name(caption.font_name)
+            ->precompute_text_rendering_vertex_layout(
+                result.vertices,
+                caption.text,
+                caption.position,
+                caption.wrap_width,
+                caption.font_size,
+                caption.justification,
+                1.0f);
+    return result;
+}
+
+StrokeVerticesPtr TessellationCache::stroke_vertices(const Stroke &stroke) {
+
+    const size_t key = content_hash(stroke);
+    const size_t n_vertices =
+        stroke.points.empty() ? 0 : std::max(size_t(1), stroke.points.size() - 1) * 12;
+
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        const Entry *e = lookup(key);
+        // size check guards against the (unlikely) hash collision
+        if (e && e->stroke && e->stroke->size() == n_vertices)
+            return e->stroke;
+    }
+
+    // generate outside the lock, it can take a while for long strokes
+    auto vertices =
+        std::make_shared<const std::vector<Imath::V2f>>(make_stroke_vertices(stroke));
+
+    std::lock_guard<std::mutex> l(mutex_);
+    insert(Entry{key, vertices->size() * sizeof(Imath::V2f), vertices, CaptionGeometryPtr()});
+    return vertices;
+}
+
+CaptionGeometryPtr TessellationCache::caption_geometry(const Caption &caption) {
+
+    const size_t key = content_hash(caption);
+
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        const Entry *e = lookup(key);
+        if (e && e->caption)
+            return e->caption;
+    }
+
+    auto geom = std::make_shared<const CaptionGeometry>(make_caption_geometry(caption));
+
+    std::lock_guard<std::mutex> l(mutex_);
+    insert(Entry{
+        key,
+        geom->vertices.size() * sizeof(float) + sizeof(CaptionGeometry),
+        StrokeVerticesPtr(),
+        geom});
+    return geom;
+}
+
+const TessellationCache::Entry *TessellationCache::lookup(const size_t key) {
+
+    auto p = index_.find(key);
+    if (p == index_.end()) {
+        misses_++;
+        return nullptr;
+    }
+    hits_++;
+    // move to the front of the LRU list
+    lru_.splice(lru_.begin(), lru_, p->second);
+    return &(*p->second);
+}
+
+void TessellationCache::insert(Entry &&entry) {
+
+    auto p = index_.find(entry.key);
+    if (p != index_.end()) {
+        // another thread got here first, or this is a collision - either way
+        // the newest geometry wins
+        bytes_ -= p->second->bytes;
+        lru_.erase(p->second);
+        index_.erase(p);
+    }
+
+    bytes_ += entry.bytes;
+    lru_.push_front(std::move(entry));
+    index_[lru_.front().key] = lru_.begin();
+    evict();
+}
+
+void TessellationCache::evict() {
+    // always keep the most recent entry, even if it is bigger than the limit
+    while (bytes_ > max_bytes_ && lru_.size() > 1) {
+        bytes_ -= lru_.back().bytes;
+        index_.erase(lru_.back().key);
+        lru_.pop_back();
+    }
+}
+
+void TessellationCache::set_max_bytes(const size_t max_bytes) {
+    std::lock_guard<std::mutex> l(mutex_);
+    max_bytes_ = max_bytes;
+    evict();
+}
+
+size_t TessellationCache::max_bytes() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return max_bytes_;
+}
+
+size_t TessellationCache::bytes() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return bytes_;
+}
+
+size_t TessellationCache::size() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return lru_.size();
+}
+
+size_t TessellationCache::hits() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return hits_;
+}
+
+size_t TessellationCache::misses() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return misses_;
+}
+
+void TessellationCache::clear() {
+    std::lock_guard<std::mutex> l(mutex_);
+    lru_.clear();
+    index_.clear();
+    bytes_  = 0;
+    hits_   = 0;
+    misses_ = 0;
+}
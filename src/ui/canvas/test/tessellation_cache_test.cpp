@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#include "xstudio/ui/canvas/tessellation_cache.hpp"
+
+using namespace xstudio;
+using namespace xstudio::ui::canvas;
+
+namespace {
+
+Stroke make_stroke(const int n_points, const float seed) {
+    Stroke s = Stroke::Pen(utility::ColourTriplet(1.0f, 0.0f, 0.0f), 0.01f, 0.0f, 1.0f);
+    for (int i = 0; i < n_points; ++i) {
+        const float t = float(i) / float(n_points);
+        s.points.emplace_back(std::cos(t * 6.0f + seed), std::sin(t * 4.0f + seed) * t);
+    }
+    return s;
+}
+
+} // namespace
+
+TEST(TessellationCacheTest, StrokeVertices) {
+
+    const Stroke s = make_stroke(10, 0.0f);
+    const auto v   = TessellationCache::make_stroke_vertices(s);
+
+    ASSERT_EQ(v.size(), size_t(9 * 12));
+    for (size_t seg = 0; seg < 9; ++seg) {
+        for (size_t vtx = 0; vtx < 6; ++vtx) {
+            EXPECT_EQ(v[seg * 12 + vtx * 2], s.points[seg]);
+            EXPECT_EQ(v[seg * 12 + vtx * 2 + 1], s.points[seg + 1]);
+        }
+    }
+
+    // single point strokes draw a zero length segment
+    const Stroke dot = make_stroke(1, 0.0f);
+    EXPECT_EQ(TessellationCache::make_stroke_vertices(dot).size(), size_t(12));
+    EXPECT_TRUE(TessellationCache::make_stroke_vertices(Stroke()).empty());
+}
+
+TEST(TessellationCacheTest, LongStroke) {
+
+    // long enough to use the multithreaded path
+    const Stroke s = make_stroke(100000, 1.0f);
+    const auto v   = TessellationCache::make_stroke_vertices(s);
+
+    ASSERT_EQ(v.size(), (s.points.size() - 1) * 12);
+    for (size_t seg = 0; seg < s.points.size() - 1; seg += 997) {
+        EXPECT_EQ(v[seg * 12 + 10], s.points[seg]);
+        EXPECT_EQ(v[seg * 12 + 11], s.points[seg + 1]);
+    }
+    EXPECT_EQ(v.back(), s.points.back());
+}
+
+TEST(TessellationCacheTest, SharedByCopies) {
+
+    auto &cache = TessellationCache::instance();
+    cache.clear();
+
+    const Stroke s = make_stroke(100, 2.0f);
+    auto v1        = cache.stroke_vertices(s);
+
+    // a stroke rebuilt from json finds the same geometry
+    nlohmann::json j = s;
+    const Stroke s2  = j.get<Stroke>();
+    auto v2          = cache.stroke_vertices(s2);
+
+    EXPECT_EQ(v1.get(), v2.get());
+    EXPECT_EQ(cache.hits(), size_t(1));
+    EXPECT_EQ(cache.misses(), size_t(1));
+
+    // different points, different geometry
+    auto v3 = cache.stroke_vertices(make_stroke(100, 3.0f));
+    EXPECT_NE(v1.get(), v3.get());
+    EXPECT_EQ(cache.size(), size_t(2));
+}
+
+TEST(TessellationCacheTest, BoundedMemory) {
+
+    auto &cache = TessellationCache::instance();
+    cache.clear();
+
+    const size_t old_max = cache.max_bytes();
+    // room for ~10 strokes of 100 points
+    cache.set_max_bytes(10 * 99 * 12 * sizeof(Imath::V2f));
+
+    for (int i = 0; i < 50; ++i) {
+        cache.stroke_vertices(make_stroke(100, float(i)));
+    }
+    EXPECT_LE(cache.bytes(), cache.max_bytes());
+    EXPECT_EQ(cache.size(), size_t(10));
+
+    // most recently used strokes are kept
+    cache.stroke_vertices(make_stroke(100, 49.0f));
+    EXPECT_EQ(cache.hits(), size_t(1));
+
+    cache.set_max_bytes(old_max);
+    cache.clear();
+}
+
+TEST(TessellationCacheTest, AnnotationPlaybackBenchmark) {
+
+    // Simulates playback of a review with many annotated frames: for each
+    // frame drawn the annotation is rebuilt from JSON (as when the playhead
+    // fetches bookmark annotations) and the vertices for its strokes are
+    // generated. Reports the time without and with the cache.
+    const int n_frames         = 300;
+    const int strokes_per_anno = 20;
+    const int points_per_pen   = 100;
+    const int loops            = 3;
+
+    std::vector<nlohmann::json> annotations;
+    for (int f = 0; f < n_frames; ++f) {
+        nlohmann::json strokes = nlohmann::json::array();
+        for (int s = 0; s < strokes_per_anno; ++s) {
+            strokes.push_back(make_stroke(points_per_pen, float(f * strokes_per_anno + s)));
+        }
+        annotations.push_back(strokes);
+    }
+
+    auto play = [&](const bool cached) {
+        size_t n_vertices = 0;
+        const auto t0     = std::chrono::steady_clock::now();
+        for (int l = 0; l < loops; ++l) {
+            for (const auto &anno : annotations) {
+                const auto strokes = anno.get<std::vector<Stroke>>();
+                for (const auto &s : strokes) {
+                    if (cached)
+                        n_vertices += TessellationCache::instance().stroke_vertices(s)->size();
+                    else
+                        n_vertices += TessellationCache::make_stroke_vertices(s).size();
+                }
+            }
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        return std::make_pair(
+            n_vertices, std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count());
+    };
+
+    TessellationCache::instance().clear();
+    const auto uncached = play(false);
+    const auto cached   = play(true);
+
+    EXPECT_EQ(uncached.first, cached.first);
+    EXPECT_EQ(
+        TessellationCache::instance().misses(), size_t(n_frames * strokes_per_anno));
+
+    std::cout << n_frames << " annotated frames x " << loops
+              << " loops: vertex generation uncached " << uncached.second << "us, cached "
+              << cached.second << "us (" << TessellationCache::instance().bytes()
+              << " bytes cached)\n";
+
+    TessellationCache::instance().clear();
+}
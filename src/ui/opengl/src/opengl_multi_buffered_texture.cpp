@@ -6,6 +6,7 @@
 
 #include "xstudio/ui/opengl/opengl_multi_buffered_texture.hpp"
 #include "xstudio/utility/chrono.hpp"
+#include "xstudio/utility/frame_trace.hpp"
 
 using namespace xstudio::ui::opengl;
 
@@ -90,6 +91,8 @@ class TextureTransferWorker {
             GLDoubleBufferedTexture::GLBlindTexturePtr tex = get_job();
             if (!tex)
                 break; // exit
+            utility::TraceSpan span(
+                utility::TraceStage::TextureUpload, tex->pending_media_key());
             tex->do_pixel_upload();
         }
     }
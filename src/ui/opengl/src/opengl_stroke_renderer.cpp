@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "xstudio/ui/opengl/opengl_stroke_renderer.hpp"
+#include "xstudio/ui/canvas/tessellation_cache.hpp"
 
 using namespace xstudio::ui::canvas;
 using namespace xstudio::ui::opengl;
@@ -151,33 +152,26 @@ void OpenGLStrokeRenderer::render_strokes(
     if (!shader_)
         init_gl();
 
-    std::vector<Imath::V2f> line_start_end_per_vertex;
+    // the per vertex data for each stroke comes from the tessellation
+    // cache, so strokes that are redrawn (or copies of them) aren't
+    // regenerated every time we draw
+    std::vector<StrokeVerticesPtr> stroke_vertices;
     std::vector<int> n_vtx_per_stroke;
+    stroke_vertices.reserve(strokes.size());
+    n_vtx_per_stroke.reserve(strokes.size());
 
+    size_t n_vertices = 0;
     for (const auto &stroke : strokes) {
-        const Imath::V2f *v0 = stroke.points.data();
-        const Imath::V2f *v1 = v0;
-        if (stroke.points.size() > 1)
-            v1++;
-        const int n_segments = std::max(size_t(1), (stroke.points.size() - 1));
-        n_vtx_per_stroke.push_back(n_segments * 6);
-
-        for (int i = 0; i < n_segments; ++i) {
-            line_start_end_per_vertex.push_back(*v0);
-            line_start_end_per_vertex.push_back(*v1);
-            line_start_end_per_vertex.push_back(*v0);
-            line_start_end_per_vertex.push_back(*v1);
-            line_start_end_per_vertex.push_back(*v0);
-            line_start_end_per_vertex.push_back(*v1);
-            line_start_end_per_vertex.push_back(*v0);
-            line_start_end_per_vertex.push_back(*v1);
-            line_start_end_per_vertex.push_back(*v0);
-            line_start_end_per_vertex.push_back(*v1);
-            line_start_end_per_vertex.push_back(*v0);
-            line_start_end_per_vertex.push_back(*v1);
-            v0++;
-            v1++;
-        }
+        stroke_vertices.push_back(TessellationCache::instance().stroke_vertices(stroke));
+        // two V2f (line start & end) per vertex
+        n_vtx_per_stroke.push_back(int(stroke_vertices.back()->size() / 2));
+        n_vertices += stroke_vertices.back()->size();
+    }
+
+    std::vector<Imath::V2f> line_start_end_per_vertex;
+    line_start_end_per_vertex.reserve(n_vertices);
+    for (const auto &v : stroke_vertices) {
+        line_start_end_per_vertex.insert(line_start_end_per_vertex.end(), v->begin(), v->end());
     }
 
     glBindVertexArray(vao_);
@@ -329,7 +323,7 @@ void OpenGLStrokeRenderer::render_strokes(
         shader_params3["do_soft_edge"] = true;
         shader_params3["soft_dim"] = viewport_du_dx * 4.0f + stroke.softness * stroke.thickness;
         shader_->set_shader_parameters(shader_params3);
-        glDrawArrays(GL_TRIANGLES, offset, (stroke.points.size() - 1) * 6);
+        glDrawArrays(GL_TRIANGLES, offset, std::max(0, int(stroke.points.size()) - 1) * 6);
 
         offset += *p_n_vtx_per_stroke;
         *p_n_vtx_per_stroke++;
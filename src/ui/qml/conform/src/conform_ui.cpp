@@ -73,6 +73,13 @@ void ConformEngineUI::init(caf::actor_system &_system) {
                 conform::conform_tasks_atom,
                 const std::vector<std::string> &) {},
 
+            [=](utility::event_atom, conform::conform_atom, const JsonStore &progress) {
+                emit conformProgress(
+                    QStringFromStd(progress.value("stage", std::string())),
+                    progress.value("done", 0),
+                    progress.value("total", 0));
+            },
+
             [=](utility::event_atom,
                 json_store::sync_atom,
                 const Uuid &uuid,
@@ -214,9 +214,11 @@ OffscreenViewport::OffscreenViewport(const std::string name, bool sync_with_main
     // viewport that can receive caf messages including framebuffers and also
     // to render the viewport into our GLContext
     utility::JsonStore jsn;
-    jsn["base"]       = utility::JsonStore();
-    jsn["window_id"]  = name;
-    xstudio_viewport_ = new Viewport(jsn, as_actor(), sync_with_main_viewports, name);
+    jsn["base"]        = utility::JsonStore();
+    jsn["window_id"]   = name;
+    // renders and video outputs always get the full resolution frames
+    jsn["use_proxies"] = false;
+    xstudio_viewport_  = new Viewport(jsn, as_actor(), sync_with_main_viewports, name);
 
     /* Provide a callback so the Viewport can tell this class when some property of the viewport
     has changed and such events can be propagated to other QT components, for example */
@@ -479,6 +481,12 @@ void OffscreenViewport::cleanup() {
     // cleanup is called by our thread on completion, so we can delete
     // ouselves whilst still in the Thread. Qt doesn't let us kill object
     // living in one thread from another thread.
+    if (software_render_) {
+        delete xstudio_viewport_;
+        video_output_actor_ = caf::actor();
+        return;
+    }
+
     // gl context must be current for cleanup
     gl_context_->makeCurrent(surface_);
     if (render_control_)
@@ -509,6 +517,14 @@ void OffscreenViewport::cleanup() {
 
 void OffscreenViewport::initGL() {
 
+    if (software_render_)
+        return;
+
+    if (!gl_context_ && utility::get_env("XSTUDIO_SOFTWARE_RENDER", "0") != "0") {
+        initSoftwareRender();
+        return;
+    }
+
     if (!gl_context_) {
         // create our own GL context
         QSurfaceFormat format = QSurfaceFormat::defaultFormat();
@@ -524,8 +540,14 @@ void OffscreenViewport::initGL() {
         if (!gl_context_)
             throw std::runtime_error("OffscreeninitGL - could not create QOpenGLContext.");
         if (!gl_context_->create()) {
-            throw std::runtime_error("OffscreeninitGL - failed to creat GL Context "
-                                     "for offscreen rendering.");
+            spdlog::warn(
+                "{} failed to create GL Context for offscreen rendering, falling back to "
+                "software rendering.",
+                __PRETTY_FUNCTION__);
+            delete gl_context_;
+            gl_context_ = nullptr;
+            initSoftwareRender();
+            return;
         }
 
         // This offscreen viewport runs in its own thread
@@ -593,6 +615,22 @@ void OffscreenViewport::initGL() {
     }
 }
 
+void OffscreenViewport::initSoftwareRender() {
+
+    // No GL context, surface or QML overlays here - the xstudio viewport
+    // draws with the CPU renderer and we read its framebuffer directly.
+    software_render_ = true;
+    cpu_renderer_    = std::make_shared<viewport::CPUViewportRenderer>();
+    xstudio_viewport_->set_renderer_override(cpu_renderer_);
+
+    thread_ = new QThread();
+    moveToThread(thread_);
+    thread_->start();
+
+    connect(thread_, &QThread::finished, thread_, &QThread::deleteLater);
+    connect(thread_, &QThread::finished, this, &OffscreenViewport::cleanup);
+}
+
 void OffscreenViewport::stop() {
     thread_->quit();
     thread_->wait();
@@ -912,6 +950,11 @@ void OffscreenViewport::render(
     const utility::time_point &tp,
     const media_reader::ImageBufPtr &image_to_use) {
 
+    if (software_render_) {
+        renderSoftware(w, h, sync_fetch_playhead_image, tp, image_to_use);
+        return;
+    }
+
     // ensure our GLContext is current
     if (!gl_context_->makeCurrent(surface_) || !gl_context_->isValid()) {
         throw std::runtime_error("OffscreenrenderToImageBuffer - GL Context is not valid.");
@@ -1067,6 +1110,33 @@ void OffscreenViewport::render(
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
+void OffscreenViewport::renderSoftware(
+    const int w,
+    const int h,
+    const bool sync_fetch_playhead_image,
+    const utility::time_point &tp,
+    const media_reader::ImageBufPtr &image_to_use) {
+
+    // N.B. the QML HUD overlays are not available in software mode, but
+    // viewport overlay plugins (e.g. annotations) that implement
+    // render_image_overlay_cpu are drawn by the CPU renderer
+    xstudio_viewport_->init();
+    xstudio_viewport_->set_geometry(0.0f, 0.0f, w, h, w, h, 1.0f);
+
+    if (image_to_use) {
+        xstudio_viewport_->render(image_to_use);
+    } else {
+        if (sync_fetch_playhead_image) {
+            xstudio_viewport_->prepare_render_data(utility::clock::now(), true);
+        } else if (tp != utility::time_point()) {
+            xstudio_viewport_->prepare_render_data(tp);
+        } else {
+            xstudio_viewport_->prepare_render_data();
+        }
+        xstudio_viewport_->render();
+    }
+}
+
 void OffscreenViewport::sync_python_hud_data() {
 
     // Python HUD plugins update their overlay data asynchronously. They get a
@@ -1128,6 +1198,11 @@ void OffscreenViewport::renderToImageBuffer(
     // the actual render call
     render(w, h, format, sync_fetch_playhead_image, tp, image_to_use);
 
+    if (software_render_) {
+        cpu_renderer_->copy_framebuffer(destination_image, format);
+        return;
+    }
+
     if (!post_draw_hook_)
         post_draw_hook_.reset(new DefaultFrameGrabber());
 
@@ -0,0 +1,338 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <cmath>
+#include <mutex>
+
+#include <Imath/half.h>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+#include "xstudio/ui/viewport/cpu_viewport_renderer.hpp"
+#include "xstudio/utility/chrono.hpp"
+#include "xstudio/utility/logging.hpp"
+
+using namespace xstudio;
+using namespace xstudio::ui::viewport;
+
+namespace {
+
+// Lazily unpacked rows of source image data. Rows are decoded on first
+// access (from whichever thread gets there first) so when the image is
+// zoomed out we only decode the scanlines that are actually sampled.
+class SourceRows {
+  public:
+    SourceRows(const media_reader::ImageBuffer &buf)
+        : buf_(buf),
+          bounds_(buf.image_pixels_bounding_box()),
+          width_(bounds_.max.x - bounds_.min.x),
+          height_(bounds_.max.y - bounds_.min.y),
+          data_(size_t(std::max(width_, 0)) * std::max(height_, 0) * 4),
+          flags_(new std::once_flag[std::max(height_, 0)]) {}
+
+    [[nodiscard]] const float *row(int y) {
+        y -= bounds_.min.y;
+        float *r = data_.data() + size_t(y) * width_ * 4;
+        std::call_once(flags_[y], [&]() { buf_.unpack_scanline(y + bounds_.min.y, r); });
+        return r;
+    }
+
+    [[nodiscard]] const Imath::Box2i &bounds() const { return bounds_; }
+    [[nodiscard]] bool empty() const { return width_ <= 0 || height_ <= 0; }
+
+  private:
+    const media_reader::ImageBuffer &buf_;
+    const Imath::Box2i bounds_;
+    const int width_;
+    const int height_;
+    std::vector<float> data_;
+    std::unique_ptr<std::once_flag[]> flags_;
+};
+
+inline void lerp4(float *out, const float *a, const float *b, const float f) {
+    out[0] = a[0] + (b[0] - a[0]) * f;
+    out[1] = a[1] + (b[1] - a[1]) * f;
+    out[2] = a[2] + (b[2] - a[2]) * f;
+    out[3] = a[3] + (b[3] - a[3]) * f;
+}
+
+} // anonymous namespace
+
+CPUViewportRenderer::CPUViewportRenderer(const int num_threads)
+    : workers_(std::make_unique<utility::WorkerPool>(num_threads)) {}
+
+void CPUViewportRenderer::parallel_rows(
+    const int num_rows, const std::function<void(const int, const int)> &func) const {
+
+    // rows are handed out in small chunks so that threads that land on
+    // empty (e.g. letterbox) areas go on to pick up more work
+    static const int chunk = 8;
+    workers_->parallel_for(num_rows, chunk, func);
+}
+
+void CPUViewportRenderer::render(
+    const media_reader::ImageBufDisplaySetPtr &images,
+    const Imath::M44f &window_to_viewport_matrix,
+    const Imath::M44f &viewport_to_image_space,
+    const Imath::V2i &window_size,
+    const float device_pixel_ratio,
+    const std::map<utility::Uuid, plugin::ViewportOverlayRendererPtr> &overlay_renderers) {
+
+    init();
+
+    framebuffer_size_ = Imath::V2i(std::max(window_size.x, 0), std::max(window_size.y, 0));
+    framebuffer_.resize(size_t(framebuffer_size_.x) * framebuffer_size_.y * 4);
+
+    // clear to opaque black, as per the OpenGL renderer
+    parallel_rows(framebuffer_size_.y, [&](const int y0, const int y1) {
+        for (int y = y0; y < y1; ++y) {
+            float *p = framebuffer_.data() + size_t(y) * framebuffer_size_.x * 4;
+            for (int x = 0; x < framebuffer_size_.x; ++x, p += 4) {
+                p[0] = p[1] = p[2] = 0.0f;
+                p[3]               = 1.0f;
+            }
+        }
+    });
+
+    if (!images || !images->layout_data() || framebuffer_.empty())
+        return;
+
+    // see OpenGLViewportRenderer::render for explanation
+    const float image_zoom_in_viewport = viewport_to_image_space[0][0];
+    const float viewport_x_size_in_window =
+        window_to_viewport_matrix[0][0] / window_to_viewport_matrix[3][3];
+    const float viewport_du_dx =
+        image_zoom_in_viewport / (window_size.x * viewport_x_size_in_window);
+
+    for (const auto &idx : images->layout_data()->image_draw_order_hint_) {
+        draw_image(
+            images->onscreen_image(idx),
+            images->layout_data(),
+            idx,
+            window_to_viewport_matrix,
+            viewport_to_image_space,
+            viewport_du_dx);
+    }
+
+    auto draw_overlays = [&](const int idx) {
+        const media_reader::ImageBufPtr &image = images->onscreen_image(idx);
+        if (!image)
+            return;
+        const Imath::M44f to_image_matrix =
+            (image.layout_transform() * viewport_to_image_space.inverse()).inverse();
+        for (const auto &orf : overlay_renderers) {
+            orf.second->render_image_overlay_cpu(
+                framebuffer_.data(),
+                framebuffer_size_,
+                window_to_viewport_matrix,
+                to_image_matrix,
+                std::abs(viewport_du_dx),
+                image);
+        }
+    };
+
+    if (images->layout_data()->draw_hero_overlays_only_) {
+        draw_overlays(images->hero_sub_playhead_index());
+    } else {
+        for (const auto &idx : images->layout_data()->image_draw_order_hint_) {
+            draw_overlays(idx);
+        }
+    }
+}
+
+void CPUViewportRenderer::draw_image(
+    const media_reader::ImageBufPtr &image,
+    const media_reader::ImageSetLayoutDataPtr &layout_data,
+    const int index,
+    const Imath::M44f &window_to_viewport_matrix,
+    const Imath::M44f &viewport_to_image_space,
+    const float viewport_du_dx) {
+
+    if (!image)
+        return;
+
+    SourceRows source(*image);
+    if (source.empty())
+        return;
+
+    const utility::JsonStore shader_params = core_shader_params(
+        image,
+        window_to_viewport_matrix,
+        viewport_to_image_space,
+        viewport_du_dx,
+        layout_data->custom_layout_data_,
+        index);
+
+    const bool bilinear = shader_params.value("use_bilinear_filtering", false);
+    const float aspect  = shader_params.value("image_aspect", 16.0f / 9.0f);
+
+    // This mirrors the vertex shader : a point 'rpos' in image space maps to
+    // the window as rpos*image_transform_matrix*to_coord_system*to_canvas.
+    // We invert that to go from window pixel to image pixel.
+    const Imath::M44f to_window =
+        shader_params["image_transform_matrix"].get<Imath::M44f>() *
+        shader_params["to_coord_system"].get<Imath::M44f>() *
+        shader_params["to_canvas"].get<Imath::M44f>();
+    const Imath::M44f from_window = to_window.inverse();
+
+    const Imath::V2i image_dims = image->image_size_in_pixels();
+    const Imath::V2i fb_size    = framebuffer_size_;
+
+    auto window_pix_to_image_pix = [&](const float x, const float y) {
+        Imath::V3f rpos;
+        from_window.multVecMatrix(
+            Imath::V3f(
+                (x + 0.5f) * 2.0f / float(fb_size.x) - 1.0f,
+                (y + 0.5f) * 2.0f / float(fb_size.y) - 1.0f,
+                0.0f),
+            rpos);
+        return Imath::V2f(
+            (rpos.x + 1.0f) * 0.5f * float(image_dims.x),
+            (rpos.y * aspect + 1.0f) * 0.5f * float(image_dims.y));
+    };
+
+    // the transform is affine, so we can step through image pixel coordinates
+    // with constant increments as we go along the scanline
+    const Imath::V2f origin = window_pix_to_image_pix(0.0f, 0.0f);
+    const Imath::V2f d_dx   = window_pix_to_image_pix(1.0f, 0.0f) - origin;
+    const Imath::V2f d_dy   = window_pix_to_image_pix(0.0f, 1.0f) - origin;
+
+    const Imath::Box2i &bounds = source.bounds();
+    std::vector<colour_pipeline::ColourOperationData::CPUProcessFunc> colour_ops;
+    if (image.colour_pipe_data_) {
+        for (const auto &op : image.colour_pipe_data_->operations()) {
+            if (op->cpu_process_func_) {
+                colour_ops.push_back(op->cpu_process_func_);
+            } else {
+                spdlog::debug(
+                    "{} colour operation \"{}\" has no CPU implementation.",
+                    __PRETTY_FUNCTION__,
+                    op->name_);
+            }
+        }
+    }
+
+    parallel_rows(fb_size.y, [&](const int y0, const int y1) {
+        for (int y = y0; y < y1; ++y) {
+
+            float *out   = framebuffer_.data() + size_t(y) * fb_size.x * 4;
+            Imath::V2f p = origin + d_dy * float(y);
+            int span_min = fb_size.x;
+            int span_max = -1;
+
+            for (int x = 0; x < fb_size.x; ++x, p += d_dx) {
+
+                if (p.x < bounds.min.x || p.x >= bounds.max.x || p.y < bounds.min.y ||
+                    p.y >= bounds.max.y)
+                    continue;
+
+                span_min = std::min(span_min, x);
+                span_max = x;
+                float *o = out + x * 4;
+
+                if (bilinear) {
+                    const float sx = p.x - 0.5f;
+                    const float sy = p.y - 0.5f;
+                    const int ix   = int(std::floor(sx));
+                    const int iy   = int(std::floor(sy));
+                    const int x0   = std::clamp(ix, bounds.min.x, bounds.max.x - 1);
+                    const int x1   = std::clamp(ix + 1, bounds.min.x, bounds.max.x - 1);
+                    const float *r0 =
+                        source.row(std::clamp(iy, bounds.min.y, bounds.max.y - 1));
+                    const float *r1 =
+                        source.row(std::clamp(iy + 1, bounds.min.y, bounds.max.y - 1));
+                    const float fx = sx - float(ix);
+                    float top[4], bottom[4];
+                    lerp4(top, r0 + (x0 - bounds.min.x) * 4, r0 + (x1 - bounds.min.x) * 4, fx);
+                    lerp4(
+                        bottom, r1 + (x0 - bounds.min.x) * 4, r1 + (x1 - bounds.min.x) * 4, fx);
+                    lerp4(o, top, bottom, sy - float(iy));
+                } else {
+                    const float *r = source.row(int(std::floor(p.y)));
+                    const float *s = r + (int(std::floor(p.x)) - bounds.min.x) * 4;
+                    o[0]           = s[0];
+                    o[1]           = s[1];
+                    o[2]           = s[2];
+                    o[3]           = s[3];
+                }
+            }
+
+            if (span_max < span_min)
+                continue;
+
+            // The image quad is convex so the pixels it covers on any scanline
+            // are contiguous and we can colour-process them in one go.
+            float *span          = out + span_min * 4;
+            const size_t n_pixels = size_t(span_max - span_min + 1);
+            for (const auto &op : colour_ops) {
+                op(span, n_pixels);
+            }
+            for (size_t i = 0; i < n_pixels; ++i) {
+                span[i * 4 + 3] = 1.0f;
+            }
+        }
+    });
+}
+
+void CPUViewportRenderer::copy_framebuffer(
+    media_reader::ImageBufPtr &destination_image, const ImageFormat format) const {
+
+    const int width  = framebuffer_size_.x;
+    const int height = framebuffer_size_.y;
+
+    size_t bytes_per_pixel = 4;
+    if (format == ImageFormat::RGBA_16 || format == ImageFormat::RGBA_16F)
+        bytes_per_pixel = 8;
+    else if (format == ImageFormat::RGBA_32F)
+        bytes_per_pixel = 16;
+
+    if (!destination_image)
+        destination_image.reset(new media_reader::ImageBuffer());
+    destination_image->allocate(size_t(width) * height * bytes_per_pixel);
+    destination_image->set_image_dimensions(Imath::V2i(width, height));
+    destination_image.when_to_display_          = utility::clock::now();
+    destination_image->params()["pixel_format"] = (int)format;
+
+    auto *dst_base = reinterpret_cast<uint8_t *>(destination_image->buffer());
+
+    parallel_rows(height, [&](const int y0, const int y1) {
+        for (int y = y0; y < y1; ++y) {
+
+            const float *src = framebuffer_.data() + size_t(y) * width * 4;
+            uint8_t *dst     = dst_base + size_t(y) * width * bytes_per_pixel;
+            const int n      = width * 4;
+
+            switch (format) {
+            case ImageFormat::RGBA_32F:
+                memcpy(dst, src, size_t(n) * sizeof(float));
+                break;
+            case ImageFormat::RGBA_16F: {
+                auto *h = reinterpret_cast<half *>(dst);
+                int i   = 0;
+#if defined(__F16C__) && defined(__AVX__)
+                for (; i + 8 <= n; i += 8) {
+                    const __m128i v =
+                        _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(h + i), v);
+                }
+#endif
+                for (; i < n; ++i) {
+                    h[i] = half(src[i]);
+                }
+            } break;
+            case ImageFormat::RGBA_16: {
+                auto *s = reinterpret_cast<uint16_t *>(dst);
+                for (int i = 0; i < n; ++i) {
+                    s[i] = uint16_t(std::clamp(src[i], 0.0f, 1.0f) * 65535.0f + 0.5f);
+                }
+            } break;
+            default:
+                // N.B. the OpenGL path also reads RGBA_10_10_10_2 back as 8 bits
+                for (int i = 0; i < n; ++i) {
+                    dst[i] = uint8_t(std::clamp(src[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+                }
+                break;
+            }
+        }
+    });
+}
@@ -4,6 +4,7 @@
 #include "xstudio/broadcast/broadcast_actor.hpp"
 #include "xstudio/colour_pipeline/colour_pipeline.hpp"
 #include "xstudio/media_reader/media_reader.hpp"
+#include "xstudio/utility/frame_trace.hpp"
 #include "xstudio/utility/helpers.hpp"
 #include "xstudio/utility/logging.hpp"
 #include "xstudio/utility/uuid.hpp"
@@ -138,6 +139,12 @@ void FpsMonitor::reset_actual_fps_measure() { viewport_frame_update_timepoints_.
 
 void FpsMonitor::framebuffer_swapped(const utility::time_point &tp, const int frame) {
 
+    // trace the interval between swaps, the tail of the frame pipeline
+    if (utility::FrameTracer::enabled() && !viewport_frame_update_timepoints_.empty() &&
+        viewport_frame_update_timepoints_.back().first < tp)
+        utility::FrameTracer::instance().record(
+            utility::TraceStage::Swap, viewport_frame_update_timepoints_.back().first, tp);
+
     // we don't have enough samples, so fill in some phony samples
     if (viewport_frame_update_timepoints_.size() < MIN_FPS_MEASURE_EVENTS) {
 
@@ -5,6 +5,7 @@
 #include <chrono>
 #include <type_traits>
 
+#include "xstudio/media_reader/image_proxy.hpp"
 #include "xstudio/ui/viewport/viewport.hpp"
 #include "xstudio/ui/viewport/viewport_frame_queue_actor.hpp"
 #include "xstudio/utility/helpers.hpp"
@@ -122,6 +123,7 @@ Viewport::Viewport(
     }
 
     has_overlays_ = state_data.value("has_overlays", true);
+    use_proxies_  = state_data.value("use_proxies", true);
 
     if (window_id_ == "xstudio_quickview_window") {
         // This is a hack - I've not worked out how to make unique window ID on construction
@@ -972,6 +974,36 @@ void Viewport::calc_image_bounds_in_viewport_pixels() {
     if (old != image_bounds_in_viewport_pixels_) {
         event_callback(ImageBoundsChanged);
     }
+
+    update_proxy_level();
+}
+
+void Viewport::update_proxy_level() {
+
+    // grid layouts can draw frames small enough that a reduced copy (see
+    // media_reader::make_image_proxies) looks the same. The level that
+    // suits the largest frame on screen is used for all of them.
+    int level = 0;
+    if (use_proxies_ && on_screen_frames_ && on_screen_frames_->has_grid_layout() &&
+        on_screen_frames_->layout_data()) {
+        const auto &im_order = on_screen_frames_->layout_data()->image_draw_order_hint_;
+        level                = media_reader::max_proxy_level;
+        for (size_t i = 0; i < image_bounds_in_viewport_pixels_.size() && i < im_order.size();
+             ++i) {
+            const auto &im = on_screen_frames_->onscreen_image(im_order[i]);
+            if (!im)
+                continue;
+            const float width =
+                image_bounds_in_viewport_pixels_[i].size().x * state_.devicePixelRatio_;
+            level = std::min(
+                level, media_reader::proxy_level_for(im->source_size_in_pixels().x, width));
+        }
+    }
+
+    if (level != proxy_level_ && display_frames_queue_actor_) {
+        proxy_level_ = level;
+        anon_mail(media_cache::proxy_atom_v, level).send(display_frames_queue_actor_);
+    }
 }
 
 void Viewport::update_image_resolutions() {
@@ -989,7 +1021,7 @@ void Viewport::update_image_resolutions() {
     for (const auto &i : im_order) {
         const media_reader::ImageBufPtr &im = on_screen_frames_->onscreen_image(i);
         if (im) {
-            image_resolutions_.push_back(im->image_size_in_pixels());
+            image_resolutions_.push_back(im->source_size_in_pixels());
         } else {
             image_resolutions_.push_back(Imath::V2i(1920, 1080));
         }
@@ -1425,6 +1457,9 @@ void Viewport::attribute_changed(const utility::Uuid &attr_uuid, const int role)
             if (active_renderer_ && filter_mode_pref == std::get<1>(opt)) {
                 active_renderer_->set_render_hints(std::get<0>(opt));
             }
+            if (renderer_override_ && filter_mode_pref == std::get<1>(opt)) {
+                renderer_override_->set_render_hints(std::get<0>(opt));
+            }
         }
         event_callback(Redraw);
 
@@ -1640,8 +1675,8 @@ void Viewport::update_onscreen_frame_info(const media_reader::ImageBufDisplaySet
     }
 
     if (state_.layout_aspect_ != images->layout_aspect() ||
-        state_.image_size_ != images->hero_image()->image_size_in_pixels()) {
-        state_.image_size_    = images->hero_image()->image_size_in_pixels();
+        state_.image_size_ != images->hero_image()->source_size_in_pixels()) {
+        state_.image_size_    = images->hero_image()->source_size_in_pixels();
         state_.layout_aspect_ = images->layout_aspect();
         update_matrix();
     }
@@ -2113,7 +2148,7 @@ void Viewport::render(const media_reader::ImageBufPtr &image_buf) {
     rdata->window_to_viewport_matrix = window_to_viewport_matrix();
     rdata->projection_matrix         = projection_matrix();
     rdata->overlay_renderers         = viewport_overlay_renderers_;
-    rdata->renderer                  = active_renderer_;
+    rdata->renderer                  = renderer();
     rdata->window_size               = state_.window_size_;
     rdata->device_pixel_ratio        = state_.devicePixelRatio_;
     render_data_.reset(rdata);
@@ -2130,12 +2165,26 @@ void Viewport::prepare_render_data(
     rdata->window_to_viewport_matrix = window_to_viewport_matrix();
     rdata->projection_matrix         = projection_matrix();
     rdata->overlay_renderers         = viewport_overlay_renderers_;
-    rdata->renderer                  = active_renderer_;
+    rdata->renderer                  = renderer();
     rdata->window_size               = state_.window_size_;
     rdata->device_pixel_ratio        = state_.devicePixelRatio_;
     render_data_.reset(rdata);
 }
 
+void Viewport::set_renderer_override(const ViewportRendererPtr &renderer) {
+
+    renderer_override_ = renderer;
+    if (renderer_override_) {
+        const std::string filter_mode_pref = filter_mode_preference_->value();
+        for (auto opt : ViewportRenderer::pixel_filter_mode_names) {
+            if (filter_mode_pref == std::get<1>(opt)) {
+                renderer_override_->set_render_hints(std::get<0>(opt));
+            }
+        }
+    }
+    event_callback(Redraw);
+}
+
 void Viewport::set_compare_mode(const std::string &compare_mode) {
 
     if (compare_mode_ == compare_mode)
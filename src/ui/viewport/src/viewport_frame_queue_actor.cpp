@@ -1,7 +1,13 @@
 // SPDX-License-Identifier: Apache-2.0
+#include <caf/actor_registry.hpp>
+
+#include <algorithm>
+
 #include "xstudio/atoms.hpp"
 #include "xstudio/media_reader/image_buffer_set.hpp"
+#include "xstudio/media_reader/image_proxy.hpp"
 #include "xstudio/ui/viewport/viewport_frame_queue_actor.hpp"
+#include "xstudio/utility/frame_trace.hpp"
 #include "xstudio/utility/helpers.hpp"
 #include "xstudio/utility/logging.hpp"
 #include "xstudio/utility/uuid.hpp"
@@ -29,6 +35,8 @@ ViewportFrameQueueActor::ViewportFrameQueueActor(
 
     print_on_exit(this, "ViewportFrameQueueActor");
 
+    image_cache_ = system().registry().template get<caf::actor>(image_cache_registry);
+
     behavior_.assign(
         [=](xstudio::broadcast::broadcast_down_atom, const caf::actor_addr &) {},
 
@@ -47,7 +55,18 @@ ViewportFrameQueueActor::ViewportFrameQueueActor(
 
         [=](playhead::key_child_playhead_atom,
             const utility::UuidVector &child_playhead_uuids) {
+            withdraw_proxy_demand(proxy_demand_playheads());
             sub_playhead_ids_ = child_playhead_uuids;
+            send_proxy_demand(proxy_level_);
+        },
+
+        // the viewport is drawing frames small enough for this proxy level,
+        // see media_reader::proxy_level_for
+        [=](media_cache::proxy_atom, const int level) {
+            if (level == proxy_level_)
+                return;
+            proxy_level_ = level;
+            send_proxy_demand(level);
         },
 
         [=](playhead::key_child_playhead_atom,
@@ -89,8 +108,15 @@ ViewportFrameQueueActor::ViewportFrameQueueActor(
                             queue_image_buffer_for_drawing(intial_frame, sub_playhead.uuid());
                             if (current_key_sub_playhead_id_ != sub_playhead.uuid()) {
                                 previous_key_sub_playhead_id_ = current_key_sub_playhead_id_;
+                                if (std::find(
+                                        sub_playhead_ids_.begin(),
+                                        sub_playhead_ids_.end(),
+                                        current_key_sub_playhead_id_) ==
+                                    sub_playhead_ids_.end())
+                                    withdraw_proxy_demand({current_key_sub_playhead_id_});
                             }
                             current_key_sub_playhead_id_ = sub_playhead.uuid();
+                            send_proxy_demand(proxy_level_);
                             clear_images_from_old_playheads();
                             last_playhead_set_tp_ = tp;
                         }
@@ -251,6 +277,8 @@ ViewportFrameQueueActor::ViewportFrameQueueActor(
 ViewportFrameQueueActor::~ViewportFrameQueueActor() {}
 
 void ViewportFrameQueueActor::on_exit() {
+    withdraw_proxy_demand(proxy_demand_playheads());
+    image_cache_             = caf::actor();
     viewport_layout_manager_ = caf::actor();
     playhead_                = utility::UuidActor();
     caf::event_based_actor::on_exit();
@@ -303,6 +331,60 @@ void ViewportFrameQueueActor::queue_image_buffer_for_drawing(
 
     auto &frames_queued_for_display = frames_to_draw_per_playhead_[playhead_id];
     frames_queued_for_display[buf.timeline_timestamp()] = buf;
+
+    if (not proxy_level_ or not image_cache_ or not buf or buf->proxy_level() == proxy_level_)
+        return;
+
+    // the proxy replaces the frame if it's still queued when it turns up
+    mail(
+        media_cache::proxy_atom_v,
+        media_cache::retrieve_atom_v,
+        buf->media_key(),
+        proxy_level_,
+        playhead_id)
+        .request(image_cache_, infinite)
+        .then(
+            [=](const media_reader::ImageBufPtr &proxy) {
+                if (not proxy)
+                    return;
+                auto frames = frames_to_draw_per_playhead_.find(playhead_id);
+                if (frames == frames_to_draw_per_playhead_.end())
+                    return;
+                auto p = frames->second.find(buf.timeline_timestamp());
+                if (p == frames->second.end() or p->second.get() != buf.get())
+                    return;
+                p->second = media_reader::with_proxy(p->second, proxy);
+                anon_mail(playhead::redraw_viewport_atom_v).send(viewport_);
+            },
+            [=](const caf::error &) {});
+}
+
+utility::UuidVector ViewportFrameQueueActor::proxy_demand_playheads() const {
+    auto playheads = sub_playhead_ids_;
+    if (not current_key_sub_playhead_id_.is_null() and
+        std::find(playheads.begin(), playheads.end(), current_key_sub_playhead_id_) ==
+            playheads.end())
+        playheads.push_back(current_key_sub_playhead_id_);
+    return playheads;
+}
+
+void ViewportFrameQueueActor::send_proxy_demand(const int level) {
+    // sent at full resolution too, as the cache only serves a playhead's
+    // proxies when every viewport showing it wants them
+    const auto playheads = proxy_demand_playheads();
+    if (not image_cache_ or playheads.empty())
+        return;
+    anon_mail(media_cache::proxy_atom_v, proxy_demand_uuid_, playheads, level)
+        .send(image_cache_);
+}
+
+void ViewportFrameQueueActor::withdraw_proxy_demand(const utility::UuidVector &playheads) {
+    if (not image_cache_ or playheads.empty() or
+        (playheads.size() == 1 and playheads.front().is_null()))
+        return;
+    anon_mail(
+        media_cache::proxy_atom_v, media_cache::erase_atom_v, proxy_demand_uuid_, playheads)
+        .send(image_cache_);
 }
 
 void ViewportFrameQueueActor::get_frames_for_display_sync(
@@ -351,6 +433,8 @@ void ViewportFrameQueueActor::get_frames_for_display(
     caf::typed_response_promise<media_reader::ImageBufDisplaySetPtr> rp,
     const utility::time_point &when_going_on_screen) {
 
+    const auto schedule_start = utility::clock::now();
+
     // evaluate the position of the playhead at the timepoint when the viewport
     // redraw happens (or, more precisely, when the buffer that it is drawn
     // to is swapped to the display)
@@ -402,6 +486,13 @@ void ViewportFrameQueueActor::get_frames_for_display(
         }
 
         result->add_on_screen_image(playhead_id, r->second);
+        if (utility::FrameTracer::enabled() && r->second)
+            utility::FrameTracer::instance().record(
+                utility::TraceStage::ViewportSchedule,
+                schedule_start,
+                utility::clock::now(),
+                r->second->media_key(),
+                playhead_id);
 
         // now we add 'future frames' - i.e. frames that are not onscreen now
         // but will be going on-screen next. We supply these to the viewport so
@@ -886,9 +977,11 @@ caf::typed_response_promise<bool> ViewportFrameQueueActor::set_playhead(
 
                                 if (curr_playhead_uuids.empty())
                                     return;
+                                withdraw_proxy_demand(proxy_demand_playheads());
                                 current_key_sub_playhead_id_ = curr_playhead_uuids.back();
                                 curr_playhead_uuids.pop_back();
                                 sub_playhead_ids_ = curr_playhead_uuids;
+                                send_proxy_demand(proxy_level_);
                                 rp.deliver(true);
                             },
                             [=](const error &err) mutable { rp.deliver(err); });
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <Imath/half.h>
+
+#include "xstudio/ui/viewport/cpu_viewport_renderer.hpp"
+#include "xstudio/utility/uuid.hpp"
+
+using namespace xstudio;
+using namespace xstudio::media_reader;
+using namespace xstudio::ui::viewport;
+
+namespace {
+
+// 4x4 image where each pixel encodes its own coordinates
+ImageBufDisplaySetPtr make_test_image_set(colour_pipeline::ColourPipelineDataPtr colour) {
+
+    ImageBufPtr image(new ImageBuffer());
+    image->set_image_dimensions(Imath::V2i(4, 4));
+    image->set_scanline_unpack_func([](const ImageBuffer &, const int line, float *rgba) {
+        for (int x = 0; x < 4; ++x) {
+            rgba[x * 4]     = float(x) / 10.0f;
+            rgba[x * 4 + 1] = float(line) / 10.0f;
+            rgba[x * 4 + 2] = 0.5f;
+            rgba[x * 4 + 3] = 1.0f;
+        }
+    });
+    image.colour_pipe_data_ = colour;
+
+    const auto sub_playhead = utility::Uuid::generate();
+    auto image_set          = new ImageBufDisplaySet(utility::UuidVector({sub_playhead}));
+    image_set->add_on_screen_image(sub_playhead, image);
+
+    auto layout                      = new ImageSetLayoutData;
+    layout->image_draw_order_hint_   = {0};
+    layout->draw_hero_overlays_only_ = false;
+    layout->layout_aspect_           = 1.0f;
+    image_set->set_layout_data(ImageSetLayoutDataPtr(layout));
+
+    return ImageBufDisplaySetPtr(image_set);
+}
+
+} // namespace
+
+TEST(CPUViewportRendererTest, Test) {
+
+    CPUViewportRenderer renderer(2);
+    renderer.set_render_hints(AlwaysNearestPixel);
+
+    // identity matrices and a window matching the image size give a
+    // 1:1 mapping of image pixels to window pixels
+    renderer.render(
+        make_test_image_set(colour_pipeline::ColourPipelineDataPtr()),
+        Imath::M44f(),
+        Imath::M44f(),
+        Imath::V2i(4, 4),
+        1.0f,
+        {});
+
+    EXPECT_EQ(renderer.framebuffer_size(), Imath::V2i(4, 4));
+    const auto &fb = renderer.framebuffer();
+    ASSERT_EQ(fb.size(), size_t(4 * 4 * 4));
+
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            const float *p = fb.data() + (y * 4 + x) * 4;
+            EXPECT_FLOAT_EQ(p[0], float(x) / 10.0f);
+            EXPECT_FLOAT_EQ(p[1], float(y) / 10.0f);
+            EXPECT_FLOAT_EQ(p[2], 0.5f);
+            EXPECT_FLOAT_EQ(p[3], 1.0f);
+        }
+    }
+}
+
+TEST(CPUViewportRendererColourTest, Test) {
+
+    auto op               = std::make_shared<colour_pipeline::ColourOperationData>("x2");
+    op->order_index_      = 0.0f;
+    op->cpu_process_func_ = [](float *rgba, const size_t n) {
+        for (size_t i = 0; i < n * 4; ++i)
+            rgba[i] *= 2.0f;
+    };
+    auto colour = std::make_shared<colour_pipeline::ColourPipelineData>();
+    colour->add_operation(op);
+
+    CPUViewportRenderer renderer(2);
+    renderer.set_render_hints(AlwaysNearestPixel);
+    renderer.render(
+        make_test_image_set(colour), Imath::M44f(), Imath::M44f(), Imath::V2i(4, 4), 1.0f, {});
+
+    const float *p = renderer.framebuffer().data() + (2 * 4 + 3) * 4;
+    EXPECT_FLOAT_EQ(p[0], 0.6f);
+    EXPECT_FLOAT_EQ(p[1], 0.4f);
+    EXPECT_FLOAT_EQ(p[2], 1.0f);
+    // display alpha is always opaque
+    EXPECT_FLOAT_EQ(p[3], 1.0f);
+
+    ImageBufPtr half_image;
+    renderer.copy_framebuffer(half_image, ImageFormat::RGBA_16F);
+    ASSERT_TRUE(half_image);
+    EXPECT_EQ(half_image->image_size_in_pixels(), Imath::V2i(4, 4));
+    EXPECT_EQ(half_image->params().value("pixel_format", -1), int(ImageFormat::RGBA_16F));
+    const half *h = reinterpret_cast<const half *>(half_image->buffer()) + (2 * 4 + 3) * 4;
+    EXPECT_NEAR(float(h[0]), 0.6f, 1e-3f);
+    EXPECT_NEAR(float(h[1]), 0.4f, 1e-3f);
+
+    ImageBufPtr rgba8;
+    renderer.copy_framebuffer(rgba8, ImageFormat::RGBA_8);
+    const auto *b = reinterpret_cast<const uint8_t *>(rgba8->buffer()) + (2 * 4 + 3) * 4;
+    EXPECT_EQ(b[0], 153);
+    EXPECT_EQ(b[2], 255);
+}
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: Apache-2.0
+#include "xstudio/utility/compact_json.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+
+namespace {
+
+// msgpack ext type marking a reference to a pool blob, json parsed from text
+// never contains binary values so these can't clash with real data.
+const uint8_t blob_subtype = 0x58;
+
+std::string_view as_view(const std::vector<uint8_t> &data) {
+    return std::string_view(reinterpret_cast<const char *>(data.data()), data.size());
+}
+
+nlohmann::json blob_ref(const uint64_t id) {
+    auto bytes = std::vector<uint8_t>(sizeof(uint64_t));
+    for (size_t i = 0; i < bytes.size(); i++)
+        bytes[i] = static_cast<uint8_t>(id >> (i * 8));
+    return nlohmann::json::binary(bytes, blob_subtype);
+}
+
+} // namespace
+
+CompactJsonPool::Handle CompactJsonPool::store(const nlohmann::json &value) {
+    auto result = Handle();
+    result.data = nlohmann::json::to_msgpack(intern(value, result.blobs));
+    return result;
+}
+
+nlohmann::json CompactJsonPool::load(const Handle &handle) const {
+    if (handle.data.empty())
+        return nlohmann::json();
+
+    auto result = nlohmann::json::from_msgpack(handle.data);
+    resolve(result);
+    return result;
+}
+
+void CompactJsonPool::release(Handle &handle) {
+    for (const auto id : handle.blobs)
+        unref(id);
+    handle.blobs.clear();
+    handle.data.clear();
+}
+
+void CompactJsonPool::clear() {
+    index_.clear();
+    blobs_.clear();
+    bytes_ = 0;
+}
+
+nlohmann::json
+CompactJsonPool::intern(const nlohmann::json &value, std::vector<uint64_t> &refs) {
+    if (not value.is_structured())
+        return value;
+
+    // children first, a shared parent then only references its large children.
+    auto children = std::vector<uint64_t>();
+    auto result   = value.is_object() ? nlohmann::json::object() : nlohmann::json::array();
+
+    if (value.is_object()) {
+        for (auto it = value.begin(); it != value.end(); ++it)
+            result[it.key()] = intern(it.value(), children);
+    } else {
+        for (const auto &i : value)
+            result.push_back(intern(i, children));
+    }
+
+    auto data = nlohmann::json::to_msgpack(result);
+
+    if (data.size() < share_threshold_) {
+        // too small to be worth sharing, whoever holds us holds our children.
+        refs.insert(refs.end(), children.begin(), children.end());
+        return result;
+    }
+
+    auto id = uint64_t(0);
+
+    if (auto it = index_.find(as_view(data)); it != index_.end()) {
+        // identical content has identical children, which the blob already holds.
+        id = it->second;
+        for (const auto child : children)
+            unref(child);
+    } else {
+        id            = next_id_++;
+        auto &blob    = blobs_[id];
+        blob.data     = std::move(data);
+        blob.children = std::move(children);
+        index_.emplace(as_view(blob.data), id);
+        bytes_ += blob.data.size();
+    }
+
+    blobs_[id].refs++;
+    refs.push_back(id);
+
+    return blob_ref(id);
+}
+
+void CompactJsonPool::resolve(nlohmann::json &value) const {
+    if (value.is_binary()) {
+        const auto &bin = value.get_binary();
+        if (bin.has_subtype() and bin.subtype() == blob_subtype and
+            bin.size() == sizeof(uint64_t)) {
+            auto id = uint64_t(0);
+            for (size_t i = 0; i < bin.size(); i++)
+                id |= static_cast<uint64_t>(bin[i]) << (i * 8);
+
+            value = nlohmann::json::from_msgpack(blobs_.at(id).data);
+            resolve(value);
+        }
+    } else if (value.is_structured()) {
+        for (auto &i : value)
+            resolve(i);
+    }
+}
+
+void CompactJsonPool::unref(const uint64_t id) {
+    auto it = blobs_.find(id);
+    if (it == blobs_.end() or --(it->second.refs))
+        return;
+
+    auto children = std::move(it->second.children);
+    index_.erase(as_view(it->second.data));
+    bytes_ -= it->second.data.size();
+    blobs_.erase(it);
+
+    for (const auto child : children)
+        unref(child);
+}
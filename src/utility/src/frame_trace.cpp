@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include "xstudio/utility/frame_trace.hpp"
+#include "xstudio/utility/logging.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+
+namespace {
+
+int64_t to_ns(const time_point &tp) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch())
+        .count();
+}
+
+size_t bucket_index(const int64_t duration_ns) {
+    auto us  = static_cast<uint64_t>(std::max(int64_t(0), duration_ns / 1000));
+    size_t b = 0;
+    while (us && b < TraceHistogram::num_buckets - 1) {
+        us >>= 1;
+        b++;
+    }
+    return b;
+}
+
+} // namespace
+
+const char *xstudio::utility::to_string(const TraceStage stage) {
+    switch (stage) {
+    case TraceStage::RequestQueueWait:
+        return "RequestQueueWait";
+    case TraceStage::Decode:
+        return "Decode";
+    case TraceStage::CacheStore:
+        return "CacheStore";
+    case TraceStage::CacheRetrieve:
+        return "CacheRetrieve";
+    case TraceStage::ReceiveFromCache:
+        return "ReceiveFromCache";
+    case TraceStage::ViewportSchedule:
+        return "ViewportSchedule";
+    case TraceStage::TextureUpload:
+        return "TextureUpload";
+    case TraceStage::Swap:
+        return "Swap";
+    default:
+        break;
+    }
+    return "Unknown";
+}
+
+void TraceHistogram::add(const int64_t duration_ns) {
+    buckets_[bucket_index(duration_ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    total_ns_.fetch_add(duration_ns, std::memory_order_relaxed);
+
+    auto max = max_ns_.load(std::memory_order_relaxed);
+    while (duration_ns > max &&
+           !max_ns_.compare_exchange_weak(max, duration_ns, std::memory_order_relaxed)) {
+    }
+}
+
+void TraceHistogram::clear() {
+    for (auto &b : buckets_)
+        b.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    total_ns_.store(0, std::memory_order_relaxed);
+    max_ns_.store(0, std::memory_order_relaxed);
+}
+
+std::array<uint64_t, TraceHistogram::num_buckets> TraceHistogram::buckets() const {
+    std::array<uint64_t, num_buckets> result;
+    for (size_t i = 0; i < num_buckets; ++i)
+        result[i] = buckets_[i].load(std::memory_order_relaxed);
+    return result;
+}
+
+double TraceHistogram::percentile_us(const double pc) const {
+    const auto b   = buckets();
+    uint64_t total = 0;
+    for (const auto &n : b)
+        total += n;
+    if (!total)
+        return 0.0;
+
+    const auto target = static_cast<uint64_t>(std::ceil(double(total) * pc / 100.0));
+    uint64_t seen     = 0;
+    for (size_t i = 0; i < num_buckets; ++i) {
+        seen += b[i];
+        if (seen >= target)
+            return double(uint64_t(1) << i);
+    }
+    return double(uint64_t(1) << (num_buckets - 1));
+}
+
+nlohmann::json TraceHistogram::json() const {
+    const auto n    = count();
+    auto result     = nlohmann::json::object();
+    result["count"] = n;
+    result["mean_us"] =
+        n ? double(total_ns_.load(std::memory_order_relaxed)) / double(n) / 1000.0 : 0.0;
+    result["max_us"]  = double(max_ns_.load(std::memory_order_relaxed)) / 1000.0;
+    result["p50_us"]  = percentile_us(50.0);
+    result["p90_us"]  = percentile_us(90.0);
+    result["p99_us"]  = percentile_us(99.0);
+    result["buckets"] = buckets();
+    return result;
+}
+
+FrameTracer &FrameTracer::instance() {
+    static FrameTracer tracer;
+    return tracer;
+}
+
+void FrameTracer::set_enabled(const bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+FrameTracer::ThreadBuffer *FrameTracer::thread_buffer() {
+    // buffers are owned by the tracer and live as long as the process, so the
+    // pointer stays valid even if events are read after the thread exits
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (!buffer) {
+        std::lock_guard<std::mutex> l(mutex_);
+        buffers_.emplace_back(new ThreadBuffer());
+        buffer      = buffers_.back().get();
+        buffer->tid = static_cast<int>(buffers_.size());
+    }
+    return buffer;
+}
+
+void FrameTracer::record(
+    const TraceStage stage,
+    const time_point &start,
+    const time_point &end,
+    const size_t key_hash,
+    const std::string_view key,
+    const Uuid &playhead) {
+
+    if (!enabled())
+        return;
+
+    auto buffer     = thread_buffer();
+    const auto head = buffer->head.load(std::memory_order_relaxed);
+    auto &ev        = buffer->events[head % ring_size];
+
+    ev.stage    = stage;
+    ev.start_ns = to_ns(start);
+    ev.end_ns   = to_ns(end);
+    ev.key_hash = key_hash;
+    ev.playhead = playhead;
+
+    const auto n = std::min(key.size(), ev.key.size() - 1);
+    std::memcpy(ev.key.data(), key.data(), n);
+    ev.key[n] = 0;
+
+    buffer->head.store(head + 1, std::memory_order_release);
+
+    histograms_[static_cast<size_t>(stage)].add(ev.end_ns - ev.start_ns);
+}
+
+std::vector<TraceEvent> FrameTracer::events() const {
+
+    std::vector<TraceEvent> result;
+
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        for (const auto &buffer : buffers_) {
+            const auto head  = buffer->head.load(std::memory_order_acquire);
+            const auto first = head > ring_size ? head - ring_size : 0;
+            const auto mark  = result.size();
+            for (auto i = first; i < head; ++i) {
+                result.push_back(buffer->events[i % ring_size]);
+                result.back().tid = buffer->tid;
+            }
+
+            // the owning thread may have overwritten the oldest events while we
+            // were copying them, drop any that could be torn
+            const auto new_head = buffer->head.load(std::memory_order_acquire);
+            if (new_head > ring_size && new_head - ring_size > first) {
+                const auto n_stale = std::min(new_head - ring_size - first, head - first);
+                result.erase(
+                    result.begin() + mark, result.begin() + mark + static_cast<long>(n_stale));
+            }
+        }
+    }
+
+    std::stable_sort(result.begin(), result.end(), [](const auto &a, const auto &b) {
+        return a.start_ns < b.start_ns;
+    });
+
+    return result;
+}
+
+nlohmann::json FrameTracer::chrome_trace() const {
+
+    const auto evs       = events();
+    const int64_t origin = evs.empty() ? 0 : evs.front().start_ns;
+
+    auto trace_events = nlohmann::json::array();
+    for (const auto &ev : evs) {
+        auto e    = nlohmann::json::object();
+        e["name"] = to_string(ev.stage);
+        e["cat"]  = "frame";
+        e["ph"]   = "X";
+        e["pid"]  = 1;
+        e["tid"]  = ev.tid;
+        // trace event timestamps are in microseconds
+        e["ts"]   = double(ev.start_ns - origin) / 1000.0;
+        e["dur"]  = double(ev.end_ns - ev.start_ns) / 1000.0;
+        e["args"] = nlohmann::json::object();
+        if (ev.key_hash)
+            e["args"]["key"] = std::string(ev.key_view());
+        if (!ev.playhead.is_null())
+            e["args"]["playhead"] = to_string(ev.playhead);
+        trace_events.push_back(e);
+    }
+
+    return nlohmann::json{{"traceEvents", trace_events}, {"displayTimeUnit", "ms"}};
+}
+
+void FrameTracer::write_chrome_trace(const std::string &path) const {
+    std::ofstream o(path);
+    o.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    o << chrome_trace().dump();
+    o.close();
+    spdlog::info("Frame trace written to {}", path);
+}
+
+nlohmann::json FrameTracer::statistics() const {
+    auto result       = nlohmann::json::object();
+    result["enabled"] = enabled();
+    auto stages       = nlohmann::json::object();
+    for (size_t i = 0; i < histograms_.size(); ++i)
+        stages[to_string(static_cast<TraceStage>(i))] = histograms_[i].json();
+    result["stages"] = stages;
+    return result;
+}
+
+void FrameTracer::clear() {
+    std::lock_guard<std::mutex> l(mutex_);
+    // buffers can't be freed, threads hold pointers to them, but resetting
+    // the head is safe as only the owning thread writes it .. apart from
+    // here, a span recorded at the same moment may survive the clear.
+    for (auto &buffer : buffers_)
+        buffer->head.store(0, std::memory_order_release);
+    for (auto &h : histograms_)
+        h.clear();
+}
+
+void TraceSpan::start(
+    const TraceStage stage,
+    const size_t key_hash,
+    const std::string_view key,
+    const Uuid &playhead) {
+    stage_    = stage;
+    key_hash_ = key_hash;
+    key_      = std::string(key);
+    playhead_ = playhead;
+    start_    = utility::clock::now();
+}
+
+TraceSpan::~TraceSpan() {
+    if (active_)
+        FrameTracer::instance().record(
+            stage_, start_, utility::clock::now(), key_hash_, key_, playhead_);
+}
@@ -1,5 +1,9 @@
 // SPDX-License-Identifier: Apache-2.0
 // #include <iostream>
+#include <algorithm>
+#include <array>
+#include <iterator>
+
 #include <zstr.hpp>
 #include "xstudio/utility/json_store.hpp"
 #include "xstudio/utility/helpers.hpp"
@@ -34,10 +38,50 @@ JsonStore xstudio::utility::open_session(const caf::uri &path) {
 }
 
 JsonStore xstudio::utility::open_session(const std::string &path) {
-    JsonStore js;
-    zstr::ifstream i(path);
-    i >> js;
-    return js;
+    // zstr handles compressed and uncompressed files, the contents are either
+    // text json or json_to_binary data.
+    zstr::ifstream i(path, std::ios::in | std::ios::binary);
+    const std::string data(
+        (std::istreambuf_iterator<char>(i)), std::istreambuf_iterator<char>());
+
+    const auto bytes = reinterpret_cast<const uint8_t *>(data.data());
+    if (is_binary_json(bytes, data.size()))
+        return JsonStore(json_from_binary(bytes, data.size()));
+
+    return JsonStore(nlohmann::json::parse(data));
+}
+
+namespace {
+// header of binary json, magic followed by format version.
+const std::array<uint8_t, 4> binary_json_magic = {'X', 'S', 'T', 'B'};
+// bump when the layout after the header changes, older builds refuse to
+// read newer data rather than misinterpret it.
+constexpr uint8_t binary_json_version = 1;
+constexpr size_t binary_json_header   = binary_json_magic.size() + 1;
+} // namespace
+
+std::vector<uint8_t> xstudio::utility::json_to_binary(const nlohmann::json &json) {
+    std::vector<uint8_t> result(binary_json_magic.begin(), binary_json_magic.end());
+    result.push_back(binary_json_version);
+    nlohmann::json::to_cbor(json, result);
+    return result;
+}
+
+bool xstudio::utility::is_binary_json(const uint8_t *data, const size_t size) {
+    return size >= binary_json_header and
+           std::equal(binary_json_magic.begin(), binary_json_magic.end(), data);
+}
+
+nlohmann::json xstudio::utility::json_from_binary(const uint8_t *data, const size_t size) {
+    if (not is_binary_json(data, size))
+        throw std::runtime_error("Not binary json data.");
+
+    const auto version = data[binary_json_magic.size()];
+    if (version > binary_json_version)
+        throw std::runtime_error(
+            fmt::format("Unsupported binary json version {}.", static_cast<int>(version)));
+
+    return nlohmann::json::from_cbor(data + binary_json_header, data + size);
 }
 
 
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <algorithm>
+
+#include "xstudio/utility/worker_pool.hpp"
+
+using namespace xstudio::utility;
+
+WorkerPool::WorkerPool(const int num_threads) {
+    const int n =
+        num_threads > 0 ? num_threads : std::max(1, int(std::thread::hardware_concurrency()));
+    threads_.reserve(n - 1);
+    for (int i = 1; i < n; ++i)
+        threads_.emplace_back(&WorkerPool::run, this);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard lk(mutex_);
+        stop_ = true;
+    }
+    job_cv_.notify_all();
+    for (auto &t : threads_)
+        t.join();
+}
+
+void WorkerPool::parallel_for(
+    const int count, const int chunk, const std::function<void(const int, const int)> &func) {
+
+    if (count <= 0)
+        return;
+    if (threads_.empty() or count <= chunk) {
+        func(0, count);
+        return;
+    }
+
+    std::lock_guard submit(submit_mutex_);
+
+    auto job = std::make_shared<Job>(count, std::max(1, chunk), func);
+    {
+        std::lock_guard lk(mutex_);
+        job_ = job;
+        generation_++;
+    }
+    job_cv_.notify_all();
+
+    job->work();
+
+    // no worker joins the job once it's withdrawn, so wait for those that did
+    {
+        std::unique_lock lk(mutex_);
+        job_.reset();
+        done_cv_.wait(lk, [&] { return job->workers_ == 0; });
+    }
+
+    if (job->error_)
+        std::rethrow_exception(job->error_);
+}
+
+void WorkerPool::Job::work() {
+    int begin;
+    while ((begin = next_.fetch_add(chunk_)) < count_) {
+        try {
+            func_(begin, std::min(begin + chunk_, count_));
+        } catch (...) {
+            // the remaining chunks are dropped
+            next_ = count_;
+            std::lock_guard lk(error_mutex_);
+            if (not error_)
+                error_ = std::current_exception();
+        }
+    }
+}
+
+void WorkerPool::run() {
+    size_t generation = 0;
+    while (true) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock lk(mutex_);
+            job_cv_.wait(lk, [&] { return stop_ or (job_ and generation_ != generation); });
+            if (stop_)
+                return;
+            generation = generation_;
+            job        = job_;
+            job->workers_++;
+        }
+
+        job->work();
+
+        {
+            std::lock_guard lk(mutex_);
+            job->workers_--;
+        }
+        done_cv_.notify_all();
+    }
+}
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include "xstudio/utility/compact_json.hpp"
+
+using namespace xstudio::utility;
+
+namespace {
+
+nlohmann::json make_clip(const int index) {
+    auto clip            = R"({"type": "Clip", "enabled": true, "prop": {}})"_json;
+    clip["name"]         = "clip_" + std::to_string(index);
+    clip["prop"]["path"] = "/shows/test/shots/" + std::to_string(index) + "/plate.exr";
+    clip["range"]        = {index * 100, 100, index * 100 + 10, 50};
+    return clip;
+}
+
+nlohmann::json make_track(const int clips, const int changed = -1) {
+    auto track    = R"({"type": "Track", "children": []})"_json;
+    track["name"] = "Video 1";
+    for (int i = 0; i < clips; i++) {
+        auto clip = make_clip(i);
+        if (i == changed)
+            clip["enabled"] = false;
+        track["children"].push_back(clip);
+    }
+    return track;
+}
+
+} // namespace
+
+TEST(CompactJsonPoolTest, RoundTrip) {
+    auto pool = CompactJsonPool(64);
+
+    auto value     = R"({"a": 1, "b": [1, 2.5, "three", null, true], "c": {"d": {}}})"_json;
+    value["track"] = make_track(8);
+
+    auto handle = pool.store(value);
+    EXPECT_EQ(pool.load(handle), value);
+    EXPECT_GT(pool.blob_count(), size_t(0));
+
+    // small values aren't shared
+    auto small = pool.store(R"({"a": 1})"_json);
+    EXPECT_TRUE(small.blobs.empty());
+    EXPECT_EQ(pool.load(small), R"({"a": 1})"_json);
+
+    pool.release(handle);
+    pool.release(small);
+    EXPECT_EQ(pool.blob_count(), size_t(0));
+    EXPECT_EQ(pool.bytes(), size_t(0));
+
+    EXPECT_TRUE(pool.load(CompactJsonPool::Handle()).is_null());
+}
+
+TEST(CompactJsonPoolTest, Sharing) {
+    auto pool = CompactJsonPool(64);
+
+    auto first       = pool.store(make_track(50));
+    const auto bytes = pool.bytes();
+    const auto blobs = pool.blob_count();
+
+    // one clip changed, only it and the track's children are new
+    auto second = pool.store(make_track(50, 10));
+    EXPECT_EQ(pool.blob_count(), blobs + 2);
+    EXPECT_LT(pool.bytes() - bytes, bytes / 4);
+
+    // identical value shares everything
+    auto third = pool.store(make_track(50));
+    EXPECT_EQ(pool.blob_count(), blobs + 2);
+    EXPECT_EQ(pool.load(third), make_track(50));
+
+    pool.release(first);
+    EXPECT_EQ(pool.load(second), make_track(50, 10));
+    EXPECT_EQ(pool.load(third), make_track(50));
+
+    pool.release(third);
+    EXPECT_EQ(pool.blob_count(), blobs);
+    EXPECT_EQ(pool.load(second), make_track(50, 10));
+
+    pool.release(second);
+    EXPECT_EQ(pool.blob_count(), size_t(0));
+    EXPECT_EQ(pool.bytes(), size_t(0));
+}
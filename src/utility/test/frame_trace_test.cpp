@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "xstudio/utility/frame_trace.hpp"
+
+using namespace xstudio;
+using namespace xstudio::utility;
+using namespace std::chrono_literals;
+
+namespace test_keys {
+// stands in for media::MediaKey
+struct Key {
+    std::string s;
+    [[nodiscard]] size_t hash() const { return std::hash<std::string>{}(s); }
+};
+std::string_view to_string_view(const Key &k) { return k.s; }
+} // namespace test_keys
+
+using test_keys::Key;
+
+class FrameTraceTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        FrameTracer::instance().clear();
+        FrameTracer::instance().set_enabled(true);
+    }
+    void TearDown() override {
+        FrameTracer::instance().set_enabled(false);
+        FrameTracer::instance().clear();
+    }
+};
+
+TEST_F(FrameTraceTest, Record) {
+    auto &tracer    = FrameTracer::instance();
+    const auto uuid = Uuid::generate();
+    const auto t0   = utility::clock::now();
+
+    tracer.record(TraceStage::Decode, t0, t0 + 3ms, Key{"/tmp/test.0001.exr@1"}, uuid);
+    tracer.record(TraceStage::Swap, t0 + 1ms, t0 + 2ms);
+
+    const auto events = tracer.events();
+    ASSERT_EQ(events.size(), size_t(2));
+    EXPECT_EQ(events[0].stage, TraceStage::Decode);
+    EXPECT_EQ(events[0].key_view(), "/tmp/test.0001.exr@1");
+    EXPECT_EQ(events[0].playhead, uuid);
+    EXPECT_EQ(events[0].end_ns - events[0].start_ns, 3000000);
+    EXPECT_EQ(events[1].stage, TraceStage::Swap);
+    EXPECT_TRUE(events[1].playhead.is_null());
+
+    EXPECT_EQ(tracer.histogram(TraceStage::Decode).count(), uint64_t(1));
+    // 3000us is in the [2048, 4096) bucket
+    EXPECT_EQ(tracer.histogram(TraceStage::Decode).buckets()[12], uint64_t(1));
+    EXPECT_EQ(tracer.histogram(TraceStage::Decode).percentile_us(50.0), 4096.0);
+
+    // disabled, nothing is recorded
+    tracer.set_enabled(false);
+    tracer.record(TraceStage::Decode, t0, t0 + 3ms, Key{"ignored"});
+    {
+        TraceSpan span(TraceStage::CacheStore, Key{"ignored"});
+    }
+    EXPECT_EQ(tracer.events().size(), size_t(2));
+}
+
+TEST_F(FrameTraceTest, Span) {
+    {
+        TraceSpan span(TraceStage::TextureUpload, Key{"abc"});
+        std::this_thread::sleep_for(1ms);
+    }
+    const auto events = FrameTracer::instance().events();
+    ASSERT_EQ(events.size(), size_t(1));
+    EXPECT_EQ(events[0].stage, TraceStage::TextureUpload);
+    EXPECT_GE(events[0].end_ns - events[0].start_ns, 1000000);
+}
+
+TEST_F(FrameTraceTest, LongKeyTruncated) {
+    const std::string long_key(500, 'x');
+    const auto t0 = utility::clock::now();
+    FrameTracer::instance().record(TraceStage::CacheRetrieve, t0, t0, Key{long_key});
+    const auto events = FrameTracer::instance().events();
+    ASSERT_EQ(events.size(), size_t(1));
+    EXPECT_EQ(events[0].key_view(), long_key.substr(0, events[0].key.size() - 1));
+}
+
+TEST_F(FrameTraceTest, RingOverwrite) {
+    auto &tracer  = FrameTracer::instance();
+    const auto t0 = utility::clock::now();
+    const int n   = FrameTracer::ring_size + 100;
+    for (int i = 0; i < n; ++i)
+        tracer.record(TraceStage::Decode, t0 + i * 1us, t0 + i * 1us + 1us);
+
+    const auto events = tracer.events();
+    ASSERT_EQ(events.size(), FrameTracer::ring_size);
+    // oldest were overwritten
+    EXPECT_EQ(
+        events.back().start_ns - events.front().start_ns,
+        int64_t(FrameTracer::ring_size - 1) * 1000);
+    // histograms count everything
+    EXPECT_EQ(tracer.histogram(TraceStage::Decode).count(), uint64_t(n));
+}
+
+TEST_F(FrameTraceTest, Threads) {
+    const int n_threads = 4;
+    const int n_events  = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < n_threads; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < n_events; ++i) {
+                TraceSpan span(TraceStage::CacheStore, Key{std::to_string(t)});
+            }
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+
+    const auto events = FrameTracer::instance().events();
+    EXPECT_EQ(events.size(), size_t(n_threads * n_events));
+    for (size_t i = 1; i < events.size(); ++i)
+        EXPECT_LE(events[i - 1].start_ns, events[i].start_ns);
+}
+
+TEST_F(FrameTraceTest, ChromeTrace) {
+    auto &tracer    = FrameTracer::instance();
+    const auto uuid = Uuid::generate();
+    const auto t0   = utility::clock::now();
+    tracer.record(TraceStage::Decode, t0 + 1ms, t0 + 5ms, Key{"a"}, uuid);
+    tracer.record(TraceStage::RequestQueueWait, t0, t0 + 1ms, Key{"a"}, uuid);
+
+    const auto trace = tracer.chrome_trace();
+    ASSERT_EQ(trace["traceEvents"].size(), size_t(2));
+
+    const auto &first = trace["traceEvents"][0];
+    EXPECT_EQ(first["name"], "RequestQueueWait");
+    EXPECT_EQ(first["ph"], "X");
+    EXPECT_EQ(first["ts"], 0.0);
+    EXPECT_EQ(first["dur"], 1000.0);
+    EXPECT_EQ(first["args"]["key"], "a");
+    EXPECT_EQ(first["args"]["playhead"], to_string(uuid));
+
+    const auto &second = trace["traceEvents"][1];
+    EXPECT_EQ(second["name"], "Decode");
+    EXPECT_EQ(second["ts"], 1000.0);
+    EXPECT_EQ(second["dur"], 4000.0);
+
+    const auto stats = tracer.statistics();
+    EXPECT_TRUE(stats["enabled"].get<bool>());
+    EXPECT_EQ(stats["stages"]["Decode"]["count"], 1);
+    EXPECT_EQ(stats["stages"]["Swap"]["count"], 0);
+}
+
+TEST_F(FrameTraceTest, Overhead) {
+    // cost of a trace point, disabled and enabled
+    const int n     = 100000;
+    auto &tracer    = FrameTracer::instance();
+    const Key key{"/tmp/test.0001.exr@1/0,0"};
+
+    auto run = [&]() {
+        const auto t0 = utility::clock::now();
+        for (int i = 0; i < n; ++i) {
+            TraceSpan span(TraceStage::Decode, key);
+        }
+        const auto t1 = utility::clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count() / n;
+    };
+
+    tracer.set_enabled(false);
+    const auto off = run();
+    tracer.set_enabled(true);
+    const auto on = run();
+
+    std::cout << "trace point overhead: disabled " << off << "ns, enabled " << on << "ns\n";
+}
@@ -2,6 +2,12 @@
 #include "xstudio/utility/json_store.hpp"
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+
+#include <zstr.hpp>
+
 using namespace xstudio::utility;
 using namespace nlohmann;
 
@@ -63,3 +69,97 @@ TEST(JsonStoreTest, Test) {
     j = R"({"test": {"one": 3 }})"_json;
     j.merge(R"({"test": {"two": 3 }, "doube":[1]})"_json);
 }
+
+namespace {
+// roughly the shape of a serialised timeline, tracks of clips with media
+// references, ranges and metadata.
+nlohmann::json make_timeline_json(const int tracks, const int clips) {
+    auto timeline = R"({"base": {"container": {"name": "timeline", "type": "Timeline",
+        "uuid": "0b2a4e8c-33d5-4e6d-9a0f-2c7f3c1b5a11"}}, "children": []})"_json;
+    for (int t = 0; t < tracks; t++) {
+        auto track = R"({"type": "Video Track", "enabled": true, "children": []})"_json;
+        track["name"] = "Track " + std::to_string(t);
+        for (int c = 0; c < clips; c++) {
+            auto clip = R"({"type": "Clip", "enabled": true, "locked": false,
+                "active_range": {"rate": 0.041666666666666664, "start": 0, "duration": 24},
+                "available_range": {"rate": 0.041666666666666664, "start": 0, "duration": 48},
+                "prop": {"media_uuid": "6a0f7c2e-8a41-4c4b-b0b4-0b6f2d5c1e77"},
+                "children": []})"_json;
+            clip["name"] = "shot_" + std::to_string(t) + "_" + std::to_string(c);
+            clip["active_range"]["start"] = c * 24;
+            clip["prop"]["path"] =
+                "file:///jobs/show/shot_" + std::to_string(c) + "/plate.####.exr";
+            track["children"].push_back(clip);
+        }
+        timeline["children"].push_back(track);
+    }
+    return timeline;
+}
+} // namespace
+
+TEST(JsonStoreTest, Binary) {
+    const auto j = make_timeline_json(2, 5);
+
+    const auto bin = json_to_binary(j);
+    EXPECT_TRUE(is_binary_json(bin.data(), bin.size()));
+    EXPECT_EQ(json_from_binary(bin.data(), bin.size()), j);
+
+    // text is not binary
+    const auto txt = j.dump();
+    EXPECT_FALSE(
+        is_binary_json(reinterpret_cast<const uint8_t *>(txt.data()), txt.size()));
+    EXPECT_THROW(
+        json_from_binary(reinterpret_cast<const uint8_t *>(txt.data()), txt.size()),
+        std::runtime_error);
+
+    // data from a newer version is refused
+    auto newer = bin;
+    newer[4]++;
+    EXPECT_THROW(json_from_binary(newer.data(), newer.size()), std::runtime_error);
+}
+
+TEST(JsonStoreTest, OpenBinarySession) {
+    const auto j    = JsonStore(make_timeline_json(2, 5));
+    const auto path = (std::filesystem::temp_directory_path() / "json_store_test.xsz").string();
+
+    {
+        const auto bin = json_to_binary(j);
+        zstr::ofstream o(path, std::ios::out | std::ios::binary);
+        o.write(reinterpret_cast<const char *>(bin.data()), bin.size());
+    }
+    EXPECT_EQ(open_session(path), j);
+
+    {
+        zstr::ofstream o(path);
+        o << j.dump(2);
+    }
+    EXPECT_EQ(open_session(path), j);
+
+    std::filesystem::remove(path);
+}
+
+TEST(JsonStoreTest, BinaryBenchmark) {
+    // compares text and binary encoding of a large timeline
+    const auto j = make_timeline_json(20, 1000);
+
+    auto t0        = std::chrono::steady_clock::now();
+    const auto txt = j.dump(2);
+    auto t1        = std::chrono::steady_clock::now();
+    const auto jt  = nlohmann::json::parse(txt);
+    auto t2        = std::chrono::steady_clock::now();
+    const auto bin = json_to_binary(j);
+    auto t3        = std::chrono::steady_clock::now();
+    const auto jb  = json_from_binary(bin.data(), bin.size());
+    auto t4        = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(jt, j);
+    EXPECT_EQ(jb, j);
+    EXPECT_LT(bin.size(), txt.size());
+
+    auto us = [](auto a, auto b) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(b - a).count();
+    };
+    std::cout << "20x1000 clip timeline: json " << txt.size() << " bytes, encode "
+              << us(t0, t1) << "us, decode " << us(t1, t2) << "us; binary " << bin.size()
+              << " bytes, encode " << us(t2, t3) << "us, decode " << us(t3, t4) << "us\n";
+}
@@ -6,6 +6,7 @@
 #include "xstudio/atoms.hpp"
 #include "xstudio/utility/container.hpp"
 #include "xstudio/utility/helpers.hpp"
+#include "xstudio/utility/json_store.hpp"
 #include "xstudio/utility/media_reference.hpp"
 #include "xstudio/utility/timecode.hpp"
 #include "xstudio/utility/types.hpp"
@@ -224,3 +225,22 @@ TEST(TimecodeSerializerTest, Test) {
 
     EXPECT_EQ(u1, u2) << "Creation from string should be equal";
 }
+
+TEST(JsonStoreSerializerTest, Test) {
+    fixture f;
+
+    binary_serializer::container_type buf;
+    binary_serializer bs{f.system, buf};
+    JsonStore u1(nlohmann::json::parse(
+        R"({"name": "timeline", "children": [{"start": 1001, "rate": 0.5}]})"));
+    JsonStore u2;
+
+    auto e = bs.apply(u1);
+    EXPECT_TRUE(e) << "unable to serialize" << to_string(bs.get_error()) << std::endl;
+
+    binary_deserializer bd{f.system, buf};
+    e = bd.apply(u2);
+    EXPECT_TRUE(e) << "unable to deserialize" << to_string(bd.get_error()) << std::endl;
+
+    EXPECT_EQ(u1, u2) << "Binary round trip should be equal";
+}
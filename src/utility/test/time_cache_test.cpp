@@ -183,6 +183,205 @@ TEST(TimeCacheTest2, Test) {
 }
 
 
+TEST(TimeCacheUsageTest, Test) {
+    using namespace std::chrono_literals;
+    TimeCache<std::string, std::shared_ptr<std::string>> mc;
+
+    // keys starting 'a' belong to a, the rest to b
+    const Uuid a(Uuid::generate());
+    const Uuid b(Uuid::generate());
+    const Uuid playhead(Uuid::generate());
+    mc.set_owner_function([&](const std::string &key, const std::shared_ptr<std::string> &) {
+        return std::vector<Uuid>({key[0] == 'a' ? a : b});
+    });
+
+    const auto now = clock::now();
+    mc.store("a1", std::make_shared<std::string>("testing"), now, false, playhead);
+    mc.store("b1", std::make_shared<std::string>("testing"), now, false, playhead);
+    mc.store("b2", std::make_shared<std::string>("testing"), now);
+    EXPECT_EQ(mc.usage(a).size, unsigned(7));
+    EXPECT_EQ(mc.usage(a).count, unsigned(1));
+    EXPECT_EQ(mc.usage(b).size, unsigned(14));
+    EXPECT_EQ(mc.usage(playhead).size, unsigned(14));
+    EXPECT_EQ(mc.usage(playhead).count, unsigned(2));
+
+    mc.erase("a1");
+    EXPECT_EQ(mc.usage(a).count, unsigned(0));
+    EXPECT_EQ(mc.usage(playhead).count, unsigned(1));
+
+    // b1 goes with the last uuid stored with it, owners don't keep it
+    mc.erase("b1", playhead);
+    EXPECT_EQ(mc.usage(playhead).count, unsigned(0));
+    EXPECT_EQ(mc.usage(b).count, unsigned(1));
+    EXPECT_EQ(mc.usage(b).size, unsigned(7));
+
+    // owners are worked out again
+    mc.set_owner_function(
+        [&](const std::string &, const std::shared_ptr<std::string> &) -> std::vector<Uuid> {
+            return {a};
+        });
+    EXPECT_EQ(mc.usage(a).count, unsigned(1));
+    EXPECT_EQ(mc.usage(b).count, unsigned(0));
+
+    mc.clear();
+    EXPECT_TRUE(mc.usage().empty());
+}
+
+TEST(TimeCacheRefreshOwnersTest, Test) {
+    TimeCache<std::string, std::shared_ptr<std::string>> mc;
+
+    // keys are owned by their first letter and, once added, its container
+    const Uuid a(Uuid::generate());
+    const Uuid b(Uuid::generate());
+    const Uuid container(Uuid::generate());
+    const Uuid playhead(Uuid::generate());
+    std::set<Uuid> members;
+    size_t calls = 0;
+    mc.set_owner_function([&](const std::string &key, const std::shared_ptr<std::string> &) {
+        calls++;
+        const auto owner = key[0] == 'a' ? a : b;
+        std::vector<Uuid> result({owner});
+        if (members.count(owner))
+            result.push_back(container);
+        return result;
+    });
+
+    const auto now = clock::now();
+    mc.store("a1", std::make_shared<std::string>("testing"), now, false, container);
+    mc.store("a2", std::make_shared<std::string>("testing"), now, false, playhead);
+    mc.store("b1", std::make_shared<std::string>("testing"), now);
+    EXPECT_EQ(mc.usage(container).count, unsigned(1));
+
+    // only a's entries are asked about
+    calls = 0;
+    members.insert(a);
+    mc.refresh_owners({a});
+    EXPECT_EQ(calls, size_t(2));
+    EXPECT_EQ(mc.usage(container).count, unsigned(2));
+    EXPECT_EQ(mc.usage(container).size, unsigned(14));
+    EXPECT_EQ(mc.usage(playhead).count, unsigned(1));
+
+    // a1 was stored with the container, so it's still counted once it goes
+    members.erase(a);
+    mc.refresh_owners({a});
+    EXPECT_EQ(mc.usage(container).count, unsigned(1));
+    EXPECT_EQ(mc.usage(a).count, unsigned(2));
+    EXPECT_EQ(mc.usage(b).count, unsigned(1));
+
+    calls = 0;
+    mc.refresh_owners({});
+    EXPECT_EQ(calls, size_t(0));
+}
+
+TEST(TimeCacheQuotaTest, Test) {
+    using namespace std::chrono_literals;
+    TimeCache<std::string, std::shared_ptr<std::string>> mc;
+
+    const Uuid a(Uuid::generate());
+    const Uuid b(Uuid::generate());
+    mc.set_owner_function([&](const std::string &key, const std::shared_ptr<std::string> &) {
+        return std::vector<Uuid>({key[0] == 'a' ? a : b});
+    });
+    mc.set_quota(a, 14);
+    EXPECT_EQ(mc.quota(a), unsigned(14));
+
+    const auto now = clock::now() + 1h;
+    mc.store("b1", std::make_shared<std::string>("testing"), now);
+    mc.store("a1", std::make_shared<std::string>("testing"), now);
+    mc.store("a2", std::make_shared<std::string>("testing"), now + 1s);
+
+    // a is full and its frames are needed before this one
+    EXPECT_FALSE(mc.store("a3", std::make_shared<std::string>("testing"), now + 2s));
+
+    // needed sooner, so a's last frame goes rather than b's
+    EXPECT_TRUE(mc.store("a0", std::make_shared<std::string>("testing"), now - 1s));
+    EXPECT_EQ(mc.count(), unsigned(3));
+    EXPECT_TRUE(mc.retrieve("b1"));
+    EXPECT_FALSE(mc.retrieve("a2"));
+    EXPECT_EQ(mc.usage(a).size, unsigned(14));
+
+    // a lower quota drops the excess straight away
+    mc.set_quota(a, 7);
+    EXPECT_EQ(mc.usage(a).count, unsigned(1));
+    EXPECT_EQ(mc.count(), unsigned(2));
+
+    // too big for its quota
+    EXPECT_FALSE(mc.store("a4", std::make_shared<std::string>("testing, testing"), now));
+
+    mc.set_quota(a, 0);
+    EXPECT_TRUE(mc.quotas().empty());
+    EXPECT_TRUE(mc.store("a4", std::make_shared<std::string>("testing, testing"), now));
+
+    // a playhead storing frames that are already cached stays in its quota
+    const Uuid playhead(Uuid::generate());
+    mc.set_quota(playhead, 7);
+    mc.store("b2", std::make_shared<std::string>("testing"), now + 1s);
+    EXPECT_TRUE(mc.store("b1", std::make_shared<std::string>("testing"), now, false, playhead));
+    EXPECT_TRUE(
+        mc.store("b2", std::make_shared<std::string>("testing"), now - 1s, false, playhead));
+    EXPECT_FALSE(mc.retrieve("b1"));
+    EXPECT_EQ(mc.usage(playhead).count, unsigned(1));
+    EXPECT_EQ(mc.usage(playhead).size, unsigned(7));
+}
+
+TEST(TimeCachePriorityTest, Test) {
+    using namespace std::chrono_literals;
+    TimeCache<std::string, std::shared_ptr<std::string>> mc;
+
+    const Uuid a(Uuid::generate());
+    const Uuid b(Uuid::generate());
+    mc.set_owner_function([&](const std::string &key, const std::shared_ptr<std::string> &) {
+        return std::vector<Uuid>({key[0] == 'a' ? a : b});
+    });
+    mc.set_max_size(21);
+    mc.set_priority(b, 1);
+    EXPECT_EQ(mc.priority(b), 1);
+    EXPECT_EQ(mc.priority(a), 0);
+
+    const auto now = clock::now() + 1h;
+    mc.store("a1", std::make_shared<std::string>("testing"), now);
+    mc.store("a2", std::make_shared<std::string>("testing"), now + 1s);
+    mc.store("b1", std::make_shared<std::string>("testing"), now + 2s);
+
+    // b1 is needed last, but a's frames go first
+    EXPECT_TRUE(mc.store("b2", std::make_shared<std::string>("testing"), now - 1s));
+    EXPECT_TRUE(mc.retrieve("b1"));
+    EXPECT_FALSE(mc.retrieve("a2"));
+
+    // there's nothing of a's left to make room with that isn't needed sooner
+    EXPECT_TRUE(mc.store("a3", std::make_shared<std::string>("testing"), now - 2s));
+    EXPECT_FALSE(mc.retrieve("a1"));
+    EXPECT_FALSE(mc.store("a4", std::make_shared<std::string>("testing"), now + 3s));
+
+    mc.set_priority(b, 0);
+    EXPECT_TRUE(mc.priorities().empty());
+}
+
+TEST(TimeCacheLookupTest, Test) {
+    using namespace std::chrono_literals;
+    TimeCache<std::string, std::shared_ptr<std::string>> mc;
+
+    const Uuid playhead(Uuid::generate());
+    const auto now = clock::now() + 1h;
+    mc.store("a1", std::make_shared<std::string>("testing"), now, false, playhead);
+
+    EXPECT_TRUE(mc.contains("a1"));
+    EXPECT_FALSE(mc.contains("a2"));
+    EXPECT_EQ(*mc.find("a1"), "testing");
+    EXPECT_FALSE(mc.find("a2"));
+
+    // lookups don't add timepoints or uuids
+    size_t entries = 0;
+    mc.for_each([&](const std::string &key, const auto &entry) {
+        EXPECT_EQ(key, "a1");
+        EXPECT_EQ(entry.timepoints.size(), size_t(1));
+        EXPECT_EQ(entry.uuids.size(), size_t(1));
+        entries++;
+    });
+    EXPECT_EQ(entries, size_t(1));
+}
+
+
 TEST(TimeCacheSpeedTest, Test) {
     using namespace std::chrono_literals;
     TimeCache<int, std::shared_ptr<std::string>> mc;
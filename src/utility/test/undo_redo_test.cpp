@@ -160,3 +160,92 @@ TEST(UndoRedoMapTest, Test) {
     EXPECT_EQ(*(h.redo(2)), 5);
     EXPECT_FALSE(h.redo(2));
 }
+
+TEST(CompactUndoRedoMapTest, Test) {
+
+    auto h     = CompactUndoRedoMap<int>();
+    auto value = [](const int i) {
+        auto jsn         = R"({"undo": {}, "redo": {}})"_json;
+        jsn["undo"]["v"] = i - 1;
+        jsn["redo"]["v"] = i;
+        return JsonStore(jsn);
+    };
+
+    EXPECT_EQ(h.count(), 0);
+    EXPECT_TRUE(h.empty());
+    EXPECT_FALSE(h.undo());
+    EXPECT_FALSE(h.redo());
+
+    h.push(1, value(1));
+    h.push(2, value(2));
+    h.push(3, value(3));
+    h.push(3, value(4));
+    h.push(4, value(5));
+
+    EXPECT_FALSE(h.undo(5));
+    EXPECT_FALSE(h.undo(4));
+
+    EXPECT_EQ(*(h.undo(2)), value(5));
+    EXPECT_EQ(*(h.undo(2)), value(4));
+    EXPECT_EQ(*(h.undo(2)), value(3));
+
+    EXPECT_FALSE(h.undo(2));
+
+    EXPECT_EQ(*(h.redo(2)), value(3));
+    EXPECT_EQ(*(h.redo(2)), value(4));
+    EXPECT_EQ(*(h.redo(2)), value(5));
+    EXPECT_FALSE(h.redo(2));
+
+    EXPECT_TRUE(h.undo());
+    h.push(6, value(6));
+    EXPECT_FALSE(h.redo());
+    EXPECT_EQ(h.count(), 5);
+
+    h.set_max_count(3);
+    EXPECT_EQ(h.count(), 3);
+    EXPECT_EQ(*(h.undo()), value(6));
+    EXPECT_EQ(*(h.undo()), value(4));
+    EXPECT_EQ(*(h.undo()), value(3));
+    EXPECT_FALSE(h.undo());
+
+    // the budget drops the oldest entries
+    h.clear();
+    EXPECT_EQ(h.bytes(), size_t(0));
+    for (int i = 0; i < 10; i++)
+        h.push(i, value(i));
+
+    const auto per_entry = h.bytes() / 10;
+    h.set_max_bytes(per_entry * 4);
+    EXPECT_LE(h.bytes(), per_entry * 4);
+    EXPECT_EQ(*(h.peek_undo()), 9);
+    EXPECT_LT(h.count(), size_t(5));
+}
+
+TEST(CompactUndoRedoMapTest, DuplicateKeys) {
+    // redo() keeps UndoRedoMap's behaviour, entries sharing the redone key
+    // are dropped
+    auto plain   = UndoRedoMap<int, int>();
+    auto compact = CompactUndoRedoMap<int>();
+    auto value   = [](const int i) { return JsonStore(nlohmann::json{{"v", i}}); };
+
+    const std::vector<std::pair<int, int>> entries = {{1, 1}, {2, 2}, {2, 3}, {3, 4}};
+    for (const auto &i : entries) {
+        plain.push(i.first, i.second);
+        compact.push(i.first, value(i.second));
+    }
+
+    for (int i = 0; i < 3; ++i)
+        EXPECT_EQ(*(compact.undo()), value(*(plain.undo())));
+
+    const auto bytes = compact.bytes();
+    EXPECT_EQ(*(compact.redo()), value(*(plain.redo())));
+    EXPECT_EQ(compact.count(), plain.count());
+    EXPECT_EQ(compact.count(), size_t(2));
+    EXPECT_LT(compact.bytes(), bytes);
+
+    EXPECT_EQ(*(compact.peek_redo()), *(plain.peek_redo()));
+    EXPECT_EQ(*(compact.peek_redo()), 3);
+    EXPECT_EQ(*(compact.redo()), value(*(plain.redo())));
+    EXPECT_FALSE(compact.redo());
+    EXPECT_FALSE(plain.redo());
+}
@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: Apache-2.0
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "xstudio/utility/worker_pool.hpp"
+
+using namespace xstudio::utility;
+
+TEST(WorkerPoolTest, Test) {
+    WorkerPool pool(4);
+    EXPECT_EQ(pool.num_threads(), 4);
+
+    // every row is visited once, over and over with the same threads
+    for (int pass = 0; pass < 100; ++pass) {
+        std::vector<int> rows(1037, 0);
+        pool.parallel_for(int(rows.size()), 8, [&](const int y0, const int y1) {
+            for (int y = y0; y < y1; ++y)
+                rows[y]++;
+        });
+        for (const auto r : rows)
+            ASSERT_EQ(r, 1);
+    }
+
+    // fewer rows than a chunk are done on the calling thread
+    const auto caller = std::this_thread::get_id();
+    pool.parallel_for(5, 8, [&](const int y0, const int y1) {
+        EXPECT_EQ(y0, 0);
+        EXPECT_EQ(y1, 5);
+        EXPECT_EQ(std::this_thread::get_id(), caller);
+    });
+
+    pool.parallel_for(0, 8, [&](const int, const int) { FAIL(); });
+}
+
+TEST(WorkerPoolTest, ConcurrentCallers) {
+    WorkerPool pool(3);
+
+    std::atomic<int> total{0};
+    std::vector<std::thread> callers;
+    for (int i = 0; i < 4; ++i) {
+        callers.emplace_back([&]() {
+            for (int pass = 0; pass < 50; ++pass) {
+                pool.parallel_for(
+                    100, 4, [&](const int y0, const int y1) { total += y1 - y0; });
+            }
+        });
+    }
+    for (auto &t : callers)
+        t.join();
+
+    EXPECT_EQ(total, 4 * 50 * 100);
+}
+
+TEST(WorkerPoolTest, Exception) {
+    WorkerPool pool(4);
+
+    EXPECT_THROW(
+        pool.parallel_for(
+            1000,
+            1,
+            [&](const int y0, const int) {
+                if (y0 == 500)
+                    throw std::runtime_error("row 500");
+            }),
+        std::runtime_error);
+
+    // and the pool is still usable
+    std::atomic<int> total{0};
+    pool.parallel_for(1000, 10, [&](const int y0, const int y1) { total += y1 - y0; });
+    EXPECT_EQ(total, 1000);
+}